@@ -177,6 +177,14 @@ CONF_mInt32(doris_max_scan_key_num, "1024");
 // the max number of push down values of a single column.
 // if exceed, no conditions will be pushed down for that column.
 CONF_mInt32(max_pushdown_conditions_per_column, "1024");
+// the max number of distinct values kept by a runtime filter of a hash join,
+// beyond which only the min/max values and the bloom filter are pushed down to the scan.
+CONF_mInt32(runtime_filter_max_in_num, "1024");
+// the false positive probability of the bloom filter of a runtime filter
+CONF_Double(runtime_filter_bloom_filter_fpp, "0.05");
+// the timeout of the rpc sending the runtime filters of a hash join to the fragments
+// scanning its probe side
+CONF_mInt32(runtime_filter_rpc_timeout_ms, "1000");
 // return_row / total_row
 CONF_mInt32(doris_max_pushdown_conjuncts_return_rate, "90");
 // (Advanced) Maximum size of per-query receive-side buffer
@@ -301,6 +309,16 @@ CONF_mInt32(cumulative_compaction_rounds_for_each_base_compaction_round, "9");
 // Merge log will be printed for each "row_step_for_compaction_merge_log" rows merged during compaction
 CONF_mInt64(row_step_for_compaction_merge_log, "0");
 
+// Whether the compactions of beta rowsets merge and aggregate the rows by blocks of columns
+// instead of row by row.
+CONF_mBool(enable_vectorized_compaction, "true");
+// Whether the vectorized compactions of the tablets with more value columns than
+// "vertical_compaction_num_columns_per_group" merge the key columns first, then the value
+// columns group by group in the same order, to bound the memory of wide tables.
+CONF_mBool(enable_vertical_compaction, "true");
+// The value columns merged at a time by the vertical compactions.
+CONF_mInt32(vertical_compaction_num_columns_per_group, "5");
+
 // Threshold to logging compaction trace, in seconds.
 CONF_mInt32(base_compaction_trace_threshold, "10");
 CONF_mInt32(cumulative_compaction_trace_threshold, "2");
@@ -585,6 +603,14 @@ CONF_mInt32(zone_map_row_num_threshold, "20");
 CONF_Int32(aws_log_level, "3");
 
 CONF_mBool(is_vec, "true");
+
+// the vectorized aggregation node converts its hash table to a two level (partitioned)
+// hash table once the number of groups exceeds this threshold. 0 means never convert.
+CONF_mInt64(vectorized_agg_two_level_threshold, "100000");
+
+// whether the vectorized aggregation node groups by a single string column of an OLAP scan by
+// the codes of its dictionary encoded pages, the values are decoded once per group.
+CONF_mBool(enable_low_cardinality_optimize, "true");
 } // namespace config
 
 } // namespace doris
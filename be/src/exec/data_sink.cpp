@@ -35,7 +35,9 @@
 #include "runtime/result_sink.h"
 #include "runtime/runtime_state.h"
 #include "util/logging.h"
+#include "vec/sink/data_stream_sender.h"
 #include "vec/sink/result_sink.h"
+#include "vec/sink/vtablet_sink.h"
 
 namespace doris {
 
@@ -72,6 +74,20 @@ Status DataSink::create_data_sink(ObjectPool* pool, const TDataSink& thrift_sink
         tmp_sink = new ResultSink(row_desc, output_exprs, thrift_sink.result_sink, 1024, config::is_vec);
         sink->reset(tmp_sink);
         break;
+    case TDataSinkType::VDATA_STREAM_SINK: {
+        if (!thrift_sink.__isset.stream_sink) {
+            return Status::InternalError("Missing data stream sink.");
+        }
+        bool send_query_statistics_with_every_batch =
+                params.__isset.send_query_statistics_with_every_batch
+                        ? params.send_query_statistics_with_every_batch
+                        : false;
+        tmp_sink = new vectorized::VDataStreamSender(pool, params.sender_id, row_desc,
+                                                     thrift_sink.stream_sink, params.destinations,
+                                                     send_query_statistics_with_every_batch);
+        sink->reset(tmp_sink);
+        break;
+    }
     case TDataSinkType::VRESULT_SINK:
         if (!thrift_sink.__isset.result_sink) {
             return Status::InternalError("Missing data buffer sink.");
@@ -141,6 +157,13 @@ Status DataSink::create_data_sink(ObjectPool* pool, const TDataSink& thrift_sink
         RETURN_IF_ERROR(status);
         break;
     }
+    case TDataSinkType::VOLAP_TABLE_SINK: {
+        Status status;
+        DCHECK(thrift_sink.__isset.olap_table_sink);
+        sink->reset(new stream_load::VOlapTableSink(pool, row_desc, output_exprs, &status));
+        RETURN_IF_ERROR(status);
+        break;
+    }
 
     default:
         std::stringstream error_msg;
@@ -38,6 +38,10 @@ class TPlanExecParams;
 class TPlanFragmentExecParams;
 class RowDescriptor;
 
+namespace vectorized {
+class Block;
+}
+
 // Superclass of all data sinks.
 class DataSink {
 public:
@@ -58,6 +62,11 @@ public:
     virtual Status send(RuntimeState* state, RowBatch* batch) = 0;
     // virtual Status send(RuntimeState* state, RowBatch* batch, bool eos) = 0;
 
+    // Send a block of the vectorized engine into this sink.
+    virtual Status send(RuntimeState* state, vectorized::Block* block) {
+        return Status::NotSupported("the sink does not accept vectorized blocks");
+    }
+
     // Releases all resources that were allocated in prepare()/send().
     // Further send() calls are illegal after calling close().
     // It must be okay to call this multiple times. Subsequent calls should
@@ -64,7 +64,11 @@
 
 #include "vec/core/block.h"
 #include "vec/exec/aggregation_node.h"
+#include "vec/exec/exchange_node.h"
+#include "vec/exec/hash_join_node.h"
 #include "vec/exec/olap_scan_node.h"
+#include "vec/exec/sort_node.h"
+#include "vec/exec/topn_node.h"
 #include "vec/exprs/vexpr.h"
 
 namespace doris {
@@ -163,6 +167,20 @@ void ExecNode::push_down_predicate(RuntimeState* state, std::list<ExprContext*>*
     }
 }
 
+void ExecNode::push_down_runtime_filters(RuntimeState* state,
+                                         std::vector<RuntimeFilter*>* filters) {
+    if (_type == TPlanNodeType::AGGREGATION_NODE || _type == TPlanNodeType::VAGGREGATION_NODE) {
+        return;
+    }
+    // the rows under a limit, e.g. of a top-n, must not be filtered
+    if (_limit != -1) {
+        return;
+    }
+    for (int i = 0; i < _children.size() && !filters->empty(); ++i) {
+        _children[i]->push_down_runtime_filters(state, filters);
+    }
+}
+
 Status ExecNode::init(const TPlanNode& tnode, RuntimeState* state) {
     if (tnode.__isset.vconjunct) {
         _vconjunct_ctx_ptr.reset(new doris::vectorized::VExprContext*);
@@ -398,6 +416,9 @@ Status ExecNode::create_node(RuntimeState* state, ObjectPool* pool, const TPlanN
     case TPlanNodeType::HASH_JOIN_NODE:
         *node = pool->add(new HashJoinNode(pool, tnode, descs));
         return Status::OK();
+    case TPlanNodeType::VHASH_JOIN_NODE:
+        *node = pool->add(new doris::vectorized::VHashJoinNode(pool, tnode, descs));
+        return Status::OK();
 
     case TPlanNodeType::CROSS_JOIN_NODE:
         *node = pool->add(new CrossJoinNode(pool, tnode, descs));
@@ -415,6 +436,10 @@ Status ExecNode::create_node(RuntimeState* state, ObjectPool* pool, const TPlanN
         *node = pool->add(new ExchangeNode(pool, tnode, descs));
         return Status::OK();
 
+    case TPlanNodeType::VEXCHANGE_NODE:
+        *node = pool->add(new doris::vectorized::VExchangeNode(pool, tnode, descs));
+        return Status::OK();
+
     case TPlanNodeType::SELECT_NODE:
         *node = pool->add(new SelectNode(pool, tnode, descs));
         return Status::OK();
@@ -430,6 +455,13 @@ Status ExecNode::create_node(RuntimeState* state, ObjectPool* pool, const TPlanN
             *node = pool->add(new SpillSortNode(pool, tnode, descs));
         }
 
+        return Status::OK();
+    case TPlanNodeType::VSORT_NODE:
+        if (tnode.sort_node.use_top_n) {
+            *node = pool->add(new doris::vectorized::VTopNNode(pool, tnode, descs));
+        } else {
+            *node = pool->add(new doris::vectorized::VSortNode(pool, tnode, descs));
+        }
         return Status::OK();
     case TPlanNodeType::ANALYTIC_EVAL_NODE:
         *node = pool->add(new AnalyticEvalNode(pool, tnode, descs));
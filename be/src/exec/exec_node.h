@@ -44,6 +44,7 @@ class TPlan;
 class TupleRow;
 class DataSink;
 class MemTracker;
+class RuntimeFilter;
 
 namespace vectorized {
 class Block;
@@ -170,6 +171,12 @@ public:
 
     virtual void push_down_predicate(RuntimeState* state, std::list<ExprContext*>* expr_ctxs);
 
+    // Hand the runtime filters of a hash join down to the scan nodes of its probe side,
+    // the filters accepted by a node are removed from the list.
+    // Must be called before the first get_next() of the subtree.
+    virtual void push_down_runtime_filters(RuntimeState* state,
+                                           std::vector<RuntimeFilter*>* filters);
+
     // recursive helper method for generating a string for Debug_string().
     // implementations should call debug_string(int, std::stringstream) on their children.
     // Input parameters:
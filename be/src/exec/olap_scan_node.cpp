@@ -365,9 +365,35 @@ Status OlapScanNode::set_scan_ranges(const std::vector<TScanRangeParams>& scan_r
     return Status::OK();
 }
 
+void OlapScanNode::push_down_runtime_filters(RuntimeState* state,
+                                             std::vector<RuntimeFilter*>* filters) {
+    // the filters are turned into conditions when the scan starts, those of the joins
+    // of other fragments may come too late
+    std::lock_guard<std::mutex> l(_runtime_filters_lock);
+    if (_runtime_filters_applied) {
+        return;
+    }
+    auto iter = filters->begin();
+    while (iter != filters->end()) {
+        SlotDescriptor* slot = state->desc_tbl().get_slot_descriptor((*iter)->slot_id());
+        if (slot != nullptr && slot->parent() == _tuple_id &&
+            slot->type().type == (*iter)->type()) {
+            _runtime_filters.push_back(*iter);
+            iter = filters->erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+
 Status OlapScanNode::start_scan(RuntimeState* state) {
     RETURN_IF_CANCELLED(state);
 
+    {
+        std::lock_guard<std::mutex> l(_runtime_filters_lock);
+        _runtime_filters_applied = true;
+    }
+
     VLOG_CRITICAL << "Eval Const Conjuncts";
     // 1. Eval const conjuncts to find whether eos = true
     eval_const_conjuncts();
@@ -388,7 +414,6 @@ Status OlapScanNode::start_scan(RuntimeState* state) {
 
     VLOG_CRITICAL << "Filter idle conjuncts";
     // 4. Filter idle conjunct which already trans to olap filters`
-    // TODO: filter idle conjunct in vexpr_contexts
     remove_pushed_conjuncts(state);
 
     VLOG_CRITICAL << "BuildScanKey";
@@ -745,15 +770,55 @@ Status OlapScanNode::normalize_predicate(ColumnValueRange<T>& range, SlotDescrip
     // 3. Normalize BinaryPredicate , add to ColumnValueRange
     RETURN_IF_ERROR(normalize_noneq_binary_predicate(slot, &range));
 
-    // 4. Check whether range is empty, set _eos
+    // 4. Normalize the runtime filters of the hash joins, add to ColumnValueRange
+    RETURN_IF_ERROR(normalize_runtime_filters(slot, &range));
+
+    // 5. Check whether range is empty, set _eos
     if (range.is_empty_value_range()) _eos = true;
 
-    // 5. Add range to Column->ColumnValueRange map
+    // 6. Add range to Column->ColumnValueRange map
     _column_value_ranges[slot->col_name()] = range;
 
     return Status::OK();
 }
 
+// The values of a runtime filter become an IN condition when there are not too many of
+// them, the min and max values a range condition otherwise. The range condition can not
+// filter much in general, so the storage evaluates the bloom filter as well.
+template <class T>
+Status OlapScanNode::normalize_runtime_filters(SlotDescriptor* slot, ColumnValueRange<T>* range) {
+    for (auto filter : _runtime_filters) {
+        if (filter->slot_id() != slot->id()) {
+            continue;
+        }
+        // the joins push down no filter when their build side is empty
+        DCHECK(!filter->empty());
+
+        HybridSetBase* in_values = filter->in_values();
+        if (in_values != nullptr && in_values->size() <= _max_pushdown_conditions_per_column) {
+            auto temp_range = ColumnValueRange<T>::create_empty_column_value_range(range->type());
+            HybridSetBase::IteratorBase* iter = in_values->begin();
+            while (iter->has_next()) {
+                auto value = const_cast<void*>(iter->get_value());
+                RETURN_IF_ERROR(change_fixed_value_range(temp_range, slot->type().type, value,
+                        ColumnValueRange<T>::add_fixed_value_range));
+                iter->next();
+            }
+            range->intersection(temp_range);
+            continue;
+        }
+
+        RETURN_IF_ERROR(range->add_range(FILTER_LARGER_OR_EQUAL,
+                                         *reinterpret_cast<const T*>(filter->min_value())));
+        RETURN_IF_ERROR(range->add_range(FILTER_LESS_OR_EQUAL,
+                                         *reinterpret_cast<const T*>(filter->max_value())));
+        if (filter->bloom_filter() != nullptr) {
+            _bloom_filters.emplace_back(slot->col_name(), filter->bloom_filter());
+        }
+    }
+    return Status::OK();
+}
+
 static bool ignore_cast(SlotDescriptor* slot, Expr* expr) {
     if (slot->type().is_date_type() && expr->type().is_date_type()) {
         return true;
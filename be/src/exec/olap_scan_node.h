@@ -21,12 +21,14 @@
 #include <boost/thread.hpp>
 #include <boost/variant/static_visitor.hpp>
 #include <condition_variable>
+#include <mutex>
 #include <queue>
 
 #include "exec/olap_common.h"
 #include "exec/olap_scanner.h"
 #include "exec/scan_node.h"
 #include "exprs/in_predicate.h"
+#include "exprs/runtime_filter.h"
 #include "runtime/descriptors.h"
 #include "runtime/row_batch_interface.hpp"
 #include "runtime/vectorized_row_batch.h"
@@ -56,6 +58,9 @@ public:
     Status collect_query_statistics(QueryStatistics* statistics) override;
     virtual Status close(RuntimeState* state);
     virtual Status set_scan_ranges(const std::vector<TScanRangeParams>& scan_ranges);
+    // Accept the runtime filters targeting the slots of the scanned tuple.
+    virtual void push_down_runtime_filters(RuntimeState* state,
+                                           std::vector<RuntimeFilter*>* filters);
     inline void set_no_agg_finalize() { _need_agg_finalize = false; }
 
 protected:
@@ -137,7 +142,7 @@ protected:
     // In order to ensure the accuracy of the query result
     // only key column conjuncts will be remove as idle conjunct
     bool is_key_column(const std::string& key_name);
-    void remove_pushed_conjuncts(RuntimeState *state);
+    virtual void remove_pushed_conjuncts(RuntimeState *state);
 
     Status start_scan(RuntimeState* state);
 
@@ -159,6 +164,9 @@ protected:
     template <class T>
     Status normalize_noneq_binary_predicate(SlotDescriptor* slot, ColumnValueRange<T>* range);
 
+    template <class T>
+    Status normalize_runtime_filters(SlotDescriptor* slot, ColumnValueRange<T>* range);
+
     template <typename T>
     static bool normalize_is_null_predicate(Expr* expr, SlotDescriptor* slot,
             const std::string& is_null_str, ColumnValueRange<T>* range);
@@ -217,6 +225,16 @@ protected:
 
     std::vector<TCondition> _olap_filter;
 
+    // the runtime filters pushed down by the hash joins, owned by the joins or by the
+    // fragment executor for the filters of other fragments
+    std::vector<RuntimeFilter*> _runtime_filters;
+    // protects _runtime_filters until they are applied when the scan starts, the
+    // filters of other fragments are pushed down by the rpc threads
+    std::mutex _runtime_filters_lock;
+    bool _runtime_filters_applied = false;
+    // (column name, bloom filter) of the runtime filters, evaluated by the storage
+    std::vector<std::pair<std::string, const segment_v2::BloomFilter*>> _bloom_filters;
+
     // Pool for storing allocated scanner objects.  We don't want to use the
     // runtime pool to ensure that the scanner objects are deleted before this
     // object is.
@@ -142,6 +142,7 @@ Status OlapScanner::_init_params(const std::vector<OlapScanRange*>& key_ranges,
     for (auto& filter : filters) {
         _params.conditions.push_back(filter);
     }
+    _params.bloom_filters = _parent->_bloom_filters;
 
     // Range
     for (auto key_range : key_ranges) {
@@ -22,6 +22,9 @@
 #include "runtime/row_batch.h"
 #include "runtime/tuple_row.h"
 #include "util/string_parser.hpp"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
+#include "vec/core/block.h"
 
 namespace doris {
 
@@ -191,6 +194,16 @@ Status OlapTablePartitionParam::init() {
             _distributed_slot_descs.emplace_back(it->second);
         }
     }
+    const auto& slots = _schema->tuple_desc()->slots();
+    auto position = [&slots](SlotDescriptor* slot_desc) {
+        return std::find(slots.begin(), slots.end(), slot_desc) - slots.begin();
+    };
+    for (auto slot_desc : _partition_slot_descs) {
+        _partition_slot_positions.push_back(position(slot_desc));
+    }
+    for (auto slot_desc : _distributed_slot_descs) {
+        _distributed_slot_positions.push_back(position(slot_desc));
+    }
     // initial partitions
     for (int i = 0; i < _t_param.partitions.size(); ++i) {
         const TOlapTablePartition& t_part = _t_param.partitions[i];
@@ -239,6 +252,7 @@ Status OlapTablePartitionParam::init() {
         _partitions.emplace_back(part);
         _partitions_map->emplace(part->end_key, part);
     }
+    _create_vec_part_keys();
     return Status::OK();
 }
 
@@ -256,6 +270,177 @@ bool OlapTablePartitionParam::find_tablet(Tuple* tuple, const OlapTablePartition
     return false;
 }
 
+namespace {
+
+// Splits a column of the vectorized engine into its values and its null map, the null map
+// is nullptr if the column is not nullable.
+void split_nullable(vectorized::ColumnPtr column, vectorized::ColumnPtr* values,
+                    vectorized::ColumnPtr* null_map) {
+    column = column->convertToFullColumnIfConst();
+    if (column->isNullable()) {
+        const auto& nullable_column = assert_cast<const vectorized::ColumnNullable&>(*column);
+        *values = nullable_column.getNestedColumnPtr();
+        *null_map = nullable_column.getNullMapColumnPtr();
+    } else {
+        *values = std::move(column);
+        *null_map = nullptr;
+    }
+}
+
+// The values of a partition column in the layout of VecPartKeys.
+vectorized::ColumnPtr to_part_key_column(vectorized::ColumnPtr values, PrimitiveType type) {
+    if (type != TYPE_DATE && type != TYPE_DATETIME) {
+        return values;
+    }
+    auto datetimes = vectorized::ColumnInt64::create(values->size());
+    auto& data = datetimes->getData();
+    for (size_t i = 0; i < data.size(); ++i) {
+        auto value = reinterpret_cast<const DateTimeValue*>(values->getDataAt(i).data);
+        data[i] = value->to_olap_datetime();
+    }
+    return datetimes;
+}
+
+} // namespace
+
+void OlapTablePartitionParam::find_tablets(const vectorized::Block& block,
+                                           std::vector<const OlapTablePartition*>* partitions,
+                                           std::vector<uint32_t>* dist_hashes) const {
+    size_t rows = block.rows();
+    VecPartKeys keys;
+    for (int i = 0; i < _partition_slot_descs.size(); ++i) {
+        vectorized::ColumnPtr values;
+        vectorized::ColumnPtr null_map;
+        split_nullable(block.getByPosition(_partition_slot_positions[i]).column, &values,
+                       &null_map);
+        keys.columns.emplace_back(
+                to_part_key_column(std::move(values), _partition_slot_descs[i]->type().type));
+        keys.null_maps.emplace_back(std::move(null_map));
+    }
+    partitions->assign(rows, nullptr);
+    // the rows of a load mostly come partition after partition, so a row is first looked
+    // for in the partition of the row before it
+    int pos = -1;
+    for (size_t row = 0; row < rows; ++row) {
+        if (pos < 0 || !_vec_part_contains(keys, row, pos)) {
+            pos = _find_vec_partition(keys, row);
+        }
+        if (pos >= 0) {
+            (*partitions)[row] = _sorted_partitions[pos];
+        }
+    }
+
+    // hash the distributed columns one after the other, updating the hashes of all the rows
+    dist_hashes->assign(rows, 0);
+    for (int i = 0; i < _distributed_slot_descs.size(); ++i) {
+        const auto& type = _distributed_slot_descs[i]->type();
+        vectorized::ColumnPtr values;
+        vectorized::ColumnPtr null_map;
+        split_nullable(block.getByPosition(_distributed_slot_positions[i]).column, &values,
+                       &null_map);
+        for (size_t row = 0; row < rows; ++row) {
+            uint32_t& hash_val = (*dist_hashes)[row];
+            if (null_map != nullptr && null_map->getBool(row)) {
+                //NULL is treat as 0 when hash
+                static const int INT_VALUE = 0;
+                static const TypeDescriptor INT_TYPE(TYPE_INT);
+                hash_val = RawValue::zlib_crc32(&INT_VALUE, INT_TYPE, hash_val);
+                continue;
+            }
+            // the DATEs, DATETIMEs and DECIMALV2s of the vectorized engine are the
+            // DateTimeValues and DecimalV2Values zlib_crc32 expects
+            StringRef data = values->getDataAt(row);
+            if (type.is_string_type()) {
+                StringValue value(const_cast<char*>(data.data), data.size);
+                hash_val = RawValue::zlib_crc32(&value, type, hash_val);
+            } else {
+                hash_val = RawValue::zlib_crc32(data.data, type, hash_val);
+            }
+        }
+    }
+}
+
+void OlapTablePartitionParam::_create_vec_part_keys() {
+    for (auto& it : *_partitions_map) {
+        _sorted_partitions.push_back(it.second);
+    }
+    auto create_keys = [this](bool is_start_key, VecPartKeys* keys) {
+        for (auto slot_desc : _partition_slot_descs) {
+            const auto& type = slot_desc->type();
+            auto values = type.get_data_type_ptr()->createColumn();
+            auto null_map = vectorized::ColumnUInt8::create();
+            for (auto part : _sorted_partitions) {
+                // the nullptr keys are not compared
+                Tuple* key = is_start_key ? part->start_key : part->end_key;
+                if (key == nullptr || key->is_null(slot_desc->null_indicator_offset())) {
+                    values->insertDefault();
+                    null_map->insertValue(key != nullptr);
+                } else {
+                    values->insertData(
+                            reinterpret_cast<const char*>(key->get_slot(slot_desc->tuple_offset())),
+                            type.get_slot_size());
+                    null_map->insertValue(0);
+                }
+            }
+            keys->columns.emplace_back(to_part_key_column(std::move(values), type.type));
+            keys->null_maps.emplace_back(std::move(null_map));
+        }
+    };
+    create_keys(true, &_vec_start_keys);
+    create_keys(false, &_vec_end_keys);
+}
+
+int OlapTablePartitionParam::_compare_vec_part_key(const VecPartKeys& keys, size_t row,
+                                                   const VecPartKeys& bounds, size_t pos) const {
+    for (int i = 0; i < keys.columns.size(); ++i) {
+        bool lhs_null = keys.null_maps[i] != nullptr && keys.null_maps[i]->getBool(row);
+        bool rhs_null = bounds.null_maps[i] != nullptr && bounds.null_maps[i]->getBool(pos);
+        if (lhs_null && rhs_null) {
+            continue;
+        }
+        // null is the min value
+        if (lhs_null || rhs_null) {
+            return lhs_null ? -1 : 1;
+        }
+        int res = keys.columns[i]->compareAt(row, pos, *bounds.columns[i], -1);
+        if (res != 0) {
+            return res;
+        }
+    }
+    return 0;
+}
+
+bool OlapTablePartitionParam::_vec_part_contains(const VecPartKeys& keys, size_t row,
+                                                 size_t pos) const {
+    const OlapTablePartition* part = _sorted_partitions[pos];
+    if (part->end_key != nullptr && _compare_vec_part_key(keys, row, _vec_end_keys, pos) >= 0) {
+        return false;
+    }
+    return part->start_key == nullptr ||
+           _compare_vec_part_key(keys, row, _vec_start_keys, pos) >= 0;
+}
+
+int OlapTablePartitionParam::_find_vec_partition(const VecPartKeys& keys, size_t row) const {
+    // upper bound of row in the end keys, a nullptr end key is greater than any row
+    size_t first = 0;
+    size_t count = _sorted_partitions.size();
+    while (count > 0) {
+        size_t step = count / 2;
+        size_t mid = first + step;
+        if (_sorted_partitions[mid]->end_key != nullptr &&
+            _compare_vec_part_key(keys, row, _vec_end_keys, mid) >= 0) {
+            first = mid + 1;
+            count -= step + 1;
+        } else {
+            count = step;
+        }
+    }
+    if (first == _sorted_partitions.size() || !_vec_part_contains(keys, row, first)) {
+        return -1;
+    }
+    return first;
+}
+
 Status OlapTablePartitionParam::_create_partition_keys(const std::vector<TExprNode>& t_exprs,
                                                        Tuple** part_key) {
     Tuple* tuple = (Tuple*)_mem_pool->allocate(_schema->tuple_desc()->byte_size());
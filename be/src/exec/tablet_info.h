@@ -30,6 +30,7 @@
 #include "runtime/descriptors.h"
 #include "runtime/raw_value.h"
 #include "runtime/tuple.h"
+#include "vec/columns/column.h"
 
 namespace doris {
 
@@ -37,6 +38,10 @@ class MemPool;
 class MemTracker;
 class RowBatch;
 
+namespace vectorized {
+class Block;
+}
+
 struct OlapTableIndexSchema {
     int64_t index_id;
     std::vector<SlotDescriptor*> slots;
@@ -156,16 +161,46 @@ public:
     bool find_tablet(Tuple* tuple, const OlapTablePartition** partitions,
                      uint32_t* dist_hash) const;
 
+    // find_tablet of the vectorized engine, the columns of block are the slots of the tuple
+    // of the schema. Finds the partition and the distribution hash of every row of block,
+    // the partition of a row no partition contains is nullptr.
+    void find_tablets(const vectorized::Block& block,
+                      std::vector<const OlapTablePartition*>* partitions,
+                      std::vector<uint32_t>* dist_hashes) const;
+
     const std::vector<OlapTablePartition*>& get_partitions() const { return _partitions; }
     std::string debug_string() const;
 
 private:
+    // The values of the partition columns in the vectorized layout, with the DATEs and
+    // DATETIMEs as olap datetimes, which compare like the DateTimeValues.
+    struct VecPartKeys {
+        vectorized::Columns columns;
+        // the ColumnUInt8 null maps, nullptr for the values which are never null
+        vectorized::Columns null_maps;
+    };
+
     Status _create_partition_keys(const std::vector<TExprNode>& t_exprs, Tuple** part_key);
 
     Status _create_partition_key(const TExprNode& t_expr, Tuple* tuple, SlotDescriptor* slot_desc);
 
     uint32_t _compute_dist_hash(Tuple* key) const;
 
+    // builds the start and end keys of _sorted_partitions in the vectorized layout
+    void _create_vec_part_keys();
+
+    // compares row of keys with the key of the partition at position pos of bounds, like
+    // OlapTablePartKeyComparator does.
+    int _compare_vec_part_key(const VecPartKeys& keys, size_t row, const VecPartKeys& bounds,
+                              size_t pos) const;
+
+    // whether the partition at position pos of _sorted_partitions contains row of keys
+    bool _vec_part_contains(const VecPartKeys& keys, size_t row, size_t pos) const;
+
+    // the position in _sorted_partitions of the partition which contains row of keys, -1 if
+    // none does
+    int _find_vec_partition(const VecPartKeys& keys, size_t row) const;
+
     // check if this partition contain this key
     bool _part_contains(OlapTablePartition* part, Tuple* key) const {
         if (part->start_key == nullptr) {
@@ -183,6 +218,9 @@ private:
 
     std::vector<SlotDescriptor*> _partition_slot_descs;
     std::vector<SlotDescriptor*> _distributed_slot_descs;
+    // the positions of the partition and distributed slots in the tuple of the schema
+    std::vector<int> _partition_slot_positions;
+    std::vector<int> _distributed_slot_positions;
 
     ObjectPool _obj_pool;
     std::shared_ptr<MemTracker> _mem_tracker;
@@ -190,6 +228,11 @@ private:
     std::vector<OlapTablePartition*> _partitions;
     std::unique_ptr<std::map<Tuple*, OlapTablePartition*, OlapTablePartKeyComparator>>
             _partitions_map;
+
+    // the partitions in the order of their end keys, for the vectorized engine
+    std::vector<OlapTablePartition*> _sorted_partitions;
+    VecPartKeys _vec_start_keys;
+    VecPartKeys _vec_end_keys;
 };
 
 using TabletLocation = TTabletLocation;
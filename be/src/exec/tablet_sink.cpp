@@ -31,6 +31,7 @@
 #include "util/debug/sanitizer_scopes.h"
 #include "util/monotime.h"
 #include "util/uid_util.h"
+#include "vec/core/block.h"
 
 namespace doris {
 namespace stream_load {
@@ -105,6 +106,7 @@ void NodeChannel::open() {
     request.set_need_gen_rollup(_parent->_need_gen_rollup);
     request.set_load_mem_limit(_parent->_load_mem_limit);
     request.set_load_channel_timeout_s(_parent->_load_channel_timeout_s);
+    request.set_is_vectorized(_parent->_is_vectorized);
 
     _open_closure = new RefCountClosure<PTabletWriterOpenResult>();
     _open_closure->ref();
@@ -195,16 +197,7 @@ Status NodeChannel::add_row(Tuple* input_tuple, int64_t tablet_id) {
         return st.clone_and_prepend("already stopped, can't add_row. cancelled/eos: ");
     }
 
-    // We use OlapTableSink mem_tracker which has the same ancestor of _plan node,
-    // so in the ideal case, mem limit is a matter for _plan node.
-    // But there is still some unfinished things, we do mem limit here temporarily.
-    // _cancelled may be set by rpc callback, and it's possible that _cancelled might be set in any of the steps below.
-    // It's fine to do a fake add_row() and return OK, because we will check _cancelled in next add_row() or mark_close().
-    while (!_cancelled && _parent->_mem_tracker->AnyLimitExceeded(MemLimit::HARD) &&
-           _pending_batches_num > 0) {
-        SCOPED_ATOMIC_TIMER(&_mem_exceeded_block_ns);
-        SleepFor(MonoDelta::FromMilliseconds(10));
-    }
+    _wait_mem_limit();
 
     auto row_no = _cur_batch->add_row();
     if (row_no == RowBatch::INVALID_ROW_INDEX) {
@@ -229,12 +222,81 @@ Status NodeChannel::add_row(Tuple* input_tuple, int64_t tablet_id) {
     return Status::OK();
 }
 
+Status NodeChannel::add_rows(vectorized::MutableColumns&& columns,
+                             const vectorized::ColumnInt64& tablet_ids) {
+    auto st = none_of({_cancelled, _eos_is_produced});
+    if (!st.ok()) {
+        return st.clone_and_prepend("already stopped, can't add_rows. cancelled/eos: ");
+    }
+
+    _wait_mem_limit();
+
+    if (_cur_columns.empty()) {
+        _cur_columns = std::move(columns);
+    } else {
+        for (size_t i = 0; i < _cur_columns.size(); ++i) {
+            _cur_columns[i]->insertRangeFrom(*columns[i], 0, tablet_ids.size());
+        }
+    }
+    for (auto tablet_id : tablet_ids.getData()) {
+        _cur_add_batch_request.add_tablet_ids(tablet_id);
+    }
+
+    if (_cur_columns[0]->size() >= _batch_size) {
+        RETURN_IF_ERROR(_serialize_cur_columns());
+        {
+            SCOPED_ATOMIC_TIMER(&_queue_push_lock_ns);
+            std::lock_guard<std::mutex> l(_pending_batches_lock);
+            _pending_batches.emplace(nullptr, _cur_add_batch_request);
+            _pending_batches_num++;
+        }
+        _cur_add_batch_request.clear_tablet_ids();
+        _cur_add_batch_request.clear_block();
+    }
+    return Status::OK();
+}
+
+void NodeChannel::_wait_mem_limit() {
+    // We use OlapTableSink mem_tracker which has the same ancestor of _plan node,
+    // so in the ideal case, mem limit is a matter for _plan node.
+    // But there is still some unfinished things, we do mem limit here temporarily.
+    // _cancelled may be set by rpc callback, and it's possible that _cancelled might be set in any of the steps below.
+    // It's fine to do a fake add_row() and return OK, because we will check _cancelled in next add_row() or mark_close().
+    while (!_cancelled && _parent->_mem_tracker->AnyLimitExceeded(MemLimit::HARD) &&
+           _pending_batches_num > 0) {
+        SCOPED_ATOMIC_TIMER(&_mem_exceeded_block_ns);
+        SleepFor(MonoDelta::FromMilliseconds(10));
+    }
+}
+
+Status NodeChannel::_serialize_cur_columns() {
+    SCOPED_ATOMIC_TIMER(&_serialize_batch_ns);
+    vectorized::Block block;
+    for (size_t i = 0; i < _cur_columns.size(); ++i) {
+        auto slot_desc = _tuple_desc->slots()[i];
+        block.insert({std::move(_cur_columns[i]), slot_desc->get_data_type_ptr(),
+                      slot_desc->col_name()});
+    }
+    _cur_columns.clear();
+    size_t uncompressed_bytes = 0;
+    size_t compressed_bytes = 0;
+    return block.serialize(_cur_add_batch_request.mutable_block(), &uncompressed_bytes,
+                           &compressed_bytes);
+}
+
 Status NodeChannel::mark_close() {
     auto st = none_of({_cancelled, _eos_is_produced});
     if (!st.ok()) {
         return st.clone_and_prepend("already stopped, can't mark as closed. cancelled/eos: ");
     }
 
+    if (!_cur_columns.empty()) {
+        st = _serialize_cur_columns();
+        if (!st.ok()) {
+            _cancelled = true;
+            return st;
+        }
+    }
     _cur_add_batch_request.set_eos(true);
     {
         debug::ScopedTSANIgnoreReadsAndWrites ignore_tsan;
@@ -330,7 +392,8 @@ int NodeChannel::try_send_and_fetch_status() {
 
         // tablet_ids has already set when add row
         request.set_packet_seq(_next_packet_seq);
-        if (row_batch->num_rows() > 0) {
+        // the vectorized sink serializes its blocks when it queues them
+        if (row_batch != nullptr && row_batch->num_rows() > 0) {
             SCOPED_ATOMIC_TIMER(&_serialize_batch_ns);
             row_batch->serialize(request.mutable_row_batch());
         }
@@ -383,6 +446,7 @@ void NodeChannel::clear_all_batches() {
     std::queue<AddBatchReq> empty;
     std::swap(_pending_batches, empty);
     _cur_batch.reset();
+    _cur_columns.clear();
 }
 
 IndexChannel::~IndexChannel() {}
@@ -402,11 +466,16 @@ Status IndexChannel::init(RuntimeState* state, const std::vector<TTabletWithPart
                 channel = _parent->_pool->add(
                         new NodeChannel(_parent, _index_id, node_id, _schema_hash));
                 _node_channels.emplace(node_id, channel);
+                _numbered_node_channels.push_back(channel);
             } else {
                 channel = it->second;
             }
             channel->add_tablet(tablet);
             channels.push_back(channel);
+            auto number = std::find(_numbered_node_channels.begin(),
+                                    _numbered_node_channels.end(), channel) -
+                          _numbered_node_channels.begin();
+            _channel_numbers_by_tablet[tablet.tablet_id].push_back(number);
         }
         _channels_by_tablet.emplace(tablet.tablet_id, std::move(channels));
     }
@@ -434,6 +503,63 @@ Status IndexChannel::add_row(Tuple* tuple, int64_t tablet_id) {
     return Status::OK();
 }
 
+Status IndexChannel::add_block(const vectorized::Block& block,
+                               const vectorized::ColumnInt64& tablet_ids) {
+    size_t rows = block.rows();
+    std::vector<const std::vector<uint32_t>*> channel_numbers(rows);
+    size_t max_replicas = 0;
+    for (size_t i = 0; i < rows; ++i) {
+        auto it = _channel_numbers_by_tablet.find(tablet_ids.getData()[i]);
+        DCHECK(it != _channel_numbers_by_tablet.end())
+                << "unknown tablet, tablet_id=" << tablet_ids.getData()[i];
+        channel_numbers[i] = &it->second;
+        max_replicas = std::max(max_replicas, it->second.size());
+    }
+
+    vectorized::Columns columns;
+    for (const auto& elem : block) {
+        columns.emplace_back(elem.column->convertToFullColumnIfConst());
+    }
+    // The replicas of a tablet are on different backends, so the k-th replicas of the rows
+    // are scattered to the node channels at once. The rows whose tablet has no k-th
+    // replica go to the extra last part, which is dropped.
+    size_t num_channels = _numbered_node_channels.size();
+    vectorized::IColumn::Selector selector(rows);
+    for (size_t k = 0; k < max_replicas; ++k) {
+        for (size_t i = 0; i < rows; ++i) {
+            const auto& numbers = *channel_numbers[i];
+            selector[i] = k < numbers.size() ? numbers[k] : num_channels;
+        }
+        std::vector<vectorized::MutableColumns> channel_columns(num_channels + 1);
+        for (const auto& column : columns) {
+            auto scattered = column->scatter(num_channels + 1, selector);
+            for (size_t j = 0; j < num_channels; ++j) {
+                channel_columns[j].emplace_back(std::move(scattered[j]));
+            }
+        }
+        auto channel_tablet_ids = tablet_ids.scatter(num_channels + 1, selector);
+        for (size_t j = 0; j < num_channels; ++j) {
+            if (channel_tablet_ids[j]->empty()) {
+                continue;
+            }
+            auto channel = _numbered_node_channels[j];
+            // if this node channel is already failed, this add_rows will be skipped
+            auto st = channel->add_rows(
+                    std::move(channel_columns[j]),
+                    assert_cast<const vectorized::ColumnInt64&>(*channel_tablet_ids[j]));
+            if (!st.ok()) {
+                mark_as_failed(channel);
+            }
+        }
+    }
+
+    if (has_intolerable_failure()) {
+        return Status::InternalError("index channel has intolerable failure");
+    }
+
+    return Status::OK();
+}
+
 bool IndexChannel::has_intolerable_failure() {
     return _failed_channels.size() >= ((_parent->_num_replicas + 1) / 2);
 }
@@ -37,6 +37,7 @@
 #include "util/spinlock.h"
 #include "util/thread.h"
 #include "util/thrift_util.h"
+#include "vec/columns/columns_number.h"
 
 namespace doris {
 
@@ -49,6 +50,10 @@ class TupleDescriptor;
 class ExprContext;
 class TExpr;
 
+namespace vectorized {
+class Block;
+}
+
 namespace stream_load {
 
 class OlapTableSink;
@@ -157,6 +162,11 @@ public:
 
     Status add_row(Tuple* tuple, int64_t tablet_id);
 
+    // add_row of the vectorized sink. Appends the rows of columns, which are the slots of the
+    // output tuple, tablet_ids gives the tablet of every row.
+    Status add_rows(vectorized::MutableColumns&& columns,
+                    const vectorized::ColumnInt64& tablet_ids);
+
     // two ways to stop channel:
     // 1. mark_close()->close_wait() PS. close_wait() will block waiting for the last AddBatch rpc response.
     // 2. just cancel()
@@ -198,6 +208,12 @@ public:
     void clear_all_batches();
 
 private:
+    // waits while the mem limit is exceeded and there are batches to send
+    void _wait_mem_limit();
+
+    // moves the rows appended by add_rows into _cur_add_batch_request as a serialized block
+    Status _serialize_cur_columns();
+
     OlapTableSink* _parent = nullptr;
     int64_t _index_id = -1;
     int64_t _node_id = -1;
@@ -228,6 +244,8 @@ private:
     std::unique_ptr<RowDescriptor> _row_desc;
     int _batch_size = 0;
     std::unique_ptr<RowBatch> _cur_batch;
+    // the rows appended by add_rows, the vectorized sink sends them instead of _cur_batch
+    vectorized::MutableColumns _cur_columns;
     PTabletWriterAddBatchRequest _cur_add_batch_request;
 
     std::mutex _pending_batches_lock;
@@ -259,6 +277,9 @@ public:
 
     Status add_row(Tuple* tuple, int64_t tablet_id);
 
+    // add_row of the vectorized sink, tablet_ids gives the tablet of every row of block.
+    Status add_block(const vectorized::Block& block, const vectorized::ColumnInt64& tablet_ids);
+
     void for_each_node_channel(const std::function<void(NodeChannel*)>& func) {
         for (auto& it : _node_channels) {
             func(it.second);
@@ -279,6 +300,10 @@ private:
     std::unordered_map<int64_t, NodeChannel*> _node_channels;
     // from tablet_id to backend channel
     std::unordered_map<int64_t, std::vector<NodeChannel*>> _channels_by_tablet;
+    // the backend channels numbered for add_block, and from tablet_id to the numbers of the
+    // channels of the tablet
+    std::vector<NodeChannel*> _numbered_node_channels;
+    std::unordered_map<int64_t, std::vector<uint32_t>> _channel_numbers_by_tablet;
     // BeId
     std::set<int64_t> _failed_channels;
 };
@@ -308,7 +333,7 @@ public:
     // Returns the runtime profile for the sink.
     RuntimeProfile* profile() override { return _profile; }
 
-private:
+protected:
     // convert input batch to output batch which will be loaded into OLAP table.
     // this is only used in insert statement.
     void _convert_batch(RuntimeState* state, RowBatch* input_batch, RowBatch* output_batch);
@@ -323,7 +348,7 @@ private:
     // only focus on pending batches and channel status, the internal errors of NodeChannels will be handled by the producer
     void _send_batch_process();
 
-private:
+protected:
     friend class NodeChannel;
     friend class IndexChannel;
 
@@ -338,6 +363,8 @@ private:
     int _num_replicas = -1;
     bool _need_gen_rollup = false;
     int _tuple_desc_id = -1;
+    // the node channels send vectorized blocks
+    bool _is_vectorized = false;
 
     // this is tuple descriptor of destination OLAP table
     TupleDescriptor* _output_tuple_desc = nullptr;
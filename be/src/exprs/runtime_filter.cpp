@@ -0,0 +1,314 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "exprs/runtime_filter.h"
+
+#include <cstring>
+
+#include "common/config.h"
+#include "runtime/datetime_value.h"
+#include "runtime/decimalv2_value.h"
+#include "runtime/string_value.hpp"
+
+namespace doris {
+
+static_assert(sizeof(DateTimeValue) <= 16 && sizeof(DecimalV2Value) <= 16,
+              "the min/max buffers of RuntimeFilter are too small");
+
+RuntimeFilter::RuntimeFilter(SlotId slot_id, PrimitiveType type, size_t expected_num)
+        : _slot_id(slot_id), _type(type), _expected_num(expected_num) {}
+
+RuntimeFilter::~RuntimeFilter() {}
+
+bool RuntimeFilter::is_supported_type(PrimitiveType type) {
+    switch (type) {
+    case TYPE_TINYINT:
+    case TYPE_SMALLINT:
+    case TYPE_INT:
+    case TYPE_BIGINT:
+    case TYPE_LARGEINT:
+    case TYPE_DATE:
+    case TYPE_DATETIME:
+    case TYPE_DECIMALV2:
+    case TYPE_CHAR:
+    case TYPE_VARCHAR:
+        return true;
+    default:
+        return false;
+    }
+}
+
+Status RuntimeFilter::init() {
+    DCHECK(is_supported_type(_type));
+    _in_values.reset(HybridSetBase::create_set(_type));
+    if (_in_values == nullptr) {
+        return Status::InternalError("fail to create the value set of the runtime filter");
+    }
+
+    // the storage compares the bytes of these types, see BloomFilterColumnPredicate
+    switch (_type) {
+    case TYPE_TINYINT:
+    case TYPE_SMALLINT:
+    case TYPE_INT:
+    case TYPE_BIGINT:
+    case TYPE_LARGEINT:
+    case TYPE_CHAR:
+    case TYPE_VARCHAR:
+        RETURN_IF_ERROR(
+                segment_v2::BloomFilter::create(segment_v2::BLOCK_BLOOM_FILTER, &_bloom_filter));
+        RETURN_IF_ERROR(_bloom_filter->init(_expected_num, config::runtime_filter_bloom_filter_fpp,
+                                            segment_v2::HASH_MURMUR3_X64_64));
+        break;
+    default:
+        break;
+    }
+    return Status::OK();
+}
+
+template <class T>
+void RuntimeFilter::_update_fixed_min_max(const void* data) {
+    T value;
+    memcpy(&value, data, sizeof(T));
+    T min;
+    T max;
+    memcpy(&min, _min, sizeof(T));
+    memcpy(&max, _max, sizeof(T));
+    if (_empty || value < min) {
+        memcpy(_min, &value, sizeof(T));
+    }
+    if (_empty || max < value) {
+        memcpy(_max, &value, sizeof(T));
+    }
+}
+
+void RuntimeFilter::_update_string_min_max(const StringValue* value) {
+    if (_empty || *value < _min_string_value) {
+        _min_string.assign(value->ptr, value->len);
+        _min_string_value = StringValue(const_cast<char*>(_min_string.data()), _min_string.size());
+    }
+    if (_empty || _max_string_value < *value) {
+        _max_string.assign(value->ptr, value->len);
+        _max_string_value = StringValue(const_cast<char*>(_max_string.data()), _max_string.size());
+    }
+}
+
+void RuntimeFilter::_update_min_max(const void* data) {
+    switch (_type) {
+    case TYPE_TINYINT:
+        _update_fixed_min_max<int8_t>(data);
+        break;
+    case TYPE_SMALLINT:
+        _update_fixed_min_max<int16_t>(data);
+        break;
+    case TYPE_INT:
+        _update_fixed_min_max<int32_t>(data);
+        break;
+    case TYPE_BIGINT:
+        _update_fixed_min_max<int64_t>(data);
+        break;
+    case TYPE_LARGEINT:
+        _update_fixed_min_max<__int128>(data);
+        break;
+    case TYPE_DATE:
+    case TYPE_DATETIME:
+        _update_fixed_min_max<DateTimeValue>(data);
+        break;
+    case TYPE_DECIMALV2:
+        _update_fixed_min_max<DecimalV2Value>(data);
+        break;
+    case TYPE_CHAR:
+    case TYPE_VARCHAR:
+        _update_string_min_max(reinterpret_cast<const StringValue*>(data));
+        break;
+    default:
+        DCHECK(false) << "unsupported type of runtime filter: " << _type;
+        return;
+    }
+    _empty = false;
+}
+
+void RuntimeFilter::_insert_bloom_filter(const void* data) {
+    char* bytes = nullptr;
+    uint32_t size = 0;
+    if (_is_string()) {
+        auto value = reinterpret_cast<const StringValue*>(data);
+        bytes = value->ptr;
+        size = value->len;
+    } else {
+        bytes = reinterpret_cast<char*>(const_cast<void*>(data));
+        size = get_byte_size(_type);
+    }
+    // add_bytes() takes a null pointer as the null value, which an empty string may have
+    _bloom_filter->add_hash(_bloom_filter->hash(bytes, size));
+}
+
+void RuntimeFilter::insert(const void* data) {
+    _update_min_max(data);
+
+    if (_in_values != nullptr) {
+        _in_values->insert(const_cast<void*>(data));
+        if (_in_values->size() > config::runtime_filter_max_in_num) {
+            _in_values.reset();
+        }
+    }
+    if (_bloom_filter != nullptr) {
+        _insert_bloom_filter(data);
+    }
+}
+
+// The fixed length values are sent in their in-memory format, as the rows between fragments.
+static void value_to_protobuf(PrimitiveType type, const void* data, std::string* bytes) {
+    if (type == TYPE_CHAR || type == TYPE_VARCHAR) {
+        auto value = reinterpret_cast<const StringValue*>(data);
+        bytes->assign(value->ptr, value->len);
+    } else {
+        bytes->assign(reinterpret_cast<const char*>(data), get_byte_size(type));
+    }
+}
+
+// Point value to the value of bytes, buf holds the fixed length value so that it is aligned.
+static Status value_from_protobuf(PrimitiveType type, const std::string& bytes, void* buf,
+                                  StringValue* string_value, const void** value) {
+    if (type == TYPE_CHAR || type == TYPE_VARCHAR) {
+        *string_value = StringValue(const_cast<char*>(bytes.data()), bytes.size());
+        *value = string_value;
+        return Status::OK();
+    }
+    if (bytes.size() != static_cast<size_t>(get_byte_size(type))) {
+        return Status::Corruption("the value of the runtime filter has a wrong size");
+    }
+    memcpy(buf, bytes.data(), bytes.size());
+    *value = buf;
+    return Status::OK();
+}
+
+Status RuntimeFilter::create_from_protobuf(const PRuntimeFilter& pfilter,
+                                           std::unique_ptr<RuntimeFilter>* filter) {
+    PrimitiveType type = thrift_to_type(static_cast<TPrimitiveType::type>(pfilter.type()));
+    if (!is_supported_type(type) || !pfilter.has_min_value() || !pfilter.has_max_value()) {
+        return Status::Corruption("the runtime filter is invalid");
+    }
+    filter->reset(new RuntimeFilter(pfilter.slot_id(), type, 0));
+    RuntimeFilter* result = filter->get();
+
+    alignas(16) char buf[16];
+    StringValue string_value;
+    const void* value = nullptr;
+    RETURN_IF_ERROR(value_from_protobuf(type, pfilter.min_value(), buf, &string_value, &value));
+    result->_update_min_max(value);
+    RETURN_IF_ERROR(value_from_protobuf(type, pfilter.max_value(), buf, &string_value, &value));
+    result->_update_min_max(value);
+
+    if (pfilter.has_in_values()) {
+        result->_in_values.reset(HybridSetBase::create_set(type));
+        if (result->_in_values == nullptr) {
+            return Status::InternalError("fail to create the value set of the runtime filter");
+        }
+        for (const auto& bytes : pfilter.in_values()) {
+            RETURN_IF_ERROR(value_from_protobuf(type, bytes, buf, &string_value, &value));
+            result->_in_values->insert(const_cast<void*>(value));
+        }
+    }
+
+    if (pfilter.has_bloom_filter()) {
+        const std::string& bytes = pfilter.bloom_filter();
+        // the block split bloom filter needs a power of 2 bytes, and a byte for the null flag
+        uint32_t num_bytes = bytes.size() - 1;
+        if (bytes.size() < segment_v2::BloomFilter::MINIMUM_BYTES + 1 ||
+            bytes.size() > segment_v2::BloomFilter::MAXIMUM_BYTES + 1 ||
+            (num_bytes & (num_bytes - 1)) != 0) {
+            return Status::Corruption("the bloom filter of the runtime filter is corrupted");
+        }
+        RETURN_IF_ERROR(segment_v2::BloomFilter::create(segment_v2::BLOCK_BLOOM_FILTER,
+                                                        &result->_bloom_filter));
+        RETURN_IF_ERROR(result->_bloom_filter->init(const_cast<char*>(bytes.data()), bytes.size(),
+                                                    segment_v2::HASH_MURMUR3_X64_64));
+    }
+    return Status::OK();
+}
+
+void RuntimeFilter::to_protobuf(PRuntimeFilter* pfilter) const {
+    DCHECK(!_empty);
+    pfilter->set_slot_id(_slot_id);
+    pfilter->set_type(to_thrift(_type));
+    value_to_protobuf(_type, min_value(), pfilter->mutable_min_value());
+    value_to_protobuf(_type, max_value(), pfilter->mutable_max_value());
+    if (_in_values != nullptr) {
+        pfilter->set_has_in_values(true);
+        HybridSetBase::IteratorBase* iter = _in_values->begin();
+        while (iter->has_next()) {
+            value_to_protobuf(_type, iter->get_value(), pfilter->add_in_values());
+            iter->next();
+        }
+    }
+    if (_bloom_filter != nullptr) {
+        pfilter->set_bloom_filter(_bloom_filter->data(), _bloom_filter->size());
+    }
+}
+
+Status RuntimeFilter::merge(const RuntimeFilter& other) {
+    DCHECK(_slot_id == other._slot_id && _type == other._type);
+    if (other._empty) {
+        return Status::OK();
+    }
+    _update_min_max(other.min_value());
+    _update_min_max(other.max_value());
+
+    if (_in_values != nullptr && other._in_values != nullptr) {
+        _in_values->insert(other._in_values.get());
+        if (_in_values->size() > config::runtime_filter_max_in_num) {
+            _in_values.reset();
+        }
+    } else {
+        _in_values.reset();
+    }
+
+    // the bloom filters of the joins are sized by their numbers of build rows
+    if (_bloom_filter != nullptr && other._bloom_filter != nullptr &&
+        _bloom_filter->size() == other._bloom_filter->size()) {
+        char* data = _bloom_filter->data();
+        const char* other_data = other._bloom_filter->data();
+        for (uint32_t i = 0; i < _bloom_filter->num_bytes(); ++i) {
+            data[i] |= other_data[i];
+        }
+    } else {
+        _bloom_filter.reset();
+    }
+    return Status::OK();
+}
+
+const void* RuntimeFilter::min_value() const {
+    DCHECK(!_empty);
+    if (_is_string()) {
+        return &_min_string_value;
+    }
+    return _min;
+}
+
+const void* RuntimeFilter::max_value() const {
+    DCHECK(!_empty);
+    if (_is_string()) {
+        return &_max_string_value;
+    }
+    return _max;
+}
+
+int64_t RuntimeFilter::allocated_bytes() const {
+    return _bloom_filter == nullptr ? 0 : _bloom_filter->size();
+}
+
+} // namespace doris
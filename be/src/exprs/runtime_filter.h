@@ -0,0 +1,121 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef DORIS_BE_SRC_EXPRS_RUNTIME_FILTER_H
+#define DORIS_BE_SRC_EXPRS_RUNTIME_FILTER_H
+
+#include <memory>
+#include <string>
+
+#include "common/global_types.h"
+#include "common/status.h"
+#include "exprs/hybrid_set.h"
+#include "gen_cpp/internal_service.pb.h"
+#include "olap/rowset/segment_v2/bloom_filter.h"
+#include "runtime/primitive_type.h"
+#include "runtime/string_value.h"
+
+namespace doris {
+
+// The values of a join key on the build side of a hash join, used to filter the
+// rows of the probe side before they are read from the storage.
+// A RuntimeFilter targets a slot of the probe side and keeps:
+//  - the min and the max value, which become a range condition of the scan;
+//  - the distinct values while there are at most config::runtime_filter_max_in_num of
+//    them, which become an IN condition of the scan;
+//  - a bloom filter of the values for the integer and string types, which is evaluated
+//    as a ColumnPredicate by the storage.
+// The nulls are never inserted: a null key does not match with the equal condition.
+// The filters of the instances of a join are sent to the scans of other fragments as
+// PRuntimeFilter, and merged there.
+class RuntimeFilter {
+public:
+    // expected_num is the number of values which will be inserted, to size the bloom filter
+    RuntimeFilter(SlotId slot_id, PrimitiveType type, size_t expected_num);
+    ~RuntimeFilter();
+
+    static bool is_supported_type(PrimitiveType type);
+
+    Status init();
+
+    // Create the filter sent by the hash join of another fragment.
+    static Status create_from_protobuf(const PRuntimeFilter& pfilter,
+                                       std::unique_ptr<RuntimeFilter>* filter);
+
+    void to_protobuf(PRuntimeFilter* pfilter) const;
+
+    // Merge the filter of another instance of the join, of the same slot: the values
+    // passing any of them pass the result. The bloom filter is dropped if the sizes of
+    // both differ.
+    Status merge(const RuntimeFilter& other);
+
+    // data points to a value in the in-memory format of the slot type, a StringValue
+    // for the strings.
+    void insert(const void* data);
+
+    SlotId slot_id() const { return _slot_id; }
+
+    PrimitiveType type() const { return _type; }
+
+    // true until a value is inserted, the min and max values are undefined before
+    bool empty() const { return _empty; }
+
+    const void* min_value() const;
+
+    const void* max_value() const;
+
+    // null once there are too many distinct values
+    HybridSetBase* in_values() const { return _in_values.get(); }
+
+    // null if the type is not supported by BloomFilterColumnPredicate
+    const segment_v2::BloomFilter* bloom_filter() const { return _bloom_filter.get(); }
+
+    int64_t allocated_bytes() const;
+
+private:
+    bool _is_string() const { return _type == TYPE_CHAR || _type == TYPE_VARCHAR; }
+
+    void _update_min_max(const void* data);
+
+    template <class T>
+    void _update_fixed_min_max(const void* data);
+
+    void _update_string_min_max(const StringValue* value);
+
+    void _insert_bloom_filter(const void* data);
+
+    SlotId _slot_id;
+    PrimitiveType _type;
+    size_t _expected_num;
+    bool _empty = true;
+
+    // the min and max values of the fixed length types
+    alignas(16) char _min[16];
+    alignas(16) char _max[16];
+    // the min and max values of the strings point to the copies
+    std::string _min_string;
+    std::string _max_string;
+    StringValue _min_string_value;
+    StringValue _max_string_value;
+
+    std::unique_ptr<HybridSetBase> _in_values;
+    std::unique_ptr<segment_v2::BloomFilter> _bloom_filter;
+};
+
+} // namespace doris
+
+#endif // DORIS_BE_SRC_EXPRS_RUNTIME_FILTER_H
@@ -0,0 +1,300 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/block_aggregator.h"
+
+#include "common/logging.h"
+#include "olap/hll.h"
+#include "olap/tablet_schema.h"
+#include "runtime/datetime_value.h"
+#include "util/bitmap_value.h"
+#include "vec/columns/column_decimal.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
+#include "vec/common/assert_cast.h"
+
+namespace doris {
+
+namespace {
+
+// The nested column of column, null_map is set to its null map if it is nullable.
+const vectorized::IColumn& remove_nullable(const vectorized::IColumn& column,
+                                           const vectorized::NullMap** null_map) {
+    *null_map = nullptr;
+    if (!column.isNullable()) {
+        return column;
+    }
+    const auto& nullable_column = assert_cast<const vectorized::ColumnNullable&>(column);
+    *null_map = &nullable_column.getNullMapData();
+    return nullable_column.getNestedColumn();
+}
+
+// The sum of the rows of every key, as AggregateFuncTraits the nulls are ignored and the sum is
+// null only if all the rows are.
+template <typename ColumnType>
+vectorized::ColumnPtr sum_runs(const vectorized::IColumn& column,
+                               const vectorized::IColumn::Permutation& run_ends) {
+    const vectorized::NullMap* null_map = nullptr;
+    const auto& data_column = remove_nullable(column, &null_map);
+    const auto& data = assert_cast<const ColumnType&>(data_column).getData();
+    using ValueType = std::decay_t<decltype(data[0])>;
+
+    auto result = data_column.cloneEmpty();
+    auto& result_data = assert_cast<ColumnType&>(*result).getData();
+    result_data.resize(run_ends.size());
+    auto result_null_map = vectorized::ColumnUInt8::create(run_ends.size(), 0);
+    size_t begin = 0;
+    for (size_t run = 0; run < run_ends.size(); ++run) {
+        ValueType sum {};
+        bool is_null = true;
+        for (size_t i = begin; i < run_ends[run]; ++i) {
+            if (null_map != nullptr && (*null_map)[i]) {
+                continue;
+            }
+            sum += data[i];
+            is_null = false;
+        }
+        result_data[run] = sum;
+        result_null_map->getData()[run] = is_null;
+        begin = run_ends[run];
+    }
+    if (null_map == nullptr) {
+        return result;
+    }
+    return vectorized::ColumnNullable::create(std::move(result), std::move(result_null_map));
+}
+
+OLAPStatus sum_runs(FieldType type, const vectorized::IColumn& column,
+                    const vectorized::IColumn::Permutation& run_ends,
+                    vectorized::ColumnPtr* result) {
+    switch (type) {
+    case OLAP_FIELD_TYPE_TINYINT:
+        *result = sum_runs<vectorized::ColumnInt8>(column, run_ends);
+        break;
+    case OLAP_FIELD_TYPE_SMALLINT:
+        *result = sum_runs<vectorized::ColumnInt16>(column, run_ends);
+        break;
+    case OLAP_FIELD_TYPE_INT:
+        *result = sum_runs<vectorized::ColumnInt32>(column, run_ends);
+        break;
+    case OLAP_FIELD_TYPE_BIGINT:
+        *result = sum_runs<vectorized::ColumnInt64>(column, run_ends);
+        break;
+    case OLAP_FIELD_TYPE_LARGEINT:
+        *result = sum_runs<vectorized::ColumnVector<vectorized::Int128>>(column, run_ends);
+        break;
+    case OLAP_FIELD_TYPE_FLOAT:
+        *result = sum_runs<vectorized::ColumnFloat32>(column, run_ends);
+        break;
+    case OLAP_FIELD_TYPE_DOUBLE:
+        *result = sum_runs<vectorized::ColumnFloat64>(column, run_ends);
+        break;
+    case OLAP_FIELD_TYPE_DECIMAL:
+        *result = sum_runs<vectorized::ColumnDecimal<vectorized::Decimal128>>(column, run_ends);
+        break;
+    default:
+        LOG(WARNING) << "unsupported type " << type << " of SUM for vectorized aggregation";
+        return OLAP_ERR_FUNC_NOT_IMPLEMENTED;
+    }
+    return OLAP_SUCCESS;
+}
+
+void merge_serialized(HyperLogLog* dst, const StringRef& value) {
+    dst->merge(HyperLogLog(Slice(value.data, value.size)));
+}
+
+void merge_serialized(BitmapValue* dst, const StringRef& value) {
+    *dst |= BitmapValue(value.data);
+}
+
+void serialize(const HyperLogLog& hll, std::string* buf) {
+    buf->resize(hll.max_serialized_size());
+    buf->resize(hll.serialize(reinterpret_cast<uint8_t*>(buf->data())));
+}
+
+void serialize(BitmapValue& bitmap, std::string* buf) {
+    buf->resize(bitmap.getSizeInBytes());
+    bitmap.write(buf->data());
+}
+
+// The union of the serialized HLL or BITMAP values of every key, nulls are ignored.
+template <typename T>
+vectorized::ColumnPtr union_runs(const vectorized::IColumn& column,
+                                 const vectorized::IColumn::Permutation& run_ends) {
+    const vectorized::NullMap* null_map = nullptr;
+    const auto& data_column = remove_nullable(column, &null_map);
+    auto result = column.cloneEmpty();
+    result->reserve(run_ends.size());
+    std::string buf;
+    size_t begin = 0;
+    for (size_t run = 0; run < run_ends.size(); ++run) {
+        T value;
+        size_t num_values = 0;
+        size_t last_value = begin;
+        for (size_t i = begin; i < run_ends[run]; ++i) {
+            if (null_map != nullptr && (*null_map)[i]) {
+                continue;
+            }
+            merge_serialized(&value, data_column.getDataAt(i));
+            ++num_values;
+            last_value = i;
+        }
+        if (num_values <= 1) {
+            // a single value is kept as loaded
+            result->insertFrom(column, last_value);
+        } else {
+            serialize(value, &buf);
+            result->insertData(buf.data(), buf.size());
+        }
+        begin = run_ends[run];
+    }
+    return result;
+}
+
+} // namespace
+
+vectorized::ColumnPtr BlockAggregator::comparable_column(
+        size_t cid, const vectorized::ColumnPtr& column) const {
+    auto type = _tablet_schema->column(cid).type();
+    if (type != OLAP_FIELD_TYPE_DATE && type != OLAP_FIELD_TYPE_DATETIME) {
+        return column;
+    }
+    // the vectorized DATE and DATETIME are DateTimeValues, which do not compare as Int128
+    const vectorized::NullMap* null_map = nullptr;
+    const auto& data_column = remove_nullable(*column, &null_map);
+    auto values = vectorized::ColumnInt64::create(column->size());
+    auto& data = values->getData();
+    for (size_t i = 0; i < data.size(); ++i) {
+        auto value = reinterpret_cast<const DateTimeValue*>(data_column.getDataAt(i).data);
+        data[i] = value->to_olap_datetime();
+    }
+    if (null_map == nullptr) {
+        return values;
+    }
+    const auto& nullable_column = assert_cast<const vectorized::ColumnNullable&>(*column);
+    return vectorized::ColumnNullable::create(std::move(values),
+                                              nullable_column.getNullMapColumnPtr());
+}
+
+
+OLAPStatus BlockAggregator::aggregate_column(size_t cid, const vectorized::ColumnPtr& column,
+                                             const vectorized::IColumn::Permutation& run_ends,
+                                             vectorized::ColumnPtr* result) const {
+    const auto& tablet_column = _tablet_schema->column(cid);
+    // the row of every key the result is taken from
+    vectorized::IColumn::Permutation rows(run_ends.size());
+    switch (tablet_column.aggregation()) {
+    case OLAP_FIELD_AGGREGATION_REPLACE:
+        for (size_t run = 0; run < run_ends.size(); ++run) {
+            rows[run] = run_ends[run] - 1;
+        }
+        break;
+    case OLAP_FIELD_AGGREGATION_REPLACE_IF_NOT_NULL: {
+        size_t begin = 0;
+        for (size_t run = 0; run < run_ends.size(); ++run) {
+            size_t row = run_ends[run] - 1;
+            while (row > begin && column->isNullAt(row)) {
+                --row;
+            }
+            rows[run] = row;
+            begin = run_ends[run];
+        }
+        break;
+    }
+    case OLAP_FIELD_AGGREGATION_MIN:
+    case OLAP_FIELD_AGGREGATION_MAX: {
+        // nulls are ignored, so they are the greatest for MIN and the least for MAX
+        bool is_min = tablet_column.aggregation() == OLAP_FIELD_AGGREGATION_MIN;
+        int null_direction = is_min ? 1 : -1;
+        auto values = comparable_column(cid, column);
+        size_t begin = 0;
+        for (size_t run = 0; run < run_ends.size(); ++run) {
+            size_t row = begin;
+            for (size_t i = begin + 1; i < run_ends[run]; ++i) {
+                int res = values->compareAt(i, row, *values, null_direction);
+                if (is_min ? res < 0 : res > 0) {
+                    row = i;
+                }
+            }
+            rows[run] = row;
+            begin = run_ends[run];
+        }
+        break;
+    }
+    case OLAP_FIELD_AGGREGATION_SUM:
+        return sum_runs(tablet_column.type(), *column, run_ends, result);
+    case OLAP_FIELD_AGGREGATION_HLL_UNION:
+        *result = union_runs<HyperLogLog>(*column, run_ends);
+        return OLAP_SUCCESS;
+    case OLAP_FIELD_AGGREGATION_BITMAP_UNION:
+        *result = union_runs<BitmapValue>(*column, run_ends);
+        return OLAP_SUCCESS;
+    default:
+        LOG(WARNING) << "unsupported aggregation " << tablet_column.aggregation() << " of column "
+                     << tablet_column.name() << " for vectorized aggregation";
+        return OLAP_ERR_FUNC_NOT_IMPLEMENTED;
+    }
+    *result = column->permute(rows, rows.size());
+    return OLAP_SUCCESS;
+}
+
+OLAPStatus BlockAggregator::aggregate(const vectorized::IColumn::Permutation& run_ends,
+                                      vectorized::Columns* columns) const {
+    size_t num_rows = columns->empty() ? 0 : (*columns)[0]->size();
+    if (run_ends.size() == num_rows) {
+        // every key has a single row
+        return OLAP_SUCCESS;
+    }
+    size_t num_keys = _tablet_schema->num_key_columns();
+    if (_tablet_schema->has_sequence_col()) {
+        // as agg_update_row_with_sequence, the values of a key are replaced by the last
+        // row with the greatest sequence
+        size_t sequence_idx = _tablet_schema->sequence_col_idx();
+        auto sequence = comparable_column(sequence_idx, (*columns)[sequence_idx]);
+        vectorized::IColumn::Permutation rows(run_ends.size());
+        size_t begin = 0;
+        for (size_t run = 0; run < run_ends.size(); ++run) {
+            size_t row = begin;
+            for (size_t i = begin + 1; i < run_ends[run]; ++i) {
+                if (sequence->compareAt(i, row, *sequence, -1) >= 0) {
+                    row = i;
+                }
+            }
+            rows[run] = row;
+            begin = run_ends[run];
+        }
+        for (size_t cid = num_keys; cid < columns->size(); ++cid) {
+            (*columns)[cid] = (*columns)[cid]->permute(rows, rows.size());
+        }
+    } else {
+        for (size_t cid = num_keys; cid < columns->size(); ++cid) {
+            vectorized::ColumnPtr result;
+            RETURN_NOT_OK(aggregate_column(cid, (*columns)[cid], run_ends, &result));
+            (*columns)[cid] = std::move(result);
+        }
+    }
+    vectorized::IColumn::Permutation firsts(run_ends.size());
+    for (size_t run = 0; run < run_ends.size(); ++run) {
+        firsts[run] = run == 0 ? 0 : run_ends[run - 1];
+    }
+    for (size_t cid = 0; cid < num_keys; ++cid) {
+        (*columns)[cid] = (*columns)[cid]->permute(firsts, firsts.size());
+    }
+    return OLAP_SUCCESS;
+}
+
+} // namespace doris
@@ -0,0 +1,54 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include "olap/olap_define.h"
+#include "vec/columns/column.h"
+
+namespace doris {
+
+class TabletSchema;
+
+// Aggregates the rows of the same key of vectorized columns, column by column, the way the
+// storage aggregates rows. Used by the vectorized memtable and by the block merge of
+// compactions.
+// The columns are in the order of the tablet schema, their values in the layout of the
+// vectorized engine.
+class BlockAggregator {
+public:
+    explicit BlockAggregator(const TabletSchema* tablet_schema)
+            : _tablet_schema(tablet_schema) {}
+
+    // The column cid of the tablet, comparable in the order of the storage.
+    vectorized::ColumnPtr comparable_column(size_t cid, const vectorized::ColumnPtr& column) const;
+
+    // Replaces the rows of every key of columns, which are sorted by the keys, by one row.
+    // The rows of a key end at run_ends, a later row of a key replaces an earlier one.
+    OLAPStatus aggregate(const vectorized::IColumn::Permutation& run_ends,
+                         vectorized::Columns* columns) const;
+
+    // Aggregates the sorted value column cid of the tablet, the rows of a key end at run_ends.
+    OLAPStatus aggregate_column(size_t cid, const vectorized::ColumnPtr& column,
+                                const vectorized::IColumn::Permutation& run_ends,
+                                vectorized::ColumnPtr* result) const;
+
+private:
+    const TabletSchema* _tablet_schema;
+};
+
+} // namespace doris
@@ -0,0 +1,155 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/bloom_filter_predicate.h"
+
+#include <cstring>
+
+#include "olap/field.h"
+#include "runtime/string_value.hpp"
+#include "runtime/vectorized_row_batch.h"
+
+namespace doris {
+
+BloomFilterColumnPredicate::BloomFilterColumnPredicate(uint32_t column_id, FieldType type,
+                                                       const segment_v2::BloomFilter* filter)
+        : ColumnPredicate(column_id),
+          _filter(filter),
+          _is_string(type == OLAP_FIELD_TYPE_CHAR || type == OLAP_FIELD_TYPE_VARCHAR),
+          _is_char(type == OLAP_FIELD_TYPE_CHAR),
+          _size(0) {
+    DCHECK(is_supported_type(type));
+    switch (type) {
+    case OLAP_FIELD_TYPE_TINYINT:
+        _size = sizeof(int8_t);
+        break;
+    case OLAP_FIELD_TYPE_SMALLINT:
+        _size = sizeof(int16_t);
+        break;
+    case OLAP_FIELD_TYPE_INT:
+        _size = sizeof(int32_t);
+        break;
+    case OLAP_FIELD_TYPE_BIGINT:
+        _size = sizeof(int64_t);
+        break;
+    case OLAP_FIELD_TYPE_LARGEINT:
+        _size = sizeof(int128_t);
+        break;
+    default:
+        break;
+    }
+}
+
+bool BloomFilterColumnPredicate::is_supported_type(FieldType type) {
+    switch (type) {
+    case OLAP_FIELD_TYPE_TINYINT:
+    case OLAP_FIELD_TYPE_SMALLINT:
+    case OLAP_FIELD_TYPE_INT:
+    case OLAP_FIELD_TYPE_BIGINT:
+    case OLAP_FIELD_TYPE_LARGEINT:
+    case OLAP_FIELD_TYPE_CHAR:
+    case OLAP_FIELD_TYPE_VARCHAR:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool BloomFilterColumnPredicate::_test(const void* cell) const {
+    if (_is_string) {
+        auto value = reinterpret_cast<const StringValue*>(cell);
+        size_t size = _is_char ? strnlen(value->ptr, value->len) : value->len;
+        return _filter->test_hash(_filter->hash(value->ptr, size));
+    }
+    return _filter->test_hash(
+            _filter->hash(reinterpret_cast<char*>(const_cast<void*>(cell)), _size));
+}
+
+void BloomFilterColumnPredicate::evaluate(VectorizedRowBatch* batch) const {
+    uint16_t n = batch->size();
+    if (n == 0) {
+        return;
+    }
+    uint16_t* sel = batch->selected();
+    auto column = batch->column(_column_id);
+    const char* col_vector = reinterpret_cast<const char*>(column->col_data());
+    size_t cell_size = _is_string ? sizeof(StringValue) : _size;
+    bool* is_null = column->no_nulls() ? nullptr : column->is_null();
+    uint16_t new_size = 0;
+    if (batch->selected_in_use()) {
+        for (uint16_t j = 0; j != n; ++j) {
+            uint16_t i = sel[j];
+            sel[new_size] = i;
+            new_size += (is_null == nullptr || !is_null[i]) && _test(col_vector + i * cell_size);
+        }
+        batch->set_size(new_size);
+    } else {
+        for (uint16_t i = 0; i != n; ++i) {
+            sel[new_size] = i;
+            new_size += (is_null == nullptr || !is_null[i]) && _test(col_vector + i * cell_size);
+        }
+        if (new_size < n) {
+            batch->set_size(new_size);
+            batch->set_selected_in_use(true);
+        }
+    }
+}
+
+void BloomFilterColumnPredicate::evaluate(ColumnBlock* block, uint16_t* sel,
+                                          uint16_t* size) const {
+    uint16_t new_size = 0;
+    bool is_nullable = block->is_nullable();
+    for (uint16_t i = 0; i < *size; ++i) {
+        uint16_t idx = sel[i];
+        sel[new_size] = idx;
+        new_size += (!is_nullable || !block->cell(idx).is_null()) && _test(block->cell_ptr(idx));
+    }
+    *size = new_size;
+}
+
+void BloomFilterColumnPredicate::evaluate_or(ColumnBlock* block, uint16_t* sel, uint16_t size,
+                                             bool* flags) const {
+    bool is_nullable = block->is_nullable();
+    for (uint16_t i = 0; i < size; ++i) {
+        if (flags[i]) continue;
+        uint16_t idx = sel[i];
+        flags[i] |= (!is_nullable || !block->cell(idx).is_null()) && _test(block->cell_ptr(idx));
+    }
+}
+
+void BloomFilterColumnPredicate::evaluate_and(ColumnBlock* block, uint16_t* sel, uint16_t size,
+                                              bool* flags) const {
+    bool is_nullable = block->is_nullable();
+    for (uint16_t i = 0; i < size; ++i) {
+        if (!flags[i]) continue;
+        uint16_t idx = sel[i];
+        flags[i] &= (!is_nullable || !block->cell(idx).is_null()) && _test(block->cell_ptr(idx));
+    }
+}
+
+Status BloomFilterColumnPredicate::evaluate(const Schema& schema,
+                                            const std::vector<BitmapIndexIterator*>& iterators,
+                                            uint32_t num_rows, Roaring* roaring) const {
+    if (iterators[_column_id] != nullptr && iterators[_column_id]->has_null_bitmap()) {
+        Roaring null_bitmap;
+        RETURN_IF_ERROR(iterators[_column_id]->read_null_bitmap(&null_bitmap));
+        *roaring -= null_bitmap;
+    }
+    return Status::OK();
+}
+
+} //namespace doris
@@ -0,0 +1,72 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef DORIS_BE_SRC_OLAP_BLOOM_FILTER_PREDICATE_H
+#define DORIS_BE_SRC_OLAP_BLOOM_FILTER_PREDICATE_H
+
+#include <stdint.h>
+
+#include <roaring/roaring.hh>
+
+#include "olap/column_predicate.h"
+#include "olap/olap_common.h"
+#include "olap/rowset/segment_v2/bloom_filter.h"
+
+namespace doris {
+
+class VectorizedRowBatch;
+
+// Keep the rows whose value may be in a bloom filter, the nulls never pass.
+// The bloom filter comes from the runtime filter of a hash join, see RuntimeFilter,
+// it is owned by the caller and must outlive the predicate.
+// The values are hashed by their bytes in the storage format, without the zero padding
+// of CHAR, so only the integer and string types are supported.
+class BloomFilterColumnPredicate : public ColumnPredicate {
+public:
+    BloomFilterColumnPredicate(uint32_t column_id, FieldType type,
+                               const segment_v2::BloomFilter* filter);
+
+    static bool is_supported_type(FieldType type);
+
+    virtual void evaluate(VectorizedRowBatch* batch) const override;
+
+    void evaluate(ColumnBlock* block, uint16_t* sel, uint16_t* size) const override;
+
+    void evaluate_or(ColumnBlock* block, uint16_t* sel, uint16_t size, bool* flags) const override;
+
+    void evaluate_and(ColumnBlock* block, uint16_t* sel, uint16_t size, bool* flags) const override;
+
+    virtual Status evaluate(const Schema& schema, const vector<BitmapIndexIterator*>& iterators,
+                            uint32_t num_rows, Roaring* roaring) const override;
+
+    // the bitmap index can only remove the nulls
+    bool can_use_bitmap_index() const override { return false; }
+
+private:
+    bool _test(const void* cell) const;
+
+    const segment_v2::BloomFilter* _filter;
+    bool _is_string;
+    // the CHAR values are padded with zeros
+    bool _is_char;
+    // the size of the values of the integer types
+    uint32_t _size;
+};
+
+} //namespace doris
+
+#endif //DORIS_BE_SRC_OLAP_BLOOM_FILTER_PREDICATE_H
@@ -52,6 +52,10 @@ public:
                             const std::vector<BitmapIndexIterator*>& iterators, uint32_t num_rows,
                             Roaring* roaring) const = 0;
 
+    // false if the bitmap index can not fully evaluate the predicate, it is then
+    // evaluated on the column blocks as well
+    virtual bool can_use_bitmap_index() const { return true; }
+
     uint32_t column_id() const { return _column_id; }
 
 protected:
@@ -31,6 +31,22 @@ Status ColumnVectorBatch::resize(size_t new_cap) {
     return Status::OK();
 }
 
+void ColumnVectorBatch::append_dict_codes(const segment_v2::BinaryPlainPageDecoder* dict,
+                                          size_t offset, const int32_t* codes, size_t n) {
+    if (_dict_codes_stopped) {
+        return;
+    }
+    if (_dict != nullptr && _dict != dict) {
+        _dict_codes_stopped = true;
+        return;
+    }
+    _dict = dict;
+    if (_dict_codes.size() < offset + n) {
+        _dict_codes.resize(std::max(offset + n, _capacity));
+    }
+    memcpy(_dict_codes.data() + offset, codes, n * sizeof(int32_t));
+}
+
 Status ColumnVectorBatch::create(size_t init_capacity, bool is_nullable, const TypeInfo* type_info,
                                  Field* field,
                                  std::unique_ptr<ColumnVectorBatch>* column_vector_batch) {
@@ -24,6 +24,10 @@
 
 namespace doris {
 
+namespace segment_v2 {
+class BinaryPlainPageDecoder;
+} // namespace segment_v2
+
 template <class T>
 class DataBuffer {
 private:
@@ -123,12 +127,39 @@ public:
     static Status create(size_t init_capacity, bool is_nullable, const TypeInfo* type_info,
                          Field* field, std::unique_ptr<ColumnVectorBatch>* column_vector_batch);
 
+    // The codes in the dictionary dict() of the string values read from dictionary encoded
+    // pages, see BinaryDictPageDecoder, so that the values can be compared and grouped by
+    // their codes. The code of row i is dict_codes()[i], the codes of null rows are undefined.
+    // The codes are valid only if all the values written since reset_dict_codes() are of
+    // dictionary encoded pages of the same dictionary.
+    bool has_dict_codes() const { return _dict != nullptr && !_dict_codes_stopped; }
+
+    const segment_v2::BinaryPlainPageDecoder* dict() const { return _dict; }
+
+    const int32_t* dict_codes() const { return _dict_codes.data(); }
+
+    // Set the codes of the n rows from offset.
+    void append_dict_codes(const segment_v2::BinaryPlainPageDecoder* dict, size_t offset,
+                           const int32_t* codes, size_t n);
+
+    // Values not in a dictionary are written, the codes are no longer valid.
+    void stop_dict_codes() { _dict_codes_stopped = true; }
+
+    void reset_dict_codes() {
+        _dict = nullptr;
+        _dict_codes_stopped = false;
+    }
+
 private:
     const TypeInfo* _type_info;
     size_t _capacity;
     DelCondSatisfied _delete_state;
     const bool _nullable;
     DataBuffer<bool> _null_signs;
+
+    const segment_v2::BinaryPlainPageDecoder* _dict = nullptr;
+    std::vector<int32_t> _dict_codes;
+    bool _dict_codes_stopped = false;
 };
 
 template <class ScalarCppType>
@@ -158,6 +158,11 @@ OLAPStatus DeltaWriter::init() {
     } else {
         writer_context.rowset_type = ALPHA_ROWSET;
     }
+    if (_req.is_vec && writer_context.rowset_type != BETA_ROWSET) {
+        LOG(WARNING) << "vectorized load is only supported for beta rowset. tablet: "
+                     << _tablet->full_name();
+        return OLAP_ERR_FUNC_NOT_IMPLEMENTED;
+    }
     writer_context.rowset_path_prefix = _tablet->tablet_path();
     writer_context.tablet_schema = &(_tablet->tablet_schema());
     writer_context.rowset_state = PREPARED;
@@ -190,7 +195,25 @@ OLAPStatus DeltaWriter::write(Tuple* tuple) {
     }
 
     _mem_table->insert(tuple);
+    return _flush_memtable_if_full();
+}
+
+OLAPStatus DeltaWriter::write(const vectorized::Block* block) {
+    DCHECK(_req.is_vec);
+    std::lock_guard<SpinLock> l(_lock);
+    if (!_is_init && !_is_cancelled) {
+        RETURN_NOT_OK(init());
+    }
+
+    if (_is_cancelled) {
+        return OLAP_ERR_ALREADY_CANCELLED;
+    }
+
+    _mem_table->insert(block);
+    return _flush_memtable_if_full();
+}
 
+OLAPStatus DeltaWriter::_flush_memtable_if_full() {
     // if memtable is full, push it to the flush executor,
     // and create a new memtable for incoming data
     if (_mem_table->memory_usage() >= config::write_buffer_size) {
@@ -255,7 +278,7 @@ OLAPStatus DeltaWriter::wait_flush() {
 void DeltaWriter::_reset_mem_table() {
     _mem_table.reset(new MemTable(_tablet->tablet_id(), _schema.get(), _tablet_schema, _req.slots,
                                   _req.tuple_desc, _tablet->keys_type(), _rowset_writer.get(),
-                                  _mem_tracker));
+                                  _mem_tracker, _req.is_vec));
 }
 
 OLAPStatus DeltaWriter::close() {
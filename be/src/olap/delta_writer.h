@@ -34,6 +34,10 @@ class Tuple;
 class TupleDescriptor;
 class SlotDescriptor;
 
+namespace vectorized {
+class Block;
+} // namespace vectorized
+
 enum WriteType { LOAD = 1, LOAD_DELETE = 2, DELETE = 3 };
 
 struct WriteRequest {
@@ -47,6 +51,8 @@ struct WriteRequest {
     TupleDescriptor* tuple_desc;
     // slots are in order of tablet's schema
     const std::vector<SlotDescriptor*>* slots;
+    // the rows are written in blocks, only to tablets of beta rowsets
+    bool is_vec = false;
 };
 
 // Writer for a particular (load, index, tablet).
@@ -61,6 +67,8 @@ public:
     OLAPStatus init();
 
     OLAPStatus write(Tuple* tuple);
+    // Only for a vectorized write request, the columns of block are in order of tablet's schema.
+    OLAPStatus write(const vectorized::Block* block);
     // flush the last memtable to flush queue, must call it before close_wait()
     OLAPStatus close();
     // wait for all memtables to be flushed.
@@ -92,6 +100,9 @@ private:
     // push a full memtable to flush executor
     OLAPStatus _flush_memtable_async();
 
+    // flush the memtable if it is full, after rows are written
+    OLAPStatus _flush_memtable_if_full();
+
     void _garbage_collection();
 
     void _reset_mem_table();
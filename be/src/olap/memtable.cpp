@@ -17,7 +17,10 @@
 
 #include "olap/memtable.h"
 
+#include <algorithm>
+
 #include "common/logging.h"
+#include "olap/block_aggregator.h"
 #include "olap/row.h"
 #include "olap/row_cursor.h"
 #include "olap/rowset/column_data_writer.h"
@@ -32,7 +35,7 @@ namespace doris {
 MemTable::MemTable(int64_t tablet_id, Schema* schema, const TabletSchema* tablet_schema,
                    const std::vector<SlotDescriptor*>* slot_descs, TupleDescriptor* tuple_desc,
                    KeysType keys_type, RowsetWriter* rowset_writer,
-                   const std::shared_ptr<MemTracker>& parent_tracker)
+                   const std::shared_ptr<MemTracker>& parent_tracker, bool is_vec)
         : _tablet_id(tablet_id),
           _schema(schema),
           _tablet_schema(tablet_schema),
@@ -46,10 +49,12 @@ MemTable::MemTable(int64_t tablet_id, Schema* schema, const TabletSchema* tablet
           _schema_size(_schema->schema_size()),
           _skip_list(new Table(_row_comparator, _table_mem_pool.get(),
                                _keys_type == KeysType::DUP_KEYS)),
-          _rowset_writer(rowset_writer) {}
+          _rowset_writer(rowset_writer),
+          _is_vec(is_vec) {}
 
 MemTable::~MemTable() {
     delete _skip_list;
+    _mem_tracker->Release(_input_bytes);
 }
 
 MemTable::RowCursorComparator::RowCursorComparator(const Schema* schema) : _schema(schema) {}
@@ -95,6 +100,23 @@ void MemTable::insert(const Tuple* tuple) {
     _buffer_mem_pool->clear();
 }
 
+void MemTable::insert(const vectorized::Block* block) {
+    DCHECK(_is_vec);
+    if (_input_columns.empty()) {
+        _input_header = block->cloneEmpty();
+        _input_columns = _input_header.cloneEmptyColumns();
+    }
+    DCHECK_EQ(block->columns(), _input_columns.size());
+    int64_t input_bytes = 0;
+    for (size_t i = 0; i < _input_columns.size(); ++i) {
+        auto column = block->getByPosition(i).column->convertToFullColumnIfConst();
+        _input_columns[i]->insertRangeFrom(*column, 0, column->size());
+        input_bytes += _input_columns[i]->allocatedBytes();
+    }
+    _mem_tracker->Consume(input_bytes - _input_bytes);
+    _input_bytes = input_bytes;
+}
+
 void MemTable::_tuple_to_row(const Tuple* tuple, ContiguousRow* row, MemPool* mem_pool) {
     for (size_t i = 0; i < _slot_descs->size(); ++i) {
         auto cell = row->cell(i);
@@ -117,24 +139,92 @@ void MemTable::_aggregate_two_row(const ContiguousRow& src_row, TableKey row_in_
     }
 }
 
+OLAPStatus MemTable::_sort_and_aggregate(vectorized::Block* block) {
+    size_t num_rows = _input_columns.empty() ? 0 : _input_columns[0]->size();
+    if (num_rows == 0) {
+        return OLAP_SUCCESS;
+    }
+    vectorized::Columns columns;
+    for (auto& column : _input_columns) {
+        columns.emplace_back(std::move(column));
+    }
+    _input_columns.clear();
+
+    BlockAggregator aggregator(_tablet_schema);
+    size_t num_keys = _tablet_schema->num_key_columns();
+    vectorized::Columns key_columns;
+    for (size_t cid = 0; cid < num_keys; ++cid) {
+        key_columns.push_back(aggregator.comparable_column(cid, columns[cid]));
+    }
+    auto compare_keys = [&key_columns](size_t lhs, size_t rhs) {
+        for (const auto& column : key_columns) {
+            // nulls first, as the storage
+            int res = column->compareAt(lhs, rhs, *column, -1);
+            if (res != 0) {
+                return res;
+            }
+        }
+        return 0;
+    };
+
+    // The sort is stable, the rows of a key stay in the order they are loaded in,
+    // which REPLACE depends on.
+    vectorized::IColumn::Permutation perm(num_rows);
+    for (size_t i = 0; i < num_rows; ++i) {
+        perm[i] = i;
+    }
+    std::stable_sort(perm.begin(), perm.end(), [&compare_keys](size_t lhs, size_t rhs) {
+        return compare_keys(lhs, rhs) < 0;
+    });
+
+    // the rows of every key end at run_ends after they are sorted
+    vectorized::IColumn::Permutation run_ends;
+    if (_keys_type != KeysType::DUP_KEYS) {
+        for (size_t i = 1; i < num_rows; ++i) {
+            if (compare_keys(perm[i - 1], perm[i]) != 0) {
+                run_ends.push_back(i);
+            }
+        }
+        run_ends.push_back(num_rows);
+    }
+    key_columns.clear();
+
+    for (auto& column : columns) {
+        column = column->permute(perm, num_rows);
+    }
+
+    if (!run_ends.empty()) {
+        RETURN_NOT_OK(aggregator.aggregate(run_ends, &columns));
+    }
+    *block = _input_header.cloneWithColumns(columns);
+    return OLAP_SUCCESS;
+}
+
 OLAPStatus MemTable::flush() {
     int64_t duration_ns = 0;
     {
         SCOPED_RAW_TIMER(&duration_ns);
-        OLAPStatus st = _rowset_writer->flush_single_memtable(this, &_flush_size);
-        if (st == OLAP_ERR_FUNC_NOT_IMPLEMENTED) {
-            // For alpha rowset, we do not implement "flush_single_memtable".
-            // Flush the memtable like the old way.
-            Table::Iterator it(_skip_list);
-            for (it.SeekToFirst(); it.Valid(); it.Next()) {
-                char* row = (char*)it.key();
-                ContiguousRow dst_row(_schema, row);
-                agg_finalize_row(&dst_row, _table_mem_pool.get());
-                RETURN_NOT_OK(_rowset_writer->add_row(dst_row));
-            }
-            RETURN_NOT_OK(_rowset_writer->flush());
+        if (_is_vec) {
+            // only beta rowsets are written from blocks, see DeltaWriter::init()
+            vectorized::Block block;
+            RETURN_NOT_OK(_sort_and_aggregate(&block));
+            RETURN_NOT_OK(_rowset_writer->flush_single_memtable(&block, &_flush_size));
         } else {
-            RETURN_NOT_OK(st);
+            OLAPStatus st = _rowset_writer->flush_single_memtable(this, &_flush_size);
+            if (st == OLAP_ERR_FUNC_NOT_IMPLEMENTED) {
+                // For alpha rowset, we do not implement "flush_single_memtable".
+                // Flush the memtable like the old way.
+                Table::Iterator it(_skip_list);
+                for (it.SeekToFirst(); it.Valid(); it.Next()) {
+                    char* row = (char*)it.key();
+                    ContiguousRow dst_row(_schema, row);
+                    agg_finalize_row(&dst_row, _table_mem_pool.get());
+                    RETURN_NOT_OK(_rowset_writer->add_row(dst_row));
+                }
+                RETURN_NOT_OK(_rowset_writer->flush());
+            } else {
+                RETURN_NOT_OK(st);
+            }
         }
     }
     DorisMetrics::instance()->memtable_flush_total->increment(1);
@@ -24,6 +24,7 @@
 #include "olap/olap_define.h"
 #include "olap/skiplist.h"
 #include "runtime/mem_tracker.h"
+#include "vec/core/block.h"
 
 namespace doris {
 
@@ -40,12 +41,14 @@ public:
     MemTable(int64_t tablet_id, Schema* schema, const TabletSchema* tablet_schema,
              const std::vector<SlotDescriptor*>* slot_descs, TupleDescriptor* tuple_desc,
              KeysType keys_type, RowsetWriter* rowset_writer,
-             const std::shared_ptr<MemTracker>& parent_tracker);
+             const std::shared_ptr<MemTracker>& parent_tracker, bool is_vec = false);
     ~MemTable();
 
     int64_t tablet_id() const { return _tablet_id; }
     size_t memory_usage() const { return _mem_tracker->consumption(); }
     void insert(const Tuple* tuple);
+    // Only for a vectorized memtable. The columns of block are in order of tablet's schema.
+    void insert(const vectorized::Block* block);
     /// Flush 
     OLAPStatus flush();
     OLAPStatus close();
@@ -87,6 +90,10 @@ private:
     void _tuple_to_row(const Tuple* tuple, ContiguousRow* row, MemPool* mem_pool);
     void _aggregate_two_row(const ContiguousRow& new_row, TableKey row_in_skiplist);
 
+    // Sorts the rows of the vectorized memtable by the keys, and aggregates the rows of
+    // every key into one for the AGG and UNIQUE models.
+    OLAPStatus _sort_and_aggregate(vectorized::Block* block);
+
     int64_t _tablet_id;
     Schema* _schema;
     const TabletSchema* _tablet_schema;
@@ -115,6 +122,13 @@ private:
     // the data size flushed on disk of this memtable
     int64_t _flush_size = 0;
 
+    // A vectorized memtable appends the input blocks to _input_columns, and only sorts and
+    // aggregates them when it is flushed, instead of inserting every row into _skip_list.
+    const bool _is_vec;
+    vectorized::Block _input_header;
+    vectorized::MutableColumns _input_columns;
+    int64_t _input_bytes = 0;
+
 }; // class MemTable
 
 inline std::ostream& operator<<(std::ostream& os, const MemTable& table) {
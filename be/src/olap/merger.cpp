@@ -17,6 +17,7 @@
 
 #include "olap/merger.h"
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 
@@ -24,10 +25,113 @@
 #include "olap/reader.h"
 #include "olap/row_cursor.h"
 #include "olap/tablet.h"
+#include "olap/vcollect_iterator.h"
 #include "util/trace.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_string.h"
+#include "vec/data_types/data_types_decimal.h"
+#include "vec/data_types/data_types_number.h"
 
 namespace doris {
 
+namespace {
+
+// The vectorized block of all the columns of the tablet, in the layout RowBlockV2 converts the
+// values to. Returns false if a column can not be read by block.
+bool create_block(const TabletSchema& tablet_schema, vectorized::Block* block) {
+    for (size_t cid = 0; cid < tablet_schema.num_columns(); ++cid) {
+        const auto& column = tablet_schema.column(cid);
+        vectorized::DataTypePtr type;
+        switch (column.type()) {
+        case OLAP_FIELD_TYPE_BOOL:
+        case OLAP_FIELD_TYPE_TINYINT:
+            type = std::make_shared<vectorized::DataTypeInt8>();
+            break;
+        case OLAP_FIELD_TYPE_SMALLINT:
+            type = std::make_shared<vectorized::DataTypeInt16>();
+            break;
+        case OLAP_FIELD_TYPE_INT:
+            type = std::make_shared<vectorized::DataTypeInt32>();
+            break;
+        case OLAP_FIELD_TYPE_BIGINT:
+            type = std::make_shared<vectorized::DataTypeInt64>();
+            break;
+        case OLAP_FIELD_TYPE_LARGEINT:
+        case OLAP_FIELD_TYPE_DATE:
+        case OLAP_FIELD_TYPE_DATETIME:
+            type = std::make_shared<vectorized::DataTypeInt128>();
+            break;
+        case OLAP_FIELD_TYPE_FLOAT:
+            type = std::make_shared<vectorized::DataTypeFloat32>();
+            break;
+        case OLAP_FIELD_TYPE_DOUBLE:
+            type = std::make_shared<vectorized::DataTypeFloat64>();
+            break;
+        case OLAP_FIELD_TYPE_CHAR:
+        case OLAP_FIELD_TYPE_VARCHAR:
+        case OLAP_FIELD_TYPE_HLL:
+        case OLAP_FIELD_TYPE_OBJECT:
+            type = std::make_shared<vectorized::DataTypeString>();
+            break;
+        case OLAP_FIELD_TYPE_DECIMAL:
+            type = std::make_shared<vectorized::DataTypeDecimal<vectorized::Decimal128>>(27, 9);
+            break;
+        default:
+            return false;
+        }
+        if (column.is_nullable()) {
+            type = vectorized::makeNullable(type);
+        }
+        block->insert({type->createColumn(), type, column.name()});
+    }
+    return true;
+}
+
+// Whether the rows of the rowsets can be merged column group by column group.
+bool use_vertical_merge(const TabletSchema& tablet_schema,
+                        const std::vector<RowsetReaderSharedPtr>& rs_readers) {
+    if (!config::enable_vertical_compaction ||
+        rs_readers.size() >= RowSourcesBuffer::MAX_CHILDREN) {
+        return false;
+    }
+    // the values of a key are not those of its last row with a sequence column, which the row
+    // sources can not tell
+    if (tablet_schema.has_sequence_col()) {
+        return false;
+    }
+    size_t num_value_columns = tablet_schema.num_columns() - tablet_schema.num_key_columns();
+    if (num_value_columns <= config::vertical_compaction_num_columns_per_group) {
+        return false;
+    }
+    for (auto& rs_reader : rs_readers) {
+        if (rs_reader->rowset()->rowset_meta()->rowset_type() != BETA_ROWSET) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// The size of an output segment of a vertical merge is not known before all its column groups
+// are written, so its rows are estimated by the average row size of the input rowsets.
+uint32_t estimate_max_rows_per_segment(const std::vector<RowsetReaderSharedPtr>& rs_readers) {
+    int64_t num_rows = 0;
+    int64_t data_size = 0;
+    for (auto& rs_reader : rs_readers) {
+        num_rows += rs_reader->rowset()->num_rows();
+        data_size += rs_reader->rowset()->data_disk_size();
+    }
+    if (num_rows == 0 || data_size == 0) {
+        return UINT32_MAX;
+    }
+    double max_segment_size =
+            OLAP_MAX_COLUMN_SEGMENT_FILE_SIZE * OLAP_COLUMN_FILE_SEGMENT_SIZE_SCALE;
+    double max_rows = max_segment_size * num_rows / data_size;
+    return static_cast<uint32_t>(std::max(1.0, std::min<double>(UINT32_MAX, max_rows)));
+}
+
+} // namespace
+
 OLAPStatus Merger::merge_rowsets(TabletSharedPtr tablet, ReaderType reader_type,
                                  const std::vector<RowsetReaderSharedPtr>& src_rowset_readers,
                                  RowsetWriter* dst_rowset_writer,
@@ -40,8 +144,34 @@ OLAPStatus Merger::merge_rowsets(TabletSharedPtr tablet, ReaderType reader_type,
     reader_params.reader_type = reader_type;
     reader_params.rs_readers = src_rowset_readers;
     reader_params.version = dst_rowset_writer->version();
+    // the output rowsets of the compactions of such tablets are beta rowsets, which can be
+    // written by block
+    vectorized::Block header;
+    reader_params.read_by_block =
+            config::enable_vectorized_compaction &&
+            tablet->tablet_meta()->preferred_rowset_type() == BETA_ROWSET &&
+            create_block(tablet->tablet_schema(), &header);
+    if (reader_params.read_by_block &&
+        use_vertical_merge(tablet->tablet_schema(), src_rowset_readers)) {
+        return _vertical_merge_rowsets(tablet, reader_type, src_rowset_readers, header,
+                                       dst_rowset_writer, stats_output);
+    }
     RETURN_NOT_OK(reader.init(reader_params));
 
+    int64_t output_rows = 0;
+    if (reader.support_block_read()) {
+        RETURN_NOT_OK(_merge_by_block(tablet, &reader, header, dst_rowset_writer, &output_rows));
+        if (stats_output != nullptr) {
+            stats_output->output_rows = output_rows;
+            stats_output->merged_rows = reader.merged_rows();
+            stats_output->filtered_rows = reader.filtered_rows();
+        }
+        RETURN_NOT_OK_LOG(
+                dst_rowset_writer->flush(),
+                "failed to flush rowset when merging rowsets of tablet " + tablet->full_name());
+        return OLAP_SUCCESS;
+    }
+
     RowCursor row_cursor;
     RETURN_NOT_OK_LOG(
             row_cursor.init(tablet->tablet_schema()),
@@ -52,7 +182,6 @@ OLAPStatus Merger::merge_rowsets(TabletSharedPtr tablet, ReaderType reader_type,
     std::unique_ptr<MemPool> mem_pool(new MemPool(tracker.get()));
 
     // The following procedure would last for long time, half of one day, etc.
-    int64_t output_rows = 0;
     while (true) {
         ObjectPool objectPool;
         bool eof = false;
@@ -88,4 +217,118 @@ OLAPStatus Merger::merge_rowsets(TabletSharedPtr tablet, ReaderType reader_type,
     return OLAP_SUCCESS;
 }
 
+OLAPStatus Merger::_merge_by_block(TabletSharedPtr tablet, Reader* reader,
+                                   const vectorized::Block& header,
+                                   RowsetWriter* dst_rowset_writer, int64_t* output_rows) {
+    while (true) {
+        vectorized::Block block = header.cloneEmpty();
+        bool eof = false;
+        RETURN_NOT_OK_LOG(
+                reader->next_block(&block, &eof),
+                "failed to read next block when merging rowsets of tablet " + tablet->full_name());
+        if (eof) {
+            break;
+        }
+        RETURN_NOT_OK_LOG(
+                dst_rowset_writer->add_block(&block),
+                "failed to write block when merging rowsets of tablet " + tablet->full_name());
+        int64_t step = config::row_step_for_compaction_merge_log;
+        LOG_IF(INFO, step != 0 && (*output_rows + block.rows()) / step != *output_rows / step)
+                << "Merge rowsets stay alive. "
+                << "tablet=" << tablet->full_name()
+                << ", merged rows=" << *output_rows + block.rows();
+        *output_rows += block.rows();
+    }
+    return OLAP_SUCCESS;
+}
+
+OLAPStatus Merger::_vertical_merge_rowsets(
+        TabletSharedPtr tablet, ReaderType reader_type,
+        const std::vector<RowsetReaderSharedPtr>& src_rowset_readers,
+        const vectorized::Block& header, RowsetWriter* dst_rowset_writer,
+        Merger::Statistics* stats_output) {
+    // the key columns, then the value columns split into groups
+    const auto& tablet_schema = tablet->tablet_schema();
+    size_t num_key_columns = tablet_schema.num_key_columns();
+    std::vector<std::vector<uint32_t>> column_groups(1);
+    for (uint32_t cid = 0; cid < tablet_schema.num_columns(); ++cid) {
+        if (cid >= num_key_columns &&
+            (column_groups.size() == 1 ||
+             column_groups.back().size() >= config::vertical_compaction_num_columns_per_group)) {
+            column_groups.emplace_back();
+        }
+        column_groups.back().push_back(cid);
+    }
+    uint32_t max_rows_per_segment = estimate_max_rows_per_segment(src_rowset_readers);
+
+    RowSourcesBuffer row_sources;
+    int64_t output_rows = 0;
+    for (size_t group = 0; group < column_groups.size(); ++group) {
+        const auto& column_ids = column_groups[group];
+        bool is_key = group == 0;
+        ReaderParams reader_params;
+        reader_params.tablet = tablet;
+        reader_params.reader_type = reader_type;
+        reader_params.version = dst_rowset_writer->version();
+        reader_params.read_by_block = true;
+        reader_params.row_sources = &row_sources;
+        reader_params.is_key_column_group = is_key;
+        reader_params.return_columns = column_ids;
+        if (is_key) {
+            reader_params.rs_readers = src_rowset_readers;
+        } else {
+            // the rowsets are read again, with the key columns to merge their overlapping
+            // segments as the merge of the key columns did
+            reader_params.return_columns.insert(reader_params.return_columns.end(),
+                                                column_groups[0].begin(), column_groups[0].end());
+            for (auto& src_rowset_reader : src_rowset_readers) {
+                RowsetReaderSharedPtr rs_reader;
+                RETURN_NOT_OK(src_rowset_reader->rowset()->create_reader(&rs_reader));
+                reader_params.rs_readers.push_back(std::move(rs_reader));
+            }
+        }
+        Reader reader;
+        RETURN_NOT_OK(reader.init(reader_params));
+        DCHECK(reader.support_block_read());
+
+        vectorized::Block group_header;
+        for (auto cid : column_ids) {
+            group_header.insert(header.getByPosition(cid).cloneEmpty());
+        }
+        int64_t group_rows = 0;
+        while (true) {
+            vectorized::Block block = group_header.cloneEmpty();
+            bool eof = false;
+            RETURN_NOT_OK_LOG(reader.next_block(&block, &eof),
+                              "failed to read next block when merging rowsets of tablet " +
+                                      tablet->full_name());
+            if (eof) {
+                break;
+            }
+            RETURN_NOT_OK_LOG(
+                    dst_rowset_writer->add_columns(&block, column_ids, is_key,
+                                                   max_rows_per_segment),
+                    "failed to write block when merging rowsets of tablet " + tablet->full_name());
+            group_rows += block.rows();
+        }
+        RETURN_NOT_OK_LOG(dst_rowset_writer->flush_columns(is_key),
+                          "failed to flush columns when merging rowsets of tablet " +
+                                  tablet->full_name());
+        if (is_key) {
+            output_rows = group_rows;
+            if (stats_output != nullptr) {
+                stats_output->output_rows = output_rows;
+                stats_output->merged_rows = reader.merged_rows();
+                stats_output->filtered_rows = reader.filtered_rows();
+            }
+        }
+        VLOG_NOTICE << "merged column group " << group << " of " << column_groups.size()
+                    << ", tablet=" << tablet->full_name() << ", rows=" << group_rows;
+    }
+    RETURN_NOT_OK_LOG(
+            dst_rowset_writer->final_flush(),
+            "failed to flush rowset when merging rowsets of tablet " + tablet->full_name());
+    return OLAP_SUCCESS;
+}
+
 } // namespace doris
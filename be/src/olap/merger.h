@@ -24,6 +24,12 @@
 
 namespace doris {
 
+class Reader;
+
+namespace vectorized {
+class Block;
+} // namespace vectorized
+
 class Merger {
 public:
     struct Statistics {
@@ -39,6 +45,22 @@ public:
     static OLAPStatus merge_rowsets(TabletSharedPtr tablet, ReaderType reader_type,
                                     const std::vector<RowsetReaderSharedPtr>& src_rowset_readers,
                                     RowsetWriter* dst_rowset_writer, Statistics* stats_output);
+
+private:
+    // The vertical merge of the rowsets of a tablet with many value columns, which bounds the
+    // columns read and written at a time. The key columns of all the rowsets are merged first,
+    // recording the source of every row, then the value columns are merged group by group in
+    // the same order. The output segments are written column group by column group.
+    static OLAPStatus _vertical_merge_rowsets(
+            TabletSharedPtr tablet, ReaderType reader_type,
+            const std::vector<RowsetReaderSharedPtr>& src_rowset_readers,
+            const vectorized::Block& header, RowsetWriter* dst_rowset_writer,
+            Statistics* stats_output);
+
+    // Writes the blocks read by reader, the merged and aggregated rows of a compaction.
+    static OLAPStatus _merge_by_block(TabletSharedPtr tablet, Reader* reader,
+                                      const vectorized::Block& header,
+                                      RowsetWriter* dst_rowset_writer, int64_t* output_rows);
 };
 
 } // namespace doris
@@ -20,6 +20,7 @@
 #include <boost/algorithm/string/case_conv.hpp>
 #include <sstream>
 
+#include "olap/bloom_filter_predicate.h"
 #include "olap/collect_iterator.h"
 #include "olap/comparison_predicate.h"
 #include "olap/in_list_predicate.h"
@@ -31,6 +32,7 @@
 #include "olap/rowset/beta_rowset_reader.h"
 #include "olap/storage_engine.h"
 #include "olap/tablet.h"
+#include "olap/vcollect_iterator.h"
 #include "runtime/mem_pool.h"
 #include "runtime/mem_tracker.h"
 #include "runtime/string_value.hpp"
@@ -391,8 +393,28 @@ OLAPStatus Reader::_capture_rs_readers(const ReaderParams& read_params) {
     _reader_context.stats = &_stats;
     _reader_context.runtime_state = read_params.runtime_state;
     _reader_context.use_page_cache = read_params.use_page_cache;
+    _read_by_block = read_params.read_by_block && _can_read_by_block(read_params);
+    if (_read_by_block && read_params.reader_type != READER_QUERY) {
+        if (read_params.row_sources != nullptr && !read_params.is_key_column_group) {
+            _vvalue_group_iter.reset(new VValueGroupIterator(
+                    &_tablet->tablet_schema(), _return_columns, read_params.row_sources));
+        } else {
+            _vcollect_iter.reset(new VCollectIterator(&_tablet->tablet_schema(),
+                                                      _tablet->keys_type()));
+            _vcollect_iter->set_row_sources(read_params.row_sources);
+        }
+    }
     for (auto& rs_reader : *rs_readers) {
         RETURN_NOT_OK(rs_reader->init(&_reader_context));
+        if (_read_by_block) {
+            if (_vcollect_iter != nullptr) {
+                _vcollect_iter->add_child(rs_reader);
+            } else if (_vvalue_group_iter != nullptr) {
+                _vvalue_group_iter->add_child(rs_reader);
+            }
+            _rs_readers.push_back(rs_reader);
+            continue;
+        }
         OLAPStatus res = _collect_iter->add_child(rs_reader);
         if (res != OLAP_SUCCESS && res != OLAP_ERR_DATA_EOF) {
             LOG(WARNING) << "failed to add child to iterator, err=" << res;
@@ -402,11 +424,82 @@ OLAPStatus Reader::_capture_rs_readers(const ReaderParams& read_params) {
             _rs_readers.push_back(rs_reader);
         }
     }
+    if (_read_by_block) {
+        // next_block() merges the rowset readers with _vcollect_iter for compactions, and
+        // reads them one after another otherwise
+        return OLAP_SUCCESS;
+    }
     _collect_iter->build_heap();
     _next_key = _collect_iter->current_row(&_next_delete_flag);
     return OLAP_SUCCESS;
 }
 
+bool Reader::_can_read_by_block(const ReaderParams& read_params) const {
+    if (read_params.reader_type == READER_BASE_COMPACTION ||
+        read_params.reader_type == READER_CUMULATIVE_COMPACTION) {
+        // the rows of all the rowsets are merged by the keys and aggregated by VCollectIterator
+        for (auto& rs_reader : read_params.rs_readers) {
+            if (rs_reader->rowset()->rowset_meta()->rowset_type() != BETA_ROWSET) {
+                return false;
+            }
+        }
+        return true;
+    }
+    if (read_params.reader_type != READER_QUERY) {
+        return false;
+    }
+    bool has_delete_rowset = false;
+    bool has_overlapping = false;
+    int nonoverlapping_count = 0;
+    for (auto& rs_reader : read_params.rs_readers) {
+        auto rowset_meta = rs_reader->rowset()->rowset_meta();
+        if (rowset_meta->rowset_type() != BETA_ROWSET) {
+            return false;
+        }
+        if (rowset_meta->delete_flag()) {
+            has_delete_rowset = true;
+        } else if (rowset_meta->num_rows() > 0) {
+            if (rowset_meta->is_segments_overlapping()) {
+                has_overlapping = true;
+            } else {
+                ++nonoverlapping_count;
+            }
+        }
+    }
+    // only the cases in which init() chooses _direct_next_row()
+    switch (_tablet->keys_type()) {
+    case KeysType::DUP_KEYS:
+        return true;
+    case KeysType::UNIQUE_KEYS:
+        return !has_overlapping && nonoverlapping_count == 1 && !has_delete_rowset;
+    default:
+        return false;
+    }
+}
+
+OLAPStatus Reader::next_block(vectorized::Block* block, bool* eof) {
+    DCHECK(_read_by_block);
+    if (_vcollect_iter != nullptr) {
+        RETURN_NOT_OK(_vcollect_iter->next_block(block, eof));
+        _merged_rows = _vcollect_iter->merged_rows();
+        return OLAP_SUCCESS;
+    }
+    if (_vvalue_group_iter != nullptr) {
+        return _vvalue_group_iter->next_block(block, eof);
+    }
+    while (_block_rs_reader_idx < _rs_readers.size()) {
+        auto res = _rs_readers[_block_rs_reader_idx]->next_block(block);
+        if (res == OLAP_ERR_DATA_EOF) {
+            ++_block_rs_reader_idx;
+            continue;
+        }
+        *eof = false;
+        return res;
+    }
+    *eof = true;
+    return OLAP_SUCCESS;
+}
+
 OLAPStatus Reader::_init_params(const ReaderParams& read_params) {
     read_params.check_validation();
 
@@ -495,6 +588,25 @@ OLAPStatus Reader::_init_return_columns(const ReaderParams& read_params) {
                 _value_cids.push_back(id);
             }
         }
+    } else if (read_params.row_sources != nullptr) {
+        // a column group of a vertical compaction, every merge must read the same rows so the
+        // columns of the delete conditions are read as well
+        _return_columns = read_params.return_columns;
+        set<uint32_t> column_set(_return_columns.begin(), _return_columns.end());
+        for (const auto& conds : _delete_handler.get_delete_conditions()) {
+            for (const auto& cond_column : conds.del_cond->columns()) {
+                if (column_set.insert(cond_column.first).second) {
+                    _return_columns.push_back(cond_column.first);
+                }
+            }
+        }
+        for (auto id : _return_columns) {
+            if (_tablet->tablet_schema().column(id).is_key()) {
+                _key_cids.push_back(id);
+            } else {
+                _value_cids.push_back(id);
+            }
+        }
     } else {
         OLAP_LOG_WARNING("fail to init return columns. [reader_type=%d return_columns_size=%u]",
                          read_params.reader_type, read_params.return_columns.size());
@@ -599,6 +711,22 @@ void Reader::_init_conditions_param(const ReaderParams& read_params) {
             }
         }
     }
+
+    // the aggregated value columns can only be filtered after the merge, the bloom filters
+    // are skipped for them since the hash join checks the keys anyway
+    for (const auto& bloom_filter : read_params.bloom_filters) {
+        int32_t index = _tablet->field_index(bloom_filter.first);
+        if (index < 0) {
+            continue;
+        }
+        const TabletColumn& column = _tablet->tablet_schema().column(index);
+        if (column.aggregation() != FieldAggregationMethod::OLAP_FIELD_AGGREGATION_NONE ||
+            !BloomFilterColumnPredicate::is_supported_type(column.type())) {
+            continue;
+        }
+        _col_predicates.push_back(
+                new BloomFilterColumnPredicate(index, column.type(), bloom_filter.second));
+    }
 }
 
 #define COMPARISON_PREDICATE_CONDITION_VALUE(NAME, PREDICATE)                                   \
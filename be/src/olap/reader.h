@@ -36,6 +36,7 @@
 #include "olap/olap_define.h"
 #include "olap/row_cursor.h"
 #include "olap/rowset/rowset_reader.h"
+#include "olap/rowset/segment_v2/bloom_filter.h"
 #include "olap/tablet.h"
 #include "util/runtime_profile.h"
 
@@ -46,6 +47,12 @@ class RowCursor;
 class RowBlock;
 class CollectIterator;
 class RuntimeState;
+class RowSourcesBuffer;
+class VCollectIterator;
+class VValueGroupIterator;
+namespace vectorized {
+class Block;
+} // namespace vectorized
 
 // Params for Reader,
 // mainly include tablet, data version and fetch range.
@@ -68,11 +75,23 @@ struct ReaderParams {
     std::vector<OlapTuple> start_key;
     std::vector<OlapTuple> end_key;
     std::vector<TCondition> conditions;
+    // (column name, bloom filter) of the runtime filters of the hash joins, the bloom
+    // filters are owned by the caller
+    std::vector<std::pair<std::string, const segment_v2::BloomFilter*>> bloom_filters;
     // The ColumnData will be set when using Merger, eg Cumulative, BE.
     std::vector<RowsetReaderSharedPtr> rs_readers;
     std::vector<uint32_t> return_columns;
     RuntimeProfile* profile = nullptr;
     RuntimeState* runtime_state = nullptr;
+    // try to read the rows column by column with Reader::next_block(),
+    // Reader::support_block_read() tells whether it is possible. Compactions merge and
+    // aggregate the blocks of the rowsets with a VCollectIterator.
+    bool read_by_block = false;
+    // For the vertical compactions reading by block, see Merger::vertical_merge_rowsets(): the
+    // sources of the merged rows, which the merge of the key columns records and the merges
+    // of the value columns follow.
+    RowSourcesBuffer* row_sources = nullptr;
+    bool is_key_column_group = false;
 
     void check_validation() const;
 
@@ -98,6 +117,18 @@ public:
         return (this->*_next_row_func)(row_cursor, mem_pool, agg_pool, eof);
     }
 
+    // Whether next_block() can be used instead of next_row_with_aggregation(). Only when
+    // ReaderParams::read_by_block is set, all the rowsets are beta rowsets and either the
+    // rows are returned as they are stored, without merging or aggregation, or the reader
+    // is a compaction one.
+    bool support_block_read() const { return _read_by_block; }
+
+    // Read the next rows into the columns of *block, the columns of *block are the first
+    // return columns of ReaderParams, in the same order.
+    // Return OLAP_SUCCESS and set `*eof` to true when no more rows can be read.
+    // Return others when unexpected error happens.
+    OLAPStatus next_block(vectorized::Block* block, bool* eof);
+
     uint64_t merged_rows() const { return _merged_rows; }
 
     uint64_t filtered_rows() const {
@@ -126,6 +157,8 @@ private:
 
     OLAPStatus _capture_rs_readers(const ReaderParams& read_params);
 
+    bool _can_read_by_block(const ReaderParams& read_params) const;
+
     OLAPStatus _init_keys_param(const ReaderParams& read_params);
 
     void _init_conditions_param(const ReaderParams& read_params);
@@ -197,6 +230,13 @@ private:
     int32_t _sequence_col_idx = -1;
     const RowCursor* _next_key = nullptr;
     std::unique_ptr<CollectIterator> _collect_iter;
+    // the rowset readers are read one after another by next_block(), bypassing _collect_iter
+    bool _read_by_block = false;
+    size_t _block_rs_reader_idx = 0;
+    // merges the blocks of the rowset readers for the compactions reading by block
+    std::unique_ptr<VCollectIterator> _vcollect_iter;
+    // merges the value columns of the vertical compactions
+    std::unique_ptr<VValueGroupIterator> _vvalue_group_iter;
     std::vector<uint32_t> _key_cids;
     std::vector<uint32_t> _value_cids;
 
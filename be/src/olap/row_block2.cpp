@@ -21,7 +21,17 @@
 
 #include "gutil/strings/substitute.h"
 #include "olap/row_cursor.h"
+#include "olap/rowset/segment_v2/binary_plain_page.h"
+#include "runtime/datetime_value.h"
+#include "runtime/decimalv2_value.h"
 #include "util/bitmap.h"
+#include "vec/columns/column_low_cardinality.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/column_vector.h"
+#include "vec/common/assert_cast.h"
+#include "vec/common/unaligned.h"
+#include "vec/core/block.h"
 
 using strings::Substitute;
 namespace doris {
@@ -86,6 +96,223 @@ Status RowBlockV2::convert_to_row_block(RowCursor* helper, RowBlock* dst) {
     return Status::OK();
 }
 
+Status RowBlockV2::convert_to_vec_block(vectorized::Block* block) {
+    DCHECK_LE(block->columns(), _schema.num_column_ids());
+    for (size_t i = 0; i < block->columns(); ++i) {
+        ColumnId cid = _schema.column_ids()[i];
+        auto& column_with_type = block->getByPosition(i);
+        if (column_with_type.column->lowCardinality()) {
+            RETURN_IF_ERROR(_append_to_low_cardinality_column(cid, &column_with_type.column));
+            continue;
+        }
+        auto column = (*std::move(block->getByPosition(i).column)).mutate();
+        RETURN_IF_ERROR(_append_to_vec_column(cid, column.get()));
+        block->getByPosition(i).column = std::move(column);
+    }
+    return Status::OK();
+}
+
+namespace {
+
+template <typename T>
+void append_numbers(const ColumnBlock& column_block, const uint16_t* selection_vector,
+                    uint16_t selected_size, vectorized::IColumn* column) {
+    auto& data = assert_cast<vectorized::ColumnVector<T>*>(column)->getData();
+    data.reserve(data.size() + selected_size);
+    for (uint16_t i = 0; i < selected_size; ++i) {
+        data.push_back(unalignedLoad<T>(column_block.cell_ptr(selection_vector[i])));
+    }
+}
+
+} // namespace
+
+Status RowBlockV2::_append_to_vec_column(ColumnId cid, vectorized::IColumn* column) {
+    ColumnBlock column_block = this->column_block(cid);
+    bool is_nullable = column_block.is_nullable();
+
+    vectorized::IColumn* data_column = column;
+    if (column->isNullable()) {
+        auto* nullable_column = assert_cast<vectorized::ColumnNullable*>(column);
+        auto& null_map = nullable_column->getNullMapData();
+        null_map.reserve(null_map.size() + _selected_size);
+        for (uint16_t i = 0; i < _selected_size; ++i) {
+            null_map.push_back(is_nullable && column_block.is_null(_selection_vector[i]));
+        }
+        data_column = &nullable_column->getNestedColumn();
+    } else if (is_nullable) {
+        for (uint16_t i = 0; i < _selected_size; ++i) {
+            if (column_block.is_null(_selection_vector[i])) {
+                return Status::InternalError(
+                        Substitute("null value for not nullable column $0", cid));
+            }
+        }
+    }
+
+    // Fixed length values are copied even for null rows, the nested value of a null
+    // is never read. Null slices may point to anything, so they are skipped.
+    switch (_schema.column(cid)->type()) {
+    case OLAP_FIELD_TYPE_BOOL:
+    case OLAP_FIELD_TYPE_TINYINT:
+        append_numbers<vectorized::Int8>(column_block, _selection_vector, _selected_size,
+                                         data_column);
+        break;
+    case OLAP_FIELD_TYPE_SMALLINT:
+        append_numbers<vectorized::Int16>(column_block, _selection_vector, _selected_size,
+                                          data_column);
+        break;
+    case OLAP_FIELD_TYPE_INT:
+        append_numbers<vectorized::Int32>(column_block, _selection_vector, _selected_size,
+                                          data_column);
+        break;
+    case OLAP_FIELD_TYPE_BIGINT:
+        append_numbers<vectorized::Int64>(column_block, _selection_vector, _selected_size,
+                                          data_column);
+        break;
+    case OLAP_FIELD_TYPE_LARGEINT:
+        append_numbers<vectorized::Int128>(column_block, _selection_vector, _selected_size,
+                                           data_column);
+        break;
+    case OLAP_FIELD_TYPE_FLOAT:
+        append_numbers<vectorized::Float32>(column_block, _selection_vector, _selected_size,
+                                            data_column);
+        break;
+    case OLAP_FIELD_TYPE_DOUBLE:
+        append_numbers<vectorized::Float64>(column_block, _selection_vector, _selected_size,
+                                            data_column);
+        break;
+    case OLAP_FIELD_TYPE_CHAR:
+        for (uint16_t i = 0; i < _selected_size; ++i) {
+            uint16_t row_idx = _selection_vector[i];
+            if (is_nullable && column_block.is_null(row_idx)) {
+                data_column->insertDefault();
+                continue;
+            }
+            auto slice = reinterpret_cast<const Slice*>(column_block.cell_ptr(row_idx));
+            // the char values are padded with zeros
+            data_column->insertData(slice->data, strnlen(slice->data, slice->size));
+        }
+        break;
+    case OLAP_FIELD_TYPE_VARCHAR:
+    case OLAP_FIELD_TYPE_HLL:
+    case OLAP_FIELD_TYPE_OBJECT:
+        for (uint16_t i = 0; i < _selected_size; ++i) {
+            uint16_t row_idx = _selection_vector[i];
+            if (is_nullable && column_block.is_null(row_idx)) {
+                data_column->insertDefault();
+                continue;
+            }
+            auto slice = reinterpret_cast<const Slice*>(column_block.cell_ptr(row_idx));
+            data_column->insertData(slice->data, slice->size);
+        }
+        break;
+    case OLAP_FIELD_TYPE_DATE:
+        for (uint16_t i = 0; i < _selected_size; ++i) {
+            auto ptr = column_block.cell_ptr(_selection_vector[i]);
+            uint64_t value = ptr[2];
+            value <<= 8;
+            value |= ptr[1];
+            value <<= 8;
+            value |= ptr[0];
+            DateTimeValue date(value);
+            data_column->insertData(reinterpret_cast<const char*>(&date), sizeof(date));
+        }
+        break;
+    case OLAP_FIELD_TYPE_DATETIME:
+        for (uint16_t i = 0; i < _selected_size; ++i) {
+            auto value = unalignedLoad<uint64_t>(column_block.cell_ptr(_selection_vector[i]));
+            DateTimeValue datetime(value);
+            data_column->insertData(reinterpret_cast<const char*>(&datetime), sizeof(datetime));
+        }
+        break;
+    case OLAP_FIELD_TYPE_DECIMAL:
+        for (uint16_t i = 0; i < _selected_size; ++i) {
+            auto ptr = column_block.cell_ptr(_selection_vector[i]);
+            int64_t int_value = unalignedLoad<int64_t>(ptr);
+            int32_t frac_value = unalignedLoad<int32_t>(ptr + sizeof(int64_t));
+            DecimalV2Value decimal(int_value, frac_value);
+            data_column->insertData(reinterpret_cast<const char*>(&decimal), sizeof(decimal));
+        }
+        break;
+    default:
+        return Status::NotSupported(Substitute("unsupported type $0 for vectorized read",
+                                               _schema.column(cid)->type()));
+    }
+    return Status::OK();
+}
+
+Status RowBlockV2::_append_to_low_cardinality_column(ColumnId cid, vectorized::ColumnPtr* column) {
+    const auto& low_cardinality = assert_cast<const vectorized::ColumnLowCardinality&>(**column);
+    ColumnBlock column_block = this->column_block(cid);
+    const ColumnVectorBatch* batch = column_block.vector_batch();
+    bool nullable = low_cardinality.getDictionary().isNullable();
+
+    const vectorized::ColumnPtr* dictionary = nullptr;
+    if (batch->has_dict_codes()) {
+        dictionary = &_vec_dictionary(cid, batch->dict(), nullable);
+        if (low_cardinality.size() > 0 && low_cardinality.getDictionaryPtr() != *dictionary) {
+            dictionary = nullptr;
+        }
+    }
+    if (dictionary == nullptr) {
+        // the values are not all of the same dictionary, they are decoded
+        auto full_column = (*std::move(low_cardinality.convertToFullColumn())).mutate();
+        RETURN_IF_ERROR(_append_to_vec_column(cid, full_column.get()));
+        *column = std::move(full_column);
+        return Status::OK();
+    }
+
+    auto codes = vectorized::ColumnUInt32::create();
+    auto& data = codes->getData();
+    data.reserve(low_cardinality.size() + _selected_size);
+    data.insert(low_cardinality.getCodes().begin(), low_cardinality.getCodes().end());
+    const int32_t* dict_codes = batch->dict_codes();
+    // the null is the value after the last one of the dictionary
+    vectorized::UInt32 null_code = batch->dict()->count();
+    bool is_nullable = column_block.is_nullable();
+    for (uint16_t i = 0; i < _selected_size; ++i) {
+        uint16_t row_idx = _selection_vector[i];
+        if (is_nullable && column_block.is_null(row_idx)) {
+            if (!nullable) {
+                return Status::InternalError(
+                        Substitute("null value for not nullable column $0", cid));
+            }
+            data.push_back(null_code);
+            continue;
+        }
+        data.push_back(dict_codes[row_idx]);
+    }
+    *column = vectorized::ColumnLowCardinality::create(*dictionary, std::move(codes));
+    return Status::OK();
+}
+
+const vectorized::ColumnPtr& RowBlockV2::_vec_dictionary(
+        ColumnId cid, const segment_v2::BinaryPlainPageDecoder* dict, bool nullable) {
+    auto& vec_dictionary = _vec_dictionaries[cid];
+    if (vec_dictionary.dict == dict && vec_dictionary.column->isNullable() == nullable) {
+        return vec_dictionary.column;
+    }
+    size_t count = dict->count();
+    bool is_char = _schema.column(cid)->type() == OLAP_FIELD_TYPE_CHAR;
+    auto strings = vectorized::ColumnString::create();
+    strings->reserve(count + nullable);
+    for (size_t i = 0; i < count; ++i) {
+        Slice slice = dict->string_at_index(i);
+        // the char values are padded with zeros
+        strings->insertData(slice.data, is_char ? strnlen(slice.data, slice.size) : slice.size);
+    }
+    vec_dictionary.dict = dict;
+    if (nullable) {
+        strings->insertDefault();
+        auto null_map = vectorized::ColumnUInt8::create(count + 1, 0);
+        null_map->getData()[count] = 1;
+        vec_dictionary.column = vectorized::ColumnNullable::create(std::move(strings),
+                                                                   std::move(null_map));
+    } else {
+        vec_dictionary.column = std::move(strings);
+    }
+    return vec_dictionary.column;
+}
+
 std::string RowBlockRow::debug_string() const {
     std::stringstream ss;
     ss << "[";
@@ -19,6 +19,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <unordered_map>
 #include <vector>
 
 #include "common/status.h"
@@ -29,6 +30,7 @@
 #include "olap/types.h"
 #include "runtime/mem_pool.h"
 #include "runtime/mem_tracker.h"
+#include "vec/columns/column.h"
 
 namespace doris {
 
@@ -36,6 +38,14 @@ class MemPool;
 class RowBlockRow;
 class RowCursor;
 
+namespace segment_v2 {
+class BinaryPlainPageDecoder;
+} // namespace segment_v2
+
+namespace vectorized {
+class Block;
+} // namespace vectorized
+
 // This struct contains a block of rows, in which each column's data is stored
 // in a vector. We don't use VectorizedRowBatch because it doesn't own the data
 // in block, however it is used by old code, which we don't want to change.
@@ -66,11 +76,23 @@ public:
             _selection_vector[i] = i;
         }
         _delete_state = DEL_NOT_SATISFIED;
+        for (auto cid : _schema.column_ids()) {
+            if (_column_vector_batches[cid] != nullptr) {
+                _column_vector_batches[cid]->reset_dict_codes();
+            }
+        }
     }
 
     // convert RowBlockV2 to RowBlock
     Status convert_to_row_block(RowCursor* helper, RowBlock* dst);
 
+    // Append the selected rows to the columns of a vectorized Block, column by column.
+    // The i-th column of `block` receives the column of `schema()->column_ids()[i]`,
+    // columns after the last one of `block` are skipped.
+    // A ColumnLowCardinality of `block` receives the dictionary codes of the column if it has
+    // them, see ColumnVectorBatch::has_dict_codes(), else it is replaced by its full column.
+    Status convert_to_vec_block(vectorized::Block* block);
+
     // low-level API to access memory for each column block(including data array and nullmap).
     // `cid` must be one of `schema()->column_ids()`.
     ColumnBlock column_block(ColumnId cid) const {
@@ -103,6 +125,17 @@ public:
     }
 
 private:
+    Status _append_to_vec_column(ColumnId cid, vectorized::IColumn* column);
+
+    // Appends the dictionary codes of the column cid to the ColumnLowCardinality *column.
+    Status _append_to_low_cardinality_column(ColumnId cid, vectorized::ColumnPtr* column);
+
+    // The dictionary of the column cid as a vectorized column, a nullable one with the null as
+    // its last value if nullable.
+    const vectorized::ColumnPtr& _vec_dictionary(ColumnId cid,
+                                                 const segment_v2::BinaryPlainPageDecoder* dict,
+                                                 bool nullable);
+
     Schema _schema;
     size_t _capacity;
     // _column_vector_batches[cid] == null if cid is not in `_schema`.
@@ -121,6 +154,14 @@ private:
 
     // block delete state
     DelCondSatisfied _delete_state;
+
+    // the last vectorized dictionary of every column, the dictionaries of a segment live as
+    // long as its iterator, they are shared by all the blocks read from it
+    struct VecDictionary {
+        const segment_v2::BinaryPlainPageDecoder* dict = nullptr;
+        vectorized::ColumnPtr column;
+    };
+    std::unordered_map<ColumnId, VecDictionary> _vec_dictionaries;
 };
 
 // Stands for a row in RowBlockV2. It is consisted of a RowBlockV2 reference
@@ -151,4 +151,30 @@ OLAPStatus BetaRowsetReader::next_block(RowBlock** block) {
     return OLAP_SUCCESS;
 }
 
+OLAPStatus BetaRowsetReader::next_block(vectorized::Block* block) {
+    SCOPED_RAW_TIMER(&_stats->block_fetch_ns);
+    do {
+        _input_block->clear();
+        auto s = _iterator->next_batch(_input_block.get());
+        if (!s.ok()) {
+            if (s.is_end_of_file()) {
+                return OLAP_ERR_DATA_EOF;
+            }
+            LOG(WARNING) << "failed to read next block: " << s.to_string();
+            return OLAP_ERR_ROWSET_READ_FAILED;
+        }
+        // all the rows of the batch may be filtered by the predicates
+    } while (_input_block->selected_size() == 0);
+
+    {
+        SCOPED_RAW_TIMER(&_stats->block_convert_ns);
+        auto s = _input_block->convert_to_vec_block(block);
+        if (!s.ok()) {
+            LOG(WARNING) << "failed to convert block: " << s.to_string();
+            return OLAP_ERR_ROWSET_READ_FAILED;
+        }
+    }
+    return OLAP_SUCCESS;
+}
+
 } // namespace doris
@@ -40,6 +40,9 @@ public:
     // It's ok, because we only get ref here, the block's owner is this reader.
     OLAPStatus next_block(RowBlock** block) override;
 
+    // The selected rows of the segments are copied column by column, no RowCursor is involved.
+    OLAPStatus next_block(vectorized::Block* block) override;
+
     bool delete_flag() override { return _rowset->delete_flag(); }
 
     Version version() override { return _rowset->version(); }
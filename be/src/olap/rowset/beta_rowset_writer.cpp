@@ -33,12 +33,15 @@
 #include "olap/rowset/segment_v2/segment_writer.h"
 #include "olap/storage_engine.h"
 #include "runtime/exec_env.h"
+#include "vec/core/block.h"
 
 namespace doris {
 
 // TODO(lingbin): Should be a conf that can be dynamically adjusted, or a member in the context
 const uint32_t MAX_SEGMENT_SIZE = static_cast<uint32_t>(OLAP_MAX_COLUMN_SEGMENT_FILE_SIZE *
                                                         OLAP_COLUMN_FILE_SEGMENT_SIZE_SCALE);
+// The rows of a vectorized block appended to a segment at a time.
+const size_t BLOCK_APPEND_BATCH_SIZE = 4096;
 
 BetaRowsetWriter::BetaRowsetWriter()
         : _rowset_meta(nullptr),
@@ -52,6 +55,7 @@ BetaRowsetWriter::~BetaRowsetWriter() {
     // TODO(lingbin): Should wrapper exception logic, no need to know file ops directly.
     if (!_already_built) {       // abnormal exit, remove all files generated
         _segment_writer.reset(); // ensure all files are closed
+        _column_group_writers.clear();
         Status st;
         for (int i = 0; i < _num_segment; ++i) {
             auto path = BetaRowset::segment_file_path(_context.rowset_path_prefix,
@@ -173,6 +177,141 @@ OLAPStatus BetaRowsetWriter::flush_single_memtable(MemTable* memtable, int64_t*
     return OLAP_SUCCESS;
 }
 
+OLAPStatus BetaRowsetWriter::flush_single_memtable(const vectorized::Block* block,
+                                                   int64_t* flush_size) {
+    int64_t current_flush_size = _total_data_size + _total_index_size;
+    std::unique_ptr<segment_v2::SegmentWriter> writer;
+    RETURN_NOT_OK(_append_block(block, &writer));
+    if (writer != nullptr) {
+        RETURN_NOT_OK(_flush_segment_writer(&writer));
+    }
+
+    *flush_size = (_total_data_size + _total_index_size) - current_flush_size;
+    return OLAP_SUCCESS;
+}
+
+OLAPStatus BetaRowsetWriter::add_block(const vectorized::Block* block) {
+    return _append_block(block, &_segment_writer);
+}
+
+OLAPStatus BetaRowsetWriter::_append_block(const vectorized::Block* block,
+                                           std::unique_ptr<segment_v2::SegmentWriter>* writer) {
+    size_t num_rows = block->rows();
+    size_t row_pos = 0;
+    while (row_pos < num_rows) {
+        if (*writer == nullptr) {
+            RETURN_NOT_OK(_create_segment_writer(writer));
+        }
+        // the size of the segment is checked after every batch of rows
+        size_t batch_size = std::min<size_t>(
+                {num_rows - row_pos, BLOCK_APPEND_BATCH_SIZE,
+                 _context.max_rows_per_segment - (*writer)->num_rows_written()});
+        auto s = (*writer)->append_block(block, row_pos, batch_size);
+        if (PREDICT_FALSE(!s.ok())) {
+            LOG(WARNING) << "failed to append block: " << s.to_string();
+            return OLAP_ERR_WRITER_DATA_WRITE_ERROR;
+        }
+        row_pos += batch_size;
+        _num_rows_written += batch_size;
+
+        if (PREDICT_FALSE((*writer)->estimate_segment_size() >= MAX_SEGMENT_SIZE ||
+                          (*writer)->num_rows_written() >= _context.max_rows_per_segment)) {
+            RETURN_NOT_OK(_flush_segment_writer(writer));
+        }
+    }
+    return OLAP_SUCCESS;
+}
+
+OLAPStatus BetaRowsetWriter::add_columns(const vectorized::Block* block,
+                                         const std::vector<uint32_t>& column_ids, bool is_key,
+                                         uint32_t max_rows_per_segment) {
+    max_rows_per_segment = std::min(max_rows_per_segment, _context.max_rows_per_segment);
+    size_t num_rows = block->rows();
+    size_t row_pos = 0;
+    while (row_pos < num_rows) {
+        segment_v2::SegmentWriter* writer = nullptr;
+        size_t batch_size = std::min<size_t>(num_rows - row_pos, BLOCK_APPEND_BATCH_SIZE);
+        if (is_key) {
+            // the key columns start a new segment when the last one is full
+            if (_column_group_writers.empty() ||
+                _column_group_writers.back()->num_rows_written() >= max_rows_per_segment) {
+                if (!_column_group_writers.empty()) {
+                    RETURN_NOT_OK(_flush_columns(_column_group_writers.back().get()));
+                }
+                std::unique_ptr<segment_v2::SegmentWriter> segment_writer;
+                RETURN_NOT_OK(_create_segment_writer(&segment_writer, &column_ids));
+                _column_group_writers.push_back(std::move(segment_writer));
+            }
+            writer = _column_group_writers.back().get();
+            batch_size = std::min<size_t>(batch_size,
+                                          max_rows_per_segment - writer->num_rows_written());
+        } else {
+            // the value columns fill the segments of the key columns one after another
+            if (_cur_writer_idx == _column_group_writers.size()) {
+                LOG(WARNING) << "more rows of value columns than of key columns, rowset_id="
+                             << _context.rowset_id;
+                return OLAP_ERR_WRITER_DATA_WRITE_ERROR;
+            }
+            writer = _column_group_writers[_cur_writer_idx].get();
+            if (!_column_group_started) {
+                auto s = writer->init(config::push_write_mbytes_per_sec, column_ids);
+                if (!s.ok()) {
+                    LOG(WARNING) << "failed to init segment writer: " << s.to_string();
+                    return OLAP_ERR_INIT_FAILED;
+                }
+                _column_group_started = true;
+            }
+            batch_size = std::min<size_t>(batch_size,
+                                          writer->num_rows() - writer->num_rows_written());
+        }
+        auto s = writer->append_block(block, row_pos, batch_size);
+        if (PREDICT_FALSE(!s.ok())) {
+            LOG(WARNING) << "failed to append block: " << s.to_string();
+            return OLAP_ERR_WRITER_DATA_WRITE_ERROR;
+        }
+        row_pos += batch_size;
+        if (is_key) {
+            _num_rows_written += batch_size;
+        } else if (writer->num_rows_written() == writer->num_rows()) {
+            RETURN_NOT_OK(_flush_columns(writer));
+            ++_cur_writer_idx;
+            _column_group_started = false;
+        }
+    }
+    return OLAP_SUCCESS;
+}
+
+OLAPStatus BetaRowsetWriter::flush_columns(bool is_key) {
+    if (is_key) {
+        if (!_column_group_writers.empty()) {
+            RETURN_NOT_OK(_flush_columns(_column_group_writers.back().get()));
+        }
+    } else if (_cur_writer_idx != _column_group_writers.size()) {
+        LOG(WARNING) << "less rows of value columns than of key columns, rowset_id="
+                     << _context.rowset_id;
+        return OLAP_ERR_WRITER_DATA_WRITE_ERROR;
+    }
+    _cur_writer_idx = 0;
+    _column_group_started = false;
+    return OLAP_SUCCESS;
+}
+
+OLAPStatus BetaRowsetWriter::final_flush() {
+    for (auto& writer : _column_group_writers) {
+        uint64_t segment_size;
+        uint64_t index_size;
+        Status s = writer->finalize_footer(&segment_size, &index_size);
+        if (!s.ok()) {
+            LOG(WARNING) << "failed to finalize segment: " << s.to_string();
+            return OLAP_ERR_WRITER_DATA_WRITE_ERROR;
+        }
+        _total_data_size += segment_size;
+        _total_index_size += index_size;
+    }
+    _column_group_writers.clear();
+    return OLAP_SUCCESS;
+}
+
 RowsetSharedPtr BetaRowsetWriter::build() {
     // TODO(lingbin): move to more better place, or in a CreateBlockBatch?
     for (auto& wblock : _wblocks) {
@@ -181,6 +320,7 @@ RowsetSharedPtr BetaRowsetWriter::build() {
     // When building a rowset, we must ensure that the current _segment_writer has been
     // flushed, that is, the current _segment_writer is nullptr
     DCHECK(_segment_writer == nullptr) << "segment must be null when build rowset";
+    DCHECK(_column_group_writers.empty());
     _rowset_meta->set_num_rows(_num_rows_written);
     _rowset_meta->set_total_disk_size(_total_data_size);
     _rowset_meta->set_data_disk_size(_total_data_size);
@@ -209,7 +349,9 @@ RowsetSharedPtr BetaRowsetWriter::build() {
     return rowset;
 }
 
-OLAPStatus BetaRowsetWriter::_create_segment_writer(std::unique_ptr<segment_v2::SegmentWriter>* writer) {
+OLAPStatus BetaRowsetWriter::_create_segment_writer(
+        std::unique_ptr<segment_v2::SegmentWriter>* writer,
+        const std::vector<uint32_t>* column_ids) {
     auto path = BetaRowset::segment_file_path(_context.rowset_path_prefix, _context.rowset_id,
                                               _num_segment++);
     // TODO(lingbin): should use a more general way to get BlockManager object
@@ -233,7 +375,9 @@ OLAPStatus BetaRowsetWriter::_create_segment_writer(std::unique_ptr<segment_v2::
         _wblocks.push_back(std::move(wblock));
     }
 
-    auto s = (*writer)->init(config::push_write_mbytes_per_sec);
+    auto s = column_ids == nullptr
+                     ? (*writer)->init(config::push_write_mbytes_per_sec)
+                     : (*writer)->init(config::push_write_mbytes_per_sec, *column_ids);
     if (!s.ok()) {
         LOG(WARNING) << "failed to init segment writer: " << s.to_string();
         writer->reset(nullptr);
@@ -256,4 +400,15 @@ OLAPStatus BetaRowsetWriter::_flush_segment_writer(std::unique_ptr<segment_v2::S
     return OLAP_SUCCESS;
 }
 
+OLAPStatus BetaRowsetWriter::_flush_columns(segment_v2::SegmentWriter* writer) {
+    uint64_t index_size;
+    Status s = writer->finalize_columns(&index_size);
+    if (!s.ok()) {
+        LOG(WARNING) << "failed to finalize columns of segment: " << s.to_string();
+        return OLAP_ERR_WRITER_DATA_WRITE_ERROR;
+    }
+    _total_index_size += index_size;
+    return OLAP_SUCCESS;
+}
+
 } // namespace doris
@@ -43,6 +43,17 @@ public:
     // For Memtable::flush()
     OLAPStatus add_row(const ContiguousRow& row) override { return _add_row(row); }
 
+    // For Merger::merge_rowsets() reading by block
+    OLAPStatus add_block(const vectorized::Block* block) override;
+
+    // For Merger::vertical_merge_rowsets()
+    OLAPStatus add_columns(const vectorized::Block* block, const std::vector<uint32_t>& column_ids,
+                           bool is_key, uint32_t max_rows_per_segment) override;
+
+    OLAPStatus flush_columns(bool is_key) override;
+
+    OLAPStatus final_flush() override;
+
     // add rowset by create hard link
     OLAPStatus add_rowset(RowsetSharedPtr rowset) override;
 
@@ -53,6 +64,7 @@ public:
 
     // Return the file size flushed to disk in "flush_size"
     OLAPStatus flush_single_memtable(MemTable* memtable, int64_t* flush_size) override;
+    OLAPStatus flush_single_memtable(const vectorized::Block* block, int64_t* flush_size) override;
 
     RowsetSharedPtr build() override;
 
@@ -66,7 +78,15 @@ private:
     template <typename RowType>
     OLAPStatus _add_row(const RowType& row);
 
-    OLAPStatus _create_segment_writer(std::unique_ptr<segment_v2::SegmentWriter>* writer);
+    // Appends the rows of block to *writer, which is created or flushed when needed.
+    OLAPStatus _append_block(const vectorized::Block* block,
+                             std::unique_ptr<segment_v2::SegmentWriter>* writer);
+
+    // The writer of the columns column_ids, or of all the columns if column_ids is nullptr.
+    OLAPStatus _create_segment_writer(std::unique_ptr<segment_v2::SegmentWriter>* writer,
+                                      const std::vector<uint32_t>* column_ids = nullptr);
+
+    OLAPStatus _flush_columns(segment_v2::SegmentWriter* writer);
 
     OLAPStatus _flush_segment_writer(std::unique_ptr<segment_v2::SegmentWriter>* writer);
 
@@ -79,6 +99,13 @@ private:
     /// Because we want to flush memtables in parallel.
     /// In other processes, such as merger or schema change, we will use this unified writer for data writing.
     std::unique_ptr<segment_v2::SegmentWriter> _segment_writer;
+    // The segments of a vertical compaction, written column group by column group. The column
+    // group of a segment is written after that of the previous segment, they all stay open.
+    std::vector<std::unique_ptr<segment_v2::SegmentWriter>> _column_group_writers;
+    // the segment of the next rows of the current value column group, and whether its column
+    // group is started
+    size_t _cur_writer_idx = 0;
+    bool _column_group_started = false;
     mutable SpinLock _lock; // lock to protect _wblocks.
     // TODO(lingbin): it is better to wrapper in a Batch?
     std::vector<std::unique_ptr<fs::WritableBlock>> _wblocks;
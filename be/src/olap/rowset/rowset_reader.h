@@ -28,6 +28,10 @@ namespace doris {
 
 class RowBlock;
 class RowsetReader;
+namespace vectorized {
+class Block;
+} // namespace vectorized
+
 using RowsetReaderSharedPtr = std::shared_ptr<RowsetReader>;
 
 class RowsetReader {
@@ -44,6 +48,17 @@ public:
     //      Others when error happens.
     virtual OLAPStatus next_block(RowBlock** block) = 0;
 
+    // read next block data into the columns of a vectorized *block, the columns of
+    // *block are the first return columns of the read context, in the same order.
+    // Returns
+    //      OLAP_SUCCESS when read successfully.
+    //      OLAP_ERR_DATA_EOF when there is no more data.
+    //      OLAP_ERR_FUNC_NOT_IMPLEMENTED when the rowset can not be read by column.
+    //      Others when error happens.
+    virtual OLAPStatus next_block(vectorized::Block* block) {
+        return OLAP_ERR_FUNC_NOT_IMPLEMENTED;
+    }
+
     virtual bool delete_flag() = 0;
 
     virtual Version version() = 0;
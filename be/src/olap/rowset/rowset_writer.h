@@ -30,6 +30,10 @@ class ContiguousRow;
 class MemTable;
 class RowCursor;
 
+namespace vectorized {
+class Block;
+} // namespace vectorized
+
 class RowsetWriter {
 public:
     RowsetWriter() = default;
@@ -42,6 +46,28 @@ public:
     virtual OLAPStatus add_row(const RowCursor& row) = 0;
     virtual OLAPStatus add_row(const ContiguousRow& row) = 0;
 
+    // Appends the rows of a vectorized block, its columns are in the order of the tablet schema.
+    virtual OLAPStatus add_block(const vectorized::Block* block) {
+        return OLAP_ERR_FUNC_NOT_IMPLEMENTED;
+    }
+
+    // For the vertical compactions, which write the rows column group by column group: the key
+    // columns first, which decide the segments and have up to max_rows_per_segment rows in
+    // every segment, then the value columns group by group.
+    // Appends the rows of the columns column_ids of the current column group, the columns of
+    // block are in the same order.
+    virtual OLAPStatus add_columns(const vectorized::Block* block,
+                                   const std::vector<uint32_t>& column_ids, bool is_key,
+                                   uint32_t max_rows_per_segment) {
+        return OLAP_ERR_FUNC_NOT_IMPLEMENTED;
+    }
+
+    // Ends the current column group.
+    virtual OLAPStatus flush_columns(bool is_key) { return OLAP_ERR_FUNC_NOT_IMPLEMENTED; }
+
+    // Ends the segments, after all the column groups.
+    virtual OLAPStatus final_flush() { return OLAP_ERR_FUNC_NOT_IMPLEMENTED; }
+
     // Precondition: the input `rowset` should have the same type of the rowset we're building
     virtual OLAPStatus add_rowset(RowsetSharedPtr rowset) = 0;
 
@@ -57,6 +83,12 @@ public:
         return OLAP_ERR_FUNC_NOT_IMPLEMENTED;
     }
 
+    // The rows of a vectorized memtable, sorted and aggregated.
+    virtual OLAPStatus flush_single_memtable(const vectorized::Block* block,
+                                             int64_t* flush_size) {
+        return OLAP_ERR_FUNC_NOT_IMPLEMENTED;
+    }
+
     // finish building and return pointer to the built rowset (guaranteed to be inited).
     // return nullptr when failed
     virtual RowsetSharedPtr build() = 0;
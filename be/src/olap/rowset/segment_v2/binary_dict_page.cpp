@@ -233,6 +233,7 @@ void BinaryDictPageDecoder::set_dict_decoder(PageDecoder* dict_decoder) {
 
 Status BinaryDictPageDecoder::next_batch(size_t* n, ColumnBlockView* dst) {
     if (_encoding_type == PLAIN_ENCODING) {
+        dst->column_block()->vector_batch()->stop_dict_codes();
         return _data_page_decoder->next_batch(n, dst);
     }
     // dictionary encoding
@@ -248,6 +249,9 @@ Status BinaryDictPageDecoder::next_batch(size_t* n, ColumnBlockView* dst) {
     ColumnBlock column_block(_batch.get(), dst->column_block()->pool());
     ColumnBlockView tmp_block_view(&column_block);
     RETURN_IF_ERROR(_data_page_decoder->next_batch(n, &tmp_block_view));
+    dst->column_block()->vector_batch()->append_dict_codes(
+            _dict_decoder, dst->current_offset(),
+            reinterpret_cast<const int32_t*>(column_block.cell_ptr(0)), *n);
     for (int i = 0; i < *n; ++i) {
         int32_t codeword = *reinterpret_cast<const int32_t*>(column_block.cell_ptr(i));
         // get the string from the dict decoder
@@ -25,6 +25,7 @@
 #include "olap/row.h"
 #include "olap/row_block2.h"
 #include "olap/row_cursor.h"
+#include "olap/rowset/segment_v2/binary_plain_page.h"
 #include "olap/rowset/segment_v2/column_reader.h"
 #include "olap/rowset/segment_v2/segment.h"
 #include "olap/short_key_index.h"
@@ -301,6 +302,9 @@ Status SegmentIterator::_apply_bitmap_index() {
         } else {
             RETURN_IF_ERROR(pred->evaluate(_schema, _bitmap_index_iterators, _segment->num_rows(),
                                            &_row_bitmap));
+            if (!pred->can_use_bitmap_index()) {
+                remaining_predicates.push_back(pred);
+            }
             if (_row_bitmap.isEmpty()) {
                 break; // all rows have been pruned, no need to process further predicates
             }
@@ -532,6 +536,12 @@ Status SegmentIterator::next_batch(RowBlockV2* block) {
         for (auto column_predicate : _col_predicates) {
             auto column_id = column_predicate->column_id();
             auto column_block = block->column_block(column_id);
+            if (column_block.vector_batch()->has_dict_codes()) {
+                RETURN_IF_ERROR(_evaluate_on_dict_codes(column_predicate, &column_block,
+                                                        block->selection_vector(),
+                                                        &selected_size));
+                continue;
+            }
             column_predicate->evaluate(&column_block, block->selection_vector(), &selected_size);
         }
         _opts.stats->rows_vec_cond_filtered += original_size - selected_size;
@@ -567,5 +577,82 @@ Status SegmentIterator::next_batch(RowBlockV2* block) {
     return Status::OK();
 }
 
+Status SegmentIterator::_evaluate_on_dict_codes(const ColumnPredicate* pred,
+                                                ColumnBlock* column_block, uint16_t* sel,
+                                                uint16_t* size) {
+    ColumnVectorBatch* batch = column_block->vector_batch();
+    const BinaryPlainPageDecoder* dict = batch->dict();
+    auto& dict_results = _dict_predicate_results[pred];
+    if (dict_results.dict != dict) {
+        dict_results.dict = dict;
+        dict_results.results.assign(dict->count(), -1);
+    }
+    auto& results = dict_results.results;
+
+    if (_dict_values == nullptr || _dict_values->type_info() != batch->type_info()) {
+        RETURN_IF_ERROR(ColumnVectorBatch::create(*size, false, batch->type_info(), nullptr,
+                                                  &_dict_values));
+    }
+    if (_dict_values->capacity() < *size) {
+        RETURN_IF_ERROR(_dict_values->resize(*size));
+    }
+    _dict_value_codes.resize(*size);
+    _dict_value_sel.resize(*size);
+    _dict_null_sel.resize(*size);
+
+    // collect the null rows and the values of the codes not evaluated yet
+    const int32_t* codes = batch->dict_codes();
+    bool is_nullable = column_block->is_nullable();
+    uint16_t num_values = 0;
+    uint16_t num_nulls = 0;
+    for (uint16_t i = 0; i < *size; ++i) {
+        uint16_t row = sel[i];
+        if (is_nullable && column_block->is_null(row)) {
+            _dict_null_sel[num_nulls++] = row;
+            continue;
+        }
+        int32_t code = codes[row];
+        DCHECK_LT(code, results.size());
+        if (results[code] == -1) {
+            results[code] = 0;
+            *reinterpret_cast<Slice*>(_dict_values->mutable_cell_ptr(num_values)) =
+                    dict->string_at_index(code);
+            _dict_value_codes[num_values] = code;
+            _dict_value_sel[num_values] = num_values;
+            ++num_values;
+        }
+    }
+
+    if (num_values > 0) {
+        ColumnBlock values_block(_dict_values.get(), column_block->pool());
+        pred->evaluate(&values_block, _dict_value_sel.data(), &num_values);
+        for (uint16_t i = 0; i < num_values; ++i) {
+            results[_dict_value_codes[_dict_value_sel[i]]] = 1;
+        }
+    }
+    if (num_nulls > 0) {
+        pred->evaluate(column_block, _dict_null_sel.data(), &num_nulls);
+    }
+
+    // both the rows and the passed null rows are in the order of sel
+    uint16_t new_size = 0;
+    uint16_t null_idx = 0;
+    for (uint16_t i = 0; i < *size; ++i) {
+        uint16_t row = sel[i];
+        if (is_nullable && column_block->is_null(row)) {
+            if (null_idx < num_nulls && _dict_null_sel[null_idx] == row) {
+                sel[new_size++] = row;
+                ++null_idx;
+            }
+            continue;
+        }
+        if (results[codes[row]] == 1) {
+            sel[new_size++] = row;
+        }
+    }
+    *size = new_size;
+    return Status::OK();
+}
+
 } // namespace segment_v2
 } // namespace doris
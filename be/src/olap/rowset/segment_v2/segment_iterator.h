@@ -19,6 +19,7 @@
 
 #include <memory>
 #include <roaring/roaring.hh>
+#include <unordered_map>
 #include <vector>
 
 #include "common/status.h"
@@ -31,6 +32,9 @@
 
 namespace doris {
 
+class ColumnBlock;
+class ColumnPredicate;
+class ColumnVectorBatch;
 class RowCursor;
 class RowBlockV2;
 class ShortKeyIndexIterator;
@@ -41,6 +45,7 @@ class ReadableBlock;
 
 namespace segment_v2 {
 
+class BinaryPlainPageDecoder;
 class BitmapIndexIterator;
 class BitmapIndexReader;
 class ColumnIterator;
@@ -83,6 +88,11 @@ private:
     Status _read_columns(const std::vector<ColumnId>& column_ids, RowBlockV2* block,
                          size_t row_offset, size_t nrows);
 
+    // Evaluates pred on the selected rows of a column block which has the dictionary codes of
+    // its values, every value of the dictionary is evaluated once, see _dict_predicate_results.
+    Status _evaluate_on_dict_codes(const ColumnPredicate* pred, ColumnBlock* column_block,
+                                   uint16_t* sel, uint16_t* size);
+
 private:
     class BitmapRangeIterator;
 
@@ -119,6 +129,19 @@ private:
     // make a copy of `_opts.column_predicates` in order to make local changes
     std::vector<ColumnPredicate*> _col_predicates;
 
+    // The results of the column predicates on the values of the dictionary of their column:
+    // 1 if the value passes, 0 if not, -1 if not evaluated yet.
+    struct DictPredicateResults {
+        const BinaryPlainPageDecoder* dict = nullptr;
+        std::vector<int8_t> results;
+    };
+    std::unordered_map<const ColumnPredicate*, DictPredicateResults> _dict_predicate_results;
+    // the dictionary values to evaluate, and buffers reused by _evaluate_on_dict_codes()
+    std::unique_ptr<ColumnVectorBatch> _dict_values;
+    std::vector<int32_t> _dict_value_codes;
+    std::vector<uint16_t> _dict_value_sel;
+    std::vector<uint16_t> _dict_null_sel;
+
     int16_t** _select_vec;
 
     // row schema of the key to seek
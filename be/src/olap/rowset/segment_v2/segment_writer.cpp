@@ -17,8 +17,12 @@
 
 #include "olap/rowset/segment_v2/segment_writer.h"
 
+#include <numeric>
+
 #include "common/logging.h" // LOG
 #include "env/env.h"        // Env
+#include "gutil/strings/substitute.h"
+#include "olap/decimal12.h"
 #include "olap/fs/block_manager.h"
 #include "olap/row.h"                             // ContiguousRow
 #include "olap/row_cursor.h"                      // RowCursor
@@ -26,8 +30,13 @@
 #include "olap/rowset/segment_v2/page_io.h"
 #include "olap/schema.h"
 #include "olap/short_key_index.h"
+#include "olap/uint24.h"
+#include "runtime/datetime_value.h"
+#include "runtime/decimalv2_value.h"
 #include "util/crc32c.h"
 #include "util/faststring.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/core/block.h"
 
 namespace doris {
 namespace segment_v2 {
@@ -60,14 +69,31 @@ void SegmentWriter::_init_column_meta(ColumnMetaPB* meta, uint32_t* column_id,
     }
 }
 
-Status SegmentWriter::init(uint32_t write_mbytes_per_sec __attribute__((unused))) {
-    uint32_t column_id = 0;
-    _column_writers.reserve(_tablet_schema->columns().size());
-    for (auto& column : _tablet_schema->columns()) {
-        ColumnWriterOptions opts;
-        opts.meta = _footer.add_columns();
+Status SegmentWriter::init(uint32_t write_mbytes_per_sec) {
+    std::vector<uint32_t> column_ids(_tablet_schema->num_columns());
+    std::iota(column_ids.begin(), column_ids.end(), 0);
+    return init(write_mbytes_per_sec, column_ids);
+}
 
-        _init_column_meta(opts.meta, &column_id, column);
+Status SegmentWriter::init(uint32_t write_mbytes_per_sec __attribute__((unused)),
+                           const std::vector<uint32_t>& column_ids) {
+    DCHECK(_column_writers.empty());
+    if (_num_column_groups == 0) {
+        // the metas of all the columns, in the order of the tablet schema
+        uint32_t column_id = 0;
+        for (auto& column : _tablet_schema->columns()) {
+            _init_column_meta(_footer.add_columns(), &column_id, column);
+        }
+        _index_builder.reset(new ShortKeyIndexBuilder(_segment_id, _opts.num_rows_per_block));
+    }
+    _is_key_group = _num_column_groups++ == 0;
+    _column_ids = column_ids;
+    _row_count = 0;
+    _column_writers.reserve(column_ids.size());
+    for (auto cid : column_ids) {
+        const auto& column = _tablet_schema->column(cid);
+        ColumnWriterOptions opts;
+        opts.meta = _footer.mutable_columns(cid);
 
         // now we create zone map for key columns in AGG_KEYS or all column in UNIQUE_KEYS or DUP_KEYS
         // and not support zone map for array type.
@@ -91,19 +117,18 @@ Status SegmentWriter::init(uint32_t write_mbytes_per_sec __attribute__((unused))
         RETURN_IF_ERROR(writer->init());
         _column_writers.push_back(std::move(writer));
     }
-    _index_builder.reset(new ShortKeyIndexBuilder(_segment_id, _opts.num_rows_per_block));
     return Status::OK();
 }
 
 template <typename RowType>
 Status SegmentWriter::append_row(const RowType& row) {
-    for (size_t cid = 0; cid < _column_writers.size(); ++cid) {
-        auto cell = row.cell(cid);
-        RETURN_IF_ERROR(_column_writers[cid]->append(cell));
+    for (size_t i = 0; i < _column_writers.size(); ++i) {
+        auto cell = row.cell(_column_ids[i]);
+        RETURN_IF_ERROR(_column_writers[i]->append(cell));
     }
 
     // At the begin of one block, so add a short key index entry
-    if ((_row_count % _opts.num_rows_per_block) == 0) {
+    if (_is_key_group && (_row_count % _opts.num_rows_per_block) == 0) {
         std::string encoded_key;
         encode_key(&encoded_key, row, _tablet_schema->num_short_key_columns());
         RETURN_IF_ERROR(_index_builder->add_item(encoded_key));
@@ -115,6 +140,183 @@ Status SegmentWriter::append_row(const RowType& row) {
 template Status SegmentWriter::append_row(const RowCursor& row);
 template Status SegmentWriter::append_row(const ContiguousRow& row);
 
+namespace {
+
+// The rows of a vectorized column in the storage format, see RowBlockV2::convert_to_vec_block
+// for the reverse conversion.
+struct StorageColumn {
+    // one byte for every row, nullptr if no row is null
+    const uint8_t* null_map = nullptr;
+    const uint8_t* data = nullptr;
+    size_t value_size = 0;
+    // the converted values, unless data points into the vectorized column
+    std::vector<uint8_t> buffer;
+    // the padded CHAR values
+    std::string chars;
+};
+
+template <typename T>
+T* resize_buffer(StorageColumn* column, size_t num_rows) {
+    column->buffer.resize(num_rows * sizeof(T));
+    column->data = column->buffer.data();
+    column->value_size = sizeof(T);
+    return reinterpret_cast<T*>(column->buffer.data());
+}
+
+Status to_storage_column(const TabletColumn& tablet_column, const vectorized::IColumn& column,
+                         size_t row_pos, size_t num_rows, StorageColumn* dst) {
+    const vectorized::IColumn* data_column = &column;
+    if (column.isNullable()) {
+        const auto& nullable_column = assert_cast<const vectorized::ColumnNullable&>(column);
+        const uint8_t* null_map = nullable_column.getNullMapData().data() + row_pos;
+        if (tablet_column.is_nullable()) {
+            dst->null_map = null_map;
+        } else if (std::any_of(null_map, null_map + num_rows, [](uint8_t v) { return v; })) {
+            return Status::InternalError(strings::Substitute(
+                    "null value for not nullable column $0", tablet_column.name()));
+        }
+        data_column = &nullable_column.getNestedColumn();
+    }
+
+    switch (tablet_column.type()) {
+    case OLAP_FIELD_TYPE_BOOL:
+    case OLAP_FIELD_TYPE_TINYINT:
+    case OLAP_FIELD_TYPE_SMALLINT:
+    case OLAP_FIELD_TYPE_INT:
+    case OLAP_FIELD_TYPE_BIGINT:
+    case OLAP_FIELD_TYPE_LARGEINT:
+    case OLAP_FIELD_TYPE_FLOAT:
+    case OLAP_FIELD_TYPE_DOUBLE: {
+        // the same layout, the values are not copied
+        auto value = data_column->getDataAt(row_pos);
+        dst->data = reinterpret_cast<const uint8_t*>(value.data);
+        dst->value_size = value.size;
+        break;
+    }
+    case OLAP_FIELD_TYPE_DATE: {
+        auto* values = resize_buffer<uint24_t>(dst, num_rows);
+        for (size_t i = 0; i < num_rows; ++i) {
+            auto date = reinterpret_cast<const DateTimeValue*>(
+                    data_column->getDataAt(row_pos + i).data);
+            values[i] = date->to_olap_date();
+        }
+        break;
+    }
+    case OLAP_FIELD_TYPE_DATETIME: {
+        auto* values = resize_buffer<uint64_t>(dst, num_rows);
+        for (size_t i = 0; i < num_rows; ++i) {
+            auto datetime = reinterpret_cast<const DateTimeValue*>(
+                    data_column->getDataAt(row_pos + i).data);
+            values[i] = datetime->to_olap_datetime();
+        }
+        break;
+    }
+    case OLAP_FIELD_TYPE_DECIMAL: {
+        auto* values = resize_buffer<decimal12_t>(dst, num_rows);
+        for (size_t i = 0; i < num_rows; ++i) {
+            auto decimal = reinterpret_cast<const DecimalV2Value*>(
+                    data_column->getDataAt(row_pos + i).data);
+            values[i].integer = decimal->int_value();
+            values[i].fraction = decimal->frac_value();
+        }
+        break;
+    }
+    case OLAP_FIELD_TYPE_CHAR: {
+        // the char values are padded with zeros to the length of the column
+        size_t length = tablet_column.length();
+        dst->chars.assign(num_rows * length, '\0');
+        auto* values = resize_buffer<Slice>(dst, num_rows);
+        for (size_t i = 0; i < num_rows; ++i) {
+            auto value = data_column->getDataAt(row_pos + i);
+            char* data = dst->chars.data() + i * length;
+            memcpy(data, value.data, std::min(value.size, length));
+            values[i] = Slice(data, length);
+        }
+        break;
+    }
+    case OLAP_FIELD_TYPE_VARCHAR:
+    case OLAP_FIELD_TYPE_HLL:
+    case OLAP_FIELD_TYPE_OBJECT: {
+        auto* values = resize_buffer<Slice>(dst, num_rows);
+        for (size_t i = 0; i < num_rows; ++i) {
+            auto value = data_column->getDataAt(row_pos + i);
+            values[i] = Slice(value.data, value.size);
+        }
+        break;
+    }
+    default:
+        return Status::NotSupported(strings::Substitute(
+                "unsupported type $0 for vectorized write", tablet_column.type()));
+    }
+    return Status::OK();
+}
+
+Status append_storage_column(const StorageColumn& column, size_t num_rows, ColumnWriter* writer) {
+    if (column.null_map == nullptr) {
+        const uint8_t* ptr = column.data;
+        return writer->append_data(&ptr, num_rows);
+    }
+    size_t row = 0;
+    while (row < num_rows) {
+        bool is_null = column.null_map[row];
+        size_t run_end = row + 1;
+        while (run_end < num_rows && bool(column.null_map[run_end]) == is_null) {
+            ++run_end;
+        }
+        if (is_null) {
+            RETURN_IF_ERROR(writer->append_nulls(run_end - row));
+        } else {
+            const uint8_t* ptr = column.data + row * column.value_size;
+            RETURN_IF_ERROR(writer->append_data(&ptr, run_end - row));
+        }
+        row = run_end;
+    }
+    return Status::OK();
+}
+
+} // namespace
+
+Status SegmentWriter::append_block(const vectorized::Block* block, size_t row_pos,
+                                   size_t num_rows) {
+    DCHECK_EQ(block->columns(), _column_writers.size());
+    DCHECK_LE(row_pos + num_rows, block->rows());
+    if (num_rows == 0) {
+        return Status::OK();
+    }
+    std::vector<StorageColumn> columns(_column_writers.size());
+    for (size_t i = 0; i < _column_writers.size(); ++i) {
+        auto column = block->getByPosition(i).column->convertToFullColumnIfConst();
+        RETURN_IF_ERROR(to_storage_column(_tablet_schema->column(_column_ids[i]), *column, row_pos,
+                                          num_rows, &columns[i]));
+        RETURN_IF_ERROR(append_storage_column(columns[i], num_rows, _column_writers[i].get()));
+    }
+    if (!_is_key_group) {
+        _row_count += num_rows;
+        return Status::OK();
+    }
+
+    // a short key index entry for every row at the begin of one block, as append_row
+    size_t num_short_key_columns = _tablet_schema->num_short_key_columns();
+    size_t row = (_opts.num_rows_per_block - _row_count % _opts.num_rows_per_block) %
+                 _opts.num_rows_per_block;
+    for (; row < num_rows; row += _opts.num_rows_per_block) {
+        std::string encoded_key;
+        for (size_t cid = 0; cid < num_short_key_columns; ++cid) {
+            const auto& column = columns[cid];
+            if (column.null_map != nullptr && column.null_map[row]) {
+                encoded_key.push_back(KEY_NULL_FIRST_MARKER);
+                continue;
+            }
+            encoded_key.push_back(KEY_NORMAL_MARKER);
+            _column_writers[cid]->get_field()->encode_ascending(
+                    column.data + row * column.value_size, &encoded_key);
+        }
+        RETURN_IF_ERROR(_index_builder->add_item(encoded_key));
+    }
+    _row_count += num_rows;
+    return Status::OK();
+}
+
 // TODO(lingbin): Currently this function does not include the size of various indexes,
 // We should make this more precise.
 // NOTE: This function will be called when any row of data is added, so we need to
@@ -130,6 +332,20 @@ uint64_t SegmentWriter::estimate_segment_size() {
 }
 
 Status SegmentWriter::finalize(uint64_t* segment_file_size, uint64_t* index_size) {
+    RETURN_IF_ERROR(finalize_columns(index_size));
+    uint64_t short_key_index_size = 0;
+    RETURN_IF_ERROR(finalize_footer(segment_file_size, &short_key_index_size));
+    *index_size += short_key_index_size;
+    return Status::OK();
+}
+
+Status SegmentWriter::finalize_columns(uint64_t* index_size) {
+    if (_is_key_group) {
+        _num_rows = _row_count;
+    } else if (_row_count != _num_rows) {
+        return Status::InternalError(strings::Substitute(
+                "column group of $0 rows in segment of $1 rows", _row_count, _num_rows));
+    }
     for (auto& column_writer : _column_writers) {
         RETURN_IF_ERROR(column_writer->finish());
     }
@@ -139,6 +355,15 @@ Status SegmentWriter::finalize(uint64_t* segment_file_size, uint64_t* index_size
     RETURN_IF_ERROR(_write_zone_map());
     RETURN_IF_ERROR(_write_bitmap_index());
     RETURN_IF_ERROR(_write_bloom_filter_index());
+    *index_size = _wblock->bytes_appended() - index_offset;
+    // the pages of the column group are written, and released with the column writers
+    _column_writers.clear();
+    return Status::OK();
+}
+
+Status SegmentWriter::finalize_footer(uint64_t* segment_file_size, uint64_t* index_size) {
+    DCHECK(_column_writers.empty());
+    uint64_t index_offset = _wblock->bytes_appended();
     RETURN_IF_ERROR(_write_short_key_index());
     *index_size = _wblock->bytes_appended() - index_offset;
     RETURN_IF_ERROR(_write_footer());
@@ -187,7 +412,7 @@ Status SegmentWriter::_write_bloom_filter_index() {
 Status SegmentWriter::_write_short_key_index() {
     std::vector<Slice> body;
     PageFooterPB footer;
-    RETURN_IF_ERROR(_index_builder->finalize(_row_count, &body, &footer));
+    RETURN_IF_ERROR(_index_builder->finalize(_num_rows, &body, &footer));
     PagePointer pp;
     // short key index page is not compressed right now
     RETURN_IF_ERROR(PageIO::write_page(_wblock, body, footer, &pp));
@@ -196,7 +421,7 @@ Status SegmentWriter::_write_short_key_index() {
 }
 
 Status SegmentWriter::_write_footer() {
-    _footer.set_num_rows(_row_count);
+    _footer.set_num_rows(_num_rows);
 
     // Footer := SegmentFooterPB, FooterPBSize(4), FooterPBChecksum(4), MagicNumber(4)
     std::string footer_buf;
@@ -38,6 +38,10 @@ namespace fs {
 class WritableBlock;
 }
 
+namespace vectorized {
+class Block;
+}
+
 namespace segment_v2 {
 
 class ColumnWriter;
@@ -57,15 +61,34 @@ public:
 
     Status init(uint32_t write_mbytes_per_sec);
 
+    // Starts the column group of column_ids, the columns of the segment are written column group
+    // by column group by the vertical compactions. The first column group decides the rows of
+    // the segment and begins with the key columns, the others must have as many rows.
+    Status init(uint32_t write_mbytes_per_sec, const std::vector<uint32_t>& column_ids);
+
     template <typename RowType>
     Status append_row(const RowType& row);
 
+    // Appends num_rows rows of block from row_pos. The columns of block are those of the current
+    // column group, in the same order, their values in the layout of the vectorized engine.
+    Status append_block(const vectorized::Block* block, size_t row_pos, size_t num_rows);
+
     uint64_t estimate_segment_size();
 
+    // The rows written to the current column group.
     uint32_t num_rows_written() { return _row_count; }
 
+    // The rows of the segment, those of the first column group once it is finalized.
+    uint32_t num_rows() { return _num_rows; }
+
     Status finalize(uint64_t* segment_file_size, uint64_t* index_size);
 
+    // Writes the data and the indexes of the columns of the current column group.
+    Status finalize_columns(uint64_t* index_size);
+
+    // Writes the short key index and the footer, after all the column groups.
+    Status finalize_footer(uint64_t* segment_file_size, uint64_t* index_size);
+
 private:
     DISALLOW_COPY_AND_ASSIGN(SegmentWriter);
     Status _write_data();
@@ -88,8 +111,13 @@ private:
 
     SegmentFooterPB _footer;
     std::unique_ptr<ShortKeyIndexBuilder> _index_builder;
+    // the columns of the current column group
+    std::vector<uint32_t> _column_ids;
     std::vector<std::unique_ptr<ColumnWriter>> _column_writers;
+    bool _is_key_group = false;
+    uint32_t _num_column_groups = 0;
     uint32_t _row_count = 0;
+    uint32_t _num_rows = 0;
 };
 
 } // namespace segment_v2
@@ -0,0 +1,367 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/vcollect_iterator.h"
+
+#include <algorithm>
+
+#include "common/logging.h"
+#include "olap/tablet_schema.h"
+
+namespace doris {
+
+// The rows merged by a call of next_block().
+static const size_t MERGE_BATCH_SIZE = 4096;
+
+// A rowset reader and its current block.
+class VCollectIterator::Child {
+public:
+    Child(uint16_t index, RowsetReaderSharedPtr rs_reader, const BlockAggregator* aggregator,
+          size_t num_keys)
+            : index(index),
+              _rs_reader(std::move(rs_reader)),
+              _version(_rs_reader->version().second),
+              _aggregator(aggregator),
+              _num_keys(num_keys) {}
+
+    // Reads the next block of the rowset reader, whose columns are those of header.
+    // Returns OLAP_ERR_DATA_EOF when there is no more rows.
+    OLAPStatus next_block(const vectorized::Block& header) {
+        do {
+            _block = header.cloneEmpty();
+            RETURN_NOT_OK(_rs_reader->next_block(&_block));
+        } while (_block.rows() == 0);
+        _key_columns.clear();
+        for (size_t cid = 0; cid < _num_keys; ++cid) {
+            _key_columns.push_back(
+                    _aggregator->comparable_column(cid, _block.getByPosition(cid).column));
+        }
+        pos = 0;
+        return OLAP_SUCCESS;
+    }
+
+    const vectorized::Block& block() const { return _block; }
+
+    size_t rows() const { return _block.rows(); }
+
+    // Whether the row of this child goes before the current row of rhs. The rows of the same
+    // key are in the order of the versions, so that the later versions replace the earlier.
+    bool before(size_t row, const Child& rhs) const {
+        for (size_t i = 0; i < _num_keys; ++i) {
+            // nulls first, as the storage
+            int res = _key_columns[i]->compareAt(row, rhs.pos, *rhs._key_columns[i], -1);
+            if (res != 0) {
+                return res < 0;
+            }
+        }
+        return _version < rhs._version;
+    }
+
+    // the position of the child in the children
+    const uint16_t index;
+    // the current row
+    size_t pos = 0;
+
+private:
+    RowsetReaderSharedPtr _rs_reader;
+    const int64_t _version;
+    const BlockAggregator* _aggregator;
+    const size_t _num_keys;
+    vectorized::Block _block;
+    vectorized::Columns _key_columns;
+};
+
+bool VCollectIterator::MergeCursor::greater(const MergeCursor& rhs) const {
+    return !child->before(child->pos, *rhs.child);
+}
+
+VCollectIterator::VCollectIterator(const TabletSchema* tablet_schema, KeysType keys_type)
+        : _tablet_schema(tablet_schema), _keys_type(keys_type), _aggregator(tablet_schema) {}
+
+VCollectIterator::~VCollectIterator() {}
+
+void VCollectIterator::add_child(RowsetReaderSharedPtr rs_reader) {
+    DCHECK_LT(_children.size(), RowSourcesBuffer::MAX_CHILDREN);
+    _children.emplace_back(new Child(_children.size(), std::move(rs_reader), &_aggregator,
+                                     _tablet_schema->num_key_columns()));
+}
+
+OLAPStatus VCollectIterator::_init(const vectorized::Block& header) {
+    DCHECK_EQ(header.columns(), _row_sources == nullptr ? _tablet_schema->num_columns()
+                                                        : _tablet_schema->num_key_columns());
+    _header = header.cloneEmpty();
+    _pending_columns = _header.cloneEmptyColumns();
+    std::vector<MergeCursor> cursors;
+    for (auto& child : _children) {
+        auto res = child->next_block(_header);
+        if (res == OLAP_ERR_DATA_EOF) {
+            continue;
+        }
+        RETURN_NOT_OK(res);
+        cursors.push_back({child.get()});
+    }
+    _tree.init(std::move(cursors));
+    return OLAP_SUCCESS;
+}
+
+OLAPStatus VCollectIterator::next_block(vectorized::Block* block, bool* eof) {
+    if (!_inited) {
+        RETURN_NOT_OK(_init(*block));
+        _inited = true;
+    }
+    size_t num_rows = block->rows();
+    if (_keys_type == KeysType::DUP_KEYS) {
+        auto columns = block->mutateColumns();
+        auto res = _merge(MERGE_BATCH_SIZE, &columns);
+        block->setColumns(std::move(columns));
+        RETURN_NOT_OK(res);
+        for (auto child : _pending_sources) {
+            _row_sources->append(child, false);
+        }
+        _pending_sources.clear();
+    } else {
+        // the rows of a key may come from several children, in several merges
+        while (block->rows() == num_rows) {
+            // more pending rows than a batch are all of a single key
+            size_t num_pending = _pending_columns[0]->size();
+            RETURN_NOT_OK(_merge(num_pending < MERGE_BATCH_SIZE ? MERGE_BATCH_SIZE - num_pending
+                                                                : MERGE_BATCH_SIZE,
+                                 &_pending_columns));
+            bool is_last = _tree.empty();
+            RETURN_NOT_OK(_aggregate_pending(is_last, block));
+            if (is_last) {
+                break;
+            }
+        }
+    }
+    *eof = block->rows() == num_rows;
+    return OLAP_SUCCESS;
+}
+
+OLAPStatus VCollectIterator::_merge(size_t max_rows, vectorized::MutableColumns* columns) {
+    size_t merged = 0;
+    while (merged < max_rows && !_tree.empty()) {
+        Child* top = _tree.top().child;
+        size_t end = std::min(top->rows(), top->pos + (max_rows - merged));
+        // The current row of the winner goes before the current row of the runner-up, and so
+        // may the rows after it, which are copied together.
+        MergeCursor* second = _tree.secondTop();
+        if (second != nullptr && !top->before(end - 1, *second->child)) {
+            size_t run_end = top->pos + 1;
+            while (run_end < end && top->before(run_end, *second->child)) {
+                ++run_end;
+            }
+            end = run_end;
+        }
+        const auto& block = top->block();
+        for (size_t i = 0; i < columns->size(); ++i) {
+            (*columns)[i]->insertRangeFrom(*block.getByPosition(i).column, top->pos,
+                                           end - top->pos);
+        }
+        if (_row_sources != nullptr) {
+            _pending_sources.insert(_pending_sources.end(), end - top->pos, top->index);
+        }
+        merged += end - top->pos;
+        top->pos = end;
+        if (end == top->rows()) {
+            auto res = top->next_block(_header);
+            if (res == OLAP_ERR_DATA_EOF) {
+                _tree.removeTop();
+                continue;
+            }
+            RETURN_NOT_OK(res);
+        }
+        _tree.updateTop();
+    }
+    return OLAP_SUCCESS;
+}
+
+OLAPStatus VCollectIterator::_aggregate_pending(bool is_last, vectorized::Block* block) {
+    size_t num_rows = _pending_columns[0]->size();
+    if (num_rows == 0) {
+        return OLAP_SUCCESS;
+    }
+    vectorized::Columns columns;
+    for (auto& column : _pending_columns) {
+        columns.emplace_back(std::move(column));
+    }
+    size_t num_keys = _tablet_schema->num_key_columns();
+    vectorized::Columns key_columns;
+    for (size_t cid = 0; cid < num_keys; ++cid) {
+        key_columns.push_back(_aggregator.comparable_column(cid, columns[cid]));
+    }
+    // the rows of every key end at run_ends
+    vectorized::IColumn::Permutation run_ends;
+    for (size_t i = 1; i < num_rows; ++i) {
+        for (const auto& column : key_columns) {
+            if (column->compareAt(i - 1, i, *column, -1) != 0) {
+                run_ends.push_back(i);
+                break;
+            }
+        }
+    }
+    run_ends.push_back(num_rows);
+    key_columns.clear();
+
+    // the rows of the last key stay pending, the next merge may have more of them
+    size_t end = num_rows;
+    if (!is_last) {
+        run_ends.pop_back();
+        end = run_ends.empty() ? 0 : run_ends.back();
+    }
+    if (_row_sources != nullptr) {
+        size_t begin = 0;
+        for (auto run_end : run_ends) {
+            for (size_t i = begin; i < run_end; ++i) {
+                _row_sources->append(_pending_sources[i], i + 1 < run_end);
+            }
+            begin = run_end;
+        }
+        _pending_sources.erase(_pending_sources.begin(), _pending_sources.begin() + end);
+    }
+    if (end == 0) {
+        for (size_t i = 0; i < columns.size(); ++i) {
+            _pending_columns[i] = (*std::move(columns[i])).mutate();
+        }
+        return OLAP_SUCCESS;
+    }
+    vectorized::Columns result;
+    for (size_t i = 0; i < columns.size(); ++i) {
+        if (end == num_rows) {
+            result.push_back(std::move(columns[i]));
+            _pending_columns[i] = _header.getByPosition(i).column->cloneEmpty();
+        } else {
+            result.push_back(columns[i]->cut(0, end));
+            _pending_columns[i] = (*columns[i]->cut(end, num_rows - end)).mutate();
+        }
+    }
+    _merged_rows += end - run_ends.size();
+    // only the key columns are merged if the row sources are recorded, and they are reduced to
+    // the first row of every key
+    RETURN_NOT_OK(_aggregator.aggregate(run_ends, &result));
+
+    if (block->rows() == 0) {
+        block->setColumns(result);
+        return OLAP_SUCCESS;
+    }
+    auto block_columns = block->mutateColumns();
+    for (size_t i = 0; i < block_columns.size(); ++i) {
+        block_columns[i]->insertRangeFrom(*result[i], 0, result[i]->size());
+    }
+    block->setColumns(std::move(block_columns));
+    return OLAP_SUCCESS;
+}
+
+VValueGroupIterator::VValueGroupIterator(const TabletSchema* tablet_schema,
+                                         std::vector<uint32_t> column_ids,
+                                         const RowSourcesBuffer* row_sources)
+        : _column_ids(std::move(column_ids)),
+          _row_sources(row_sources),
+          _aggregator(tablet_schema) {}
+
+VValueGroupIterator::~VValueGroupIterator() {}
+
+void VValueGroupIterator::add_child(RowsetReaderSharedPtr rs_reader) {
+    _children.emplace_back();
+    _children.back().rs_reader = std::move(rs_reader);
+}
+
+OLAPStatus VValueGroupIterator::next_block(vectorized::Block* block, bool* eof) {
+    if (!_inited) {
+        _header = block->cloneEmpty();
+        _inited = true;
+    }
+    size_t num_sources = _row_sources->size();
+    if (_source_pos == num_sources) {
+        *eof = true;
+        return OLAP_SUCCESS;
+    }
+    // the rows of a key are not split between blocks
+    size_t begin = _source_pos;
+    size_t end = std::min(num_sources, begin + MERGE_BATCH_SIZE);
+    while (end < num_sources && _row_sources->agg_with_next(end - 1)) {
+        ++end;
+    }
+
+    auto columns = _header.cloneEmptyColumns();
+    size_t row = begin;
+    while (row < end) {
+        uint16_t index = _row_sources->child(row);
+        DCHECK_LT(index, _children.size());
+        Child& child = _children[index];
+        if (child.pos == child.block.rows()) {
+            OLAPStatus res;
+            do {
+                child.block = _header.cloneEmpty();
+                res = child.rs_reader->next_block(&child.block);
+            } while (res == OLAP_SUCCESS && child.block.rows() == 0);
+            if (res == OLAP_ERR_DATA_EOF) {
+                LOG(WARNING) << "less rows of the value columns than of the key columns";
+                return OLAP_ERR_CHECK_LINES_ERROR;
+            }
+            RETURN_NOT_OK(res);
+            child.pos = 0;
+        }
+        // the consecutive rows of the child are copied together
+        size_t run_end = row + 1;
+        size_t max_end = std::min(end, row + (child.block.rows() - child.pos));
+        while (run_end < max_end && _row_sources->child(run_end) == index) {
+            ++run_end;
+        }
+        for (size_t i = 0; i < columns.size(); ++i) {
+            columns[i]->insertRangeFrom(*child.block.getByPosition(i).column, child.pos,
+                                        run_end - row);
+        }
+        child.pos += run_end - row;
+        row = run_end;
+    }
+    _source_pos = end;
+
+    // the rows of every key end at run_ends
+    vectorized::IColumn::Permutation run_ends;
+    for (size_t i = begin; i < end; ++i) {
+        if (!_row_sources->agg_with_next(i)) {
+            run_ends.push_back(i - begin + 1);
+        }
+    }
+    vectorized::Columns result;
+    for (size_t i = 0; i < columns.size(); ++i) {
+        vectorized::ColumnPtr column = std::move(columns[i]);
+        if (run_ends.size() == end - begin) {
+            // every key has a single row
+            result.push_back(std::move(column));
+            continue;
+        }
+        vectorized::ColumnPtr aggregated;
+        RETURN_NOT_OK(_aggregator.aggregate_column(_column_ids[i], column, run_ends, &aggregated));
+        result.push_back(std::move(aggregated));
+    }
+
+    *eof = false;
+    if (block->rows() == 0) {
+        block->setColumns(result);
+        return OLAP_SUCCESS;
+    }
+    auto block_columns = block->mutateColumns();
+    for (size_t i = 0; i < block_columns.size(); ++i) {
+        block_columns[i]->insertRangeFrom(*result[i], 0, result[i]->size());
+    }
+    block->setColumns(std::move(block_columns));
+    return OLAP_SUCCESS;
+}
+
+} // namespace doris
@@ -0,0 +1,161 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "olap/block_aggregator.h"
+#include "olap/olap_common.h"
+#include "olap/olap_define.h"
+#include "olap/rowset/rowset_reader.h"
+#include "vec/common/loser_tree.h"
+#include "vec/core/block.h"
+
+namespace doris {
+
+class TabletSchema;
+
+// The sources of the rows merged by the key columns in a vertical compaction, in the order of
+// the merge: the child of every row, and whether the row is aggregated with the next one, of
+// the same key. The value columns are merged in the same order by VValueGroupIterator.
+// Two bytes a row are kept in memory.
+class RowSourcesBuffer {
+public:
+    // The children of the merges are less than this.
+    static const size_t MAX_CHILDREN = 1 << 15;
+
+    void append(uint16_t child, bool agg_with_next) {
+        _sources.push_back(agg_with_next ? child | AGG_FLAG : child);
+    }
+
+    size_t size() const { return _sources.size(); }
+
+    uint16_t child(size_t row) const { return _sources[row] & ~AGG_FLAG; }
+
+    bool agg_with_next(size_t row) const { return _sources[row] & AGG_FLAG; }
+
+private:
+    static const uint16_t AGG_FLAG = 1 << 15;
+
+    std::vector<uint16_t> _sources;
+};
+
+// Vectorized version of CollectIterator for the merges of compactions.
+// The rowset readers return their sorted rows as Blocks, and a loser tree over them compares
+// their key columns to find the source of the next rows. The rows of the winner which go
+// before the current row of the runner-up are copied at once, then the rows of the same key
+// are aggregated column by column by BlockAggregator.
+// The blocks have all the columns of the tablet schema, in the same order, or only the key
+// columns if the row sources are recorded.
+class VCollectIterator {
+public:
+    VCollectIterator(const TabletSchema* tablet_schema, KeysType keys_type);
+    ~VCollectIterator();
+
+    // The rows of rs_reader must be sorted by the keys.
+    void add_child(RowsetReaderSharedPtr rs_reader);
+
+    // For the merge of the key columns of a vertical compaction, records the source of every
+    // merged row into row_sources. The blocks have only the key columns.
+    void set_row_sources(RowSourcesBuffer* row_sources) { _row_sources = row_sources; }
+
+    // Append the next merged rows to the columns of *block.
+    // Return OLAP_SUCCESS and set `*eof` to true when no more rows can be read.
+    // Return others when unexpected error happens.
+    OLAPStatus next_block(vectorized::Block* block, bool* eof);
+
+    // The rows merged into the rows of the same key.
+    uint64_t merged_rows() const { return _merged_rows; }
+
+private:
+    class Child;
+
+    // The cursor of the loser tree, a child and its current row.
+    struct MergeCursor {
+        Child* child;
+        bool greater(const MergeCursor& rhs) const;
+    };
+
+    // Reads the first block of every child, and builds the loser tree of those having rows.
+    OLAPStatus _init(const vectorized::Block& header);
+
+    // Merges up to `max_rows` rows into `columns`.
+    OLAPStatus _merge(size_t max_rows, vectorized::MutableColumns* columns);
+
+    // Aggregates the rows of the same key at the head of _pending_columns into block, the rows
+    // of the last key are kept pending if more rows of the key may follow.
+    OLAPStatus _aggregate_pending(bool is_last, vectorized::Block* block);
+
+    const TabletSchema* _tablet_schema;
+    const KeysType _keys_type;
+    BlockAggregator _aggregator;
+
+    bool _inited = false;
+    std::vector<std::unique_ptr<Child>> _children;
+    vectorized::LoserTree<MergeCursor> _tree;
+
+    // the merged rows which are not aggregated yet
+    vectorized::Block _header;
+    vectorized::MutableColumns _pending_columns;
+
+    RowSourcesBuffer* _row_sources = nullptr;
+    // the children of the merged rows which are not recorded yet
+    std::vector<uint16_t> _pending_sources;
+
+    uint64_t _merged_rows = 0;
+};
+
+// Merges the value columns of a vertical compaction in the order of the merge of the key
+// columns, whose row sources were recorded by a VCollectIterator over the same children, and
+// aggregates the rows of every key column by column by BlockAggregator.
+class VValueGroupIterator {
+public:
+    // The columns of the blocks are the first column_ids, which are value columns.
+    VValueGroupIterator(const TabletSchema* tablet_schema, std::vector<uint32_t> column_ids,
+                        const RowSourcesBuffer* row_sources);
+    ~VValueGroupIterator();
+
+    // The children are added in the same order as those of the merge of the key columns.
+    void add_child(RowsetReaderSharedPtr rs_reader);
+
+    // Append the next merged rows to the columns of *block.
+    // Return OLAP_SUCCESS and set `*eof` to true when no more rows can be read.
+    // Return others when unexpected error happens.
+    OLAPStatus next_block(vectorized::Block* block, bool* eof);
+
+private:
+    // A rowset reader and its current block.
+    struct Child {
+        RowsetReaderSharedPtr rs_reader;
+        vectorized::Block block;
+        size_t pos = 0;
+    };
+
+    const std::vector<uint32_t> _column_ids;
+    const RowSourcesBuffer* _row_sources;
+    BlockAggregator _aggregator;
+
+    bool _inited = false;
+    vectorized::Block _header;
+    std::vector<Child> _children;
+    // the next row of _row_sources
+    size_t _source_pos = 0;
+};
+
+} // namespace doris
@@ -451,6 +451,20 @@ public:
 
     void set_type(int type);
 
+    // Set the date part, which must be a valid date.
+    void set_date(uint32_t year, uint32_t month, uint32_t day) {
+        _year = year;
+        _month = month;
+        _day = day;
+    }
+
+    // Set the time part, which must be a valid time of day.
+    void set_time(uint32_t hour, uint32_t minute, uint32_t second) {
+        _hour = hour;
+        _minute = minute;
+        _second = second;
+    }
+
     bool is_valid_date() const { return !check_range() && !check_date() && _month > 0 && _day > 0; }
 
 private:
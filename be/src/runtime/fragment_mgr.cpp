@@ -554,6 +554,23 @@ Status FragmentMgr::cancel(const TUniqueId& fragment_id, const PPlanFragmentCanc
     return Status::OK();
 }
 
+Status FragmentMgr::apply_runtime_filters(const PApplyRuntimeFiltersRequest& request) {
+    TUniqueId fragment_id;
+    fragment_id.__set_hi(request.finst_id().hi());
+    fragment_id.__set_lo(request.finst_id().lo());
+    std::shared_ptr<FragmentExecState> exec_state;
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        auto iter = _fragment_map.find(fragment_id);
+        if (iter == _fragment_map.end()) {
+            // the fragment is done, or was cancelled
+            return Status::OK();
+        }
+        exec_state = iter->second;
+    }
+    return exec_state->executor()->apply_runtime_filters(request);
+}
+
 void FragmentMgr::cancel_worker() {
     LOG(INFO) << "FragmentMgr cancel worker start working.";
     do {
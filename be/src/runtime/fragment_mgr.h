@@ -69,6 +69,9 @@ public:
 
     Status cancel(const TUniqueId& fragment_id, const PPlanFragmentCancelReason& reason);
 
+    // Apply the runtime filters of a hash join to the fragment scanning its probe side.
+    Status apply_runtime_filters(const PApplyRuntimeFiltersRequest& request);
+
     void cancel_worker();
 
     virtual void debug(std::stringstream& ss);
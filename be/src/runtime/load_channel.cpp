@@ -86,7 +86,7 @@ Status LoadChannel::add_batch(const PTabletWriterAddBatchRequest& request,
     handle_mem_exceed_limit(false);
 
     // 3. add batch to tablets channel
-    if (request.has_row_batch()) {
+    if (request.has_row_batch() || request.has_block()) {
         RETURN_IF_ERROR(channel->add_batch(request));
     }
 
@@ -30,6 +30,7 @@
 #include "exec/exec_node.h"
 #include "exec/scan_node.h"
 #include "exprs/expr.h"
+#include "exprs/runtime_filter.h"
 #include "runtime/data_stream_mgr.h"
 #include "runtime/descriptors.h"
 #include "runtime/exec_env.h"
@@ -44,6 +45,8 @@
 #include "util/pretty_printer.h"
 #include "util/uid_util.h"
 #include "vec/core/block.h"
+#include "vec/exec/exchange_node.h"
+#include "vec/runtime/data_stream_mgr.h"
 #include "vec/sink/data_sink.h"
 
 namespace doris {
@@ -174,6 +177,14 @@ Status PlanFragmentExecutor::prepare(const TExecPlanFragmentParams& request,
         DCHECK_GT(num_senders, 0);
         static_cast<ExchangeNode*>(exch_node)->set_num_senders(num_senders);
     }
+    exch_nodes.clear();
+    _plan->collect_nodes(TPlanNodeType::VEXCHANGE_NODE, &exch_nodes);
+    BOOST_FOREACH (ExecNode* exch_node, exch_nodes) {
+        DCHECK_EQ(exch_node->type(), TPlanNodeType::VEXCHANGE_NODE);
+        int num_senders = find_with_default(params.per_exch_num_senders, exch_node->id(), 0);
+        DCHECK_GT(num_senders, 0);
+        static_cast<vectorized::VExchangeNode*>(exch_node)->set_num_senders(num_senders);
+    }
 
     RETURN_IF_ERROR(_plan->prepare(_runtime_state.get()));
     // set scan ranges
@@ -301,8 +312,7 @@ Status PlanFragmentExecutor::open_vectorized_internal() {
         if (_collect_query_statistics_with_every_batch) {
             _collect_query_statistics();
         }
-        auto vsink = static_cast<doris::vectorized::VDataSink*>(_sink.get());
-        RETURN_IF_ERROR(vsink->send(runtime_state(), block));
+        RETURN_IF_ERROR(_sink->send(runtime_state(), block));
     }
     {
         SCOPED_TIMER(profile()->total_time_counter());
@@ -605,9 +615,42 @@ void PlanFragmentExecutor::cancel() {
     DCHECK(_prepared);
     _runtime_state->set_is_cancelled(true);
     _runtime_state->exec_env()->stream_mgr()->cancel(_runtime_state->fragment_instance_id());
+    _runtime_state->exec_env()->vstream_mgr()->cancel(_runtime_state->fragment_instance_id());
     _runtime_state->exec_env()->result_mgr()->cancel(_runtime_state->fragment_instance_id());
 }
 
+Status PlanFragmentExecutor::apply_runtime_filters(const PApplyRuntimeFiltersRequest& request) {
+    DCHECK(_prepared);
+    std::vector<std::unique_ptr<RuntimeFilter>> filters;
+    for (const auto& pfilter : request.filters()) {
+        filters.emplace_back();
+        RETURN_IF_ERROR(RuntimeFilter::create_from_protobuf(pfilter, &filters.back()));
+    }
+
+    std::lock_guard<std::mutex> l(_runtime_filters_lock);
+    auto& received = _received_runtime_filters[request.node_id()];
+    for (auto& filter : filters) {
+        // an instance omits the filter of a slot without any build key
+        auto& merged = received.second[filter->slot_id()];
+        if (merged == nullptr) {
+            merged = obj_pool()->add(filter.release());
+        } else {
+            RETURN_IF_ERROR(merged->merge(*filter));
+        }
+    }
+    if (++received.first < request.num_senders()) {
+        return Status::OK();
+    }
+
+    std::vector<RuntimeFilter*> merged_filters;
+    for (const auto& slot_filter : received.second) {
+        merged_filters.push_back(slot_filter.second);
+    }
+    // the filters are dropped if the scans have already started
+    _plan->push_down_runtime_filters(_runtime_state.get(), &merged_filters);
+    return Status::OK();
+}
+
 void PlanFragmentExecutor::set_abort() {
     update_status(Status::Aborted("Execution aborted before start"));
 }
@@ -20,10 +20,13 @@
 
 #include <boost/function.hpp>
 #include <boost/scoped_ptr.hpp>
+#include <map>
+#include <mutex>
 #include <vector>
 
 #include "common/object_pool.h"
 #include "common/status.h"
+#include "gen_cpp/internal_service.pb.h"
 #include "runtime/datetime_value.h"
 #include "runtime/query_statistics.h"
 #include "runtime/runtime_state.h"
@@ -38,6 +41,7 @@ class HdfsFsCache;
 class ExecNode;
 class RowDescriptor;
 class RowBatch;
+class RuntimeFilter;
 class DataSink;
 class DataStreamMgr;
 class RuntimeProfile;
@@ -132,6 +136,12 @@ public:
     // Releases the thread token for this fragment executor.
     void release_thread_token();
 
+    // Merge the runtime filters of an instance of a hash join of another fragment.
+    // Once the filters of all its instances are received, they are pushed down to the
+    // scans of this fragment which have not started yet.
+    // Must not be called until after prepare() returned.
+    Status apply_runtime_filters(const PApplyRuntimeFiltersRequest& request);
+
     // call these only after prepare()
     RuntimeState* runtime_state() { return _runtime_state.get(); }
     const RowDescriptor& row_desc();
@@ -227,6 +237,12 @@ private:
 
     bool _enable_vectorized_engine;
 
+    // the runtime filters received from other fragments by the id of their join node:
+    // the number of instances of the join they are merged from, and the merged filters,
+    // which live in _runtime_state->obj_pool()
+    std::mutex _runtime_filters_lock;
+    std::map<int, std::pair<int, std::map<SlotId, RuntimeFilter*>>> _received_runtime_filters;
+
     ObjectPool* obj_pool() { return _runtime_state->obj_pool(); }
 
     // typedef for TPlanFragmentExecParams.per_node_scan_ranges
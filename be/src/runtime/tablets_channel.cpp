@@ -24,6 +24,7 @@
 #include "runtime/row_batch.h"
 #include "runtime/tuple_row.h"
 #include "util/doris_metrics.h"
+#include "vec/core/block.h"
 
 namespace doris {
 
@@ -64,6 +65,7 @@ Status TabletsChannel::open(const PTabletWriterOpenRequest& params) {
     RETURN_IF_ERROR(_schema->init(params.schema()));
     _tuple_desc = _schema->tuple_desc();
     _row_desc = new RowDescriptor(_tuple_desc, false);
+    _is_vectorized = params.is_vectorized();
 
     _num_remaining_senders = params.num_senders();
     _next_seqs.resize(_num_remaining_senders, 0);
@@ -76,7 +78,8 @@ Status TabletsChannel::open(const PTabletWriterOpenRequest& params) {
 }
 
 Status TabletsChannel::add_batch(const PTabletWriterAddBatchRequest& params) {
-    DCHECK(params.tablet_ids_size() == params.row_batch().num_rows());
+    DCHECK(params.tablet_ids_size() == (params.has_block() ? params.block().num_rows()
+                                                            : params.row_batch().num_rows()));
     int64_t cur_seq;
     {
         std::lock_guard<std::mutex> l(_lock);
@@ -99,17 +102,77 @@ Status TabletsChannel::add_batch(const PTabletWriterAddBatchRequest& params) {
         }
     }
 
-    RowBatch row_batch(*_row_desc, params.row_batch(), _mem_tracker.get());
+    if (params.has_block()) {
+        RETURN_IF_ERROR(_write_block(params));
+    } else {
+        RowBatch row_batch(*_row_desc, params.row_batch(), _mem_tracker.get());
 
-    // iterator all data
+        // iterator all data
+        for (int i = 0; i < params.tablet_ids_size(); ++i) {
+            auto tablet_id = params.tablet_ids(i);
+            auto it = _tablet_writers.find(tablet_id);
+            if (it == std::end(_tablet_writers)) {
+                return Status::InternalError(strings::Substitute(
+                        "unknown tablet to append data, tablet=$0", tablet_id));
+            }
+            auto st = it->second->write(row_batch.get_row(i)->get_tuple(0));
+            if (st != OLAP_SUCCESS) {
+                const std::string& err_msg = strings::Substitute(
+                        "tablet writer write failed, tablet_id=$0, txn_id=$1, err=$2", it->first,
+                        _txn_id, st);
+                LOG(WARNING) << err_msg;
+                return Status::InternalError(err_msg);
+            }
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        _next_seqs[params.sender_id()] = cur_seq + 1;
+    }
+    return Status::OK();
+}
+
+Status TabletsChannel::_write_block(const PTabletWriterAddBatchRequest& params) {
+    vectorized::Block block;
+    for (auto slot_desc : _tuple_desc->slots()) {
+        block.insert({slot_desc->get_empty_mutable_column(), slot_desc->get_data_type_ptr(),
+                      slot_desc->col_name()});
+    }
+    RETURN_IF_ERROR(block.deserialize(params.block()));
+
+    // number the tablets in the order their rows come, and split the columns of the index
+    std::vector<int64_t> tablet_ids;
+    std::unordered_map<int64_t, size_t> tablet_numbers;
+    vectorized::IColumn::Selector selector(params.tablet_ids_size());
     for (int i = 0; i < params.tablet_ids_size(); ++i) {
         auto tablet_id = params.tablet_ids(i);
-        auto it = _tablet_writers.find(tablet_id);
+        auto it = tablet_numbers.emplace(tablet_id, tablet_ids.size()).first;
+        if (it->second == tablet_ids.size()) {
+            tablet_ids.push_back(tablet_id);
+        }
+        selector[i] = it->second;
+    }
+    std::vector<vectorized::Block> tablet_blocks(tablet_ids.size());
+    for (int position : _index_slot_positions) {
+        const auto& elem = block.getByPosition(position);
+        if (tablet_ids.size() == 1) {
+            tablet_blocks[0].insert(elem);
+            continue;
+        }
+        auto columns = elem.column->scatter(tablet_ids.size(), selector);
+        for (size_t i = 0; i < tablet_ids.size(); ++i) {
+            tablet_blocks[i].insert({std::move(columns[i]), elem.type, elem.name});
+        }
+    }
+
+    for (size_t i = 0; i < tablet_ids.size(); ++i) {
+        auto it = _tablet_writers.find(tablet_ids[i]);
         if (it == std::end(_tablet_writers)) {
-            return Status::InternalError(
-                    strings::Substitute("unknown tablet to append data, tablet=$0", tablet_id));
+            return Status::InternalError(strings::Substitute(
+                    "unknown tablet to append data, tablet=$0", tablet_ids[i]));
         }
-        auto st = it->second->write(row_batch.get_row(i)->get_tuple(0));
+        auto st = it->second->write(&tablet_blocks[i]);
         if (st != OLAP_SUCCESS) {
             const std::string& err_msg = strings::Substitute(
                     "tablet writer write failed, tablet_id=$0, txn_id=$1, err=$2", it->first,
@@ -118,11 +181,6 @@ Status TabletsChannel::add_batch(const PTabletWriterAddBatchRequest& params) {
             return Status::InternalError(err_msg);
         }
     }
-
-    {
-        std::lock_guard<std::mutex> l(_lock);
-        _next_seqs[params.sender_id()] = cur_seq + 1;
-    }
     return Status::OK();
 }
 
@@ -223,6 +281,11 @@ Status TabletsChannel::_open_all_writers(const PTabletWriterOpenRequest& params)
         ss << "unknown index id, key=" << _key;
         return Status::InternalError(ss.str());
     }
+    const auto& slots = _tuple_desc->slots();
+    for (auto slot_desc : *index_slots) {
+        _index_slot_positions.push_back(std::find(slots.begin(), slots.end(), slot_desc) -
+                                        slots.begin());
+    }
     for (auto& tablet : params.tablets()) {
         WriteRequest request;
         request.tablet_id = tablet.tablet_id();
@@ -234,6 +297,7 @@ Status TabletsChannel::_open_all_writers(const PTabletWriterOpenRequest& params)
         request.need_gen_rollup = params.need_gen_rollup();
         request.tuple_desc = _tuple_desc;
         request.slots = index_slots;
+        request.is_vec = _is_vectorized;
 
         DeltaWriter* writer = nullptr;
         auto st = DeltaWriter::open(&request, _mem_tracker, &writer);
@@ -86,6 +86,9 @@ private:
     // open all writer
     Status _open_all_writers(const PTabletWriterOpenRequest& params);
 
+    // writes the block of a batch of the vectorized sink, split by tablet
+    Status _write_block(const PTabletWriterAddBatchRequest& params);
+
 private:
     // id of this load channel
     TabletsChannelKey _key;
@@ -107,6 +110,10 @@ private:
     TupleDescriptor* _tuple_desc = nullptr;
     // row_desc used to construct
     RowDescriptor* _row_desc = nullptr;
+    // the batches are blocks of the vectorized engine
+    bool _is_vectorized = false;
+    // the columns of a block the index takes, the positions of its slots in the tuple
+    std::vector<int> _index_slot_positions;
 
     // next sequence we expect
     int _num_remaining_senders = 0;
@@ -30,6 +30,7 @@
 #include "service/brpc.h"
 #include "util/thrift_util.h"
 #include "util/uid_util.h"
+#include "vec/runtime/data_stream_mgr.h"
 
 namespace doris {
 
@@ -53,6 +54,25 @@ void PInternalServiceImpl<T>::transmit_data(google::protobuf::RpcController* cnt
     }
 }
 
+template <typename T>
+void PInternalServiceImpl<T>::transmit_block(google::protobuf::RpcController* cntl_base,
+                                             const PTransmitDataParams* request,
+                                             PTransmitDataResult* response,
+                                             google::protobuf::Closure* done) {
+    VLOG_ROW << "transmit block: fragment_instance_id=" << print_id(request->finst_id())
+             << " node=" << request->node_id();
+    auto st = _exec_env->vstream_mgr()->transmit_block(request, &done);
+    if (!st.ok()) {
+        LOG(WARNING) << "transmit block failed, message=" << st.get_error_msg()
+                     << ", fragment_instance_id=" << print_id(request->finst_id())
+                     << ", node=" << request->node_id();
+        st.to_protobuf(response->mutable_status());
+    }
+    if (done != nullptr) {
+        done->Run();
+    }
+}
+
 template <typename T>
 void PInternalServiceImpl<T>::tablet_writer_open(google::protobuf::RpcController* controller,
                                                  const PTabletWriterOpenRequest* request,
@@ -167,6 +187,20 @@ void PInternalServiceImpl<T>::cancel_plan_fragment(google::protobuf::RpcControll
     st.to_protobuf(result->mutable_status());
 }
 
+template <typename T>
+void PInternalServiceImpl<T>::apply_runtime_filters(google::protobuf::RpcController* cntl_base,
+                                                    const PApplyRuntimeFiltersRequest* request,
+                                                    PApplyRuntimeFiltersResult* result,
+                                                    google::protobuf::Closure* done) {
+    brpc::ClosureGuard closure_guard(done);
+    auto st = _exec_env->fragment_mgr()->apply_runtime_filters(*request);
+    if (!st.ok()) {
+        LOG(WARNING) << "apply runtime filters failed, fragment_instance_id="
+                     << print_id(request->finst_id()) << ", errmsg=" << st.get_error_msg();
+    }
+    st.to_protobuf(result->mutable_status());
+}
+
 template <typename T>
 void PInternalServiceImpl<T>::fetch_data(google::protobuf::RpcController* cntl_base,
                                          const PFetchDataRequest* request, PFetchDataResult* result,
@@ -42,6 +42,11 @@ public:
                        ::doris::PTransmitDataResult* response,
                        ::google::protobuf::Closure* done) override;
 
+    void transmit_block(::google::protobuf::RpcController* controller,
+                        const ::doris::PTransmitDataParams* request,
+                        ::doris::PTransmitDataResult* response,
+                        ::google::protobuf::Closure* done) override;
+
     void exec_plan_fragment(google::protobuf::RpcController* controller,
                             const PExecPlanFragmentRequest* request,
                             PExecPlanFragmentResult* result,
@@ -52,6 +57,11 @@ public:
                               PCancelPlanFragmentResult* result,
                               google::protobuf::Closure* done) override;
 
+    void apply_runtime_filters(google::protobuf::RpcController* controller,
+                               const PApplyRuntimeFiltersRequest* request,
+                               PApplyRuntimeFiltersResult* result,
+                               google::protobuf::Closure* done) override;
+
     void fetch_data(google::protobuf::RpcController* controller, const PFetchDataRequest* request,
                     PFetchDataResult* result, google::protobuf::Closure* done) override;
 
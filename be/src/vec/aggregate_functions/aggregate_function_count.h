@@ -17,9 +17,6 @@
 
 #pragma once
 
-// #include <IO/VarInt.h>
-// #include <IO/WriteHelpers.h>
-
 #include <vec/aggregate_functions/aggregate_function.h>
 #include <vec/columns/column_nullable.h>
 #include <vec/common/assert_cast.h>
@@ -57,15 +54,13 @@ public:
         data(place).count += data(rhs).count;
     }
 
-    // void serialize(ConstAggregateDataPtr place, WriteBuffer & buf) const override
-    // {
-    //     writeVarUInt(data(place).count, buf);
-    // }
+    void serialize(ConstAggregateDataPtr place, BufferWritable& buf) const override {
+        buf.write_binary(data(place).count);
+    }
 
-    // void deserialize(AggregateDataPtr place, ReadBuffer & buf, Arena *) const override
-    // {
-    //     readVarUInt(data(place).count, buf);
-    // }
+    void deserialize(AggregateDataPtr place, BufferReadable& buf, Arena*) const override {
+        buf.read_binary(data(place).count);
+    }
 
     void insertResultInto(ConstAggregateDataPtr place, IColumn& to) const override {
         assert_cast<ColumnUInt64&>(to).getData().push_back(data(place).count);
@@ -102,15 +97,13 @@ public:
         data(place).count += data(rhs).count;
     }
 
-    // void serialize(ConstAggregateDataPtr place, WriteBuffer & buf) const override
-    // {
-    //     writeVarUInt(data(place).count, buf);
-    // }
+    void serialize(ConstAggregateDataPtr place, BufferWritable& buf) const override {
+        buf.write_binary(data(place).count);
+    }
 
-    // void deserialize(AggregateDataPtr place, ReadBuffer & buf, Arena *) const override
-    // {
-    //     readVarUInt(data(place).count, buf);
-    // }
+    void deserialize(AggregateDataPtr place, BufferReadable& buf, Arena*) const override {
+        buf.read_binary(data(place).count);
+    }
 
     void insertResultInto(ConstAggregateDataPtr place, IColumn& to) const override {
         assert_cast<ColumnUInt64&>(to).getData().push_back(data(place).count);
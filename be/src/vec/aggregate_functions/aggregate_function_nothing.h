@@ -51,13 +51,9 @@ public:
 
     void merge(AggregateDataPtr, ConstAggregateDataPtr, Arena*) const override {}
 
-    // void serialize(ConstAggregateDataPtr, WriteBuffer &) const override
-    // {
-    // }
+    void serialize(ConstAggregateDataPtr, BufferWritable&) const override {}
 
-    // void deserialize(AggregateDataPtr, ReadBuffer &, Arena *) const override
-    // {
-    // }
+    void deserialize(AggregateDataPtr, BufferReadable&, Arena*) const override {}
 
     void insertResultInto(ConstAggregateDataPtr, IColumn& to) const override { to.insertDefault(); }
 
@@ -23,8 +23,6 @@
 #include <vec/data_types/data_type_nullable.h>
 
 #include <array>
-// #include <IO/ReadHelpers.h>
-// #include <IO/WriteHelpers.h>
 
 namespace doris::vectorized {
 
@@ -116,26 +114,20 @@ public:
         nested_function->merge(nestedPlace(place), nestedPlace(rhs), arena);
     }
 
-    // void serialize(ConstAggregateDataPtr place, WriteBuffer & buf) const override
-    // {
-    //     bool flag = getFlag(place);
-    //     if (result_is_nullable)
-    //         writeBinary(flag, buf);
-    //     if (flag)
-    //         nested_function->serialize(nestedPlace(place), buf);
-    // }
-
-    // void deserialize(AggregateDataPtr place, ReadBuffer & buf, Arena * arena) const override
-    // {
-    //     bool flag = 1;
-    //     if (result_is_nullable)
-    //         readBinary(flag, buf);
-    //     if (flag)
-    //     {
-    //         setFlag(place);
-    //         nested_function->deserialize(nestedPlace(place), buf, arena);
-    //     }
-    // }
+    void serialize(ConstAggregateDataPtr place, BufferWritable& buf) const override {
+        bool flag = getFlag(place);
+        if (result_is_nullable) buf.write_binary(flag);
+        if (flag) nested_function->serialize(nestedPlace(place), buf);
+    }
+
+    void deserialize(AggregateDataPtr place, BufferReadable& buf, Arena* arena) const override {
+        bool flag = 1;
+        if (result_is_nullable) buf.read_binary(flag);
+        if (flag) {
+            setFlag(place);
+            nested_function->deserialize(nestedPlace(place), buf, arena);
+        }
+    }
 
     void insertResultInto(ConstAggregateDataPtr place, IColumn& to) const override {
         if (result_is_nullable) {
@@ -19,9 +19,6 @@
 
 #include <type_traits>
 
-// #include <IO/WriteHelpers.h>
-// #include <IO/ReadHelpers.h>
-
 #include "vec/aggregate_functions/aggregate_function.h"
 #include "vec/columns/column_vector.h"
 #include "vec/data_types/data_types_decimal.h"
@@ -37,9 +34,9 @@ struct AggregateFunctionSumData {
 
     void merge(const AggregateFunctionSumData& rhs) { sum += rhs.sum; }
 
-    void write(WriteBuffer& buf) const { writeBinary(sum, buf); }
+    void write(BufferWritable& buf) const { buf.write_binary(sum); }
 
-    void read(ReadBuffer& buf) { readBinary(sum, buf); }
+    void read(BufferReadable& buf) { buf.read_binary(sum); }
 
     T get() const { return sum; }
 };
@@ -69,14 +66,14 @@ struct AggregateFunctionSumKahanData {
         compensation = compensations - (sum - raw_sum);
     }
 
-    void write(WriteBuffer& buf) const {
-        writeBinary(sum, buf);
-        writeBinary(compensation, buf);
+    void write(BufferWritable& buf) const {
+        buf.write_binary(sum);
+        buf.write_binary(compensation);
     }
 
-    void read(ReadBuffer& buf) {
-        readBinary(sum, buf);
-        readBinary(compensation, buf);
+    void read(BufferReadable& buf) {
+        buf.read_binary(sum);
+        buf.read_binary(compensation);
     }
 
     T get() const { return sum; }
@@ -122,15 +119,13 @@ public:
         this->data(place).merge(this->data(rhs));
     }
 
-    // void serialize(ConstAggregateDataPtr place, WriteBuffer & buf) const override
-    // {
-    //     this->data(place).write(buf);
-    // }
+    void serialize(ConstAggregateDataPtr place, BufferWritable& buf) const override {
+        this->data(place).write(buf);
+    }
 
-    // void deserialize(AggregateDataPtr place, ReadBuffer & buf, Arena *) const override
-    // {
-    //     this->data(place).read(buf);
-    // }
+    void deserialize(AggregateDataPtr place, BufferReadable& buf, Arena*) const override {
+        this->data(place).read(buf);
+    }
 
     void insertResultInto(ConstAggregateDataPtr place, IColumn& to) const override {
         auto& column = static_cast<ColVecResult&>(to);
@@ -81,17 +81,16 @@ ColumnPtr ColumnConst::permute(const Permutation& perm, size_t limit) const {
     return ColumnConst::create(data, limit);
 }
 
-//ColumnPtr ColumnConst::index(const IColumn & indexes, size_t limit) const
-//{
-//    if (limit == 0)
-//        limit = indexes.size();
-//
-//    if (indexes.size() < limit)
-//        throw Exception("Size of indexes (" + std::to_string(indexes.size()) + ") is less than required (" + std::to_string(limit) + ")",
-//                        ErrorCodes::SIZES_OF_COLUMNS_DOESNT_MATCH);
-//
-//    return ColumnConst::create(data, limit);
-//}
+ColumnPtr ColumnConst::index(const IColumn& indexes, size_t limit) const {
+    if (limit == 0) limit = indexes.size();
+
+    if (indexes.size() < limit)
+        throw Exception("Size of indexes (" + std::to_string(indexes.size()) +
+                                ") is less than required (" + std::to_string(limit) + ")",
+                        ErrorCodes::SIZES_OF_COLUMNS_DOESNT_MATCH);
+
+    return ColumnConst::create(data, limit);
+}
 
 MutableColumns ColumnConst::scatter(ColumnIndex num_columns, const Selector& selector) const {
     if (s != selector.size())
@@ -107,11 +106,10 @@ MutableColumns ColumnConst::scatter(ColumnIndex num_columns, const Selector& sel
     return res;
 }
 
-//void ColumnConst::getPermutation(bool /*reverse*/, size_t /*limit*/, int /*nan_direction_hint*/, Permutation & res) const
-//{
-//    res.resize(s);
-//    for (size_t i = 0; i < s; ++i)
-//        res[i] = i;
-//}
+void ColumnConst::getPermutation(bool /*reverse*/, size_t /*limit*/, int /*nan_direction_hint*/,
+                                 Permutation& res) const {
+    res.resize(s);
+    for (size_t i = 0; i < s; ++i) res[i] = i;
+}
 
 } // namespace doris::vectorized
@@ -111,8 +111,9 @@ public:
     ColumnPtr filter(const Filter& filt, ssize_t result_size_hint) const override;
     ColumnPtr replicate(const Offsets& offsets) const override;
     ColumnPtr permute(const Permutation& perm, size_t limit) const override;
-    // ColumnPtr index(const IColumn & indexes, size_t limit) const override;
-    // void getPermutation(bool reverse, size_t limit, int nan_direction_hint, Permutation & res) const override;
+    ColumnPtr index(const IColumn& indexes, size_t limit) const override;
+    void getPermutation(bool reverse, size_t limit, int nan_direction_hint,
+                        Permutation& res) const override;
 
     size_t byteSize() const override { return data->byteSize() + sizeof(s); }
 
@@ -77,24 +77,11 @@ void ColumnDecimal<T>::updateHashWithValue(size_t n, SipHash& hash) const {
     hash.update(data[n]);
 }
 
-//template <typename T>
-//void ColumnDecimal<T>::getPermutation(bool reverse, size_t limit, int , IColumn::Permutation & res) const
-//{
-//#if 1 /// TODO: perf test
-//    if (data.size() <= std::numeric_limits<UInt32>::max())
-//    {
-//        PaddedPODArray<UInt32> tmp_res;
-//        permutation(reverse, limit, tmp_res);
-//
-//        res.resize(tmp_res.size());
-//        for (size_t i = 0; i < tmp_res.size(); ++i)
-//            res[i] = tmp_res[i];
-//        return;
-//    }
-//#endif
-//
-//    permutation(reverse, limit, res);
-//}
+template <typename T>
+void ColumnDecimal<T>::getPermutation(bool reverse, size_t limit, int,
+                                      IColumn::Permutation& res) const {
+    permutation(reverse, limit, res);
+}
 
 template <typename T>
 ColumnPtr ColumnDecimal<T>::permute(const IColumn::Permutation& perm, size_t limit) const {
@@ -181,11 +168,10 @@ ColumnPtr ColumnDecimal<T>::filter(const IColumn::Filter& filt, ssize_t result_s
     return res;
 }
 
-//template <typename T>
-//ColumnPtr ColumnDecimal<T>::index(const IColumn & indexes, size_t limit) const
-//{
-//    return selectIndexImpl(*this, indexes, limit);
-//}
+template <typename T>
+ColumnPtr ColumnDecimal<T>::index(const IColumn& indexes, size_t limit) const {
+    return selectIndexImpl(*this, indexes, limit);
+}
 
 template <typename T>
 ColumnPtr ColumnDecimal<T>::replicate(const IColumn::Offsets& offsets) const {
@@ -107,7 +107,8 @@ public:
     const char* deserializeAndInsertFromArena(const char* pos) override;
     void updateHashWithValue(size_t n, SipHash& hash) const override;
     int compareAt(size_t n, size_t m, const IColumn& rhs_, int nan_direction_hint) const override;
-    //    void getPermutation(bool reverse, size_t limit, int nan_direction_hint, IColumn::Permutation & res) const override;
+    void getPermutation(bool reverse, size_t limit, int nan_direction_hint,
+                        IColumn::Permutation& res) const override;
 
     MutableColumnPtr cloneResized(size_t size) const override;
 
@@ -127,7 +128,7 @@ public:
 
     ColumnPtr filter(const IColumn::Filter& filt, ssize_t result_size_hint) const override;
     ColumnPtr permute(const IColumn::Permutation& perm, size_t limit) const override;
-    //    ColumnPtr index(const IColumn & indexes, size_t limit) const override;
+    ColumnPtr index(const IColumn& indexes, size_t limit) const override;
 
     template <typename Type>
     ColumnPtr indexImpl(const PaddedPODArray<Type>& indexes, size_t limit) const;
@@ -164,15 +165,19 @@ protected:
         res.resize(s);
         for (U i = 0; i < s; ++i) res[i] = i;
 
-        auto sort_end = res.end();
-        if (limit && limit < s) sort_end = res.begin() + limit;
-
-        if (reverse)
-            std::partial_sort(res.begin(), sort_end, res.end(),
-                              [this](size_t a, size_t b) { return data[a] > data[b]; });
-        else
-            std::partial_sort(res.begin(), sort_end, res.end(),
-                              [this](size_t a, size_t b) { return data[a] < data[b]; });
+        auto greater = [this](size_t a, size_t b) { return data[a] > data[b]; };
+        auto less = [this](size_t a, size_t b) { return data[a] < data[b]; };
+        if (limit && limit < s) {
+            if (reverse)
+                std::partial_sort(res.begin(), res.begin() + limit, res.end(), greater);
+            else
+                std::partial_sort(res.begin(), res.begin() + limit, res.end(), less);
+        } else {
+            if (reverse)
+                std::sort(res.begin(), res.end(), greater);
+            else
+                std::sort(res.begin(), res.end(), less);
+        }
     }
 };
 
@@ -92,20 +92,19 @@ public:
         return cloneDummy(limit ? std::min(s, limit) : s);
     }
 
-    // ColumnPtr index(const IColumn & indexes, size_t limit) const override
-    // {
-    //     if (indexes.size() < limit)
-    //         throw Exception("Size of indexes is less than required.", ErrorCodes::SIZES_OF_COLUMNS_DOESNT_MATCH);
+    ColumnPtr index(const IColumn& indexes, size_t limit) const override {
+        if (indexes.size() < limit)
+            throw Exception("Size of indexes is less than required.",
+                            ErrorCodes::SIZES_OF_COLUMNS_DOESNT_MATCH);
 
-    //     return cloneDummy(limit ? limit : s);
-    // }
+        return cloneDummy(limit ? limit : s);
+    }
 
-    // void getPermutation(bool /*reverse*/, size_t /*limit*/, int /*nan_direction_hint*/, Permutation & res) const override
-    // {
-    //     res.resize(s);
-    //     for (size_t i = 0; i < s; ++i)
-    //         res[i] = i;
-    // }
+    void getPermutation(bool /*reverse*/, size_t /*limit*/, int /*nan_direction_hint*/,
+                        Permutation& res) const override {
+        res.resize(s);
+        for (size_t i = 0; i < s; ++i) res[i] = i;
+    }
 
     ColumnPtr replicate(const Offsets& offsets) const override {
         if (s != offsets.size())
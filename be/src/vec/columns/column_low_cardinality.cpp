@@ -0,0 +1,146 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/columns/column_low_cardinality.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "vec/common/exception.h"
+
+namespace doris::vectorized {
+
+namespace ErrorCodes {
+extern const int LOGICAL_ERROR;
+extern const int NOT_IMPLEMENTED;
+extern const int SIZES_OF_COLUMNS_DOESNT_MATCH;
+} // namespace ErrorCodes
+
+ColumnLowCardinality::ColumnLowCardinality(const ColumnPtr& dictionary_, MutableColumnPtr&& codes_)
+        : dictionary(dictionary_), codes(std::move(codes_)) {
+    if (!typeid_cast<const ColumnUInt32*>(codes.get()))
+        throw Exception("Codes of a LowCardinality column must be UInt32, got " + codes->getName(),
+                        ErrorCodes::LOGICAL_ERROR);
+}
+
+ColumnLowCardinality::MutablePtr ColumnLowCardinality::createFromFullColumn(
+        const ColumnPtr& column) {
+    auto codes = ColumnUInt32::create(column->size());
+    auto& data = codes->getData();
+    std::iota(data.begin(), data.end(), 0);
+    return ColumnLowCardinality::create(column, std::move(codes));
+}
+
+MutableColumnPtr ColumnLowCardinality::cloneResized(size_t size) const {
+    if (size > this->size())
+        throw Exception("Cannot add default values to a LowCardinality column",
+                        ErrorCodes::NOT_IMPLEMENTED);
+    return ColumnLowCardinality::create(dictionary, codes->cloneResized(size));
+}
+
+void ColumnLowCardinality::insertFrom(const IColumn& src, size_t n) {
+    const auto& src_low_cardinality = assert_cast<const ColumnLowCardinality&>(src);
+    if (src_low_cardinality.dictionary.get() != dictionary.get())
+        throw Exception("Cannot insert the rows of another dictionary into a LowCardinality column",
+                        ErrorCodes::LOGICAL_ERROR);
+    getCodes().push_back(src_low_cardinality.getCode(n));
+}
+
+void ColumnLowCardinality::insertRangeFrom(const IColumn& src, size_t start, size_t length) {
+    const auto& src_low_cardinality = assert_cast<const ColumnLowCardinality&>(src);
+    if (src_low_cardinality.dictionary.get() != dictionary.get())
+        throw Exception("Cannot insert the rows of another dictionary into a LowCardinality column",
+                        ErrorCodes::LOGICAL_ERROR);
+    codes->insertRangeFrom(*src_low_cardinality.codes, start, length);
+}
+
+void ColumnLowCardinality::insert(const Field&) {
+    throw Exception("Cannot insert a value into a LowCardinality column",
+                    ErrorCodes::NOT_IMPLEMENTED);
+}
+
+void ColumnLowCardinality::insertData(const char*, size_t) {
+    throw Exception("Cannot insert a value into a LowCardinality column",
+                    ErrorCodes::NOT_IMPLEMENTED);
+}
+
+void ColumnLowCardinality::insertDefault() {
+    throw Exception("Cannot insert a value into a LowCardinality column",
+                    ErrorCodes::NOT_IMPLEMENTED);
+}
+
+const char* ColumnLowCardinality::deserializeAndInsertFromArena(const char*) {
+    throw Exception("Cannot insert a value into a LowCardinality column",
+                    ErrorCodes::NOT_IMPLEMENTED);
+}
+
+int ColumnLowCardinality::compareAt(size_t n, size_t m, const IColumn& rhs,
+                                    int nan_direction_hint) const {
+    if (auto rhs_low_cardinality = typeid_cast<const ColumnLowCardinality*>(&rhs)) {
+        if (rhs_low_cardinality->dictionary.get() == dictionary.get() &&
+            getCode(n) == rhs_low_cardinality->getCode(m))
+            return 0;
+        return dictionary->compareAt(getCode(n), rhs_low_cardinality->getCode(m),
+                                     *rhs_low_cardinality->dictionary, nan_direction_hint);
+    }
+    return dictionary->compareAt(getCode(n), m, rhs, nan_direction_hint);
+}
+
+void ColumnLowCardinality::getPermutation(bool reverse, size_t limit, int nan_direction_hint,
+                                          Permutation& res) const {
+    /// The equal values of the dictionary get the same rank.
+    Permutation dictionary_permutation;
+    dictionary->getPermutation(reverse, 0, nan_direction_hint, dictionary_permutation);
+    PaddedPODArray<UInt32> ranks(dictionary_permutation.size());
+    for (size_t i = 0; i < dictionary_permutation.size(); ++i) {
+        if (i > 0 && dictionary->compareAt(dictionary_permutation[i],
+                                           dictionary_permutation[i - 1], *dictionary,
+                                           nan_direction_hint) == 0) {
+            ranks[dictionary_permutation[i]] = ranks[dictionary_permutation[i - 1]];
+        } else {
+            ranks[dictionary_permutation[i]] = i;
+        }
+    }
+
+    size_t s = size();
+    if (limit >= s) limit = 0;
+    res.resize(s);
+    for (size_t i = 0; i < s; ++i) res[i] = i;
+
+    const auto& data = getCodes();
+    auto less = [&](size_t lhs, size_t rhs) { return ranks[data[lhs]] < ranks[data[rhs]]; };
+    if (limit)
+        std::partial_sort(res.begin(), res.begin() + limit, res.end(), less);
+    else
+        std::sort(res.begin(), res.end(), less);
+}
+
+MutableColumns ColumnLowCardinality::scatter(ColumnIndex num_columns,
+                                             const Selector& selector) const {
+    if (size() != selector.size())
+        throw Exception("Size of selector: " + std::to_string(selector.size()) +
+                                " doesn't match size of column: " + std::to_string(size()),
+                        ErrorCodes::SIZES_OF_COLUMNS_DOESNT_MATCH);
+
+    MutableColumns scattered_codes = codes->scatter(num_columns, selector);
+    MutableColumns res(num_columns);
+    for (size_t i = 0; i < num_columns; ++i)
+        res[i] = ColumnLowCardinality::create(dictionary, std::move(scattered_codes[i]));
+    return res;
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,163 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include "vec/columns/column.h"
+#include "vec/columns/columns_number.h"
+#include "vec/common/assert_cast.h"
+#include "vec/common/typeid_cast.h"
+
+namespace doris::vectorized {
+
+/** A column of values of a dictionary, every row is the position of its value in the
+  * dictionary column. The string columns read from the dictionary encoded pages of a segment
+  * keep the codes of the pages, and all the blocks read from the segment share its dictionary,
+  * so that the values are only decoded where they are needed, see convertToFullColumn().
+  *
+  * The dictionary is a column of any type, a nullable one if the column is nullable, the null
+  * being one of its values. Its values are not necessarily unique.
+  * The dictionary is shared, it is never mutated, and the rows of two columns can only be
+  * inserted into each other if they have the same dictionary.
+  */
+class ColumnLowCardinality final : public COWHelper<IColumn, ColumnLowCardinality> {
+private:
+    friend class COWHelper<IColumn, ColumnLowCardinality>;
+
+    ColumnLowCardinality(const ColumnPtr& dictionary_, MutableColumnPtr&& codes_);
+    ColumnLowCardinality(const ColumnLowCardinality&) = default;
+
+public:
+    using Base = COWHelper<IColumn, ColumnLowCardinality>;
+    using Codes = ColumnUInt32::Container;
+
+    /// The codes are a ColumnUInt32 of positions in the dictionary.
+    static Ptr create(const ColumnPtr& dictionary_, const ColumnPtr& codes_) {
+        return Base::create(dictionary_, codes_->assumeMutable());
+    }
+
+    template <typename Arg, typename = typename std::enable_if<IsMutableColumns<Arg>::value>::type>
+    static MutablePtr create(const ColumnPtr& dictionary_, Arg&& codes_) {
+        return Base::create(dictionary_, std::forward<Arg>(codes_));
+    }
+
+    /// A column whose dictionary is the rows of column, in the same order.
+    static MutablePtr createFromFullColumn(const ColumnPtr& column);
+
+    std::string getName() const override { return "LowCardinality(" + dictionary->getName() + ")"; }
+    const char* getFamilyName() const override { return "LowCardinality"; }
+
+    /// The values of the rows, a column of the type of the dictionary.
+    ColumnPtr convertToFullColumn() const { return dictionary->index(*codes, 0); }
+    ColumnPtr convertToFullColumnIfLowCardinality() const override {
+        return convertToFullColumn();
+    }
+
+    MutableColumnPtr cloneResized(size_t size) const override;
+
+    size_t size() const override { return codes->size(); }
+
+    Field operator[](size_t n) const override { return (*dictionary)[getCode(n)]; }
+    void get(size_t n, Field& res) const override { dictionary->get(getCode(n), res); }
+    StringRef getDataAt(size_t n) const override { return dictionary->getDataAt(getCode(n)); }
+    bool isNullAt(size_t n) const override { return dictionary->isNullAt(getCode(n)); }
+    bool isDefaultAt(size_t n) const override { return dictionary->isDefaultAt(getCode(n)); }
+
+    /// Only the rows of a column with the same dictionary can be inserted.
+    void insertFrom(const IColumn& src, size_t n) override;
+    void insertRangeFrom(const IColumn& src, size_t start, size_t length) override;
+
+    /// Values which are not in the dictionary can not be inserted.
+    void insert(const Field& x) override;
+    void insertData(const char* pos, size_t length) override;
+    void insertDefault() override;
+    const char* deserializeAndInsertFromArena(const char* pos) override;
+
+    void popBack(size_t n) override { codes->popBack(n); }
+
+    StringRef serializeValueIntoArena(size_t n, Arena& arena, char const*& begin) const override {
+        return dictionary->serializeValueIntoArena(getCode(n), arena, begin);
+    }
+
+    void updateHashWithValue(size_t n, SipHash& hash) const override {
+        dictionary->updateHashWithValue(getCode(n), hash);
+    }
+
+    ColumnPtr filter(const Filter& filt, ssize_t result_size_hint) const override {
+        return ColumnLowCardinality::create(dictionary, codes->filter(filt, result_size_hint));
+    }
+
+    ColumnPtr permute(const Permutation& perm, size_t limit) const override {
+        return ColumnLowCardinality::create(dictionary, codes->permute(perm, limit));
+    }
+
+    ColumnPtr index(const IColumn& indexes, size_t limit) const override {
+        return ColumnLowCardinality::create(dictionary, codes->index(indexes, limit));
+    }
+
+    ColumnPtr replicate(const Offsets& offsets) const override {
+        return ColumnLowCardinality::create(dictionary, codes->replicate(offsets));
+    }
+
+    /// The rows of the same code are equal without comparing their values.
+    int compareAt(size_t n, size_t m, const IColumn& rhs, int nan_direction_hint) const override;
+
+    /// Sorts the rows by the ranks of their codes in the sorted dictionary.
+    void getPermutation(bool reverse, size_t limit, int nan_direction_hint,
+                        Permutation& res) const override;
+
+    MutableColumns scatter(ColumnIndex num_columns, const Selector& selector) const override;
+
+    void getExtremes(Field& min, Field& max) const override {
+        convertToFullColumn()->getExtremes(min, max);
+    }
+
+    void reserve(size_t n) override { codes->reserve(n); }
+
+    size_t byteSize() const override { return codes->byteSize() + dictionary->byteSize(); }
+
+    size_t allocatedBytes() const override {
+        return codes->allocatedBytes() + dictionary->allocatedBytes();
+    }
+
+    void protect() override { codes->protect(); }
+
+    /// Only the codes, mutating the shared dictionary would copy it.
+    void forEachSubcolumn(ColumnCallback callback) override { callback(codes); }
+
+    bool structureEquals(const IColumn& rhs) const override {
+        if (auto rhs_low_cardinality = typeid_cast<const ColumnLowCardinality*>(&rhs))
+            return dictionary->structureEquals(*rhs_low_cardinality->dictionary);
+        return false;
+    }
+
+    bool lowCardinality() const override { return true; }
+
+    const IColumn& getDictionary() const { return *dictionary; }
+    const ColumnPtr& getDictionaryPtr() const { return dictionary; }
+
+    Codes& getCodes() { return assert_cast<ColumnUInt32&>(*codes).getData(); }
+    const Codes& getCodes() const { return assert_cast<const ColumnUInt32&>(*codes).getData(); }
+
+    UInt32 getCode(size_t n) const { return getCodes()[n]; }
+
+private:
+    WrappedPtr dictionary;
+    WrappedPtr codes;
+};
+
+} // namespace doris::vectorized
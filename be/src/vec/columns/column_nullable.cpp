@@ -180,12 +180,11 @@ ColumnPtr ColumnNullable::permute(const Permutation& perm, size_t limit) const {
     return ColumnNullable::create(permuted_data, permuted_null_map);
 }
 
-//ColumnPtr ColumnNullable::index(const IColumn & indexes, size_t limit) const
-//{
-//    ColumnPtr indexed_data = getNestedColumn().index(indexes, limit);
-//    ColumnPtr indexed_null_map = getNullMapColumn().index(indexes, limit);
-//    return ColumnNullable::create(indexed_data, indexed_null_map);
-//}
+ColumnPtr ColumnNullable::index(const IColumn& indexes, size_t limit) const {
+    ColumnPtr indexed_data = getNestedColumn().index(indexes, limit);
+    ColumnPtr indexed_null_map = getNullMapColumn().index(indexes, limit);
+    return ColumnNullable::create(indexed_data, indexed_null_map);
+}
 
 int ColumnNullable::compareAt(size_t n, size_t m, const IColumn& rhs_,
                               int null_direction_hint) const {
@@ -211,79 +210,46 @@ int ColumnNullable::compareAt(size_t n, size_t m, const IColumn& rhs_,
     return getNestedColumn().compareAt(n, m, nested_rhs, null_direction_hint);
 }
 
-//void ColumnNullable::getPermutation(bool reverse, size_t limit, int null_direction_hint, Permutation & res) const
-//{
-//    /// Cannot pass limit because of unknown amount of NULLs.
-//    getNestedColumn().getPermutation(reverse, 0, null_direction_hint, res);
-//
-//    if ((null_direction_hint > 0) != reverse)
-//    {
-//        /// Shift all NULL values to the end.
-//
-//        size_t read_idx = 0;
-//        size_t write_idx = 0;
-//        size_t end_idx = res.size();
-//
-//        if (!limit)
-//            limit = end_idx;
-//        else
-//            limit = std::min(end_idx, limit);
-//
-//        while (read_idx < limit && !isNullAt(res[read_idx]))
-//        {
-//            ++read_idx;
-//            ++write_idx;
-//        }
-//
-//        ++read_idx;
-//
-//        /// Invariants:
-//        ///  write_idx < read_idx
-//        ///  write_idx points to NULL
-//        ///  read_idx will be incremented to position of next not-NULL
-//        ///  there are range of NULLs between write_idx and read_idx - 1,
-//        /// We are moving elements from end to begin of this range,
-//        ///  so range will "bubble" towards the end.
-//        /// Relative order of NULL elements could be changed,
-//        ///  but relative order of non-NULLs is preserved.
-//
-//        while (read_idx < end_idx && write_idx < limit)
-//        {
-//            if (!isNullAt(res[read_idx]))
-//            {
-//                std::swap(res[read_idx], res[write_idx]);
-//                ++write_idx;
-//            }
-//            ++read_idx;
-//        }
-//    }
-//    else
-//    {
-//        /// Shift all NULL values to the beginning.
-//
-//        ssize_t read_idx = res.size() - 1;
-//        ssize_t write_idx = res.size() - 1;
-//
-//        while (read_idx >= 0 && !isNullAt(res[read_idx]))
-//        {
-//            --read_idx;
-//            --write_idx;
-//        }
-//
-//        --read_idx;
-//
-//        while (read_idx >= 0 && write_idx >= 0)
-//        {
-//            if (!isNullAt(res[read_idx]))
-//            {
-//                std::swap(res[read_idx], res[write_idx]);
-//                --write_idx;
-//            }
-//            --read_idx;
-//        }
-//    }
-//}
-//
+void ColumnNullable::getPermutation(bool reverse, size_t limit, int null_direction_hint,
+                                    Permutation& res) const {
+    const auto& null_map = getNullMapData();
+    size_t s = null_map.size();
+    size_t null_count = 0;
+    for (size_t i = 0; i < s; ++i) null_count += null_map[i] != 0;
+    if (null_count == 0) {
+        getNestedColumn().getPermutation(reverse, limit, null_direction_hint, res);
+        return;
+    }
+
+    /// The NULLs hold default values in the nested column and are mixed with the others
+    /// in its permutation. The first limit non-NULL rows are among the first
+    /// limit + null_count rows of it if the NULLs are at the end, and among the first
+    /// limit rows if they are at the beginning.
+    bool nulls_last = (null_direction_hint > 0) != reverse;
+    size_t nested_limit = limit;
+    if (limit && nulls_last) nested_limit = limit + null_count;
+    if (nested_limit >= s) nested_limit = 0;
+    Permutation nested_res;
+    getNestedColumn().getPermutation(reverse, nested_limit, null_direction_hint, nested_res);
+
+    /// Move the NULLs, the relative order of the non-NULLs is preserved.
+    res.resize(s);
+    size_t pos = 0;
+    if (!nulls_last) {
+        for (size_t i = 0; i < s; ++i) {
+            if (null_map[i]) res[pos++] = i;
+        }
+    }
+    for (size_t i = 0; i < s; ++i) {
+        if (!null_map[nested_res[i]]) res[pos++] = nested_res[i];
+    }
+    if (nulls_last) {
+        for (size_t i = 0; i < s; ++i) {
+            if (null_map[i]) res[pos++] = i;
+        }
+    }
+}
+
 //void ColumnNullable::gather(ColumnGathererStream & gatherer)
 //{
 //    gatherer.gather(*this);
@@ -188,7 +188,7 @@ public:
 
     ColumnPtr permute(const Permutation& perm, size_t limit) const override;
 
-    //    ColumnPtr index(const IColumn & indexes, size_t limit) const override;
+    ColumnPtr index(const IColumn& indexes, size_t limit) const override;
 
     template <typename Type>
     ColumnPtr indexImpl(const PaddedPODArray<Type>& indexes, size_t limit) const;
@@ -209,7 +209,8 @@ public:
     int compareAtWithCollation(size_t n, size_t m, const IColumn& rhs_,
                                const Collator& collator) const;
 
-    //    void getPermutation(bool reverse, size_t limit, int nan_direction_hint, Permutation & res) const override;
+    void getPermutation(bool reverse, size_t limit, int nan_direction_hint,
+                        Permutation& res) const override;
 
     /// Sorting with respect of collation.
     void getPermutationWithCollation(const Collator& collator, bool reverse, size_t limit,
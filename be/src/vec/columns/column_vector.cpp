@@ -20,6 +20,7 @@
 #include <cmath>
 #include <cstring>
 
+#include "vec/columns/columns_common.h"
 #include "vec/common/arena.h"
 #include "vec/common/exception.h"
 #include "vec/common/nan_utils.h"
@@ -86,118 +87,29 @@ struct ColumnVector<T>::greater {
     }
 };
 
-//namespace
-//{
-//    template <typename T>
-//    struct ValueWithIndex
-//    {
-//        T value;
-//        UInt32 index;
-//    };
-//
-//    template <typename T>
-//    struct RadixSortTraits : RadixSortNumTraits<T>
-//    {
-//        using Element = ValueWithIndex<T>;
-//        static T & extractKey(Element & elem) { return elem.value; }
-//    };
-//}
-
-//template <typename T>
-//void ColumnVector<T>::getPermutation(bool reverse, size_t limit, int nan_direction_hint, IColumn::Permutation & res) const
-//{
-//    size_t s = data.size();
-//    res.resize(s);
-//
-//    if (s == 0)
-//        return;
-//
-//    if (limit >= s)
-//        limit = 0;
-//
-//    if (limit)
-//    {
-//        for (size_t i = 0; i < s; ++i)
-//            res[i] = i;
-//
-//        if (reverse)
-//            std::partial_sort(res.begin(), res.begin() + limit, res.end(), greater(*this, nan_direction_hint));
-//        else
-//            std::partial_sort(res.begin(), res.begin() + limit, res.end(), less(*this, nan_direction_hint));
-//    }
-//    else
-//    {
-//        /// A case for radix sort
-//        if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, UInt128>)
-//        {
-//            /// Thresholds on size. Lower threshold is arbitrary. Upper threshold is chosen by the type for histogram counters.
-//            if (s >= 256 && s <= std::numeric_limits<UInt32>::max())
-//            {
-//                PaddedPODArray<ValueWithIndex<T>> pairs(s);
-//                for (UInt32 i = 0; i < s; ++i)
-//                    pairs[i] = {data[i], i};
-//
-//                RadixSort<RadixSortTraits<T>>::executeLSD(pairs.data(), s);
-//
-//                /// Radix sort treats all NaNs to be greater than all numbers.
-//                /// If the user needs the opposite, we must move them accordingly.
-//                size_t nans_to_move = 0;
-//                if (std::is_floating_point_v<T> && nan_direction_hint < 0)
-//                {
-//                    for (ssize_t i = s - 1; i >= 0; --i)
-//                    {
-//                        if (isNaN(pairs[i].value))
-//                            ++nans_to_move;
-//                        else
-//                            break;
-//                    }
-//                }
-//
-//                if (reverse)
-//                {
-//                    if (nans_to_move)
-//                    {
-//                        for (size_t i = 0; i < s - nans_to_move; ++i)
-//                            res[i] = pairs[s - nans_to_move - 1 - i].index;
-//                        for (size_t i = s - nans_to_move; i < s; ++i)
-//                            res[i] = pairs[s - 1 - (i - (s - nans_to_move))].index;
-//                    }
-//                    else
-//                    {
-//                        for (size_t i = 0; i < s; ++i)
-//                            res[s - 1 - i] = pairs[i].index;
-//                    }
-//                }
-//                else
-//                {
-//                    if (nans_to_move)
-//                    {
-//                        for (size_t i = 0; i < nans_to_move; ++i)
-//                            res[i] = pairs[i + s - nans_to_move].index;
-//                        for (size_t i = nans_to_move; i < s; ++i)
-//                            res[i] = pairs[i - nans_to_move].index;
-//                    }
-//                    else
-//                    {
-//                        for (size_t i = 0; i < s; ++i)
-//                            res[i] = pairs[i].index;
-//                    }
-//                }
-//
-//                return;
-//            }
-//        }
-//
-//        /// Default sorting algorithm.
-//        for (size_t i = 0; i < s; ++i)
-//            res[i] = i;
-//
-//        if (reverse)
-//            pdqsort(res.begin(), res.end(), greater(*this, nan_direction_hint));
-//        else
-//            pdqsort(res.begin(), res.end(), less(*this, nan_direction_hint));
-//    }
-//}
+template <typename T>
+void ColumnVector<T>::getPermutation(bool reverse, size_t limit, int nan_direction_hint,
+                                     IColumn::Permutation& res) const {
+    size_t s = data.size();
+    res.resize(s);
+    for (size_t i = 0; i < s; ++i) res[i] = i;
+
+    if (limit >= s) limit = 0;
+
+    if (limit) {
+        if (reverse)
+            std::partial_sort(res.begin(), res.begin() + limit, res.end(),
+                              greater(*this, nan_direction_hint));
+        else
+            std::partial_sort(res.begin(), res.begin() + limit, res.end(),
+                              less(*this, nan_direction_hint));
+    } else {
+        if (reverse)
+            std::sort(res.begin(), res.end(), greater(*this, nan_direction_hint));
+        else
+            std::sort(res.begin(), res.end(), less(*this, nan_direction_hint));
+    }
+}
 
 template <typename T>
 const char* ColumnVector<T>::getFamilyName() const {
@@ -325,11 +237,10 @@ ColumnPtr ColumnVector<T>::permute(const IColumn::Permutation& perm, size_t limi
     return res;
 }
 
-//template <typename T>
-//ColumnPtr ColumnVector<T>::index(const IColumn & indexes, size_t limit) const
-//{
-//    return selectIndexImpl(*this, indexes, limit);
-//}
+template <typename T>
+ColumnPtr ColumnVector<T>::index(const IColumn& indexes, size_t limit) const {
+    return selectIndexImpl(*this, indexes, limit);
+}
 
 template <typename T>
 ColumnPtr ColumnVector<T>::replicate(const IColumn::Offsets& offsets) const {
@@ -157,7 +157,8 @@ public:
                                          nan_direction_hint);
     }
 
-    //    void getPermutation(bool reverse, size_t limit, int nan_direction_hint, IColumn::Permutation & res) const override;
+    void getPermutation(bool reverse, size_t limit, int nan_direction_hint,
+                        IColumn::Permutation& res) const override;
 
     void reserve(size_t n) override { data.reserve(n); }
 
@@ -189,7 +190,7 @@ public:
 
     ColumnPtr permute(const IColumn::Permutation& perm, size_t limit) const override;
 
-    //    ColumnPtr index(const IColumn & indexes, size_t limit) const override;
+    ColumnPtr index(const IColumn& indexes, size_t limit) const override;
 
     template <typename Type>
     ColumnPtr indexImpl(const PaddedPODArray<Type>& indexes, size_t limit) const;
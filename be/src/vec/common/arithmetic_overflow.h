@@ -104,6 +104,8 @@ inline bool mulOverflow(__int128 x, __int128 y, __int128& res) {
 
     unsigned __int128 a = (x > 0) ? x : -x;
     unsigned __int128 b = (y > 0) ? y : -y;
-    return (a * b) / b != a;
+    /// The product may fit in unsigned __int128 but not in __int128.
+    unsigned __int128 max_abs = (static_cast<unsigned __int128>(1) << 127) - ((x > 0) == (y > 0));
+    return (a * b) / b != a || a * b > max_abs;
 }
 } // namespace common
@@ -5,11 +5,11 @@
 #include <vec/common/hash_table/hash_table.h>
 #include <vec/common/hash_table/hash_table_key_holder.h>
 // #include <vec/common/lRUCache.h>
+#include <vec/columns/column_low_cardinality.h>
 #include <vec/columns/column_string.h>
 #include <vec/common/assert_cast.h>
 #include <vec/common/unaligned.h>
 // #include <vec/columns/column_fixed_string.h>
-// #include <vec/columns/column_LowCardinality.h>
 
 #include <vec/core/defines.h>
 
@@ -128,299 +128,83 @@ protected:
 //     friend class columns_hashing_impl::HashMethodBase<Self, Value, Mapped, use_cache>;
 // };
 
-/// Cache stores dictionaries and saved_hash per dictionary key.
-// class LowCardinalityDictionaryCache : public HashMethodContext
-// {
-// public:
-//     /// Will assume that dictionaries with same hash has the same keys.
-//     /// Just in case, check that they have also the same size.
-//     struct DictionaryKey
-//     {
-//         UInt128 hash;
-//         UInt64 size;
-
-//         bool operator== (const DictionaryKey & other) const { return hash == other.hash && size == other.size; }
-//     };
-
-//     struct DictionaryKeyHash
-//     {
-//         size_t operator()(const DictionaryKey & key) const
-//         {
-//             SipHash hash;
-//             hash.update(key.hash.low);
-//             hash.update(key.hash.high);
-//             hash.update(key.size);
-//             return hash.get64();
-//         }
-//     };
-
-//     struct CachedValues
-//     {
-//         /// Store ptr to dictionary to be sure it won't be deleted.
-//         ColumnPtr dictionary_holder;
-//         /// Hashes for dictionary keys.
-//         const UInt64 * saved_hash = nullptr;
-//     };
-
-//     using CachedValuesPtr = std::shared_ptr<CachedValues>;
-
-//     explicit LowCardinalityDictionaryCache(const HashMethodContext::Settings & settings) : cache(settings.max_threads) {}
-
-//     CachedValuesPtr get(const DictionaryKey & key) { return cache.get(key); }
-//     void set(const DictionaryKey & key, const CachedValuesPtr & mapped) { cache.set(key, mapped); }
-
-// private:
-//     using Cache = LRUCache<DictionaryKey, CachedValues, DictionaryKeyHash>;
-//     Cache cache;
-// };
-
 /// Single low cardinality column.
-// template <typename SingleColumnMethod, typename Mapped, bool use_cache>
-// struct HashMethodSingleLowCardinalityColumn : public SingleColumnMethod
-// {
-//     using Base = SingleColumnMethod;
-
-//     enum class VisitValue
-//     {
-//         Empty = 0,
-//         Found = 1,
-//         NotFound = 2,
-//     };
-
-//     static constexpr bool has_mapped = !std::is_same<Mapped, void>::value;
-//     using EmplaceResult = columns_hashing_impl::EmplaceResultImpl<Mapped>;
-//     using FindResult = columns_hashing_impl::FindResultImpl<Mapped>;
-
-//     static HashMethodContextPtr createContext(const HashMethodContext::Settings & settings)
-//     {
-//         return std::make_shared<LowCardinalityDictionaryCache>(settings);
-//     }
-
-//     ColumnRawPtrs key_columns;
-//     const IColumn * positions = nullptr;
-//     size_t size_of_index_type = 0;
-
-//     /// saved hash is from current column or from cache.
-//     const UInt64 * saved_hash = nullptr;
-//     /// Hold dictionary in case saved_hash is from cache to be sure it won't be deleted.
-//     ColumnPtr dictionary_holder;
-
-//     /// Cache AggregateDataPtr for current column in order to decrease the number of hash table usages.
-//     columns_hashing_impl::MappedCache<Mapped> mapped_cache;
-//     PaddedPODArray<VisitValue> visit_cache;
-
-//     /// If initialized column is nullable.
-//     bool is_nullable = false;
-
-//     static const ColumnLowCardinality & getLowCardinalityColumn(const IColumn * low_cardinality_column)
-//     {
-//         auto column = typeid_cast<const ColumnLowCardinality *>(low_cardinality_column);
-//         if (!column)
-//             throw Exception("Invalid aggregation key type for HashMethodSingleLowCardinalityColumn method. "
-//                             "Excepted LowCardinality, got " + column->getName(), ErrorCodes::LOGICAL_ERROR);
-//         return *column;
-//     }
-
-//     HashMethodSingleLowCardinalityColumn(
-//         const ColumnRawPtrs & key_columns_low_cardinality, const Sizes & key_sizes, const HashMethodContextPtr & context)
-//         : Base({getLowCardinalityColumn(key_columns_low_cardinality[0]).getDictionary().getNestedNotNullableColumn().get()}, key_sizes, context)
-//     {
-//         auto column = &getLowCardinalityColumn(key_columns_low_cardinality[0]);
-
-//         if (!context)
-//             throw Exception("Cache wasn't created for HashMethodSingleLowCardinalityColumn",
-//                             ErrorCodes::LOGICAL_ERROR);
-
-//         LowCardinalityDictionaryCache * lcd_cache;
-//         if constexpr (use_cache)
-//         {
-//             lcd_cache = typeid_cast<LowCardinalityDictionaryCache *>(context.get());
-//             if (!lcd_cache)
-//             {
-//                 const auto & cached_val = *context;
-//                 throw Exception("Invalid type for HashMethodSingleLowCardinalityColumn cache: "
-//                                 + demangle(typeid(cached_val).name()), ErrorCodes::LOGICAL_ERROR);
-//             }
-//         }
-
-//         auto * dict = column->getDictionary().getNestedNotNullableColumn().get();
-//         is_nullable = column->getDictionary().nestedColumnIsNullable();
-//         key_columns = {dict};
-//         bool is_shared_dict = column->isSharedDictionary();
-
-//         typename LowCardinalityDictionaryCache::DictionaryKey dictionary_key;
-//         typename LowCardinalityDictionaryCache::CachedValuesPtr cached_values;
-
-//         if (is_shared_dict)
-//         {
-//             dictionary_key = {column->getDictionary().getHash(), dict->size()};
-//             if constexpr (use_cache)
-//                 cached_values = lcd_cache->get(dictionary_key);
-//         }
-
-//         if (cached_values)
-//         {
-//             saved_hash = cached_values->saved_hash;
-//             dictionary_holder = cached_values->dictionary_holder;
-//         }
-//         else
-//         {
-//             saved_hash = column->getDictionary().tryGetSavedHash();
-//             dictionary_holder = column->getDictionaryPtr();
-
-//             if constexpr (use_cache)
-//             {
-//                 if (is_shared_dict)
-//                 {
-//                     cached_values = std::make_shared<typename LowCardinalityDictionaryCache::CachedValues>();
-//                     cached_values->saved_hash = saved_hash;
-//                     cached_values->dictionary_holder = dictionary_holder;
-
-//                     lcd_cache->set(dictionary_key, cached_values);
-//                 }
-//             }
-//         }
-
-//         if constexpr (has_mapped)
-//             mapped_cache.resize(key_columns[0]->size());
-
-//         VisitValue empty(VisitValue::Empty);
-//         visit_cache.assign(key_columns[0]->size(), empty);
-
-//         size_of_index_type = column->getSizeOfIndexType();
-//         positions = column->getIndexesPtr().get();
-//     }
-
-//     ALWAYS_INLINE size_t getIndexAt(size_t row) const
-//     {
-//         switch (size_of_index_type)
-//         {
-//             case sizeof(UInt8): return assert_cast<const ColumnUInt8 *>(positions)->getElement(row);
-//             case sizeof(UInt16): return assert_cast<const ColumnUInt16 *>(positions)->getElement(row);
-//             case sizeof(UInt32): return assert_cast<const ColumnUInt32 *>(positions)->getElement(row);
-//             case sizeof(UInt64): return assert_cast<const ColumnUInt64 *>(positions)->getElement(row);
-//             default: throw Exception("Unexpected size of index type for low cardinality column.", ErrorCodes::LOGICAL_ERROR);
-//         }
-//     }
-
-//     /// Get the key holder from the key columns for insertion into the hash table.
-//     ALWAYS_INLINE auto getKeyHolder(size_t row, Arena & pool) const
-//     {
-//         return Base::getKeyHolder(getIndexAt(row), pool);
-//     }
-
-//     template <typename Data>
-//     ALWAYS_INLINE EmplaceResult emplaceKey(Data & data, size_t row_, Arena & pool)
-//     {
-//         size_t row = getIndexAt(row_);
-
-//         if (is_nullable && row == 0)
-//         {
-//             visit_cache[row] = VisitValue::Found;
-//             bool has_null_key = data.hasNullKeyData();
-//             data.hasNullKeyData() = true;
-
-//             if constexpr (has_mapped)
-//                 return EmplaceResult(data.getNullKeyData(), mapped_cache[0], !has_null_key);
-//             else
-//                 return EmplaceResult(!has_null_key);
-//         }
-
-//         if (visit_cache[row] == VisitValue::Found)
-//         {
-//             if constexpr (has_mapped)
-//                 return EmplaceResult(mapped_cache[row], mapped_cache[row], false);
-//             else
-//                 return EmplaceResult(false);
-//         }
-
-//         auto key_holder = getKeyHolder(row_, pool);
-
-//         bool inserted = false;
-//         typename Data::LookupResult it;
-//         if (saved_hash)
-//             data.emplace(key_holder, it, inserted, saved_hash[row]);
-//         else
-//             data.emplace(key_holder, it, inserted);
-
-//         visit_cache[row] = VisitValue::Found;
-
-//         if constexpr (has_mapped)
-//         {
-//             auto & mapped = *lookupResultGetMapped(it);
-//             if (inserted)
-//             {
-//                 new (&mapped) Mapped();
-//             }
-//             mapped_cache[row] = mapped;
-//             return EmplaceResult(mapped, mapped_cache[row], inserted);
-//         }
-//         else
-//             return EmplaceResult(inserted);
-//     }
-
-//     ALWAYS_INLINE bool isNullAt(size_t i)
-//     {
-//         if (!is_nullable)
-//             return false;
-
-//         return getIndexAt(i) == 0;
-//     }
+/// The keys are the values of the dictionary of the column, every position of the dictionary
+/// used by the rows is looked up in the hash table once by the method of the dictionary
+/// column, the other rows of the position get the mapped value from the cache.
+template <typename SingleColumnMethod, typename Mapped>
+struct HashMethodSingleLowCardinalityColumn : public SingleColumnMethod {
+    using Base = SingleColumnMethod;
+
+    enum class VisitValue {
+        Empty = 0,
+        Found = 1,
+    };
+
+    static constexpr bool has_mapped = !std::is_same<Mapped, void>::value;
+    using EmplaceResult = columns_hashing_impl::EmplaceResultImpl<Mapped>;
+
+    const UInt32* codes = nullptr;
+
+    /// The mapped values of the positions of the dictionary which are looked up already.
+    columns_hashing_impl::MappedCache<Mapped> mapped_cache;
+    PaddedPODArray<VisitValue> visit_cache;
+
+    static const ColumnLowCardinality& getLowCardinalityColumn(
+            const IColumn* low_cardinality_column) {
+        auto column = typeid_cast<const ColumnLowCardinality*>(low_cardinality_column);
+        if (!column)
+            throw Exception(
+                    "Invalid aggregation key type for HashMethodSingleLowCardinalityColumn "
+                    "method. Excepted LowCardinality, got " +
+                            low_cardinality_column->getName(),
+                    ErrorCodes::LOGICAL_ERROR);
+        return *column;
+    }
 
-//     template <typename Data>
-//     ALWAYS_INLINE FindResult findFromRow(Data & data, size_t row_, Arena & pool)
-//     {
-//         size_t row = getIndexAt(row_);
+    HashMethodSingleLowCardinalityColumn(const ColumnRawPtrs& key_columns_low_cardinality,
+                                         const Sizes& key_sizes,
+                                         const HashMethodContextPtr& context)
+            : Base({&getLowCardinalityColumn(key_columns_low_cardinality[0]).getDictionary()},
+                   key_sizes, context) {
+        const auto& column = getLowCardinalityColumn(key_columns_low_cardinality[0]);
+        codes = column.getCodes().data();
+
+        size_t dictionary_size = column.getDictionary().size();
+        if constexpr (has_mapped) mapped_cache.resize(dictionary_size);
+        visit_cache.assign(dictionary_size, VisitValue::Empty);
+    }
 
-//         if (is_nullable && row == 0)
-//         {
-//             if constexpr (has_mapped)
-//                 return FindResult(data.hasNullKeyData() ? &data.getNullKeyData() : nullptr, data.hasNullKeyData());
-//             else
-//                 return FindResult(data.hasNullKeyData());
-//         }
+    template <typename Data>
+    ALWAYS_INLINE EmplaceResult emplaceKey(Data& data, size_t row_, Arena& pool) {
+        size_t row = codes[row_];
 
-//         if (visit_cache[row] != VisitValue::Empty)
-//         {
-//             if constexpr (has_mapped)
-//                 return FindResult(&mapped_cache[row], visit_cache[row] == VisitValue::Found);
-//             else
-//                 return FindResult(visit_cache[row] == VisitValue::Found);
-//         }
+        if (visit_cache[row] == VisitValue::Found) {
+            if constexpr (has_mapped)
+                return EmplaceResult(mapped_cache[row], mapped_cache[row], false);
+            else
+                return EmplaceResult(false);
+        }
 
-//         auto key_holder = getKeyHolder(row_, pool);
+        auto key_holder = Base::getKeyHolder(row, pool);
 
-//         typename Data::iterator it;
-//         if (saved_hash)
-//             it = data.find(*key_holder, saved_hash[row]);
-//         else
-//             it = data.find(*key_holder);
+        bool inserted = false;
+        typename Data::LookupResult it;
+        data.emplace(key_holder, it, inserted);
 
-//         bool found = it != data.end();
-//         visit_cache[row] = found ? VisitValue::Found : VisitValue::NotFound;
+        visit_cache[row] = VisitValue::Found;
 
-//         if constexpr (has_mapped)
-//         {
-//             if (found)
-//                 mapped_cache[row] = it->second;
-//         }
-
-//         if constexpr (has_mapped)
-//             return FindResult(&mapped_cache[row], found);
-//         else
-//             return FindResult(found);
-//     }
-
-//     template <typename Data>
-//     ALWAYS_INLINE size_t getHash(const Data & data, size_t row, Arena & pool)
-//     {
-//         row = getIndexAt(row);
-//         if (saved_hash)
-//             return saved_hash[row];
-
-//         return Base::getHash(data, row, pool);
-//     }
-// };
+        if constexpr (has_mapped) {
+            auto& mapped = *lookupResultGetMapped(it);
+            if (inserted) {
+                new (&mapped) Mapped();
+            }
+            mapped_cache[row] = mapped;
+            return EmplaceResult(mapped, mapped_cache[row], inserted);
+        } else
+            return EmplaceResult(inserted);
+    }
+};
 
 // // Optional mask for low cardinality columns.
 // template <bool has_low_cardinality>
@@ -435,61 +219,35 @@ protected:
 // struct LowCardinalityKeys<false> {};
 
 /// For the case when all keys are of fixed length, and they fit in N (for example, 128) bits.
-// template <typename Value, typename Key, typename Mapped, bool has_nullable_keys_ = false, bool has_low_cardinality_ = false, bool use_cache = true>
-// struct HashMethodKeysFixed
-//     : private columns_hashing_impl::BaseStateKeysFixed<Key, has_nullable_keys_>
-//     , public columns_hashing_impl::HashMethodBase<HashMethodKeysFixed<Value, Key, Mapped, has_nullable_keys_, has_low_cardinality_, use_cache>, Value, Mapped, use_cache>
-// {
-//     using Self = HashMethodKeysFixed<Value, Key, Mapped, has_nullable_keys_, has_low_cardinality_, use_cache>;
-//     using BaseHashed = columns_hashing_impl::HashMethodBase<Self, Value, Mapped, use_cache>;
-//     using Base = columns_hashing_impl::BaseStateKeysFixed<Key, has_nullable_keys_>;
-
-//     static constexpr bool has_nullable_keys = has_nullable_keys_;
-//     static constexpr bool has_low_cardinality = has_low_cardinality_;
-
-//     LowCardinalityKeys<has_low_cardinality> low_cardinality_keys;
-//     Sizes key_sizes;
-//     size_t keys_size;
-
-//     HashMethodKeysFixed(const ColumnRawPtrs & key_columns, const Sizes & key_sizes_, const HashMethodContextPtr &)
-//         : Base(key_columns), key_sizes(std::move(key_sizes_)), keys_size(key_columns.size())
-//     {
-//         if constexpr (has_low_cardinality)
-//         {
-//             low_cardinality_keys.nested_columns.resize(key_columns.size());
-//             low_cardinality_keys.positions.assign(key_columns.size(), nullptr);
-//             low_cardinality_keys.position_sizes.resize(key_columns.size());
-//             for (size_t i = 0; i < key_columns.size(); ++i)
-//             {
-//                 if (auto * low_cardinality_col = typeid_cast<const ColumnLowCardinality *>(key_columns[i]))
-//                 {
-//                     low_cardinality_keys.nested_columns[i] = low_cardinality_col->getDictionary().getNestedColumn().get();
-//                     low_cardinality_keys.positions[i] = &low_cardinality_col->getIndexes();
-//                     low_cardinality_keys.position_sizes[i] = low_cardinality_col->getSizeOfIndexType();
-//                 }
-//                 else
-//                     low_cardinality_keys.nested_columns[i] = key_columns[i];
-//             }
-//         }
-//     }
+template <typename Value, typename Key, typename Mapped, bool has_nullable_keys_ = false,
+          bool use_cache = true>
+struct HashMethodKeysFixed
+        : private columns_hashing_impl::BaseStateKeysFixed<Key, has_nullable_keys_>,
+          public columns_hashing_impl::HashMethodBase<
+                  HashMethodKeysFixed<Value, Key, Mapped, has_nullable_keys_, use_cache>, Value,
+                  Mapped, use_cache> {
+    using Self = HashMethodKeysFixed<Value, Key, Mapped, has_nullable_keys_, use_cache>;
+    using BaseHashed = columns_hashing_impl::HashMethodBase<Self, Value, Mapped, use_cache>;
+    using Base = columns_hashing_impl::BaseStateKeysFixed<Key, has_nullable_keys_>;
+
+    static constexpr bool has_nullable_keys = has_nullable_keys_;
+
+    Sizes key_sizes;
+    size_t keys_size;
 
-//     ALWAYS_INLINE Key getKeyHolder(size_t row, Arena &) const
-//     {
-//         if constexpr (has_nullable_keys)
-//         {
-//             auto bitmap = Base::createBitmap(row);
-//             return packFixed<Key>(row, keys_size, Base::getActualColumns(), key_sizes, bitmap);
-//         }
-//         else
-//         {
-//             if constexpr (has_low_cardinality)
-//                 return packFixed<Key, true>(row, keys_size, low_cardinality_keys.nested_columns, key_sizes,
-//                                             &low_cardinality_keys.positions, &low_cardinality_keys.position_sizes);
+    HashMethodKeysFixed(const ColumnRawPtrs& key_columns, const Sizes& key_sizes_,
+                        const HashMethodContextPtr&)
+            : Base(key_columns), key_sizes(key_sizes_), keys_size(key_columns.size()) {}
 
-//             return packFixed<Key>(row, keys_size, Base::getActualColumns(), key_sizes);
-//         }
-//     }
-// };
+    ALWAYS_INLINE Key getKeyHolder(size_t row, Arena&) const {
+        if constexpr (has_nullable_keys) {
+            auto bitmap = Base::createBitmap(row);
+            return packFixed<Key>(row, keys_size, Base::getActualColumns(), key_sizes, bitmap);
+        } else {
+            return packFixed<Key>(row, keys_size, Base::getActualColumns(), key_sizes);
+        }
+    }
+};
 
 /** Hash by concatenating serialized key values.
   * The serialized value differs in that it uniquely allows to deserialize it, having only the position with which it starts.
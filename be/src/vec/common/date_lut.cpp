@@ -0,0 +1,39 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+
+#include "vec/common/date_lut.h"
+
+/// The DATE and DATETIME values of Doris have no time zone, so the default lookup table is the
+/// one of UTC, which has no daylight saving time changes.
+DateLUT::DateLUT() {
+    default_impl.store(&getImplementation("UTC"), std::memory_order_release);
+}
+
+const DateLUTImpl& DateLUT::getImplementation(const std::string& time_zone) const {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = impls.emplace(time_zone, nullptr).first;
+    if (!it->second) it->second = std::make_unique<DateLUTImpl>(time_zone);
+
+    return *it->second;
+}
+
+DateLUT& DateLUT::getInstance() {
+    static DateLUT ret;
+    return ret;
+}
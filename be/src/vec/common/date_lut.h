@@ -23,7 +23,7 @@
 #include <mutex>
 #include <unordered_map>
 
-#include "DateLUTImpl.h"
+#include "vec/common/date_lut_impl.h"
 
 // Also defined in Core/Defines.h
 #if !defined(ALWAYS_INLINE)
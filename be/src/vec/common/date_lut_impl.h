@@ -20,9 +20,9 @@
 #include <ctime>
 #include <string>
 
-#include "DayNum.h"
-#include "Types.h"
 #include "common/compiler_util.h"
+#include "vec/common/day_num.h"
+#include "vec/common/types.h"
 
 #define DATE_LUT_MAX (0xFFFFFFFFU - 86400)
 #define DATE_LUT_MAX_DAY_NUM (0xFFFFFFFFU / 86400)
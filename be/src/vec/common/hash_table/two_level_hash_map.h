@@ -0,0 +1,57 @@
+#pragma once
+
+#include <vec/common/hash_table/hash_map.h>
+#include <vec/common/hash_table/two_level_hash_table.h>
+
+template <typename Key, typename Cell, typename Hash = DefaultHash<Key>,
+          typename Grower = TwoLevelHashTableGrower<>, typename Allocator = HashTableAllocator,
+          template <typename...> typename ImplTable = HashMapTable>
+class TwoLevelHashMapTable
+        : public TwoLevelHashTable<Key, Cell, Hash, Grower, Allocator,
+                                   ImplTable<Key, Cell, Hash, Grower, Allocator>> {
+public:
+    using Impl = ImplTable<Key, Cell, Hash, Grower, Allocator>;
+    using LookupResult = typename Impl::LookupResult;
+
+    using TwoLevelHashTable<Key, Cell, Hash, Grower, Allocator,
+                            ImplTable<Key, Cell, Hash, Grower, Allocator>>::TwoLevelHashTable;
+
+    using key_type = Key;
+    using mapped_type = typename Cell::Mapped;
+    using value_type = typename Cell::value_type;
+
+    /// Call func(const Key &, Mapped &) for each hash map element.
+    template <typename Func>
+    void ALWAYS_INLINE forEachValue(Func&& func) {
+        for (auto i = 0u; i < this->NUM_BUCKETS; ++i) this->impls[i].forEachValue(func);
+    }
+
+    /// Call func(Mapped &) for each hash map element.
+    template <typename Func>
+    void ALWAYS_INLINE forEachMapped(Func&& func) {
+        for (auto i = 0u; i < this->NUM_BUCKETS; ++i) this->impls[i].forEachMapped(func);
+    }
+
+    mapped_type& ALWAYS_INLINE operator[](const Key& x) {
+        LookupResult it;
+        bool inserted;
+        this->emplace(x, it, inserted);
+
+        if (inserted) new (lookupResultGetMapped(it)) mapped_type();
+
+        return *lookupResultGetMapped(it);
+    }
+};
+
+template <typename Key, typename Mapped, typename Hash = DefaultHash<Key>,
+          typename Grower = TwoLevelHashTableGrower<>, typename Allocator = HashTableAllocator,
+          template <typename...> typename ImplTable = HashMapTable>
+using TwoLevelHashMap = TwoLevelHashMapTable<Key, HashMapCell<Key, Mapped, Hash>, Hash, Grower,
+                                             Allocator, ImplTable>;
+
+template <typename Key, typename Mapped, typename Hash = DefaultHash<Key>,
+          typename Grower = TwoLevelHashTableGrower<>, typename Allocator = HashTableAllocator,
+          template <typename...> typename ImplTable = HashMapTable>
+using TwoLevelHashMapWithSavedHash =
+        TwoLevelHashMapTable<Key, HashMapCellWithSavedHash<Key, Mapped, Hash>, Hash, Grower,
+                             Allocator, ImplTable>;
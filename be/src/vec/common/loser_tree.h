@@ -0,0 +1,113 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace doris::vectorized {
+
+/** Tournament tree of losers to merge k sorted streams.
+  * Replacing the winner only needs one comparison per level of the tree, log(k) in total,
+  *  while a binary heap needs two per level.
+  *
+  * Cursor must provide `bool greater(const Cursor& rhs) const`, which is true if the current
+  *  row of the cursor goes after the current row of rhs. Cursors never compare equal.
+  *
+  * The winner is returned by top(). After consuming its current row, the caller either moves
+  *  the cursor to the next row and calls updateTop(), or calls removeTop() if the cursor
+  *  is exhausted.
+  */
+template <typename Cursor>
+class LoserTree {
+public:
+    LoserTree() = default;
+
+    explicit LoserTree(std::vector<Cursor> cursors_) { init(std::move(cursors_)); }
+
+    void init(std::vector<Cursor> cursors_) {
+        cursors = std::move(cursors_);
+        k = cursors.size();
+        active = k;
+        exhausted.assign(k, false);
+        /// Node 0 holds the winner, nodes 1..k-1 hold the losers of the matches
+        ///  and the leaf i is the virtual node k + i.
+        tree.assign(std::max<size_t>(k, 1), MIN_SENTINEL);
+        for (size_t i = k; i > 0; --i) adjust(i - 1);
+    }
+
+    bool empty() const { return active == 0; }
+    size_t size() const { return active; }
+
+    Cursor& top() { return cursors[tree[0]]; }
+
+    /// The cursor which would be the winner without top(), nullptr if top() is the only one.
+    /// It can only have lost against the winner, so it is the best of the losers on the path
+    ///  of the winner: finding it takes log(k) comparisons and does not change the tree.
+    Cursor* secondTop() {
+        size_t second = MIN_SENTINEL;
+        for (size_t node = (tree[0] + k) / 2; node > 0; node /= 2) {
+            size_t loser = tree[node];
+            if (exhausted[loser]) continue;
+            if (second == MIN_SENTINEL || beats(loser, second)) second = loser;
+        }
+        return second == MIN_SENTINEL ? nullptr : &cursors[second];
+    }
+
+    /// The cursor of top() has moved to its next row.
+    void updateTop() { adjust(tree[0]); }
+
+    /// The cursor of top() has no more rows.
+    void removeTop() {
+        exhausted[tree[0]] = true;
+        --active;
+        adjust(tree[0]);
+    }
+
+private:
+    /// A virtual leaf winning all the matches, used to build the tree.
+    static constexpr size_t MIN_SENTINEL = static_cast<size_t>(-1);
+
+    /// The leaf a wins the match against the leaf b.
+    bool beats(size_t a, size_t b) const {
+        if (a == MIN_SENTINEL) return true;
+        if (b == MIN_SENTINEL) return false;
+        if (exhausted[a]) return false;
+        if (exhausted[b]) return true;
+        return !cursors[a].greater(cursors[b]);
+    }
+
+    /// Replay the matches from the leaf to the root.
+    void adjust(size_t leaf) {
+        size_t winner = leaf;
+        for (size_t node = (leaf + k) / 2; node > 0; node /= 2) {
+            if (beats(tree[node], winner)) std::swap(winner, tree[node]);
+        }
+        tree[0] = winner;
+    }
+
+    std::vector<Cursor> cursors;
+    std::vector<bool> exhausted;
+    std::vector<size_t> tree;
+    size_t k = 0;
+    size_t active = 0;
+};
+
+} // namespace doris::vectorized
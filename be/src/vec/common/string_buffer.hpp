@@ -18,8 +18,11 @@
 #pragma once
 #include <fmt/format.h>
 
+#include <cassert>
 #include <cstring>
 
+#include "vec/common/string_ref.h"
+
 namespace doris::vectorized {
 class BufferWritable {
 public:
@@ -33,6 +36,12 @@ public:
         write(buffer.data(), buffer.size());
     }
 
+    // write the raw bytes of a trivially copyable value, read back by BufferReadable::read_binary
+    template <typename T>
+    void write_binary(const T& data) {
+        write(reinterpret_cast<const char*>(&data), sizeof(data));
+    }
+
     int count() const { return _writer_counter; }
 
 protected:
@@ -55,4 +64,26 @@ public:
 private:
     T& _vector;
 };
+
+class BufferReadable {
+public:
+    explicit BufferReadable(const StringRef& ref) : _data(ref.data), _end(ref.data + ref.size) {}
+
+    void read(char* data, int len) {
+        assert(_data + len <= _end);
+        memcpy(data, _data, len);
+        _data += len;
+    }
+
+    template <typename T>
+    void read_binary(T& data) {
+        read(reinterpret_cast<char*>(&data), sizeof(data));
+    }
+
+    bool eof() const { return _data >= _end; }
+
+private:
+    const char* _data;
+    const char* _end;
+};
 } // namespace doris::vectorized
@@ -0,0 +1,61 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace doris::vectorized::UTF8 {
+
+/// The length in bytes of the UTF-8 sequence starting with byte, the same as the row engine.
+inline size_t seqLength(uint8_t byte) {
+    if (byte >= 0xFC) return 6;
+    if (byte >= 0xF8) return 5;
+    if (byte >= 0xF0) return 4;
+    if (byte >= 0xE0) return 3;
+    if (byte >= 0xC0) return 2;
+    return 1;
+}
+
+/// The number of code points of a valid UTF-8 string, i.e. the bytes which are not
+/// continuation bytes (10xxxxxx).
+inline size_t countCodePoints(const uint8_t* data, size_t size) {
+    size_t res = 0;
+    const uint8_t* end = data + size;
+
+#if defined(__SSE2__)
+    constexpr size_t bytes_sse = sizeof(__m128i);
+    const uint8_t* end_sse = data + size / bytes_sse * bytes_sse;
+    /// The continuation bytes are the signed bytes <= (int8_t)0xBF.
+    const __m128i threshold = _mm_set1_epi8(0xBF);
+    for (; data < end_sse; data += bytes_sse) {
+        res += __builtin_popcount(_mm_movemask_epi8(_mm_cmpgt_epi8(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(data)), threshold)));
+    }
+#endif
+
+    for (; data < end; ++data) {
+        res += static_cast<int8_t>(*data) > static_cast<int8_t>(0xBF);
+    }
+    return res;
+}
+
+} // namespace doris::vectorized::UTF8
@@ -26,11 +26,16 @@
 #include <iterator>
 #include <memory>
 
+#include "common/config.h"
+#include "gen_cpp/data.pb.h"
+#include "util/block_compression.h"
 #include "vec/columns/column_vector.h"
 #include "vec/columns/column_const.h"
+#include "vec/columns/column_nullable.h"
 #include "vec/columns/columns_common.h"
 #include "vec/common/assert_cast.h"
 #include "vec/common/typeid_cast.h"
+#include "vec/data_types/data_type_nullable.h"
 
 namespace doris::vectorized {
 
@@ -532,23 +537,122 @@ void Block::updateHash(SipHash& hash) const {
 }
 
 void Block::filter_block(Block* block, int filter_column_id, int column_to_keep) {
-    ColumnPtr filter_column = block->getByPosition(filter_column_id).column;
+    // a conjunct of constants is folded to a ColumnConst
+    ColumnPtr filter_column =
+            block->getByPosition(filter_column_id).column->convertToFullColumnIfConst();
     const IColumn::Filter& filter =
             assert_cast<const doris::vectorized::ColumnVector<UInt8>&>(*filter_column).getData();
+    filter_block(block, filter, column_to_keep);
+}
 
+void Block::filter_block(Block* block, const IColumn::Filter& filter, int column_to_keep) {
+    while (block->columns() > static_cast<size_t>(column_to_keep)) {
+        block->erase(block->columns() - 1);
+    }
     auto count = countBytesInFilter(filter);
-    if (count == 0) {
-        block->getByPosition(0).column = block->getByPosition(0).column->cloneEmpty();
-    } else {
-        if (count != block->rows()) {
-            for (int i = 0; i < column_to_keep; ++i) {
-                block->getByPosition(i).column = block->getByPosition(i).column->filter(filter, 0);
+    if (count == block->rows()) {
+        return;
+    }
+    for (int i = 0; i < column_to_keep; ++i) {
+        auto& column = block->getByPosition(i).column;
+        column = column->filter(filter, count);
+    }
+}
+
+Status Block::serialize(PBlock* pblock, size_t* uncompressed_bytes,
+                        size_t* compressed_bytes) const {
+    pblock->Clear();
+    pblock->set_num_rows(rows());
+    *uncompressed_bytes = 0;
+    *compressed_bytes = 0;
+
+    const BlockCompressionCodec* codec = nullptr;
+    if (config::compress_rowbatches) {
+        RETURN_IF_ERROR(get_block_compression_codec(segment_v2::CompressionTypePB::LZ4, &codec));
+    }
+
+    std::string buf;
+    for (const auto& elem : data) {
+        ColumnPtr column = elem.column->convertToFullColumnIfConst();
+        PColumn* pcolumn = pblock->add_columns();
+        pcolumn->set_is_nullable(elem.type->isNullable());
+
+        size_t size = elem.type->getUncompressedSerializedBytes(*column);
+        std::string* column_data = pcolumn->mutable_data();
+        if (codec == nullptr) {
+            column_data->resize(size);
+            elem.type->serialize(*column, column_data->data());
+        } else {
+            buf.resize(size);
+            elem.type->serialize(*column, buf.data());
+            size_t max_compressed_len = codec->max_compressed_len(size);
+            column_data->resize(max_compressed_len);
+            Slice compressed(column_data->data(), max_compressed_len);
+            RETURN_IF_ERROR(codec->compress(Slice(buf.data(), size), &compressed));
+            if (compressed.size < size) {
+                column_data->resize(compressed.size);
+                pcolumn->set_uncompressed_size(size);
+            } else {
+                // not worth decompressing on the receiver
+                column_data->swap(buf);
             }
         }
-        for (size_t i = column_to_keep; i < block->columns(); ++i) {
-            block->erase(i);
+        *uncompressed_bytes += size;
+        *compressed_bytes += column_data->size();
+    }
+    return Status::OK();
+}
+
+Status Block::deserialize(const PBlock& pblock) {
+    if (static_cast<size_t>(pblock.columns_size()) != columns()) {
+        return Status::InternalError("the number of the columns received " +
+                                     std::to_string(pblock.columns_size()) + " is not " +
+                                     std::to_string(columns()));
+    }
+
+    const BlockCompressionCodec* codec = nullptr;
+    std::string buf;
+    for (size_t i = 0; i < columns(); ++i) {
+        const PColumn& pcolumn = pblock.columns(i);
+        const char* column_data = pcolumn.data().data();
+        const char* column_end = column_data + pcolumn.data().size();
+        if (pcolumn.has_uncompressed_size()) {
+            if (codec == nullptr) {
+                RETURN_IF_ERROR(
+                        get_block_compression_codec(segment_v2::CompressionTypePB::LZ4, &codec));
+            }
+            buf.resize(pcolumn.uncompressed_size());
+            Slice uncompressed(buf.data(), buf.size());
+            RETURN_IF_ERROR(codec->decompress(Slice(pcolumn.data()), &uncompressed));
+            column_data = buf.data();
+            column_end = column_data + uncompressed.size;
+        }
+
+        // The sender may know that the values of a nullable slot have no null, the
+        // columns stay nullable to keep the types of the slots.
+        auto& elem = data[i];
+        DataTypePtr type = pcolumn.is_nullable() ? makeNullable(elem.type)
+                                                 : removeNullable(elem.type);
+        MutableColumnPtr column = type->createColumn();
+        // the lengths in the data come from the network, they are checked against the buffer
+        if (type->deserialize(column_data, column_end, column.get()) != column_end) {
+            return Status::Corruption("the data of the column " + elem.name + " received of " +
+                                      std::to_string(column_end - column_data) +
+                                      " bytes is corrupted");
+        }
+        if (elem.type->isNullable() && !type->isNullable()) {
+            elem.column = makeNullable(std::move(column));
+        } else {
+            elem.type = type;
+            elem.column = std::move(column);
+        }
+        if (elem.column->size() != static_cast<size_t>(pblock.num_rows())) {
+            return Status::InternalError("the number of the rows of the column " + elem.name +
+                                         " received is " + std::to_string(elem.column->size()) +
+                                         " instead of " + std::to_string(pblock.num_rows()));
         }
     }
+    return Status::OK();
 }
 
 } // namespace doris::vectorized
@@ -23,11 +23,16 @@
 #include <set>
 #include <vector>
 
+#include "common/status.h"
 #include "vec/core/block_info.h"
 #include "vec/core/column_with_type_and_name.h"
 #include "vec/core/columns_with_type_and_name.h"
 #include "vec/core/names_and_types.h"
 
+namespace doris {
+class PBlock;
+}
+
 namespace doris::vectorized {
 
 /** Container for set of columns for bunch of rows in memory.
@@ -155,6 +160,21 @@ public:
 
     static void filter_block(Block* block, int filter_conlumn_id, int column_to_keep);
 
+    /** Keep the rows selected by filter in the columns before column_to_keep, erase the others.
+      * The columns are copied once, whatever the number of conjuncts the filter is made of.
+      */
+    static void filter_block(Block* block, const IColumn::Filter& filter, int column_to_keep);
+
+    /** Serialize the columns into pblock to send them to another backend, each column is
+      *  compressed with LZ4 if config::compress_rowbatches is set.
+      */
+    Status serialize(PBlock* pblock, size_t* uncompressed_bytes, size_t* compressed_bytes) const;
+
+    /** Replace the columns of the block by the ones of pblock. The block must have the
+      *  columns of the sender, the types give how to read the columns back.
+      */
+    Status deserialize(const PBlock& pblock);
+
 private:
     void eraseImpl(size_t position);
     void initializeIndexByName();
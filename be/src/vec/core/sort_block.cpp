@@ -0,0 +1,110 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/core/sort_block.h"
+
+#include <algorithm>
+
+#include "vec/common/pod_array.h"
+
+namespace doris::vectorized {
+
+using ColumnWithSortDescription = std::pair<const IColumn*, SortColumnDescription>;
+using ColumnsWithSortDescriptions = std::vector<ColumnWithSortDescription>;
+
+static ColumnsWithSortDescriptions getColumnsWithSortDescription(
+        const Block& block, const SortDescription& description) {
+    size_t size = description.size();
+    ColumnsWithSortDescriptions res;
+    res.reserve(size);
+
+    for (size_t i = 0; i < size; ++i) {
+        const IColumn* column = block.getByPosition(description[i].column_number).column.get();
+        res.emplace_back(column, description[i]);
+    }
+
+    return res;
+}
+
+struct PartialSortingLess {
+    const ColumnsWithSortDescriptions& columns;
+
+    explicit PartialSortingLess(const ColumnsWithSortDescriptions& columns_)
+            : columns(columns_) {}
+
+    bool operator()(size_t a, size_t b) const {
+        for (const auto& elem : columns) {
+            int res = elem.second.direction *
+                      elem.first->compareAt(a, b, *elem.first, elem.second.nulls_direction);
+            if (res < 0)
+                return true;
+            else if (res > 0)
+                return false;
+        }
+        return false;
+    }
+};
+
+void sortBlock(Block& block, const SortDescription& description, UInt64 limit) {
+    if (!block) return;
+
+    size_t size = block.rows();
+    if (limit >= size) limit = 0;
+
+    IColumn::Permutation perm;
+    if (description.size() == 1) {
+        /// Fast path when only one column is sorted.
+        bool reverse = description[0].direction == -1;
+        const IColumn* column = block.getByPosition(description[0].column_number).column.get();
+        column->getPermutation(reverse, limit, description[0].nulls_direction, perm);
+    } else {
+        perm.resize(size);
+        for (size_t i = 0; i < size; ++i) perm[i] = i;
+
+        ColumnsWithSortDescriptions columns_with_sort_desc =
+                getColumnsWithSortDescription(block, description);
+        PartialSortingLess less(columns_with_sort_desc);
+
+        if (limit)
+            std::partial_sort(perm.begin(), perm.begin() + limit, perm.end(), less);
+        else
+            std::sort(perm.begin(), perm.end(), less);
+    }
+
+    size_t columns = block.columns();
+    for (size_t i = 0; i < columns; ++i) {
+        auto& column = block.getByPosition(i).column;
+        column = column->permute(perm, limit);
+    }
+}
+
+void stableGetPermutation(const Block& block, const SortDescription& description,
+                          IColumn::Permutation& out_permutation) {
+    if (!block) return;
+
+    size_t size = block.rows();
+    out_permutation.resize(size);
+    for (size_t i = 0; i < size; ++i) out_permutation[i] = i;
+
+    ColumnsWithSortDescriptions columns_with_sort_desc =
+            getColumnsWithSortDescription(block, description);
+
+    std::stable_sort(out_permutation.begin(), out_permutation.end(),
+                     PartialSortingLess(columns_with_sort_desc));
+}
+
+} // namespace doris::vectorized
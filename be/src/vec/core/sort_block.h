@@ -0,0 +1,34 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include "vec/core/block.h"
+#include "vec/core/sort_description.h"
+
+namespace doris::vectorized {
+
+/// Sort one block by `description`. If limit != 0, then the partial sort of the first `limit` rows
+/// is performed and only these rows are kept in the block.
+void sortBlock(Block& block, const SortDescription& description, UInt64 limit = 0);
+
+/// Do not sort the block, but only calculate the permutation of the values, so that you can
+/// rearrange the column values yourself. The sort is stable, the equal rows keep their order.
+void stableGetPermutation(const Block& block, const SortDescription& description,
+                          IColumn::Permutation& out_permutation);
+
+} // namespace doris::vectorized
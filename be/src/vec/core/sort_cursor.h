@@ -0,0 +1,101 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include "vec/core/block.h"
+#include "vec/core/sort_description.h"
+
+namespace doris::vectorized {
+
+/** Cursor allows to compare rows in different blocks (and parts).
+  * Cursor moves inside single block.
+  * It is used in priority queue or loser tree to merge several sorted blocks.
+  */
+struct SortCursorImpl {
+    ColumnRawPtrs all_columns;
+    ColumnRawPtrs sort_columns;
+    SortDescription desc;
+    size_t sort_columns_size = 0;
+    size_t pos = 0;
+    size_t rows = 0;
+
+    /** Determines order if comparing columns are equal.
+      * Order is determined by number of cursor.
+      */
+    size_t order = 0;
+
+    SortCursorImpl() {}
+
+    SortCursorImpl(const Block& block, const SortDescription& desc_, size_t order_ = 0)
+            : desc(desc_), sort_columns_size(desc.size()), order(order_) {
+        reset(block);
+    }
+
+    bool empty() const { return rows == 0; }
+
+    /// Set the cursor to the beginning of the new block.
+    void reset(const Block& block) {
+        all_columns.clear();
+        sort_columns.clear();
+
+        size_t num_columns = block.columns();
+        for (size_t j = 0; j < num_columns; ++j) {
+            all_columns.push_back(block.getByPosition(j).column.get());
+        }
+        for (size_t j = 0, size = desc.size(); j < size; ++j) {
+            sort_columns.push_back(block.getByPosition(desc[j].column_number).column.get());
+        }
+
+        pos = 0;
+        rows = block.rows();
+    }
+
+    bool isFirst() const { return pos == 0; }
+    bool isLast() const { return pos + 1 >= rows; }
+    void next() { ++pos; }
+};
+
+/// A wrapper of SortCursorImpl comparing the current rows of two cursors.
+struct SortCursor {
+    SortCursorImpl* impl;
+
+    SortCursor(SortCursorImpl* impl_) : impl(impl_) {}
+    SortCursorImpl* operator->() { return impl; }
+    const SortCursorImpl* operator->() const { return impl; }
+
+    /// The specified row of this cursor is greater than the specified row of another cursor.
+    bool greaterAt(const SortCursor& rhs, size_t lhs_pos, size_t rhs_pos) const {
+        for (size_t i = 0; i < impl->sort_columns_size; ++i) {
+            int direction = impl->desc[i].direction;
+            int nulls_direction = impl->desc[i].nulls_direction;
+            int res = direction * impl->sort_columns[i]->compareAt(lhs_pos, rhs_pos,
+                                                                   *(rhs.impl->sort_columns[i]),
+                                                                   nulls_direction);
+            if (res > 0) return true;
+            if (res < 0) return false;
+        }
+        return impl->order > rhs.impl->order;
+    }
+
+    bool greater(const SortCursor& rhs) const { return greaterAt(rhs, impl->pos, rhs.impl->pos); }
+
+    /// Inverted so that the priority queue elements are removed in ascending order.
+    bool operator<(const SortCursor& rhs) const { return greater(rhs); }
+};
+
+} // namespace doris::vectorized
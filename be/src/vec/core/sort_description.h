@@ -0,0 +1,49 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace doris::vectorized {
+
+/// Description of the sorting rule by one column.
+struct SortColumnDescription {
+    size_t column_number; /// Position of the column in the block.
+    int direction;        /// 1 - ascending, -1 - descending.
+    int nulls_direction;  /// 1 - NULLs and NaNs are greater, -1 - less.
+                          /// To achieve NULLS LAST, set it equal to direction,
+                          /// to achieve NULLS FIRST, set it opposite.
+
+    SortColumnDescription(size_t column_number_, int direction_, int nulls_direction_)
+            : column_number(column_number_),
+              direction(direction_),
+              nulls_direction(nulls_direction_) {}
+
+    bool operator==(const SortColumnDescription& other) const {
+        return column_number == other.column_number && direction == other.direction &&
+               nulls_direction == other.nulls_direction;
+    }
+
+    bool operator!=(const SortColumnDescription& other) const { return !(*this == other); }
+};
+
+/// Description of the sorting rule for several columns.
+using SortDescription = std::vector<SortColumnDescription>;
+
+} // namespace doris::vectorized
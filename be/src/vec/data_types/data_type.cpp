@@ -18,6 +18,7 @@
 #include "vec/columns/column.h"
 #include "vec/columns/column_const.h"
 #include "vec/common/exception.h"
+#include "vec/common/unaligned.h"
 // #include <vec/Common/escapeForFileName.h>
 
 #include "vec/core/defines.h"
@@ -132,6 +133,34 @@ void IDataType::to_string(const IColumn& column, size_t row_num, BufferWritable&
                     ErrorCodes::NOT_IMPLEMENTED);
 }
 
+size_t IDataType::getUncompressedSerializedBytes(const IColumn& column) const {
+    throw Exception("Data type " + getName() + " serialization not implemented.",
+                    ErrorCodes::NOT_IMPLEMENTED);
+}
+
+char* IDataType::serialize(const IColumn& column, char* buf) const {
+    throw Exception("Data type " + getName() + " serialization not implemented.",
+                    ErrorCodes::NOT_IMPLEMENTED);
+}
+
+const char* IDataType::deserialize(const char* buf, const char* end, IColumn* column) const {
+    throw Exception("Data type " + getName() + " deserialization not implemented.",
+                    ErrorCodes::NOT_IMPLEMENTED);
+}
+
+const char* IDataType::deserializeRows(const char* buf, const char* end, size_t value_size,
+                                       UInt64* rows) {
+    if (static_cast<size_t>(end - buf) < sizeof(UInt64)) {
+        return nullptr;
+    }
+    *rows = unalignedLoad<UInt64>(buf);
+    buf += sizeof(UInt64);
+    if (value_size != 0 && *rows > static_cast<size_t>(end - buf) / value_size) {
+        return nullptr;
+    }
+    return buf;
+}
+
 void IDataType::insertDefaultInto(IColumn& column) const {
     column.insertDefault();
 }
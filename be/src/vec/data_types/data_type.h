@@ -217,6 +217,25 @@ public:
     // virtual void serializeBinaryBulk(const IColumn & column, WriteBuffer & ostr, size_t offset, size_t limit) const;
     // virtual void deserializeBinaryBulk(IColumn & column, ReadBuffer & istr, size_t limit, double avg_value_size_hint) const;
 
+    /** Serialization of all the values of a column into one contiguous buffer, used to send
+      *  Blocks to other backends. The buffer passed to serialize() must hold
+      *  getUncompressedSerializedBytes() bytes. deserialize() appends the values of the buffer
+      *  [buf, end), which comes from the network, to the column.
+      * Both return the position after the bytes they have processed, deserialize() returns
+      *  nullptr if the values do not fit in the buffer or are inconsistent.
+      */
+    virtual size_t getUncompressedSerializedBytes(const IColumn& column) const;
+    virtual char* serialize(const IColumn& column, char* buf) const;
+    virtual const char* deserialize(const char* buf, const char* end, IColumn* column) const;
+
+protected:
+    /// Read the number of the values of a serialized column, which are followed by at least
+    /// rows * value_size bytes. Returns nullptr if the buffer is too short.
+    static const char* deserializeRows(const char* buf, const char* end, size_t value_size,
+                                       UInt64* rows);
+
+public:
+
     /** Serialization/deserialization of individual values.
       *
       * These are helper methods for implementation of various formats to input/output for user (like CSV, JSON, etc.).
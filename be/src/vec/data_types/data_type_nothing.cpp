@@ -17,9 +17,11 @@
 
 #include "vec/data_types/data_type_nothing.h"
 
+#include "vec/common/assert_cast.h"
 #include "vec/common/typeid_cast.h"
 // #include <vec/DataTypes/DataTypeFactory.h>
 #include "vec/columns/column_nothing.h"
+#include "vec/common/unaligned.h"
 // #include <vec/IO/ReadBuffer.h>
 // #include <vec/IO/WriteBuffer.h>
 
@@ -29,6 +31,26 @@ MutableColumnPtr DataTypeNothing::createColumn() const {
     return ColumnNothing::create(0);
 }
 
+size_t DataTypeNothing::getUncompressedSerializedBytes(const IColumn& column) const {
+    return sizeof(UInt64);
+}
+
+char* DataTypeNothing::serialize(const IColumn& column, char* buf) const {
+    unalignedStore<UInt64>(buf, column.size());
+    return buf + sizeof(UInt64);
+}
+
+const char* DataTypeNothing::deserialize(const char* buf, const char* end,
+                                         IColumn* column) const {
+    UInt64 rows = 0;
+    buf = deserializeRows(buf, end, 0, &rows);
+    if (buf == nullptr) {
+        return nullptr;
+    }
+    assert_cast<ColumnNothing*>(column)->addSize(rows);
+    return buf;
+}
+
 // void DataTypeNothing::serializeBinaryBulk(const IColumn & column, WriteBuffer & ostr, size_t offset, size_t limit) const
 // {
 //     size_t size = column.size();
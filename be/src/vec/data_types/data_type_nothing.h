@@ -42,6 +42,11 @@ public:
     // void serializeBinaryBulk(const IColumn & column, WriteBuffer & ostr, size_t offset, size_t limit) const override;
     // void deserializeBinaryBulk(IColumn & column, ReadBuffer & istr, size_t limit, double avg_value_size_hint) const override;
 
+    /// Only the number of rows.
+    size_t getUncompressedSerializedBytes(const IColumn& column) const override;
+    char* serialize(const IColumn& column, char* buf) const override;
+    const char* deserialize(const char* buf, const char* end, IColumn* column) const override;
+
     bool equals(const IDataType& rhs) const override;
 
     bool isParametric() const override { return false; }
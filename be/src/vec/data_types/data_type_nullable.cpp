@@ -31,6 +31,7 @@
 // #include <vec/Parsers/IAST.h>
 #include "vec/common/assert_cast.h"
 #include "vec/common/typeid_cast.h"
+#include "vec/common/unaligned.h"
 
 namespace doris::vectorized {
 
@@ -483,6 +484,45 @@ bool DataTypeNullable::onlyNull() const {
 //     }
 // }
 
+size_t DataTypeNullable::getUncompressedSerializedBytes(const IColumn& column) const {
+    const auto& col = assert_cast<const ColumnNullable&>(column);
+    return sizeof(UInt64) + col.size() * sizeof(UInt8) +
+           nested_data_type->getUncompressedSerializedBytes(col.getNestedColumn());
+}
+
+char* DataTypeNullable::serialize(const IColumn& column, char* buf) const {
+    const auto& col = assert_cast<const ColumnNullable&>(column);
+    const auto& null_map = col.getNullMapData();
+
+    UInt64 rows = null_map.size();
+    unalignedStore<UInt64>(buf, rows);
+    buf += sizeof(UInt64);
+    memcpy(buf, null_map.data(), rows * sizeof(UInt8));
+    buf += rows * sizeof(UInt8);
+    return nested_data_type->serialize(col.getNestedColumn(), buf);
+}
+
+const char* DataTypeNullable::deserialize(const char* buf, const char* end,
+                                          IColumn* column) const {
+    auto* col = assert_cast<ColumnNullable*>(column);
+    auto& null_map = col->getNullMapData();
+    size_t old_rows = null_map.size();
+
+    UInt64 rows = 0;
+    buf = deserializeRows(buf, end, sizeof(UInt8), &rows);
+    if (buf == nullptr) {
+        return nullptr;
+    }
+    null_map.resize(old_rows + rows);
+    memcpy(null_map.data() + old_rows, buf, rows * sizeof(UInt8));
+    buf += rows * sizeof(UInt8);
+    buf = nested_data_type->deserialize(buf, end, &col->getNestedColumn());
+    if (buf == nullptr || col->getNestedColumn().size() != null_map.size()) {
+        return nullptr;
+    }
+    return buf;
+}
+
 MutableColumnPtr DataTypeNullable::createColumn() const {
     return ColumnNullable::create(nested_data_type->createColumn(), ColumnUInt8::create());
 }
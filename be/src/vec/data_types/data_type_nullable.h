@@ -92,6 +92,11 @@ public:
     //     void serializeProtobuf(const IColumn & column, size_t row_num, ProtobufWriter & protobuf, size_t & value_index) const override;
     //     void deserializeProtobuf(IColumn & column, ProtobufReader & protobuf, bool allow_add_row, bool & row_added) const override;
 
+    /// The null map serialized as UInt8 followed by the nested column.
+    size_t getUncompressedSerializedBytes(const IColumn& column) const override;
+    char* serialize(const IColumn& column, char* buf) const override;
+    const char* deserialize(const char* buf, const char* end, IColumn* column) const override;
+
     MutableColumnPtr createColumn() const override;
 
     Field getDefault() const override;
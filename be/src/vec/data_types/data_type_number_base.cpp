@@ -26,6 +26,7 @@
 #include "vec/common/assert_cast.h"
 #include "vec/common/nan_utils.h"
 #include "vec/common/typeid_cast.h"
+#include "vec/common/unaligned.h"
 // #include <Formats/FormatSettings.h>
 // #include <Formats/ProtobufReader.h>
 // #include <Formats/ProtobufWriter.h>
@@ -255,6 +256,36 @@ Field DataTypeNumberBase<T>::getDefault() const {
 //         container.back() = value;
 // }
 
+template <typename T>
+size_t DataTypeNumberBase<T>::getUncompressedSerializedBytes(const IColumn& column) const {
+    return sizeof(UInt64) + column.size() * sizeof(FieldType);
+}
+
+template <typename T>
+char* DataTypeNumberBase<T>::serialize(const IColumn& column, char* buf) const {
+    const auto& data = assert_cast<const ColumnVector<T>&>(column).getData();
+    UInt64 rows = data.size();
+    unalignedStore<UInt64>(buf, rows);
+    buf += sizeof(UInt64);
+    memcpy(buf, data.data(), rows * sizeof(FieldType));
+    return buf + rows * sizeof(FieldType);
+}
+
+template <typename T>
+const char* DataTypeNumberBase<T>::deserialize(const char* buf, const char* end,
+                                               IColumn* column) const {
+    auto& data = assert_cast<ColumnVector<T>*>(column)->getData();
+    UInt64 rows = 0;
+    buf = deserializeRows(buf, end, sizeof(FieldType), &rows);
+    if (buf == nullptr) {
+        return nullptr;
+    }
+    size_t old_size = data.size();
+    data.resize(old_size + rows);
+    memcpy(data.data() + old_size, buf, rows * sizeof(FieldType));
+    return buf + rows * sizeof(FieldType);
+}
+
 template <typename T>
 MutableColumnPtr DataTypeNumberBase<T>::createColumn() const {
     return ColumnVector<T>::create();
@@ -20,6 +20,7 @@
 #include "vec/columns/columns_number.h"
 #include "vec/common/assert_cast.h"
 #include "vec/common/typeid_cast.h"
+#include "vec/common/unaligned.h"
 #include "vec/core/defines.h"
 #include "vec/core/field.h"
 
@@ -360,6 +361,69 @@ Field DataTypeString::getDefault() const {
     return String();
 }
 
+size_t DataTypeString::getUncompressedSerializedBytes(const IColumn& column) const {
+    const auto& col = assert_cast<const ColumnString&>(column);
+    return sizeof(UInt64) + col.size() * sizeof(IColumn::Offset) + sizeof(UInt64) +
+           col.getChars().size();
+}
+
+char* DataTypeString::serialize(const IColumn& column, char* buf) const {
+    const auto& col = assert_cast<const ColumnString&>(column);
+    const auto& offsets = col.getOffsets();
+    const auto& chars = col.getChars();
+
+    UInt64 rows = offsets.size();
+    unalignedStore<UInt64>(buf, rows);
+    buf += sizeof(UInt64);
+    memcpy(buf, offsets.data(), rows * sizeof(IColumn::Offset));
+    buf += rows * sizeof(IColumn::Offset);
+
+    UInt64 chars_size = chars.size();
+    unalignedStore<UInt64>(buf, chars_size);
+    buf += sizeof(UInt64);
+    memcpy(buf, chars.data(), chars_size);
+    return buf + chars_size;
+}
+
+const char* DataTypeString::deserialize(const char* buf, const char* end,
+                                        IColumn* column) const {
+    auto* col = assert_cast<ColumnString*>(column);
+    auto& offsets = col->getOffsets();
+    auto& chars = col->getChars();
+    size_t old_rows = offsets.size();
+    size_t old_chars_size = chars.size();
+
+    UInt64 rows = 0;
+    buf = deserializeRows(buf, end, sizeof(IColumn::Offset), &rows);
+    if (buf == nullptr) {
+        return nullptr;
+    }
+    offsets.resize(old_rows + rows);
+    memcpy(offsets.data() + old_rows, buf, rows * sizeof(IColumn::Offset));
+    buf += rows * sizeof(IColumn::Offset);
+
+    UInt64 chars_size = 0;
+    buf = deserializeRows(buf, end, 1, &chars_size);
+    if (buf == nullptr) {
+        return nullptr;
+    }
+    /// The offsets are relative to the serialized chars, they must be ascending up to its size.
+    IColumn::Offset prev_offset = 0;
+    for (size_t i = old_rows; i < old_rows + rows; ++i) {
+        if (offsets[i] < prev_offset) {
+            return nullptr;
+        }
+        prev_offset = offsets[i];
+        offsets[i] += old_chars_size;
+    }
+    if (prev_offset != chars_size) {
+        return nullptr;
+    }
+    chars.resize(old_chars_size + chars_size);
+    memcpy(chars.data() + old_chars_size, buf, chars_size);
+    return buf + chars_size;
+}
+
 MutableColumnPtr DataTypeString::createColumn() const {
     return ColumnString::create();
 }
@@ -39,6 +39,12 @@ public:
     //
     //    void serializeBinaryBulk(const IColumn & column, WriteBuffer & ostr, size_t offset, size_t limit) const override;
     //    void deserializeBinaryBulk(IColumn & column, ReadBuffer & istr, size_t limit, double avg_value_size_hint) const override;
+
+    /// The number of rows, the offsets, the size of the chars and the chars.
+    size_t getUncompressedSerializedBytes(const IColumn& column) const override;
+    char* serialize(const IColumn& column, char* buf) const override;
+    const char* deserialize(const char* buf, const char* end, IColumn* column) const override;
+
     //
     //    void serializeText(const IColumn & column, size_t row_num, WriteBuffer & ostr, const FormatSettings &) const override;
     //    void deserializeWholeText(IColumn & column, ReadBuffer & istr, const FormatSettings &) const override;
@@ -22,6 +22,7 @@
 #include "vec/common/assert_cast.h"
 #include "vec/common/int_exp.h"
 #include "vec/common/typeid_cast.h"
+#include "vec/common/unaligned.h"
 //#include <DataTypes/DataTypeFactory.h>
 //#include <Formats/ProtobufReader.h>
 //#include <Formats/ProtobufWriter.h>
@@ -204,6 +205,36 @@ DataTypePtr DataTypeDecimal<T>::promoteNumericType() const {
     return std::make_shared<PromotedType>(PromotedType::maxPrecision(), scale);
 }
 
+template <typename T>
+size_t DataTypeDecimal<T>::getUncompressedSerializedBytes(const IColumn& column) const {
+    return sizeof(UInt64) + column.size() * sizeof(FieldType);
+}
+
+template <typename T>
+char* DataTypeDecimal<T>::serialize(const IColumn& column, char* buf) const {
+    const auto& data = assert_cast<const ColumnType&>(column).getData();
+    UInt64 rows = data.size();
+    unalignedStore<UInt64>(buf, rows);
+    buf += sizeof(UInt64);
+    memcpy(buf, data.data(), rows * sizeof(FieldType));
+    return buf + rows * sizeof(FieldType);
+}
+
+template <typename T>
+const char* DataTypeDecimal<T>::deserialize(const char* buf, const char* end,
+                                            IColumn* column) const {
+    auto& data = assert_cast<ColumnType*>(column)->getData();
+    UInt64 rows = 0;
+    buf = deserializeRows(buf, end, sizeof(FieldType), &rows);
+    if (buf == nullptr) {
+        return nullptr;
+    }
+    size_t old_size = data.size();
+    data.resize(old_size + rows);
+    memcpy(data.data() + old_size, buf, rows * sizeof(FieldType));
+    return buf + rows * sizeof(FieldType);
+}
+
 template <typename T>
 MutableColumnPtr DataTypeDecimal<T>::createColumn() const {
     return ColumnType::create(0, scale);
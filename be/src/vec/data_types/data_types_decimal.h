@@ -127,6 +127,11 @@ public:
     //    void deserializeBinary(Field & field, ReadBuffer & istr) const override;
     //    void deserializeBinary(IColumn & column, ReadBuffer & istr) const override;
     //    void deserializeBinaryBulk(IColumn & column, ReadBuffer & istr, size_t limit, double avg_value_size_hint) const override;
+
+    /// The number of rows followed by the values.
+    size_t getUncompressedSerializedBytes(const IColumn& column) const override;
+    char* serialize(const IColumn& column, char* buf) const override;
+    const char* deserialize(const char* buf, const char* end, IColumn* column) const override;
     //
     //    void serializeProtobuf(const IColumn & column, size_t row_num, ProtobufWriter & protobuf, size_t & value_index) const override;
     //    void deserializeProtobuf(IColumn & column, ProtobufReader & protobuf, bool allow_add_row, bool & row_added) const override;
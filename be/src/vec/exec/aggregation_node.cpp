@@ -17,10 +17,19 @@
 
 #include "vec/exec/aggregation_node.h"
 
+#include "common/config.h"
 #include "exec/exec_node.h"
+#include "runtime/exec_env.h"
 #include "runtime/mem_pool.h"
+#include "runtime/mem_tracker.h"
 #include "runtime/row_batch.h"
+#include "runtime/runtime_state.h"
+#include "vec/columns/column_low_cardinality.h"
+#include "vec/columns/column_string.h"
 #include "vec/core/block.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_string.h"
+#include "vec/exec/olap_scan_node.h"
 #include "vec/exprs/vexpr.h"
 #include "vec/exprs/vexpr_context.h"
 #include "vec/exprs/vslot_ref.h"
@@ -28,6 +37,27 @@
 #include "vec/utils/util.hpp"
 
 namespace doris::vectorized {
+
+/// The minimum reduction factor (input rows / hash table rows) to keep growing the hash
+/// table of a streaming pre-aggregation, by the size of the hash table buffer. Same values
+/// as PartitionedAggregationNode.
+struct StreamingHtMinReductionEntry {
+    int min_ht_mem;
+    double streaming_ht_min_reduction;
+};
+
+static constexpr StreamingHtMinReductionEntry STREAMING_HT_MIN_REDUCTION[] = {
+        // Expand up to L2 cache always.
+        {0, 0.0},
+        // Expand into L3 cache if we look like we're getting some reduction.
+        {256 * 1024, 1.1},
+        // Expand into main memory if we're getting a significant reduction.
+        {2 * 1024 * 1024, 2.0},
+};
+
+static constexpr int STREAMING_HT_MIN_REDUCTION_SIZE =
+        sizeof(STREAMING_HT_MIN_REDUCTION) / sizeof(STREAMING_HT_MIN_REDUCTION[0]);
+
 AggregationNode::AggregationNode(ObjectPool* pool, const TPlanNode& tnode,
                                  const DescriptorTbl& descs)
         : ExecNode(pool, tnode, descs),
@@ -36,7 +66,12 @@ AggregationNode::AggregationNode(ObjectPool* pool, const TPlanNode& tnode,
           _output_tuple_id(tnode.agg_node.output_tuple_id),
           _output_tuple_desc(NULL),
           _needs_finalize(tnode.agg_node.need_finalize),
-          _agg_data() {}
+          _is_streaming_preagg(tnode.agg_node.__isset.use_streaming_preaggregation &&
+                               tnode.agg_node.use_streaming_preaggregation &&
+                               !tnode.agg_node.grouping_exprs.empty() &&
+                               !tnode.agg_node.need_finalize),
+          _agg_data(),
+          _agg_arena_pool(new Arena) {}
 
 AggregationNode::~AggregationNode() {}
 
@@ -69,6 +104,23 @@ Status AggregationNode::prepare(RuntimeState* state) {
 
     _mem_pool.reset(new MemPool(mem_tracker().get()));
 
+    _enable_spill = state->enable_spill() && !_probe_expr_ctxs.empty() && !_is_streaming_preagg;
+    if (_enable_spill) {
+        _spill_timer = ADD_TIMER(runtime_profile(), "SpillTime");
+        _spilled_bytes_counter = ADD_COUNTER(runtime_profile(), "SpilledBytes", TUnit::BYTES);
+        _spill_count_counter = ADD_COUNTER(runtime_profile(), "SpillCount", TUnit::UNIT);
+        _max_spill_level_counter = ADD_COUNTER(runtime_profile(), "MaxSpillLevel", TUnit::UNIT);
+    }
+
+    if (_is_streaming_preagg) {
+        runtime_profile()->append_exec_option("Streaming Preaggregation");
+        _streaming_agg_timer = ADD_TIMER(runtime_profile(), "StreamingTime");
+        _passthrough_rows_counter =
+                ADD_COUNTER(runtime_profile(), "RowsPassedThrough", TUnit::UNIT);
+        _preagg_streaming_ht_min_reduction = ADD_COUNTER(
+                runtime_profile(), "ReductionFactorThresholdToExpand", TUnit::DOUBLE_VALUE);
+    }
+
     int j = _probe_expr_ctxs.size();
     for (int i = 0; i < _aggregate_evaluators.size(); ++i, ++j) {
         SlotDescriptor* intermediate_slot_desc = _intermediate_tuple_desc->slots()[j];
@@ -114,7 +166,9 @@ Status AggregationNode::prepare(RuntimeState* state) {
         intermediate.reserve(slots.size());
 
         for (const auto slot : slots) {
-            auto data_type_ptr = slot->get_data_type_ptr();
+            // without finalize the serialized states are sent to a merge aggregation
+            DataTypePtr data_type_ptr = _needs_finalize ? slot->get_data_type_ptr()
+                                                        : std::make_shared<DataTypeString>();
             intermediate.emplace_back(data_type_ptr->createColumn(), data_type_ptr,
                                       fmt::format("slot-id:{}", slot->id()));
         }
@@ -123,12 +177,128 @@ Status AggregationNode::prepare(RuntimeState* state) {
 
         _single_output_block.reset(new Block(std::move(intermediate)));
     } else {
-        _agg_data.init(AggregatedDataVariants::Type::serialized);
+        _init_hash_method(_probe_expr_ctxs);
     }
 
     return Status::OK();
 }
 
+bool AggregationNode::_request_low_cardinality_key() {
+    if (!config::enable_low_cardinality_optimize || _probe_expr_ctxs.size() != 1) {
+        return false;
+    }
+    auto scan_node = dynamic_cast<VOlapScanNode*>(child(0));
+    auto slot_ref = dynamic_cast<const VSlotRef*>(_probe_expr_ctxs[0]->root());
+    if (scan_node == nullptr || slot_ref == nullptr) {
+        return false;
+    }
+    if (slot_ref->result_type() != TYPE_CHAR && slot_ref->result_type() != TYPE_VARCHAR) {
+        return false;
+    }
+    // the aggregate functions read the values of the rows
+    std::set<int> column_ids;
+    for (auto evaluator : _aggregate_evaluators) {
+        evaluator->collect_slot_column_ids(&column_ids);
+    }
+    if (column_ids.count(slot_ref->column_id()) != 0) {
+        return false;
+    }
+    return scan_node->request_low_cardinality_slot(slot_ref->slot_id());
+}
+
+void AggregationNode::_init_hash_method(std::vector<VExprContext*>& probe_exprs) {
+    DCHECK(probe_exprs.size() >= 1);
+    if (_request_low_cardinality_key()) {
+        _agg_data.init(AggregatedDataVariants::Type::low_cardinality_key,
+                       probe_exprs[0]->root()->is_nullable());
+        return;
+    }
+
+    if (probe_exprs.size() == 1 && !probe_exprs[0]->root()->is_nullable()) {
+        switch (probe_exprs[0]->root()->result_type()) {
+        case TYPE_TINYINT:
+        case TYPE_BOOLEAN:
+            _agg_data.init(AggregatedDataVariants::Type::int8_key);
+            return;
+        case TYPE_SMALLINT:
+            _agg_data.init(AggregatedDataVariants::Type::int16_key);
+            return;
+        case TYPE_INT:
+        case TYPE_FLOAT:
+            _agg_data.init(AggregatedDataVariants::Type::int32_key);
+            return;
+        case TYPE_BIGINT:
+        case TYPE_DOUBLE:
+            _agg_data.init(AggregatedDataVariants::Type::int64_key);
+            return;
+        case TYPE_LARGEINT:
+        case TYPE_DATE:
+        case TYPE_DATETIME:
+        case TYPE_DECIMALV2:
+            _agg_data.init(AggregatedDataVariants::Type::int128_key);
+            return;
+        case TYPE_CHAR:
+        case TYPE_VARCHAR:
+            _agg_data.init(AggregatedDataVariants::Type::string_key);
+            return;
+        default:
+            break;
+        }
+    }
+
+    // Several keys (or a nullable one): pack them into a single fixed size
+    // key if all of them have fixed size, otherwise serialize them.
+    bool use_fixed_key = true;
+    bool has_null = false;
+    size_t key_byte_size = 0;
+
+    _probe_key_sz.resize(probe_exprs.size());
+    for (int i = 0; i < probe_exprs.size(); ++i) {
+        const auto& data_type = probe_exprs[i]->root()->data_type();
+        const auto nested_type = removeNullable(data_type);
+
+        if (!nested_type->isValueUnambiguouslyRepresentedInFixedSizeContiguousMemoryRegion()) {
+            use_fixed_key = false;
+            break;
+        }
+
+        has_null |= data_type->isNullable();
+        _probe_key_sz[i] = nested_type->getSizeOfValueInMemory();
+        key_byte_size += _probe_key_sz[i];
+    }
+
+    if (use_fixed_key) {
+        if (has_null) {
+            if (std::tuple_size<KeysNullMap<UInt64>>::value + key_byte_size <= sizeof(UInt64)) {
+                _agg_data.init(AggregatedDataVariants::Type::int64_keys, has_null);
+            } else if (std::tuple_size<KeysNullMap<UInt128>>::value + key_byte_size <=
+                       sizeof(UInt128)) {
+                _agg_data.init(AggregatedDataVariants::Type::int128_keys, has_null);
+            } else if (std::tuple_size<KeysNullMap<UInt256>>::value + key_byte_size <=
+                       sizeof(UInt256)) {
+                _agg_data.init(AggregatedDataVariants::Type::int256_keys, has_null);
+            } else {
+                use_fixed_key = false;
+            }
+        } else {
+            if (key_byte_size <= sizeof(UInt64)) {
+                _agg_data.init(AggregatedDataVariants::Type::int64_keys);
+            } else if (key_byte_size <= sizeof(UInt128)) {
+                _agg_data.init(AggregatedDataVariants::Type::int128_keys);
+            } else if (key_byte_size <= sizeof(UInt256)) {
+                _agg_data.init(AggregatedDataVariants::Type::int256_keys);
+            } else {
+                use_fixed_key = false;
+            }
+        }
+    }
+
+    if (!use_fixed_key) {
+        _probe_key_sz.clear();
+        _agg_data.init(AggregatedDataVariants::Type::serialized);
+    }
+}
+
 Status AggregationNode::open(RuntimeState* state) {
     RETURN_IF_ERROR(ExecNode::open(state));
     SCOPED_TIMER(_runtime_profile->total_time_counter());
@@ -141,6 +311,11 @@ Status AggregationNode::open(RuntimeState* state) {
 
     RETURN_IF_ERROR(_children[0]->open(state));
 
+    // the streaming pre-aggregation consumes its child in get_next
+    if (_is_streaming_preagg) {
+        return Status::OK();
+    }
+
     bool eos = false;
 
     while (!eos) {
@@ -156,9 +331,20 @@ Status AggregationNode::open(RuntimeState* state) {
         } else {
             // with group by key
             RETURN_IF_ERROR(_execute_with_serialized_key(&block));
+            _update_mem_usage();
+            if (_enable_spill && mem_tracker()->AnyLimitExceeded(MemLimit::SOFT)) {
+                RETURN_IF_ERROR(_spill_hash_table(state));
+            }
         }
     }
 
+    // once something was spilled, the groups left in memory are spilled as well,
+    // so that every partition can be merged on its own
+    if (_spilled) {
+        RETURN_IF_ERROR(_spill_hash_table(state));
+        _queue_spill_partitions();
+    }
+
     return Status::OK();
 }
 
@@ -172,6 +358,10 @@ Status AggregationNode::get_next(RuntimeState* state, Block* block, bool* eos) {
     // procsess no group by
     if (_agg_data._type == AggregatedDataVariants::Type::without_key) {
         return _get_without_key_result(state, block, eos);
+    } else if (_is_streaming_preagg) {
+        return _get_next_streaming(state, block, eos);
+    } else if (_spilled) {
+        return _get_next_spilled(state, block, eos);
     } else {
         return _get_with_serialized_key_result(state, block, eos);
     }
@@ -179,6 +369,15 @@ Status AggregationNode::get_next(RuntimeState* state, Block* block, bool* eos) {
 }
 
 Status AggregationNode::close(RuntimeState* state) {
+    if (_agg_data._type != AggregatedDataVariants::Type::without_key &&
+        _agg_data._type != AggregatedDataVariants::Type::EMPTY) {
+        _reset_hash_table();
+    }
+    _spill_partitions.clear();
+    _spilled_partitions.clear();
+    mem_tracker()->Release(_mem_usage_record);
+    _mem_usage_record = 0;
+
     RETURN_IF_ERROR(ExecNode::close(state));
     VExpr::close(_probe_expr_ctxs, state);
     return Status::OK();
@@ -191,6 +390,12 @@ Status AggregationNode::_create_agg_status(AggregateDataPtr data) {
     return Status::OK();
 }
 
+void AggregationNode::_destroy_agg_status(AggregateDataPtr data) {
+    for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
+        _aggregate_evaluators[i]->destroy(data + _offsets_of_aggregate_states[i]);
+    }
+}
+
 Status AggregationNode::_get_without_key_result(RuntimeState* state, Block* block, bool* eos) {
     DCHECK(_agg_data.without_key != nullptr);
     *block = _single_output_block->cloneEmpty();
@@ -198,8 +403,13 @@ Status AggregationNode::_get_without_key_result(RuntimeState* state, Block* bloc
 
     for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
         auto column = columns[i].get();
-        _aggregate_evaluators[i]->insert_result_info(
-                _agg_data.without_key + _offsets_of_aggregate_states[i], column);
+        if (_needs_finalize) {
+            _aggregate_evaluators[i]->insert_result_info(
+                    _agg_data.without_key + _offsets_of_aggregate_states[i], column);
+        } else {
+            _aggregate_evaluators[i]->insert_serialized_state(
+                    _agg_data.without_key + _offsets_of_aggregate_states[i], column);
+        }
     }
 
     block->setColumns(std::move(columns));
@@ -210,110 +420,446 @@ Status AggregationNode::_get_without_key_result(RuntimeState* state, Block* bloc
 Status AggregationNode::_execute_without_key(Block* block) {
     DCHECK(_agg_data.without_key != nullptr);
     for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
-        _aggregate_evaluators[i]->execute_single_add(
-                block, _agg_data.without_key + _offsets_of_aggregate_states[i]);
+        if (_aggregate_evaluators[i]->is_merge()) {
+            _aggregate_evaluators[i]->execute_single_merge(
+                    block, _agg_data.without_key + _offsets_of_aggregate_states[i],
+                    _agg_arena_pool.get());
+        } else {
+            _aggregate_evaluators[i]->execute_single_add(
+                    block, _agg_data.without_key + _offsets_of_aggregate_states[i]);
+        }
     }
     return Status::OK();
 }
 
 Status AggregationNode::_execute_with_serialized_key(Block* block) {
     DCHECK(!_probe_expr_ctxs.empty());
-    // now we only support serialized key
-    // TODO:
-    DCHECK(_agg_data.serialized != nullptr);
-
-    using Method = AggregationMethodSerialized<AggregatedDataWithStringKey>;
-    using AggState = Method::State;
-
-    auto& method = *_agg_data.serialized;
 
     size_t key_size = _probe_expr_ctxs.size();
     ColumnRawPtrs key_columns(key_size);
 
+    std::vector<int> result_column_ids;
+    RETURN_IF_ERROR(VExprContext::execute_exprs(_probe_expr_ctxs, block, &result_column_ids));
     for (size_t i = 0; i < key_size; ++i) {
-        int result_column_id = -1;
-        RETURN_IF_ERROR(_probe_expr_ctxs[i]->execute(block, &result_column_id));
-        key_columns[i] = block->getByPosition(result_column_id).column.get();
+        // the hash methods read the raw data of key columns, so constant keys
+        // have to be materialized first
+        auto& column = block->getByPosition(result_column_ids[i]).column;
+        column = column->convertToFullColumnIfConst();
+        key_columns[i] = column.get();
     }
 
     int rows = block->rows();
     PODArray<AggregateDataPtr> places(rows);
+    _emplace_into_hash_table(places.data(), key_columns, rows);
 
-    AggState state(key_columns, {}, nullptr);
+    // the aggregate states live in the arena, so places stay valid across the conversion
+    if (config::vectorized_agg_two_level_threshold > 0 &&
+        _agg_data.is_convertible_to_two_level() &&
+        _agg_data.size() >= config::vectorized_agg_two_level_threshold) {
+        _agg_data.convert_to_two_level();
+    }
 
-    /// For all rows.
-    for (size_t i = 0; i < rows; ++i) {
-        AggregateDataPtr aggregate_data = nullptr;
+    for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
+        if (_aggregate_evaluators[i]->is_merge()) {
+            _aggregate_evaluators[i]->execute_batch_merge(block, _offsets_of_aggregate_states[i],
+                                                          places.data(), _agg_arena_pool.get());
+        } else {
+            _aggregate_evaluators[i]->execute_batch_add(block, _offsets_of_aggregate_states[i],
+                                                        places.data(), _agg_arena_pool.get());
+        }
+    }
 
-        auto emplace_result = state.emplaceKey(method.data, i, _agg_arena_pool);
+    return Status::OK();
+}
 
-        /// If a new key is inserted, initialize the states of the aggregate functions, and possibly something related to the key.
-        if (emplace_result.isInserted()) {
-            /// exception-safety - if you can not allocate memory or create states, then destructors will not be called.
-            emplace_result.setMapped(nullptr);
+void AggregationNode::_emplace_into_hash_table(AggregateDataPtr* places,
+                                               ColumnRawPtrs& key_columns, size_t rows) {
+    // the scan could not keep the codes of the rows of a low cardinality key, or they were
+    // spilled, the rows are made the dictionary of the block
+    ColumnPtr low_cardinality_key;
+    if (_agg_data._type == AggregatedDataVariants::Type::low_cardinality_key &&
+        !key_columns[0]->lowCardinality()) {
+        low_cardinality_key = ColumnLowCardinality::createFromFullColumn(key_columns[0]->getPtr());
+        key_columns[0] = low_cardinality_key.get();
+    }
 
-            aggregate_data = _agg_arena_pool.alignedAlloc(_total_size_of_aggregate_states,
-                                                          _align_aggregate_states);
-            _create_agg_status(aggregate_data);
+    std::visit(
+            [&](auto&& agg_method) -> void {
+                using HashMethodType = std::decay_t<decltype(agg_method)>;
+                using AggState = typename HashMethodType::State;
+                AggState state(key_columns, _probe_key_sz, nullptr);
 
-            emplace_result.setMapped(aggregate_data);
-        } else
-            aggregate_data = emplace_result.getMapped();
+                /// For all rows.
+                for (size_t i = 0; i < rows; ++i) {
+                    AggregateDataPtr aggregate_data = nullptr;
 
-        places[i] = aggregate_data;
-        assert(places[i] != nullptr);
-    }
+                    auto emplace_result = state.emplaceKey(agg_method.data, i, *_agg_arena_pool);
 
-    for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
-        _aggregate_evaluators[i]->execute_batch_add(block, _offsets_of_aggregate_states[i],
-                                                    places.data(), &_agg_arena_pool);
-    }
+                    /// If a new key is inserted, initialize the states of the aggregate functions, and possibly something related to the key.
+                    if (emplace_result.isInserted()) {
+                        /// exception-safety - if you can not allocate memory or create states, then destructors will not be called.
+                        emplace_result.setMapped(nullptr);
 
-    return Status::OK();
+                        aggregate_data = _agg_arena_pool->alignedAlloc(
+                                _total_size_of_aggregate_states, _align_aggregate_states);
+                        _create_agg_status(aggregate_data);
+
+                        emplace_result.setMapped(aggregate_data);
+                    } else
+                        aggregate_data = emplace_result.getMapped();
+
+                    places[i] = aggregate_data;
+                    assert(places[i] != nullptr);
+                }
+            },
+            _agg_data._aggregated_method_variant);
+}
+
+MutableColumns AggregationNode::_create_key_columns() {
+    MutableColumns key_columns;
+    for (auto ctx : _probe_expr_ctxs) {
+        key_columns.emplace_back(ctx->root()->data_type()->createColumn());
+    }
+    return key_columns;
 }
 
 Status AggregationNode::_get_with_serialized_key_result(RuntimeState* state, Block* block,
                                                         bool* eos) {
-    DCHECK(_agg_data.serialized != nullptr);
-    using Method = AggregationMethodSerialized<AggregatedDataWithStringKey>;
-    using AggState = Method::State;
-
-    auto& method = *_agg_data.serialized;
-    auto& data = _agg_data.serialized->data;
-
     block->clear();
     auto column_withschema = VectorizedUtils::create_columns_with_type_and_name(row_desc());
 
     int key_size = _probe_expr_ctxs.size();
 
-    MutableColumns key_columns;
-    for (int i = 0; i < key_size; ++i) {
-        key_columns.emplace_back(column_withschema[i].type->createColumn());
-    }
+    MutableColumns key_columns = _create_key_columns();
     MutableColumns value_columns;
     for (int i = key_size; i < column_withschema.size(); ++i) {
+        if (!_needs_finalize) {
+            column_withschema[i].type = std::make_shared<DataTypeString>();
+        }
         value_columns.emplace_back(column_withschema[i].type->createColumn());
     }
 
-    data.forEachValue([&](const auto& key, auto& mapped) {
-        // insert keys
-        method.insertKeyIntoColumns(key, key_columns, {});
-        // insert values
-        for (size_t i = 0; i < _aggregate_evaluators.size(); ++i)
-            _aggregate_evaluators[i]->insert_result_info(mapped + _offsets_of_aggregate_states[i],
-                                                         value_columns[i].get());
-    });
-
-    *block = column_withschema;
-    MutableColumns columns(block->columns());
-    for (int i = 0; i < block->columns(); ++i) {
+    std::visit(
+            [&](auto&& agg_method) -> void {
+                agg_method.data.forEachValue([&](const auto& key, auto& mapped) {
+                    // insert keys
+                    agg_method.insertKeyIntoColumns(key, key_columns, _probe_key_sz);
+                    // insert values
+                    for (size_t i = 0; i < _aggregate_evaluators.size(); ++i) {
+                        if (_needs_finalize) {
+                            _aggregate_evaluators[i]->insert_result_info(
+                                    mapped + _offsets_of_aggregate_states[i],
+                                    value_columns[i].get());
+                        } else {
+                            _aggregate_evaluators[i]->insert_serialized_state(
+                                    mapped + _offsets_of_aggregate_states[i],
+                                    value_columns[i].get());
+                        }
+                    }
+                });
+            },
+            _agg_data._aggregated_method_variant);
+
+    for (int i = 0; i < column_withschema.size(); ++i) {
         if (i < key_size) {
-            columns[i] = std::move(key_columns[i]);
+            ColumnPtr column = std::move(key_columns[i]);
+            // the key slot of the output may be nullable while the key expr is not
+            if (column_withschema[i].type->isNullable()) {
+                column = makeNullable(column);
+            }
+            column_withschema[i].column = std::move(column);
         } else {
-            columns[i] = std::move(value_columns[i - key_size]);
+            column_withschema[i].column = std::move(value_columns[i - key_size]);
+        }
+    }
+    *block = Block(std::move(column_withschema));
+    *eos = true;
+    return Status::OK();
+}
+
+Status AggregationNode::_get_next_streaming(RuntimeState* state, Block* block, bool* eos) {
+    SCOPED_TIMER(_streaming_agg_timer);
+    while (!_child_eos) {
+        Block child_block;
+        RETURN_IF_CANCELLED(state);
+        RETURN_IF_ERROR(_children[0]->get_next(state, &child_block, &_child_eos));
+        if (child_block.rows() == 0) {
+            continue;
+        }
+
+        // Stop growing the hash table if it does not reduce the input sufficiently, every
+        // lookup gets slower once the table falls out of a cache level.
+        bool expand = _should_expand_preagg_hash_tables();
+        _num_input_rows += child_block.rows();
+        if (expand) {
+            RETURN_IF_ERROR(_execute_with_serialized_key(&child_block));
+        } else {
+            RETURN_IF_ERROR(_streaming_passthrough(&child_block, block));
+            *eos = false;
+            return Status::OK();
+        }
+    }
+
+    // the child is exhausted, return the groups aggregated so far
+    return _get_with_serialized_key_result(state, block, eos);
+}
+
+bool AggregationNode::_should_expand_preagg_hash_tables() {
+    const int64_t ht_rows = _agg_data.size();
+    // Need some rows in tables to have valid statistics.
+    if (ht_rows == 0) return true;
+
+    // Find the appropriate reduction factor in our table for the current hash table sizes.
+    const int64_t ht_mem = _agg_data.get_buffer_size_in_bytes();
+    int cache_level = 0;
+    while (cache_level + 1 < STREAMING_HT_MIN_REDUCTION_SIZE &&
+           ht_mem >= STREAMING_HT_MIN_REDUCTION[cache_level + 1].min_ht_mem) {
+        ++cache_level;
+    }
+
+    // Compare the number of rows in the hash table with the number of input rows that
+    // were aggregated into it, the passed through rows are not in the hash table.
+    const int64_t aggregated_input_rows = _num_input_rows - _num_passthrough_rows;
+    if (aggregated_input_rows <= 0) return true;
+
+    double current_reduction = static_cast<double>(aggregated_input_rows) / ht_rows;
+    double min_reduction = STREAMING_HT_MIN_REDUCTION[cache_level].streaming_ht_min_reduction;
+    COUNTER_SET(_preagg_streaming_ht_min_reduction, min_reduction);
+    return current_reduction > min_reduction;
+}
+
+Status AggregationNode::_streaming_passthrough(Block* in_block, Block* out_block) {
+    size_t key_size = _probe_expr_ctxs.size();
+    size_t rows = in_block->rows();
+
+    ColumnsWithTypeAndName columns_with_schema =
+            VectorizedUtils::create_columns_with_type_and_name(row_desc());
+    std::vector<int> result_column_ids;
+    RETURN_IF_ERROR(VExprContext::execute_exprs(_probe_expr_ctxs, in_block, &result_column_ids));
+    for (size_t i = 0; i < key_size; ++i) {
+        ColumnPtr column = in_block->getByPosition(result_column_ids[i])
+                                   .column->convertToFullColumnIfConst()
+                                   ->convertToFullColumnIfLowCardinality();
+        // the key slot of the output may be nullable while the key expr is not
+        if (columns_with_schema[i].type->isNullable()) {
+            column = makeNullable(column);
+        }
+        columns_with_schema[i].column = std::move(column);
+    }
+
+    // every row gets its own state, they only live until they are serialized
+    Arena arena;
+    PODArray<AggregateDataPtr> places(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        places[i] = arena.alignedAlloc(_total_size_of_aggregate_states, _align_aggregate_states);
+        _create_agg_status(places[i]);
+    }
+
+    for (size_t i = 0; i < _aggregate_evaluators.size(); ++i) {
+        _aggregate_evaluators[i]->execute_batch_add(in_block, _offsets_of_aggregate_states[i],
+                                                    places.data(), &arena);
+
+        auto value_column = ColumnString::create();
+        for (size_t j = 0; j < rows; ++j) {
+            _aggregate_evaluators[i]->insert_serialized_state(
+                    places[j] + _offsets_of_aggregate_states[i], value_column.get());
+        }
+        columns_with_schema[key_size + i].type = std::make_shared<DataTypeString>();
+        columns_with_schema[key_size + i].column = std::move(value_column);
+    }
+
+    for (size_t i = 0; i < rows; ++i) {
+        for (size_t j = 0; j < _aggregate_evaluators.size(); ++j) {
+            _aggregate_evaluators[j]->destroy(places[i] + _offsets_of_aggregate_states[j]);
+        }
+    }
+
+    *out_block = Block(std::move(columns_with_schema));
+    _num_passthrough_rows += rows;
+    COUNTER_SET(_passthrough_rows_counter, _num_passthrough_rows);
+    return Status::OK();
+}
+
+void AggregationNode::_update_mem_usage() {
+    int64_t mem_usage = _agg_arena_pool->size() + _agg_data.get_buffer_size_in_bytes();
+    mem_tracker()->Consume(mem_usage - _mem_usage_record);
+    _mem_usage_record = mem_usage;
+}
+
+void AggregationNode::_reset_hash_table() {
+    std::visit(
+            [&](auto&& agg_method) -> void {
+                agg_method.data.forEachMapped([&](auto& mapped) { _destroy_agg_status(mapped); });
+            },
+            _agg_data._aggregated_method_variant);
+    _agg_data.init(_agg_data._type, _agg_data._is_nullable);
+    _agg_arena_pool.reset(new Arena);
+    _update_mem_usage();
+}
+
+size_t AggregationNode::_spill_partition(size_t hash, int level) {
+    // The hash is mixed again, the bits of the hash itself are no good: the CRC32 hashes only
+    // fill the low 32 bits, the small integer keys are their own hash, and the two level hash
+    // table buckets by bits 24 to 31, so a partition would only fill some of its buckets.
+    // Every level mixes it with another seed, the groups of one partition of a level are
+    // spread over all the partitions of the next one.
+    return intHash64(hash ^ (level * 0x9E3779B97F4A7C15ULL)) % SPILL_PARTITION_FANOUT;
+}
+
+Status AggregationNode::_spill_hash_table(RuntimeState* state) {
+    SCOPED_TIMER(_spill_timer);
+    if (_agg_data.size() == 0) {
+        return Status::OK();
+    }
+    _spilled = true;
+    if (_spill_partitions.empty()) {
+        for (size_t i = 0; i < SPILL_PARTITION_FANOUT; ++i) {
+            _spill_partitions.emplace_back(new SpillStream(state->exec_env()->tmp_file_mgr(),
+                                                           state->query_id()));
+        }
+        COUNTER_SET(_max_spill_level_counter,
+                    std::max<int64_t>(_max_spill_level_counter->value(), _spill_level));
+    }
+
+    // the keys are spilled as the hash table has them, they are merged back into it
+    auto column_withschema = VectorizedUtils::create_columns_with_type_and_name(row_desc());
+    int key_size = _probe_expr_ctxs.size();
+    for (int i = 0; i < column_withschema.size(); ++i) {
+        column_withschema[i].type = i < key_size ? _probe_expr_ctxs[i]->root()->data_type()
+                                                 : std::make_shared<DataTypeString>();
+    }
+
+    // the columns of a partition are flushed once they reach _spill_flush_bytes, so the
+    // memory taken to spill is bounded whatever the size of the hash table
+    std::vector<MutableColumns> columns(SPILL_PARTITION_FANOUT);
+    auto create_columns = [&](size_t p) {
+        columns[p] = _create_key_columns();
+        for (int i = key_size; i < column_withschema.size(); ++i) {
+            columns[p].emplace_back(column_withschema[i].type->createColumn());
+        }
+    };
+    auto flush = [&](size_t p) -> Status {
+        Block block = column_withschema;
+        block.setColumns(std::move(columns[p]));
+        create_columns(p);
+
+        int64_t bytes_before = _spill_partitions[p]->bytes_written();
+        RETURN_IF_ERROR(_spill_partitions[p]->write_block(block));
+        COUNTER_UPDATE(_spilled_bytes_counter,
+                       _spill_partitions[p]->bytes_written() - bytes_before);
+        return Status::OK();
+    };
+    for (size_t p = 0; p < SPILL_PARTITION_FANOUT; ++p) {
+        create_columns(p);
+    }
+
+    Status st;
+    std::visit(
+            [&](auto&& agg_method) -> void {
+                agg_method.data.forEachValue([&](const auto& key, auto& mapped) {
+                    if (!st.ok()) {
+                        return;
+                    }
+                    size_t p = _spill_partition(agg_method.data.hash(key), _spill_level);
+                    agg_method.insertKeyIntoColumns(key, columns[p], _probe_key_sz);
+                    for (size_t i = 0; i < _aggregate_evaluators.size(); ++i) {
+                        _aggregate_evaluators[i]->insert_serialized_state(
+                                mapped + _offsets_of_aggregate_states[i],
+                                columns[p][key_size + i].get());
+                    }
+
+                    size_t bytes = 0;
+                    for (const auto& column : columns[p]) {
+                        bytes += column->byteSize();
+                    }
+                    if (bytes >= _spill_flush_bytes) {
+                        st = flush(p);
+                    }
+                });
+            },
+            _agg_data._aggregated_method_variant);
+    RETURN_IF_ERROR(st);
+
+    for (size_t p = 0; p < SPILL_PARTITION_FANOUT; ++p) {
+        if (!columns[p][0]->empty()) {
+            RETURN_IF_ERROR(flush(p));
+        }
+    }
+    COUNTER_UPDATE(_spill_count_counter, 1);
+
+    _reset_hash_table();
+    return Status::OK();
+}
+
+void AggregationNode::_queue_spill_partitions() {
+    // the partitions of the last spill go first, the disk they take is freed sooner
+    for (auto it = _spill_partitions.rbegin(); it != _spill_partitions.rend(); ++it) {
+        if (!(*it)->empty()) {
+            _spilled_partitions.push_front({std::move(*it), _spill_level});
+        }
+    }
+    _spill_partitions.clear();
+}
+
+Status AggregationNode::_merge_spilled_block(Block* block) {
+    size_t key_size = _probe_expr_ctxs.size();
+    ColumnRawPtrs key_columns(key_size);
+    for (size_t i = 0; i < key_size; ++i) {
+        key_columns[i] = block->getByPosition(i).column.get();
+    }
+
+    int rows = block->rows();
+    PODArray<AggregateDataPtr> places(rows);
+    _emplace_into_hash_table(places.data(), key_columns, rows);
+
+    for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
+        _aggregate_evaluators[i]->merge_serialized_states(
+                *block->getByPosition(key_size + i).column, _offsets_of_aggregate_states[i],
+                places.data(), _agg_arena_pool.get());
+    }
+    return Status::OK();
+}
+
+Status AggregationNode::_get_next_spilled(RuntimeState* state, Block* block, bool* eos) {
+    // every group of a partition is in the same partition of every spill,
+    // so the partitions are merged and output one by one
+    while (!_spilled_partitions.empty()) {
+        SpilledPartition partition = std::move(_spilled_partitions.front());
+        _spilled_partitions.pop_front();
+
+        // a partition that does not fit either is spilled again to the partitions of the
+        // next level, a single group can not be split
+        _reset_hash_table();
+        _spill_level = partition.level + 1;
+        bool partition_eos = false;
+        while (!partition_eos) {
+            RETURN_IF_CANCELLED(state);
+            Block spilled_block;
+            RETURN_IF_ERROR(partition.stream->read_block(&spilled_block, &partition_eos));
+            if (!partition_eos) {
+                RETURN_IF_ERROR(_merge_spilled_block(&spilled_block));
+                _update_mem_usage();
+                if (_spill_level < MAX_SPILL_LEVEL && _agg_data.size() > 1 &&
+                    mem_tracker()->AnyLimitExceeded(MemLimit::SOFT)) {
+                    RETURN_IF_ERROR(_spill_hash_table(state));
+                }
+            }
+        }
+        partition.stream->close();
+
+        if (!_spill_partitions.empty()) {
+            RETURN_IF_ERROR(_spill_hash_table(state));
+            _queue_spill_partitions();
+            continue;
+        }
+
+        bool unused_eos = false;
+        RETURN_IF_ERROR(_get_with_serialized_key_result(state, block, &unused_eos));
+        if (block->rows() > 0) {
+            *eos = false;
+            return Status::OK();
         }
     }
-    block->setColumns(std::move(columns));
     *eos = true;
     return Status::OK();
 }
@@ -16,10 +16,18 @@
 // under the License.
 
 #pragma once
+
+#include <deque>
+#include <variant>
+
 #include "exec/exec_node.h"
 #include "vec/aggregate_functions/aggregate_function.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_vector_helper.h"
 #include "vec/common/columns_hashing.h"
 #include "vec/common/hash_table/hash_map.h"
+#include "vec/common/hash_table/two_level_hash_map.h"
+#include "vec/exec/spill_stream.h"
 #include "vec/exprs/vectorized_agg_fn.h"
 
 namespace doris {
@@ -60,40 +68,429 @@ struct AggregationMethodSerialized {
     }
 };
 
+/// For the case where there is one numeric key.
+/// FieldType is UInt8/16/32/64/128 for any type with corresponding bit width.
+template <typename FieldType, typename TData>
+struct AggregationMethodOneNumber {
+    using Data = TData;
+    using Key = typename Data::key_type;
+    using Mapped = typename Data::mapped_type;
+
+    Data data;
+
+    AggregationMethodOneNumber() {}
+
+    template <typename Other>
+    AggregationMethodOneNumber(const Other& other) : data(other.data) {}
+
+    using State = ColumnsHashing::HashMethodOneNumber<typename Data::value_type, Mapped, FieldType>;
+
+    static const bool low_cardinality_optimization = false;
+
+    // Insert the key from the hash table into columns.
+    static void insertKeyIntoColumns(const Key& key, MutableColumns& key_columns,
+                                     const Sizes&) {
+        const auto* key_holder = reinterpret_cast<const char*>(&key);
+        /// The key column is of the type of the key expr, which chose this method: a not
+        /// nullable ColumnVector or ColumnDecimal, whose data follows ColumnVectorHelper.
+        IColumn* key_column = key_columns[0].get();
+        assert(!key_column->isNullable() && key_column->isFixedAndContiguous() &&
+               key_column->sizeOfValueIfFixed() == sizeof(FieldType));
+        auto* column = static_cast<ColumnVectorHelper*>(key_column);
+        column->insertRawData<sizeof(FieldType)>(key_holder);
+    }
+};
+
+/// For the case where there is one string key.
+template <typename TData>
+struct AggregationMethodString {
+    using Data = TData;
+    using Key = typename Data::key_type;
+    using Mapped = typename Data::mapped_type;
+
+    Data data;
+
+    AggregationMethodString() {}
+
+    template <typename Other>
+    AggregationMethodString(const Other& other) : data(other.data) {}
+
+    using State = ColumnsHashing::HashMethodString<typename Data::value_type, Mapped>;
+
+    static const bool low_cardinality_optimization = false;
+
+    static void insertKeyIntoColumns(const StringRef& key, MutableColumns& key_columns,
+                                     const Sizes&) {
+        key_columns[0]->insertData(key.data, key.size);
+    }
+};
+
+/// For the case where there is one low cardinality key, see ColumnLowCardinality. The values
+/// of its dictionary are looked up by the method of the dictionary column.
+template <typename SingleColumnMethod>
+struct AggregationMethodSingleLowCardinalityColumn : public SingleColumnMethod {
+    using Base = SingleColumnMethod;
+    using Data = typename Base::Data;
+    using Key = typename Base::Key;
+    using Mapped = typename Base::Mapped;
+
+    using Base::data;
+
+    AggregationMethodSingleLowCardinalityColumn() = default;
+
+    template <typename Other>
+    explicit AggregationMethodSingleLowCardinalityColumn(const Other& other) : Base(other) {}
+
+    using State =
+            ColumnsHashing::HashMethodSingleLowCardinalityColumn<typename Base::State, Mapped>;
+
+    static const bool low_cardinality_optimization = true;
+};
+
+/// For the case where all keys are of fixed length, and they fit in N (for example, 128) bits.
+template <typename TData, bool has_nullable_keys_ = false>
+struct AggregationMethodKeysFixed {
+    using Data = TData;
+    using Key = typename Data::key_type;
+    using Mapped = typename Data::mapped_type;
+    static constexpr bool has_nullable_keys = has_nullable_keys_;
+
+    Data data;
+
+    AggregationMethodKeysFixed() {}
+
+    template <typename Other>
+    AggregationMethodKeysFixed(const Other& other) : data(other.data) {}
+
+    using State = ColumnsHashing::HashMethodKeysFixed<typename Data::value_type, Key, Mapped,
+                                                      has_nullable_keys>;
+
+    static const bool low_cardinality_optimization = false;
+
+    static void insertKeyIntoColumns(const Key& key, MutableColumns& key_columns,
+                                     const Sizes& key_sizes) {
+        size_t keys_size = key_columns.size();
+
+        static constexpr auto bitmap_size =
+                has_nullable_keys ? std::tuple_size<KeysNullMap<Key>>::value : 0;
+        /// In any hash key value, column values to be read start just after the bitmap, if it exists.
+        size_t pos = bitmap_size;
+
+        for (size_t i = 0; i < keys_size; ++i) {
+            IColumn* observed_column;
+            ColumnUInt8* null_map;
+
+            bool column_nullable = false;
+            if constexpr (has_nullable_keys) column_nullable = isColumnNullable(*key_columns[i]);
+
+            /// If we have a nullable column, get its nested column and its null map.
+            if (column_nullable) {
+                ColumnNullable& nullable_col = assert_cast<ColumnNullable&>(*key_columns[i]);
+                observed_column = &nullable_col.getNestedColumn();
+                null_map = assert_cast<ColumnUInt8*>(&nullable_col.getNullMapColumn());
+            } else {
+                observed_column = key_columns[i].get();
+                null_map = nullptr;
+            }
+
+            bool is_null = false;
+            if (column_nullable) {
+                /// The current column is nullable. Check if the value of the
+                /// corresponding key is nullable. Update the null map accordingly.
+                size_t bucket = i / 8;
+                size_t offset = i % 8;
+                UInt8 val = (reinterpret_cast<const UInt8*>(&key)[bucket] >> offset) & 1;
+                null_map->insertValue(val);
+                is_null = val == 1;
+            }
+
+            if (has_nullable_keys && is_null) {
+                observed_column->insertDefault();
+            } else {
+                size_t size = key_sizes[i];
+                observed_column->insertData(reinterpret_cast<const char*>(&key) + pos, size);
+                pos += size;
+            }
+        }
+    }
+};
+
 using AggregatedDataWithoutKey = AggregateDataPtr;
 using AggregatedDataWithStringKey = HashMapWithSavedHash<StringRef, AggregateDataPtr>;
 
+/// For small keys the hash table is a direct lookup table, no hashing is needed.
+using AggregatedDataWithUInt8Key =
+        HashMap<UInt8, AggregateDataPtr, TrivialHash, HashTableFixedGrower<8>>;
+using AggregatedDataWithUInt16Key =
+        HashMap<UInt16, AggregateDataPtr, TrivialHash, HashTableFixedGrower<16>>;
+using AggregatedDataWithUInt32Key = HashMap<UInt32, AggregateDataPtr, HashCRC32<UInt32>>;
+using AggregatedDataWithUInt64Key = HashMap<UInt64, AggregateDataPtr, HashCRC32<UInt64>>;
+using AggregatedDataWithKeys128 = HashMap<UInt128, AggregateDataPtr, UInt128HashCRC32>;
+using AggregatedDataWithKeys256 = HashMap<UInt256, AggregateDataPtr, UInt256HashCRC32>;
+
+/// Used once the number of groups is large, see AggregatedDataVariants::convert_to_two_level.
+using AggregatedDataWithStringKeyTwoLevel =
+        TwoLevelHashMapWithSavedHash<StringRef, AggregateDataPtr>;
+using AggregatedDataWithUInt32KeyTwoLevel =
+        TwoLevelHashMap<UInt32, AggregateDataPtr, HashCRC32<UInt32>>;
+using AggregatedDataWithUInt64KeyTwoLevel =
+        TwoLevelHashMap<UInt64, AggregateDataPtr, HashCRC32<UInt64>>;
+using AggregatedDataWithKeys128TwoLevel =
+        TwoLevelHashMap<UInt128, AggregateDataPtr, UInt128HashCRC32>;
+using AggregatedDataWithKeys256TwoLevel =
+        TwoLevelHashMap<UInt256, AggregateDataPtr, UInt256HashCRC32>;
+
+using AggregatedMethodVariants = std::variant<
+        AggregationMethodSerialized<AggregatedDataWithStringKey>,
+        AggregationMethodOneNumber<UInt8, AggregatedDataWithUInt8Key>,
+        AggregationMethodOneNumber<UInt16, AggregatedDataWithUInt16Key>,
+        AggregationMethodOneNumber<UInt32, AggregatedDataWithUInt32Key>,
+        AggregationMethodOneNumber<UInt64, AggregatedDataWithUInt64Key>,
+        AggregationMethodOneNumber<UInt128, AggregatedDataWithKeys128>,
+        AggregationMethodString<AggregatedDataWithStringKey>,
+        AggregationMethodKeysFixed<AggregatedDataWithUInt64Key, false>,
+        AggregationMethodKeysFixed<AggregatedDataWithUInt64Key, true>,
+        AggregationMethodKeysFixed<AggregatedDataWithKeys128, false>,
+        AggregationMethodKeysFixed<AggregatedDataWithKeys128, true>,
+        AggregationMethodKeysFixed<AggregatedDataWithKeys256, false>,
+        AggregationMethodKeysFixed<AggregatedDataWithKeys256, true>,
+        AggregationMethodSerialized<AggregatedDataWithStringKeyTwoLevel>,
+        AggregationMethodOneNumber<UInt32, AggregatedDataWithUInt32KeyTwoLevel>,
+        AggregationMethodOneNumber<UInt64, AggregatedDataWithUInt64KeyTwoLevel>,
+        AggregationMethodOneNumber<UInt128, AggregatedDataWithKeys128TwoLevel>,
+        AggregationMethodString<AggregatedDataWithStringKeyTwoLevel>,
+        AggregationMethodKeysFixed<AggregatedDataWithUInt64KeyTwoLevel, false>,
+        AggregationMethodKeysFixed<AggregatedDataWithUInt64KeyTwoLevel, true>,
+        AggregationMethodKeysFixed<AggregatedDataWithKeys128TwoLevel, false>,
+        AggregationMethodKeysFixed<AggregatedDataWithKeys128TwoLevel, true>,
+        AggregationMethodKeysFixed<AggregatedDataWithKeys256TwoLevel, false>,
+        AggregationMethodKeysFixed<AggregatedDataWithKeys256TwoLevel, true>,
+        AggregationMethodSingleLowCardinalityColumn<
+                AggregationMethodString<AggregatedDataWithStringKey>>,
+        AggregationMethodSingleLowCardinalityColumn<
+                AggregationMethodSerialized<AggregatedDataWithStringKey>>>;
+
 struct AggregatedDataVariants {
     AggregatedDataVariants() = default;
     AggregatedDataVariants(const AggregatedDataVariants&) = delete;
     AggregatedDataVariants& operator=(const AggregatedDataVariants&) = delete;
     AggregatedDataWithoutKey without_key = nullptr;
-    std::unique_ptr<AggregationMethodSerialized<AggregatedDataWithStringKey>> serialized;
+    AggregatedMethodVariants _aggregated_method_variant;
+
     enum class Type {
         EMPTY = 0,
         without_key,
-        serialized
-        // TODO: add more key optimize types
+        serialized,
+        int8_key,
+        int16_key,
+        int32_key,
+        int64_key,
+        int128_key,
+        string_key,
+        int64_keys,
+        int128_keys,
+        int256_keys,
+        low_cardinality_key
     };
 
     Type _type = Type::EMPTY;
+    bool _is_nullable = false;
+    bool _is_two_level = false;
 
-    void init(Type type) {
+    // is_nullable only makes sense for the fixed keys variants, where a
+    // null bitmap is packed in front of the key values, and for the low
+    // cardinality key, whose nullable values are serialized.
+    void init(Type type, bool is_nullable = false) {
         _type = type;
+        _is_nullable = is_nullable;
+        _is_two_level = false;
         switch (_type) {
+        case Type::without_key:
+            break;
         case Type::serialized:
-            serialized.reset(new AggregationMethodSerialized<AggregatedDataWithStringKey>());
+            _aggregated_method_variant
+                    .emplace<AggregationMethodSerialized<AggregatedDataWithStringKey>>();
+            break;
+        case Type::int8_key:
+            _aggregated_method_variant
+                    .emplace<AggregationMethodOneNumber<UInt8, AggregatedDataWithUInt8Key>>();
+            break;
+        case Type::int16_key:
+            _aggregated_method_variant
+                    .emplace<AggregationMethodOneNumber<UInt16, AggregatedDataWithUInt16Key>>();
+            break;
+        case Type::int32_key:
+            _aggregated_method_variant
+                    .emplace<AggregationMethodOneNumber<UInt32, AggregatedDataWithUInt32Key>>();
+            break;
+        case Type::int64_key:
+            _aggregated_method_variant
+                    .emplace<AggregationMethodOneNumber<UInt64, AggregatedDataWithUInt64Key>>();
+            break;
+        case Type::int128_key:
+            _aggregated_method_variant
+                    .emplace<AggregationMethodOneNumber<UInt128, AggregatedDataWithKeys128>>();
+            break;
+        case Type::string_key:
+            _aggregated_method_variant
+                    .emplace<AggregationMethodString<AggregatedDataWithStringKey>>();
+            break;
+        case Type::int64_keys:
+            if (is_nullable) {
+                _aggregated_method_variant
+                        .emplace<AggregationMethodKeysFixed<AggregatedDataWithUInt64Key, true>>();
+            } else {
+                _aggregated_method_variant
+                        .emplace<AggregationMethodKeysFixed<AggregatedDataWithUInt64Key, false>>();
+            }
+            break;
+        case Type::int128_keys:
+            if (is_nullable) {
+                _aggregated_method_variant
+                        .emplace<AggregationMethodKeysFixed<AggregatedDataWithKeys128, true>>();
+            } else {
+                _aggregated_method_variant
+                        .emplace<AggregationMethodKeysFixed<AggregatedDataWithKeys128, false>>();
+            }
+            break;
+        case Type::int256_keys:
+            if (is_nullable) {
+                _aggregated_method_variant
+                        .emplace<AggregationMethodKeysFixed<AggregatedDataWithKeys256, true>>();
+            } else {
+                _aggregated_method_variant
+                        .emplace<AggregationMethodKeysFixed<AggregatedDataWithKeys256, false>>();
+            }
+            break;
+        case Type::low_cardinality_key:
+            if (is_nullable) {
+                _aggregated_method_variant.emplace<AggregationMethodSingleLowCardinalityColumn<
+                        AggregationMethodSerialized<AggregatedDataWithStringKey>>>();
+            } else {
+                _aggregated_method_variant.emplace<AggregationMethodSingleLowCardinalityColumn<
+                        AggregationMethodString<AggregatedDataWithStringKey>>>();
+            }
             break;
         default:
+            DCHECK(false) << "Do not have a right agg data type";
+        }
+    }
+
+    size_t size() const {
+        return std::visit([](auto&& agg_method) -> size_t { return agg_method.data.size(); },
+                          _aggregated_method_variant);
+    }
+
+    size_t get_buffer_size_in_bytes() const {
+        return std::visit(
+                [](auto&& agg_method) -> size_t { return agg_method.data.getBufferSizeInBytes(); },
+                _aggregated_method_variant);
+    }
+
+    // The tiny int8/int16 tables are direct lookup tables, nothing to gain there. The low
+    // cardinality keys have few groups.
+    bool is_convertible_to_two_level() const {
+        if (_is_two_level) return false;
+        switch (_type) {
+        case Type::serialized:
+        case Type::int32_key:
+        case Type::int64_key:
+        case Type::int128_key:
+        case Type::string_key:
+        case Type::int64_keys:
+        case Type::int128_keys:
+        case Type::int256_keys:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    /// Move the groups into a hash table partitioned into 256 buckets by the hash value, so
+    /// that later resizes only rehash a single bucket. The aggregate states are not touched.
+    void convert_to_two_level() {
+        DCHECK(is_convertible_to_two_level());
+        switch (_type) {
+        case Type::serialized:
+            _convert_to_two_level<AggregationMethodSerialized<AggregatedDataWithStringKey>,
+                                  AggregationMethodSerialized<AggregatedDataWithStringKeyTwoLevel>>();
+            break;
+        case Type::int32_key:
+            _convert_to_two_level<
+                    AggregationMethodOneNumber<UInt32, AggregatedDataWithUInt32Key>,
+                    AggregationMethodOneNumber<UInt32, AggregatedDataWithUInt32KeyTwoLevel>>();
+            break;
+        case Type::int64_key:
+            _convert_to_two_level<
+                    AggregationMethodOneNumber<UInt64, AggregatedDataWithUInt64Key>,
+                    AggregationMethodOneNumber<UInt64, AggregatedDataWithUInt64KeyTwoLevel>>();
             break;
+        case Type::int128_key:
+            _convert_to_two_level<
+                    AggregationMethodOneNumber<UInt128, AggregatedDataWithKeys128>,
+                    AggregationMethodOneNumber<UInt128, AggregatedDataWithKeys128TwoLevel>>();
+            break;
+        case Type::string_key:
+            _convert_to_two_level<AggregationMethodString<AggregatedDataWithStringKey>,
+                                  AggregationMethodString<AggregatedDataWithStringKeyTwoLevel>>();
+            break;
+        case Type::int64_keys:
+            if (_is_nullable) {
+                _convert_to_two_level<
+                        AggregationMethodKeysFixed<AggregatedDataWithUInt64Key, true>,
+                        AggregationMethodKeysFixed<AggregatedDataWithUInt64KeyTwoLevel, true>>();
+            } else {
+                _convert_to_two_level<
+                        AggregationMethodKeysFixed<AggregatedDataWithUInt64Key, false>,
+                        AggregationMethodKeysFixed<AggregatedDataWithUInt64KeyTwoLevel, false>>();
+            }
+            break;
+        case Type::int128_keys:
+            if (_is_nullable) {
+                _convert_to_two_level<
+                        AggregationMethodKeysFixed<AggregatedDataWithKeys128, true>,
+                        AggregationMethodKeysFixed<AggregatedDataWithKeys128TwoLevel, true>>();
+            } else {
+                _convert_to_two_level<
+                        AggregationMethodKeysFixed<AggregatedDataWithKeys128, false>,
+                        AggregationMethodKeysFixed<AggregatedDataWithKeys128TwoLevel, false>>();
+            }
+            break;
+        case Type::int256_keys:
+            if (_is_nullable) {
+                _convert_to_two_level<
+                        AggregationMethodKeysFixed<AggregatedDataWithKeys256, true>,
+                        AggregationMethodKeysFixed<AggregatedDataWithKeys256TwoLevel, true>>();
+            } else {
+                _convert_to_two_level<
+                        AggregationMethodKeysFixed<AggregatedDataWithKeys256, false>,
+                        AggregationMethodKeysFixed<AggregatedDataWithKeys256TwoLevel, false>>();
+            }
+            break;
+        default:
+            DCHECK(false) << "Do not have a right agg data type";
         }
+        _is_two_level = true;
+    }
+
+private:
+    template <typename SingleLevel, typename TwoLevel>
+    void _convert_to_two_level() {
+        // the variant storage is reused by the two level table, so take the old table out first
+        auto single_level = std::move(std::get<SingleLevel>(_aggregated_method_variant));
+        _aggregated_method_variant.emplace<TwoLevel>(single_level);
     }
 };
 
 using AggregatedDataVariantsPtr = std::shared_ptr<AggregatedDataVariants>;
 
-// not support spill
+// When spilling is enabled and the memory limit is nearly reached, the groups are
+// partitioned by hash and written out to SpillStreams, and the hash table starts over.
+// At the end every partition is read back and merged on its own, a partition that still
+// does not fit is partitioned again by another seed of the hash.
 class AggregationNode : public ::doris::ExecNode {
+    friend class VAggregationNodeTest;
+
 public:
     using Sizes = std::vector<size_t>;
 
@@ -124,12 +521,21 @@ private:
     TupleDescriptor* _output_tuple_desc;
 
     bool _needs_finalize;
+    // A streaming pre-aggregation stops growing its hash table once it does not reduce
+    // the input enough, and passes the remaining rows through as serialized states.
+    bool _is_streaming_preagg;
+    bool _child_eos = false;
+    int64_t _num_input_rows = 0;
+    int64_t _num_passthrough_rows = 0;
     std::unique_ptr<MemPool> _mem_pool;
 
     // TODO:
     // AggregateDataPtr _single_data_ptr;
     std::unique_ptr<Block> _single_output_block;
 
+    /// The size of each key for fixed keys, the null bitmap excluded.
+    Sizes _probe_key_sz;
+
     size_t _align_aggregate_states = 1;
     /// The offset to the n-th aggregate function in a row of aggregate functions.
     Sizes _offsets_of_aggregate_states;
@@ -137,17 +543,78 @@ private:
     size_t _total_size_of_aggregate_states = 0;
 
     AggregatedDataVariants _agg_data;
-    // TODO:
-    // add tracker here
-    Arena _agg_arena_pool;
+
+    RuntimeProfile::Counter* _streaming_agg_timer = nullptr;
+    RuntimeProfile::Counter* _passthrough_rows_counter = nullptr;
+    RuntimeProfile::Counter* _preagg_streaming_ht_min_reduction = nullptr;
+    std::unique_ptr<Arena> _agg_arena_pool;
+    // memory of the hash table and the arena, consumed from mem_tracker()
+    int64_t _mem_usage_record = 0;
+
+    static constexpr size_t SPILL_PARTITION_FANOUT = 16;
+    // The partitions of this level are merged in memory whatever their size, the groups of
+    // a partition only go on spreading if their hashes differ.
+    static constexpr int MAX_SPILL_LEVEL = 8;
+    // The columns of a partition are written out once they reach this size while spilling.
+    static constexpr size_t SPILL_FLUSH_BYTES = 1024 * 1024;
+
+    struct SpilledPartition {
+        std::unique_ptr<SpillStream> stream;
+        int level;
+    };
+
+    bool _enable_spill = false;
+    // whether the output is read from the spilled partitions
+    bool _spilled = false;
+    size_t _spill_flush_bytes = SPILL_FLUSH_BYTES;
+    // the partitions the hash table is spilled to, of level _spill_level
+    std::vector<std::unique_ptr<SpillStream>> _spill_partitions;
+    int _spill_level = 0;
+    // the spilled partitions left to merge and output, the next one first
+    std::deque<SpilledPartition> _spilled_partitions;
+
+    RuntimeProfile::Counter* _spill_timer = nullptr;
+    RuntimeProfile::Counter* _spilled_bytes_counter = nullptr;
+    RuntimeProfile::Counter* _spill_count_counter = nullptr;
+    RuntimeProfile::Counter* _max_spill_level_counter = nullptr;
 
 private:
+    /// Choose the hash table layout according to the types of the group by keys.
+    void _init_hash_method(std::vector<VExprContext*>& probe_exprs);
+    /// Whether the single string key is a slot of the OLAP scan below which is read by its
+    /// dictionary codes, see ColumnLowCardinality. The aggregate functions must not read it.
+    bool _request_low_cardinality_key();
+
     Status _create_agg_status(AggregateDataPtr data);
+    void _destroy_agg_status(AggregateDataPtr data);
     Status _get_without_key_result(RuntimeState* state, Block* block, bool* eos);
     Status _execute_without_key(Block* block);
 
     Status _execute_with_serialized_key(Block* block);
+    void _emplace_into_hash_table(AggregateDataPtr* places, ColumnRawPtrs& key_columns,
+                                  size_t rows);
+    // The columns of the keys of the hash table, of the types of the probe exprs the hash
+    // method was chosen by, a key slot of the output may be nullable while its expr is not.
+    MutableColumns _create_key_columns();
     Status _get_with_serialized_key_result(RuntimeState* state, Block* block, bool* eos);
+
+    Status _get_next_streaming(RuntimeState* state, Block* block, bool* eos);
+    bool _should_expand_preagg_hash_tables();
+    // Aggregate every row of in_block into its own state and output it serialized.
+    Status _streaming_passthrough(Block* in_block, Block* out_block);
+
+    void _update_mem_usage();
+    // Drop all the groups and their states, the hash table starts empty again.
+    void _reset_hash_table();
+    // The spill partition of a group of the given level by the hash of its key in the hash
+    // table.
+    static size_t _spill_partition(size_t hash, int level);
+    // Write the groups of the hash table to the spill partitions as keys and serialized states.
+    Status _spill_hash_table(RuntimeState* state);
+    // Queue the non-empty spill partitions to be merged before the ones already spilled.
+    void _queue_spill_partitions();
+    Status _merge_spilled_block(Block* block);
+    Status _get_next_spilled(RuntimeState* state, Block* block, bool* eos);
 };
 } // namespace vectorized
 } // namespace doris
@@ -0,0 +1,158 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/exchange_node.h"
+
+#include <algorithm>
+
+#include "common/config.h"
+#include "gen_cpp/PlanNodes_types.h"
+#include "runtime/exec_env.h"
+#include "runtime/runtime_state.h"
+#include "util/runtime_profile.h"
+#include "vec/exprs/vexpr.h"
+#include "vec/exprs/vexpr_context.h"
+#include "vec/runtime/data_stream_mgr.h"
+#include "vec/runtime/data_stream_recvr.h"
+
+namespace doris::vectorized {
+
+VExchangeNode::VExchangeNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs)
+        : ExecNode(pool, tnode, descs),
+          _num_senders(0),
+          _input_row_desc(descs, tnode.exchange_node.input_row_tuples,
+                          std::vector<bool>(tnode.nullable_tuples.begin(),
+                                            tnode.nullable_tuples.begin() +
+                                                    tnode.exchange_node.input_row_tuples.size())),
+          _is_merging(tnode.exchange_node.__isset.sort_info),
+          _offset(tnode.exchange_node.__isset.offset ? tnode.exchange_node.offset : 0),
+          _num_rows_skipped(0) {
+    DCHECK_GE(_offset, 0);
+    DCHECK(_is_merging || (_offset == 0));
+}
+
+Status VExchangeNode::init(const TPlanNode& tnode, RuntimeState* state) {
+    RETURN_IF_ERROR(ExecNode::init(tnode, state));
+    if (!_is_merging) {
+        return Status::OK();
+    }
+
+    const TSortInfo& sort_info = tnode.exchange_node.sort_info;
+    RETURN_IF_ERROR(
+            VExpr::create_expr_trees(_pool, sort_info.ordering_exprs, &_ordering_expr_ctxs));
+    _is_asc_order = sort_info.is_asc_order;
+    _nulls_first = sort_info.nulls_first;
+    return Status::OK();
+}
+
+Status VExchangeNode::prepare(RuntimeState* state) {
+    RETURN_IF_ERROR(ExecNode::prepare(state));
+    DCHECK_GT(_num_senders, 0);
+    _sub_plan_query_statistics_recvr.reset(new QueryStatisticsRecvr());
+    _stream_recvr = state->exec_env()->vstream_mgr()->create_recvr(
+            state, _input_row_desc, state->fragment_instance_id(), _id, _num_senders,
+            config::exchg_node_buffer_size_bytes, _runtime_profile.get(), _is_merging,
+            _sub_plan_query_statistics_recvr);
+    if (_is_merging) {
+        RETURN_IF_ERROR(
+                VExpr::prepare(_ordering_expr_ctxs, state, _row_descriptor, expr_mem_tracker()));
+    }
+    return Status::OK();
+}
+
+Status VExchangeNode::open(RuntimeState* state) {
+    SCOPED_TIMER(_runtime_profile->total_time_counter());
+    RETURN_IF_ERROR(ExecNode::open(state));
+    if (_is_merging) {
+        RETURN_IF_ERROR(VExpr::open(_ordering_expr_ctxs, state));
+        // the merger waits for the first block of every sender
+        RETURN_IF_ERROR(_stream_recvr->create_merger(_ordering_expr_ctxs, _is_asc_order,
+                                                     _nulls_first, state->batch_size()));
+    }
+    return Status::OK();
+}
+
+Status VExchangeNode::get_next(RuntimeState* state, RowBatch* row_batch, bool* eos) {
+    return Status::NotSupported("Not Implemented VExchangeNode::get_next scalar");
+}
+
+Status VExchangeNode::get_next(RuntimeState* state, Block* output_block, bool* eos) {
+    SCOPED_TIMER(_runtime_profile->total_time_counter());
+    RETURN_IF_CANCELLED(state);
+    output_block->clear();
+
+    if (reached_limit()) {
+        *eos = true;
+        return Status::OK();
+    }
+
+    if (_is_merging) {
+        RETURN_IF_ERROR(_stream_recvr->get_next_merging(output_block, eos));
+        if (_num_rows_skipped < _offset) {
+            size_t rows = output_block->rows();
+            size_t skip = std::min<size_t>(_offset - _num_rows_skipped, rows);
+            for (size_t i = 0; i < output_block->columns(); ++i) {
+                auto& column = output_block->getByPosition(i).column;
+                column = column->cut(skip, rows - skip);
+            }
+            _num_rows_skipped += skip;
+        }
+    } else {
+        Block* next_block = nullptr;
+        RETURN_IF_ERROR(_stream_recvr->get_next(&next_block));
+        if (next_block == nullptr) {
+            *eos = true;
+        } else {
+            output_block->swap(*next_block);
+            *eos = false;
+        }
+    }
+
+    _num_rows_returned += output_block->rows();
+    if (reached_limit()) {
+        size_t rows = output_block->rows() - (_num_rows_returned - _limit);
+        for (size_t i = 0; i < output_block->columns(); ++i) {
+            auto& column = output_block->getByPosition(i).column;
+            column = column->cut(0, rows);
+        }
+        _num_rows_returned = _limit;
+        *eos = true;
+    }
+    COUNTER_SET(_rows_returned_counter, _num_rows_returned);
+    return Status::OK();
+}
+
+Status VExchangeNode::collect_query_statistics(QueryStatistics* statistics) {
+    RETURN_IF_ERROR(ExecNode::collect_query_statistics(statistics));
+    statistics->merge(_sub_plan_query_statistics_recvr.get());
+    return Status::OK();
+}
+
+Status VExchangeNode::close(RuntimeState* state) {
+    if (is_closed()) {
+        return Status::OK();
+    }
+    if (_is_merging) {
+        VExpr::close(_ordering_expr_ctxs, state);
+    }
+    if (_stream_recvr != nullptr) {
+        _stream_recvr->close();
+    }
+    return ExecNode::close(state);
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,81 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "exec/exec_node.h"
+#include "runtime/descriptors.h"
+#include "runtime/query_statistics.h"
+
+namespace doris {
+namespace vectorized {
+class VDataStreamRecvr;
+class VExprContext;
+
+// Vectorized version of ExchangeNode, which returns the Blocks sent by the
+// VDataStreamSenders of the child fragment. If the node has a sort info, the sorted
+// streams of the senders are merged by the receiver.
+class VExchangeNode : public ExecNode {
+public:
+    VExchangeNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs);
+    virtual ~VExchangeNode() {}
+
+    virtual Status init(const TPlanNode& tnode, RuntimeState* state = nullptr);
+    virtual Status prepare(RuntimeState* state);
+    virtual Status open(RuntimeState* state);
+    virtual Status get_next(RuntimeState* state, RowBatch* row_batch, bool* eos);
+    virtual Status get_next(RuntimeState* state, Block* block, bool* eos);
+    Status collect_query_statistics(QueryStatistics* statistics) override;
+    virtual Status close(RuntimeState* state);
+
+    // the number of senders needs to be set after the c'tor, because it's not
+    // recorded in TPlanNode, and before calling prepare()
+    void set_num_senders(int num_senders) { _num_senders = num_senders; }
+
+private:
+    int _num_senders; // needed for _stream_recvr construction
+
+    // created in prepare() and owned by the RuntimeState
+    std::shared_ptr<VDataStreamRecvr> _stream_recvr;
+
+    // our input rows are a prefix of the rows we produce
+    RowDescriptor _input_row_desc;
+
+    // True if this is a merging exchange node.
+    bool _is_merging;
+
+    // Sort expressions and parameters passed to the merging receiver.
+    std::vector<VExprContext*> _ordering_expr_ctxs;
+    std::vector<bool> _is_asc_order;
+    std::vector<bool> _nulls_first;
+
+    // Offset specifying number of rows to skip.
+    int64_t _offset;
+
+    // Number of rows skipped so far.
+    int64_t _num_rows_skipped;
+
+    // Shared with the receiver, which may add the statistics of the senders after this
+    // node is destructed.
+    std::shared_ptr<QueryStatisticsRecvr> _sub_plan_query_statistics_recvr;
+};
+
+} // namespace vectorized
+} // namespace doris
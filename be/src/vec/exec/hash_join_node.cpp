@@ -0,0 +1,783 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/hash_join_node.h"
+
+#include <limits>
+
+#include "common/config.h"
+#include "exprs/runtime_filter.h"
+#include "gen_cpp/PlanNodes_types.h"
+#include "runtime/exec_env.h"
+#include "runtime/mem_tracker.h"
+#include "runtime/runtime_state.h"
+#include "service/brpc.h"
+#include "util/brpc_stub_cache.h"
+#include "util/ref_count_closure.h"
+#include "util/runtime_profile.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_common.h"
+#include "vec/common/assert_cast.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/exprs/vexpr.h"
+#include "vec/exprs/vexpr_context.h"
+#include "vec/exprs/vslot_ref.h"
+
+namespace doris::vectorized {
+
+VHashJoinNode::VHashJoinNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs)
+        : ExecNode(pool, tnode, descs),
+          _join_op(tnode.hash_join_node.join_op),
+          _is_push_down(tnode.hash_join_node.is_push_down),
+          _runtime_filter_targets(tnode.hash_join_node.runtime_filter_targets),
+          _num_runtime_filter_senders(tnode.hash_join_node.num_runtime_filter_senders),
+          _build_indexes(ColumnUInt32::create()) {
+    _match_all_probe =
+            (_join_op == TJoinOp::LEFT_OUTER_JOIN || _join_op == TJoinOp::FULL_OUTER_JOIN);
+    _match_all_build =
+            (_join_op == TJoinOp::RIGHT_OUTER_JOIN || _join_op == TJoinOp::FULL_OUTER_JOIN);
+    _build_unique = _join_op == TJoinOp::LEFT_ANTI_JOIN || _join_op == TJoinOp::LEFT_SEMI_JOIN ||
+                    _join_op == TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN;
+}
+
+VHashJoinNode::~VHashJoinNode() {}
+
+Status VHashJoinNode::init(const TPlanNode& tnode, RuntimeState* state) {
+    RETURN_IF_ERROR(ExecNode::init(tnode, state));
+    DCHECK(tnode.__isset.hash_join_node);
+    const std::vector<TEqJoinCondition>& eq_join_conjuncts = tnode.hash_join_node.eq_join_conjuncts;
+
+    for (const auto& eq_join_conjunct : eq_join_conjuncts) {
+        VExprContext* ctx = nullptr;
+        RETURN_IF_ERROR(VExpr::create_expr_tree(_pool, eq_join_conjunct.left, &ctx));
+        _probe_expr_ctxs.push_back(ctx);
+        RETURN_IF_ERROR(VExpr::create_expr_tree(_pool, eq_join_conjunct.right, &ctx));
+        _build_expr_ctxs.push_back(ctx);
+        _is_null_safe_eq_join.push_back(eq_join_conjunct.__isset.opcode &&
+                                        eq_join_conjunct.opcode == TExprOpcode::EQ_FOR_NULL);
+    }
+
+    RETURN_IF_ERROR(VExpr::create_expr_trees(_pool, tnode.hash_join_node.other_join_conjuncts,
+                                             &_other_join_conjunct_ctxs));
+    if (!_other_join_conjunct_ctxs.empty()) {
+        // If LEFT SEMI JOIN/LEFT ANTI JOIN with not equal predicate,
+        // build table should not be deduplicated.
+        _build_unique = false;
+    }
+
+    return Status::OK();
+}
+
+Status VHashJoinNode::prepare(RuntimeState* state) {
+    RETURN_IF_ERROR(ExecNode::prepare(state));
+    SCOPED_TIMER(_runtime_profile->total_time_counter());
+
+    _build_timer = ADD_TIMER(runtime_profile(), "BuildTime");
+    _probe_timer = ADD_TIMER(runtime_profile(), "ProbeTime");
+    _build_rows_counter = ADD_COUNTER(runtime_profile(), "BuildRows", TUnit::UNIT);
+    _probe_rows_counter = ADD_COUNTER(runtime_profile(), "ProbeRows", TUnit::UNIT);
+
+    // build and probe exprs are evaluated in the context of the rows produced by our
+    // right and left children, respectively
+    RETURN_IF_ERROR(
+            VExpr::prepare(_build_expr_ctxs, state, child(1)->row_desc(), expr_mem_tracker()));
+    RETURN_IF_ERROR(
+            VExpr::prepare(_probe_expr_ctxs, state, child(0)->row_desc(), expr_mem_tracker()));
+    // _other_join_conjuncts are evaluated in the context of the rows produced by this node
+    RETURN_IF_ERROR(VExpr::prepare(_other_join_conjunct_ctxs, state, _row_descriptor,
+                                   expr_mem_tracker()));
+
+    for (const auto tuple_desc : child(0)->row_desc().tuple_descriptors()) {
+        _probe_column_num += tuple_desc->slots().size();
+    }
+    for (const auto tuple_desc : child(1)->row_desc().tuple_descriptors()) {
+        _build_column_num += tuple_desc->slots().size();
+    }
+
+    _init_hash_method();
+    return Status::OK();
+}
+
+void VHashJoinNode::_init_hash_method() {
+    bool has_null_safe_key = std::find(_is_null_safe_eq_join.begin(), _is_null_safe_eq_join.end(),
+                                       true) != _is_null_safe_eq_join.end();
+    // the keys of both sides are looked up with the same method, so they must be
+    // represented the same way
+    bool same_key_types = true;
+    for (int i = 0; i < _build_expr_ctxs.size(); ++i) {
+        auto build_type = removeNullable(_build_expr_ctxs[i]->root()->data_type());
+        auto probe_type = removeNullable(_probe_expr_ctxs[i]->root()->data_type());
+        same_key_types &= build_type->equals(*probe_type);
+    }
+    if (has_null_safe_key || !same_key_types) {
+        _hash_table_variants.emplace<SerializedHashTableContext>();
+        return;
+    }
+
+    if (_build_expr_ctxs.size() == 1) {
+        switch (_build_expr_ctxs[0]->root()->result_type()) {
+        case TYPE_TINYINT:
+        case TYPE_BOOLEAN:
+            _hash_table_variants.emplace<I8HashTableContext>();
+            return;
+        case TYPE_SMALLINT:
+            _hash_table_variants.emplace<I16HashTableContext>();
+            return;
+        case TYPE_INT:
+        case TYPE_FLOAT:
+            _hash_table_variants.emplace<I32HashTableContext>();
+            return;
+        case TYPE_BIGINT:
+        case TYPE_DOUBLE:
+            _hash_table_variants.emplace<I64HashTableContext>();
+            return;
+        case TYPE_LARGEINT:
+        case TYPE_DATE:
+        case TYPE_DATETIME:
+        case TYPE_DECIMALV2:
+            _hash_table_variants.emplace<I128HashTableContext>();
+            return;
+        case TYPE_CHAR:
+        case TYPE_VARCHAR:
+            _hash_table_variants.emplace<StringHashTableContext>();
+            return;
+        default:
+            break;
+        }
+    }
+
+    // Several keys: pack them into a single fixed size key if all of them have
+    // fixed size, otherwise serialize them.
+    size_t key_byte_size = 0;
+    _key_sizes.resize(_build_expr_ctxs.size());
+    for (int i = 0; i < _build_expr_ctxs.size(); ++i) {
+        const auto nested_type = removeNullable(_build_expr_ctxs[i]->root()->data_type());
+        if (!nested_type->isValueUnambiguouslyRepresentedInFixedSizeContiguousMemoryRegion()) {
+            _key_sizes.clear();
+            _hash_table_variants.emplace<SerializedHashTableContext>();
+            return;
+        }
+        _key_sizes[i] = nested_type->getSizeOfValueInMemory();
+        key_byte_size += _key_sizes[i];
+    }
+
+    if (key_byte_size <= sizeof(UInt64)) {
+        _hash_table_variants.emplace<I64FixedKeyHashTableContext>();
+    } else if (key_byte_size <= sizeof(UInt128)) {
+        _hash_table_variants.emplace<I128FixedKeyHashTableContext>();
+    } else if (key_byte_size <= sizeof(UInt256)) {
+        _hash_table_variants.emplace<I256FixedKeyHashTableContext>();
+    } else {
+        _key_sizes.clear();
+        _hash_table_variants.emplace<SerializedHashTableContext>();
+    }
+}
+
+Status VHashJoinNode::open(RuntimeState* state) {
+    RETURN_IF_ERROR(ExecNode::open(state));
+    SCOPED_TIMER(_runtime_profile->total_time_counter());
+    RETURN_IF_CANCELLED(state);
+
+    RETURN_IF_ERROR(VExpr::open(_build_expr_ctxs, state));
+    RETURN_IF_ERROR(VExpr::open(_probe_expr_ctxs, state));
+    RETURN_IF_ERROR(VExpr::open(_other_join_conjunct_ctxs, state));
+
+    RETURN_IF_ERROR(_build_hash_table(state));
+    if (_is_push_down && !_runtime_filters.empty()) {
+        // the filters not accepted by any scan node are dropped
+        std::vector<RuntimeFilter*> filters = _runtime_filters;
+        child(0)->push_down_runtime_filters(state, &filters);
+    }
+    if (!_runtime_filter_targets.empty()) {
+        _send_runtime_filters(state);
+    }
+    RETURN_IF_ERROR(child(0)->open(state));
+    return Status::OK();
+}
+
+Status VHashJoinNode::_build_hash_table(RuntimeState* state) {
+    SCOPED_TIMER(_build_timer);
+    RETURN_IF_ERROR(child(1)->open(state));
+
+    // merge all the blocks of the build side, so that a build row is identified by
+    // its row number in the hash table
+    Block header;
+    for (const auto tuple_desc : child(1)->row_desc().tuple_descriptors()) {
+        for (const auto slot_desc : tuple_desc->slots()) {
+            header.insert(ColumnWithTypeAndName(slot_desc->get_empty_mutable_column(),
+                                                slot_desc->get_data_type_ptr(),
+                                                slot_desc->col_name()));
+        }
+    }
+    MutableColumns columns = header.cloneEmptyColumns();
+
+    bool eos = false;
+    while (!eos) {
+        Block block;
+        RETURN_IF_CANCELLED(state);
+        RETURN_IF_ERROR(child(1)->get_next(state, &block, &eos));
+        size_t rows = block.rows();
+        if (rows == 0) {
+            continue;
+        }
+        int64_t bytes = 0;
+        for (size_t i = 0; i < _build_column_num; ++i) {
+            auto column = block.getByPosition(i).column->convertToFullColumnIfConst();
+            bytes -= columns[i]->allocatedBytes();
+            columns[i]->insertRangeFrom(*column, 0, rows);
+            bytes += columns[i]->allocatedBytes();
+        }
+        mem_tracker()->Consume(bytes);
+        _mem_used += bytes;
+        RETURN_IF_LIMIT_EXCEEDED(state, "Hash join, while constructing the hash table.");
+    }
+    _build_block = header.cloneWithColumns(std::move(columns));
+    size_t build_rows = _build_block.rows();
+    if (build_rows > std::numeric_limits<uint32_t>::max()) {
+        return Status::InternalError("Hash join, too many rows in the build side.");
+    }
+    COUNTER_UPDATE(_build_rows_counter, build_rows);
+    if (_match_all_build || _join_op == TJoinOp::RIGHT_SEMI_JOIN ||
+        _join_op == TJoinOp::RIGHT_ANTI_JOIN) {
+        _build_visited.resize(build_rows, 0);
+    }
+    if (build_rows == 0) {
+        return Status::OK();
+    }
+
+    ColumnRawPtrs key_columns(_build_expr_ctxs.size());
+    ColumnUInt8::MutablePtr null_map;
+    RETURN_IF_ERROR(_extract_join_columns(_build_block, _build_expr_ctxs, key_columns, null_map));
+    RETURN_IF_ERROR(_build_runtime_filters(key_columns, null_map.get()));
+
+    std::visit(
+            [&](auto&& ctx) {
+                _insert_build_rows(ctx, key_columns, null_map.get());
+                int64_t bytes = ctx.hash_table.getBufferSizeInBytes() + _arena.size();
+                mem_tracker()->Consume(bytes);
+                _mem_used += bytes;
+            },
+            _hash_table_variants);
+    RETURN_IF_LIMIT_EXCEEDED(state, "Hash join, while constructing the hash table.");
+    return Status::OK();
+}
+
+Status VHashJoinNode::_build_runtime_filters(const ColumnRawPtrs& key_columns,
+                                             const ColumnUInt8* null_map) {
+    // only these joins drop the probe rows without match
+    if ((!_is_push_down && _runtime_filter_targets.empty()) ||
+        (_join_op != TJoinOp::INNER_JOIN && _join_op != TJoinOp::LEFT_SEMI_JOIN &&
+         _join_op != TJoinOp::RIGHT_OUTER_JOIN && _join_op != TJoinOp::RIGHT_SEMI_JOIN)) {
+        return Status::OK();
+    }
+
+    size_t rows = _build_block.rows();
+    for (int i = 0; i < _probe_expr_ctxs.size(); ++i) {
+        // the nulls of the probe side match the ones of the build side with <=>
+        if (_is_null_safe_eq_join[i]) {
+            continue;
+        }
+        VExpr* probe_expr = _probe_expr_ctxs[i]->root();
+        PrimitiveType type = probe_expr->result_type();
+        if (probe_expr->node_type() != TExprNodeType::SLOT_REF ||
+            type != _build_expr_ctxs[i]->root()->result_type() ||
+            !RuntimeFilter::is_supported_type(type)) {
+            continue;
+        }
+
+        auto filter = _pool->add(new RuntimeFilter(
+                static_cast<VSlotRef*>(probe_expr)->slot_id(), type, rows));
+        RETURN_IF_ERROR(filter->init());
+        const IColumn* column = key_columns[i];
+        bool is_string = type == TYPE_CHAR || type == TYPE_VARCHAR;
+        for (size_t row = 0; row < rows; ++row) {
+            if (null_map != nullptr && null_map->getData()[row]) {
+                continue;
+            }
+            StringRef value = column->getDataAt(row);
+            if (is_string) {
+                StringValue string_value(const_cast<char*>(value.data), value.size);
+                filter->insert(&string_value);
+            } else {
+                filter->insert(value.data);
+            }
+        }
+        // all the build keys are null
+        if (filter->empty()) {
+            continue;
+        }
+        mem_tracker()->Consume(filter->allocated_bytes());
+        _mem_used += filter->allocated_bytes();
+        _runtime_filters.push_back(filter);
+    }
+    return Status::OK();
+}
+
+void VHashJoinNode::_send_runtime_filters(RuntimeState* state) {
+    // an instance whose build side is empty sends no filter, but is still counted
+    PApplyRuntimeFiltersRequest request;
+    request.set_node_id(id());
+    request.set_num_senders(_num_runtime_filter_senders);
+    for (auto filter : _runtime_filters) {
+        filter->to_protobuf(request.add_filters());
+    }
+
+    std::vector<RefCountClosure<PApplyRuntimeFiltersResult>*> closures;
+    for (const auto& target : _runtime_filter_targets) {
+        PBackendService_Stub* stub = state->exec_env()->brpc_stub_cache()->get_stub(target.address);
+        if (stub == nullptr) {
+            LOG(WARNING) << "fail to get the brpc stub of " << target.address.hostname << ":"
+                         << target.address.port << " to send the runtime filters";
+            continue;
+        }
+        request.mutable_finst_id()->set_hi(target.fragment_instance_id.hi);
+        request.mutable_finst_id()->set_lo(target.fragment_instance_id.lo);
+
+        auto closure = new RefCountClosure<PApplyRuntimeFiltersResult>();
+        closure->ref();
+        // This ref is for RPC's reference
+        closure->ref();
+        closure->cntl.set_timeout_ms(config::runtime_filter_rpc_timeout_ms);
+        // the request is serialized by the call, it is reused for the next target
+        stub->apply_runtime_filters(&closure->cntl, &request, &closure->result, closure);
+        closures.push_back(closure);
+    }
+
+    // the filters only save work, the query goes on without them
+    for (auto closure : closures) {
+        closure->join();
+        if (closure->cntl.Failed()) {
+            LOG(WARNING) << "fail to send the runtime filters, error="
+                         << berror(closure->cntl.ErrorCode())
+                         << ", error_text=" << closure->cntl.ErrorText();
+        } else {
+            Status status(closure->result.status());
+            if (!status.ok()) {
+                LOG(WARNING) << "fail to apply the runtime filters, errmsg="
+                             << status.get_error_msg();
+            }
+        }
+        if (closure->unref()) {
+            delete closure;
+        }
+    }
+}
+
+Status VHashJoinNode::_extract_join_columns(Block& block, const std::vector<VExprContext*>& exprs,
+                                            ColumnRawPtrs& key_columns,
+                                            ColumnUInt8::MutablePtr& null_map) {
+    for (size_t i = 0; i < exprs.size(); ++i) {
+        int result_column_id = -1;
+        RETURN_IF_ERROR(exprs[i]->execute(&block, &result_column_id));
+        auto& column_with_type = block.getByPosition(result_column_id);
+        column_with_type.column = column_with_type.column->convertToFullColumnIfConst();
+
+        if (_is_null_safe_eq_join[i]) {
+            // null is a regular value of the key, both sides serialize it the same way
+            if (!column_with_type.column->isNullable()) {
+                block.insert({makeNullable(column_with_type.column),
+                              makeNullable(column_with_type.type), column_with_type.name});
+                key_columns[i] = block.getByPosition(block.columns() - 1).column.get();
+            } else {
+                key_columns[i] = column_with_type.column.get();
+            }
+        } else if (auto* nullable = checkAndGetColumn<ColumnNullable>(*column_with_type.column)) {
+            // a null key never matches
+            if (null_map == nullptr) {
+                null_map = ColumnUInt8::create(block.rows(), 0);
+            }
+            auto& null_map_data = null_map->getData();
+            const auto& key_null_map = nullable->getNullMapData();
+            for (size_t j = 0; j < null_map_data.size(); ++j) {
+                null_map_data[j] |= key_null_map[j];
+            }
+            key_columns[i] = &nullable->getNestedColumn();
+        } else {
+            key_columns[i] = column_with_type.column.get();
+        }
+    }
+    return Status::OK();
+}
+
+template <typename HashTableContext>
+void VHashJoinNode::_insert_build_rows(HashTableContext& ctx, const ColumnRawPtrs& key_columns,
+                                       const ColumnUInt8* null_map) {
+    using KeyGetter = typename HashTableContext::State;
+    KeyGetter key_getter(key_columns, _key_sizes, nullptr);
+
+    size_t rows = _build_block.rows();
+    for (size_t i = 0; i < rows; ++i) {
+        if (null_map != nullptr && null_map->getData()[i]) {
+            _has_null_in_build_side = true;
+            continue;
+        }
+        auto emplace_result = key_getter.emplaceKey(ctx.hash_table, i, _arena);
+        if (emplace_result.isInserted()) {
+            new (&emplace_result.getMapped()) RowRefList(i);
+        } else if (!_build_unique) {
+            emplace_result.getMapped().insert(i, _arena);
+        }
+    }
+}
+
+template <typename HashTableContext>
+void VHashJoinNode::_find_matched_rows(HashTableContext& ctx, const ColumnRawPtrs& key_columns,
+                                       const ColumnUInt8* null_map, size_t probe_rows) {
+    using KeyGetter = typename HashTableContext::State;
+    KeyGetter key_getter(key_columns, _key_sizes, nullptr);
+    // the serialized keys of the probe rows are only needed during the lookup
+    Arena probe_arena;
+
+    auto& build_indexes = _build_indexes->getData();
+    build_indexes.clear();
+    build_indexes.reserve(probe_rows);
+    _offsets.resize(probe_rows);
+
+    for (size_t i = 0; i < probe_rows; ++i) {
+        if (null_map == nullptr || !null_map->getData()[i]) {
+            auto find_result = key_getter.findKey(ctx.hash_table, i, probe_arena);
+            if (find_result.isFound()) {
+                for (auto* it = &find_result.getMapped(); it != nullptr; it = it->next) {
+                    build_indexes.push_back(it->row_num);
+                }
+            }
+        }
+        _offsets[i] = build_indexes.size();
+    }
+}
+
+Status VHashJoinNode::_process_probe_block(Block* output_block) {
+    size_t probe_rows = _probe_block.rows();
+    ColumnRawPtrs key_columns(_probe_expr_ctxs.size());
+    ColumnUInt8::MutablePtr null_map;
+    RETURN_IF_ERROR(_extract_join_columns(_probe_block, _probe_expr_ctxs, key_columns, null_map));
+
+    std::visit(
+            [&](auto&& ctx) { _find_matched_rows(ctx, key_columns, null_map.get(), probe_rows); },
+            _hash_table_variants);
+    _null_build_rows.clear();
+
+    Block pairs;
+    bool has_other_join_conjuncts = !_other_join_conjunct_ctxs.empty();
+    if (has_other_join_conjuncts) {
+        pairs = _build_pairs_block(_probe_block);
+        RETURN_IF_ERROR(_filter_other_join_conjuncts(&pairs, probe_rows));
+    }
+
+    _probe_matched.resize(probe_rows);
+    size_t matched_rows = 0;
+    IColumn::Offset prev_offset = 0;
+    for (size_t i = 0; i < probe_rows; ++i) {
+        _probe_matched[i] = _offsets[i] != prev_offset;
+        matched_rows += _probe_matched[i];
+        prev_offset = _offsets[i];
+    }
+    if (!_build_visited.empty()) {
+        for (auto row : _build_indexes->getData()) {
+            _build_visited[row] = 1;
+        }
+    }
+
+    switch (_join_op) {
+    case TJoinOp::INNER_JOIN:
+    case TJoinOp::RIGHT_OUTER_JOIN:
+        *output_block =
+                has_other_join_conjuncts ? std::move(pairs) : _build_pairs_block(_probe_block);
+        break;
+    case TJoinOp::LEFT_OUTER_JOIN:
+    case TJoinOp::FULL_OUTER_JOIN:
+        if (matched_rows != probe_rows) {
+            _add_unmatched_probe_rows(probe_rows);
+            *output_block = _build_pairs_block(_probe_block);
+        } else {
+            *output_block =
+                    has_other_join_conjuncts ? std::move(pairs) : _build_pairs_block(_probe_block);
+        }
+        break;
+    case TJoinOp::LEFT_SEMI_JOIN:
+        if (matched_rows != 0) {
+            *output_block = _build_probe_rows_block(_probe_block, _probe_matched);
+        }
+        break;
+    case TJoinOp::LEFT_ANTI_JOIN:
+    case TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN: {
+        // NOT IN returns nothing once the subquery has a null, and a null probe key
+        // is not in a non-empty subquery
+        if (_join_op == TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN && _has_null_in_build_side) {
+            break;
+        }
+        bool exclude_null_keys = _join_op == TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN &&
+                                 null_map != nullptr && _build_block.rows() != 0;
+        IColumn::Filter filter(probe_rows);
+        for (size_t i = 0; i < probe_rows; ++i) {
+            filter[i] = !_probe_matched[i] && !(exclude_null_keys && null_map->getData()[i]);
+        }
+        *output_block = _build_probe_rows_block(_probe_block, filter);
+        break;
+    }
+    case TJoinOp::RIGHT_SEMI_JOIN:
+    case TJoinOp::RIGHT_ANTI_JOIN:
+        // the build rows are returned once all the probe rows are seen
+        break;
+    default:
+        return Status::NotSupported("Not supported join type " + std::to_string(_join_op) +
+                                    " in VHashJoinNode");
+    }
+    return Status::OK();
+}
+
+Status VHashJoinNode::_filter_other_join_conjuncts(Block* block, size_t probe_rows) {
+    IColumn::Filter filter(block->rows(), 1);
+    RETURN_IF_ERROR(_execute_conjuncts(_other_join_conjunct_ctxs, block, &filter));
+    Block::filter_block(block, filter, _probe_column_num + _build_column_num);
+
+    auto& build_indexes = _build_indexes->getData();
+    size_t pos = 0;
+    IColumn::Offset prev_offset = 0;
+    for (size_t i = 0; i < probe_rows; ++i) {
+        for (size_t j = prev_offset; j < _offsets[i]; ++j) {
+            if (filter[j]) {
+                build_indexes[pos++] = build_indexes[j];
+            }
+        }
+        prev_offset = _offsets[i];
+        _offsets[i] = pos;
+    }
+    build_indexes.resize(pos);
+    return Status::OK();
+}
+
+void VHashJoinNode::_add_unmatched_probe_rows(size_t probe_rows) {
+    auto& build_indexes = _build_indexes->getData();
+    ColumnUInt32::Container indexes;
+    indexes.reserve(build_indexes.size() + probe_rows);
+    _null_build_rows.clear();
+    _null_build_rows.reserve(build_indexes.size() + probe_rows);
+
+    IColumn::Offset prev_offset = 0;
+    for (size_t i = 0; i < probe_rows; ++i) {
+        if (_probe_matched[i]) {
+            for (size_t j = prev_offset; j < _offsets[i]; ++j) {
+                indexes.push_back(build_indexes[j]);
+                _null_build_rows.push_back(0);
+            }
+        } else {
+            // any build row does, its columns are set to null
+            indexes.push_back(0);
+            _null_build_rows.push_back(1);
+        }
+        prev_offset = _offsets[i];
+        _offsets[i] = indexes.size();
+    }
+    build_indexes.swap(indexes);
+}
+
+Block VHashJoinNode::_build_pairs_block(const Block& probe_block) {
+    Block block;
+    size_t rows = _build_indexes->size();
+    for (size_t i = 0; i < _probe_column_num; ++i) {
+        const auto& column = probe_block.getByPosition(i);
+        auto replicated = column.column->replicate(_offsets);
+        if (_match_all_build) {
+            block.insert({makeNullable(replicated), makeNullable(column.type), column.name});
+        } else {
+            block.insert({std::move(replicated), column.type, column.name});
+        }
+    }
+    for (size_t i = 0; i < _build_column_num; ++i) {
+        const auto& column = _build_block.getByPosition(i);
+        if (_match_all_probe) {
+            block.insert({_gather_nullable_build_column(column.column, rows),
+                          makeNullable(column.type), column.name});
+        } else {
+            block.insert({column.column->index(*_build_indexes, 0), column.type, column.name});
+        }
+    }
+    return block;
+}
+
+ColumnPtr VHashJoinNode::_gather_nullable_build_column(const ColumnPtr& column, size_t rows) {
+    if (_build_block.rows() == 0) {
+        // all the probe rows are unmatched
+        auto result = makeNullable(column)->cloneEmpty();
+        result->insertManyDefaults(rows);
+        return result;
+    }
+
+    auto result = makeNullable(column->index(*_build_indexes, 0));
+    if (!_null_build_rows.empty()) {
+        auto mutable_result = (*std::move(result)).mutate();
+        auto& null_map = assert_cast<ColumnNullable&>(*mutable_result).getNullMapData();
+        for (size_t i = 0; i < rows; ++i) {
+            null_map[i] |= _null_build_rows[i];
+        }
+        result = std::move(mutable_result);
+    }
+    return result;
+}
+
+Block VHashJoinNode::_build_probe_rows_block(const Block& probe_block,
+                                             const IColumn::Filter& filter) {
+    Block block;
+    for (size_t i = 0; i < _probe_column_num; ++i) {
+        const auto& column = probe_block.getByPosition(i);
+        block.insert({column.column->filter(filter, -1), column.type, column.name});
+    }
+    _append_null_columns(&block, child(1)->row_desc(), block.rows());
+    return block;
+}
+
+bool VHashJoinNode::_need_output_build_rows() const {
+    return _match_all_build || _join_op == TJoinOp::RIGHT_SEMI_JOIN ||
+           _join_op == TJoinOp::RIGHT_ANTI_JOIN;
+}
+
+void VHashJoinNode::_output_build_rows(Block* output_block, size_t batch_size) {
+    uint8_t output_visited = _join_op == TJoinOp::RIGHT_SEMI_JOIN;
+    auto indexes = ColumnUInt32::create();
+    auto& indexes_data = indexes->getData();
+    size_t build_rows = _build_block.rows();
+    while (_build_output_pos < build_rows && indexes_data.size() < batch_size) {
+        if (_build_visited[_build_output_pos] == output_visited) {
+            indexes_data.push_back(_build_output_pos);
+        }
+        ++_build_output_pos;
+    }
+    if (indexes_data.empty()) {
+        return;
+    }
+
+    _append_null_columns(output_block, child(0)->row_desc(), indexes_data.size());
+    for (size_t i = 0; i < _build_column_num; ++i) {
+        const auto& column = _build_block.getByPosition(i);
+        auto result = column.column->index(*indexes, 0);
+        if (_match_all_probe) {
+            output_block->insert({makeNullable(result), makeNullable(column.type), column.name});
+        } else {
+            output_block->insert({std::move(result), column.type, column.name});
+        }
+    }
+}
+
+void VHashJoinNode::_append_null_columns(Block* block, const RowDescriptor& row_desc,
+                                         size_t rows) {
+    for (const auto tuple_desc : row_desc.tuple_descriptors()) {
+        for (const auto slot_desc : tuple_desc->slots()) {
+            auto type = makeNullable(slot_desc->get_data_type_ptr());
+            auto column = type->createColumn();
+            column->insertManyDefaults(rows);
+            block->insert({std::move(column), type, slot_desc->col_name()});
+        }
+    }
+}
+
+Status VHashJoinNode::_execute_conjuncts(const std::vector<VExprContext*>& ctxs, Block* block,
+                                         IColumn::Filter* filter) {
+    std::vector<int> result_column_ids;
+    RETURN_IF_ERROR(VExprContext::execute_exprs(ctxs, block, &result_column_ids));
+    for (int result_column_id : result_column_ids) {
+        auto column = block->getByPosition(result_column_id).column->convertToFullColumnIfConst();
+        if (auto* nullable = checkAndGetColumn<ColumnNullable>(*column)) {
+            const auto& null_map = nullable->getNullMapData();
+            const auto& data =
+                    assert_cast<const ColumnUInt8&>(nullable->getNestedColumn()).getData();
+            for (size_t i = 0; i < filter->size(); ++i) {
+                (*filter)[i] &= data[i] & !null_map[i];
+            }
+        } else {
+            const auto& data = assert_cast<const ColumnUInt8&>(*column).getData();
+            for (size_t i = 0; i < filter->size(); ++i) {
+                (*filter)[i] &= data[i];
+            }
+        }
+    }
+    return Status::OK();
+}
+
+Status VHashJoinNode::get_next(RuntimeState* state, RowBatch* row_batch, bool* eos) {
+    return Status::NotSupported("Not Implemented VHashJoinNode::get_next scalar");
+}
+
+Status VHashJoinNode::get_next(RuntimeState* state, Block* output_block, bool* eos) {
+    SCOPED_TIMER(_runtime_profile->total_time_counter());
+    RETURN_IF_CANCELLED(state);
+    output_block->clear();
+
+    if (reached_limit()) {
+        *eos = true;
+        return Status::OK();
+    }
+
+    while (output_block->rows() == 0) {
+        if (!_probe_eos) {
+            _probe_block.clear();
+            RETURN_IF_ERROR(child(0)->get_next(state, &_probe_block, &_probe_eos));
+            if (_probe_block.rows() == 0) {
+                continue;
+            }
+            SCOPED_TIMER(_probe_timer);
+            COUNTER_UPDATE(_probe_rows_counter, _probe_block.rows());
+            RETURN_IF_ERROR(_process_probe_block(output_block));
+        } else if (_need_output_build_rows() && _build_output_pos < _build_block.rows()) {
+            _output_build_rows(output_block, state->batch_size());
+        } else {
+            break;
+        }
+
+        if (_vconjunct_ctx_ptr != nullptr && output_block->rows() > 0) {
+            IColumn::Filter filter;
+            RETURN_IF_ERROR((*_vconjunct_ctx_ptr)->execute_conjuncts(output_block, &filter));
+            Block::filter_block(output_block, filter, _probe_column_num + _build_column_num);
+        }
+    }
+
+    *eos = _probe_eos &&
+           !(_need_output_build_rows() && _build_output_pos < _build_block.rows());
+
+    _num_rows_returned += output_block->rows();
+    if (reached_limit()) {
+        size_t rows = output_block->rows() - (_num_rows_returned - _limit);
+        for (size_t i = 0; i < output_block->columns(); ++i) {
+            auto& column = output_block->getByPosition(i).column;
+            column = column->cut(0, rows);
+        }
+        _num_rows_returned = _limit;
+        *eos = true;
+    }
+    COUNTER_SET(_rows_returned_counter, _num_rows_returned);
+    return Status::OK();
+}
+
+Status VHashJoinNode::close(RuntimeState* state) {
+    if (is_closed()) {
+        return Status::OK();
+    }
+
+    VExpr::close(_build_expr_ctxs, state);
+    VExpr::close(_probe_expr_ctxs, state);
+    VExpr::close(_other_join_conjunct_ctxs, state);
+
+    _hash_table_variants.emplace<SerializedHashTableContext>();
+    _build_block.clear();
+    _probe_block.clear();
+    mem_tracker()->Release(_mem_used);
+    _mem_used = 0;
+
+    return ExecNode::close(state);
+}
+
+} // namespace doris::vectorized
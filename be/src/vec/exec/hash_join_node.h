@@ -0,0 +1,245 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <variant>
+
+#include "exec/exec_node.h"
+#include "vec/columns/columns_number.h"
+#include "vec/common/arena.h"
+#include "vec/common/columns_hashing.h"
+#include "vec/common/hash_table/hash_map.h"
+#include "vec/core/block.h"
+
+namespace doris {
+class ObjectPool;
+class TPlanNode;
+class DescriptorTbl;
+class RuntimeFilter;
+
+namespace vectorized {
+class VExprContext;
+
+// The rows of the build block sharing the same join key, the first one is
+// stored in the hash table and the others are chained from the arena.
+struct RowRefList {
+    RowRefList() = default;
+    RowRefList(uint32_t row_num_) : row_num(row_num_) {}
+
+    void insert(uint32_t row, Arena& pool) {
+        auto* elem = new (pool.alloc<RowRefList>()) RowRefList(row);
+        elem->next = next;
+        next = elem;
+    }
+
+    uint32_t row_num = 0;
+    RowRefList* next = nullptr;
+};
+
+// The cache of consecutive keys is disabled for all the methods: it keeps a copy
+// of the mapped value, while the chains of the build side are updated in place.
+struct SerializedHashTableContext {
+    using Mapped = RowRefList;
+    using HashTable = HashMapWithSavedHash<StringRef, Mapped>;
+    using State = ColumnsHashing::HashMethodSerialized<typename HashTable::value_type, Mapped>;
+
+    HashTable hash_table;
+};
+
+// The strings stay in the build block, so they are not copied into the arena.
+struct StringHashTableContext {
+    using Mapped = RowRefList;
+    using HashTable = HashMapWithSavedHash<StringRef, Mapped>;
+    using State =
+            ColumnsHashing::HashMethodString<typename HashTable::value_type, Mapped, false, false>;
+
+    HashTable hash_table;
+};
+
+template <typename T>
+struct PrimaryTypeHashTableContext {
+    using Mapped = RowRefList;
+    using HashTable = HashMap<T, Mapped, HashCRC32<T>>;
+    using State =
+            ColumnsHashing::HashMethodOneNumber<typename HashTable::value_type, Mapped, T, false>;
+
+    HashTable hash_table;
+};
+
+using I8HashTableContext = PrimaryTypeHashTableContext<UInt8>;
+using I16HashTableContext = PrimaryTypeHashTableContext<UInt16>;
+using I32HashTableContext = PrimaryTypeHashTableContext<UInt32>;
+using I64HashTableContext = PrimaryTypeHashTableContext<UInt64>;
+using I128HashTableContext = PrimaryTypeHashTableContext<UInt128>;
+
+// The nullable keys are stripped before the lookup: a null never matches with the
+// equal condition, and the null-safe equal (<=>) keys always use the serialized method.
+template <typename T, typename Hash>
+struct FixedKeyHashTableContext {
+    using Mapped = RowRefList;
+    using HashTable = HashMap<T, Mapped, Hash>;
+    using State = ColumnsHashing::HashMethodKeysFixed<typename HashTable::value_type, T, Mapped,
+                                                      false, false>;
+
+    HashTable hash_table;
+};
+
+using I64FixedKeyHashTableContext = FixedKeyHashTableContext<UInt64, HashCRC32<UInt64>>;
+using I128FixedKeyHashTableContext = FixedKeyHashTableContext<UInt128, UInt128HashCRC32>;
+using I256FixedKeyHashTableContext = FixedKeyHashTableContext<UInt256, UInt256HashCRC32>;
+
+using HashTableVariants =
+        std::variant<SerializedHashTableContext, StringHashTableContext, I8HashTableContext,
+                     I16HashTableContext, I32HashTableContext, I64HashTableContext,
+                     I128HashTableContext, I64FixedKeyHashTableContext,
+                     I128FixedKeyHashTableContext, I256FixedKeyHashTableContext>;
+
+// Vectorized version of HashJoinNode.
+// The build side (child(1)) is fully consumed in open() into a single block and a
+// hash table mapping each join key to the chain of its build rows. Each block of the
+// probe side (child(0)) is then looked up as a whole: every probe row yields the list
+// of its matched build rows, the probe columns are replicated by the number of matches
+// and the build columns are gathered with the matched row numbers.
+// The output block holds the columns of the probe tuples followed by the ones of the
+// build tuples, the side not returned by semi and anti joins is filled with nulls.
+class VHashJoinNode : public ExecNode {
+public:
+    VHashJoinNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs);
+    ~VHashJoinNode();
+
+    virtual Status init(const TPlanNode& tnode, RuntimeState* state = nullptr);
+    virtual Status prepare(RuntimeState* state);
+    virtual Status open(RuntimeState* state);
+    virtual Status get_next(RuntimeState* state, RowBatch* row_batch, bool* eos);
+    virtual Status get_next(RuntimeState* state, Block* block, bool* eos);
+    virtual Status close(RuntimeState* state);
+
+private:
+    void _init_hash_method();
+
+    // Evaluate the key exprs over the block, the key columns are kept alive by the block.
+    // The rows whose keys can not match anything because of a null are flagged in null_map.
+    Status _extract_join_columns(Block& block, const std::vector<VExprContext*>& exprs,
+                                 ColumnRawPtrs& key_columns, ColumnUInt8::MutablePtr& null_map);
+
+    Status _build_hash_table(RuntimeState* state);
+
+    template <typename HashTableContext>
+    void _insert_build_rows(HashTableContext& ctx, const ColumnRawPtrs& key_columns,
+                            const ColumnUInt8* null_map);
+
+    // Collect the build keys into the runtime filters of the probe slots they are
+    // compared with, the filters are pushed down to the probe side in open().
+    Status _build_runtime_filters(const ColumnRawPtrs& key_columns, const ColumnUInt8* null_map);
+
+    // Send the runtime filters to the fragments scanning the probe side, and wait for them
+    // to be received.
+    void _send_runtime_filters(RuntimeState* state);
+
+    Status _process_probe_block(Block* output_block);
+
+    // Fill _offsets and _build_indexes with the matched build rows of every probe row.
+    template <typename HashTableContext>
+    void _find_matched_rows(HashTableContext& ctx, const ColumnRawPtrs& key_columns,
+                            const ColumnUInt8* null_map, size_t probe_rows);
+
+    // Only keep the pairs of the block passing the other join conjuncts, in the block
+    // as well as in _offsets and _build_indexes.
+    Status _filter_other_join_conjuncts(Block* block, size_t probe_rows);
+
+    // Give one pair to each probe row without any match, its build columns are null.
+    void _add_unmatched_probe_rows(size_t probe_rows);
+
+    // The matched pairs of the probe block described by _offsets and _build_indexes.
+    Block _build_pairs_block(const Block& probe_block);
+
+    ColumnPtr _gather_nullable_build_column(const ColumnPtr& column, size_t rows);
+
+    // The probe rows selected by filter, the build columns are all null.
+    Block _build_probe_rows_block(const Block& probe_block, const IColumn::Filter& filter);
+
+    bool _need_output_build_rows() const;
+
+    // Emit the build rows which were (not) visited, once the probe side is done.
+    void _output_build_rows(Block* output_block, size_t batch_size);
+
+    // Append null columns for the slots of row_desc, used for the side of the
+    // output that is not returned by semi/anti joins and the unmatched rows of outer joins.
+    static void _append_null_columns(Block* block, const RowDescriptor& row_desc, size_t rows);
+
+    // AND the results of the conjuncts over the block into filter, null counts as false.
+    static Status _execute_conjuncts(const std::vector<VExprContext*>& ctxs, Block* block,
+                                     IColumn::Filter* filter);
+
+    TJoinOp::type _join_op;
+
+    std::vector<VExprContext*> _build_expr_ctxs;
+    std::vector<VExprContext*> _probe_expr_ctxs;
+    std::vector<VExprContext*> _other_join_conjunct_ctxs;
+    // true for the null-safe equal (<=>) conditions
+    std::vector<bool> _is_null_safe_eq_join;
+
+    // LEFT SEMI/ANTI joins only need to know whether a probe row has a match, so
+    // the rows with duplicated keys are not stored.
+    bool _build_unique;
+    bool _match_all_probe;
+    bool _match_all_build;
+    bool _has_null_in_build_side = false;
+    // set by the planner if the probe side can be filtered by the build keys
+    bool _is_push_down;
+    // the instances of the fragments scanning the probe side, when it is not scanned by
+    // this fragment, and the number of the instances of this join sending them filters
+    std::vector<TRuntimeFilterTarget> _runtime_filter_targets;
+    int _num_runtime_filter_senders;
+
+    HashTableVariants _hash_table_variants;
+    Sizes _key_sizes;
+    Arena _arena;
+
+    std::vector<RuntimeFilter*> _runtime_filters;
+
+    Block _build_block;
+    // the first columns of both blocks belong to the tuples of the children, the
+    // others hold the evaluated join keys
+    size_t _build_column_num = 0;
+    size_t _probe_column_num = 0;
+    // the build rows matched by some probe row, for the right joins
+    std::vector<uint8_t> _build_visited;
+    size_t _build_output_pos = 0;
+
+    Block _probe_block;
+    bool _probe_eos = false;
+
+    // the lookup result of the current probe block: the matched build rows of
+    // probe row i are _build_indexes[_offsets[i - 1], _offsets[i])
+    IColumn::Offsets _offsets;
+    ColumnUInt32::MutablePtr _build_indexes;
+    // set for the pairs of the probe rows without match of the outer joins
+    IColumn::Filter _null_build_rows;
+    IColumn::Filter _probe_matched;
+
+    int64_t _mem_used = 0;
+
+    RuntimeProfile::Counter* _build_timer;
+    RuntimeProfile::Counter* _probe_timer;
+    RuntimeProfile::Counter* _build_rows_counter;
+    RuntimeProfile::Counter* _probe_rows_counter;
+};
+
+} // namespace vectorized
+} // namespace doris
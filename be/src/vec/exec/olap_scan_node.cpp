@@ -17,13 +17,19 @@
 
 #include "vec/exec/olap_scan_node.h"
 
+#include <map>
+
 #include "gen_cpp/PlanNodes_types.h"
 #include "runtime/descriptors.h"
 #include "runtime/exec_env.h"
 #include "util/priority_thread_pool.hpp"
+#include "vec/columns/column_const.h"
+#include "vec/columns/column_nullable.h"
 #include "vec/core/block.h"
 #include "vec/exec/olap_scanner.h"
 #include "vec/exprs/vexpr.h"
+#include "vec/exprs/vin_predicate.h"
+#include "vec/exprs/vslot_ref.h"
 
 namespace doris::vectorized {
 VOlapScanNode::VOlapScanNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs)
@@ -32,6 +38,20 @@ VOlapScanNode::VOlapScanNode(ObjectPool* pool, const TPlanNode& tnode, const Des
 
 VOlapScanNode::~VOlapScanNode() {}
 
+bool VOlapScanNode::request_low_cardinality_slot(SlotId slot_id) {
+    for (auto slot : _tuple_desc->slots()) {
+        if (slot->id() != slot_id) {
+            continue;
+        }
+        if (slot->type().type != TYPE_CHAR && slot->type().type != TYPE_VARCHAR) {
+            return false;
+        }
+        _low_cardinality_slots.insert(slot_id);
+        return true;
+    }
+    return false;
+}
+
 void VOlapScanNode::transfer_thread(RuntimeState* state) {
     // scanner open pushdown to scanThread
     state->resource_pool()->acquire_thread_token();
@@ -524,4 +544,190 @@ Status VOlapScanNode::get_next(RuntimeState* state, Block* block, bool* eos) {
     return _status;
 }
 
+void VOlapScanNode::remove_pushed_conjuncts(RuntimeState* state) {
+    OlapScanNode::remove_pushed_conjuncts(state);
+    if (_vconjunct_ctx_ptr == nullptr) {
+        return;
+    }
+    if (_push_down_vconjunct((*_vconjunct_ctx_ptr)->root())) {
+        (*_vconjunct_ctx_ptr)->close(state);
+        _vconjunct_ctx_ptr.reset();
+    }
+}
+
+bool VOlapScanNode::_push_down_vconjunct(VExpr* expr) {
+    bool pushed = true;
+    if (expr->node_type() == TExprNodeType::COMPOUND_PRED &&
+        expr->fn().name.function_name == "and") {
+        for (auto child : expr->children()) {
+            pushed &= _push_down_vconjunct(child);
+        }
+    } else {
+        TCondition filter;
+        pushed = _to_olap_filter(expr, &filter);
+        // the row engine conjuncts the conjunct is made of may be pushed down already
+        if (pushed && std::find(_olap_filter.begin(), _olap_filter.end(), filter) ==
+                              _olap_filter.end()) {
+            _olap_filter.push_back(std::move(filter));
+        }
+    }
+    if (pushed) {
+        expr->set_constant(UInt64(1));
+    }
+    return pushed;
+}
+
+// The value of column, a constant, as the value of an olap filter on a column of type, see
+// cast_to_string. False if it is NULL.
+static bool to_olap_filter_value(PrimitiveType type, const IColumn& column, std::string* value) {
+    if (column.isNullAt(0)) {
+        return false;
+    }
+    const IColumn* data = &column;
+    if (auto column_const = checkAndGetColumn<ColumnConst>(*data)) {
+        data = &column_const->getDataColumn();
+    }
+    if (auto column_nullable = checkAndGetColumn<ColumnNullable>(*data)) {
+        data = &column_nullable->getNestedColumn();
+    }
+    StringRef ref = data->getDataAt(0);
+    auto cast = [&](auto typed_value) {
+        memcpy(&typed_value, ref.data, sizeof(typed_value));
+        *value = cast_to_string(typed_value);
+        return true;
+    };
+    switch (type) {
+    case TYPE_BOOLEAN:
+        return cast(bool());
+    case TYPE_TINYINT:
+        return cast(int8_t());
+    case TYPE_SMALLINT:
+        return cast(int16_t());
+    case TYPE_INT:
+        return cast(int32_t());
+    case TYPE_BIGINT:
+        return cast(int64_t());
+    case TYPE_LARGEINT:
+        return cast(__int128());
+    case TYPE_DATE:
+    case TYPE_DATETIME:
+        // a DateTimeValue in the Int128 of the column
+        return cast(DateTimeValue());
+    case TYPE_DECIMALV2: {
+        __int128 decimal = 0;
+        memcpy(&decimal, ref.data, sizeof(decimal));
+        *value = cast_to_string(DecimalV2Value(decimal));
+        return true;
+    }
+    case TYPE_CHAR:
+    case TYPE_VARCHAR:
+        *value = ref.toString();
+        return true;
+    default:
+        return false;
+    }
+}
+
+const SlotDescriptor* VOlapScanNode::_pushable_slot(VExpr* expr) {
+    auto slot_ref = dynamic_cast<VSlotRef*>(expr);
+    if (slot_ref == nullptr) {
+        return nullptr;
+    }
+    for (auto slot : _tuple_desc->slots()) {
+        if (slot->id() != slot_ref->slot_id()) {
+            continue;
+        }
+        // the value columns of the aggregate and unique keys tables are only known after the
+        // merge of the rows of a key
+        return is_key_column(slot->col_name()) ? slot : nullptr;
+    }
+    return nullptr;
+}
+
+bool VOlapScanNode::_to_olap_filter(VExpr* conjunct, TCondition* filter) {
+    const auto& children = conjunct->children();
+    const std::string& function_name = conjunct->fn().name.function_name;
+    if (children.empty()) {
+        return false;
+    }
+
+    if (conjunct->node_type() == TExprNodeType::FUNCTION_CALL &&
+        (function_name == "is_null_pred" || function_name == "is_not_null_pred")) {
+        const SlotDescriptor* slot = _pushable_slot(children[0]);
+        if (slot == nullptr) {
+            return false;
+        }
+        filter->__set_column_name(slot->col_name());
+        filter->__set_condition_op("is");
+        filter->condition_values.push_back(function_name == "is_null_pred" ? "null"
+                                                                           : "not null");
+        return true;
+    }
+
+    // the values compared to the slot, which have to be constants of its type
+    auto add_value = [&](const SlotDescriptor* slot, VExpr* expr) {
+        PrimitiveType type = slot->type().type;
+        PrimitiveType value_type = expr->result_type();
+        bool string_types = (type == TYPE_CHAR || type == TYPE_VARCHAR) &&
+                            (value_type == TYPE_CHAR || value_type == TYPE_VARCHAR);
+        ColumnPtr column = expr->get_const_col();
+        std::string value;
+        if (column == nullptr || (type != value_type && !string_types) ||
+            !to_olap_filter_value(type, *column, &value)) {
+            return false;
+        }
+        filter->condition_values.push_back(std::move(value));
+        return true;
+    };
+
+    if (auto in_predicate = dynamic_cast<VInPredicate*>(conjunct)) {
+        const SlotDescriptor* slot = _pushable_slot(children[0]);
+        if (slot == nullptr ||
+            static_cast<int>(children.size()) - 1 > _max_pushdown_conditions_per_column) {
+            return false;
+        }
+        for (size_t i = 1; i < children.size(); ++i) {
+            ColumnPtr column = children[i]->get_const_col();
+            if (column != nullptr && column->isNullAt(0) && !in_predicate->is_not_in()) {
+                // no row is equal to NULL, while x NOT IN (..., NULL) is never true
+                continue;
+            }
+            if (!add_value(slot, children[i])) {
+                return false;
+            }
+        }
+        // the storage has no list predicate of booleans, see Reader::_parse_to_predicate, a
+        // single value is a comparison
+        if (filter->condition_values.empty() ||
+            (slot->type().type == TYPE_BOOLEAN && filter->condition_values.size() > 1)) {
+            return false;
+        }
+        filter->__set_column_name(slot->col_name());
+        filter->__set_condition_op(in_predicate->is_not_in() ? "!*=" : "*=");
+        return true;
+    }
+
+    // the op of a comparison of the slot to a value, and of a value to the slot
+    static const std::map<std::string, std::pair<std::string, std::string>> comparison_ops = {
+            {"eq", {"*=", "*="}}, {"ne", {"!*=", "!*="}}, {"lt", {"<<", ">>"}},
+            {"le", {"<=", ">="}}, {"gt", {">>", "<<"}},   {"ge", {">=", "<="}}};
+    auto op = comparison_ops.find(function_name);
+    if (conjunct->node_type() != TExprNodeType::BINARY_PRED || op == comparison_ops.end() ||
+        children.size() != 2) {
+        return false;
+    }
+    bool slot_first = true;
+    const SlotDescriptor* slot = _pushable_slot(children[0]);
+    if (slot == nullptr) {
+        slot_first = false;
+        slot = _pushable_slot(children[1]);
+    }
+    if (slot == nullptr || !add_value(slot, children[slot_first ? 1 : 0])) {
+        return false;
+    }
+    filter->__set_column_name(slot->col_name());
+    filter->__set_condition_op(slot_first ? op->second.first : op->second.second);
+    return true;
+}
+
 } // namespace doris::vectorized
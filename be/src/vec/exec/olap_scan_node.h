@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include <set>
+
 #include "exec/olap_scan_node.h"
 #include "vec/exec/olap_scan_node.h"
 
@@ -27,6 +29,7 @@ class DescriptorTbl;
 class RowBatch;
 namespace vectorized {
 
+class VExpr;
 class VOlapScanner;
 
 class VOlapScanNode : public OlapScanNode {
@@ -43,9 +46,37 @@ public:
     virtual Status start_scan_thread(RuntimeState* state);
     virtual Status close(RuntimeState* state);
 
+    // Asks the scanners to return the string slot slot_id as a ColumnLowCardinality of the
+    // codes of the dictionary encoded pages, when it is not read by the vectorized conjuncts,
+    // see VOlapScanner::_low_cardinality_positions(). Called by the parent in prepare().
+    // Returns false if the slot can not be returned as codes.
+    bool request_low_cardinality_slot(SlotId slot_id);
+
     friend class VOlapScanner;
 
+protected:
+    // Also pushes the conjuncts of the vectorized conjunct the storage can evaluate down to
+    // it, see _push_down_vconjunct.
+    virtual void remove_pushed_conjuncts(RuntimeState* state) override;
+
 private:
+    friend class VOlapScanNodeTest;
+
+    // Pushes the conjuncts of the AND tree of expr which the storage can evaluate down to it
+    // as olap filters, which the reader turns into the column predicates of the segments. A
+    // pushed conjunct holds on all the rows read, so it is made a constant true and the
+    // scanners no longer execute it. Returns whether all the conjuncts of expr are pushed.
+    // Only the pushed conjuncts are lazily materialized by the segment iterator, the others
+    // are executed by the scanners on whole blocks, after all their columns are read.
+    bool _push_down_vconjunct(VExpr* expr);
+
+    // Translates conjunct to an olap filter: a comparison or an IN of a slot and constants,
+    // or an IS [NOT] NULL of a slot, on a key column of a type the reader supports.
+    bool _to_olap_filter(VExpr* conjunct, TCondition* filter);
+
+    // The slot of expr if it is a slot ref whose conjuncts can be pushed down, else nullptr.
+    const SlotDescriptor* _pushable_slot(VExpr* expr);
+
     std::list<Block*> _scan_blocks;
     std::list<Block*> _materialized_blocks;
     std::mutex _blocks_lock;
@@ -58,6 +89,9 @@ private:
     std::list<VOlapScanner*> _volap_scanners;
 
     int _max_materialized_blocks;
+
+    // the slots returned as ColumnLowCardinality if the scanners can
+    std::set<SlotId> _low_cardinality_slots;
 };
 } // namespace vectorized
 } // namespace doris
@@ -17,6 +17,7 @@
 
 #include "vec/exec/olap_scanner.h"
 
+#include "vec/columns/column_low_cardinality.h"
 #include "vec/columns/column_vector.h"
 #include "vec/common/assert_cast.h"
 #include "vec/core/block.h"
@@ -36,7 +37,24 @@ VOlapScanner::VOlapScanner(RuntimeState* runtime_state, VOlapScanNode* parent, b
 
 VOlapScanner::~VOlapScanner() {}
 
+Status VOlapScanner::prepare(const TPaloScanRange& scan_range,
+                             const std::vector<OlapScanRange*>& key_ranges,
+                             const std::vector<TCondition>& filters) {
+    RETURN_IF_ERROR(OlapScanner::prepare(scan_range, key_ranges, filters));
+    // the reader fills the columns of its first return columns, which have to be the
+    // columns of the query slots
+    _params.read_by_block =
+            _params.return_columns.size() >= _query_slots.size() &&
+            std::equal(_return_columns.begin(), _return_columns.begin() + _query_slots.size(),
+                       _params.return_columns.begin());
+    return Status::OK();
+}
+
 Status VOlapScanner::get_block(RuntimeState* state, vectorized::Block* block, bool* eof) {
+    if (_reader->support_block_read()) {
+        return _get_block_by_column(state, block, eof);
+    }
+
     auto tracker = MemTracker::CreateTracker(state->fragment_mem_tracker()->limit(),
                                              "VOlapScanner:" + print_id(state->query_id()),
                                              state->fragment_mem_tracker());
@@ -89,15 +107,73 @@ Status VOlapScanner::get_block(RuntimeState* state, vectorized::Block* block, bo
         VLOG_ROW << "VOlapScanner output rows: " << block->rows();
         
         if (_vconjunct_ctx != nullptr) {
-            int result_column_id = -1;
-            _vconjunct_ctx->execute(block, &result_column_id);
-            Block::filter_block(block, result_column_id, _tuple_desc->slots().size());
+            IColumn::Filter filter;
+            RETURN_IF_ERROR(_vconjunct_ctx->execute_conjuncts(block, &filter));
+            Block::filter_block(block, filter, _tuple_desc->slots().size());
+        }
+    } while (block->rows() == 0 && !(*eof) && raw_rows_read() < raw_rows_threshold);
+
+    return Status::OK();
+}
+
+Status VOlapScanner::_get_block_by_column(RuntimeState* state, vectorized::Block* block,
+                                          bool* eof) {
+    int64_t raw_rows_threshold = raw_rows_read() + config::doris_scanner_row_num;
+    const auto& is_low_cardinality = _low_cardinality_positions();
+    do {
+        block->clear();
+        for (size_t i = 0; i < _query_slots.size(); ++i) {
+            auto slot = _query_slots[i];
+            // the reader fills the codes of the columns of the slot, the type stays the one
+            // of the values
+            ColumnPtr column = slot->get_empty_mutable_column();
+            if (is_low_cardinality[i]) {
+                column = ColumnLowCardinality::create(column, ColumnUInt32::create());
+            }
+            block->insert(ColumnWithTypeAndName(column, slot->get_data_type_ptr(),
+                                                slot->col_name()));
+        }
+        auto res = _reader->next_block(block, eof);
+        if (res != OLAP_SUCCESS) {
+            std::stringstream ss;
+            ss << "Internal Error: read storage fail. res=" << res
+               << ", tablet=" << _tablet->full_name()
+               << ", backend=" << BackendOptions::get_localhost();
+            return Status::InternalError(ss.str());
+        }
+        _num_rows_read += block->rows();
+        _update_realtime_counter();
+        VLOG_ROW << "VOlapScanner output rows: " << block->rows();
+
+        // the conjuncts not pushed down, the columns of all the rows read are materialized
+        if (_vconjunct_ctx != nullptr && block->rows() > 0) {
+            IColumn::Filter filter;
+            RETURN_IF_ERROR(_vconjunct_ctx->execute_conjuncts(block, &filter));
+            Block::filter_block(block, filter, _query_slots.size());
         }
     } while (block->rows() == 0 && !(*eof) && raw_rows_read() < raw_rows_threshold);
 
     return Status::OK();
 }
 
+const std::vector<bool>& VOlapScanner::_low_cardinality_positions() {
+    if (_low_cardinality_inited) {
+        return _is_low_cardinality;
+    }
+    _low_cardinality_inited = true;
+    std::set<int> conjunct_column_ids;
+    if (_vconjunct_ctx != nullptr) {
+        _vconjunct_ctx->root()->collect_slot_column_ids(&conjunct_column_ids);
+    }
+    auto parent = static_cast<VOlapScanNode*>(_parent);
+    _is_low_cardinality.resize(_query_slots.size());
+    for (size_t i = 0; i < _query_slots.size(); ++i) {
+        _is_low_cardinality[i] = parent->_low_cardinality_slots.count(_query_slots[i]->id()) &&
+                                 !conjunct_column_ids.count(i);
+    }
+    return _is_low_cardinality;
+}
+
 void VOlapScanner::_convert_row_to_block(std::vector<vectorized::MutableColumnPtr>* columns) {
     size_t slots_size = _query_slots.size();
     for (int i = 0; i < slots_size; ++i) {
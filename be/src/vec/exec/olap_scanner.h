@@ -35,6 +35,10 @@ public:
                  const std::vector<OlapScanRange*>& key_ranges);
 
     ~VOlapScanner();
+
+    Status prepare(const TPaloScanRange& scan_range, const std::vector<OlapScanRange*>& key_ranges,
+                   const std::vector<TCondition>& filters);
+
     Status get_block(RuntimeState* state, vectorized::Block* block, bool* eof);
     Status get_batch(RuntimeState* state, RowBatch* row_batch, bool* eos) {
         return Status::NotSupported("Not Implemented VOlapScanNode Node::get_next scalar");
@@ -43,10 +47,22 @@ public:
     VExprContext** vconjunct_ctx_ptr() { return &_vconjunct_ctx; }
 
 private:
+    // read the columns of the segments directly, see Reader::support_block_read()
+    Status _get_block_by_column(RuntimeState* state, vectorized::Block* block, bool* eof);
+
     void _convert_row_to_block(std::vector<vectorized::MutableColumnPtr>* columns);
 
+    // Whether the query slot of every position is read as a ColumnLowCardinality: the slots
+    // requested by the parent, see VOlapScanNode::request_low_cardinality_slot(), which are
+    // not read by _vconjunct_ctx. Computed on the first call, _vconjunct_ctx is cloned after
+    // the scanner is prepared.
+    const std::vector<bool>& _low_cardinality_positions();
+
     VExprContext* _vconjunct_ctx = nullptr;
 
+    bool _low_cardinality_inited = false;
+    std::vector<bool> _is_low_cardinality;
+
     RuntimeState* _runtime_state;
     OlapScanNode* _parent;
     RuntimeProfile* _profile;
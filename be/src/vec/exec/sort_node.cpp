@@ -0,0 +1,303 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/sort_node.h"
+
+#include <algorithm>
+
+#include "gen_cpp/PlanNodes_types.h"
+#include "runtime/mem_tracker.h"
+#include "runtime/runtime_state.h"
+#include "util/runtime_profile.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/core/sort_block.h"
+#include "vec/exprs/vexpr.h"
+#include "vec/exprs/vexpr_context.h"
+
+namespace doris::vectorized {
+
+VSortNode::VSortNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs)
+        : ExecNode(pool, tnode, descs),
+          _offset(tnode.sort_node.__isset.offset ? tnode.sort_node.offset : 0) {}
+
+VSortNode::~VSortNode() {}
+
+Status VSortNode::init(const TPlanNode& tnode, RuntimeState* state) {
+    RETURN_IF_ERROR(ExecNode::init(tnode, state));
+    const TSortInfo& sort_info = tnode.sort_node.sort_info;
+    RETURN_IF_ERROR(
+            VExpr::create_expr_trees(_pool, sort_info.ordering_exprs, &_ordering_expr_ctxs));
+    if (sort_info.__isset.sort_tuple_slot_exprs) {
+        RETURN_IF_ERROR(VExpr::create_expr_trees(_pool, sort_info.sort_tuple_slot_exprs,
+                                                 &_sort_tuple_slot_expr_ctxs));
+    }
+    _is_asc_order = sort_info.is_asc_order;
+    _nulls_first = sort_info.nulls_first;
+    return Status::OK();
+}
+
+Status VSortNode::prepare(RuntimeState* state) {
+    RETURN_IF_ERROR(ExecNode::prepare(state));
+    SCOPED_TIMER(_runtime_profile->total_time_counter());
+
+    _sort_timer = ADD_TIMER(runtime_profile(), "SortTime");
+    _merge_timer = ADD_TIMER(runtime_profile(), "MergeTime");
+
+    // the materialization exprs are evaluated over the rows of the child, the ordering
+    // exprs over the materialized sort tuple
+    RETURN_IF_ERROR(VExpr::prepare(_sort_tuple_slot_expr_ctxs, state, child(0)->row_desc(),
+                                   expr_mem_tracker()));
+    RETURN_IF_ERROR(
+            VExpr::prepare(_ordering_expr_ctxs, state, _row_descriptor, expr_mem_tracker()));
+
+    for (const auto tuple_desc : _row_descriptor.tuple_descriptors()) {
+        _num_output_columns += tuple_desc->slots().size();
+    }
+    return Status::OK();
+}
+
+Status VSortNode::open(RuntimeState* state) {
+    RETURN_IF_ERROR(ExecNode::open(state));
+    SCOPED_TIMER(_runtime_profile->total_time_counter());
+    RETURN_IF_CANCELLED(state);
+
+    RETURN_IF_ERROR(VExpr::open(_sort_tuple_slot_expr_ctxs, state));
+    RETURN_IF_ERROR(VExpr::open(_ordering_expr_ctxs, state));
+    RETURN_IF_ERROR(child(0)->open(state));
+
+    // Limit of 0, no need to fetch anything from children.
+    bool eos = _limit == 0;
+    while (!eos) {
+        Block block;
+        RETURN_IF_CANCELLED(state);
+        RETURN_IF_ERROR(child(0)->get_next(state, &block, &eos));
+        if (block.rows() == 0) {
+            continue;
+        }
+
+        Block sort_block;
+        RETURN_IF_ERROR(_prepare_block(&block, &sort_block));
+        {
+            SCOPED_TIMER(_sort_timer);
+            sortBlock(sort_block, _sort_description, _sort_limit());
+        }
+        RETURN_IF_ERROR(_append_sorted_block(state, std::move(sort_block)));
+    }
+
+    {
+        SCOPED_TIMER(_merge_timer);
+        _init_merge();
+    }
+
+    // The child can be closed at this point, all its rows are in _sorted_blocks.
+    child(0)->close(state);
+    return Status::OK();
+}
+
+Status VSortNode::_prepare_block(Block* input_block, Block* sort_block) {
+    if (_sort_tuple_slot_expr_ctxs.empty()) {
+        for (size_t i = 0; i < _num_output_columns; ++i) {
+            sort_block->insert(input_block->getByPosition(i));
+        }
+    } else {
+        const auto& slots = _row_descriptor.tuple_descriptors()[0]->slots();
+        DCHECK_EQ(slots.size(), _sort_tuple_slot_expr_ctxs.size());
+        std::vector<int> result_column_ids;
+        RETURN_IF_ERROR(VExprContext::execute_exprs(_sort_tuple_slot_expr_ctxs, input_block,
+                                                    &result_column_ids));
+        for (size_t i = 0; i < _sort_tuple_slot_expr_ctxs.size(); ++i) {
+            auto column = input_block->getByPosition(result_column_ids[i]).column;
+            if (slots[i]->is_nullable() && !column->isNullable()) {
+                column = makeNullable(column);
+            }
+            sort_block->insert(ColumnWithTypeAndName(column, slots[i]->get_data_type_ptr(),
+                                                     slots[i]->col_name()));
+        }
+    }
+
+    SortDescription sort_description;
+    std::vector<int> result_column_ids;
+    RETURN_IF_ERROR(
+            VExprContext::execute_exprs(_ordering_expr_ctxs, sort_block, &result_column_ids));
+    for (size_t i = 0; i < _ordering_expr_ctxs.size(); ++i) {
+        int direction = _is_asc_order[i] ? 1 : -1;
+        int nulls_direction = _nulls_first[i] ? -direction : direction;
+        sort_description.emplace_back(result_column_ids[i], direction, nulls_direction);
+    }
+    _sort_description = std::move(sort_description);
+
+    // the cursors of the merge read the rows one by one from full columns
+    for (size_t i = 0; i < sort_block->columns(); ++i) {
+        auto& column = sort_block->getByPosition(i).column;
+        column = column->convertToFullColumnIfConst();
+    }
+    return Status::OK();
+}
+
+Status VSortNode::_append_sorted_block(RuntimeState* state, Block&& block) {
+    _update_mem_used(block.allocatedBytes());
+    _sorted_rows += block.rows();
+    _sorted_blocks.emplace_back(std::move(block));
+    RETURN_IF_LIMIT_EXCEEDED(state, "Sort, while sorting the blocks of the child.");
+    return Status::OK();
+}
+
+void VSortNode::_init_merge() {
+    std::vector<SortCursor> cursors;
+    _cursor_impls.clear();
+    // the cursors point to the elements of _cursor_impls, which must not move
+    _cursor_impls.reserve(_sorted_blocks.size());
+    for (size_t i = 0; i < _sorted_blocks.size(); ++i) {
+        _cursor_impls.emplace_back(_sorted_blocks[i], _sort_description, i);
+        cursors.emplace_back(&_cursor_impls.back());
+    }
+    _merger.init(std::move(cursors));
+}
+
+void VSortNode::_next_row() {
+    auto& cursor = _merger.top();
+    if (cursor->isLast()) {
+        _merger.removeTop();
+    } else {
+        cursor->next();
+        _merger.updateTop();
+    }
+}
+
+void VSortNode::_merge_rows(MutableColumns& columns, size_t max_rows) {
+    size_t rows = 0;
+    while (rows < max_rows && !_merger.empty()) {
+        auto& cursor = _merger.top();
+        if (_merger.size() == 1) {
+            // nothing to compare with, the rest of the last block is copied at once
+            size_t length = std::min(cursor->rows - cursor->pos, max_rows - rows);
+            for (size_t i = 0; i < columns.size(); ++i) {
+                columns[i]->insertRangeFrom(*cursor->all_columns[i], cursor->pos, length);
+            }
+            rows += length;
+            cursor->pos += length;
+            if (cursor->pos == cursor->rows) {
+                _merger.removeTop();
+            }
+            continue;
+        }
+
+        for (size_t i = 0; i < columns.size(); ++i) {
+            columns[i]->insertFrom(*cursor->all_columns[i], cursor->pos);
+        }
+        ++rows;
+        _next_row();
+    }
+}
+
+void VSortNode::_merge_sorted_blocks(size_t max_rows) {
+    SCOPED_TIMER(_merge_timer);
+    if (_sorted_blocks.size() <= 1) {
+        return;
+    }
+    _init_merge();
+    MutableColumns columns = _sorted_blocks[0].cloneEmptyColumns();
+    _merge_rows(columns, max_rows);
+    Block merged_block = _sorted_blocks[0].cloneWithColumns(std::move(columns));
+
+    _merger.init({});
+    _cursor_impls.clear();
+    _sorted_blocks.clear();
+    // the stored blocks are all the memory tracked by the node
+    _update_mem_used(static_cast<int64_t>(merged_block.allocatedBytes()) - _mem_used);
+    _sorted_rows = merged_block.rows();
+    _sorted_blocks.emplace_back(std::move(merged_block));
+}
+
+void VSortNode::_update_mem_used(int64_t bytes) {
+    if (bytes > 0) {
+        mem_tracker()->Consume(bytes);
+    } else {
+        mem_tracker()->Release(-bytes);
+    }
+    _mem_used += bytes;
+}
+
+Status VSortNode::get_next(RuntimeState* state, RowBatch* row_batch, bool* eos) {
+    return Status::NotSupported("Not Implemented VSortNode::get_next scalar");
+}
+
+Status VSortNode::get_next(RuntimeState* state, Block* output_block, bool* eos) {
+    SCOPED_TIMER(_runtime_profile->total_time_counter());
+    RETURN_IF_CANCELLED(state);
+    output_block->clear();
+
+    if (reached_limit()) {
+        *eos = true;
+        return Status::OK();
+    }
+
+    {
+        SCOPED_TIMER(_merge_timer);
+        while (_num_rows_skipped < _offset && !_merger.empty()) {
+            _next_row();
+            ++_num_rows_skipped;
+        }
+
+        if (!_merger.empty()) {
+            const Block& header = _sorted_blocks[0];
+            MutableColumns columns;
+            for (size_t i = 0; i < _num_output_columns; ++i) {
+                columns.emplace_back(header.getByPosition(i).column->cloneEmpty());
+            }
+            _merge_rows(columns, state->batch_size());
+            for (size_t i = 0; i < _num_output_columns; ++i) {
+                const auto& column_with_type = header.getByPosition(i);
+                output_block->insert(ColumnWithTypeAndName(
+                        std::move(columns[i]), column_with_type.type, column_with_type.name));
+            }
+        }
+    }
+    *eos = _merger.empty();
+
+    _num_rows_returned += output_block->rows();
+    if (reached_limit()) {
+        size_t rows = output_block->rows() - (_num_rows_returned - _limit);
+        for (size_t i = 0; i < output_block->columns(); ++i) {
+            auto& column = output_block->getByPosition(i).column;
+            column = column->cut(0, rows);
+        }
+        _num_rows_returned = _limit;
+        *eos = true;
+    }
+    COUNTER_SET(_rows_returned_counter, _num_rows_returned);
+    return Status::OK();
+}
+
+Status VSortNode::close(RuntimeState* state) {
+    if (is_closed()) {
+        return Status::OK();
+    }
+
+    VExpr::close(_sort_tuple_slot_expr_ctxs, state);
+    VExpr::close(_ordering_expr_ctxs, state);
+
+    _merger.init({});
+    _cursor_impls.clear();
+    _sorted_blocks.clear();
+    mem_tracker()->Release(_mem_used);
+    _mem_used = 0;
+
+    return ExecNode::close(state);
+}
+
+} // namespace doris::vectorized
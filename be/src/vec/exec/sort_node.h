@@ -0,0 +1,110 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "exec/exec_node.h"
+#include "vec/common/loser_tree.h"
+#include "vec/core/block.h"
+#include "vec/core/sort_cursor.h"
+#include "vec/core/sort_description.h"
+
+namespace doris {
+class ObjectPool;
+class TPlanNode;
+class DescriptorTbl;
+
+namespace vectorized {
+class VExprContext;
+
+// Vectorized version of SortNode.
+// Each block of the child is materialized into the sort tuple, the ordering exprs are
+// appended to it as extra columns and it is sorted on its own in open(). The sorted
+// blocks are then merged by get_next() with a loser tree of cursors, one per block,
+// and only the columns of the sort tuple are returned.
+// With a limit, only the first offset + limit rows of each block are kept.
+class VSortNode : public ExecNode {
+public:
+    VSortNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs);
+    virtual ~VSortNode();
+
+    virtual Status init(const TPlanNode& tnode, RuntimeState* state = nullptr);
+    virtual Status prepare(RuntimeState* state);
+    virtual Status open(RuntimeState* state);
+    virtual Status get_next(RuntimeState* state, RowBatch* row_batch, bool* eos);
+    virtual Status get_next(RuntimeState* state, Block* block, bool* eos);
+    virtual Status close(RuntimeState* state);
+
+protected:
+    // Keep a sorted block of the child until all of them are merged.
+    virtual Status _append_sorted_block(RuntimeState* state, Block&& block);
+
+    // Merge all the blocks of _sorted_blocks into one block of at most max_rows rows,
+    // which replaces them.
+    void _merge_sorted_blocks(size_t max_rows);
+
+    // the number of rows kept from each block, 0 for all of them
+    size_t _sort_limit() const { return _limit == -1 ? 0 : _offset + _limit; }
+
+    int64_t _offset;
+
+    std::vector<Block> _sorted_blocks;
+    size_t _sorted_rows = 0;
+
+private:
+    // Evaluate the materialization and the ordering exprs over a block of the child.
+    Status _prepare_block(Block* input_block, Block* sort_block);
+
+    void _init_merge();
+
+    // Move the rows from the head of the merged stream to columns, the column i is
+    // copied from the column i of the sorted blocks.
+    void _merge_rows(MutableColumns& columns, size_t max_rows);
+
+    // Move the merged stream to its next row.
+    void _next_row();
+
+    void _update_mem_used(int64_t bytes);
+
+    // the exprs evaluated over the child rows to materialize the sort tuple, empty if
+    // the tuple of the child is sorted as is
+    std::vector<VExprContext*> _sort_tuple_slot_expr_ctxs;
+    // evaluated over the materialized sort tuple
+    std::vector<VExprContext*> _ordering_expr_ctxs;
+    std::vector<bool> _is_asc_order;
+    std::vector<bool> _nulls_first;
+
+    // the columns of the sort tuple, the others hold the results of the ordering exprs
+    size_t _num_output_columns = 0;
+    // the ordering columns of the sorted blocks, set by the first block
+    SortDescription _sort_description;
+
+    std::vector<SortCursorImpl> _cursor_impls;
+    LoserTree<SortCursor> _merger;
+    int64_t _num_rows_skipped = 0;
+
+    int64_t _mem_used = 0;
+
+    RuntimeProfile::Counter* _sort_timer;
+    RuntimeProfile::Counter* _merge_timer;
+};
+
+} // namespace vectorized
+} // namespace doris
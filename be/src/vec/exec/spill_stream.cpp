@@ -0,0 +1,168 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/spill_stream.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include "common/logging.h"
+#include "fmt/format.h"
+#include "vec/common/arena.h"
+
+namespace doris::vectorized {
+
+SpillStream::SpillStream(TmpFileMgr* tmp_file_mgr, const TUniqueId& query_id,
+                         size_t max_chunk_bytes)
+        : _tmp_file_mgr(tmp_file_mgr), _query_id(query_id), _max_chunk_bytes(max_chunk_bytes) {}
+
+SpillStream::~SpillStream() {
+    close();
+}
+
+Status SpillStream::_open_file() {
+    auto devices = _tmp_file_mgr->active_tmp_devices();
+    if (devices.empty()) {
+        return Status::InternalError("no available tmp dir to spill to");
+    }
+    TmpFileMgr::File* file = nullptr;
+    RETURN_IF_ERROR(
+            _tmp_file_mgr->get_file(devices[rand() % devices.size()], _query_id, &file));
+    _file.reset(file);
+    return Status::OK();
+}
+
+Status SpillStream::write_block(const Block& block) {
+    size_t rows = block.rows();
+    if (rows == 0) {
+        return Status::OK();
+    }
+    if (_blocks.empty()) {
+        _header = block.cloneEmpty();
+    }
+    DCHECK_EQ(_header.columns(), block.columns());
+
+    size_t row = 0;
+    while (row < rows) {
+        Arena arena;
+        const char* begin = nullptr;
+        size_t size = 0;
+        size_t chunk_begin = row;
+        // a chunk ends after the row reaching _max_chunk_bytes, so it has a row at least
+        for (; row < rows && size < _max_chunk_bytes; ++row) {
+            for (size_t j = 0; j < block.columns(); ++j) {
+                size += block.getByPosition(j)
+                                .column->serializeValueIntoArena(row, arena, begin)
+                                .size;
+            }
+        }
+        RETURN_IF_ERROR(_write_chunk(begin, size, row - chunk_begin));
+    }
+    return Status::OK();
+}
+
+Status SpillStream::_write_chunk(const char* data, size_t size, size_t rows) {
+    if (_file == nullptr) {
+        RETURN_IF_ERROR(_open_file());
+    }
+    int64_t offset = 0;
+    RETURN_IF_ERROR(_file->allocate_space(size, &offset));
+    // the file is created by the first allocate_space
+    if (_fd < 0) {
+        _fd = ::open(_file->path().c_str(), O_RDWR);
+        if (_fd < 0) {
+            return Status::InternalError(fmt::format("fail to open spill file {}: {}",
+                                                     _file->path(), std::strerror(errno)));
+        }
+    }
+
+    size_t written = 0;
+    while (written < size) {
+        ssize_t res = ::pwrite(_fd, data + written, size - written, offset + written);
+        if (res < 0 && errno == EINTR) {
+            continue;
+        }
+        if (res <= 0) {
+            _file->report_io_error(std::strerror(errno));
+            return Status::InternalError(fmt::format("fail to write spill file {}: {}",
+                                                     _file->path(), std::strerror(errno)));
+        }
+        written += res;
+    }
+
+    _blocks.emplace_back(offset, size);
+    _block_rows.push_back(rows);
+    _bytes_written += size;
+    return Status::OK();
+}
+
+Status SpillStream::read_block(Block* block, bool* eos) {
+    if (_read_index >= _blocks.size()) {
+        *eos = true;
+        return Status::OK();
+    }
+    *eos = false;
+
+    auto [offset, size] = _blocks[_read_index];
+    std::unique_ptr<char[]> buffer(new char[size]);
+    int64_t read = 0;
+    while (read < size) {
+        ssize_t res = ::pread(_fd, buffer.get() + read, size - read, offset + read);
+        if (res < 0 && errno == EINTR) {
+            continue;
+        }
+        if (res <= 0) {
+            _file->report_io_error(std::strerror(errno));
+            return Status::InternalError(fmt::format("fail to read spill file {}: {}",
+                                                     _file->path(), std::strerror(errno)));
+        }
+        read += res;
+    }
+
+    MutableColumns columns = _header.cloneEmptyColumns();
+    const char* pos = buffer.get();
+    for (size_t i = 0; i < _block_rows[_read_index]; ++i) {
+        for (auto& column : columns) {
+            pos = column->deserializeAndInsertFromArena(pos);
+        }
+    }
+    DCHECK_EQ(pos, buffer.get() + size);
+
+    *block = _header.cloneEmpty();
+    block->setColumns(std::move(columns));
+    ++_read_index;
+    return Status::OK();
+}
+
+void SpillStream::close() {
+    if (_fd >= 0) {
+        ::close(_fd);
+        _fd = -1;
+    }
+    if (_file != nullptr) {
+        _file->remove();
+        _file.reset();
+    }
+    _blocks.clear();
+    _block_rows.clear();
+    _read_index = 0;
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,77 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "common/status.h"
+#include "gen_cpp/Types_types.h"
+#include "runtime/tmp_file_mgr.h"
+#include "vec/core/block.h"
+
+namespace doris::vectorized {
+
+// A sequence of Blocks written to a temporary file of TmpFileMgr and read back in the
+// same order. All the blocks of a stream must have the same structure.
+// Each block is stored row by row, every value serialized with
+// IColumn::serializeValueIntoArena, in chunks of about max_chunk_bytes.
+class SpillStream {
+public:
+    static constexpr size_t DEFAULT_MAX_CHUNK_BYTES = 4 * 1024 * 1024;
+
+    SpillStream(TmpFileMgr* tmp_file_mgr, const TUniqueId& query_id,
+                size_t max_chunk_bytes = DEFAULT_MAX_CHUNK_BYTES);
+    ~SpillStream();
+
+    // Write the rows of block, a chunk at a time, so the memory to serialize a large block
+    // is bounded.
+    Status write_block(const Block& block);
+
+    // Read the next chunk of the written blocks as a block, *eos is set once all of them
+    // were read.
+    Status read_block(Block* block, bool* eos);
+
+    bool empty() const { return _blocks.empty(); }
+
+    int64_t bytes_written() const { return _bytes_written; }
+
+    // Remove the file, the stream can not be used afterwards.
+    void close();
+
+private:
+    Status _open_file();
+    Status _write_chunk(const char* data, size_t size, size_t rows);
+
+    TmpFileMgr* _tmp_file_mgr;
+    TUniqueId _query_id;
+    size_t _max_chunk_bytes;
+
+    std::unique_ptr<TmpFileMgr::File> _file;
+    int _fd = -1;
+
+    // structure of the written blocks
+    Block _header;
+    // (offset, size) of each chunk in the file
+    std::vector<std::pair<int64_t, int64_t>> _blocks;
+    std::vector<size_t> _block_rows;
+    size_t _read_index = 0;
+    int64_t _bytes_written = 0;
+};
+
+} // namespace doris::vectorized
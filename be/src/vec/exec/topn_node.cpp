@@ -0,0 +1,45 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/topn_node.h"
+
+#include <algorithm>
+
+#include "runtime/runtime_state.h"
+
+namespace doris::vectorized {
+
+VTopNNode::VTopNNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs)
+        : VSortNode(pool, tnode, descs) {}
+
+VTopNNode::~VTopNNode() {}
+
+Status VTopNNode::_append_sorted_block(RuntimeState* state, Block&& block) {
+    RETURN_IF_ERROR(VSortNode::_append_sorted_block(state, std::move(block)));
+
+    size_t sort_limit = _sort_limit();
+    if (sort_limit == 0 || _sorted_blocks.size() == 1) {
+        return Status::OK();
+    }
+    // Merging once per batch_size rows avoids merging on every block for small limits.
+    if (_sorted_rows >= std::max<size_t>(2 * sort_limit, state->batch_size())) {
+        _merge_sorted_blocks(sort_limit);
+    }
+    return Status::OK();
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,37 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include "vec/exec/sort_node.h"
+
+namespace doris::vectorized {
+
+// Vectorized version of TopNNode (ORDER BY ... LIMIT).
+// As in VSortNode, only the first offset + limit rows of each block of the child are
+// kept. Once the kept blocks hold enough rows, they are merged into a single block of
+// offset + limit rows, so the memory is bounded by the limit instead of the input size.
+class VTopNNode : public VSortNode {
+public:
+    VTopNNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs);
+    virtual ~VTopNNode();
+
+protected:
+    virtual Status _append_sorted_block(RuntimeState* state, Block&& block);
+};
+
+} // namespace doris::vectorized
@@ -0,0 +1,394 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exprs/vcase_expr.h"
+
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+
+#include <string_view>
+
+#include "vec/columns/column_const.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_vector.h"
+#include "vec/columns/columns_common.h"
+#include "vec/common/assert_cast.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_types_number.h"
+#include "vec/functions/cast_type_to_either.h"
+#include "vec/functions/function_helpers.h"
+#include "vec/functions/simple_function_factory.h"
+
+namespace doris::vectorized {
+
+namespace {
+
+// Sets filter to the rows of column which are not null.
+void not_null_to_filter(const IColumn& column, IColumn::Filter* filter) {
+    size_t rows = column.size();
+    if (auto nullable = checkAndGetColumn<ColumnNullable>(column)) {
+        const UInt8* null_data = nullable->getNullMapData().data();
+        filter->resize(rows);
+        UInt8* __restrict res = filter->data();
+        for (size_t i = 0; i < rows; ++i) {
+            res[i] = !null_data[i];
+        }
+    } else {
+        filter->assign(rows, static_cast<UInt8>(1));
+    }
+}
+
+// Appends a row to column for every entry of branch_of_row, taken from the next unused row
+// of sources[branch_of_row[i]]. The rows of every source are in the order of the result.
+template <typename T>
+void gather_vector(const PaddedPODArray<UInt32>& branch_of_row, const ColumnRawPtrs& sources,
+                   IColumn* column) {
+    std::vector<const T*> source_data(sources.size(), nullptr);
+    for (size_t i = 0; i < sources.size(); ++i) {
+        if (sources[i] != nullptr) {
+            source_data[i] = assert_cast<const ColumnVector<T>&>(*sources[i]).getData().data();
+        }
+    }
+    auto& data = assert_cast<ColumnVector<T>&>(*column).getData();
+    size_t rows = branch_of_row.size();
+    size_t offset = data.size();
+    data.resize(offset + rows);
+    for (size_t i = 0; i < rows; ++i) {
+        data[offset + i] = *source_data[branch_of_row[i]]++;
+    }
+}
+
+// gather_vector for any column, the runs of rows of the same branch are copied at once.
+void gather_generic(const PaddedPODArray<UInt32>& branch_of_row, const ColumnRawPtrs& sources,
+                    IColumn* column) {
+    std::vector<size_t> positions(sources.size(), 0);
+    size_t rows = branch_of_row.size();
+    column->reserve(rows);
+    for (size_t i = 0; i < rows;) {
+        UInt32 branch = branch_of_row[i];
+        size_t end = i + 1;
+        while (end < rows && branch_of_row[end] == branch) {
+            ++end;
+        }
+        column->insertRangeFrom(*sources[branch], positions[branch], end - i);
+        positions[branch] += end - i;
+        i = end;
+    }
+}
+
+void gather(const DataTypePtr& type, const PaddedPODArray<UInt32>& branch_of_row,
+            const ColumnRawPtrs& sources, IColumn* column) {
+    bool gathered = castTypeToEither<DataTypeUInt8, DataTypeUInt16, DataTypeUInt32,
+                                     DataTypeUInt64, DataTypeInt8, DataTypeInt16, DataTypeInt32,
+                                     DataTypeInt64, DataTypeInt128, DataTypeFloat32,
+                                     DataTypeFloat64>(type.get(), [&](const auto& data_type) {
+        using FieldType = typename std::decay_t<decltype(data_type)>::FieldType;
+        gather_vector<FieldType>(branch_of_row, sources, column);
+        return true;
+    });
+    if (!gathered) {
+        gather_generic(branch_of_row, sources, column);
+    }
+}
+
+} // namespace
+
+VCaseExpr::VCaseExpr(const TExprNode& node)
+        : VExpr(node),
+          _has_case_expr(node.node_type == TExprNodeType::CASE_EXPR &&
+                         node.case_expr.has_case_expr),
+          _has_else_expr(node.node_type != TExprNodeType::CASE_EXPR ||
+                         node.case_expr.has_else_expr),
+          _is_not_null_test(node.node_type != TExprNodeType::CASE_EXPR &&
+                            node.fn.name.function_name != "if"),
+          _function_name(node.node_type == TExprNodeType::CASE_EXPR
+                                 ? "case"
+                                 : node.fn.name.function_name) {}
+
+bool VCaseExpr::is_conditional_function(const std::string& function_name) {
+    return function_name == "if" || function_name == "ifnull" || function_name == "coalesce";
+}
+
+Status VCaseExpr::prepare(RuntimeState* state, const RowDescriptor& desc,
+                          VExprContext* context) {
+    RETURN_IF_ERROR(VExpr::prepare(state, desc, context));
+
+    size_t child = 0;
+    if (_has_case_expr) {
+        _case = _children[child++];
+    }
+    size_t num_values = _children.size() - child - (_has_else_expr ? 1 : 0);
+    if (_children.size() <= child ||
+        (!_is_not_null_test && (num_values == 0 || num_values % 2 != 0)) ||
+        (_function_name == "if" && num_values != 2)) {
+        return Status::InternalError(
+                fmt::format("Wrong number of arguments of {}: {}", _function_name,
+                            _children.size()));
+    }
+    _branches.clear();
+    for (; child + (_has_else_expr ? 1 : 0) < _children.size(); ++child) {
+        Branch branch;
+        if (!_is_not_null_test) {
+            branch.when = _children[child++];
+        }
+        branch.then = _children[child];
+        _branches.push_back(std::move(branch));
+    }
+    _else = _has_else_expr ? _children.back() : nullptr;
+
+    if (_case != nullptr) {
+        for (auto& branch : _branches) {
+            ColumnsWithTypeAndName arguments {
+                    {_case->data_type()->createColumn(), _case->data_type(), _case->expr_name()},
+                    {branch.when->data_type()->createColumn(), branch.when->data_type(),
+                     branch.when->expr_name()}};
+            branch.equals = SimpleFunctionFactory::instance().get_function("eq", arguments);
+            if (branch.equals == nullptr) {
+                return Status::NotSupported(
+                        fmt::format("Function eq is not implemented for {} and {}",
+                                    _case->data_type()->getName(),
+                                    branch.when->data_type()->getName()));
+            }
+        }
+    }
+
+    // The FE casts all the values to the type of the result, only the nullability differs.
+    // The result of ifnull and coalesce is null where all the values are, so where the last
+    // one is; the result of case and if is null where the value taken is, or no one is.
+    VExpr* first_value = _branches.empty() ? _else : _branches[0].then;
+    DataTypePtr nested_type = removeNullable(first_value->data_type());
+    bool nullable = _is_not_null_test ? _else->is_nullable() : _else == nullptr;
+    for (size_t i = 0; i <= _branches.size(); ++i) {
+        VExpr* value = i < _branches.size() ? _branches[i].then : _else;
+        if (value == nullptr) {
+            continue;
+        }
+        if (!removeNullable(value->data_type())->equals(*nested_type)) {
+            return Status::InternalError(fmt::format("Values of {} have different types: {} and {}",
+                                                     _function_name, nested_type->getName(),
+                                                     value->data_type()->getName()));
+        }
+        nullable |= !_is_not_null_test && value->is_nullable();
+    }
+    _data_type = nullable ? makeNullable(nested_type) : nested_type;
+
+    _slot_column_ids.clear();
+    collect_slot_column_ids(&_slot_column_ids);
+
+    std::vector<std::string_view> child_expr_name;
+    for (auto child_expr : _children) {
+        child_expr_name.emplace_back(child_expr->expr_name());
+    }
+    _expr_name = fmt::format("{}({})", _function_name, child_expr_name);
+    return Status::OK();
+}
+
+Status VCaseExpr::execute(VExprContext* context, Block* block, int* result_column_id) {
+    size_t rows = block->rows();
+    // the columns kept by the blocks of the undecided rows
+    size_t num_columns = block->columns();
+    int case_column_id = -1;
+    if (_case != nullptr) {
+        RETURN_IF_ERROR(context->execute(_case, block, &case_column_id));
+        num_columns = std::max(num_columns, static_cast<size_t>(case_column_id) + 1);
+    }
+
+    const UInt32 else_branch = _branches.size();
+    // the branch every row takes, the ones no WHEN is true for take the ELSE
+    PaddedPODArray<UInt32> branch_of_row(rows, else_branch);
+    Columns branch_columns(_branches.size() + 1);
+
+    // The undecided rows are current, and their rows in block are row_ids unless current
+    // is block itself.
+    Block* current = block;
+    Block undecided;
+    PaddedPODArray<UInt32> row_ids;
+    size_t remaining = rows;
+    IColumn::Filter filter;
+    for (size_t i = 0; i < _branches.size() && remaining > 0; ++i) {
+        const Branch& branch = _branches[i];
+        ColumnPtr then_column;
+        if (branch.when == nullptr) {
+            int column_id = -1;
+            RETURN_IF_ERROR(context->execute(branch.then, current, &column_id));
+            then_column = current->getByPosition(column_id).column->convertToFullColumnIfConst();
+            not_null_to_filter(*then_column, &filter);
+        } else {
+            RETURN_IF_ERROR(_execute_when(context, branch, current, case_column_id, &filter));
+        }
+
+        size_t count = countBytesInFilter(filter);
+        if (count == 0) {
+            continue;
+        }
+        if (branch.when == nullptr) {
+            if (count < remaining) {
+                then_column = then_column->filter(filter, count);
+            }
+        } else {
+            RETURN_IF_ERROR(_execute_on_rows(context, branch.then, current, filter, count,
+                                             num_columns, &then_column));
+        }
+        branch_columns[i] = _to_result_column(then_column);
+        for (size_t j = 0; j < remaining; ++j) {
+            if (filter[j]) {
+                branch_of_row[current == block ? j : row_ids[j]] = i;
+            }
+        }
+
+        remaining -= count;
+        if (remaining == 0) {
+            break;
+        }
+        // go on with the rows the branch did not take
+        for (auto& selected : filter) {
+            selected = !selected;
+        }
+        PaddedPODArray<UInt32> next_row_ids;
+        next_row_ids.reserve(remaining);
+        for (size_t j = 0; j < filter.size(); ++j) {
+            if (filter[j]) {
+                next_row_ids.push_back(current == block ? j : row_ids[j]);
+            }
+        }
+        Block next = _filter_block(*current, filter, remaining, num_columns, case_column_id);
+        undecided.swap(next);
+        current = &undecided;
+        row_ids.swap(next_row_ids);
+    }
+
+    if (remaining > 0) {
+        ColumnPtr else_column;
+        if (_else != nullptr) {
+            int column_id = -1;
+            RETURN_IF_ERROR(context->execute(_else, current, &column_id));
+            else_column = current->getByPosition(column_id).column;
+        } else {
+            else_column = _data_type->createColumnConstWithDefaultValue(remaining);
+        }
+        branch_columns[else_branch] = _to_result_column(else_column);
+    }
+
+    ColumnPtr result;
+    if (auto nullable_type = checkAndGetDataType<DataTypeNullable>(_data_type.get())) {
+        ColumnRawPtrs nested_columns(branch_columns.size(), nullptr);
+        ColumnRawPtrs null_maps(branch_columns.size(), nullptr);
+        for (size_t i = 0; i < branch_columns.size(); ++i) {
+            if (branch_columns[i] != nullptr) {
+                const auto& column = assert_cast<const ColumnNullable&>(*branch_columns[i]);
+                nested_columns[i] = &column.getNestedColumn();
+                null_maps[i] = &column.getNullMapColumn();
+            }
+        }
+        const auto& nested_type = nullable_type->getNestedType();
+        auto nested = nested_type->createColumn();
+        gather(nested_type, branch_of_row, nested_columns, nested.get());
+        auto null_map = ColumnUInt8::create();
+        gather_vector<UInt8>(branch_of_row, null_maps, null_map.get());
+        result = ColumnNullable::create(std::move(nested), std::move(null_map));
+    } else {
+        ColumnRawPtrs columns(branch_columns.size(), nullptr);
+        for (size_t i = 0; i < branch_columns.size(); ++i) {
+            columns[i] = branch_columns[i].get();
+        }
+        auto column = _data_type->createColumn();
+        gather(_data_type, branch_of_row, columns, column.get());
+        result = std::move(column);
+    }
+
+    *result_column_id = block->columns();
+    block->insert({std::move(result), _data_type, _expr_name});
+    return Status::OK();
+}
+
+Status VCaseExpr::_execute_when(VExprContext* context, const Branch& branch, Block* block,
+                                int case_column_id, IColumn::Filter* filter) {
+    int column_id = -1;
+    RETURN_IF_ERROR(context->execute(branch.when, block, &column_id));
+    if (branch.equals != nullptr) {
+        ColumnNumbers arguments {static_cast<size_t>(case_column_id),
+                                 static_cast<size_t>(column_id)};
+        size_t result = block->columns();
+        block->insert({nullptr, branch.equals->getReturnType(), _expr_name});
+        branch.equals->execute(*block, arguments, result, block->rows(), false);
+        column_id = result;
+    }
+    VExprContext::condition_to_filter(block->getByPosition(column_id).column, filter);
+    return Status::OK();
+}
+
+Status VCaseExpr::_execute_on_rows(VExprContext* context, VExpr* expr, Block* block,
+                                   const IColumn::Filter& filter, size_t count,
+                                   size_t num_columns, ColumnPtr* result) {
+    int column_id = -1;
+    if (count == block->rows()) {
+        RETURN_IF_ERROR(context->execute(expr, block, &column_id));
+        *result = block->getByPosition(column_id).column;
+        return Status::OK();
+    }
+    Block selected = _filter_block(*block, filter, count, num_columns, -1);
+    RETURN_IF_ERROR(context->execute(expr, &selected, &column_id));
+    *result = selected.getByPosition(column_id).column;
+    return Status::OK();
+}
+
+Block VCaseExpr::_filter_block(const Block& block, const IColumn::Filter& filter, size_t count,
+                               size_t num_columns, int case_column_id) const {
+    Block result;
+    for (size_t i = 0; i < num_columns; ++i) {
+        const auto& column = block.getByPosition(i);
+        ColumnPtr selected;
+        if (static_cast<int>(i) == case_column_id || _slot_column_ids.count(i) != 0) {
+            selected = column.column->filter(filter, count);
+        } else if (isColumnConst(*column.column)) {
+            selected = column.column->cloneResized(count);
+        } else {
+            // keeps the positions of the columns, without copying the ones not read
+            selected = ColumnConst::create(column.column->cloneResized(1), count);
+        }
+        result.insert({std::move(selected), column.type, column.name});
+    }
+    return result;
+}
+
+ColumnPtr VCaseExpr::_to_result_column(const ColumnPtr& column) const {
+    ColumnPtr result = column->convertToFullColumnIfConst();
+    if (_data_type->isNullable()) {
+        return makeNullable(result);
+    }
+    // a nullable value of ifnull or coalesce is only taken where it is not null
+    if (auto nullable = checkAndGetColumn<ColumnNullable>(*result)) {
+        return nullable->getNestedColumnPtr();
+    }
+    return result;
+}
+
+const std::string& VCaseExpr::expr_name() const {
+    return _expr_name;
+}
+
+bool VCaseExpr::equals(const VExpr& other) const {
+    if (!VExpr::equals(other)) {
+        return false;
+    }
+    const auto& other_case = static_cast<const VCaseExpr&>(other);
+    return _has_case_expr == other_case._has_case_expr &&
+           _has_else_expr == other_case._has_else_expr &&
+           _function_name == other_case._function_name;
+}
+
+} // namespace doris::vectorized
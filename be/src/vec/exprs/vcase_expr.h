@@ -0,0 +1,101 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "vec/common/pod_array.h"
+#include "vec/exprs/vexpr.h"
+#include "vec/functions/function.h"
+
+namespace doris::vectorized {
+
+// Vectorized CASE, also used for if, ifnull and coalesce which are CASE in disguise:
+//   if(c, a, b)          CASE WHEN c THEN a ELSE b END
+//   ifnull(a, b)         CASE WHEN a IS NOT NULL THEN a ELSE b END
+//   coalesce(a, b, c)    CASE WHEN a IS NOT NULL THEN a WHEN b IS NOT NULL THEN b ELSE c END
+//
+// The branches are evaluated in order, every one of them only on the rows no earlier
+// branch decided: the WHEN of a branch gives a filter of the undecided rows, its THEN
+// is executed on the rows the filter selects, and the next branch on the other ones.
+// A branch is skipped once all rows are decided, so an expensive THEN or ELSE does not
+// run for rows which do not need it. The result is gathered from the branch columns
+// with the index of the branch of every row.
+class VCaseExpr final : public VExpr {
+public:
+    VCaseExpr(const TExprNode& node);
+    ~VCaseExpr() = default;
+    virtual doris::Status execute(VExprContext* context, doris::vectorized::Block* block,
+                                  int* result_column_id) override;
+    virtual doris::Status prepare(doris::RuntimeState* state, const doris::RowDescriptor& desc,
+                                  VExprContext* context) override;
+    virtual VExpr* clone(doris::ObjectPool* pool) const override {
+        return pool->add(new VCaseExpr(*this));
+    }
+    virtual const std::string& expr_name() const override;
+    virtual bool equals(const VExpr& other) const override;
+    // the branches after the first one are executed on the rows no branch before took
+    virtual bool is_children_shareable() const override { return false; }
+
+    // Whether the function call is a conditional executed by VCaseExpr.
+    static bool is_conditional_function(const std::string& function_name);
+
+private:
+    struct Branch {
+        // nullptr when the branch is taken where then is not null
+        VExpr* when = nullptr;
+        VExpr* then = nullptr;
+        // compares the case value to when, only set for CASE <expr> WHEN ...
+        FunctionBasePtr equals;
+    };
+
+    // Executes the when of the branch on block, and sets filter to the rows it is true for.
+    Status _execute_when(VExprContext* context, const Branch& branch, Block* block,
+                         int case_column_id, IColumn::Filter* filter);
+
+    // Executes expr on the rows of block selected by filter, count of them.
+    Status _execute_on_rows(VExprContext* context, VExpr* expr, Block* block,
+                            const IColumn::Filter& filter, size_t count, size_t num_columns,
+                            ColumnPtr* result);
+
+    // The rows of block selected by filter. The columns no branch reads are replaced by
+    // constants, only the columns before num_columns are kept.
+    Block _filter_block(const Block& block, const IColumn::Filter& filter, size_t count,
+                        size_t num_columns, int case_column_id) const;
+
+    // Converts the result of a branch to the result type.
+    ColumnPtr _to_result_column(const ColumnPtr& column) const;
+
+    const bool _has_case_expr;
+    const bool _has_else_expr;
+    // ifnull and coalesce, a branch is taken where its value is not null
+    const bool _is_not_null_test;
+    std::string _function_name;
+
+    VExpr* _case = nullptr;
+    std::vector<Branch> _branches;
+    VExpr* _else = nullptr;
+    // the ids of the block columns read by the children
+    std::set<int> _slot_column_ids;
+
+    std::string _expr_name;
+};
+
+} // namespace doris::vectorized
@@ -64,11 +64,12 @@ void VCastExpr::close(doris::RuntimeState* state, VExprContext* context) {
     VExpr::close(state, context);
 }
 
-doris::Status VCastExpr::execute(doris::vectorized::Block* block, int* result_column_id) {
+doris::Status VCastExpr::execute(VExprContext* context, doris::vectorized::Block* block,
+                                 int* result_column_id) {
     // for each child call execute
     doris::vectorized::ColumnNumbers arguments(2);
     int column_id = -1;
-    _children[0]->execute(block, &column_id);
+    RETURN_IF_ERROR(context->execute(_children[0], block, &column_id));
     arguments[0] = column_id;
 
     size_t const_param_id = block->columns();
@@ -21,12 +21,17 @@
 #include "fmt/ranges.h"
 #include "runtime/descriptors.h"
 #include "vec/aggregate_functions/aggregate_function_simple_factory.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/common/assert_cast.h"
+#include "vec/data_types/data_type_nullable.h"
 #include "vec/exprs/vexpr.h"
 
 namespace doris::vectorized {
 
 AggFnEvaluator::AggFnEvaluator(const TExprNode& desc)
         : _fn(desc.fn),
+          _is_merge(desc.agg_expr.is_merge_agg),
           _return_type(TypeDescriptor::from_thrift(desc.fn.ret_type)),
           _intermediate_type(TypeDescriptor::from_thrift(desc.fn.aggregate_fn.intermediate_type)),
           _intermediate_slot_desc(NULL),
@@ -66,12 +71,38 @@ Status AggFnEvaluator::prepare(RuntimeState* state, const RowDescriptor& desc, M
     std::vector<std::string_view> child_expr_name;
 
     doris::vectorized::Array params;
-    // prepare for argument
+    // The state of a function with nullable arguments has a null flag, so both phases of an
+    // aggregation have to agree on the nullability of the arguments. The merge phase does not
+    // know the input exprs of the update phase, the intermediate slot decides for both: its
+    // arguments are nullable iff it is.
+    bool nullable_arguments = _intermediate_slot_desc->is_nullable();
+    _make_nullable_arguments.assign(_input_exprs_ctxs.size(), false);
     for (int i = 0; i < _input_exprs_ctxs.size(); ++i) {
-        argument_types.emplace_back(_input_exprs_ctxs[i]->root()->data_type());
+        if (!_is_merge) {
+            const auto& data_type = _input_exprs_ctxs[i]->root()->data_type();
+            if (data_type->isNullable() && !nullable_arguments) {
+                return Status::InternalError(fmt::format(
+                        "Agg Function {} has nullable argument {} but a not nullable "
+                        "intermediate slot",
+                        _fn.name.function_name, _input_exprs_ctxs[i]->root()->expr_name()));
+            }
+            _make_nullable_arguments[i] = nullable_arguments && !data_type->isNullable();
+            argument_types.emplace_back(nullable_arguments ? makeNullable(data_type)
+                                                           : data_type);
+        }
         child_expr_name.emplace_back(_input_exprs_ctxs[i]->root()->expr_name());
     }
 
+    // The input of a merge aggregation is the serialized state, so the function has to be
+    // created with the argument types of the update phase to get the same state layout.
+    if (_is_merge) {
+        for (const auto& arg_type : _fn.arg_types) {
+            auto data_type = TypeDescriptor::from_thrift(arg_type).get_data_type_ptr();
+            argument_types.emplace_back(nullable_arguments ? makeNullable(data_type)
+                                                           : data_type);
+        }
+    }
+
     _function = AggregateFunctionSimpleFactory::instance().get(_fn.name.function_name,
                                                                argument_types, params);
     if (_function == nullptr) {
@@ -79,6 +110,9 @@ Status AggFnEvaluator::prepare(RuntimeState* state, const RowDescriptor& desc, M
                 fmt::format("Agg Function {} is not implemented", _fn.name.function_name));
     }
     _data_type = _function->getReturnType();
+    _deserialize_arena.reset(new Arena());
+    _deserialize_place =
+            _deserialize_arena->alignedAlloc(_function->sizeOfData(), _function->alignOfData());
     DCHECK(_data_type->equals(*_intermediate_slot_desc->get_data_type_ptr()));
     _expr_name = fmt::format("{}({})", _fn.name.function_name, child_expr_name);
     return Status::OK();
@@ -99,30 +133,91 @@ void AggFnEvaluator::destroy(AggregateDataPtr place) {
 }
 
 void AggFnEvaluator::execute_single_add(Block* block, AggregateDataPtr place) {
-    std::vector<const IColumn*> column_arguments(_input_exprs_ctxs.size());
-    auto columns = block->getColumns();
-    for (int i = 0; i < _input_exprs_ctxs.size(); ++i) {
-        int column_id = -1;
-        _input_exprs_ctxs[i]->execute(block, &column_id);
-        column_arguments[i] = block->getByPosition(column_id).column.get();
-    }
+    Columns arguments;
+    std::vector<const IColumn*> column_arguments;
+    _execute_arguments(block, &arguments, &column_arguments);
     _function->addBatchSinglePlace(block->rows(), place, column_arguments.data(), nullptr);
 }
 
 void AggFnEvaluator::execute_batch_add(Block* block, size_t offset, AggregateDataPtr* places,
                                        Arena* arena) {
-    std::vector<const IColumn*> column_arguments(_input_exprs_ctxs.size());
-    auto columns = block->getColumns();
+    Columns arguments;
+    std::vector<const IColumn*> column_arguments;
+    _execute_arguments(block, &arguments, &column_arguments);
+    _function->addBatch(block->rows(), places, offset, column_arguments.data(), arena);
+}
+
+void AggFnEvaluator::insert_result_info(AggregateDataPtr place, IColumn* column) {
+    _function->insertResultInto(place, *column);
+}
+
+void AggFnEvaluator::execute_single_merge(Block* block, AggregateDataPtr place, Arena* arena) {
+    auto merge_column = _get_merge_column(block);
+    const auto& column = assert_cast<const ColumnString&>(*merge_column);
+    for (size_t i = 0; i < block->rows(); ++i) {
+        _merge_serialized_state(place, column.getDataAt(i), arena);
+    }
+}
+
+void AggFnEvaluator::execute_batch_merge(Block* block, size_t offset, AggregateDataPtr* places,
+                                         Arena* arena) {
+    auto merge_column = _get_merge_column(block);
+    merge_serialized_states(*merge_column, offset, places, arena);
+}
+
+void AggFnEvaluator::merge_serialized_states(const IColumn& column, size_t offset,
+                                             AggregateDataPtr* places, Arena* arena) {
+    const auto& column_string = assert_cast<const ColumnString&>(column);
+    for (size_t i = 0; i < column_string.size(); ++i) {
+        _merge_serialized_state(places[i] + offset, column_string.getDataAt(i), arena);
+    }
+}
+
+void AggFnEvaluator::collect_slot_column_ids(std::set<int>* column_ids) const {
+    for (auto ctx : _input_exprs_ctxs) {
+        ctx->root()->collect_slot_column_ids(column_ids);
+    }
+}
+
+void AggFnEvaluator::insert_serialized_state(AggregateDataPtr place, IColumn* column) {
+    auto& column_string = assert_cast<ColumnString&>(*column);
+    auto& chars = column_string.getChars();
+    VectorBufferWriter<ColumnString::Chars> writer(chars);
+    _function->serialize(place, writer);
+    chars.push_back(0);
+    column_string.getOffsets().push_back(chars.size());
+}
+
+void AggFnEvaluator::_execute_arguments(Block* block, Columns* arguments,
+                                        std::vector<const IColumn*>* column_arguments) {
+    arguments->resize(_input_exprs_ctxs.size());
+    column_arguments->resize(_input_exprs_ctxs.size());
     for (int i = 0; i < _input_exprs_ctxs.size(); ++i) {
         int column_id = -1;
         _input_exprs_ctxs[i]->execute(block, &column_id);
-        column_arguments[i] = block->getByPosition(column_id).column.get();
+        (*arguments)[i] = block->getByPosition(column_id).column;
+        if (_make_nullable_arguments[i]) {
+            (*arguments)[i] = makeNullable((*arguments)[i]);
+        }
+        (*column_arguments)[i] = (*arguments)[i].get();
     }
-    _function->addBatch(block->rows(), places, offset, column_arguments.data(), arena);
 }
 
-void AggFnEvaluator::insert_result_info(AggregateDataPtr place, IColumn* column) {
-    _function->insertResultInto(place, *column);
+ColumnPtr AggFnEvaluator::_get_merge_column(Block* block) {
+    DCHECK_EQ(_input_exprs_ctxs.size(), 1);
+    int column_id = -1;
+    _input_exprs_ctxs[0]->execute(block, &column_id);
+    return block->getByPosition(column_id).column->convertToFullColumnIfConst();
+}
+
+void AggFnEvaluator::_merge_serialized_state(AggregateDataPtr place, const StringRef& state,
+                                             Arena* arena) {
+    AggregateDataPtr tmp_place = _deserialize_place;
+    BufferReadable reader(state);
+    _function->create(tmp_place);
+    _function->deserialize(tmp_place, reader, arena);
+    _function->merge(place, tmp_place, arena);
+    _function->destroy(tmp_place);
 }
 
 } // namespace doris::vectorized
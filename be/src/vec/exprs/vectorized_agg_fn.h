@@ -18,6 +18,7 @@
 #pragma once
 #include "runtime/types.h"
 #include "vec/aggregate_functions/aggregate_function.h"
+#include "vec/common/arena.h"
 #include "vec/core/block.h"
 #include "vec/data_types/data_type.h"
 #include "vec/exprs/vexpr_context.h"
@@ -53,13 +54,33 @@ public:
 
     void execute_batch_add(Block* block, size_t offset, AggregateDataPtr* places, Arena* arena);
 
+    // the input of a merge aggregation is a ColumnString of serialized states
+    void execute_single_merge(Block* block, AggregateDataPtr place, Arena* arena);
+
+    void execute_batch_merge(Block* block, size_t offset, AggregateDataPtr* places, Arena* arena);
+
+    // merge the states of a ColumnString built by insert_serialized_state, row i into places[i]
+    void merge_serialized_states(const IColumn& column, size_t offset, AggregateDataPtr* places,
+                                 Arena* arena);
+
+    // append the serialized state as a new row of a ColumnString, used when the node
+    // does not finalize and the states are sent to a merge aggregation
+    void insert_serialized_state(AggregateDataPtr place, IColumn* column);
+
     DataTypePtr& data_type() { return _data_type; }
 
     const AggregateFunctionPtr& function() { return _function; }
 
+    bool is_merge() const { return _is_merge; }
+
+    // the columns of the slots read by the input exprs
+    void collect_slot_column_ids(std::set<int>* column_ids) const;
+
 private:
     const TFunction _fn;
 
+    const bool _is_merge;
+
     AggFnEvaluator(const TExprNode& desc);
 
     const TypeDescriptor _return_type;
@@ -76,6 +97,21 @@ private:
     AggregateFunctionPtr _function;
 
     std::string _expr_name;
+
+    // holds the temporary state, aligned as the function requires, while merging
+    // serialized states
+    std::unique_ptr<Arena> _deserialize_arena;
+    AggregateDataPtr _deserialize_place = nullptr;
+
+    // the arguments of the update phase that are not nullable while the function takes them
+    // as nullable, see prepare
+    std::vector<bool> _make_nullable_arguments;
+
+    // execute the input exprs, the columns are kept in arguments
+    void _execute_arguments(Block* block, Columns* arguments,
+                            std::vector<const IColumn*>* column_arguments);
+    ColumnPtr _get_merge_column(Block* block);
+    void _merge_serialized_state(AggregateDataPtr place, const StringRef& state, Arena* arena);
 };
 } // namespace vectorized
 
@@ -36,7 +36,11 @@ doris::Status VectorizedFnCall::prepare(doris::RuntimeState* state,
     argument_template.reserve(_children.size());
     std::vector<std::string_view> child_expr_name;
     for (auto child : _children) {
-        auto column = child->data_type()->createColumn();
+        // the constant arguments are visible to the function when it is built
+        ColumnPtr column = child->get_const_col();
+        if (column == nullptr) {
+            column = child->data_type()->createColumn();
+        }
         argument_template.emplace_back(std::move(column), child->data_type(), child->expr_name());
         child_expr_name.emplace_back(child->expr_name());
     }
@@ -58,12 +62,13 @@ void VectorizedFnCall::close(doris::RuntimeState* state, VExprContext* context)
     VExpr::close(state, context);
 }
 
-doris::Status VectorizedFnCall::execute(doris::vectorized::Block* block, int* result_column_id) {
+doris::Status VectorizedFnCall::execute(VExprContext* context, doris::vectorized::Block* block,
+                                        int* result_column_id) {
     // for each child call execute
     doris::vectorized::ColumnNumbers arguments(_children.size());
     for (int i = 0; i < _children.size(); ++i) {
         int column_id = -1;
-        _children[i]->execute(block, &column_id);
+        RETURN_IF_ERROR(context->execute(_children[i], block, &column_id));
         arguments[i] = column_id;
     }
     // call function
@@ -78,4 +83,13 @@ doris::Status VectorizedFnCall::execute(doris::vectorized::Block* block, int* re
 const std::string& VectorizedFnCall::expr_name() const {
     return _expr_name;
 }
+
+bool VectorizedFnCall::is_constant_foldable() const {
+    return _function->isDeterministicInScopeOfQuery() && _function->isSuitableForConstantFolding();
+}
+
+bool VectorizedFnCall::equals(const VExpr& other) const {
+    // e.g. rand() is not a common subexpression of two calls of it
+    return VExpr::equals(other) && _function->isDeterministic() && !_function->isStateful();
+}
 } // namespace doris::vectorized
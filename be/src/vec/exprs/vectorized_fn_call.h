@@ -24,7 +24,8 @@ namespace doris::vectorized {
 class VectorizedFnCall final : public VExpr {
 public:
     VectorizedFnCall(const doris::TExprNode& node);
-    virtual doris::Status execute(doris::vectorized::Block* block, int* result_column_id);
+    virtual doris::Status execute(VExprContext* context, doris::vectorized::Block* block,
+                                  int* result_column_id);
     virtual doris::Status prepare(doris::RuntimeState* state, const doris::RowDescriptor& desc,
                                   VExprContext* context);
     virtual doris::Status open(doris::RuntimeState* state, VExprContext* context);
@@ -33,6 +34,8 @@ public:
         return pool->add(new VectorizedFnCall(*this));
     }
     virtual const std::string& expr_name() const override;
+    virtual bool equals(const VExpr& other) const override;
+    virtual bool is_constant_foldable() const override;
 
 private:
     FunctionBasePtr _function;
@@ -19,9 +19,17 @@
 
 #include <fmt/format.h>
 
+#include <typeinfo>
+
 #include "gen_cpp/Exprs_types.h"
+#include "vec/columns/column_const.h"
+#include "vec/columns/columns_number.h"
+#include "vec/common/exception.h"
+#include "vec/data_types/data_types_number.h"
+#include "vec/exprs/vcase_expr.h"
 #include "vec/exprs/vcast_expr.h"
 #include "vec/exprs/vectorized_fn_call.h"
+#include "vec/exprs/vin_predicate.h"
 #include "vec/exprs/vliteral.h"
 #include "vec/exprs/vslot_ref.h"
 
@@ -50,7 +58,31 @@ VExpr::VExpr(const TypeDescriptor& type, bool is_slotref)
 Status VExpr::prepare(RuntimeState* state, const RowDescriptor& row_desc, VExprContext* context) {
     for (int i = 0; i < _children.size(); ++i) {
         RETURN_IF_ERROR(_children[i]->prepare(state, row_desc, context));
+        RETURN_IF_ERROR(_children[i]->_fold_constant(context));
+    }
+    return Status::OK();
+}
+
+Status VExpr::_fold_constant(VExprContext* context) {
+    if (_children.empty() || _constant_col != nullptr || !is_constant_foldable()) {
+        return Status::OK();
+    }
+    for (auto child : _children) {
+        if (child->get_const_col() == nullptr) {
+            return Status::OK();
+        }
     }
+    // the children insert their constants with the row count of the block
+    Block block({{ColumnUInt8::create(1, 0), std::make_shared<DataTypeUInt8>(), "constant"}});
+    int column_id = -1;
+    try {
+        RETURN_IF_ERROR(context->execute(this, &block, &column_id));
+    } catch (const Exception&) {
+        // e.g. a cast of an invalid string, only an error if the expr executes on some row
+        return Status::OK();
+    }
+    ColumnPtr column = block.getByPosition(column_id).column;
+    _constant_col = isColumnConst(*column) ? column : ColumnConst::create(column, 1);
     return Status::OK();
 }
 
@@ -67,6 +99,29 @@ void VExpr::close(doris::RuntimeState* state, VExprContext* context) {
     }
 }
 
+void VExpr::collect_slot_column_ids(std::set<int>* column_ids) const {
+    for (auto child : _children) {
+        child->collect_slot_column_ids(column_ids);
+    }
+}
+
+bool VExpr::equals(const VExpr& other) const {
+    if (this == &other) {
+        return true;
+    }
+    if (typeid(*this) != typeid(other) || _node_type != other._node_type ||
+        !(_type == other._type) || _fn != other._fn || !_data_type->equals(*other._data_type) ||
+        _children.size() != other._children.size()) {
+        return false;
+    }
+    for (int i = 0; i < _children.size(); ++i) {
+        if (!_children[i]->equals(*other._children[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
 Status VExpr::create_expr(doris::ObjectPool* pool, const doris::TExprNode& texpr_node,
                           VExpr** expr) {
     switch (texpr_node.node_type) {
@@ -84,16 +139,44 @@ Status VExpr::create_expr(doris::ObjectPool* pool, const doris::TExprNode& texpr
         *expr = pool->add(new VSlotRef(texpr_node));
         break;
     }
+    case doris::TExprNodeType::ARITHMETIC_EXPR:
     case doris::TExprNodeType::COMPOUND_PRED:
-    case doris::TExprNodeType::BINARY_PRED:
-    case doris::TExprNodeType::FUNCTION_CALL: {
+    case doris::TExprNodeType::BINARY_PRED: {
         *expr = pool->add(new VectorizedFnCall(texpr_node));
         break;
     }
+    case doris::TExprNodeType::FUNCTION_CALL: {
+        // if, ifnull and coalesce are conditionals, their arguments are evaluated lazily
+        if (VCaseExpr::is_conditional_function(texpr_node.fn.name.function_name)) {
+            *expr = pool->add(new VCaseExpr(texpr_node));
+        } else {
+            *expr = pool->add(new VectorizedFnCall(texpr_node));
+        }
+        break;
+    }
+    case doris::TExprNodeType::CASE_EXPR: {
+        if (!texpr_node.__isset.case_expr) {
+            return Status::InternalError("Case expression not set in thrift node");
+        }
+        *expr = pool->add(new VCaseExpr(texpr_node));
+        break;
+    }
     case doris::TExprNodeType::CAST_EXPR: {
         *expr = pool->add(new VCastExpr(texpr_node));
         break;
     }
+    case doris::TExprNodeType::IN_PRED: {
+        switch (texpr_node.opcode) {
+        case TExprOpcode::FILTER_IN:
+        case TExprOpcode::FILTER_NOT_IN:
+            *expr = pool->add(new VInPredicate(texpr_node));
+            break;
+        default:
+            // FILTER_NEW_IN, the list is not constant
+            return Status::NotSupported("In predicate with a not constant list is not supported");
+        }
+        break;
+    }
     default:
         return Status::InternalError(
                 fmt::format("Unknown expr node type: {}", texpr_node.node_type));
@@ -169,6 +252,9 @@ Status VExpr::prepare(const std::vector<VExprContext*>& ctxs, RuntimeState* stat
     for (int i = 0; i < ctxs.size(); ++i) {
         RETURN_IF_ERROR(ctxs[i]->prepare(state, row_desc, tracker));
     }
+    if (ctxs.size() > 1) {
+        VExprContext::share_common_exprs(ctxs);
+    }
     return Status::OK();
 }
 
@@ -200,6 +286,7 @@ Status VExpr::clone_if_not_exists(const std::vector<VExprContext*>& ctxs, Runtim
     for (int i = 0; i < ctxs.size(); ++i) {
         RETURN_IF_ERROR(ctxs[i]->clone(state, &(*new_ctxs)[i]));
     }
+    VExprContext::share_results_of_clones(ctxs, *new_ctxs);
     return Status::OK();
 }
 } // namespace doris::vectorized
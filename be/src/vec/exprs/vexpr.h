@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <set>
 #include <vector>
 
 #include "common/status.h"
@@ -42,7 +43,11 @@ public:
                            VExprContext* context);
     virtual void close(RuntimeState* state, VExprContext* context);
     virtual Status open(RuntimeState* state, VExprContext* context);
-    virtual Status execute(vectorized::Block* block, int* result_column_id) = 0;
+    // Executes the expr on block, the column of the result is appended to block unless it is
+    // one of its columns. The children are executed by context->execute(child, ...), see
+    // VExprContext::execute.
+    virtual Status execute(VExprContext* context, vectorized::Block* block,
+                           int* result_column_id) = 0;
 
     DataTypePtr& data_type() { return _data_type; }
 
@@ -50,6 +55,10 @@ public:
 
     void add_child(VExpr* expr) { _children.push_back(expr); }
 
+    const std::vector<VExpr*>& children() const { return _children; }
+
+    const TFunction& fn() const { return _fn; }
+
     static Status create_expr_tree(ObjectPool* pool, const TExpr& texpr, VExprContext** ctx);
 
     static Status create_expr_trees(ObjectPool* pool, const std::vector<TExpr>& texprs,
@@ -70,6 +79,34 @@ public:
 
     PrimitiveType result_type() const { return _type.type; }
 
+    TExprNodeType::type node_type() const { return _node_type; }
+
+    // The ColumnConst of the result if it is known at prepare, e.g. of a literal or of an
+    // expr folded to a constant, otherwise nullptr. It is passed to the functions when they
+    // are built, so they can specialize on their constant arguments.
+    virtual ColumnPtr get_const_col() const { return _constant_col; }
+
+    // Makes the expr the constant value, e.g. a conjunct already known to hold on all the rows
+    // it will be executed on. Only called before the context is cloned.
+    void set_constant(const Field& value) {
+        _constant_col = _data_type->createColumnConst(1, value);
+    }
+
+    // Adds the ids of the block columns read by the slot refs of the tree to column_ids.
+    virtual void collect_slot_column_ids(std::set<int>* column_ids) const;
+
+    // Whether the trees of this and other compute the same result on any block, only called
+    // on prepared exprs. The overrides compare the state the node does not get from TExprNode.
+    virtual bool equals(const VExpr& other) const;
+
+    // Whether the expr may be computed once at prepare when all its children are constants.
+    virtual bool is_constant_foldable() const { return true; }
+
+    // Whether the children are executed on the block the expr is executed on, and so may share
+    // their results with the other exprs executed on it. Not for exprs executing children on
+    // a part of the rows.
+    virtual bool is_children_shareable() const { return true; }
+
     static Status create_expr(ObjectPool* pool, const TExprNode& texpr_node, VExpr** expr);
 
     static Status create_tree_from_thrift(ObjectPool* pool, const std::vector<TExprNode>& nodes,
@@ -77,11 +114,24 @@ public:
                                           VExprContext** ctx);
 
 protected:
+    friend class VExprContext;
+
+    // Computes the prepared expr once if its children are constants, and then executes it as
+    // its result. The children of an expr are folded by VExpr::prepare before the expr builds
+    // its function, which so sees constant arguments.
+    Status _fold_constant(VExprContext* context);
+
     TExprNodeType::type _node_type;
     TypeDescriptor _type;
     DataTypePtr _data_type;
     std::vector<VExpr*> _children;
     TFunction _fn;
+
+    // the index of the result in the shared results of the VExprContext when the expr is a
+    // common subexpression of the exprs of the context, otherwise -1
+    int _shared_id = -1;
+    // the result of the expr folded at prepare, a ColumnConst of one row
+    ColumnPtr _constant_col;
 };
 
 } // namespace vectorized
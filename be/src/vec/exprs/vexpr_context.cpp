@@ -17,6 +17,13 @@
 
 #include "vec/exprs/vexpr_context.h"
 
+#include <functional>
+#include <set>
+#include <unordered_map>
+
+#include "vec/columns/column_const.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_common.h"
 #include "vec/exprs/vexpr.h"
 
 namespace doris::vectorized {
@@ -24,13 +31,281 @@ VExprContext::VExprContext(VExpr* expr)
         : _root(expr), _prepared(false), _opened(false), _closed(false) {}
 
 doris::Status VExprContext::execute(doris::vectorized::Block* block, int* result_column_id) {
-    return _root->execute(block, result_column_id);
+    size_t num_columns = block->columns();
+    _begin_shared_results(block);
+    Status status = execute(_root, block, result_column_id);
+    if (_shared_results != nullptr) {
+        _shared_results->block = nullptr;
+    }
+    RETURN_IF_ERROR(status);
+    _erase_temporary_columns(block, num_columns, result_column_id, 1);
+    return Status::OK();
+}
+
+doris::Status VExprContext::execute(VExpr* expr, doris::vectorized::Block* block,
+                                    int* result_column_id) {
+    if (expr->_constant_col != nullptr) {
+        *result_column_id = block->columns();
+        block->insert({expr->_constant_col->cloneResized(block->rows()), expr->_data_type,
+                       expr->expr_name()});
+        return Status::OK();
+    }
+    // the exprs of a CASE branch are executed on a block of a part of the rows
+    if (expr->_shared_id < 0 || _shared_results == nullptr || _shared_results->block != block) {
+        return expr->execute(this, block, result_column_id);
+    }
+    int& shared_column_id = _shared_results->column_ids[expr->_shared_id];
+    if (shared_column_id < 0) {
+        int column_id = -1;
+        RETURN_IF_ERROR(expr->execute(this, block, &column_id));
+        shared_column_id = column_id;
+    }
+    *result_column_id = shared_column_id;
+    return Status::OK();
+}
+
+doris::Status VExprContext::execute_exprs(const std::vector<VExprContext*>& ctxs,
+                                          doris::vectorized::Block* block,
+                                          std::vector<int>* result_column_ids) {
+    size_t num_columns = block->columns();
+    result_column_ids->assign(ctxs.size(), -1);
+    for (auto ctx : ctxs) {
+        ctx->_begin_shared_results(block);
+    }
+    Status status;
+    for (int i = 0; i < ctxs.size() && status.ok(); ++i) {
+        status = ctxs[i]->execute(ctxs[i]->_root, block, &(*result_column_ids)[i]);
+    }
+    for (auto ctx : ctxs) {
+        if (ctx->_shared_results != nullptr) {
+            ctx->_shared_results->block = nullptr;
+        }
+    }
+    RETURN_IF_ERROR(status);
+    _erase_temporary_columns(block, num_columns, result_column_ids->data(), ctxs.size());
+    return Status::OK();
+}
+
+doris::Status VExprContext::execute_conjuncts(doris::vectorized::Block* block,
+                                              IColumn::Filter* filter) {
+    std::vector<VExpr*> conjuncts;
+    std::function<void(VExpr*)> collect = [&](VExpr* expr) {
+        if (expr->_constant_col == nullptr && expr->node_type() == TExprNodeType::COMPOUND_PRED &&
+            expr->fn().name.function_name == "and") {
+            for (auto child : expr->_children) {
+                collect(child);
+            }
+        } else if (expr->_constant_col == nullptr || expr->_constant_col->isNullAt(0) ||
+                   !expr->_constant_col->getBool(0)) {
+            // a conjunct known to be true, e.g. pushed down to the storage, is skipped
+            conjuncts.push_back(expr);
+        }
+    };
+    collect(_root);
+
+    filter->assign(block->rows(), static_cast<UInt8>(1));
+    // the rows the next conjunct is executed on, and their row ids in block, empty while they
+    // are the rows of block
+    Block* current = block;
+    Block selected;
+    PaddedPODArray<UInt32> row_ids;
+    IColumn::Filter result;
+    IColumn::Filter current_filter;
+    for (size_t i = 0; i < conjuncts.size(); ++i) {
+        size_t num_columns = current->columns();
+        _begin_shared_results(current);
+        int column_id = -1;
+        Status status = execute(conjuncts[i], current, &column_id);
+        if (_shared_results != nullptr) {
+            _shared_results->block = nullptr;
+        }
+        RETURN_IF_ERROR(status);
+        condition_to_filter(current->getByPosition(column_id).column, &result);
+        while (current->columns() > num_columns) {
+            current->erase(current->columns() - 1);
+        }
+
+        size_t rows = current->rows();
+        UInt8* __restrict filter_data = filter->data();
+        current_filter.resize(rows);
+        if (row_ids.empty()) {
+            for (size_t j = 0; j < rows; ++j) {
+                current_filter[j] = filter_data[j] &= result[j];
+            }
+        } else {
+            for (size_t j = 0; j < rows; ++j) {
+                current_filter[j] = filter_data[row_ids[j]] &= result[j];
+            }
+        }
+        size_t count = countBytesInFilter(current_filter);
+        // copying the columns is cheaper than executing the next conjuncts on the rows rejected
+        // already once they are the most of the rows
+        if (count == 0 || i + 1 == conjuncts.size() || count * 2 > rows) {
+            if (count == 0) {
+                break;
+            }
+            continue;
+        }
+
+        std::set<int> column_ids;
+        for (size_t j = i + 1; j < conjuncts.size(); ++j) {
+            conjuncts[j]->collect_slot_column_ids(&column_ids);
+        }
+        Block next;
+        for (size_t j = 0; j < current->columns(); ++j) {
+            const auto& column = current->getByPosition(j);
+            ColumnPtr next_column;
+            if (column_ids.count(j) != 0) {
+                next_column = column.column->filter(current_filter, count);
+            } else {
+                // keeps the positions of the columns, without copying the ones not read
+                next_column = ColumnConst::create(column.column->cloneResized(1), count);
+            }
+            next.insert({std::move(next_column), column.type, column.name});
+        }
+        PaddedPODArray<UInt32> next_row_ids;
+        next_row_ids.reserve(count);
+        for (size_t j = 0; j < rows; ++j) {
+            if (current_filter[j]) {
+                next_row_ids.push_back(row_ids.empty() ? j : row_ids[j]);
+            }
+        }
+        selected = std::move(next);
+        current = &selected;
+        row_ids.swap(next_row_ids);
+    }
+    return Status::OK();
+}
+
+void VExprContext::condition_to_filter(const ColumnPtr& condition, IColumn::Filter* filter) {
+    ColumnPtr column = condition->convertToFullColumnIfConst();
+    const NullMap* null_map = nullptr;
+    if (auto nullable = checkAndGetColumn<ColumnNullable>(*column)) {
+        null_map = &nullable->getNullMapData();
+        column = nullable->getNestedColumnPtr();
+    }
+    size_t rows = column->size();
+    filter->resize(rows);
+    UInt8* __restrict res = filter->data();
+    if (column->isFixedAndContiguous() && column->sizeOfValueIfFixed() == 1) {
+        // the UInt8 of the predicates, or the Int8 of the boolean slots
+        const auto* data = reinterpret_cast<const UInt8*>(column->getRawData().data);
+        for (size_t i = 0; i < rows; ++i) {
+            res[i] = data[i] != 0;
+        }
+    } else {
+        for (size_t i = 0; i < rows; ++i) {
+            res[i] = column->getBool(i);
+        }
+    }
+    if (null_map != nullptr) {
+        const UInt8* null_data = null_map->data();
+        for (size_t i = 0; i < rows; ++i) {
+            res[i] &= !null_data[i];
+        }
+    }
+}
+
+void VExprContext::_begin_shared_results(const Block* block) {
+    if (_shared_results != nullptr) {
+        _shared_results->block = block;
+        std::fill(_shared_results->column_ids.begin(), _shared_results->column_ids.end(), -1);
+    }
+}
+
+void VExprContext::_erase_temporary_columns(Block* block, size_t num_columns,
+                                            int* result_column_ids, size_t num_results) {
+    if (block->columns() <= num_columns + 1) {
+        // at most the column of the result was appended
+        return;
+    }
+    std::set<size_t> results;
+    for (size_t i = 0; i < num_results; ++i) {
+        results.insert(result_column_ids[i]);
+    }
+    std::set<size_t> temporaries;
+    for (size_t i = num_columns; i < block->columns(); ++i) {
+        if (results.count(i) == 0) {
+            temporaries.insert(i);
+        }
+    }
+    if (temporaries.empty()) {
+        return;
+    }
+    block->erase(temporaries);
+    for (size_t i = 0; i < num_results; ++i) {
+        // the columns before the result are gone
+        auto erased = std::distance(temporaries.begin(),
+                                    temporaries.lower_bound(result_column_ids[i]));
+        result_column_ids[i] -= erased;
+    }
+}
+
+void VExprContext::share_common_exprs(const std::vector<VExprContext*>& ctxs) {
+    // the distinct exprs met so far, and the number of references to them
+    std::vector<VExpr*> exprs;
+    std::unordered_map<VExpr*, int> num_refs;
+    std::function<void(VExpr**)> share = [&](VExpr** expr) {
+        auto it = num_refs.find(*expr);
+        if (it != num_refs.end()) {
+            ++it->second;
+            return;
+        }
+        for (auto other : exprs) {
+            if (other->equals(**expr)) {
+                *expr = other;
+                ++num_refs[other];
+                return;
+            }
+        }
+        if ((*expr)->is_children_shareable()) {
+            for (auto& child : (*expr)->_children) {
+                share(&child);
+            }
+        }
+        exprs.push_back(*expr);
+        num_refs[*expr] = 1;
+    };
+    for (auto ctx : ctxs) {
+        share(&ctx->_root);
+    }
+
+    int num_shared = 0;
+    for (auto expr : exprs) {
+        // a slot ref is a column of the block, and a literal is as cheap to execute again
+        bool shared = num_refs[expr] > 1 && !expr->_children.empty();
+        expr->_shared_id = shared ? num_shared++ : -1;
+    }
+    std::shared_ptr<SharedResults> shared_results;
+    if (num_shared > 0) {
+        shared_results = std::make_shared<SharedResults>(num_shared);
+    }
+    for (auto ctx : ctxs) {
+        ctx->_shared_results = shared_results;
+    }
+}
+
+void VExprContext::share_results_of_clones(const std::vector<VExprContext*>& ctxs,
+                                           const std::vector<VExprContext*>& new_ctxs) {
+    DCHECK_EQ(ctxs.size(), new_ctxs.size());
+    for (int i = 0; i < ctxs.size(); ++i) {
+        for (int j = 0; j < i; ++j) {
+            if (ctxs[i]->_shared_results != nullptr &&
+                ctxs[i]->_shared_results == ctxs[j]->_shared_results) {
+                new_ctxs[i]->_shared_results = new_ctxs[j]->_shared_results;
+                break;
+            }
+        }
+    }
 }
 
 doris::Status VExprContext::prepare(doris::RuntimeState* state,
                                     const doris::RowDescriptor& row_desc,
                                     const std::shared_ptr<doris::MemTracker>& tracker) {
-    return _root->prepare(state, row_desc, this);
+    RETURN_IF_ERROR(_root->prepare(state, row_desc, this));
+    RETURN_IF_ERROR(_root->_fold_constant(this));
+    share_common_exprs({this});
+    return Status::OK();
 }
 doris::Status VExprContext::open(doris::RuntimeState* state) {
     return _root->open(state, this);
@@ -46,6 +321,11 @@ doris::Status VExprContext::clone(RuntimeState* state, VExprContext** new_ctx) {
     DCHECK(*new_ctx == NULL);
 
     *new_ctx = state->obj_pool()->add(new VExprContext(_root));
+    // the shared results are of the block the context is executed on, not shared by clones
+    if (_shared_results != nullptr) {
+        (*new_ctx)->_shared_results =
+                std::make_shared<SharedResults>(_shared_results->column_ids.size());
+    }
 //    (*new_ctx)->_pool.reset(new MemPool(_pool->mem_tracker()));
 //    for (int i = 0; i < _fn_contexts.size(); ++i) {
 //        (*new_ctx)->_fn_contexts.push_back(_fn_contexts[i]->impl()->clone((*new_ctx)->_pool.get()));
@@ -17,6 +17,9 @@
 
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include "common/status.h"
 #include "runtime/runtime_state.h"
 #include "vec/core/block.h"
@@ -32,12 +35,61 @@ public:
     doris::Status open(doris::RuntimeState* state);
     void close(doris::RuntimeState* state);
     doris::Status clone(doris::RuntimeState* state, VExprContext** new_ctx);
+
+    // Executes the tree on block. Of the columns the exprs append to block, only the one of
+    // the result is kept.
     doris::Status execute(doris::vectorized::Block* block, int* result_column_id);
 
+    // Executes expr, a node of the tree, for its parent. The result of a common subexpression
+    // is computed once per block and reused by all the exprs sharing it.
+    doris::Status execute(VExpr* expr, doris::vectorized::Block* block, int* result_column_id);
+
+    // Executes ctxs on block, the common subexpressions of them are computed once. Of the
+    // columns the exprs append to block, only the ones of the results are kept.
+    static doris::Status execute_exprs(const std::vector<VExprContext*>& ctxs,
+                                       doris::vectorized::Block* block,
+                                       std::vector<int>* result_column_ids);
+
+    // Executes the tree, an AND of conjuncts, on block and sets filter to the rows of block it
+    // is true for, NULL is false. The conjuncts are executed one after another, each only on
+    // the rows the ones before are true for: once a conjunct rejects most of the rows, the
+    // columns the next conjuncts read are compacted to the selected rows, and the row ids of
+    // them in block map the results back. The columns of block are left unfiltered, so it is
+    // compacted once by the caller, e.g. with Block::filter_block.
+    doris::Status execute_conjuncts(doris::vectorized::Block* block, IColumn::Filter* filter);
+
+    // Sets filter to the rows condition is true for, NULL is false.
+    static void condition_to_filter(const ColumnPtr& condition, IColumn::Filter* filter);
+
+    // Replaces the subtrees of the trees of ctxs equal to a subtree met before by it, and makes
+    // ctxs share the results of the subtrees which are so referenced more than once. Called
+    // once the trees are prepared, before the contexts are cloned.
+    static void share_common_exprs(const std::vector<VExprContext*>& ctxs);
+
+    // Gives the clones of ctxs the same sharing of the results as ctxs.
+    static void share_results_of_clones(const std::vector<VExprContext*>& ctxs,
+                                        const std::vector<VExprContext*>& new_ctxs);
+
     VExpr* root() { return _root; }
 
 private:
+    // The results of the common subexpressions of the trees of the contexts sharing it, valid
+    // while block is being executed on.
+    struct SharedResults {
+        SharedResults(size_t size) : column_ids(size, -1) {}
+
+        const Block* block = nullptr;
+        std::vector<int> column_ids;
+    };
+
+    // Starts the reuse of the shared results on block.
+    void _begin_shared_results(const Block* block);
+    // Erases the columns appended to block from num_columns on, except the ones of the results.
+    static void _erase_temporary_columns(Block* block, size_t num_columns,
+                                         int* result_column_ids, size_t num_results);
+
     VExpr* _root;
+    std::shared_ptr<SharedResults> _shared_results;
     bool _prepared;
     bool _opened;
     bool _closed;
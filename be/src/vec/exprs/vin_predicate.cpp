@@ -0,0 +1,89 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exprs/vin_predicate.h"
+
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+
+#include <vector>
+
+#include "vec/functions/simple_function_factory.h"
+
+namespace doris::vectorized {
+
+VInPredicate::VInPredicate(const TExprNode& node)
+        : VExpr(node), _is_not_in(node.in_predicate.is_not_in) {}
+
+doris::Status VInPredicate::prepare(doris::RuntimeState* state,
+                                    const doris::RowDescriptor& desc, VExprContext* context) {
+    RETURN_IF_ERROR(VExpr::prepare(state, desc, context));
+
+    if (_children.size() < 2) {
+        return Status::InternalError("In predicate requires at least 2 children");
+    }
+    ColumnsWithTypeAndName argument_template;
+    argument_template.reserve(_children.size());
+    std::vector<std::string> child_expr_name;
+    argument_template.emplace_back(_children[0]->data_type()->createColumn(),
+                                   _children[0]->data_type(), _children[0]->expr_name());
+    for (int i = 1; i < _children.size(); ++i) {
+        auto child = _children[i];
+        ColumnPtr column = child->get_const_col();
+        if (column == nullptr) {
+            return Status::NotSupported(
+                    fmt::format("In predicate with a not constant value {} is not supported",
+                                child->expr_name()));
+        }
+        argument_template.emplace_back(std::move(column), child->data_type(), child->expr_name());
+        child_expr_name.emplace_back(child->expr_name());
+    }
+
+    const char* function_name = _is_not_in ? "not_in" : "in";
+    _function = SimpleFunctionFactory::instance().get_function(function_name, argument_template);
+    if (_function == nullptr) {
+        return Status::NotSupported(fmt::format("Function {} is not implemented", function_name));
+    }
+    _data_type = _function->getReturnType();
+    _expr_name = fmt::format("({} {} ({}))", _children[0]->expr_name(),
+                             _is_not_in ? "NOT IN" : "IN", fmt::join(child_expr_name, ", "));
+    return Status::OK();
+}
+
+doris::Status VInPredicate::execute(VExprContext* context, doris::vectorized::Block* block,
+                                    int* result_column_id) {
+    // the list is in the function, only x is executed
+    int column_id = -1;
+    RETURN_IF_ERROR(context->execute(_children[0], block, &column_id));
+
+    size_t num_columns_without_result = block->columns();
+    block->insert({nullptr, _data_type, _expr_name});
+    _function->execute(*block, {static_cast<size_t>(column_id)}, num_columns_without_result,
+                       block->rows(), false);
+    *result_column_id = num_columns_without_result;
+    return Status::OK();
+}
+
+const std::string& VInPredicate::expr_name() const {
+    return _expr_name;
+}
+
+bool VInPredicate::equals(const VExpr& other) const {
+    return VExpr::equals(other) && _is_not_in == static_cast<const VInPredicate&>(other)._is_not_in;
+}
+
+} // namespace doris::vectorized
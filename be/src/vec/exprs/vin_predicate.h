@@ -0,0 +1,53 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <string>
+
+#include "vec/exprs/vexpr.h"
+#include "vec/functions/function.h"
+
+namespace doris::vectorized {
+
+// x IN (c1, c2, ...) and x NOT IN (c1, c2, ...) where the list is constant, the FILTER_IN and
+// FILTER_NOT_IN in predicates. The set of the list is built once at prepare by the in or
+// not_in function, only x is executed per block.
+class VInPredicate final : public VExpr {
+public:
+    VInPredicate(const TExprNode& node);
+    ~VInPredicate() = default;
+    virtual doris::Status execute(VExprContext* context, doris::vectorized::Block* block,
+                                  int* result_column_id) override;
+    virtual doris::Status prepare(doris::RuntimeState* state, const doris::RowDescriptor& desc,
+                                  VExprContext* context) override;
+    virtual VExpr* clone(doris::ObjectPool* pool) const override {
+        return pool->add(new VInPredicate(*this));
+    }
+    virtual const std::string& expr_name() const override;
+    virtual bool equals(const VExpr& other) const override;
+
+    bool is_not_in() const { return _is_not_in; }
+
+private:
+    FunctionBasePtr _function;
+    std::string _expr_name;
+
+    const bool _is_not_in;
+};
+
+} // namespace doris::vectorized
@@ -121,11 +121,17 @@ VLiteral::VLiteral(const TExprNode& node) : VExpr(node) {
 
 VLiteral::~VLiteral() {}
 
-Status VLiteral::execute(vectorized::Block* block, int* result_column_id) {
+Status VLiteral::execute(VExprContext* context, vectorized::Block* block,
+                         int* result_column_id) {
     int rows = block->rows();
     size_t res = block->columns();
     block->insert({_column_ptr->cloneResized(rows), _data_type, _expr_name});
     *result_column_id = res;
     return Status::OK();
 }
+
+bool VLiteral::equals(const VExpr& other) const {
+    return VExpr::equals(other) &&
+           (*_column_ptr)[0] == (*static_cast<const VLiteral&>(other)._column_ptr)[0];
+}
 } // namespace doris::vectorized
@@ -58,7 +58,7 @@ Status VSlotRef::prepare(doris::RuntimeState* state, const doris::RowDescriptor&
     return Status::OK();
 }
 
-Status VSlotRef::execute(Block* block, int* result_column_id) {
+Status VSlotRef::execute(VExprContext* context, Block* block, int* result_column_id) {
     DCHECK_GE(_column_id, 0);
     *result_column_id = _column_id;
     return Status::OK();
@@ -68,4 +68,9 @@ const std::string& VSlotRef::expr_name() const {
     return *_column_name;
 }
 
+bool VSlotRef::equals(const VExpr& other) const {
+    return VExpr::equals(other) && _slot_id == static_cast<const VSlotRef&>(other)._slot_id &&
+           _column_id == static_cast<const VSlotRef&>(other)._column_id;
+}
+
 } // namespace doris::vectorized
@@ -27,7 +27,8 @@ class VSlotRef final : public VExpr {
 public:
     VSlotRef(const doris::TExprNode& node);
     VSlotRef(const SlotDescriptor* desc);
-    virtual doris::Status execute(doris::vectorized::Block* block, int* result_column_id);
+    virtual doris::Status execute(VExprContext* context, doris::vectorized::Block* block,
+                                  int* result_column_id);
     virtual doris::Status prepare(doris::RuntimeState* state, const doris::RowDescriptor& desc,
                                   VExprContext* context);
     virtual VExpr* clone(doris::ObjectPool* pool) const override {
@@ -35,6 +36,15 @@ public:
     }
 
     virtual const std::string& expr_name() const override;
+    virtual bool equals(const VExpr& other) const override;
+
+    virtual void collect_slot_column_ids(std::set<int>* column_ids) const override {
+        column_ids->insert(_column_id);
+    }
+
+    int slot_id() const { return _slot_id; }
+
+    int column_id() const { return _column_id; }
 
 private:
     FunctionPtr _function;
@@ -0,0 +1,248 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+
+#pragma once
+
+#include <string.h>
+
+#include "runtime/datetime_value.h"
+#include "vec/common/date_lut.h"
+#include "vec/core/types.h"
+
+namespace doris::vectorized {
+
+/** The DATE and DATETIME columns are ColumnVector<Int128> of packed DateTimeValue, see VLiteral
+  * and VOlapScanner. The transforms below read the fields of the DateTimeValue directly, and do
+  * the calendar math by day number with the lookup table of DateLUTImpl instead of the
+  * per-value computations of DateTimeValue. The values out of the range of the table fall back
+  * to DateTimeValue, with the semantics of the row engine (exprs/timestamp_functions.cpp).
+  */
+
+static_assert(sizeof(DateTimeValue) == sizeof(Int128));
+
+inline DateTimeValue binaryToDateTime(Int128 value) {
+    DateTimeValue res;
+    memcpy(&res, &value, sizeof(value));
+    return res;
+}
+
+inline Int128 dateTimeToBinary(const DateTimeValue& value) {
+    Int128 res;
+    memcpy(&res, &value, sizeof(res));
+    return res;
+}
+
+/// DateTimeValue::daynr (MySQL TO_DAYS) of 1970-01-01, which is the DayNum 0.
+static constexpr Int64 DAYNR_OF_UNIX_EPOCH = 719528;
+
+/// The first and the last year of the table are excluded, so the computations around the
+/// value, e.g. the first day of its ISO year, stay in the table.
+inline bool isInDateLUT(const DateTimeValue& value) {
+    return value.year() > DATE_LUT_MIN_YEAR && value.year() < DATE_LUT_MAX_YEAR &&
+           value.month() > 0 && value.day() > 0;
+}
+
+inline bool isInDateLUT(Int64 day_num) {
+    return day_num > 0 && day_num < DATE_LUT_MAX_DAY_NUM;
+}
+
+inline DayNum toDayNum(const DateTimeValue& value, const DateLUTImpl& date_lut) {
+    return date_lut.makeDayNum(value.year(), value.month(), value.day());
+}
+
+inline void setDayNum(DateTimeValue& value, Int64 day_num, const DateLUTImpl& date_lut) {
+    const auto& values = date_lut.getValues(DayNum(day_num));
+    value.set_date(values.year, values.month, values.day_of_month);
+}
+
+struct ToYearImpl {
+    static inline Int32 execute(const DateTimeValue& value, const DateLUTImpl&) {
+        return value.year();
+    }
+};
+
+struct ToQuarterImpl {
+    static inline Int32 execute(const DateTimeValue& value, const DateLUTImpl&) {
+        return (value.month() - 1) / 3 + 1;
+    }
+};
+
+struct ToMonthImpl {
+    static inline Int32 execute(const DateTimeValue& value, const DateLUTImpl&) {
+        return value.month();
+    }
+};
+
+struct ToDayOfMonthImpl {
+    static inline Int32 execute(const DateTimeValue& value, const DateLUTImpl&) {
+        return value.day();
+    }
+};
+
+struct ToHourImpl {
+    static inline Int32 execute(const DateTimeValue& value, const DateLUTImpl&) {
+        return value.hour();
+    }
+};
+
+struct ToMinuteImpl {
+    static inline Int32 execute(const DateTimeValue& value, const DateLUTImpl&) {
+        return value.minute();
+    }
+};
+
+struct ToSecondImpl {
+    static inline Int32 execute(const DateTimeValue& value, const DateLUTImpl&) {
+        return value.second();
+    }
+};
+
+/// MySQL TO_DAYS, the number of days since year 0.
+struct ToDaysImpl {
+    static inline Int32 execute(const DateTimeValue& value, const DateLUTImpl& date_lut) {
+        if (isInDateLUT(value)) return toDayNum(value, date_lut) + DAYNR_OF_UNIX_EPOCH;
+        return value.daynr();
+    }
+};
+
+/// The date part of a DATETIME as a DATE, which buckets the values by day.
+struct ToDateImpl {
+    static inline Int128 execute(const DateTimeValue& value, const DateLUTImpl&) {
+        DateTimeValue res = value;
+        res.cast_to_date();
+        return dateTimeToBinary(res);
+    }
+};
+
+/// The transforms below return NULL for the invalid dates, e.g. 0000-00-00.
+
+/// 1 = Sunday, 2 = Monday, ..., 7 = Saturday.
+struct ToDayOfWeekImpl {
+    static inline Int32 execute(const DateTimeValue& value, const DateLUTImpl& date_lut,
+                                UInt8& is_null) {
+        /// The day of week of the table is 1 = Monday, ..., 7 = Sunday.
+        if (isInDateLUT(value)) return date_lut.toDayOfWeek(toDayNum(value, date_lut)) % 7 + 1;
+        if (!value.is_valid_date()) {
+            is_null = 1;
+            return 0;
+        }
+        return (value.weekday() + 1) % 7 + 1;
+    }
+};
+
+struct ToDayOfYearImpl {
+    static inline Int32 execute(const DateTimeValue& value, const DateLUTImpl& date_lut,
+                                UInt8& is_null) {
+        if (isInDateLUT(value)) return date_lut.toDayOfYear(toDayNum(value, date_lut));
+        if (!value.is_valid_date()) {
+            is_null = 1;
+            return 0;
+        }
+        return value.day_of_year();
+    }
+};
+
+/// The ISO 8601 week, which is the MySQL week mode 3.
+struct ToWeekOfYearImpl {
+    static inline Int32 execute(const DateTimeValue& value, const DateLUTImpl& date_lut,
+                                UInt8& is_null) {
+        if (isInDateLUT(value)) return date_lut.toISOWeek(toDayNum(value, date_lut));
+        if (!value.is_valid_date()) {
+            is_null = 1;
+            return 0;
+        }
+        return value.week(mysql_week_mode(3));
+    }
+};
+
+/// Add delta units to value, return false if the result is out of range.
+
+template <TimeUnit unit, Int64 days_per_unit>
+struct AddDaysImplBase {
+    static inline bool execute(DateTimeValue& value, Int64 delta, const DateLUTImpl& date_lut) {
+        if (isInDateLUT(value)) {
+            Int64 day_num = toDayNum(value, date_lut) + delta * days_per_unit;
+            if (isInDateLUT(day_num)) {
+                setDayNum(value, day_num, date_lut);
+                return true;
+            }
+        }
+        return value.date_add_interval(TimeInterval(unit, delta, false), unit);
+    }
+};
+
+template <TimeUnit unit, Int64 seconds_per_unit>
+struct AddSecondsImplBase {
+    static inline bool execute(DateTimeValue& value, Int64 delta, const DateLUTImpl& date_lut) {
+        if (isInDateLUT(value)) {
+            Int64 seconds = toDayNum(value, date_lut) * 86400L + value.hour() * 3600L +
+                            value.minute() * 60L + value.second() + delta * seconds_per_unit;
+            Int64 day_num = seconds / 86400;
+            seconds %= 86400;
+            if (seconds < 0) {
+                seconds += 86400;
+                --day_num;
+            }
+            if (isInDateLUT(day_num)) {
+                setDayNum(value, day_num, date_lut);
+                value.set_time(seconds / 3600, seconds / 60 % 60, seconds % 60);
+                value.set_type(TIME_DATETIME);
+                return true;
+            }
+        }
+        return value.date_add_interval(TimeInterval(unit, delta, false), unit);
+    }
+};
+
+/// The day of month is saturated to the last day of the result month.
+template <TimeUnit unit, Int64 months_per_unit>
+struct AddMonthsImplBase {
+    static inline bool execute(DateTimeValue& value, Int64 delta, const DateLUTImpl& date_lut) {
+        if (isInDateLUT(value)) {
+            Int64 months = value.year() * 12L + value.month() - 1 + delta * months_per_unit;
+            Int64 year = months / 12;
+            if (months >= 0 && year > DATE_LUT_MIN_YEAR && year < DATE_LUT_MAX_YEAR) {
+                UInt8 month = months % 12 + 1;
+                UInt8 days_in_month = date_lut.daysInMonth(year, month);
+                value.set_date(year, month, std::min<UInt8>(value.day(), days_in_month));
+                return true;
+            }
+        }
+        return value.date_add_interval(TimeInterval(unit, delta, false), unit);
+    }
+};
+
+using AddDaysImpl = AddDaysImplBase<DAY, 1>;
+using AddWeeksImpl = AddDaysImplBase<WEEK, 7>;
+using AddHoursImpl = AddSecondsImplBase<HOUR, 3600>;
+using AddMinutesImpl = AddSecondsImplBase<MINUTE, 60>;
+using AddSecondsImpl = AddSecondsImplBase<SECOND, 1>;
+using AddMonthsImpl = AddMonthsImplBase<MONTH, 1>;
+using AddYearsImpl = AddMonthsImplBase<YEAR, 12>;
+
+/// The number of days from the date part of right to the one of left.
+struct DateDiffImpl {
+    static inline Int32 execute(const DateTimeValue& left, const DateTimeValue& right,
+                                const DateLUTImpl& date_lut) {
+        if (isInDateLUT(left) && isInDateLUT(right))
+            return toDayNum(left, date_lut) - toDayNum(right, date_lut);
+        return left.daynr() - right.daynr();
+    }
+};
+
+} // namespace doris::vectorized
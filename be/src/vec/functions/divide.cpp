@@ -0,0 +1,53 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#include "vec/functions/function_binary_arithmetic.h"
+#include "vec/functions/simple_function_factory.h"
+
+namespace doris::vectorized {
+
+template <typename A, typename B>
+struct DivideFloatingImpl {
+    using ResultType = std::conditional_t<IsDecimalNumber<A>, A, Float64>;
+    static constexpr bool allow_decimal = true;
+    static constexpr bool allow_float = true;
+    static constexpr bool is_nullable = true;
+    static constexpr bool is_multiply = false;
+    static constexpr bool is_division = true;
+
+    static inline ResultType apply(A a, B b, UInt8& is_null) {
+        /// The quotient of a zero divisor is inf or nan, which is masked by the null map.
+        is_null = b == 0;
+        return static_cast<Float64>(a) / static_cast<Float64>(b);
+    }
+
+    template <typename T>
+    static inline T applyDecimal(T a, T b, T, UInt8& is_null) {
+        is_null = b == 0;
+        return b == 0 ? 0 : divideRoundHalfUp(a, b);
+    }
+};
+
+struct NameDivide {
+    static constexpr auto name = "divide";
+};
+using FunctionDivide = FunctionBinaryArithmetic<DivideFloatingImpl, NameDivide>;
+
+void registerFunctionDivide(SimpleFunctionFactory& factory) {
+    factory.registerFunction<FunctionDivide>();
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,396 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <type_traits>
+
+#include "vec/columns/column_const.h"
+#include "vec/columns/column_decimal.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
+#include "vec/common/arithmetic_overflow.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_types_decimal.h"
+#include "vec/data_types/data_types_number.h"
+#include "vec/data_types/number_traits.h"
+#include "vec/functions/cast_type_to_either.h"
+#include "vec/functions/function.h"
+#include "vec/functions/function_helpers.h"
+
+namespace doris::vectorized {
+
+namespace ErrorCodes {
+extern const int DECIMAL_OVERFLOW;
+extern const int ILLEGAL_COLUMN;
+extern const int ILLEGAL_TYPE_OF_ARGUMENT;
+extern const int LOGICAL_ERROR;
+} // namespace ErrorCodes
+
+/** Binary arithmetic functions: +, -, *, /, %, DIV.
+  *
+  * The FE casts both arguments to a common type, but any two numbers are accepted:
+  * - integers and floats are computed in the common type of the arguments and wrap on
+  *   overflow, like the row engine;
+  * - decimals are computed on their native values in the max scale of the arguments, the
+  *   result overflowing the native type throws DECIMAL_OVERFLOW;
+  * - /, % and DIV return NULL if the divisor is 0.
+  */
+
+/// The common type of A and B, Float64 if ResultOfIf has no such type (e.g. Int64 and Float64).
+template <typename A, typename B>
+struct ResultOfBinaryArithmetic {
+    using IfType = typename NumberTraits::ResultOfIf<A, B>::Type;
+    using Type = std::conditional_t<std::is_same_v<IfType, NumberTraits::Error>, Float64, IfType>;
+};
+
+template <typename A, typename B, typename Op>
+struct BinaryOperationImpl {
+    using ResultType = typename Op::ResultType;
+
+    /// null_map is only written if Op::is_nullable.
+    static void NO_INLINE vector_vector(const PaddedPODArray<A>& a, const PaddedPODArray<B>& b,
+                                        PaddedPODArray<ResultType>& c, UInt8* null_map) {
+        size_t size = a.size();
+        for (size_t i = 0; i < size; ++i) {
+            if constexpr (Op::is_nullable)
+                c[i] = Op::apply(a[i], b[i], null_map[i]);
+            else
+                c[i] = Op::apply(a[i], b[i]);
+        }
+    }
+
+    static void NO_INLINE vector_constant(const PaddedPODArray<A>& a, B b,
+                                          PaddedPODArray<ResultType>& c, UInt8* null_map) {
+        size_t size = a.size();
+        for (size_t i = 0; i < size; ++i) {
+            if constexpr (Op::is_nullable)
+                c[i] = Op::apply(a[i], b, null_map[i]);
+            else
+                c[i] = Op::apply(a[i], b);
+        }
+    }
+
+    static void NO_INLINE constant_vector(A a, const PaddedPODArray<B>& b,
+                                          PaddedPODArray<ResultType>& c, UInt8* null_map) {
+        size_t size = b.size();
+        for (size_t i = 0; i < size; ++i) {
+            if constexpr (Op::is_nullable)
+                c[i] = Op::apply(a, b[i], null_map[i]);
+            else
+                c[i] = Op::apply(a, b[i]);
+        }
+    }
+};
+
+/// Arithmetic on the native values of two decimals. a and b are rescaled by scale_a and
+/// scale_b before Op::applyDecimal, which receives scale_c to rescale its own result.
+template <typename T, typename Op>
+struct DecimalBinaryOperationImpl {
+    using NativeType = typename T::NativeType;
+    using Array = typename ColumnDecimal<T>::Container;
+
+    static NativeType rescale(NativeType x, NativeType scale) {
+        if (scale == 1) return x;
+        NativeType res;
+        if (common::mulOverflow(x, scale, res))
+            throw Exception("Decimal math overflow", ErrorCodes::DECIMAL_OVERFLOW);
+        return res;
+    }
+
+    static NativeType apply(NativeType a, NativeType b, NativeType scale_c, UInt8* null_map,
+                            size_t i) {
+        if constexpr (Op::is_nullable)
+            return Op::applyDecimal(a, b, scale_c, null_map[i]);
+        else
+            return Op::applyDecimal(a, b, scale_c);
+    }
+
+    static void NO_INLINE vector_vector(const Array& a, const Array& b, Array& c,
+                                        NativeType scale_a, NativeType scale_b,
+                                        NativeType scale_c, UInt8* null_map) {
+        size_t size = a.size();
+        for (size_t i = 0; i < size; ++i) {
+            c[i] = apply(rescale(a[i].value, scale_a), rescale(b[i].value, scale_b), scale_c,
+                         null_map, i);
+        }
+    }
+
+    static void NO_INLINE vector_constant(const Array& a, T b, Array& c, NativeType scale_a,
+                                          NativeType scale_b, NativeType scale_c,
+                                          UInt8* null_map) {
+        NativeType b_value = rescale(b.value, scale_b);
+        size_t size = a.size();
+        for (size_t i = 0; i < size; ++i) {
+            c[i] = apply(rescale(a[i].value, scale_a), b_value, scale_c, null_map, i);
+        }
+    }
+
+    static void NO_INLINE constant_vector(T a, const Array& b, Array& c, NativeType scale_a,
+                                          NativeType scale_b, NativeType scale_c,
+                                          UInt8* null_map) {
+        NativeType a_value = rescale(a.value, scale_a);
+        size_t size = b.size();
+        for (size_t i = 0; i < size; ++i) {
+            c[i] = apply(a_value, rescale(b[i].value, scale_b), scale_c, null_map, i);
+        }
+    }
+};
+
+/// a / b rounded half away from zero, like DecimalV2Value. b must not be 0.
+template <typename T>
+inline T divideRoundHalfUp(T a, T b) {
+    T quotient = a / b;
+    T remainder = a % b;
+    T abs_remainder = remainder < 0 ? -remainder : remainder;
+    T abs_b = b < 0 ? -b : b;
+    if (abs_remainder >= abs_b - abs_remainder) quotient += ((a < 0) == (b < 0)) ? 1 : -1;
+    return quotient;
+}
+
+template <template <typename, typename> class Op, typename Name>
+class FunctionBinaryArithmetic : public IFunction {
+    template <typename F>
+    static bool castType(const IDataType* type, F&& f) {
+        return castTypeToEither<DataTypeUInt8, DataTypeUInt16, DataTypeUInt32, DataTypeUInt64,
+                                DataTypeInt8, DataTypeInt16, DataTypeInt32, DataTypeInt64,
+                                DataTypeInt128, DataTypeFloat32, DataTypeFloat64,
+                                DataTypeDecimal<Decimal128>>(type, std::forward<F>(f));
+    }
+
+    template <typename F>
+    static bool castBothTypes(const IDataType* left, const IDataType* right, F&& f) {
+        return castType(left, [&](const auto& left_) {
+            return castType(right, [&](const auto& right_) { return f(left_, right_); });
+        });
+    }
+
+    /// Whether Op is defined on the arguments: decimals only with decimals.
+    template <typename LeftDataType, typename RightDataType>
+    static constexpr bool isValidTypes() {
+        using T0 = typename LeftDataType::FieldType;
+        using T1 = typename RightDataType::FieldType;
+        constexpr bool left_decimal = IsDataTypeDecimal<LeftDataType>;
+        constexpr bool right_decimal = IsDataTypeDecimal<RightDataType>;
+        if constexpr (left_decimal || right_decimal)
+            return left_decimal && right_decimal && Op<T0, T1>::allow_decimal;
+        else if constexpr (std::is_floating_point_v<T0> || std::is_floating_point_v<T1>)
+            return Op<T0, T1>::allow_float;
+        else
+            return true;
+    }
+
+    /// The scale of the result of two decimals, the scale of DECIMALV2 is always 9.
+    static UInt32 resultScale(UInt32 scale_a, UInt32 scale_b) {
+        return scale_a > scale_b ? scale_a : scale_b;
+    }
+
+public:
+    static constexpr auto name = Name::name;
+    static FunctionPtr create() { return std::make_shared<FunctionBinaryArithmetic>(); }
+
+    String getName() const override { return name; }
+
+    size_t getNumberOfArguments() const override { return 2; }
+
+    bool useDefaultImplementationForConstants() const override { return true; }
+
+    DataTypePtr getReturnTypeImpl(const DataTypes& arguments) const override {
+        DataTypePtr type_res;
+        bool valid = castBothTypes(arguments[0].get(), arguments[1].get(),
+                                   [&](const auto& left, const auto& right) {
+            using LeftDataType = std::decay_t<decltype(left)>;
+            using RightDataType = std::decay_t<decltype(right)>;
+            if constexpr (!isValidTypes<LeftDataType, RightDataType>()) {
+                return false;
+            } else if constexpr (IsDataTypeDecimal<LeftDataType>) {
+                type_res = std::make_shared<LeftDataType>(
+                        LeftDataType::maxPrecision(),
+                        resultScale(left.getScale(), right.getScale()));
+                return true;
+            } else {
+                using OpImpl = Op<typename LeftDataType::FieldType,
+                                  typename RightDataType::FieldType>;
+                type_res = std::make_shared<DataTypeNumber<typename OpImpl::ResultType>>();
+                return true;
+            }
+        });
+        if (!valid)
+            throw Exception("Illegal types " + arguments[0]->getName() + " and " +
+                                    arguments[1]->getName() + " of arguments of function " +
+                                    getName(),
+                            ErrorCodes::ILLEGAL_TYPE_OF_ARGUMENT);
+
+        if constexpr (Op<UInt8, UInt8>::is_nullable) return makeNullable(type_res);
+        return type_res;
+    }
+
+    void executeImpl(Block& block, const ColumnNumbers& arguments, size_t result,
+                     size_t input_rows_count) override {
+        const auto& left = block.getByPosition(arguments[0]);
+        const auto& right = block.getByPosition(arguments[1]);
+        bool valid = castBothTypes(left.type.get(), right.type.get(),
+                                   [&](const auto& left_type, const auto& right_type) {
+            using LeftDataType = std::decay_t<decltype(left_type)>;
+            using RightDataType = std::decay_t<decltype(right_type)>;
+            if constexpr (!isValidTypes<LeftDataType, RightDataType>()) {
+                return false;
+            } else if constexpr (IsDataTypeDecimal<LeftDataType>) {
+                return executeDecimal<LeftDataType, RightDataType>(
+                        block, result, input_rows_count, left.column.get(), right.column.get(),
+                        left_type.getScale(), right_type.getScale());
+            } else {
+                return executeNumber<typename LeftDataType::FieldType,
+                                     typename RightDataType::FieldType>(
+                        block, result, input_rows_count, left.column.get(), right.column.get());
+            }
+        });
+        if (!valid)
+            throw Exception(getName() + "'s arguments do not match the expected data types",
+                            ErrorCodes::LOGICAL_ERROR);
+    }
+
+private:
+    template <typename Column, typename Value>
+    static bool getColumnOrConstant(const IColumn* column, const Column*& vector, Value& value) {
+        if ((vector = checkAndGetColumn<Column>(column))) return true;
+        if (auto col_const = checkAndGetColumnConst<Column>(column)) {
+            value = assert_cast<const Column&>(col_const->getDataColumn()).getData()[0];
+            return true;
+        }
+        return false;
+    }
+
+    /// Wrap col_res into a ColumnNullable if Op may return NULL.
+    template <typename OpImpl>
+    static void setResult(Block& block, size_t result, MutableColumnPtr col_res,
+                          ColumnUInt8::MutablePtr null_map) {
+        if constexpr (OpImpl::is_nullable)
+            block.getByPosition(result).column =
+                    ColumnNullable::create(std::move(col_res), std::move(null_map));
+        else
+            block.getByPosition(result).column = std::move(col_res);
+    }
+
+    template <typename T0, typename T1>
+    bool executeNumber(Block& block, size_t result, size_t input_rows_count,
+                       const IColumn* col_left_untyped, const IColumn* col_right_untyped) {
+        using OpImpl = Op<T0, T1>;
+        using Impl = BinaryOperationImpl<T0, T1, OpImpl>;
+        using ResultType = typename OpImpl::ResultType;
+
+        const ColumnVector<T0>* col_left = nullptr;
+        const ColumnVector<T1>* col_right = nullptr;
+        T0 left_value {};
+        T1 right_value {};
+        if (!getColumnOrConstant(col_left_untyped, col_left, left_value))
+            throw Exception("Illegal column " + col_left_untyped->getName() +
+                                    " of first argument of function " + getName(),
+                            ErrorCodes::ILLEGAL_COLUMN);
+        if (!getColumnOrConstant(col_right_untyped, col_right, right_value))
+            throw Exception("Illegal column " + col_right_untyped->getName() +
+                                    " of second argument of function " + getName(),
+                            ErrorCodes::ILLEGAL_COLUMN);
+
+        auto col_res = ColumnVector<ResultType>::create(input_rows_count);
+        auto& vec_res = col_res->getData();
+        ColumnUInt8::MutablePtr col_null_map;
+        UInt8* null_map = nullptr;
+        if constexpr (OpImpl::is_nullable) {
+            col_null_map = ColumnUInt8::create(input_rows_count, 0);
+            null_map = col_null_map->getData().data();
+        }
+
+        if (col_left && col_right)
+            Impl::vector_vector(col_left->getData(), col_right->getData(), vec_res, null_map);
+        else if (col_left)
+            Impl::vector_constant(col_left->getData(), right_value, vec_res, null_map);
+        else if (col_right)
+            Impl::constant_vector(left_value, col_right->getData(), vec_res, null_map);
+        else
+            return false;
+
+        setResult<OpImpl>(block, result, std::move(col_res), std::move(col_null_map));
+        return true;
+    }
+
+    template <typename LeftDataType, typename RightDataType>
+    bool executeDecimal(Block& block, size_t result, size_t input_rows_count,
+                        const IColumn* col_left_untyped, const IColumn* col_right_untyped,
+                        UInt32 scale_left, UInt32 scale_right) {
+        using T0 = typename LeftDataType::FieldType;
+        using T1 = typename RightDataType::FieldType;
+        static_assert(std::is_same_v<T0, T1>);
+        using OpImpl = Op<T0, T1>;
+        using Impl = DecimalBinaryOperationImpl<T0, OpImpl>;
+        using NativeType = typename T0::NativeType;
+
+        const ColumnDecimal<T0>* col_left = nullptr;
+        const ColumnDecimal<T1>* col_right = nullptr;
+        T0 left_value {};
+        T1 right_value {};
+        if (!getColumnOrConstant(col_left_untyped, col_left, left_value))
+            throw Exception("Illegal column " + col_left_untyped->getName() +
+                                    " of first argument of function " + getName(),
+                            ErrorCodes::ILLEGAL_COLUMN);
+        if (!getColumnOrConstant(col_right_untyped, col_right, right_value))
+            throw Exception("Illegal column " + col_right_untyped->getName() +
+                                    " of second argument of function " + getName(),
+                            ErrorCodes::ILLEGAL_COLUMN);
+
+        UInt32 scale_result = resultScale(scale_left, scale_right);
+        NativeType scale_a = 1;
+        NativeType scale_b = 1;
+        NativeType scale_c = 1;
+        if constexpr (OpImpl::is_multiply) {
+            /// a * b has the scale scale_left + scale_right.
+            scale_c = LeftDataType::getScaleMultiplier(scale_left + scale_right - scale_result);
+        } else if constexpr (OpImpl::is_division) {
+            /// a * 10^(scale_result + scale_right - scale_left) / b has the scale scale_result.
+            scale_a = LeftDataType::getScaleMultiplier(scale_result + scale_right - scale_left);
+        } else {
+            scale_a = LeftDataType::getScaleMultiplier(scale_result - scale_left);
+            scale_b = LeftDataType::getScaleMultiplier(scale_result - scale_right);
+        }
+
+        auto col_res = ColumnDecimal<T0>::create(input_rows_count, scale_result);
+        auto& vec_res = col_res->getData();
+        ColumnUInt8::MutablePtr col_null_map;
+        UInt8* null_map = nullptr;
+        if constexpr (OpImpl::is_nullable) {
+            col_null_map = ColumnUInt8::create(input_rows_count, 0);
+            null_map = col_null_map->getData().data();
+        }
+
+        if (col_left && col_right)
+            Impl::vector_vector(col_left->getData(), col_right->getData(), vec_res, scale_a,
+                                scale_b, scale_c, null_map);
+        else if (col_left)
+            Impl::vector_constant(col_left->getData(), right_value, vec_res, scale_a, scale_b,
+                                  scale_c, null_map);
+        else if (col_right)
+            Impl::constant_vector(left_value, col_right->getData(), vec_res, scale_a, scale_b,
+                                  scale_c, null_map);
+        else
+            return false;
+
+        setResult<OpImpl>(block, result, std::move(col_res), std::move(col_null_map));
+        return true;
+    }
+};
+
+} // namespace doris::vectorized
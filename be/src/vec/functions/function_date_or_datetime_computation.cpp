@@ -0,0 +1,109 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+
+#include "vec/functions/function_date_or_datetime_computation.h"
+
+#include "vec/functions/simple_function_factory.h"
+
+namespace doris::vectorized {
+
+struct NameYearsAdd {
+    static constexpr auto name = "years_add";
+};
+struct NameYearsSub {
+    static constexpr auto name = "years_sub";
+};
+struct NameMonthsAdd {
+    static constexpr auto name = "months_add";
+};
+struct NameMonthsSub {
+    static constexpr auto name = "months_sub";
+};
+struct NameWeeksAdd {
+    static constexpr auto name = "weeks_add";
+};
+struct NameWeeksSub {
+    static constexpr auto name = "weeks_sub";
+};
+struct NameDaysAdd {
+    static constexpr auto name = "days_add";
+};
+struct NameDaysSub {
+    static constexpr auto name = "days_sub";
+};
+struct NameHoursAdd {
+    static constexpr auto name = "hours_add";
+};
+struct NameHoursSub {
+    static constexpr auto name = "hours_sub";
+};
+struct NameMinutesAdd {
+    static constexpr auto name = "minutes_add";
+};
+struct NameMinutesSub {
+    static constexpr auto name = "minutes_sub";
+};
+struct NameSecondsAdd {
+    static constexpr auto name = "seconds_add";
+};
+struct NameSecondsSub {
+    static constexpr auto name = "seconds_sub";
+};
+
+using FunctionYearsAdd = FunctionDateOrDateTimeComputation<AddYearsImpl, NameYearsAdd, false>;
+using FunctionYearsSub = FunctionDateOrDateTimeComputation<AddYearsImpl, NameYearsSub, true>;
+using FunctionMonthsAdd = FunctionDateOrDateTimeComputation<AddMonthsImpl, NameMonthsAdd, false>;
+using FunctionMonthsSub = FunctionDateOrDateTimeComputation<AddMonthsImpl, NameMonthsSub, true>;
+using FunctionWeeksAdd = FunctionDateOrDateTimeComputation<AddWeeksImpl, NameWeeksAdd, false>;
+using FunctionWeeksSub = FunctionDateOrDateTimeComputation<AddWeeksImpl, NameWeeksSub, true>;
+using FunctionDaysAdd = FunctionDateOrDateTimeComputation<AddDaysImpl, NameDaysAdd, false>;
+using FunctionDaysSub = FunctionDateOrDateTimeComputation<AddDaysImpl, NameDaysSub, true>;
+using FunctionHoursAdd = FunctionDateOrDateTimeComputation<AddHoursImpl, NameHoursAdd, false>;
+using FunctionHoursSub = FunctionDateOrDateTimeComputation<AddHoursImpl, NameHoursSub, true>;
+using FunctionMinutesAdd =
+        FunctionDateOrDateTimeComputation<AddMinutesImpl, NameMinutesAdd, false>;
+using FunctionMinutesSub = FunctionDateOrDateTimeComputation<AddMinutesImpl, NameMinutesSub, true>;
+using FunctionSecondsAdd =
+        FunctionDateOrDateTimeComputation<AddSecondsImpl, NameSecondsAdd, false>;
+using FunctionSecondsSub = FunctionDateOrDateTimeComputation<AddSecondsImpl, NameSecondsSub, true>;
+
+void registerFunctionDateTimeComputation(SimpleFunctionFactory& factory) {
+    factory.registerFunction<FunctionYearsAdd>();
+    factory.registerFunction<FunctionYearsSub>();
+    factory.registerFunction<FunctionMonthsAdd>();
+    factory.registerAlias(NameMonthsAdd::name, "add_months");
+    factory.registerFunction<FunctionMonthsSub>();
+    factory.registerFunction<FunctionWeeksAdd>();
+    factory.registerFunction<FunctionWeeksSub>();
+    factory.registerFunction<FunctionDaysAdd>();
+    factory.registerAlias(NameDaysAdd::name, "date_add");
+    factory.registerAlias(NameDaysAdd::name, "adddate");
+    factory.registerFunction<FunctionDaysSub>();
+    factory.registerAlias(NameDaysSub::name, "date_sub");
+    factory.registerAlias(NameDaysSub::name, "subdate");
+    factory.registerFunction<FunctionHoursAdd>();
+    factory.registerFunction<FunctionHoursSub>();
+    factory.registerFunction<FunctionMinutesAdd>();
+    factory.registerFunction<FunctionMinutesSub>();
+    factory.registerFunction<FunctionSecondsAdd>();
+    factory.registerFunction<FunctionSecondsSub>();
+    factory.registerFunction<FunctionDateDiff>();
+    factory.registerFunction<FunctionDateFormat>();
+}
+
+} // namespace doris::vectorized
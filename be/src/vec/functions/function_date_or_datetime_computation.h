@@ -0,0 +1,272 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+
+#pragma once
+
+#include <string_view>
+
+#include "vec/columns/column_const.h"
+#include "vec/columns/column_string.h"
+#include "vec/data_types/data_type_string.h"
+#include "vec/functions/function_date_or_datetime_to_something.h"
+
+namespace doris::vectorized {
+
+/// DATETIME + INT units, or DATETIME - INT units if is_sub. The result is NULL if it is out of
+/// the range of DATETIME.
+template <typename Transform, typename Name, bool is_sub>
+class FunctionDateOrDateTimeComputation : public IFunction {
+public:
+    static constexpr auto name = Name::name;
+    static FunctionPtr create() { return std::make_shared<FunctionDateOrDateTimeComputation>(); }
+
+    String getName() const override { return name; }
+
+    size_t getNumberOfArguments() const override { return 2; }
+
+    bool useDefaultImplementationForConstants() const override { return true; }
+
+    DataTypePtr getReturnTypeImpl(const DataTypes& arguments) const override {
+        checkDateTimeArgument(arguments[0], 0, getName());
+        if (!WhichDataType(arguments[1]).isInt32()) {
+            throw Exception("Illegal type " + arguments[1]->getName() +
+                                    " of second argument of function " + getName(),
+                            ErrorCodes::ILLEGAL_TYPE_OF_ARGUMENT);
+        }
+        return makeNullable(std::make_shared<DataTypeInt128>());
+    }
+
+    void executeImpl(Block& block, const ColumnNumbers& arguments, size_t result,
+                     size_t input_rows_count) override {
+        const ColumnPtr col_from =
+                block.getByPosition(arguments[0]).column->convertToFullColumnIfConst();
+        const auto& vec_from = getDateTimeColumn(col_from, getName()).getData();
+        const IColumn* col_delta = block.getByPosition(arguments[1]).column.get();
+
+        auto col_to = ColumnVector<Int128>::create(input_rows_count);
+        auto col_null_map = ColumnUInt8::create(input_rows_count, 0);
+        if (auto col_delta_const = checkAndGetColumnConst<ColumnInt32>(col_delta)) {
+            Int64 delta = col_delta_const->template getValue<Int32>();
+            for (size_t i = 0; i < input_rows_count; ++i) {
+                execute(vec_from[i], delta, col_to->getData()[i], col_null_map->getData()[i]);
+            }
+        } else if (auto col_delta_vector = checkAndGetColumn<ColumnInt32>(col_delta)) {
+            const auto& vec_delta = col_delta_vector->getData();
+            for (size_t i = 0; i < input_rows_count; ++i) {
+                execute(vec_from[i], vec_delta[i], col_to->getData()[i],
+                        col_null_map->getData()[i]);
+            }
+        } else {
+            throw Exception("Illegal column " + col_delta->getName() +
+                                    " of second argument of function " + getName(),
+                            ErrorCodes::ILLEGAL_COLUMN);
+        }
+        block.getByPosition(result).column =
+                ColumnNullable::create(std::move(col_to), std::move(col_null_map));
+    }
+
+private:
+    static inline void execute(Int128 from, Int64 delta, Int128& to, UInt8& is_null) {
+        DateTimeValue value = binaryToDateTime(from);
+        if (Transform::execute(value, is_sub ? -delta : delta, DateLUT::instance())) {
+            to = dateTimeToBinary(value);
+        } else {
+            is_null = 1;
+        }
+    }
+};
+
+/// datediff(DATETIME, DATETIME), the number of days between the date parts.
+class FunctionDateDiff : public IFunction {
+public:
+    static constexpr auto name = "datediff";
+    static FunctionPtr create() { return std::make_shared<FunctionDateDiff>(); }
+
+    String getName() const override { return name; }
+
+    size_t getNumberOfArguments() const override { return 2; }
+
+    bool useDefaultImplementationForConstants() const override { return true; }
+
+    DataTypePtr getReturnTypeImpl(const DataTypes& arguments) const override {
+        checkDateTimeArgument(arguments[0], 0, getName());
+        checkDateTimeArgument(arguments[1], 1, getName());
+        return std::make_shared<DataTypeInt32>();
+    }
+
+    void executeImpl(Block& block, const ColumnNumbers& arguments, size_t result,
+                     size_t input_rows_count) override {
+        const ColumnPtr col_left =
+                block.getByPosition(arguments[0]).column->convertToFullColumnIfConst();
+        const ColumnPtr col_right =
+                block.getByPosition(arguments[1]).column->convertToFullColumnIfConst();
+        const auto& vec_left = getDateTimeColumn(col_left, getName()).getData();
+        const auto& vec_right = getDateTimeColumn(col_right, getName()).getData();
+        const auto& date_lut = DateLUT::instance();
+
+        auto col_res = ColumnInt32::create(input_rows_count);
+        auto& res = col_res->getData();
+        for (size_t i = 0; i < input_rows_count; ++i) {
+            res[i] = DateDiffImpl::execute(binaryToDateTime(vec_left[i]),
+                                           binaryToDateTime(vec_right[i]), date_lut);
+        }
+        block.getByPosition(result).column = std::move(col_res);
+    }
+};
+
+/// date_format(DATETIME, VARCHAR) with the MySQL format specifiers, see
+/// DateTimeValue::to_format_string. The result is NULL if the format is invalid or too long.
+class FunctionDateFormat : public IFunction {
+public:
+    static constexpr auto name = "date_format";
+    static FunctionPtr create() { return std::make_shared<FunctionDateFormat>(); }
+
+    String getName() const override { return name; }
+
+    size_t getNumberOfArguments() const override { return 2; }
+
+    bool useDefaultImplementationForConstants() const override { return true; }
+
+    DataTypePtr getReturnTypeImpl(const DataTypes& arguments) const override {
+        checkDateTimeArgument(arguments[0], 0, getName());
+        if (!isString(arguments[1])) {
+            throw Exception("Illegal type " + arguments[1]->getName() +
+                                    " of second argument of function " + getName(),
+                            ErrorCodes::ILLEGAL_TYPE_OF_ARGUMENT);
+        }
+        return makeNullable(std::make_shared<DataTypeString>());
+    }
+
+    void executeImpl(Block& block, const ColumnNumbers& arguments, size_t result,
+                     size_t input_rows_count) override {
+        const ColumnPtr col_from =
+                block.getByPosition(arguments[0]).column->convertToFullColumnIfConst();
+        const auto& vec_from = getDateTimeColumn(col_from, getName()).getData();
+        const IColumn* col_format = block.getByPosition(arguments[1]).column.get();
+
+        auto col_res = ColumnString::create();
+        auto col_null_map = ColumnUInt8::create(input_rows_count, 0);
+        auto& null_map = col_null_map->getData();
+        if (auto col_format_const = checkAndGetColumnConst<ColumnString>(col_format)) {
+            StringRef format = convertFormat(col_format_const->getDataAt(0));
+            bool is_valid = isValidFormat(format);
+            for (size_t i = 0; i < input_rows_count; ++i) {
+                formatOne(vec_from[i], format, is_valid, *col_res, null_map[i]);
+            }
+        } else if (auto col_format_vector = checkAndGetColumn<ColumnString>(col_format)) {
+            for (size_t i = 0; i < input_rows_count; ++i) {
+                StringRef format = convertFormat(col_format_vector->getDataAt(i));
+                formatOne(vec_from[i], format, isValidFormat(format), *col_res, null_map[i]);
+            }
+        } else {
+            throw Exception("Illegal column " + col_format->getName() +
+                                    " of second argument of function " + getName(),
+                            ErrorCodes::ILLEGAL_COLUMN);
+        }
+        block.getByPosition(result).column =
+                ColumnNullable::create(std::move(col_res), std::move(col_null_map));
+    }
+
+private:
+    static constexpr size_t MAX_FORMAT_LENGTH = 128;
+
+    /// The Java style formats supported by the row engine.
+    static StringRef convertFormat(StringRef format) {
+        std::string_view format_view(format.data, format.size);
+        if (format_view == "yyyyMMdd") return StringRef("%Y%m%d", 6);
+        if (format_view == "yyyy-MM-dd") return StringRef("%Y-%m-%d", 8);
+        if (format_view == "yyyy-MM-dd HH:mm:ss") return StringRef("%Y-%m-%d %H:%i:%s", 17);
+        return format;
+    }
+
+    /// The longest value a specifier is formatted to by DateTimeValue::to_format_string.
+    static size_t maxSpecifierLength(char specifier) {
+        switch (specifier) {
+        case 'r':
+            return 11; /// hh:mm:ss AM
+        case 'M':
+        case 'W':
+            return 9; /// September, Wednesday
+        case 'T':
+            return 8;
+        case 'f':
+            return 6;
+        case 'x':
+        case 'X':
+            return 5; /// the year of the week may be the year after 9999
+        case 'D':
+        case 'Y':
+            return 4;
+        case 'a':
+        case 'b':
+        case 'j':
+            return 3;
+        case 'w':
+            return 1;
+        case 'c':
+        case 'd':
+        case 'e':
+        case 'h':
+        case 'H':
+        case 'i':
+        case 'I':
+        case 'k':
+        case 'l':
+        case 'm':
+        case 'p':
+        case 's':
+        case 'S':
+        case 'u':
+        case 'U':
+        case 'v':
+        case 'V':
+        case 'y':
+            return 2;
+        default:
+            return 1;
+        }
+    }
+
+    /// The formatted value, with its terminating zero, has to fit in the buffer of formatOne.
+    /// DateTimeValue::compute_format_len counts a specifier as one byte, so the upper bound
+    /// of the length is computed here.
+    static bool isValidFormat(StringRef format) {
+        size_t length = 0;
+        for (size_t i = 0; i < format.size; ++i) {
+            if (format.data[i] == '%' && i + 1 < format.size) {
+                length += maxSpecifierLength(format.data[++i]);
+            } else {
+                ++length;
+            }
+        }
+        return length < MAX_FORMAT_LENGTH;
+    }
+
+    static void formatOne(Int128 from, StringRef format, bool is_valid, ColumnString& res,
+                           UInt8& is_null) {
+        char buf[MAX_FORMAT_LENGTH];
+        if (is_valid && binaryToDateTime(from).to_format_string(format.data, format.size, buf)) {
+            res.insertData(buf, strlen(buf));
+        } else {
+            res.insertDefault();
+            is_null = 1;
+        }
+    }
+};
+
+} // namespace doris::vectorized
@@ -0,0 +1,100 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+
+#pragma once
+
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_types_number.h"
+#include "vec/functions/date_time_transforms.h"
+#include "vec/functions/function.h"
+#include "vec/functions/function_helpers.h"
+
+namespace doris::vectorized {
+
+namespace ErrorCodes {
+extern const int ILLEGAL_COLUMN;
+extern const int ILLEGAL_TYPE_OF_ARGUMENT;
+} // namespace ErrorCodes
+
+inline void checkDateTimeArgument(const DataTypePtr& type, size_t index,
+                                  const String& function_name) {
+    if (!WhichDataType(type).isInt128()) {
+        throw Exception("Illegal type " + type->getName() + " of argument " +
+                                std::to_string(index + 1) + " of function " + function_name +
+                                ", should be a DATE or DATETIME",
+                        ErrorCodes::ILLEGAL_TYPE_OF_ARGUMENT);
+    }
+}
+
+inline const ColumnVector<Int128>& getDateTimeColumn(const ColumnPtr& column,
+                                                    const String& function_name) {
+    if (auto col = checkAndGetColumn<ColumnVector<Int128>>(column.get())) return *col;
+    throw Exception("Illegal column " + column->getName() + " of argument of function " +
+                            function_name,
+                    ErrorCodes::ILLEGAL_COLUMN);
+}
+
+/// Transform a DATE or DATETIME to a number or another DATE or DATETIME. If is_nullable,
+/// Transform::execute sets is_null for the values without result.
+template <typename ToDataType, typename Transform, typename Name, bool is_nullable = false>
+class FunctionDateOrDateTimeToSomething : public IFunction {
+public:
+    static constexpr auto name = Name::name;
+    static FunctionPtr create() { return std::make_shared<FunctionDateOrDateTimeToSomething>(); }
+
+    String getName() const override { return name; }
+
+    size_t getNumberOfArguments() const override { return 1; }
+
+    bool useDefaultImplementationForConstants() const override { return true; }
+
+    DataTypePtr getReturnTypeImpl(const DataTypes& arguments) const override {
+        checkDateTimeArgument(arguments[0], 0, getName());
+        DataTypePtr type = std::make_shared<ToDataType>();
+        return is_nullable ? makeNullable(type) : type;
+    }
+
+    void executeImpl(Block& block, const ColumnNumbers& arguments, size_t result,
+                     size_t input_rows_count) override {
+        const auto& vec_from =
+                getDateTimeColumn(block.getByPosition(arguments[0]).column, getName()).getData();
+        const auto& date_lut = DateLUT::instance();
+
+        auto col_to = ColumnVector<typename ToDataType::FieldType>::create(input_rows_count);
+        auto& vec_to = col_to->getData();
+        if constexpr (is_nullable) {
+            auto col_null_map = ColumnUInt8::create(input_rows_count, 0);
+            auto& null_map = col_null_map->getData();
+            for (size_t i = 0; i < input_rows_count; ++i) {
+                vec_to[i] = Transform::execute(binaryToDateTime(vec_from[i]), date_lut,
+                                               null_map[i]);
+            }
+            block.getByPosition(result).column =
+                    ColumnNullable::create(std::move(col_to), std::move(col_null_map));
+        } else {
+            for (size_t i = 0; i < input_rows_count; ++i) {
+                vec_to[i] = Transform::execute(binaryToDateTime(vec_from[i]), date_lut);
+            }
+            block.getByPosition(result).column = std::move(col_to);
+        }
+    }
+};
+
+} // namespace doris::vectorized
@@ -0,0 +1,95 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#include "vec/functions/function_string.h"
+
+#include "vec/functions/simple_function_factory.h"
+
+namespace doris::vectorized {
+
+struct NameLength {
+    static constexpr auto name = "length";
+};
+struct NameCharLength {
+    static constexpr auto name = "char_length";
+};
+struct NameLower {
+    static constexpr auto name = "lower";
+};
+struct NameUpper {
+    static constexpr auto name = "upper";
+};
+struct NameReverse {
+    static constexpr auto name = "reverse";
+};
+struct NameTrim {
+    static constexpr auto name = "trim";
+};
+struct NameLTrim {
+    static constexpr auto name = "ltrim";
+};
+struct NameRTrim {
+    static constexpr auto name = "rtrim";
+};
+struct NameStartsWith {
+    static constexpr auto name = "starts_with";
+};
+struct NameEndsWith {
+    static constexpr auto name = "ends_with";
+};
+struct NameInstr {
+    static constexpr auto name = "instr";
+};
+
+using FunctionLength = FunctionStringToNumber<LengthImpl, NameLength, Int32>;
+using FunctionCharLength = FunctionStringToNumber<CharLengthImpl, NameCharLength, Int32>;
+using FunctionLower = FunctionStringToString<LowerUpperImpl<'A', 'Z'>, NameLower>;
+using FunctionUpper = FunctionStringToString<LowerUpperImpl<'a', 'z'>, NameUpper>;
+using FunctionReverse = FunctionStringToString<ReverseImpl, NameReverse>;
+using FunctionTrim = FunctionStringToString<TrimImpl<true, true>, NameTrim>;
+using FunctionLTrim = FunctionStringToString<TrimImpl<true, false>, NameLTrim>;
+using FunctionRTrim = FunctionStringToString<TrimImpl<false, true>, NameRTrim>;
+using FunctionStartsWith = FunctionStringsToNumber<StartsWithImpl, NameStartsWith, UInt8>;
+using FunctionEndsWith = FunctionStringsToNumber<EndsWithImpl, NameEndsWith, UInt8>;
+using FunctionInstr = FunctionStringsToNumber<InstrImpl, NameInstr, Int32>;
+
+void registerFunctionString(SimpleFunctionFactory& factory) {
+    factory.registerFunction<FunctionLength>();
+    factory.registerFunction<FunctionCharLength>();
+    factory.registerAlias(FunctionCharLength::name, "character_length");
+    factory.registerFunction<FunctionLower>();
+    factory.registerAlias(FunctionLower::name, "lcase");
+    factory.registerFunction<FunctionUpper>();
+    factory.registerAlias(FunctionUpper::name, "ucase");
+    factory.registerFunction<FunctionReverse>();
+    factory.registerFunction<FunctionTrim>();
+    factory.registerFunction<FunctionLTrim>();
+    factory.registerFunction<FunctionRTrim>();
+    factory.registerFunction<FunctionSubstring<SubstringImpl>>();
+    factory.registerAlias(SubstringImpl::name, "substr");
+    factory.registerFunction<FunctionSubstring<LeftImpl>>();
+    factory.registerAlias(LeftImpl::name, "strleft");
+    factory.registerFunction<FunctionSubstring<RightImpl>>();
+    factory.registerAlias(RightImpl::name, "strright");
+    factory.registerFunction<FunctionConcat>();
+    factory.registerFunction<FunctionStartsWith>();
+    factory.registerFunction<FunctionEndsWith>();
+    factory.registerFunction<FunctionInstr>();
+    factory.registerFunction<FunctionLocate>();
+    factory.registerFunction<FunctionSplitPart>();
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,678 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#pragma once
+
+#include <string.h>
+
+#include <memory>
+
+#include "vec/columns/column_const.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/columns_number.h"
+#include "vec/common/assert_cast.h"
+#include "vec/common/find_symbols.h"
+#include "vec/common/memcpy_small.h"
+#include "vec/common/string_ref.h"
+#include "vec/common/utf8_helpers.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_string.h"
+#include "vec/data_types/data_types_number.h"
+#include "vec/functions/function.h"
+#include "vec/functions/function_helpers.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace doris::vectorized {
+
+namespace ErrorCodes {
+extern const int ILLEGAL_COLUMN;
+extern const int ILLEGAL_TYPE_OF_ARGUMENT;
+extern const int NUMBER_OF_ARGUMENTS_DOESNT_MATCH;
+} // namespace ErrorCodes
+
+/** String functions working on the chars and offsets of ColumnString, with the semantics of
+  * the row engine (exprs/string_functions.cpp).
+  *
+  * The result chars of a block are allocated once, for the functions whose result is a part of
+  * the argument the chars of the argument are an upper bound of the result.
+  */
+
+/// A String argument, which is a ColumnString or a constant one.
+class StringArgument {
+public:
+    StringArgument(const IColumn* column, const String& function_name) {
+        if (auto col_const = checkAndGetColumnConst<ColumnString>(column)) {
+            data = &assert_cast<const ColumnString&>(col_const->getDataColumn());
+            is_const = true;
+        } else if (!(data = checkAndGetColumn<ColumnString>(column))) {
+            throw Exception("Illegal column " + column->getName() + " of argument of function " +
+                                    function_name,
+                            ErrorCodes::ILLEGAL_COLUMN);
+        }
+    }
+
+    StringRef operator[](size_t row) const { return data->getDataAt(is_const ? 0 : row); }
+
+    /// The total size of the strings of rows rows without the terminating zeros.
+    size_t totalSize(size_t rows) const {
+        return is_const ? data->getDataAt(0).size * rows : data->getChars().size() - rows;
+    }
+
+    bool isConst() const { return is_const; }
+
+private:
+    const ColumnString* data = nullptr;
+    bool is_const = false;
+};
+
+/// An INT argument, which is a ColumnInt32 or a constant one.
+class IntArgument {
+public:
+    explicit IntArgument(Int32 value_) : value(value_), data(&value), is_const(true) {}
+
+    IntArgument(const IColumn* column, const String& function_name) {
+        if (auto col_const = checkAndGetColumnConst<ColumnInt32>(column)) {
+            value = assert_cast<const ColumnInt32&>(col_const->getDataColumn()).getData()[0];
+            data = &value;
+            is_const = true;
+        } else if (auto col = checkAndGetColumn<ColumnInt32>(column)) {
+            data = col->getData().data();
+        } else {
+            throw Exception("Illegal column " + column->getName() + " of argument of function " +
+                                    function_name,
+                            ErrorCodes::ILLEGAL_COLUMN);
+        }
+    }
+
+    IntArgument(const IntArgument&) = delete;
+    IntArgument& operator=(const IntArgument&) = delete;
+
+    Int32 operator[](size_t row) const { return data[is_const ? 0 : row]; }
+
+private:
+    Int32 value = 0;
+    const Int32* data = nullptr;
+    bool is_const = false;
+};
+
+/// Write the string and its terminating zero at res_chars[res_offset] and advance res_offset.
+/// res_chars must be large enough, up to 15 bytes after the string may be overwritten.
+inline void writeString(StringRef s, ColumnString::Chars& res_chars,
+                        ColumnString::Offset& res_offset) {
+    memcpySmallAllowReadWriteOverflow15(&res_chars[res_offset], s.data, s.size);
+    res_offset += s.size;
+    res_chars[res_offset] = 0;
+    ++res_offset;
+}
+
+inline void checkStringArguments(const DataTypes& arguments, size_t number,
+                                 const String& function_name) {
+    for (size_t i = 0; i < number; ++i) {
+        if (!isString(arguments[i]))
+            throw Exception("Illegal type " + arguments[i]->getName() + " of argument " +
+                                    std::to_string(i + 1) + " of function " + function_name,
+                            ErrorCodes::ILLEGAL_TYPE_OF_ARGUMENT);
+    }
+}
+
+inline void checkIntArgument(const DataTypes& arguments, size_t i, const String& function_name) {
+    if (!WhichDataType(arguments[i]).isInt32())
+        throw Exception("Illegal type " + arguments[i]->getName() + " of argument " +
+                                std::to_string(i + 1) + " of function " + function_name,
+                        ErrorCodes::ILLEGAL_TYPE_OF_ARGUMENT);
+}
+
+/// The first occurrence of needle in s from the byte from, or nullptr.
+inline const char* findSubstring(StringRef s, size_t from, StringRef needle) {
+    if (from > s.size) return nullptr;
+    return static_cast<const char*>(memmem(s.data + from, s.size - from, needle.data, needle.size));
+}
+
+/// Functions of one String argument returning a String.
+template <typename Impl, typename Name>
+class FunctionStringToString : public IFunction {
+public:
+    static constexpr auto name = Name::name;
+    static FunctionPtr create() { return std::make_shared<FunctionStringToString>(); }
+
+    String getName() const override { return name; }
+
+    size_t getNumberOfArguments() const override { return 1; }
+
+    bool useDefaultImplementationForConstants() const override { return true; }
+
+    DataTypePtr getReturnTypeImpl(const DataTypes& arguments) const override {
+        checkStringArguments(arguments, 1, getName());
+        return std::make_shared<DataTypeString>();
+    }
+
+    void executeImpl(Block& block, const ColumnNumbers& arguments, size_t result,
+                     size_t /*input_rows_count*/) override {
+        const ColumnPtr& column = block.getByPosition(arguments[0]).column;
+        if (const ColumnString* col = checkAndGetColumn<ColumnString>(column.get())) {
+            auto col_res = ColumnString::create();
+            Impl::vector(col->getChars(), col->getOffsets(), col_res->getChars(),
+                         col_res->getOffsets());
+            block.getByPosition(result).column = std::move(col_res);
+        } else {
+            throw Exception("Illegal column " + column->getName() + " of argument of function " +
+                                    getName(),
+                            ErrorCodes::ILLEGAL_COLUMN);
+        }
+    }
+};
+
+/// Functions of one String argument returning a number.
+template <typename Impl, typename Name, typename ResultType>
+class FunctionStringToNumber : public IFunction {
+public:
+    static constexpr auto name = Name::name;
+    static FunctionPtr create() { return std::make_shared<FunctionStringToNumber>(); }
+
+    String getName() const override { return name; }
+
+    size_t getNumberOfArguments() const override { return 1; }
+
+    bool useDefaultImplementationForConstants() const override { return true; }
+
+    DataTypePtr getReturnTypeImpl(const DataTypes& arguments) const override {
+        checkStringArguments(arguments, 1, getName());
+        return std::make_shared<DataTypeNumber<ResultType>>();
+    }
+
+    void executeImpl(Block& block, const ColumnNumbers& arguments, size_t result,
+                     size_t /*input_rows_count*/) override {
+        const ColumnPtr& column = block.getByPosition(arguments[0]).column;
+        if (const ColumnString* col = checkAndGetColumn<ColumnString>(column.get())) {
+            auto col_res = ColumnVector<ResultType>::create(col->size());
+            Impl::vector(col->getChars(), col->getOffsets(), col_res->getData());
+            block.getByPosition(result).column = std::move(col_res);
+        } else {
+            throw Exception("Illegal column " + column->getName() + " of argument of function " +
+                                    getName(),
+                            ErrorCodes::ILLEGAL_COLUMN);
+        }
+    }
+};
+
+/// Functions of two String arguments returning a number, Impl::apply is called per row.
+template <typename Impl, typename Name, typename ResultType>
+class FunctionStringsToNumber : public IFunction {
+public:
+    static constexpr auto name = Name::name;
+    static FunctionPtr create() { return std::make_shared<FunctionStringsToNumber>(); }
+
+    String getName() const override { return name; }
+
+    size_t getNumberOfArguments() const override { return 2; }
+
+    bool useDefaultImplementationForConstants() const override { return true; }
+
+    DataTypePtr getReturnTypeImpl(const DataTypes& arguments) const override {
+        checkStringArguments(arguments, 2, getName());
+        return std::make_shared<DataTypeNumber<ResultType>>();
+    }
+
+    void executeImpl(Block& block, const ColumnNumbers& arguments, size_t result,
+                     size_t input_rows_count) override {
+        StringArgument left(block.getByPosition(arguments[0]).column.get(), getName());
+        StringArgument right(block.getByPosition(arguments[1]).column.get(), getName());
+
+        auto col_res = ColumnVector<ResultType>::create(input_rows_count);
+        auto& res = col_res->getData();
+        for (size_t i = 0; i < input_rows_count; ++i) {
+            res[i] = Impl::apply(left[i], right[i]);
+        }
+        block.getByPosition(result).column = std::move(col_res);
+    }
+};
+
+struct LengthImpl {
+    static void vector(const ColumnString::Chars& /*data*/, const ColumnString::Offsets& offsets,
+                       PaddedPODArray<Int32>& res) {
+        size_t size = offsets.size();
+        for (size_t i = 0; i < size; ++i) {
+            res[i] = offsets[i] - offsets[i - 1] - 1;
+        }
+    }
+};
+
+struct CharLengthImpl {
+    static void vector(const ColumnString::Chars& data, const ColumnString::Offsets& offsets,
+                       PaddedPODArray<Int32>& res) {
+        size_t size = offsets.size();
+        for (size_t i = 0; i < size; ++i) {
+            res[i] = UTF8::countCodePoints(&data[offsets[i - 1]], offsets[i] - offsets[i - 1] - 1);
+        }
+    }
+};
+
+/// Flip the case of the ASCII characters in [not_case_lower_bound, not_case_upper_bound], like
+/// ::tolower and ::toupper of the row engine in the C locale.
+template <char not_case_lower_bound, char not_case_upper_bound>
+struct LowerUpperImpl {
+    static void vector(const ColumnString::Chars& data, const ColumnString::Offsets& offsets,
+                       ColumnString::Chars& res_data, ColumnString::Offsets& res_offsets) {
+        res_data.resize(data.size());
+        res_offsets.assign(offsets);
+        array(data.data(), data.data() + data.size(), res_data.data());
+    }
+
+private:
+    static void array(const UInt8* src, const UInt8* src_end, UInt8* dst) {
+        const auto flip_case_mask = 'A' ^ 'a';
+
+#if defined(__SSE2__)
+        constexpr size_t bytes_sse = sizeof(__m128i);
+        const UInt8* src_end_sse = src_end - (src_end - src) % bytes_sse;
+
+        const auto v_not_case_lower_bound = _mm_set1_epi8(not_case_lower_bound - 1);
+        const auto v_not_case_upper_bound = _mm_set1_epi8(not_case_upper_bound + 1);
+        const auto v_flip_case_mask = _mm_set1_epi8(flip_case_mask);
+
+        for (; src < src_end_sse; src += bytes_sse, dst += bytes_sse) {
+            const auto chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+            /// the bytes >= 0x80 are negative, so they are never in the range
+            const auto is_not_case = _mm_and_si128(_mm_cmpgt_epi8(chars, v_not_case_lower_bound),
+                                                   _mm_cmplt_epi8(chars, v_not_case_upper_bound));
+            const auto xor_mask = _mm_and_si128(v_flip_case_mask, is_not_case);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_xor_si128(chars, xor_mask));
+        }
+#endif
+
+        for (; src < src_end; ++src, ++dst) {
+            if (*src >= not_case_lower_bound && *src <= not_case_upper_bound)
+                *dst = *src ^ flip_case_mask;
+            else
+                *dst = *src;
+        }
+    }
+};
+
+/// Reverse the UTF-8 characters of the strings.
+struct ReverseImpl {
+    static void vector(const ColumnString::Chars& data, const ColumnString::Offsets& offsets,
+                       ColumnString::Chars& res_data, ColumnString::Offsets& res_offsets) {
+        res_data.resize(data.size());
+        res_offsets.assign(offsets);
+        size_t rows = offsets.size();
+        for (size_t i = 0; i < rows; ++i) {
+            const UInt8* src = &data[offsets[i - 1]];
+            size_t size = offsets[i] - offsets[i - 1] - 1;
+            UInt8* dst = &res_data[offsets[i - 1]];
+            for (size_t j = 0, char_size = 0; j < size; j += char_size) {
+                char_size = std::min(UTF8::seqLength(src[j]), size - j);
+                memcpy(dst + size - j - char_size, src + j, char_size);
+            }
+            dst[size] = 0;
+        }
+    }
+};
+
+/// Remove the leading and/or trailing spaces.
+template <bool left, bool right>
+struct TrimImpl {
+    static void vector(const ColumnString::Chars& data, const ColumnString::Offsets& offsets,
+                       ColumnString::Chars& res_data, ColumnString::Offsets& res_offsets) {
+        size_t rows = offsets.size();
+        res_data.resize(data.size());
+        res_offsets.resize(rows);
+
+        ColumnString::Offset res_offset = 0;
+        for (size_t i = 0; i < rows; ++i) {
+            const char* begin = reinterpret_cast<const char*>(&data[offsets[i - 1]]);
+            const char* end = reinterpret_cast<const char*>(&data[offsets[i] - 1]);
+            if constexpr (left) begin = find_first_not_symbols<' '>(begin, end);
+            if constexpr (right) {
+                const char* last = find_last_not_symbols_or_null<' '>(begin, end);
+                end = last ? last + 1 : begin;
+            }
+            writeString(StringRef(begin, end - begin), res_data, res_offset);
+            res_offsets[i] = res_offset;
+        }
+        res_data.resize(res_offset);
+    }
+};
+
+/// The substring of s from the pos-th character (counted from the end if negative) of at most len
+/// characters, like the row engine. Return false if the result is NULL, i.e. pos is after the
+/// last character.
+inline bool substringUTF8(StringRef s, Int32 pos, Int32 len, StringRef& res) {
+    res = StringRef(s.data, 0);
+    if (pos > 0 && static_cast<size_t>(pos) > s.size) return false;
+    if (len <= 0 || s.size == 0 || pos == 0) return true;
+
+    const UInt8* begin = reinterpret_cast<const UInt8*>(s.data);
+    const UInt8* end = begin + s.size;
+    const UInt8* start = begin;
+    if (pos > 0) {
+        for (Int32 i = 1; i < pos && start < end; ++i) start += UTF8::seqLength(*start);
+        if (start >= end) return false;
+    } else {
+        Int64 start_pos = static_cast<Int64>(UTF8::countCodePoints(begin, s.size)) + pos + 1;
+        if (start_pos <= 0) return true;
+        for (Int64 i = 1; i < start_pos; ++i) start += UTF8::seqLength(*start);
+    }
+
+    const UInt8* stop = start;
+    for (Int32 i = 0; i < len && stop < end; ++i) stop += UTF8::seqLength(*stop);
+    res = StringRef(start, std::min(stop, end) - start);
+    return true;
+}
+
+struct SubstringImpl {
+    static constexpr auto name = "substring";
+    static constexpr bool is_variadic = true;
+    static constexpr bool is_nullable = true;
+    static bool apply(StringRef s, Int32 pos, Int32 len, StringRef& res) {
+        return substringUTF8(s, pos, len, res);
+    }
+};
+
+struct LeftImpl {
+    static constexpr auto name = "left";
+    static constexpr bool is_variadic = false;
+    static constexpr bool is_nullable = true;
+    static bool apply(StringRef s, Int32 len, Int32, StringRef& res) {
+        return substringUTF8(s, 1, len, res);
+    }
+};
+
+/// The last len characters of s.
+struct RightImpl {
+    static constexpr auto name = "right";
+    static constexpr bool is_variadic = false;
+    static constexpr bool is_nullable = false;
+    static bool apply(StringRef s, Int32 len, Int32, StringRef& res) {
+        res = StringRef(s.data + s.size, 0);
+        if (len <= 0) return true;
+        const UInt8* start = reinterpret_cast<const UInt8*>(s.data);
+        Int64 chars = UTF8::countCodePoints(start, s.size);
+        for (Int64 i = 0; i < chars - len; ++i) start += UTF8::seqLength(*start);
+        res = StringRef(start, reinterpret_cast<const UInt8*>(s.data + s.size) - start);
+        return true;
+    }
+};
+
+/// substring(str, pos[, len]), left(str, len) and right(str, len). The result is a part of
+/// str, so the chars of str bound the chars of the result.
+template <typename Impl>
+class FunctionSubstring : public IFunction {
+public:
+    static constexpr auto name = Impl::name;
+    static FunctionPtr create() { return std::make_shared<FunctionSubstring>(); }
+
+    String getName() const override { return name; }
+
+    bool isVariadic() const override { return Impl::is_variadic; }
+    size_t getNumberOfArguments() const override { return Impl::is_variadic ? 0 : 2; }
+
+    bool useDefaultImplementationForConstants() const override { return true; }
+
+    DataTypePtr getReturnTypeImpl(const DataTypes& arguments) const override {
+        if (arguments.size() != 2 && arguments.size() != 3)
+            throw Exception("Number of arguments for function " + getName() + " doesn't match: " +
+                                    "passed " + std::to_string(arguments.size()) +
+                                    ", should be 2 or 3",
+                            ErrorCodes::NUMBER_OF_ARGUMENTS_DOESNT_MATCH);
+        checkStringArguments(arguments, 1, getName());
+        for (size_t i = 1; i < arguments.size(); ++i) checkIntArgument(arguments, i, getName());
+        auto type = std::make_shared<DataTypeString>();
+        return Impl::is_nullable ? makeNullable(type) : type;
+    }
+
+    void executeImpl(Block& block, const ColumnNumbers& arguments, size_t result,
+                     size_t input_rows_count) override {
+        StringArgument str(block.getByPosition(arguments[0]).column.get(), getName());
+        IntArgument arg1(block.getByPosition(arguments[1]).column.get(), getName());
+        std::unique_ptr<IntArgument> arg2 =
+                arguments.size() > 2 ? std::make_unique<IntArgument>(
+                                               block.getByPosition(arguments[2]).column.get(),
+                                               getName())
+                                     : std::make_unique<IntArgument>(INT32_MAX);
+
+        auto col_res = ColumnString::create();
+        auto& res_chars = col_res->getChars();
+        auto& res_offsets = col_res->getOffsets();
+        res_chars.resize(str.totalSize(input_rows_count) + input_rows_count);
+        res_offsets.resize(input_rows_count);
+        ColumnUInt8::MutablePtr col_null_map;
+        UInt8* null_map = nullptr;
+        if constexpr (Impl::is_nullable) {
+            col_null_map = ColumnUInt8::create(input_rows_count, 0);
+            null_map = col_null_map->getData().data();
+        }
+
+        ColumnString::Offset res_offset = 0;
+        for (size_t i = 0; i < input_rows_count; ++i) {
+            StringRef res;
+            [[maybe_unused]] bool not_null = Impl::apply(str[i], arg1[i], (*arg2)[i], res);
+            if constexpr (Impl::is_nullable) null_map[i] = !not_null;
+            writeString(res, res_chars, res_offset);
+            res_offsets[i] = res_offset;
+        }
+        res_chars.resize(res_offset);
+
+        if constexpr (Impl::is_nullable)
+            block.getByPosition(result).column =
+                    ColumnNullable::create(std::move(col_res), std::move(col_null_map));
+        else
+            block.getByPosition(result).column = std::move(col_res);
+    }
+};
+
+/// concat(str, ...), NULL if any argument is NULL.
+class FunctionConcat : public IFunction {
+public:
+    static constexpr auto name = "concat";
+    static FunctionPtr create() { return std::make_shared<FunctionConcat>(); }
+
+    String getName() const override { return name; }
+
+    bool isVariadic() const override { return true; }
+    size_t getNumberOfArguments() const override { return 0; }
+
+    bool useDefaultImplementationForConstants() const override { return true; }
+
+    DataTypePtr getReturnTypeImpl(const DataTypes& arguments) const override {
+        if (arguments.empty())
+            throw Exception("Function " + getName() + " needs at least one argument",
+                            ErrorCodes::NUMBER_OF_ARGUMENTS_DOESNT_MATCH);
+        checkStringArguments(arguments, arguments.size(), getName());
+        return std::make_shared<DataTypeString>();
+    }
+
+    void executeImpl(Block& block, const ColumnNumbers& arguments, size_t result,
+                     size_t input_rows_count) override {
+        std::vector<StringArgument> strs;
+        strs.reserve(arguments.size());
+        size_t res_size = input_rows_count;
+        for (auto argument : arguments) {
+            strs.emplace_back(block.getByPosition(argument).column.get(), getName());
+            res_size += strs.back().totalSize(input_rows_count);
+        }
+
+        auto col_res = ColumnString::create();
+        auto& res_chars = col_res->getChars();
+        auto& res_offsets = col_res->getOffsets();
+        res_chars.resize(res_size);
+        res_offsets.resize(input_rows_count);
+
+        ColumnString::Offset res_offset = 0;
+        for (size_t i = 0; i < input_rows_count; ++i) {
+            for (const auto& str : strs) {
+                StringRef s = str[i];
+                memcpySmallAllowReadWriteOverflow15(&res_chars[res_offset], s.data, s.size);
+                res_offset += s.size;
+            }
+            res_chars[res_offset++] = 0;
+            res_offsets[i] = res_offset;
+        }
+
+        block.getByPosition(result).column = std::move(col_res);
+    }
+};
+
+struct StartsWithImpl {
+    static UInt8 apply(StringRef str, StringRef prefix) {
+        return str.size >= prefix.size && memcmp(str.data, prefix.data, prefix.size) == 0;
+    }
+};
+
+struct EndsWithImpl {
+    static UInt8 apply(StringRef str, StringRef suffix) {
+        return str.size >= suffix.size &&
+               memcmp(str.data + str.size - suffix.size, suffix.data, suffix.size) == 0;
+    }
+};
+
+/// The position in characters of the first occurrence of substr in str from the character
+/// start_pos, 0 if not found.
+inline Int32 locateUTF8(StringRef str, StringRef substr, Int32 start_pos = 1) {
+    if (start_pos <= 0 || static_cast<size_t>(start_pos) > str.size) {
+        return substr.size == 0 && start_pos == 1 ? 1 : 0;
+    }
+    if (substr.size == 0) return start_pos;
+    const UInt8* begin = reinterpret_cast<const UInt8*>(str.data);
+    size_t from = 0;
+    for (Int32 i = 1; i < start_pos && from < str.size; ++i) from += UTF8::seqLength(begin[from]);
+    if (from >= str.size) return 0;
+
+    const char* found = findSubstring(str, from, substr);
+    if (!found) return 0;
+    return start_pos + UTF8::countCodePoints(begin + from, found - (str.data + from));
+}
+
+struct InstrImpl {
+    static Int32 apply(StringRef str, StringRef substr) {
+        if (substr.size == 0) return 1;
+        return locateUTF8(str, substr);
+    }
+};
+
+/// locate(substr, str[, pos]).
+class FunctionLocate : public IFunction {
+public:
+    static constexpr auto name = "locate";
+    static FunctionPtr create() { return std::make_shared<FunctionLocate>(); }
+
+    String getName() const override { return name; }
+
+    bool isVariadic() const override { return true; }
+    size_t getNumberOfArguments() const override { return 0; }
+
+    bool useDefaultImplementationForConstants() const override { return true; }
+
+    DataTypePtr getReturnTypeImpl(const DataTypes& arguments) const override {
+        if (arguments.size() != 2 && arguments.size() != 3)
+            throw Exception("Number of arguments for function " + getName() + " doesn't match: " +
+                                    "passed " + std::to_string(arguments.size()) +
+                                    ", should be 2 or 3",
+                            ErrorCodes::NUMBER_OF_ARGUMENTS_DOESNT_MATCH);
+        checkStringArguments(arguments, 2, getName());
+        if (arguments.size() == 3) checkIntArgument(arguments, 2, getName());
+        return std::make_shared<DataTypeInt32>();
+    }
+
+    void executeImpl(Block& block, const ColumnNumbers& arguments, size_t result,
+                     size_t input_rows_count) override {
+        StringArgument substr(block.getByPosition(arguments[0]).column.get(), getName());
+        StringArgument str(block.getByPosition(arguments[1]).column.get(), getName());
+
+        auto col_res = ColumnInt32::create(input_rows_count);
+        auto& res = col_res->getData();
+        if (arguments.size() == 2) {
+            for (size_t i = 0; i < input_rows_count; ++i) {
+                res[i] = InstrImpl::apply(str[i], substr[i]);
+            }
+        } else {
+            IntArgument start_pos(block.getByPosition(arguments[2]).column.get(), getName());
+            for (size_t i = 0; i < input_rows_count; ++i) {
+                res[i] = locateUTF8(str[i], substr[i], start_pos[i]);
+            }
+        }
+        block.getByPosition(result).column = std::move(col_res);
+    }
+};
+
+/// split_part(str, delimiter, field), the field-th part of str split by delimiter, NULL if
+/// field <= 0, if str has less than field - 1 delimiters, or if field is 1 and str has no
+/// delimiter, like the row engine.
+class FunctionSplitPart : public IFunction {
+public:
+    static constexpr auto name = "split_part";
+    static FunctionPtr create() { return std::make_shared<FunctionSplitPart>(); }
+
+    String getName() const override { return name; }
+
+    size_t getNumberOfArguments() const override { return 3; }
+
+    bool useDefaultImplementationForConstants() const override { return true; }
+
+    DataTypePtr getReturnTypeImpl(const DataTypes& arguments) const override {
+        checkStringArguments(arguments, 2, getName());
+        checkIntArgument(arguments, 2, getName());
+        return makeNullable(std::make_shared<DataTypeString>());
+    }
+
+    static bool splitPart(StringRef str, StringRef delimiter, Int32 field, StringRef& res) {
+        res = StringRef(str.data, 0);
+        if (field <= 0) return false;
+        size_t from = 0;
+        for (Int32 i = 1; i < field; ++i) {
+            const char* found = findSubstring(str, from, delimiter);
+            if (!found) return false;
+            from = found - str.data + delimiter.size;
+        }
+        const char* next = findSubstring(str, from, delimiter);
+        if (!next && field == 1) return false;
+        res = StringRef(str.data + from, (next ? next : str.data + str.size) - (str.data + from));
+        return true;
+    }
+
+    void executeImpl(Block& block, const ColumnNumbers& arguments, size_t result,
+                     size_t input_rows_count) override {
+        StringArgument str(block.getByPosition(arguments[0]).column.get(), getName());
+        StringArgument delimiter(block.getByPosition(arguments[1]).column.get(), getName());
+        IntArgument field(block.getByPosition(arguments[2]).column.get(), getName());
+
+        auto col_res = ColumnString::create();
+        auto& res_chars = col_res->getChars();
+        auto& res_offsets = col_res->getOffsets();
+        res_chars.resize(str.totalSize(input_rows_count) + input_rows_count);
+        res_offsets.resize(input_rows_count);
+        auto col_null_map = ColumnUInt8::create(input_rows_count, 0);
+        auto& null_map = col_null_map->getData();
+
+        ColumnString::Offset res_offset = 0;
+        for (size_t i = 0; i < input_rows_count; ++i) {
+            StringRef res;
+            null_map[i] = !splitPart(str[i], delimiter[i], field[i], res);
+            writeString(res, res_chars, res_offset);
+            res_offsets[i] = res_offset;
+        }
+        res_chars.resize(res_offset);
+
+        block.getByPosition(result).column =
+                ColumnNullable::create(std::move(col_res), std::move(col_null_map));
+    }
+};
+
+} // namespace doris::vectorized
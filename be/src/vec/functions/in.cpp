@@ -0,0 +1,317 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "vec/columns/column_const.h"
+#include "vec/columns/column_decimal.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/column_vector.h"
+#include "vec/common/assert_cast.h"
+#include "vec/common/hash_table/hash_set.h"
+#include "vec/common/string_ref.h"
+#include "vec/common/uint128.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_string.h"
+#include "vec/data_types/data_types_decimal.h"
+#include "vec/data_types/data_types_number.h"
+#include "vec/functions/cast_type_to_either.h"
+#include "vec/functions/function.h"
+#include "vec/functions/simple_function_factory.h"
+
+namespace doris::vectorized {
+
+namespace ErrorCodes {
+extern const int ILLEGAL_COLUMN;
+extern const int ILLEGAL_TYPE_OF_ARGUMENT;
+extern const int NUMBER_OF_ARGUMENTS_DOESNT_MATCH;
+} // namespace ErrorCodes
+
+/** x IN (c1, c2, ...) and x NOT IN (c1, c2, ...) with a constant list, with the semantics of
+  * the row engine (exprs/in_predicate.cpp): the result is NULL where x is NULL, or where x is
+  * not in the list and the list contains NULL.
+  *
+  * The set of the list is built once, when the function is built at prepare. A list of up to
+  * IN_LIST_LINEAR_SEARCH_MAX numbers is compared to the rows with a branch free loop per value
+  * the compiler vectorizes, longer lists and strings are looked up in a HashSet.
+  * The function is only called with the column of x, the list is only read at build.
+  */
+static constexpr size_t IN_LIST_LINEAR_SEARCH_MAX = 8;
+
+class IInSet {
+public:
+    virtual ~IInSet() = default;
+
+    /// res[i] = 1 if the row i of column is in the set, 0 otherwise. column is x without
+    /// nullable, res has the size of column.
+    virtual void find(const IColumn& column, PaddedPODArray<UInt8>& res) const = 0;
+};
+
+/// The values of a ColumnVector or ColumnDecimal. The hash set stores them as Key, of the
+/// same size, which has a hash function.
+template <typename ColumnType, typename T, typename Key, typename Hash>
+class FixedInSet final : public IInSet {
+public:
+    void insert(const IColumn& column) {
+        T value = assert_cast<const ColumnType&>(column).getData()[0];
+        if (set.insert(toKey(value)).second) values.push_back(value);
+    }
+
+    void find(const IColumn& column, PaddedPODArray<UInt8>& res) const override {
+        const auto& data = assert_cast<const ColumnType&>(column).getData();
+        size_t size = data.size();
+        UInt8* __restrict res_data = res.data();
+        if (values.size() <= IN_LIST_LINEAR_SEARCH_MAX) {
+            memset(res_data, 0, size);
+            for (const T value : values) {
+                for (size_t i = 0; i < size; ++i) res_data[i] |= data[i] == value;
+            }
+        } else {
+            for (size_t i = 0; i < size; ++i) res_data[i] = set.has(toKey(data[i]));
+        }
+    }
+
+private:
+    static Key toKey(const T& value) {
+        if constexpr (std::is_same_v<T, Key>) {
+            return value;
+        } else {
+            static_assert(sizeof(T) == sizeof(Key));
+            Key key;
+            memcpy(&key, &value, sizeof(Key));
+            return key;
+        }
+    }
+
+    std::vector<T> values;
+    HashSet<Key, Hash> set;
+};
+
+class StringInSet final : public IInSet {
+public:
+    void insert(const ColumnPtr& column) {
+        set.insert(column->getDataAt(0));
+        /// the keys point to the data of the columns
+        columns.push_back(column);
+    }
+
+    void find(const IColumn& column, PaddedPODArray<UInt8>& res) const override {
+        const auto& column_string = assert_cast<const ColumnString&>(column);
+        size_t size = column_string.size();
+        for (size_t i = 0; i < size; ++i) res[i] = set.has(column_string.getDataAt(i));
+    }
+
+private:
+    HashSetWithSavedHash<StringRef, StringRefHash> set;
+    Columns columns;
+};
+
+template <bool negative>
+struct NameIn;
+template <>
+struct NameIn<false> {
+    static constexpr auto name = "in";
+};
+template <>
+struct NameIn<true> {
+    static constexpr auto name = "not_in";
+};
+
+template <bool negative>
+class FunctionIn : public IFunction {
+public:
+    static constexpr auto name = NameIn<negative>::name;
+
+    FunctionIn(std::shared_ptr<const IInSet> set_, bool list_has_null_, bool nullable_result_)
+            : set(std::move(set_)),
+              list_has_null(list_has_null_),
+              nullable_result(nullable_result_) {}
+
+    String getName() const override { return name; }
+
+    bool isVariadic() const override { return true; }
+
+    size_t getNumberOfArguments() const override { return 0; }
+
+    bool useDefaultImplementationForNulls() const override { return false; }
+
+    void executeImpl(Block& block, const ColumnNumbers& arguments, size_t result,
+                     size_t input_rows_count) override {
+        ColumnPtr column = block.getByPosition(arguments[0]).column->convertToFullColumnIfConst();
+        const NullMap* null_map = nullptr;
+        if (auto column_nullable = checkAndGetColumn<ColumnNullable>(*column)) {
+            null_map = &column_nullable->getNullMapData();
+            column = column_nullable->getNestedColumnPtr();
+        }
+
+        auto col_res = ColumnUInt8::create(input_rows_count);
+        auto& res = col_res->getData();
+        set->find(*column, res);
+
+        if (!nullable_result) {
+            if constexpr (negative) {
+                for (size_t i = 0; i < input_rows_count; ++i) res[i] = !res[i];
+            }
+            block.getByPosition(result).column = std::move(col_res);
+            return;
+        }
+
+        auto col_null_map = ColumnUInt8::create(input_rows_count, 0);
+        auto& res_null_map = col_null_map->getData();
+        if (list_has_null) {
+            for (size_t i = 0; i < input_rows_count; ++i) res_null_map[i] = !res[i];
+        }
+        if (null_map != nullptr) {
+            for (size_t i = 0; i < input_rows_count; ++i) res_null_map[i] |= (*null_map)[i];
+        }
+        if constexpr (negative) {
+            for (size_t i = 0; i < input_rows_count; ++i) res[i] = !res[i];
+        }
+        block.getByPosition(result).column =
+                ColumnNullable::create(std::move(col_res), std::move(col_null_map));
+    }
+
+private:
+    std::shared_ptr<const IInSet> set;
+    const bool list_has_null;
+    const bool nullable_result;
+};
+
+/// Builds an in or not_in function holding the set of the list, which must be constant at
+/// prepare. The built function is not modified afterwards, so it can be shared by the clones
+/// of the VExprContext.
+template <typename Function>
+class FunctionInBuilder : public FunctionBuilderImpl {
+public:
+    static constexpr auto name = Function::name;
+    static FunctionBuilderPtr create() { return std::make_shared<FunctionInBuilder>(); }
+    String getName() const override { return name; }
+    bool isVariadic() const override { return true; }
+    size_t getNumberOfArguments() const override { return 0; }
+
+protected:
+    bool useDefaultImplementationForNulls() const override { return false; }
+
+    DataTypePtr getReturnTypeImpl(const ColumnsWithTypeAndName& arguments) const override {
+        bool nullable = checkListAndHasNull(arguments) || arguments[0].type->isNullable();
+        DataTypePtr type = std::make_shared<DataTypeUInt8>();
+        return nullable ? makeNullable(type) : type;
+    }
+
+    FunctionBasePtr buildImpl(const ColumnsWithTypeAndName& arguments,
+                              const DataTypePtr& return_type) const override {
+        bool list_has_null = checkListAndHasNull(arguments);
+        DataTypes data_types(arguments.size());
+        for (size_t i = 0; i < arguments.size(); ++i) data_types[i] = arguments[i].type;
+        return std::make_shared<DefaultFunction>(
+                std::make_shared<Function>(createSet(arguments), list_has_null,
+                                           return_type->isNullable()),
+                data_types, return_type);
+    }
+
+private:
+    /// Checks the list is constant and of the type of x, and returns whether it contains NULL.
+    bool checkListAndHasNull(const ColumnsWithTypeAndName& arguments) const {
+        if (arguments.size() < 2) {
+            throw Exception("Number of arguments for function " + getName() +
+                                    " doesn't match: passed " + std::to_string(arguments.size()) +
+                                    ", should be at least 2.",
+                            ErrorCodes::NUMBER_OF_ARGUMENTS_DOESNT_MATCH);
+        }
+        DataTypePtr type = removeNullable(arguments[0].type);
+        bool has_null = false;
+        for (size_t i = 1; i < arguments.size(); ++i) {
+            const auto& argument = arguments[i];
+            if (!argument.column || !isColumnConst(*argument.column)) {
+                throw Exception("The list of function " + getName() + " must be constant",
+                                ErrorCodes::ILLEGAL_COLUMN);
+            }
+            if (argument.column->onlyNull() || argument.column->isNullAt(0)) {
+                has_null = true;
+            } else if (!removeNullable(argument.type)->equals(*type)) {
+                throw Exception("Illegal type " + argument.type->getName() + " of argument " +
+                                        std::to_string(i) + " of function " + getName() +
+                                        ", should be " + type->getName(),
+                                ErrorCodes::ILLEGAL_TYPE_OF_ARGUMENT);
+            }
+        }
+        return has_null;
+    }
+
+    /// Calls insert with the column of every not null value of the list.
+    template <typename Insert>
+    static void forEachListValue(const ColumnsWithTypeAndName& arguments, Insert&& insert) {
+        for (size_t i = 1; i < arguments.size(); ++i) {
+            const auto& column = arguments[i].column;
+            if (column->onlyNull() || column->isNullAt(0)) continue;
+            ColumnPtr value = assert_cast<const ColumnConst&>(*column).getDataColumnPtr();
+            if (auto value_nullable = checkAndGetColumn<ColumnNullable>(*value))
+                value = value_nullable->getNestedColumnPtr();
+            insert(value);
+        }
+    }
+
+    template <typename ColumnType, typename T, typename Key, typename Hash>
+    static std::shared_ptr<const IInSet> createFixedSet(const ColumnsWithTypeAndName& arguments) {
+        auto set = std::make_shared<FixedInSet<ColumnType, T, Key, Hash>>();
+        forEachListValue(arguments, [&](const ColumnPtr& value) { set->insert(*value); });
+        return set;
+    }
+
+    std::shared_ptr<const IInSet> createSet(const ColumnsWithTypeAndName& arguments) const {
+        DataTypePtr type = removeNullable(arguments[0].type);
+        std::shared_ptr<const IInSet> set;
+        castTypeToEither<DataTypeUInt8, DataTypeUInt16, DataTypeUInt32, DataTypeUInt64,
+                         DataTypeInt8, DataTypeInt16, DataTypeInt32, DataTypeInt64,
+                         DataTypeFloat32, DataTypeFloat64>(type.get(), [&](const auto& data_type) {
+            using T = typename std::decay_t<decltype(data_type)>::FieldType;
+            set = createFixedSet<ColumnVector<T>, T, T, HashCRC32<T>>(arguments);
+            return true;
+        });
+        if (set) return set;
+
+        /// LARGEINT, DATE, DATETIME and DECIMALV2 are compared by their bytes, like in the
+        /// hash join.
+        WhichDataType which(type);
+        if (which.isInt128()) {
+            return createFixedSet<ColumnVector<Int128>, Int128, UInt128, UInt128HashCRC32>(
+                    arguments);
+        }
+        if (which.isDecimal128()) {
+            return createFixedSet<ColumnDecimal<Decimal128>, Decimal128, UInt128,
+                                  UInt128HashCRC32>(arguments);
+        }
+        if (which.isString()) {
+            auto string_set = std::make_shared<StringInSet>();
+            forEachListValue(arguments, [&](const ColumnPtr& value) { string_set->insert(value); });
+            return string_set;
+        }
+        throw Exception("Illegal type " + arguments[0].type->getName() +
+                                " of first argument of function " + getName(),
+                        ErrorCodes::ILLEGAL_TYPE_OF_ARGUMENT);
+    }
+};
+
+void registerFunctionIn(SimpleFunctionFactory& factory) {
+    factory.registerFunction<FunctionInBuilder<FunctionIn<false>>>();
+    factory.registerFunction<FunctionInBuilder<FunctionIn<true>>>();
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,57 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#include "vec/functions/function_binary_arithmetic.h"
+#include "vec/functions/simple_function_factory.h"
+
+namespace doris::vectorized {
+
+template <typename A, typename B>
+struct DivideIntegralImpl {
+    using ResultType = typename ResultOfBinaryArithmetic<A, B>::Type;
+    static constexpr bool allow_decimal = false;
+    static constexpr bool allow_float = false;
+    static constexpr bool is_nullable = true;
+    static constexpr bool is_multiply = false;
+    static constexpr bool is_division = true;
+
+    static inline NO_SANITIZE_UNDEFINED ResultType apply(A a, B b, UInt8& is_null) {
+        ResultType x = a;
+        ResultType y = b;
+        is_null = y == 0;
+        if constexpr (std::is_signed_v<ResultType>) {
+            /// x / -1 would raise SIGFPE for the minimum value of the type.
+            if (y == -1) return ResultType(~std::make_unsigned_t<ResultType>(x) + 1);
+        }
+        return x / (y + is_null);
+    }
+
+    template <typename T>
+    static inline T applyDecimal(T, T, T, UInt8&) {
+        return 0;
+    }
+};
+
+struct NameIntDiv {
+    static constexpr auto name = "int_divide";
+};
+using FunctionIntDiv = FunctionBinaryArithmetic<DivideIntegralImpl, NameIntDiv>;
+
+void registerFunctionIntDiv(SimpleFunctionFactory& factory) {
+    factory.registerFunction<FunctionIntDiv>();
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,69 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
+#include "vec/data_types/data_types_number.h"
+#include "vec/functions/function.h"
+#include "vec/functions/simple_function_factory.h"
+
+namespace doris::vectorized {
+
+/** is_null_pred(x) and is_not_null_pred(x), x IS NULL and x IS NOT NULL, which are never NULL.
+  * The result is read from the null map of x, the values of x are not looked at.
+  */
+template <bool negative>
+class FunctionIsNull : public IFunction {
+public:
+    static constexpr auto name = negative ? "is_not_null_pred" : "is_null_pred";
+    static FunctionPtr create() { return std::make_shared<FunctionIsNull>(); }
+
+    String getName() const override { return name; }
+
+    size_t getNumberOfArguments() const override { return 1; }
+
+    bool useDefaultImplementationForNulls() const override { return false; }
+
+    bool useDefaultImplementationForConstants() const override { return true; }
+
+    DataTypePtr getReturnTypeImpl(const DataTypes& /*arguments*/) const override {
+        return std::make_shared<DataTypeUInt8>();
+    }
+
+    void executeImpl(Block& block, const ColumnNumbers& arguments, size_t result,
+                     size_t input_rows_count) override {
+        const auto& column = block.getByPosition(arguments[0]).column;
+        auto column_nullable = checkAndGetColumn<ColumnNullable>(*column);
+        if (column_nullable == nullptr) {
+            block.getByPosition(result).column =
+                    DataTypeUInt8().createColumnConst(input_rows_count, UInt64(negative));
+            return;
+        }
+        const auto& null_map = column_nullable->getNullMapData();
+        auto col_res = ColumnUInt8::create(input_rows_count);
+        auto& res = col_res->getData();
+        for (size_t i = 0; i < input_rows_count; ++i) res[i] = negative ^ null_map[i];
+        block.getByPosition(result).column = std::move(col_res);
+    }
+};
+
+void registerFunctionIsNull(SimpleFunctionFactory& factory) {
+    factory.registerFunction<FunctionIsNull<false>>();
+    factory.registerFunction<FunctionIsNull<true>>();
+}
+
+} // namespace doris::vectorized
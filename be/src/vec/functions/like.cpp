@@ -0,0 +1,246 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+
+#include "vec/functions/like.h"
+
+#include <string.h>
+
+#include "vec/functions/simple_function_factory.h"
+
+namespace doris::vectorized {
+
+namespace ErrorCodes {
+extern const int CANNOT_COMPILE_REGEXP;
+}
+
+namespace {
+
+/// The classification of the row engine, see exprs/like_predicate.cpp.
+const re2::RE2 LIKE_SUBSTRING_RE("(?:%+)(((\\\\%)|(\\\\_)|([^%_]))+)(?:%+)");
+const re2::RE2 LIKE_ENDS_WITH_RE("(?:%+)(((\\\\%)|(\\\\_)|([^%_]))+)");
+const re2::RE2 LIKE_STARTS_WITH_RE("(((\\\\%)|(\\\\_)|([^%_]))+)(?:%+)");
+const re2::RE2 LIKE_EQUALS_RE("(((\\\\%)|(\\\\_)|([^%_]))+)");
+/// Matches any string, e.g. '%' and '%%'.
+const re2::RE2 LIKE_ALL_RE("%+");
+
+const re2::RE2 REGEXP_SUBSTRING_RE(
+        "(?:\\.\\*)*([^\\.\\^\\{\\[\\(\\|\\)\\]\\}\\+\\*\\?\\$\\\\]*)(?:\\.\\*)*");
+const re2::RE2 REGEXP_ENDS_WITH_RE(
+        "(?:\\.\\*)*([^\\.\\^\\{\\[\\(\\|\\)\\]\\}\\+\\*\\?\\$\\\\]*)\\$");
+const re2::RE2 REGEXP_STARTS_WITH_RE(
+        "\\^([^\\.\\^\\{\\[\\(\\|\\)\\]\\}\\+\\*\\?\\$\\\\]*)(?:\\.\\*)*");
+const re2::RE2 REGEXP_EQUALS_RE("\\^([^\\.\\^\\{\\[\\(\\|\\)\\]\\}\\+\\*\\?\\$\\\\]*)\\$");
+
+void removeEscapeCharacter(std::string& str) {
+    std::string res;
+    res.reserve(str.size());
+    for (size_t i = 0; i < str.size(); ++i) {
+        if (str[i] == '\\' && i + 1 < str.size() && (str[i + 1] == '%' || str[i + 1] == '_'))
+            ++i;
+        res.push_back(str[i]);
+    }
+    str.swap(res);
+}
+
+/// Convert a LIKE pattern to a re2 regex: '%' to '.*', '_' to '.' and escape the regex special
+/// characters.
+std::string convertLikePattern(StringRef pattern) {
+    std::string res;
+    bool is_escaped = false;
+    for (size_t i = 0; i < pattern.size; ++i) {
+        char c = pattern.data[i];
+        if (!is_escaped && c == '%') {
+            res.append(".*");
+        } else if (!is_escaped && c == '_') {
+            res.append(".");
+        } else if (!is_escaped && c == '\\') {
+            is_escaped = true;
+        } else if (c != '\0' && strchr(".[]{}()\\*+?|^$", c)) {
+            res.push_back('\\');
+            res.push_back(c);
+            is_escaped = false;
+        } else {
+            res.push_back(c);
+            is_escaped = false;
+        }
+    }
+    return res;
+}
+
+} // namespace
+
+std::shared_ptr<const LikeSearcher> LikeSearcher::fromLikePattern(StringRef pattern) {
+    auto searcher = std::make_shared<LikeSearcher>();
+    re2::StringPiece pattern_sp(pattern.data, pattern.size);
+    if (RE2::FullMatch(pattern_sp, LIKE_ENDS_WITH_RE, &searcher->needle)) {
+        searcher->kind = Kind::ENDS_WITH;
+    } else if (RE2::FullMatch(pattern_sp, LIKE_SUBSTRING_RE, &searcher->needle)) {
+        searcher->kind = Kind::SUBSTRING;
+    } else if (RE2::FullMatch(pattern_sp, LIKE_EQUALS_RE, &searcher->needle)) {
+        searcher->kind = Kind::EQUALS;
+    } else if (RE2::FullMatch(pattern_sp, LIKE_STARTS_WITH_RE, &searcher->needle)) {
+        searcher->kind = Kind::STARTS_WITH;
+    } else if (RE2::FullMatch(pattern_sp, LIKE_ALL_RE)) {
+        searcher->kind = Kind::SUBSTRING;
+        return searcher;
+    } else {
+        searcher->compileRegex(convertLikePattern(pattern), true);
+        return searcher;
+    }
+    removeEscapeCharacter(searcher->needle);
+    return searcher;
+}
+
+std::shared_ptr<const LikeSearcher> LikeSearcher::fromRegexpPattern(StringRef pattern) {
+    auto searcher = std::make_shared<LikeSearcher>();
+    re2::StringPiece pattern_sp(pattern.data, pattern.size);
+    if (RE2::FullMatch(pattern_sp, REGEXP_EQUALS_RE, &searcher->needle)) {
+        searcher->kind = Kind::EQUALS;
+    } else if (RE2::FullMatch(pattern_sp, REGEXP_STARTS_WITH_RE, &searcher->needle)) {
+        searcher->kind = Kind::STARTS_WITH;
+    } else if (RE2::FullMatch(pattern_sp, REGEXP_ENDS_WITH_RE, &searcher->needle)) {
+        searcher->kind = Kind::ENDS_WITH;
+    } else if (RE2::FullMatch(pattern_sp, REGEXP_SUBSTRING_RE, &searcher->needle)) {
+        searcher->kind = Kind::SUBSTRING;
+    } else {
+        searcher->compileRegex(pattern.toString(), false);
+    }
+    return searcher;
+}
+
+void LikeSearcher::compileRegex(const std::string& pattern, bool full_match_) {
+    RE2::Options opts;
+    opts.set_never_nl(false);
+    opts.set_dot_nl(true);
+    opts.set_log_errors(false);
+    regex = std::make_unique<re2::RE2>(pattern, opts);
+    if (!regex->ok()) {
+        throw Exception("Invalid regex expression: " + pattern + ": " + regex->error(),
+                        ErrorCodes::CANNOT_COMPILE_REGEXP);
+    }
+    kind = Kind::REGEX;
+    full_match = full_match_;
+}
+
+bool LikeSearcher::match(StringRef str) const {
+    switch (kind) {
+    case Kind::EQUALS:
+        return str.size == needle.size() && memcmp(str.data, needle.data(), needle.size()) == 0;
+    case Kind::STARTS_WITH:
+        return str.size >= needle.size() && memcmp(str.data, needle.data(), needle.size()) == 0;
+    case Kind::ENDS_WITH:
+        return str.size >= needle.size() &&
+               memcmp(str.data + str.size - needle.size(), needle.data(), needle.size()) == 0;
+    case Kind::SUBSTRING:
+        return needle.empty() || memmem(str.data, str.size, needle.data(), needle.size());
+    case Kind::REGEX: {
+        re2::StringPiece str_sp(str.data, str.size);
+        return full_match ? RE2::FullMatch(str_sp, *regex) : RE2::PartialMatch(str_sp, *regex);
+    }
+    }
+    __builtin_unreachable();
+}
+
+void LikeSearcher::vector(const ColumnString::Chars& data, const ColumnString::Offsets& offsets,
+                          PaddedPODArray<UInt8>& res) const {
+    size_t size = offsets.size();
+    const char* needle_data = needle.data();
+    size_t needle_size = needle.size();
+
+    switch (kind) {
+    case Kind::EQUALS:
+        for (size_t i = 0; i < size; ++i) {
+            size_t str_size = offsets[i] - offsets[i - 1] - 1;
+            res[i] = str_size == needle_size &&
+                     memcmp(&data[offsets[i - 1]], needle_data, needle_size) == 0;
+        }
+        break;
+    case Kind::STARTS_WITH:
+        for (size_t i = 0; i < size; ++i) {
+            size_t str_size = offsets[i] - offsets[i - 1] - 1;
+            res[i] = str_size >= needle_size &&
+                     memcmp(&data[offsets[i - 1]], needle_data, needle_size) == 0;
+        }
+        break;
+    case Kind::ENDS_WITH:
+        for (size_t i = 0; i < size; ++i) {
+            size_t str_size = offsets[i] - offsets[i - 1] - 1;
+            res[i] = str_size >= needle_size &&
+                     memcmp(&data[offsets[i] - 1 - needle_size], needle_data, needle_size) == 0;
+        }
+        break;
+    case Kind::SUBSTRING:
+        vectorSubstring(data, offsets, res);
+        break;
+    case Kind::REGEX:
+        for (size_t i = 0; i < size; ++i) {
+            re2::StringPiece str_sp(reinterpret_cast<const char*>(&data[offsets[i - 1]]),
+                                    offsets[i] - offsets[i - 1] - 1);
+            res[i] = full_match ? RE2::FullMatch(str_sp, *regex)
+                                : RE2::PartialMatch(str_sp, *regex);
+        }
+        break;
+    }
+}
+
+/// Search the needle in the whole chars buffer instead of row by row, which is much faster for
+/// short strings and rare needles. A match is mapped back to its row with the offsets, and
+/// the search goes on from the next row.
+void LikeSearcher::vectorSubstring(const ColumnString::Chars& data,
+                                   const ColumnString::Offsets& offsets,
+                                   PaddedPODArray<UInt8>& res) const {
+    size_t size = offsets.size();
+    if (needle.empty()) {
+        memset(res.data(), 1, size);
+        return;
+    }
+    memset(res.data(), 0, size);
+
+    const UInt8* begin = data.data();
+    const UInt8* end = begin + data.size();
+    const UInt8* pos = begin;
+    size_t i = 0;
+    while (pos < end) {
+        pos = static_cast<const UInt8*>(memmem(pos, end - pos, needle.data(), needle.size()));
+        if (!pos) break;
+
+        while (begin + offsets[i] <= pos) ++i;
+        /// The match must end before the terminating zero of the row.
+        if (pos + needle.size() < begin + offsets[i]) res[i] = 1;
+
+        pos = begin + offsets[i];
+        ++i;
+    }
+}
+
+struct NameLike {
+    static constexpr auto name = "like";
+};
+struct NameRegexp {
+    static constexpr auto name = "regexp";
+};
+
+using FunctionLike = FunctionLikeBase<NameLike, true>;
+using FunctionRegexp = FunctionLikeBase<NameRegexp, false>;
+
+void registerFunctionLike(SimpleFunctionFactory& factory) {
+    factory.registerFunction<FunctionLikeBuilder<FunctionLike>>();
+    factory.registerFunction<FunctionLikeBuilder<FunctionRegexp>>();
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,174 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+
+#pragma once
+
+#include <re2/re2.h>
+
+#include <memory>
+#include <string>
+
+#include "vec/functions/function_string.h"
+
+namespace doris::vectorized {
+
+/** LIKE and REGEXP on ColumnString, with the semantics of the row engine
+  * (exprs/like_predicate.cpp).
+  *
+  * A constant pattern is classified once, when the function is built at prepare. The patterns
+  * equivalent to an equality, a prefix, a suffix or a substring match are matched with memcmp,
+  * or with one substring search over the whole chars buffer of the column, only the other
+  * patterns are matched with re2. A non constant pattern is classified row by row.
+  */
+class LikeSearcher {
+public:
+    enum class Kind { EQUALS, STARTS_WITH, ENDS_WITH, SUBSTRING, REGEX };
+
+    /// '%' matches any string and '_' any character, '\' escapes them. The whole string must
+    /// match the pattern.
+    static std::shared_ptr<const LikeSearcher> fromLikePattern(StringRef pattern);
+    /// A re2 regex, a part of the string must match the pattern.
+    static std::shared_ptr<const LikeSearcher> fromRegexpPattern(StringRef pattern);
+
+    Kind getKind() const { return kind; }
+    const std::string& getNeedle() const { return needle; }
+
+    bool match(StringRef str) const;
+
+    /// res[i] = match(row i) for all the rows of the column.
+    void vector(const ColumnString::Chars& data, const ColumnString::Offsets& offsets,
+                PaddedPODArray<UInt8>& res) const;
+
+private:
+    void vectorSubstring(const ColumnString::Chars& data, const ColumnString::Offsets& offsets,
+                         PaddedPODArray<UInt8>& res) const;
+
+    void compileRegex(const std::string& pattern, bool full_match_);
+
+    Kind kind = Kind::REGEX;
+    std::string needle;
+    std::unique_ptr<re2::RE2> regex;
+    bool full_match = false;
+};
+
+template <typename Name, bool is_like>
+class FunctionLikeBase : public IFunction {
+public:
+    static constexpr auto name = Name::name;
+
+    explicit FunctionLikeBase(std::shared_ptr<const LikeSearcher> searcher_)
+            : searcher(std::move(searcher_)) {}
+
+    static std::shared_ptr<const LikeSearcher> createSearcher(StringRef pattern) {
+        return is_like ? LikeSearcher::fromLikePattern(pattern)
+                       : LikeSearcher::fromRegexpPattern(pattern);
+    }
+
+    String getName() const override { return name; }
+
+    size_t getNumberOfArguments() const override { return 2; }
+
+    bool useDefaultImplementationForConstants() const override { return true; }
+
+    DataTypePtr getReturnTypeImpl(const DataTypes& arguments) const override {
+        checkStringArguments(arguments, 2, getName());
+        return std::make_shared<DataTypeUInt8>();
+    }
+
+    void executeImpl(Block& block, const ColumnNumbers& arguments, size_t result,
+                     size_t input_rows_count) override {
+        const IColumn* col_pattern = block.getByPosition(arguments[1]).column.get();
+        auto col_res = ColumnUInt8::create(input_rows_count);
+        auto& res = col_res->getData();
+
+        std::shared_ptr<const LikeSearcher> const_searcher = searcher;
+        if (!const_searcher) {
+            if (auto col_pattern_const = checkAndGetColumnConst<ColumnString>(col_pattern))
+                const_searcher = createSearcher(col_pattern_const->getDataAt(0));
+        }
+
+        if (const_searcher) {
+            const ColumnPtr col_haystack =
+                    block.getByPosition(arguments[0]).column->convertToFullColumnIfConst();
+            if (auto col_haystack_string = checkAndGetColumn<ColumnString>(col_haystack.get())) {
+                const_searcher->vector(col_haystack_string->getChars(),
+                                       col_haystack_string->getOffsets(), res);
+            } else {
+                throw Exception("Illegal column " + col_haystack->getName() +
+                                        " of argument of function " + getName(),
+                                ErrorCodes::ILLEGAL_COLUMN);
+            }
+        } else {
+            StringArgument haystack(block.getByPosition(arguments[0]).column.get(), getName());
+            StringArgument pattern(col_pattern, getName());
+            /// The searcher is reused while the pattern of the rows does not change.
+            std::shared_ptr<const LikeSearcher> row_searcher;
+            StringRef last_pattern;
+            for (size_t i = 0; i < input_rows_count; ++i) {
+                StringRef row_pattern = pattern[i];
+                if (!row_searcher || !(row_pattern == last_pattern)) {
+                    row_searcher = createSearcher(row_pattern);
+                    last_pattern = row_pattern;
+                }
+                res[i] = row_searcher->match(haystack[i]);
+            }
+        }
+        block.getByPosition(result).column = std::move(col_res);
+    }
+
+private:
+    /// The searcher of the pattern if it is constant at prepare, otherwise nullptr.
+    std::shared_ptr<const LikeSearcher> searcher;
+};
+
+/// Builds a like or regexp function holding the searcher of the pattern if the pattern is
+/// constant at prepare. The built function is not modified afterwards, so it can be shared by
+/// the clones of the VExprContext.
+template <typename Function>
+class FunctionLikeBuilder : public FunctionBuilderImpl {
+public:
+    static constexpr auto name = Function::name;
+    static FunctionBuilderPtr create() { return std::make_shared<FunctionLikeBuilder>(); }
+
+    String getName() const override { return name; }
+
+    size_t getNumberOfArguments() const override { return 2; }
+
+protected:
+    DataTypePtr getReturnTypeImpl(const DataTypes& arguments) const override {
+        checkStringArguments(arguments, 2, getName());
+        return std::make_shared<DataTypeUInt8>();
+    }
+
+    FunctionBasePtr buildImpl(const ColumnsWithTypeAndName& arguments,
+                              const DataTypePtr& return_type) const override {
+        std::shared_ptr<const LikeSearcher> searcher;
+        const auto& col_pattern = arguments[1].column;
+        if (col_pattern) {
+            if (auto col_pattern_const = checkAndGetColumnConst<ColumnString>(col_pattern.get()))
+                searcher = Function::createSearcher(col_pattern_const->getDataAt(0));
+        }
+
+        DataTypes data_types(arguments.size());
+        for (size_t i = 0; i < arguments.size(); ++i) data_types[i] = arguments[i].type;
+        return std::make_shared<DefaultFunction>(std::make_shared<Function>(std::move(searcher)),
+                                                 data_types, return_type);
+    }
+};
+
+} // namespace doris::vectorized
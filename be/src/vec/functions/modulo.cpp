@@ -0,0 +1,64 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#include <cmath>
+
+#include "vec/functions/function_binary_arithmetic.h"
+#include "vec/functions/simple_function_factory.h"
+
+namespace doris::vectorized {
+
+template <typename A, typename B>
+struct ModuloImpl {
+    using ResultType = typename ResultOfBinaryArithmetic<A, B>::Type;
+    static constexpr bool allow_decimal = true;
+    static constexpr bool allow_float = true;
+    static constexpr bool is_nullable = true;
+    static constexpr bool is_multiply = false;
+    static constexpr bool is_division = false;
+
+    static inline NO_SANITIZE_UNDEFINED ResultType apply(A a, B b, UInt8& is_null) {
+        ResultType x = a;
+        ResultType y = b;
+        is_null = y == 0;
+        if constexpr (std::is_floating_point_v<ResultType>) {
+            return std::fmod(x, y);
+        } else {
+            /// x % -1 is always 0, but would raise SIGFPE for the minimum value of the type.
+            if constexpr (std::is_signed_v<ResultType>) {
+                if (y == -1) return 0;
+            }
+            return x % (y + is_null);
+        }
+    }
+
+    template <typename T>
+    static inline T applyDecimal(T a, T b, T, UInt8& is_null) {
+        is_null = b == 0;
+        return b == 0 ? 0 : a % b;
+    }
+};
+
+struct NameModulo {
+    static constexpr auto name = "mod";
+};
+using FunctionModulo = FunctionBinaryArithmetic<ModuloImpl, NameModulo>;
+
+void registerFunctionModulo(SimpleFunctionFactory& factory) {
+    factory.registerFunction<FunctionModulo>();
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,55 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#include "vec/functions/function_binary_arithmetic.h"
+#include "vec/functions/simple_function_factory.h"
+
+namespace doris::vectorized {
+
+template <typename A, typename B>
+struct PlusImpl {
+    using ResultType = typename ResultOfBinaryArithmetic<A, B>::Type;
+    static constexpr bool allow_decimal = true;
+    static constexpr bool allow_float = true;
+    static constexpr bool is_nullable = false;
+    static constexpr bool is_multiply = false;
+    static constexpr bool is_division = false;
+
+    static inline NO_SANITIZE_UNDEFINED ResultType apply(A a, B b) {
+        /// Cast before the operation to compute it in ResultType, it wraps on overflow like
+        /// the row engine.
+        return static_cast<ResultType>(a) + b;
+    }
+
+    template <typename T>
+    static inline T applyDecimal(T a, T b, T) {
+        T res;
+        if (common::addOverflow(a, b, res))
+            throw Exception("Decimal math overflow", ErrorCodes::DECIMAL_OVERFLOW);
+        return res;
+    }
+};
+
+struct NamePlus {
+    static constexpr auto name = "add";
+};
+using FunctionPlus = FunctionBinaryArithmetic<PlusImpl, NamePlus>;
+
+void registerFunctionPlus(SimpleFunctionFactory& factory) {
+    factory.registerFunction<FunctionPlus>();
+}
+
+} // namespace doris::vectorized
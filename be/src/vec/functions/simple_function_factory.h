@@ -29,6 +29,18 @@ void registerFunctionComparison(SimpleFunctionFactory& factory);
 void registerFunctionAbs(SimpleFunctionFactory& factory);
 void registerFunctionLogical(SimpleFunctionFactory& factory);
 void registerFunctionCast(SimpleFunctionFactory& factory);
+void registerFunctionPlus(SimpleFunctionFactory& factory);
+void registerFunctionMinus(SimpleFunctionFactory& factory);
+void registerFunctionMultiply(SimpleFunctionFactory& factory);
+void registerFunctionDivide(SimpleFunctionFactory& factory);
+void registerFunctionIntDiv(SimpleFunctionFactory& factory);
+void registerFunctionModulo(SimpleFunctionFactory& factory);
+void registerFunctionString(SimpleFunctionFactory& factory);
+void registerFunctionLike(SimpleFunctionFactory& factory);
+void registerFunctionToTime(SimpleFunctionFactory& factory);
+void registerFunctionDateTimeComputation(SimpleFunctionFactory& factory);
+void registerFunctionIn(SimpleFunctionFactory& factory);
+void registerFunctionIsNull(SimpleFunctionFactory& factory);
 
 class SimpleFunctionFactory {
     using Creator = std::function<FunctionBuilderPtr()>;
@@ -37,6 +49,11 @@ class SimpleFunctionFactory {
 public:
     void registerFunction(const std::string& name, Creator ptr) { function_creators[name] = ptr; }
 
+    /// Register alias as another name of the registered function name.
+    void registerAlias(const std::string& name, const std::string& alias) {
+        function_creators[alias] = function_creators.at(name);
+    }
+
     template <class Function>
     void registerFunction() {
         if constexpr (std::is_base_of<IFunction, Function>::value)
@@ -70,6 +87,18 @@ public:
             registerFunctionComparison(instance);
             registerFunctionLogical(instance);
             registerFunctionCast(instance);
+            registerFunctionPlus(instance);
+            registerFunctionMinus(instance);
+            registerFunctionMultiply(instance);
+            registerFunctionDivide(instance);
+            registerFunctionIntDiv(instance);
+            registerFunctionModulo(instance);
+            registerFunctionString(instance);
+            registerFunctionLike(instance);
+            registerFunctionToTime(instance);
+            registerFunctionDateTimeComputation(instance);
+            registerFunctionIn(instance);
+            registerFunctionIsNull(instance);
         });
         return instance;
     }
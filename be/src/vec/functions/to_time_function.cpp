@@ -0,0 +1,95 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+
+#include "vec/functions/function_date_or_datetime_to_something.h"
+#include "vec/functions/simple_function_factory.h"
+
+namespace doris::vectorized {
+
+struct NameYear {
+    static constexpr auto name = "year";
+};
+struct NameQuarter {
+    static constexpr auto name = "quarter";
+};
+struct NameMonth {
+    static constexpr auto name = "month";
+};
+struct NameDay {
+    static constexpr auto name = "day";
+};
+struct NameHour {
+    static constexpr auto name = "hour";
+};
+struct NameMinute {
+    static constexpr auto name = "minute";
+};
+struct NameSecond {
+    static constexpr auto name = "second";
+};
+struct NameToDays {
+    static constexpr auto name = "to_days";
+};
+struct NameDate {
+    static constexpr auto name = "date";
+};
+struct NameDayOfWeek {
+    static constexpr auto name = "dayofweek";
+};
+struct NameDayOfYear {
+    static constexpr auto name = "dayofyear";
+};
+struct NameWeekOfYear {
+    static constexpr auto name = "weekofyear";
+};
+
+using FunctionYear = FunctionDateOrDateTimeToSomething<DataTypeInt32, ToYearImpl, NameYear>;
+using FunctionQuarter =
+        FunctionDateOrDateTimeToSomething<DataTypeInt32, ToQuarterImpl, NameQuarter>;
+using FunctionMonth = FunctionDateOrDateTimeToSomething<DataTypeInt32, ToMonthImpl, NameMonth>;
+using FunctionDay = FunctionDateOrDateTimeToSomething<DataTypeInt32, ToDayOfMonthImpl, NameDay>;
+using FunctionHour = FunctionDateOrDateTimeToSomething<DataTypeInt32, ToHourImpl, NameHour>;
+using FunctionMinute = FunctionDateOrDateTimeToSomething<DataTypeInt32, ToMinuteImpl, NameMinute>;
+using FunctionSecond = FunctionDateOrDateTimeToSomething<DataTypeInt32, ToSecondImpl, NameSecond>;
+using FunctionToDays = FunctionDateOrDateTimeToSomething<DataTypeInt32, ToDaysImpl, NameToDays>;
+using FunctionDate = FunctionDateOrDateTimeToSomething<DataTypeInt128, ToDateImpl, NameDate>;
+using FunctionDayOfWeek =
+        FunctionDateOrDateTimeToSomething<DataTypeInt32, ToDayOfWeekImpl, NameDayOfWeek, true>;
+using FunctionDayOfYear =
+        FunctionDateOrDateTimeToSomething<DataTypeInt32, ToDayOfYearImpl, NameDayOfYear, true>;
+using FunctionWeekOfYear =
+        FunctionDateOrDateTimeToSomething<DataTypeInt32, ToWeekOfYearImpl, NameWeekOfYear, true>;
+
+void registerFunctionToTime(SimpleFunctionFactory& factory) {
+    factory.registerFunction<FunctionYear>();
+    factory.registerFunction<FunctionQuarter>();
+    factory.registerFunction<FunctionMonth>();
+    factory.registerFunction<FunctionDay>();
+    factory.registerAlias(NameDay::name, "dayofmonth");
+    factory.registerFunction<FunctionHour>();
+    factory.registerFunction<FunctionMinute>();
+    factory.registerFunction<FunctionSecond>();
+    factory.registerFunction<FunctionToDays>();
+    factory.registerFunction<FunctionDate>();
+    factory.registerAlias(NameDate::name, "to_date");
+    factory.registerFunction<FunctionDayOfWeek>();
+    factory.registerFunction<FunctionDayOfYear>();
+    factory.registerFunction<FunctionWeekOfYear>();
+}
+
+} // namespace doris::vectorized
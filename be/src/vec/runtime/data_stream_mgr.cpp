@@ -0,0 +1,167 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/runtime/data_stream_mgr.h"
+
+#include <sstream>
+
+#include "gen_cpp/types.pb.h" // PUniqueId
+#include "runtime/raw_value.h"
+#include "runtime/runtime_state.h"
+#include "util/uid_util.h"
+#include "vec/runtime/data_stream_recvr.h"
+
+namespace doris::vectorized {
+
+VDataStreamMgr::VDataStreamMgr() {}
+
+VDataStreamMgr::~VDataStreamMgr() {}
+
+uint32_t VDataStreamMgr::get_hash_value(const TUniqueId& fragment_instance_id,
+                                        PlanNodeId node_id) {
+    uint32_t value = RawValue::get_hash_value(&fragment_instance_id.lo, TYPE_BIGINT, 0);
+    value = RawValue::get_hash_value(&fragment_instance_id.hi, TYPE_BIGINT, value);
+    value = RawValue::get_hash_value(&node_id, TYPE_INT, value);
+    return value;
+}
+
+std::shared_ptr<VDataStreamRecvr> VDataStreamMgr::create_recvr(
+        RuntimeState* state, const RowDescriptor& row_desc, const TUniqueId& fragment_instance_id,
+        PlanNodeId dest_node_id, int num_senders, int buffer_size, RuntimeProfile* profile,
+        bool is_merging, std::shared_ptr<QueryStatisticsRecvr> sub_plan_query_statistics_recvr) {
+    DCHECK(profile != nullptr);
+    VLOG_FILE << "creating receiver for fragment=" << fragment_instance_id
+              << ", node=" << dest_node_id;
+    std::shared_ptr<VDataStreamRecvr> recvr(new VDataStreamRecvr(
+            this, state->instance_mem_tracker(), row_desc, fragment_instance_id, dest_node_id,
+            num_senders, is_merging, buffer_size, profile, sub_plan_query_statistics_recvr));
+    uint32_t hash_value = get_hash_value(fragment_instance_id, dest_node_id);
+    std::lock_guard<std::mutex> l(_lock);
+    _fragment_stream_set.insert(std::make_pair(fragment_instance_id, dest_node_id));
+    _receiver_map.insert(std::make_pair(hash_value, recvr));
+    return recvr;
+}
+
+std::shared_ptr<VDataStreamRecvr> VDataStreamMgr::find_recvr(
+        const TUniqueId& fragment_instance_id, PlanNodeId node_id, bool acquire_lock) {
+    VLOG_ROW << "looking up fragment_instance_id=" << fragment_instance_id << ", node=" << node_id;
+    uint32_t hash_value = get_hash_value(fragment_instance_id, node_id);
+    std::unique_lock<std::mutex> l(_lock, std::defer_lock);
+    if (acquire_lock) {
+        l.lock();
+    }
+    auto range = _receiver_map.equal_range(hash_value);
+    for (auto iter = range.first; iter != range.second; ++iter) {
+        const auto& recvr = iter->second;
+        if (recvr->fragment_instance_id() == fragment_instance_id &&
+            recvr->dest_node_id() == node_id) {
+            return recvr;
+        }
+    }
+    return nullptr;
+}
+
+Status VDataStreamMgr::transmit_block(const PTransmitDataParams* request,
+                                      ::google::protobuf::Closure** done) {
+    const PUniqueId& finst_id = request->finst_id();
+    TUniqueId t_finst_id;
+    t_finst_id.hi = finst_id.hi();
+    t_finst_id.lo = finst_id.lo();
+    std::shared_ptr<VDataStreamRecvr> recvr = find_recvr(t_finst_id, request->node_id());
+    if (recvr == nullptr) {
+        // the receiver may have been closed without waiting for all the senders, e.g.
+        // when the exchange node reached its limit
+        return Status::OK();
+    }
+
+    // the request may be released once the block is consumed, it can only be used
+    // before add_block() or for the last packet of the sender
+    if (request->has_query_statistics()) {
+        recvr->add_sub_plan_statistics(request->query_statistics(), request->sender_id());
+    }
+
+    bool eos = request->eos();
+    if (request->has_block()) {
+        RETURN_IF_ERROR(recvr->add_block(request->block(), request->sender_id(),
+                                         request->be_number(), request->packet_seq(),
+                                         eos ? nullptr : done));
+    }
+
+    if (eos) {
+        recvr->remove_sender(request->sender_id(), request->be_number());
+    }
+    return Status::OK();
+}
+
+Status VDataStreamMgr::deregister_recvr(const TUniqueId& fragment_instance_id,
+                                        PlanNodeId node_id) {
+    std::shared_ptr<VDataStreamRecvr> target_recvr;
+    VLOG_QUERY << "deregister_recvr(): fragment_instance_id=" << fragment_instance_id
+               << ", node=" << node_id;
+    uint32_t hash_value = get_hash_value(fragment_instance_id, node_id);
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        auto range = _receiver_map.equal_range(hash_value);
+        for (auto iter = range.first; iter != range.second; ++iter) {
+            const auto& recvr = iter->second;
+            if (recvr->fragment_instance_id() == fragment_instance_id &&
+                recvr->dest_node_id() == node_id) {
+                target_recvr = recvr;
+                _fragment_stream_set.erase(std::make_pair(fragment_instance_id, node_id));
+                _receiver_map.erase(iter);
+                break;
+            }
+        }
+    }
+
+    // cancel_stream() may take a while, it is called out of the lock
+    if (target_recvr != nullptr) {
+        target_recvr->cancel_stream();
+        return Status::OK();
+    }
+    std::stringstream err;
+    err << "unknown block receiver id: fragment_instance_id=" << fragment_instance_id
+        << " node_id=" << node_id;
+    LOG(ERROR) << err.str();
+    return Status::InternalError(err.str());
+}
+
+void VDataStreamMgr::cancel(const TUniqueId& fragment_instance_id) {
+    VLOG_QUERY << "cancelling all streams for fragment=" << fragment_instance_id;
+    std::vector<std::shared_ptr<VDataStreamRecvr>> recvrs;
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        auto iter = _fragment_stream_set.lower_bound(std::make_pair(fragment_instance_id, 0));
+        for (; iter != _fragment_stream_set.end() && iter->first == fragment_instance_id;
+             ++iter) {
+            auto recvr = find_recvr(iter->first, iter->second, false);
+            if (recvr == nullptr) {
+                LOG(ERROR) << "cancel(): missing in stream_map: fragment=" << iter->first
+                           << " node=" << iter->second;
+            } else {
+                recvrs.push_back(recvr);
+            }
+        }
+    }
+
+    // cancel_stream() may take a while, it is called out of the lock
+    for (auto& recvr : recvrs) {
+        recvr->cancel_stream();
+    }
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,107 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+
+#include "common/status.h"
+#include "gen_cpp/Types_types.h" // for TUniqueId
+#include "gen_cpp/internal_service.pb.h"
+#include "runtime/descriptors.h" // for PlanNodeId
+#include "runtime/query_statistics.h"
+#include "util/runtime_profile.h"
+
+namespace google {
+namespace protobuf {
+class Closure;
+}
+} // namespace google
+
+namespace doris {
+class RuntimeState;
+
+namespace vectorized {
+class VDataStreamRecvr;
+
+// Vectorized version of DataStreamMgr, which manages the incoming streams of Blocks of
+// this backend. The senders add blocks through transmit_block rpcs, or directly to the
+// receivers of this backend.
+class VDataStreamMgr {
+public:
+    VDataStreamMgr();
+    ~VDataStreamMgr();
+
+    // Create a receiver for a fragment_instance_id/node_id destination. If is_merging
+    // is true, the receiver keeps one queue per sender to merge their sorted streams.
+    // The ownership of the receiver is shared between this manager and the caller.
+    std::shared_ptr<VDataStreamRecvr> create_recvr(
+            RuntimeState* state, const RowDescriptor& row_desc,
+            const TUniqueId& fragment_instance_id, PlanNodeId dest_node_id, int num_senders,
+            int buffer_size, RuntimeProfile* profile, bool is_merging,
+            std::shared_ptr<QueryStatisticsRecvr> sub_plan_query_statistics_recvr);
+
+    // Return the receiver of fragment_instance_id/node_id, or nullptr if not found.
+    std::shared_ptr<VDataStreamRecvr> find_recvr(const TUniqueId& fragment_instance_id,
+                                                 PlanNodeId node_id, bool acquire_lock = true);
+
+    Status transmit_block(const PTransmitDataParams* request, ::google::protobuf::Closure** done);
+
+    // Close all the receivers of fragment_instance_id immediately.
+    void cancel(const TUniqueId& fragment_instance_id);
+
+private:
+    friend class VDataStreamRecvr;
+
+    // Remove the receiver of fragment_instance_id/node_id from the map.
+    Status deregister_recvr(const TUniqueId& fragment_instance_id, PlanNodeId node_id);
+
+    uint32_t get_hash_value(const TUniqueId& fragment_instance_id, PlanNodeId node_id);
+
+    // protects all the members below
+    std::mutex _lock;
+
+    // the hash value of fragment_instance_id/node_id to the receivers
+    using StreamMap = std::unordered_multimap<uint32_t, std::shared_ptr<VDataStreamRecvr>>;
+    StreamMap _receiver_map;
+
+    struct ComparisonOp {
+        bool operator()(const std::pair<doris::TUniqueId, PlanNodeId>& a,
+                        const std::pair<doris::TUniqueId, PlanNodeId>& b) const {
+            if (a.first.hi < b.first.hi) {
+                return true;
+            } else if (a.first.hi > b.first.hi) {
+                return false;
+            } else if (a.first.lo < b.first.lo) {
+                return true;
+            } else if (a.first.lo > b.first.lo) {
+                return false;
+            }
+            return a.second < b.second;
+        }
+    };
+    // the fragment_instance_id/node_id of the registered receivers, to find all the
+    // receivers of a fragment instance
+    using FragmentStreamSet = std::set<std::pair<TUniqueId, PlanNodeId>, ComparisonOp>;
+    FragmentStreamSet _fragment_stream_set;
+};
+
+} // namespace vectorized
+} // namespace doris
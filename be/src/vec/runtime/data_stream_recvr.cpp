@@ -0,0 +1,378 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/runtime/data_stream_recvr.h"
+
+#include <google/protobuf/stubs/common.h>
+
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "gen_cpp/data.pb.h"
+#include "runtime/mem_tracker.h"
+#include "util/uid_util.h"
+#include "vec/core/block.h"
+#include "vec/runtime/data_stream_mgr.h"
+#include "vec/runtime/sorted_run_merger.h"
+
+namespace doris::vectorized {
+
+// Run by the consumer to wake up a sender of this backend waiting for the buffered
+// blocks to be consumed.
+class LocalSenderClosure : public google::protobuf::Closure {
+public:
+    void Run() override { _cv.notify_one(); }
+    void wait(std::unique_lock<std::mutex>& lock) { _cv.wait(lock); }
+
+private:
+    std::condition_variable _cv;
+};
+
+// A blocking queue of the blocks of one or more senders.
+class VDataStreamRecvr::SenderQueue {
+public:
+    SenderQueue(VDataStreamRecvr* parent_recvr, int num_senders)
+            : _recvr(parent_recvr), _num_remaining_senders(num_senders) {}
+
+    ~SenderQueue() {}
+
+    // Return the next block of this queue, which is owned by the queue until the next
+    // call. Blocks until a block arrives or all the senders are done, nullptr at the end.
+    Status get_next(Block** next_block);
+
+    Status add_block(const PBlock& pblock, int be_number, int64_t packet_seq,
+                     ::google::protobuf::Closure** done);
+
+    void add_block(Block* block, bool use_move);
+
+    // Decrement the number of remaining senders and signal the end of the stream if it
+    // drops to 0.
+    void decrement_senders(int be_number);
+
+    // Drop the queued blocks and the later ones, and wake up the consumer.
+    void cancel();
+
+    void close();
+
+private:
+    VDataStreamRecvr* _recvr;
+
+    // protects all the members below
+    std::mutex _lock;
+    bool _is_cancelled = false;
+    int _num_remaining_senders;
+    std::condition_variable _data_arrival_cv;
+
+    // the (bytes, block) pairs owned by the queue
+    std::list<std::pair<int64_t, Block*>> _block_queue;
+    std::unique_ptr<Block> _current_block;
+    bool _received_first_block = false;
+
+    std::unordered_set<int> _sender_eos_set;          // be_number
+    std::unordered_map<int, int64_t> _packet_seq_map; // be_number => packet_seq
+    // the delayed ACKs of the remote senders and the waiting local senders
+    std::deque<std::pair<google::protobuf::Closure*, MonotonicStopWatch>> _pending_closures;
+    std::unordered_map<std::thread::id, std::unique_ptr<LocalSenderClosure>> _local_closures;
+};
+
+Status VDataStreamRecvr::SenderQueue::get_next(Block** next_block) {
+    std::unique_lock<std::mutex> l(_lock);
+    while (!_is_cancelled && _block_queue.empty() && _num_remaining_senders > 0) {
+        // the time waiting for the senders is not active time
+        CANCEL_SAFE_SCOPED_TIMER(_recvr->_data_arrival_timer, &_is_cancelled);
+        CANCEL_SAFE_SCOPED_TIMER(
+                _received_first_block ? nullptr : _recvr->_first_block_wait_total_timer,
+                &_is_cancelled);
+        _data_arrival_cv.wait(l);
+    }
+
+    _current_block.reset();
+    *next_block = nullptr;
+    if (_is_cancelled) {
+        return Status::Cancelled("Cancelled");
+    }
+    if (_block_queue.empty()) {
+        DCHECK_EQ(_num_remaining_senders, 0);
+        return Status::OK();
+    }
+
+    _received_first_block = true;
+    auto [block_bytes, block] = _block_queue.front();
+    _block_queue.pop_front();
+    _recvr->_num_buffered_bytes -= block_bytes;
+    _recvr->_mem_tracker->Release(block_bytes);
+    _current_block.reset(block);
+    *next_block = block;
+
+    if (!_pending_closures.empty()) {
+        auto closure_pair = _pending_closures.front();
+        closure_pair.first->Run();
+        _pending_closures.pop_front();
+        closure_pair.second.stop();
+        _recvr->_buffer_full_total_timer->update(closure_pair.second.elapsed_time());
+    }
+    return Status::OK();
+}
+
+Status VDataStreamRecvr::SenderQueue::add_block(const PBlock& pblock, int be_number,
+                                                int64_t packet_seq,
+                                                ::google::protobuf::Closure** done) {
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        if (_is_cancelled) {
+            return Status::OK();
+        }
+        auto iter = _packet_seq_map.find(be_number);
+        if (iter != _packet_seq_map.end()) {
+            if (iter->second >= packet_seq) {
+                LOG(WARNING) << "packet already exist [cur_packet_id= " << iter->second
+                             << " receive_packet_id=" << packet_seq << "]";
+                return Status::OK();
+            }
+            iter->second = packet_seq;
+        } else {
+            _packet_seq_map.emplace(be_number, packet_seq);
+        }
+        // a packet of a sender may arrive after its eos packet if it failed to be sent
+        if (_num_remaining_senders <= 0) {
+            DCHECK(_sender_eos_set.end() != _sender_eos_set.find(be_number));
+            return Status::OK();
+        }
+    }
+
+    // the decompression and the deserialization are done out of the lock
+    std::unique_ptr<Block> block(new Block(_recvr->_header.cloneEmpty()));
+    {
+        SCOPED_TIMER(_recvr->_deserialize_block_timer);
+        RETURN_IF_ERROR(block->deserialize(pblock));
+    }
+    int64_t block_bytes = block->bytes();
+    COUNTER_UPDATE(_recvr->_bytes_received_counter, pblock.ByteSizeLong());
+
+    std::lock_guard<std::mutex> l(_lock);
+    if (_is_cancelled) {
+        return Status::OK();
+    }
+    // The block is always accepted to keep the rpc pipeline going, but the ACK is not
+    // sent while the buffer is full so that the sender waits.
+    // The queue must accept a block while it is empty, or a merging receiver waiting
+    // for this sender would never get it.
+    _block_queue.emplace_back(block_bytes, block.release());
+    _recvr->_mem_tracker->Consume(block_bytes);
+    if (done != nullptr && _recvr->exceeds_limit(block_bytes)) {
+        MonotonicStopWatch monotonic_stop_watch;
+        monotonic_stop_watch.start();
+        DCHECK(*done != nullptr);
+        _pending_closures.emplace_back(*done, monotonic_stop_watch);
+        *done = nullptr;
+    }
+    _recvr->_num_buffered_bytes += block_bytes;
+    _data_arrival_cv.notify_one();
+    return Status::OK();
+}
+
+void VDataStreamRecvr::SenderQueue::add_block(Block* block, bool use_move) {
+    std::unique_lock<std::mutex> l(_lock);
+    if (_is_cancelled) {
+        return;
+    }
+    Block* nblock = new Block();
+    if (use_move) {
+        nblock->swap(*block);
+    } else {
+        // the columns are immutable, they are shared instead of copied
+        *nblock = *block;
+    }
+    int64_t block_bytes = nblock->bytes();
+    _block_queue.emplace_back(block_bytes, nblock);
+    _recvr->_mem_tracker->Consume(block_bytes);
+    _data_arrival_cv.notify_one();
+    if (_recvr->exceeds_limit(block_bytes)) {
+        std::thread::id tid = std::this_thread::get_id();
+        MonotonicStopWatch monotonic_stop_watch;
+        monotonic_stop_watch.start();
+        auto iter = _local_closures.find(tid);
+        if (iter == _local_closures.end()) {
+            iter = _local_closures.emplace(tid, new LocalSenderClosure).first;
+        }
+        _pending_closures.emplace_back(iter->second.get(), monotonic_stop_watch);
+        iter->second->wait(l);
+    }
+    _recvr->_num_buffered_bytes += block_bytes;
+}
+
+void VDataStreamRecvr::SenderQueue::decrement_senders(int be_number) {
+    std::lock_guard<std::mutex> l(_lock);
+    if (_sender_eos_set.end() != _sender_eos_set.find(be_number)) {
+        return;
+    }
+    _sender_eos_set.insert(be_number);
+    DCHECK_GT(_num_remaining_senders, 0);
+    _num_remaining_senders--;
+    VLOG_FILE << "decremented senders: fragment_instance_id=" << _recvr->fragment_instance_id()
+              << " node_id=" << _recvr->dest_node_id() << " #senders=" << _num_remaining_senders;
+    if (_num_remaining_senders == 0) {
+        _data_arrival_cv.notify_one();
+    }
+}
+
+void VDataStreamRecvr::SenderQueue::cancel() {
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        if (_is_cancelled) {
+            return;
+        }
+        _is_cancelled = true;
+        VLOG_QUERY << "cancelled stream: _fragment_instance_id=" << _recvr->fragment_instance_id()
+                   << " node_id=" << _recvr->dest_node_id();
+    }
+    // wake up the consumer, it notices that the stream is cancelled
+    _data_arrival_cv.notify_all();
+
+    std::lock_guard<std::mutex> l(_lock);
+    for (auto closure_pair : _pending_closures) {
+        closure_pair.first->Run();
+    }
+    _pending_closures.clear();
+}
+
+void VDataStreamRecvr::SenderQueue::close() {
+    std::lock_guard<std::mutex> l(_lock);
+    // no block may be added once the queue is cancelled, the later ones would leak
+    _is_cancelled = true;
+    for (auto closure_pair : _pending_closures) {
+        closure_pair.first->Run();
+    }
+    _pending_closures.clear();
+
+    for (auto& [block_bytes, block] : _block_queue) {
+        _recvr->_mem_tracker->Release(block_bytes);
+        delete block;
+    }
+    _block_queue.clear();
+    _current_block.reset();
+}
+
+VDataStreamRecvr::VDataStreamRecvr(
+        VDataStreamMgr* stream_mgr, const std::shared_ptr<MemTracker>& parent_tracker,
+        const RowDescriptor& row_desc, const TUniqueId& fragment_instance_id,
+        PlanNodeId dest_node_id, int num_senders, bool is_merging, int total_buffer_limit,
+        RuntimeProfile* profile,
+        std::shared_ptr<QueryStatisticsRecvr> sub_plan_query_statistics_recvr)
+        : _mgr(stream_mgr),
+          _fragment_instance_id(fragment_instance_id),
+          _dest_node_id(dest_node_id),
+          _total_buffer_limit(total_buffer_limit),
+          _row_desc(row_desc),
+          _is_merging(is_merging),
+          _num_buffered_bytes(0),
+          _profile(profile),
+          _sub_plan_query_statistics_recvr(sub_plan_query_statistics_recvr) {
+    _mem_tracker = MemTracker::CreateTracker(
+            _profile, -1, "VDataStreamRecvr:" + print_id(_fragment_instance_id), parent_tracker);
+
+    for (const auto tuple_desc : _row_desc.tuple_descriptors()) {
+        for (const auto slot_desc : tuple_desc->slots()) {
+            _header.insert(ColumnWithTypeAndName(slot_desc->get_empty_mutable_column(),
+                                                 slot_desc->get_data_type_ptr(),
+                                                 slot_desc->col_name()));
+        }
+    }
+
+    int num_queues = is_merging ? num_senders : 1;
+    int num_sender_per_queue = is_merging ? 1 : num_senders;
+    _sender_queues.reserve(num_queues);
+    for (int i = 0; i < num_queues; ++i) {
+        _sender_queues.push_back(
+                _sender_queue_pool.add(new SenderQueue(this, num_sender_per_queue)));
+    }
+
+    _bytes_received_counter = ADD_COUNTER(_profile, "BytesReceived", TUnit::BYTES);
+    _deserialize_block_timer = ADD_TIMER(_profile, "DeserializeBlockTimer");
+    _data_arrival_timer = ADD_TIMER(_profile, "DataArrivalWaitTime");
+    _buffer_full_total_timer = ADD_TIMER(_profile, "SendersBlockedTotalTimer(*)");
+    _first_block_wait_total_timer = ADD_TIMER(_profile, "FirstBatchArrivalWaitTime");
+}
+
+VDataStreamRecvr::~VDataStreamRecvr() {
+    DCHECK(_mgr == nullptr) << "Must call close()";
+}
+
+Status VDataStreamRecvr::get_next(Block** next_block) {
+    DCHECK(!_is_merging);
+    DCHECK_EQ(_sender_queues.size(), 1);
+    return _sender_queues[0]->get_next(next_block);
+}
+
+Status VDataStreamRecvr::create_merger(const std::vector<VExprContext*>& ordering_expr_ctxs,
+                                       const std::vector<bool>& is_asc_order,
+                                       const std::vector<bool>& nulls_first, size_t batch_size) {
+    DCHECK(_is_merging);
+    std::vector<VSortedRunMerger::BlockSupplier> input_runs;
+    for (auto sender_queue : _sender_queues) {
+        input_runs.emplace_back(
+                [sender_queue](Block** block) { return sender_queue->get_next(block); });
+    }
+    _merger.reset(new VSortedRunMerger(ordering_expr_ctxs, is_asc_order, nulls_first,
+                                       batch_size, _profile));
+    return _merger->prepare(input_runs);
+}
+
+Status VDataStreamRecvr::get_next_merging(Block* output_block, bool* eos) {
+    DCHECK(_merger != nullptr);
+    return _merger->get_next(output_block, eos);
+}
+
+Status VDataStreamRecvr::add_block(const PBlock& pblock, int sender_id, int be_number,
+                                   int64_t packet_seq, ::google::protobuf::Closure** done) {
+    int use_sender_id = _is_merging ? sender_id : 0;
+    return _sender_queues[use_sender_id]->add_block(pblock, be_number, packet_seq, done);
+}
+
+void VDataStreamRecvr::add_block(Block* block, int sender_id, bool use_move) {
+    int use_sender_id = _is_merging ? sender_id : 0;
+    _sender_queues[use_sender_id]->add_block(block, use_move);
+}
+
+void VDataStreamRecvr::remove_sender(int sender_id, int be_number) {
+    int use_sender_id = _is_merging ? sender_id : 0;
+    _sender_queues[use_sender_id]->decrement_senders(be_number);
+}
+
+void VDataStreamRecvr::cancel_stream() {
+    for (auto sender_queue : _sender_queues) {
+        sender_queue->cancel();
+    }
+}
+
+void VDataStreamRecvr::close() {
+    for (auto sender_queue : _sender_queues) {
+        sender_queue->close();
+    }
+    // remove this receiver from the VDataStreamMgr which created it
+    _mgr->deregister_recvr(fragment_instance_id(), dest_node_id());
+    _mgr = nullptr;
+    _merger.reset();
+    _mem_tracker.reset();
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,151 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "common/object_pool.h"
+#include "common/status.h"
+#include "gen_cpp/Types_types.h" // for TUniqueId
+#include "runtime/descriptors.h"
+#include "runtime/query_statistics.h"
+#include "util/runtime_profile.h"
+#include "vec/core/block.h"
+
+namespace google {
+namespace protobuf {
+class Closure;
+}
+} // namespace google
+
+namespace doris {
+class MemTracker;
+class PBlock;
+
+namespace vectorized {
+class VDataStreamMgr;
+class VExprContext;
+class VSortedRunMerger;
+
+// Vectorized version of DataStreamRecvr, the single receiver of an m:n stream of Blocks.
+// The blocks received from the senders are queued, in one queue for all the senders,
+// or one queue per sender if the receiver is merging. The ACK of a remote sender is
+// delayed while the buffered bytes exceed the buffer limit, so that the sender waits
+// before sending more data.
+// The PBlocks are deserialized into blocks holding the columns of the slots of row_desc.
+//
+// close() must be called by the owner (the exchange node) to remove the receiver
+// from its VDataStreamMgr.
+class VDataStreamRecvr {
+public:
+    ~VDataStreamRecvr();
+
+    // Return the next block of the stream, blocks if there isn't any yet. A nullptr
+    // block is the end of the stream. The block is owned by the receiver and valid until
+    // the next call. Must only be called if the receiver is not merging.
+    Status get_next(Block** next_block);
+
+    // Create the merger of the sorted streams of the senders, the ordering exprs must
+    // be prepared and opened. Must only be called if the receiver is merging.
+    Status create_merger(const std::vector<VExprContext*>& ordering_expr_ctxs,
+                         const std::vector<bool>& is_asc_order,
+                         const std::vector<bool>& nulls_first, size_t batch_size);
+
+    // Fill output_block with the next rows of the merged streams.
+    Status get_next_merging(Block* output_block, bool* eos);
+
+    // Add a block of a sender of this backend. If use_move is false, the columns are
+    // shared with the sender, which must not modify them.
+    void add_block(Block* block, int sender_id, bool use_move);
+
+    // Deregister from VDataStreamMgr, which shares the ownership of this instance.
+    void close();
+
+    const TUniqueId& fragment_instance_id() const { return _fragment_instance_id; }
+    PlanNodeId dest_node_id() const { return _dest_node_id; }
+    const RowDescriptor& row_desc() const { return _row_desc; }
+    std::shared_ptr<MemTracker> mem_tracker() const { return _mem_tracker; }
+
+    void add_sub_plan_statistics(const PQueryStatistics& statistics, int sender_id) {
+        _sub_plan_query_statistics_recvr->insert(statistics, sender_id);
+    }
+
+    // Indicate that a sender is done.
+    void remove_sender(int sender_id, int be_number);
+
+private:
+    friend class VDataStreamMgr;
+    class SenderQueue;
+
+    VDataStreamRecvr(VDataStreamMgr* stream_mgr, const std::shared_ptr<MemTracker>& parent_tracker,
+                     const RowDescriptor& row_desc, const TUniqueId& fragment_instance_id,
+                     PlanNodeId dest_node_id, int num_senders, bool is_merging,
+                     int total_buffer_limit, RuntimeProfile* profile,
+                     std::shared_ptr<QueryStatisticsRecvr> sub_plan_query_statistics_recvr);
+
+    // If the buffer limit is exceeded, done is kept to delay the ACK and *done is set
+    // to nullptr.
+    Status add_block(const PBlock& pblock, int sender_id, int be_number, int64_t packet_seq,
+                     ::google::protobuf::Closure** done);
+
+    // Empty the sender queues and notify all the waiting consumers of the cancellation.
+    void cancel_stream();
+
+    bool exceeds_limit(int64_t block_bytes) {
+        return _num_buffered_bytes + block_bytes > _total_buffer_limit;
+    }
+
+    // VDataStreamMgr instance used to create this recvr. (Not owned)
+    VDataStreamMgr* _mgr;
+
+    TUniqueId _fragment_instance_id;
+    PlanNodeId _dest_node_id;
+
+    // soft upper limit of the bytes buffered across all the sender queues
+    int64_t _total_buffer_limit;
+
+    RowDescriptor _row_desc;
+    // the empty columns of the slots of _row_desc, which the PBlocks are deserialized into
+    Block _header;
+
+    bool _is_merging;
+
+    std::atomic<int64_t> _num_buffered_bytes;
+
+    std::shared_ptr<MemTracker> _mem_tracker;
+
+    // one queue for all the senders, or one per sender if _is_merging is true
+    std::vector<SenderQueue*> _sender_queues;
+    ObjectPool _sender_queue_pool;
+
+    std::unique_ptr<VSortedRunMerger> _merger;
+
+    RuntimeProfile* _profile;
+    RuntimeProfile::Counter* _bytes_received_counter;
+    RuntimeProfile::Counter* _deserialize_block_timer;
+    RuntimeProfile::Counter* _first_block_wait_total_timer;
+    RuntimeProfile::Counter* _buffer_full_total_timer;
+    RuntimeProfile::Counter* _data_arrival_timer;
+
+    std::shared_ptr<QueryStatisticsRecvr> _sub_plan_query_statistics_recvr;
+};
+
+} // namespace vectorized
+} // namespace doris
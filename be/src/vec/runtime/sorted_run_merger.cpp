@@ -0,0 +1,161 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/runtime/sorted_run_merger.h"
+
+#include <algorithm>
+
+#include "vec/exprs/vexpr_context.h"
+
+namespace doris::vectorized {
+
+VSortedRunMerger::VSortedRunMerger(const std::vector<VExprContext*>& ordering_expr_ctxs,
+                                   const std::vector<bool>& is_asc_order,
+                                   const std::vector<bool>& nulls_first, size_t batch_size,
+                                   RuntimeProfile* profile)
+        : _ordering_expr_ctxs(ordering_expr_ctxs),
+          _is_asc_order(is_asc_order),
+          _nulls_first(nulls_first),
+          _batch_size(batch_size) {
+    _get_next_timer = ADD_TIMER(profile, "MergeGetNext");
+    _get_next_block_timer = ADD_TIMER(profile, "MergeGetNextBlock");
+}
+
+Status VSortedRunMerger::prepare(const std::vector<BlockSupplier>& input_runs) {
+    _input_runs = input_runs;
+    size_t num_runs = _input_runs.size();
+    _blocks.resize(num_runs);
+    // the cursors point to the elements of _cursor_impls, which must not move
+    _cursor_impls.resize(num_runs);
+
+    std::vector<SortCursor> cursors;
+    for (size_t i = 0; i < num_runs; ++i) {
+        bool has_block = false;
+        RETURN_IF_ERROR(_next_block(i, &has_block));
+        if (has_block) {
+            _cursor_impls[i] = SortCursorImpl(_blocks[i], _sort_description, i);
+            cursors.emplace_back(&_cursor_impls[i]);
+        }
+    }
+    _merger.init(std::move(cursors));
+    return Status::OK();
+}
+
+Status VSortedRunMerger::_next_block(size_t run, bool* has_block) {
+    SCOPED_TIMER(_get_next_block_timer);
+    *has_block = false;
+    while (true) {
+        Block* block = nullptr;
+        RETURN_IF_ERROR(_input_runs[run](&block));
+        if (block == nullptr) {
+            return Status::OK();
+        }
+        if (block->rows() == 0) {
+            continue;
+        }
+
+        Block& sort_block = _blocks[run];
+        sort_block = *block;
+        if (_header.columns() == 0) {
+            _num_columns = sort_block.columns();
+            _header = sort_block.cloneEmpty();
+        }
+
+        SortDescription sort_description;
+        std::vector<int> result_column_ids;
+        RETURN_IF_ERROR(VExprContext::execute_exprs(_ordering_expr_ctxs, &sort_block,
+                                                    &result_column_ids));
+        for (size_t i = 0; i < _ordering_expr_ctxs.size(); ++i) {
+            int direction = _is_asc_order[i] ? 1 : -1;
+            int nulls_direction = _nulls_first[i] ? -direction : direction;
+            sort_description.emplace_back(result_column_ids[i], direction, nulls_direction);
+        }
+        // the exprs append their results in the same order to all the blocks
+        if (_sort_description.empty()) {
+            _sort_description = std::move(sort_description);
+        }
+
+        // the cursors read the rows one by one from full columns
+        for (size_t i = 0; i < sort_block.columns(); ++i) {
+            auto& column = sort_block.getByPosition(i).column;
+            column = column->convertToFullColumnIfConst();
+        }
+        *has_block = true;
+        return Status::OK();
+    }
+}
+
+Status VSortedRunMerger::_next_row() {
+    auto& cursor = _merger.top();
+    if (!cursor->isLast()) {
+        cursor->next();
+        _merger.updateTop();
+        return Status::OK();
+    }
+
+    size_t run = cursor->order;
+    bool has_block = false;
+    RETURN_IF_ERROR(_next_block(run, &has_block));
+    if (has_block) {
+        _cursor_impls[run].reset(_blocks[run]);
+        _merger.updateTop();
+    } else {
+        _merger.removeTop();
+    }
+    return Status::OK();
+}
+
+Status VSortedRunMerger::get_next(Block* output_block, bool* eos) {
+    SCOPED_TIMER(_get_next_timer);
+    if (_merger.empty()) {
+        *eos = true;
+        return Status::OK();
+    }
+
+    MutableColumns columns = _header.cloneEmptyColumns();
+    size_t rows = 0;
+    while (rows < _batch_size && !_merger.empty()) {
+        auto& cursor = _merger.top();
+        if (_merger.size() > 1) {
+            for (size_t i = 0; i < _num_columns; ++i) {
+                columns[i]->insertFrom(*cursor->all_columns[i], cursor->pos);
+            }
+            ++rows;
+            RETURN_IF_ERROR(_next_row());
+            continue;
+        }
+
+        // nothing to compare with, the rest of the block of the last run is copied at once
+        size_t length = std::min(cursor->rows - cursor->pos, _batch_size - rows);
+        for (size_t i = 0; i < _num_columns; ++i) {
+            columns[i]->insertRangeFrom(*cursor->all_columns[i], cursor->pos, length);
+        }
+        rows += length;
+        cursor->pos += length;
+        if (cursor->pos == cursor->rows) {
+            // the cursor stays on the last row of the block to fetch the next one
+            --cursor->pos;
+            RETURN_IF_ERROR(_next_row());
+        }
+    }
+
+    *output_block = _header.cloneWithColumns(std::move(columns));
+    *eos = _merger.empty();
+    return Status::OK();
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,84 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include "common/status.h"
+#include "util/runtime_profile.h"
+#include "vec/common/loser_tree.h"
+#include "vec/core/block.h"
+#include "vec/core/sort_cursor.h"
+
+namespace doris::vectorized {
+
+class VExprContext;
+
+// Vectorized version of SortedRunMerger.
+// Merges the sorted runs of blocks of the senders of a merging exchange into a single
+// sorted stream. The ordering exprs are evaluated over each input block and appended
+// to it, a loser tree of cursors, one per run, picks the next row. The output blocks
+// only have the columns of the input blocks.
+// The blocks returned by a run must stay valid until the next block is asked for.
+class VSortedRunMerger {
+public:
+    // Returns the next block of a run, nullptr at the end of the run.
+    using BlockSupplier = std::function<Status(Block**)>;
+
+    // The ordering exprs must be prepared and opened by the caller.
+    VSortedRunMerger(const std::vector<VExprContext*>& ordering_expr_ctxs,
+                     const std::vector<bool>& is_asc_order, const std::vector<bool>& nulls_first,
+                     size_t batch_size, RuntimeProfile* profile);
+
+    // Fetch the first block of every run.
+    Status prepare(const std::vector<BlockSupplier>& input_runs);
+
+    // Fill output_block with at most batch_size rows of the merged stream.
+    Status get_next(Block* output_block, bool* eos);
+
+private:
+    // Replace the current block of the run by its next non empty block, has_block is
+    // set to false at the end of the run.
+    Status _next_block(size_t run, bool* has_block);
+
+    // Move the merged stream to its next row.
+    Status _next_row();
+
+    const std::vector<VExprContext*>& _ordering_expr_ctxs;
+    const std::vector<bool>& _is_asc_order;
+    const std::vector<bool>& _nulls_first;
+    size_t _batch_size;
+
+    std::vector<BlockSupplier> _input_runs;
+    // the current block of each run with the results of the ordering exprs
+    std::vector<Block> _blocks;
+    SortDescription _sort_description;
+    // the number of columns of the input blocks
+    size_t _num_columns = 0;
+    // the empty columns of the output, taken from the first input block
+    Block _header;
+
+    std::vector<SortCursorImpl> _cursor_impls;
+    LoserTree<SortCursor> _merger;
+
+    RuntimeProfile::Counter* _get_next_timer;
+    RuntimeProfile::Counter* _get_next_block_timer;
+};
+
+} // namespace doris::vectorized
@@ -0,0 +1,626 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/sink/data_stream_sender.h"
+
+#include <algorithm>
+#include <boost/bind.hpp>
+#include <map>
+#include <sstream>
+
+#include "common/config.h"
+#include "common/logging.h"
+#include "gen_cpp/DataSinks_types.h"
+#include "gen_cpp/PaloInternalService_types.h"
+#include "gen_cpp/internal_service.pb.h"
+#include "runtime/descriptors.h"
+#include "runtime/exec_env.h"
+#include "runtime/mem_tracker.h"
+#include "runtime/raw_value.h"
+#include "runtime/runtime_state.h"
+#include "service/backend_options.h"
+#include "service/brpc.h"
+#include "util/brpc_stub_cache.h"
+#include "util/ref_count_closure.h"
+#include "util/uid_util.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/common/sip_hash.h"
+#include "vec/exprs/vexpr.h"
+#include "vec/exprs/vexpr_context.h"
+#include "vec/runtime/data_stream_mgr.h"
+#include "vec/runtime/data_stream_recvr.h"
+
+namespace doris::vectorized {
+
+// A channel buffers the rows sent to a single destination ipaddress/node, and sends
+// them asynchronously via calls to transmit_block once they reach the batch size.
+// There can only be one in-flight RPC at any one time, which allows the receiver to
+// throttle the sender by withholding acks.
+// *Not* thread-safe.
+class VDataStreamSender::Channel {
+public:
+    Channel(VDataStreamSender* parent, const TNetworkAddress& brpc_dest,
+            const TUniqueId& fragment_instance_id, PlanNodeId dest_node_id,
+            bool is_transfer_chain, bool send_query_statistics_with_every_batch)
+            : _parent(parent),
+              _fragment_instance_id(fragment_instance_id),
+              _dest_node_id(dest_node_id),
+              _num_data_bytes_sent(0),
+              _packet_seq(0),
+              _need_close(false),
+              _brpc_dest_addr(brpc_dest),
+              _is_transfer_chain(is_transfer_chain),
+              _send_query_statistics_with_every_batch(send_query_statistics_with_every_batch) {
+        std::string localhost = BackendOptions::get_localhost();
+        _is_local =
+                _brpc_dest_addr.hostname == localhost && _brpc_dest_addr.port == config::brpc_port;
+        if (_is_local) {
+            LOG(INFO) << "will use local exechange, dest_node_id:" << _dest_node_id;
+        }
+    }
+
+    ~Channel() {
+        if (_closure != nullptr && _closure->unref()) {
+            delete _closure;
+        }
+        // release this before request desctruct
+        _brpc_request.release_finst_id();
+    }
+
+    Status init(RuntimeState* state);
+
+    // Append the rows of columns, which have the layout of the header of the parent,
+    // and send the buffered rows once they reach the batch size.
+    // Returns error status if any of the preceding rpcs failed, OK otherwise.
+    Status add_rows(MutableColumns&& columns);
+
+    // Asynchronously sends a serialized block, if block is nullptr, only sends eos.
+    // Returns the status of the most recently finished transmit_block rpc.
+    Status send_block(PBlock* block, bool eos = false);
+
+    // Add block to the receiver of this backend, without serializing it.
+    Status send_local_block(Block* block, bool use_move);
+
+    // Flush buffered rows and close channel. This function don't wait the response
+    // of close operation, client should call close_wait() to finish channel's close.
+    Status close(RuntimeState* state);
+
+    // Get close wait's response, to finish channel close operation.
+    Status close_wait(RuntimeState* state);
+
+    int64_t num_data_bytes_sent() const { return _num_data_bytes_sent; }
+
+    PBlock* pb_block() { return &_pb_block; }
+
+    std::string get_fragment_instance_id_str() {
+        UniqueId uid(_fragment_instance_id);
+        return uid.to_string();
+    }
+
+    bool is_local() const { return _is_local; }
+
+private:
+    inline Status _wait_last_brpc() {
+        if (_closure == nullptr) return Status::OK();
+        auto cntl = &_closure->cntl;
+        brpc::Join(cntl->call_id());
+        if (cntl->Failed()) {
+            std::stringstream ss;
+            ss << "failed to send brpc block, error=" << berror(cntl->ErrorCode())
+               << ", error_text=" << cntl->ErrorText()
+               << ", client: " << BackendOptions::get_localhost();
+            LOG(WARNING) << ss.str();
+            return Status::ThriftRpcError(ss.str());
+        }
+        return Status::OK();
+    }
+
+    // Send the buffered rows, serialized or to the local receiver.
+    Status send_current_block(bool eos = false);
+    Status close_internal();
+
+    size_t num_buffered_rows() const { return _columns.empty() ? 0 : _columns[0]->size(); }
+
+    VDataStreamSender* _parent;
+
+    TUniqueId _fragment_instance_id;
+    PlanNodeId _dest_node_id;
+
+    // the number of PBlock bytes sent successfully
+    int64_t _num_data_bytes_sent;
+    int64_t _packet_seq;
+
+    // we're accumulating rows into these columns
+    MutableColumns _columns;
+
+    bool _need_close;
+    int _be_number;
+
+    TNetworkAddress _brpc_dest_addr;
+
+    PUniqueId _finst_id;
+    PBlock _pb_block;
+    PTransmitDataParams _brpc_request;
+    PBackendService_Stub* _brpc_stub = nullptr;
+    RefCountClosure<PTransmitDataResult>* _closure = nullptr;
+    int32_t _brpc_timeout_ms = 500;
+    // whether the dest can be treated as query statistics transfer chain.
+    bool _is_transfer_chain;
+    bool _send_query_statistics_with_every_batch;
+    bool _is_local;
+};
+
+Status VDataStreamSender::Channel::init(RuntimeState* state) {
+    _be_number = state->be_number();
+
+    if (_brpc_dest_addr.hostname.empty()) {
+        LOG(WARNING) << "there is no brpc destination address's hostname"
+                        ", maybe version is not compatible.";
+        return Status::InternalError("no brpc destination");
+    }
+
+    // initialize brpc request
+    _finst_id.set_hi(_fragment_instance_id.hi);
+    _finst_id.set_lo(_fragment_instance_id.lo);
+    _brpc_request.set_allocated_finst_id(&_finst_id);
+    _brpc_request.set_node_id(_dest_node_id);
+    _brpc_request.set_sender_id(_parent->_sender_id);
+    _brpc_request.set_be_number(_be_number);
+
+    _brpc_timeout_ms = std::min(3600, state->query_options().query_timeout) * 1000;
+    if (_brpc_dest_addr.hostname == BackendOptions::get_localhost()) {
+        _brpc_stub =
+                state->exec_env()->brpc_stub_cache()->get_stub("127.0.0.1", _brpc_dest_addr.port);
+    } else {
+        _brpc_stub = state->exec_env()->brpc_stub_cache()->get_stub(_brpc_dest_addr);
+    }
+
+    // In bucket shuffle join will set fragment_instance_id (-1, -1)
+    // to build a camouflaged empty channel. the ip and port is '0.0.0.0:0"
+    // so the empty channel not need call function close_internal()
+    _need_close = (_fragment_instance_id.hi != -1 && _fragment_instance_id.lo != -1);
+    return Status::OK();
+}
+
+Status VDataStreamSender::Channel::send_block(PBlock* block, bool eos) {
+    if (_closure == nullptr) {
+        _closure = new RefCountClosure<PTransmitDataResult>();
+        _closure->ref();
+    } else {
+        RETURN_IF_ERROR(_wait_last_brpc());
+        _closure->cntl.Reset();
+    }
+    VLOG_ROW << "Channel::send_block() instance_id=" << _fragment_instance_id
+             << " dest_node=" << _dest_node_id;
+    if (_is_transfer_chain && (_send_query_statistics_with_every_batch || eos)) {
+        auto statistic = _brpc_request.mutable_query_statistics();
+        _parent->_query_statistics->to_pb(statistic);
+    }
+
+    _brpc_request.set_eos(eos);
+    if (block != nullptr) {
+        _brpc_request.set_allocated_block(block);
+        _num_data_bytes_sent += block->ByteSizeLong();
+    }
+    _brpc_request.set_packet_seq(_packet_seq++);
+
+    _closure->ref();
+    _closure->cntl.set_timeout_ms(_brpc_timeout_ms);
+    _brpc_stub->transmit_block(&_closure->cntl, &_brpc_request, &_closure->result, _closure);
+    if (block != nullptr) {
+        _brpc_request.release_block();
+    }
+    return Status::OK();
+}
+
+Status VDataStreamSender::Channel::add_rows(MutableColumns&& columns) {
+    if (_fragment_instance_id.lo == -1) {
+        return Status::OK();
+    }
+    if (_columns.empty()) {
+        _columns = std::move(columns);
+    } else {
+        size_t rows = columns[0]->size();
+        for (size_t i = 0; i < _columns.size(); ++i) {
+            _columns[i]->insertRangeFrom(*columns[i], 0, rows);
+        }
+    }
+
+    if (num_buffered_rows() >= _parent->state()->batch_size()) {
+        RETURN_IF_ERROR(send_current_block());
+    }
+    return Status::OK();
+}
+
+Status VDataStreamSender::Channel::send_current_block(bool eos) {
+    Block block;
+    if (!_columns.empty()) {
+        block = _parent->_header.cloneWithColumns(std::move(_columns));
+        _columns.clear();
+    }
+
+    if (is_local()) {
+        std::shared_ptr<VDataStreamRecvr> recvr =
+                _parent->state()->exec_env()->vstream_mgr()->find_recvr(_fragment_instance_id,
+                                                                        _dest_node_id);
+        if (recvr != nullptr) {
+            if (block.rows() > 0) {
+                recvr->add_block(&block, _parent->_sender_id, true);
+            }
+            if (eos) {
+                recvr->remove_sender(_parent->_sender_id, _be_number);
+            }
+        }
+        return Status::OK();
+    }
+
+    if (block.rows() == 0) {
+        return send_block(nullptr, eos);
+    }
+    RETURN_IF_ERROR(_parent->serialize_block(block, &_pb_block));
+    return send_block(&_pb_block, eos);
+}
+
+Status VDataStreamSender::Channel::send_local_block(Block* block, bool use_move) {
+    std::shared_ptr<VDataStreamRecvr> recvr =
+            _parent->state()->exec_env()->vstream_mgr()->find_recvr(_fragment_instance_id,
+                                                                    _dest_node_id);
+    if (recvr != nullptr) {
+        recvr->add_block(block, _parent->_sender_id, use_move);
+    }
+    return Status::OK();
+}
+
+Status VDataStreamSender::Channel::close_internal() {
+    if (!_need_close) {
+        return Status::OK();
+    }
+    VLOG_RPC << "Channel::close() instance_id=" << _fragment_instance_id
+             << " dest_node=" << _dest_node_id << " #rows= " << num_buffered_rows();
+    RETURN_IF_ERROR(send_current_block(true));
+    // Don't wait for the last packet to finish, left it to close_wait.
+    return Status::OK();
+}
+
+Status VDataStreamSender::Channel::close(RuntimeState* state) {
+    Status st = close_internal();
+    if (!st.ok()) {
+        state->log_error(st.get_error_msg());
+    }
+    return st;
+}
+
+Status VDataStreamSender::Channel::close_wait(RuntimeState* state) {
+    if (_need_close) {
+        Status st = _wait_last_brpc();
+        if (!st.ok()) {
+            state->log_error(st.get_error_msg());
+        }
+        _need_close = false;
+        return st;
+    }
+    _columns.clear();
+    return Status::OK();
+}
+
+VDataStreamSender::VDataStreamSender(ObjectPool* pool, int sender_id,
+                                     const RowDescriptor& row_desc, const TDataStreamSink& sink,
+                                     const std::vector<TPlanFragmentDestination>& destinations,
+                                     bool send_query_statistics_with_every_batch)
+        : _sender_id(sender_id),
+          _pool(pool),
+          _row_desc(row_desc),
+          _current_channel_idx(0),
+          _part_type(sink.output_partition.type),
+          _current_pb_block(&_pb_block1),
+          _profile(nullptr),
+          _serialize_batch_timer(nullptr),
+          _bytes_sent_counter(nullptr),
+          _dest_node_id(sink.dest_node_id) {
+    DCHECK_GT(destinations.size(), 0);
+    DCHECK(sink.output_partition.type == TPartitionType::UNPARTITIONED ||
+           sink.output_partition.type == TPartitionType::HASH_PARTITIONED ||
+           sink.output_partition.type == TPartitionType::RANDOM ||
+           sink.output_partition.type == TPartitionType::BUCKET_SHFFULE_HASH_PARTITIONED);
+
+    std::map<int64_t, int64_t> fragment_id_to_channel_index;
+    for (int i = 0; i < destinations.size(); ++i) {
+        // Select first dest as transfer chain.
+        bool is_transfer_chain = (i == 0);
+        const auto& fragment_instance_id = destinations[i].fragment_instance_id;
+        if (fragment_id_to_channel_index.find(fragment_instance_id.lo) ==
+            fragment_id_to_channel_index.end()) {
+            _channel_shared_ptrs.emplace_back(new Channel(
+                    this, destinations[i].brpc_server, fragment_instance_id, sink.dest_node_id,
+                    is_transfer_chain, send_query_statistics_with_every_batch));
+            fragment_id_to_channel_index.insert(
+                    {fragment_instance_id.lo, _channel_shared_ptrs.size() - 1});
+            _channels.push_back(_channel_shared_ptrs.back().get());
+        } else {
+            _channel_shared_ptrs.emplace_back(
+                    _channel_shared_ptrs[fragment_id_to_channel_index[fragment_instance_id.lo]]);
+        }
+    }
+    _name = "VDataStreamSender";
+}
+
+VDataStreamSender::~VDataStreamSender() {
+    _channel_shared_ptrs.clear();
+}
+
+Status VDataStreamSender::init(const TDataSink& tsink) {
+    RETURN_IF_ERROR(DataSink::init(tsink));
+    const TDataStreamSink& t_stream_sink = tsink.stream_sink;
+    if (_part_type == TPartitionType::HASH_PARTITIONED ||
+        _part_type == TPartitionType::BUCKET_SHFFULE_HASH_PARTITIONED) {
+        RETURN_IF_ERROR(VExpr::create_expr_trees(
+                _pool, t_stream_sink.output_partition.partition_exprs, &_partition_expr_ctxs));
+    } else if (_part_type == TPartitionType::RANGE_PARTITIONED) {
+        return Status::NotSupported("Range partition is not supported by VDataStreamSender");
+    }
+    return Status::OK();
+}
+
+Status VDataStreamSender::prepare(RuntimeState* state) {
+    RETURN_IF_ERROR(DataSink::prepare(state));
+    _state = state;
+    std::string instances;
+    for (const auto& channel : _channels) {
+        if (instances.empty()) {
+            instances = channel->get_fragment_instance_id_str();
+        } else {
+            instances += ", ";
+            instances += channel->get_fragment_instance_id_str();
+        }
+    }
+    std::stringstream title;
+    title << "VDataStreamSender (dst_id=" << _dest_node_id << ", dst_fragments=[" << instances
+          << "])";
+    _profile = _pool->add(new RuntimeProfile(title.str()));
+    SCOPED_TIMER(_profile->total_time_counter());
+    _mem_tracker = MemTracker::CreateTracker(
+            _profile, -1, "VDataStreamSender:" + print_id(state->fragment_instance_id()),
+            state->instance_mem_tracker());
+
+    if (_part_type == TPartitionType::UNPARTITIONED || _part_type == TPartitionType::RANDOM) {
+        // Randomize the order we open/transmit to channels to avoid thundering herd problems.
+        srand(reinterpret_cast<uint64_t>(this));
+        random_shuffle(_channels.begin(), _channels.end());
+    } else {
+        RETURN_IF_ERROR(VExpr::prepare(_partition_expr_ctxs, state, _row_desc, _expr_mem_tracker));
+    }
+
+    _bytes_sent_counter = ADD_COUNTER(profile(), "BytesSent", TUnit::BYTES);
+    _uncompressed_bytes_counter = ADD_COUNTER(profile(), "UncompressedRowBatchSize", TUnit::BYTES);
+    _serialize_batch_timer = ADD_TIMER(profile(), "SerializeBatchTime");
+    _split_block_timer = ADD_TIMER(profile(), "SplitBlockTime");
+    _overall_throughput = profile()->add_derived_counter(
+            "OverallThroughput", TUnit::BYTES_PER_SECOND,
+            boost::bind<int64_t>(&RuntimeProfile::units_per_second, _bytes_sent_counter,
+                                 profile()->total_time_counter()),
+            "");
+    for (int i = 0; i < _channels.size(); ++i) {
+        RETURN_IF_ERROR(_channels[i]->init(state));
+    }
+
+    return Status::OK();
+}
+
+Status VDataStreamSender::open(RuntimeState* state) {
+    DCHECK(state != nullptr);
+    return VExpr::open(_partition_expr_ctxs, state);
+}
+
+Status VDataStreamSender::send(RuntimeState* state, RowBatch* batch) {
+    return Status::NotSupported("Not Implemented VDataStreamSender::send scalar");
+}
+
+Status VDataStreamSender::send(RuntimeState* state, Block* block) {
+    SCOPED_TIMER(_profile->total_time_counter());
+    if (block->rows() == 0) {
+        return Status::OK();
+    }
+    if (_header.columns() == 0) {
+        _header = block->cloneEmpty();
+    }
+
+    if (_part_type == TPartitionType::UNPARTITIONED || _channels.size() == 1) {
+        int local_size = 0;
+        for (auto channel : _channels) {
+            if (channel->is_local()) {
+                local_size++;
+            }
+        }
+        if (local_size == _channels.size()) {
+            // we don't have to serialize
+            for (auto channel : _channels) {
+                RETURN_IF_ERROR(channel->send_local_block(block, false));
+            }
+        } else {
+            RETURN_IF_ERROR(serialize_block(*block, _current_pb_block, _channels.size()));
+            for (auto channel : _channels) {
+                if (channel->is_local()) {
+                    RETURN_IF_ERROR(channel->send_local_block(block, false));
+                } else {
+                    RETURN_IF_ERROR(channel->send_block(_current_pb_block));
+                }
+            }
+            _current_pb_block = (_current_pb_block == &_pb_block1 ? &_pb_block2 : &_pb_block1);
+        }
+    } else if (_part_type == TPartitionType::RANDOM) {
+        // Round-robin blocks among channels. Wait for the current channel to finish its
+        // rpc before overwriting its block.
+        Channel* current_channel = _channels[_current_channel_idx];
+        if (current_channel->is_local()) {
+            RETURN_IF_ERROR(current_channel->send_local_block(block, false));
+        } else {
+            RETURN_IF_ERROR(serialize_block(*block, current_channel->pb_block()));
+            RETURN_IF_ERROR(current_channel->send_block(current_channel->pb_block()));
+        }
+        _current_channel_idx = (_current_channel_idx + 1) % _channels.size();
+    } else {
+        // hash-partition block's rows across channels, the bucket shuffle hash must
+        // cover the camouflaged channels to match the distribution of the storage
+        bool is_bucket_shuffle = _part_type == TPartitionType::BUCKET_SHFFULE_HASH_PARTITIONED;
+        size_t num_channels = is_bucket_shuffle ? _channel_shared_ptrs.size() : _channels.size();
+        size_t num_columns = _header.columns();
+
+        std::vector<MutableColumns> channel_columns(num_channels);
+        {
+            SCOPED_TIMER(_split_block_timer);
+            RETURN_IF_ERROR(compute_selector(block, num_channels));
+            for (size_t i = 0; i < num_columns; ++i) {
+                auto column = block->getByPosition(i).column->convertToFullColumnIfConst();
+                auto scattered = column->scatter(num_channels, _selector);
+                for (size_t j = 0; j < num_channels; ++j) {
+                    channel_columns[j].emplace_back(std::move(scattered[j]));
+                }
+            }
+        }
+
+        for (size_t i = 0; i < num_channels; ++i) {
+            if (channel_columns[i].empty() || channel_columns[i][0]->empty()) {
+                continue;
+            }
+            Channel* channel = is_bucket_shuffle ? _channel_shared_ptrs[i].get() : _channels[i];
+            RETURN_IF_ERROR(channel->add_rows(std::move(channel_columns[i])));
+        }
+    }
+
+    return Status::OK();
+}
+
+// Hash the value of the bucket column with the hash function of the storage
+// distribution. The date/datetime and decimal values are stored in the columns as
+// DateTimeValue and DecimalV2Value, like the values RawValue::zlib_crc32 expects.
+static void update_zlib_crc32(const IColumn& column, const TypeDescriptor& type,
+                              std::vector<uint32_t>* hash_vals) {
+    const IColumn* nested_column = &column;
+    const NullMap* null_map = nullptr;
+    if (column.isNullable()) {
+        const auto& nullable_column = assert_cast<const ColumnNullable&>(column);
+        nested_column = &nullable_column.getNestedColumn();
+        null_map = &nullable_column.getNullMapData();
+    }
+
+    size_t rows = column.size();
+    for (size_t i = 0; i < rows; ++i) {
+        uint32_t& hash_val = (*hash_vals)[i];
+        if (null_map != nullptr && (*null_map)[i]) {
+            hash_val = RawValue::zlib_crc32(nullptr, type, hash_val);
+            continue;
+        }
+        StringRef data = nested_column->getDataAt(i);
+        if (type.is_string_type()) {
+            StringValue value(const_cast<char*>(data.data), data.size);
+            hash_val = RawValue::zlib_crc32(&value, type, hash_val);
+        } else {
+            hash_val = RawValue::zlib_crc32(data.data, type, hash_val);
+        }
+    }
+}
+
+// Hash the values of the rows the same way whether the column is nullable or not, so the
+// equal keys of a nullable and a not nullable side of a shuffle join reach the same channel.
+// The nulls all have the same hash.
+static void update_sip_hash(const IColumn& column, std::vector<SipHash>* hashes) {
+    size_t rows = column.size();
+    if (!column.isNullable()) {
+        for (size_t i = 0; i < rows; ++i) {
+            column.updateHashWithValue(i, (*hashes)[i]);
+        }
+        return;
+    }
+    const auto& nullable_column = assert_cast<const ColumnNullable&>(column);
+    const IColumn& nested_column = nullable_column.getNestedColumn();
+    const NullMap& null_map = nullable_column.getNullMapData();
+    constexpr UInt8 null_value = 0;
+    for (size_t i = 0; i < rows; ++i) {
+        if (null_map[i]) {
+            (*hashes)[i].update(null_value);
+        } else {
+            nested_column.updateHashWithValue(i, (*hashes)[i]);
+        }
+    }
+}
+
+Status VDataStreamSender::compute_selector(Block* block, size_t num_channels) {
+    size_t rows = block->rows();
+    std::vector<int> result_column_ids;
+    RETURN_IF_ERROR(VExprContext::execute_exprs(_partition_expr_ctxs, block, &result_column_ids));
+
+    _selector.resize(rows);
+    if (_part_type == TPartitionType::HASH_PARTITIONED) {
+        // hash column by column, updating the hash state of all the rows
+        std::vector<SipHash> hashes(rows);
+        for (int result_column_id : result_column_ids) {
+            auto column =
+                    block->getByPosition(result_column_id).column->convertToFullColumnIfConst();
+            update_sip_hash(*column, &hashes);
+        }
+        for (size_t i = 0; i < rows; ++i) {
+            _selector[i] = hashes[i].get64() % num_channels;
+        }
+    } else {
+        std::vector<uint32_t> hash_vals(rows, 0);
+        for (size_t i = 0; i < result_column_ids.size(); ++i) {
+            auto column =
+                    block->getByPosition(result_column_ids[i]).column->convertToFullColumnIfConst();
+            update_zlib_crc32(*column, _partition_expr_ctxs[i]->root()->type(), &hash_vals);
+        }
+        for (size_t i = 0; i < rows; ++i) {
+            _selector[i] = hash_vals[i] % num_channels;
+        }
+    }
+    return Status::OK();
+}
+
+Status VDataStreamSender::serialize_block(const Block& block, PBlock* dest, int num_receivers) {
+    VLOG_ROW << "serializing " << block.rows() << " rows";
+    SCOPED_TIMER(_serialize_batch_timer);
+    size_t uncompressed_bytes = 0;
+    size_t compressed_bytes = 0;
+    RETURN_IF_ERROR(block.serialize(dest, &uncompressed_bytes, &compressed_bytes));
+    COUNTER_UPDATE(_bytes_sent_counter, compressed_bytes * num_receivers);
+    COUNTER_UPDATE(_uncompressed_bytes_counter, uncompressed_bytes * num_receivers);
+    return Status::OK();
+}
+
+Status VDataStreamSender::close(RuntimeState* state, Status exec_status) {
+    if (_closed) return Status::OK();
+    _closed = true;
+    Status final_st = Status::OK();
+    // make all channels close parallel
+    for (int i = 0; i < _channels.size(); ++i) {
+        Status st = _channels[i]->close(state);
+        if (!st.ok() && final_st.ok()) {
+            final_st = st;
+        }
+    }
+    // wait all channels to finish
+    for (int i = 0; i < _channels.size(); ++i) {
+        Status st = _channels[i]->close_wait(state);
+        if (!st.ok() && final_st.ok()) {
+            final_st = st;
+        }
+    }
+    VExpr::close(_partition_expr_ctxs, state);
+
+    return final_st;
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,127 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "common/global_types.h"
+#include "common/object_pool.h"
+#include "common/status.h"
+#include "gen_cpp/data.pb.h" // for PBlock
+#include "util/runtime_profile.h"
+#include "vec/sink/data_sink.h"
+
+namespace doris {
+class MemTracker;
+class RowDescriptor;
+class TDataStreamSink;
+class TPlanFragmentDestination;
+
+namespace vectorized {
+class VExprContext;
+
+// Vectorized version of DataStreamSender, the single sender of an m:n stream of Blocks.
+// The blocks are broadcast, sent round robin, or hash partitioned across the channels
+// with IColumn::scatter, and sent to the VDataStreamRecvrs of the destinations as
+// PBlocks, or directly if the destination is on this backend.
+// Supported partition types are UNPARTITIONED, RANDOM, HASH_PARTITIONED and
+// BUCKET_SHFFULE_HASH_PARTITIONED.
+// *Not* thread-safe.
+class VDataStreamSender : public VDataSink {
+public:
+    VDataStreamSender(ObjectPool* pool, int sender_id, const RowDescriptor& row_desc,
+                      const TDataStreamSink& sink,
+                      const std::vector<TPlanFragmentDestination>& destinations,
+                      bool send_query_statistics_with_every_batch);
+    virtual ~VDataStreamSender();
+
+    virtual Status init(const TDataSink& thrift_sink) override;
+
+    virtual Status prepare(RuntimeState* state) override;
+    virtual Status open(RuntimeState* state) override;
+
+    // not implement
+    virtual Status send(RuntimeState* state, RowBatch* batch) override;
+    // Send the rows of block to the destinations according to the partition type.
+    // The result columns of the partition exprs are appended to block.
+    virtual Status send(RuntimeState* state, Block* block) override;
+
+    // Flush all buffered data and close all existing channels to destination
+    // hosts. Further send() calls are illegal after calling close().
+    virtual Status close(RuntimeState* state, Status exec_status) override;
+
+    virtual RuntimeProfile* profile() override { return _profile; }
+
+    RuntimeState* state() { return _state; }
+
+private:
+    class Channel;
+
+    // Serialize block into pblock. num_receivers is the number of receivers the block is
+    // sent to, only used to maintain the counters.
+    Status serialize_block(const Block& block, PBlock* dest, int num_receivers = 1);
+
+    // Compute the destination of every row of block into _selector.
+    Status compute_selector(Block* block, size_t num_channels);
+
+    // Sender instance id, unique within a fragment.
+    int _sender_id;
+
+    RuntimeState* _state;
+    ObjectPool* _pool;
+    const RowDescriptor& _row_desc;
+
+    int _current_channel_idx; // index of current channel to send to if _random == true
+
+    TPartitionType::type _part_type;
+
+    // the columns sent to the receivers, the columns appended by the partition exprs
+    // are not part of it
+    Block _header;
+
+    // serialized blocks for broadcasting; we need two so we can write
+    // one while the other one is still being sent
+    PBlock _pb_block1;
+    PBlock _pb_block2;
+    PBlock* _current_pb_block = nullptr;
+
+    std::vector<VExprContext*> _partition_expr_ctxs; // compute per-row partition values
+    // the index of the channel of every row of the block being partitioned
+    IColumn::Selector _selector;
+
+    std::vector<Channel*> _channels;
+    std::vector<std::shared_ptr<Channel>> _channel_shared_ptrs;
+
+    RuntimeProfile* _profile; // Allocated from _pool
+    RuntimeProfile::Counter* _serialize_batch_timer;
+    RuntimeProfile::Counter* _bytes_sent_counter;
+    RuntimeProfile::Counter* _uncompressed_bytes_counter;
+    RuntimeProfile::Counter* _split_block_timer;
+
+    std::shared_ptr<MemTracker> _mem_tracker;
+
+    // Throughput per total time spent in sender
+    RuntimeProfile::Counter* _overall_throughput;
+
+    // Identifier of the destination plan node.
+    PlanNodeId _dest_node_id;
+};
+
+} // namespace vectorized
+} // namespace doris
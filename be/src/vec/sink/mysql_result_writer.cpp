@@ -174,15 +174,9 @@ Status MysqlResultWriter::append_row_batch(const RowBatch* batch) {
 }
 
 Status MysqlResultWriter::append_block(Block& block) {
-    int result_column_ids[_output_vexpr_ctxs.size()];
-    // TODO: add dirty execute
-    for (int i = 0; i < _output_vexpr_ctxs.size(); i++) {
-        const auto& vexpr_ctx = _output_vexpr_ctxs[i];
-        int result_column_id = -1;
-        vexpr_ctx->execute(&block, &result_column_id);
-        DCHECK(result_column_id != -1);
-        result_column_ids[i] = result_column_id;
-    }
+    // the exprs repeated in the output are computed once
+    std::vector<int> result_column_ids;
+    RETURN_IF_ERROR(VExprContext::execute_exprs(_output_vexpr_ctxs, &block, &result_column_ids));
 
     SCOPED_TIMER(_append_row_batch_timer);
     if (block.rows() == 0) {
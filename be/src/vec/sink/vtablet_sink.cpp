@@ -0,0 +1,322 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/sink/vtablet_sink.h"
+
+#include <sstream>
+
+#include "olap/hll.h"
+#include "runtime/decimalv2_value.h"
+#include "runtime/runtime_state.h"
+#include "util/doris_metrics.h"
+#include "vec/columns/column_decimal.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/columns_number.h"
+#include "vec/core/block.h"
+#include "vec/exprs/vexpr.h"
+#include "vec/exprs/vexpr_context.h"
+
+namespace doris {
+namespace stream_load {
+
+VOlapTableSink::VOlapTableSink(ObjectPool* pool, const RowDescriptor& row_desc,
+                               const std::vector<TExpr>& texprs, Status* status)
+        : OlapTableSink(pool, row_desc, {}, status) {
+    if (!texprs.empty()) {
+        *status = vectorized::VExpr::create_expr_trees(pool, texprs, &_output_vexpr_ctxs);
+    }
+    _is_vectorized = true;
+    _name = "VOlapTableSink";
+}
+
+VOlapTableSink::~VOlapTableSink() {}
+
+Status VOlapTableSink::prepare(RuntimeState* state) {
+    RETURN_IF_ERROR(OlapTableSink::prepare(state));
+    RETURN_IF_ERROR(vectorized::VExpr::prepare(_output_vexpr_ctxs, state, _input_row_desc,
+                                               _expr_mem_tracker));
+    if (!_output_vexpr_ctxs.empty()) {
+        if (_output_vexpr_ctxs.size() != _output_tuple_desc->slots().size()) {
+            LOG(WARNING) << "number of exprs is not same with slots, num_exprs="
+                         << _output_vexpr_ctxs.size()
+                         << ", num_slots=" << _output_tuple_desc->slots().size();
+            return Status::InternalError("number of exprs is not same with slots");
+        }
+        for (int i = 0; i < _output_vexpr_ctxs.size(); ++i) {
+            if (!is_type_compatible(_output_vexpr_ctxs[i]->root()->type().type,
+                                    _output_tuple_desc->slots()[i]->type().type)) {
+                LOG(WARNING) << "type of exprs is not match slot's, expr_type="
+                             << _output_vexpr_ctxs[i]->root()->type().type
+                             << ", slot_type=" << _output_tuple_desc->slots()[i]->type().type
+                             << ", slot_name=" << _output_tuple_desc->slots()[i]->col_name();
+                return Status::InternalError("expr's type is not same with slot's");
+            }
+        }
+    }
+    return Status::OK();
+}
+
+Status VOlapTableSink::open(RuntimeState* state) {
+    RETURN_IF_ERROR(vectorized::VExpr::open(_output_vexpr_ctxs, state));
+    return OlapTableSink::open(state);
+}
+
+Status VOlapTableSink::send(RuntimeState* state, RowBatch* batch) {
+    return Status::NotSupported("VOlapTableSink only accepts vectorized blocks");
+}
+
+Status VOlapTableSink::send(RuntimeState* state, vectorized::Block* input_block) {
+    SCOPED_TIMER(_profile->total_time_counter());
+    size_t input_rows = input_block->rows();
+    _number_input_rows += input_rows;
+    // update incrementally so that FE can get the progress.
+    // the real 'num_rows_load_total' will be set when sink being closed.
+    state->update_num_rows_load_total(input_rows);
+    state->update_num_bytes_load_total(input_block->bytes());
+    DorisMetrics::instance()->load_rows->increment(input_rows);
+    DorisMetrics::instance()->load_bytes->increment(input_block->bytes());
+    if (input_rows == 0) {
+        return Status::OK();
+    }
+
+    vectorized::Block block;
+    // the rows to load
+    vectorized::IColumn::Filter filter(input_rows, 1);
+    {
+        SCOPED_RAW_TIMER(&_convert_batch_ns);
+        RETURN_IF_ERROR(_convert_block(state, input_block, &block, &filter));
+    }
+    if (_need_validate_data) {
+        SCOPED_RAW_TIMER(&_validate_data_ns);
+        _validate_block(state, &block, &filter);
+    }
+
+    SCOPED_RAW_TIMER(&_send_data_ns);
+    std::vector<const OlapTablePartition*> partitions;
+    std::vector<uint32_t> dist_hashes;
+    _partition->find_tablets(block, &partitions, &dist_hashes);
+    // keep the partitions and the hashes of the rows to load only
+    size_t rows = 0;
+    const OlapTablePartition* last_partition = nullptr;
+    for (size_t i = 0; i < input_rows; ++i) {
+        if (!filter[i]) {
+            continue;
+        }
+        if (partitions[i] == nullptr) {
+            filter[i] = 0;
+            _number_filtered_rows++;
+            _append_error_msg(state, "no partition for this row, the values of its partition "
+                                     "columns are out of the ranges of the partitions");
+            continue;
+        }
+        if (partitions[i] != last_partition) {
+            _partition_ids.emplace(partitions[i]->id);
+            last_partition = partitions[i];
+        }
+        partitions[rows] = partitions[i];
+        dist_hashes[rows] = dist_hashes[i];
+        rows++;
+    }
+    if (rows == 0) {
+        return Status::OK();
+    }
+    if (rows < input_rows) {
+        vectorized::Block::filter_block(&block, filter, block.columns());
+    }
+
+    auto tablet_ids = vectorized::ColumnInt64::create(rows);
+    auto& ids = tablet_ids->getData();
+    for (int j = 0; j < _channels.size(); ++j) {
+        for (size_t i = 0; i < rows; ++i) {
+            uint32_t tablet_index = dist_hashes[i] % partitions[i]->num_buckets;
+            ids[i] = partitions[i]->indexes[j].tablets[tablet_index];
+        }
+        RETURN_IF_ERROR(_channels[j]->add_block(block, *tablet_ids));
+        _number_output_rows += rows;
+    }
+    return Status::OK();
+}
+
+Status VOlapTableSink::close(RuntimeState* state, Status close_status) {
+    if (_is_closed) {
+        return _close_status;
+    }
+    Status status = OlapTableSink::close(state, close_status);
+    vectorized::VExpr::close(_output_vexpr_ctxs, state);
+    return status;
+}
+
+Status VOlapTableSink::_convert_block(RuntimeState* state, vectorized::Block* input_block,
+                                      vectorized::Block* output_block,
+                                      vectorized::IColumn::Filter* filter) {
+    const auto& slots = _output_tuple_desc->slots();
+    std::vector<int> result_column_ids;
+    if (_output_vexpr_ctxs.empty()) {
+        for (int i = 0; i < slots.size(); ++i) {
+            result_column_ids.push_back(i);
+        }
+    } else {
+        RETURN_IF_ERROR(vectorized::VExprContext::execute_exprs(_output_vexpr_ctxs, input_block,
+                                                                &result_column_ids));
+    }
+
+    for (int i = 0; i < slots.size(); ++i) {
+        SlotDescriptor* slot_desc = slots[i];
+        const auto& elem = input_block->getByPosition(result_column_ids[i]);
+        auto column = elem.column->convertToFullColumnIfConst();
+        if (column->isNullable() && !slot_desc->is_nullable()) {
+            const auto& nullable_column = assert_cast<const vectorized::ColumnNullable&>(*column);
+            const auto& null_map = nullable_column.getNullMapData();
+            for (size_t row = 0; row < null_map.size(); ++row) {
+                if (null_map[row] && (*filter)[row]) {
+                    (*filter)[row] = 0;
+                    _number_filtered_rows++;
+                    _append_error_msg(state, "null value for not null column, column=" +
+                                                     slot_desc->col_name());
+                }
+            }
+            column = nullable_column.getNestedColumnPtr();
+        } else if (!column->isNullable() && slot_desc->is_nullable()) {
+            column = vectorized::makeNullable(column);
+        }
+        output_block->insert(
+                {std::move(column), slot_desc->get_data_type_ptr(), slot_desc->col_name()});
+    }
+    return Status::OK();
+}
+
+void VOlapTableSink::_validate_block(RuntimeState* state, vectorized::Block* block,
+                                     vectorized::IColumn::Filter* filter) {
+    size_t rows = block->rows();
+    for (int i = 0; i < _output_tuple_desc->slots().size(); ++i) {
+        SlotDescriptor* desc = _output_tuple_desc->slots()[i];
+        auto& column = block->getByPosition(i).column;
+        const vectorized::NullMap* null_map = nullptr;
+        const vectorized::IColumn* values = column.get();
+        if (column->isNullable()) {
+            const auto& nullable_column = assert_cast<const vectorized::ColumnNullable&>(*column);
+            null_map = &nullable_column.getNullMapData();
+            values = &nullable_column.getNestedColumn();
+        }
+        // only the first invalid value of a row is reported
+        auto need_validate = [&](size_t row) {
+            return (*filter)[row] && (null_map == nullptr || !(*null_map)[row]);
+        };
+        auto invalidate = [&](size_t row, const std::string& msg) {
+            (*filter)[row] = 0;
+            _number_filtered_rows++;
+            _append_error_msg(state, msg);
+        };
+
+        switch (desc->type().type) {
+        case TYPE_CHAR:
+        case TYPE_VARCHAR: {
+            // the CHARs are padded by the segment writer
+            const auto& strings = assert_cast<const vectorized::ColumnString&>(*values);
+            for (size_t row = 0; row < rows; ++row) {
+                if (!need_validate(row)) {
+                    continue;
+                }
+                auto str = strings.getDataAt(row);
+                if (str.size > desc->type().len) {
+                    std::stringstream ss;
+                    ss << "the length of input is too long than schema. "
+                       << "column_name: " << desc->col_name() << "; "
+                       << "input_str: [" << str.toString() << "] "
+                       << "schema length: " << desc->type().len << "; "
+                       << "actual length: " << str.size << "; ";
+                    invalidate(row, ss.str());
+                }
+            }
+            break;
+        }
+        case TYPE_DECIMALV2: {
+            auto mutable_column = (*std::move(column)).mutate();
+            vectorized::IColumn* data_column = mutable_column.get();
+            if (data_column->isNullable()) {
+                data_column =
+                        &assert_cast<vectorized::ColumnNullable&>(*data_column).getNestedColumn();
+            }
+            auto& decimals =
+                    assert_cast<vectorized::ColumnDecimal<vectorized::Decimal128>&>(*data_column)
+                            .getData();
+            for (size_t row = 0; row < rows; ++row) {
+                if (!need_validate(row)) {
+                    continue;
+                }
+                auto& dec_val = reinterpret_cast<DecimalV2Value&>(decimals[row]);
+                if (dec_val.greater_than_scale(desc->type().scale)) {
+                    int code = dec_val.round(&dec_val, desc->type().scale, HALF_UP);
+                    if (code != E_DEC_OK) {
+                        invalidate(row, "round one decimal failed.value=" + dec_val.to_string());
+                        continue;
+                    }
+                }
+                if (dec_val > _max_decimalv2_val[i] || dec_val < _min_decimalv2_val[i]) {
+                    std::stringstream ss;
+                    ss << "decimal value is not valid for definition, column=" << desc->col_name()
+                       << ", value=" << dec_val.to_string()
+                       << ", precision=" << desc->type().precision
+                       << ", scale=" << desc->type().scale;
+                    invalidate(row, ss.str());
+                }
+            }
+            column = std::move(mutable_column);
+            break;
+        }
+        case TYPE_HLL: {
+            for (size_t row = 0; row < rows; ++row) {
+                if (!need_validate(row)) {
+                    continue;
+                }
+                auto hll_val = values->getDataAt(row);
+                if (!HyperLogLog::is_valid(Slice(hll_val.data, hll_val.size))) {
+                    invalidate(row, "Content of HLL type column is invalid column_name: " +
+                                            desc->col_name() + "; ");
+                }
+            }
+            break;
+        }
+        case TYPE_OBJECT: {
+            if (null_map == nullptr) {
+                break;
+            }
+            for (size_t row = 0; row < rows; ++row) {
+                if ((*filter)[row] && (*null_map)[row]) {
+                    invalidate(row, "null is not allowed for bitmap column, column_name: " +
+                                            desc->col_name());
+                }
+            }
+            break;
+        }
+        default:
+            break;
+        }
+    }
+}
+
+void VOlapTableSink::_append_error_msg(RuntimeState* state, const std::string& msg) {
+#if BE_TEST
+    LOG(INFO) << msg;
+#else
+    state->append_error_msg_to_file("", msg);
+#endif
+}
+
+} // namespace stream_load
+} // namespace doris
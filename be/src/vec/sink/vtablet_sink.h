@@ -0,0 +1,77 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "exec/tablet_sink.h"
+#include "vec/columns/column.h"
+
+namespace doris {
+
+namespace vectorized {
+class Block;
+class VExprContext;
+} // namespace vectorized
+
+namespace stream_load {
+
+// Vectorized version of OlapTableSink, which loads the Blocks of a fragment executed by the
+// vectorized engine without converting them to tuples.
+// The partitions of the rows and the hashes of their distributed columns are computed column
+// by column, the rows of every index are scattered to its node channels with
+// IColumn::scatter, and the node channels send them as PBlocks. The tablets channels split
+// them by tablet and the DeltaWriters write the blocks to their memtables.
+class VOlapTableSink : public OlapTableSink {
+public:
+    // Construct from thrift struct which is generated by FE.
+    VOlapTableSink(ObjectPool* pool, const RowDescriptor& row_desc,
+                   const std::vector<TExpr>& texprs, Status* status);
+    ~VOlapTableSink() override;
+
+    Status prepare(RuntimeState* state) override;
+
+    Status open(RuntimeState* state) override;
+
+    // not implement, the rows are sent by OlapTableSink
+    Status send(RuntimeState* state, RowBatch* batch) override;
+
+    Status send(RuntimeState* state, vectorized::Block* block) override;
+
+    Status close(RuntimeState* state, Status close_status) override;
+
+private:
+    // Puts into output_block the columns of the slots of the output tuple, the results of the
+    // output exprs if there are, with the nullability of the slots. The rows with a null for a
+    // not null slot are unset in filter.
+    Status _convert_block(RuntimeState* state, vectorized::Block* input_block,
+                          vectorized::Block* output_block, vectorized::IColumn::Filter* filter);
+
+    // _validate_data of the vectorized engine, unsets in filter the rows of block which are not
+    // valid for the OLAP table. The decimals are rounded to the scale of their slots.
+    void _validate_block(RuntimeState* state, vectorized::Block* block,
+                         vectorized::IColumn::Filter* filter);
+
+    void _append_error_msg(RuntimeState* state, const std::string& msg);
+
+    std::vector<vectorized::VExprContext*> _output_vexpr_ctxs;
+};
+
+} // namespace stream_load
+} // namespace doris
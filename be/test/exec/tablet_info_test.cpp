@@ -20,9 +20,15 @@
 #include <gtest/gtest.h>
 
 #include "runtime/descriptor_helper.h"
+#include "runtime/mem_pool.h"
 #include "runtime/mem_tracker.h"
 #include "runtime/row_batch.h"
 #include "runtime/tuple_row.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/columns_number.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_string.h"
+#include "vec/data_types/data_types_number.h"
 
 namespace doris {
 
@@ -433,6 +439,100 @@ TEST_F(OlapTablePartitionParamTest, NodesInfo) {
         ASSERT_TRUE(node == nullptr);
     }
 }
+TEST_F(OlapTablePartitionParamTest, find_tablets_of_block) {
+    TDescriptorTable t_desc_tbl;
+    auto t_schema = get_schema(&t_desc_tbl);
+    std::shared_ptr<OlapTableSchemaParam> schema(new OlapTableSchemaParam());
+    auto st = schema->init(t_schema);
+    ASSERT_TRUE(st.ok());
+
+    // (-oo, 10) | [10, +oo)
+    TOlapTablePartitionParam t_partition_param;
+    t_partition_param.db_id = 1;
+    t_partition_param.table_id = 2;
+    t_partition_param.version = 0;
+    t_partition_param.__set_partition_column("c2");
+    t_partition_param.__set_distributed_columns({"c1", "c3"});
+    t_partition_param.partitions.resize(2);
+    TExprNode key;
+    key.node_type = TExprNodeType::INT_LITERAL;
+    key.type = t_desc_tbl.slotDescriptors[1].slotType;
+    key.num_children = 0;
+    key.__isset.int_literal = true;
+    key.int_literal.value = 10;
+    t_partition_param.partitions[0].id = 10;
+    t_partition_param.partitions[0].__set_end_key(key);
+    t_partition_param.partitions[0].num_buckets = 1;
+    t_partition_param.partitions[0].indexes.resize(2);
+    t_partition_param.partitions[0].indexes[0].index_id = 4;
+    t_partition_param.partitions[0].indexes[0].tablets = {21};
+    t_partition_param.partitions[0].indexes[1].index_id = 5;
+    t_partition_param.partitions[0].indexes[1].tablets = {22};
+    t_partition_param.partitions[1].id = 11;
+    t_partition_param.partitions[1].__set_start_key(key);
+    t_partition_param.partitions[1].num_buckets = 2;
+    t_partition_param.partitions[1].indexes.resize(2);
+    t_partition_param.partitions[1].indexes[0].index_id = 4;
+    t_partition_param.partitions[1].indexes[0].tablets = {31, 32};
+    t_partition_param.partitions[1].indexes[1].index_id = 5;
+    t_partition_param.partitions[1].indexes[1].tablets = {33, 34};
+
+    OlapTablePartitionParam part(schema, t_partition_param);
+    st = part.init();
+    ASSERT_TRUE(st.ok());
+
+    ObjectPool pool;
+    DescriptorTbl* desc_tbl = nullptr;
+    st = DescriptorTbl::create(&pool, t_desc_tbl, &desc_tbl);
+    ASSERT_TRUE(st.ok());
+    TupleDescriptor* tuple_desc = desc_tbl->get_tuple_descriptor(0);
+    auto tracker = std::make_shared<MemTracker>();
+    MemPool mem_pool(tracker.get());
+
+    std::vector<int32_t> c1 = {12, 1, 3, 7};
+    std::vector<int64_t> c2 = {9, 20, 10, 100};
+    std::vector<std::string> c3 = {"abc", "xy", "", "abcd"};
+    auto col1 = vectorized::ColumnInt32::create();
+    auto col2 = vectorized::ColumnInt64::create();
+    auto col3 = vectorized::ColumnString::create();
+    for (int i = 0; i < c1.size(); ++i) {
+        col1->insertValue(c1[i]);
+        col2->insertValue(c2[i]);
+        col3->insertData(c3[i].data(), c3[i].size());
+    }
+    vectorized::Block block;
+    block.insert({std::move(col1), std::make_shared<vectorized::DataTypeInt32>(), "c1"});
+    block.insert({std::move(col2), std::make_shared<vectorized::DataTypeInt64>(), "c2"});
+    block.insert({std::move(col3), std::make_shared<vectorized::DataTypeString>(), "c3"});
+
+    std::vector<const OlapTablePartition*> partitions;
+    std::vector<uint32_t> dist_hashes;
+    part.find_tablets(block, &partitions, &dist_hashes);
+    ASSERT_EQ(c1.size(), partitions.size());
+    ASSERT_EQ(c1.size(), dist_hashes.size());
+
+    // the rows of the block must go to the same tablets as their tuples
+    for (int i = 0; i < c1.size(); ++i) {
+        Tuple* tuple = (Tuple*)mem_pool.allocate(tuple_desc->byte_size());
+        memset(tuple, 0, tuple_desc->byte_size());
+        *reinterpret_cast<int*>(tuple->get_slot(4)) = c1[i];
+        *reinterpret_cast<int64_t*>(tuple->get_slot(8)) = c2[i];
+        StringValue* str_val = reinterpret_cast<StringValue*>(tuple->get_slot(16));
+        str_val->ptr = (char*)mem_pool.allocate(c3[i].size() + 1);
+        str_val->len = c3[i].size();
+        memcpy(str_val->ptr, c3[i].data(), str_val->len);
+
+        uint32_t dist_hash = 0;
+        const OlapTablePartition* partition = nullptr;
+        auto found = part.find_tablet(tuple, &partition, &dist_hash);
+        ASSERT_TRUE(found);
+        ASSERT_EQ(partition, partitions[i]);
+        ASSERT_EQ(dist_hash, dist_hashes[i]);
+    }
+    ASSERT_EQ(10, partitions[0]->id);
+    ASSERT_EQ(11, partitions[1]->id);
+    ASSERT_EQ(11, partitions[2]->id);
+}
 
 } // namespace doris
 
@@ -0,0 +1,324 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "exprs/runtime_filter.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "common/config.h"
+#include "runtime/datetime_value.h"
+#include "runtime/decimalv2_value.h"
+#include "runtime/string_value.hpp"
+
+namespace doris {
+
+class RuntimeFilterTest : public testing::Test {
+public:
+    void SetUp() override { _max_in_num = config::runtime_filter_max_in_num; }
+
+    void TearDown() override { config::runtime_filter_max_in_num = _max_in_num; }
+
+protected:
+    template <class T>
+    static T value_of(const void* data) {
+        T value;
+        memcpy(&value, data, sizeof(T));
+        return value;
+    }
+
+    template <class T>
+    static std::set<T> in_values(const RuntimeFilter& filter) {
+        std::set<T> values;
+        HybridSetBase::IteratorBase* iter = filter.in_values()->begin();
+        while (iter->has_next()) {
+            values.insert(value_of<T>(iter->get_value()));
+            iter->next();
+        }
+        return values;
+    }
+
+    static std::set<std::string> string_in_values(const RuntimeFilter& filter) {
+        std::set<std::string> values;
+        HybridSetBase::IteratorBase* iter = filter.in_values()->begin();
+        while (iter->has_next()) {
+            auto value = reinterpret_cast<const StringValue*>(iter->get_value());
+            values.emplace(value->ptr, value->len);
+            iter->next();
+        }
+        return values;
+    }
+
+    static std::string to_string(const void* data) {
+        auto value = reinterpret_cast<const StringValue*>(data);
+        return std::string(value->ptr, value->len);
+    }
+
+    static bool bloom_filter_test(const RuntimeFilter& filter, const void* data, uint32_t size) {
+        const segment_v2::BloomFilter* bloom_filter = filter.bloom_filter();
+        return bloom_filter->test_hash(
+                bloom_filter->hash(reinterpret_cast<char*>(const_cast<void*>(data)), size));
+    }
+
+    int32_t _max_in_num;
+};
+
+TEST_F(RuntimeFilterTest, min_max) {
+    RuntimeFilter filter(0, TYPE_INT, 8);
+    ASSERT_TRUE(filter.init().ok());
+    ASSERT_TRUE(filter.empty());
+    ASSERT_EQ(0, filter.slot_id());
+    ASSERT_EQ(TYPE_INT, filter.type());
+
+    for (int32_t value : {7, -3, 12, 7, 0}) {
+        filter.insert(&value);
+    }
+    ASSERT_FALSE(filter.empty());
+    ASSERT_EQ(-3, value_of<int32_t>(filter.min_value()));
+    ASSERT_EQ(12, value_of<int32_t>(filter.max_value()));
+    ASSERT_EQ(std::set<int32_t>({-3, 0, 7, 12}), in_values<int32_t>(filter));
+
+    // one value is both the min and the max
+    RuntimeFilter single(1, TYPE_BIGINT, 1);
+    ASSERT_TRUE(single.init().ok());
+    int64_t value = 1L << 40;
+    single.insert(&value);
+    ASSERT_EQ(value, value_of<int64_t>(single.min_value()));
+    ASSERT_EQ(value, value_of<int64_t>(single.max_value()));
+}
+
+TEST_F(RuntimeFilterTest, fixed_length_types) {
+    RuntimeFilter tinyint(0, TYPE_TINYINT, 4);
+    ASSERT_TRUE(tinyint.init().ok());
+    for (int8_t value : {int8_t(5), int8_t(-128), int8_t(127)}) {
+        tinyint.insert(&value);
+    }
+    ASSERT_EQ(-128, value_of<int8_t>(tinyint.min_value()));
+    ASSERT_EQ(127, value_of<int8_t>(tinyint.max_value()));
+
+    RuntimeFilter largeint(0, TYPE_LARGEINT, 4);
+    ASSERT_TRUE(largeint.init().ok());
+    __int128 big = static_cast<__int128>(1) << 100;
+    for (__int128 value : {big, -big, static_cast<__int128>(3)}) {
+        largeint.insert(&value);
+    }
+    ASSERT_TRUE(value_of<__int128>(largeint.min_value()) == -big);
+    ASSERT_TRUE(value_of<__int128>(largeint.max_value()) == big);
+
+    RuntimeFilter datetime(0, TYPE_DATETIME, 4);
+    ASSERT_TRUE(datetime.init().ok());
+    std::vector<DateTimeValue> dates(3);
+    ASSERT_TRUE(dates[0].from_date_str("2021-03-04 05:06:07", 19));
+    ASSERT_TRUE(dates[1].from_date_str("1999-12-31 23:59:59", 19));
+    ASSERT_TRUE(dates[2].from_date_str("2021-03-04 05:06:08", 19));
+    for (const auto& date : dates) {
+        datetime.insert(&date);
+    }
+    ASSERT_EQ(dates[1], value_of<DateTimeValue>(datetime.min_value()));
+    ASSERT_EQ(dates[2], value_of<DateTimeValue>(datetime.max_value()));
+    // the storage format of the dates differs from the in-memory one
+    ASSERT_EQ(nullptr, datetime.bloom_filter());
+
+    RuntimeFilter decimal(0, TYPE_DECIMALV2, 4);
+    ASSERT_TRUE(decimal.init().ok());
+    for (const char* str : {"3.14", "-2.5", "10.001"}) {
+        DecimalV2Value value(std::string(str));
+        decimal.insert(&value);
+    }
+    ASSERT_EQ(DecimalV2Value(std::string("-2.5")), value_of<DecimalV2Value>(decimal.min_value()));
+    ASSERT_EQ(DecimalV2Value(std::string("10.001")),
+              value_of<DecimalV2Value>(decimal.max_value()));
+    ASSERT_EQ(nullptr, decimal.bloom_filter());
+}
+
+TEST_F(RuntimeFilterTest, max_in_num) {
+    config::runtime_filter_max_in_num = 3;
+    RuntimeFilter filter(0, TYPE_INT, 8);
+    ASSERT_TRUE(filter.init().ok());
+
+    // the duplicated values are counted once
+    for (int32_t value : {1, 2, 1, 3, 3, 2}) {
+        filter.insert(&value);
+    }
+    ASSERT_NE(nullptr, filter.in_values());
+    ASSERT_EQ(std::set<int32_t>({1, 2, 3}), in_values<int32_t>(filter));
+
+    // the set is dropped once it has too many values, the min/max and the bloom
+    // filter are still maintained
+    int32_t value = 4;
+    filter.insert(&value);
+    ASSERT_EQ(nullptr, filter.in_values());
+    value = 0;
+    filter.insert(&value);
+    ASSERT_EQ(nullptr, filter.in_values());
+    ASSERT_EQ(0, value_of<int32_t>(filter.min_value()));
+    ASSERT_EQ(4, value_of<int32_t>(filter.max_value()));
+    for (int32_t value : {0, 1, 2, 3, 4}) {
+        ASSERT_TRUE(bloom_filter_test(filter, &value, sizeof(value)));
+    }
+}
+
+TEST_F(RuntimeFilterTest, strings) {
+    for (PrimitiveType type : {TYPE_CHAR, TYPE_VARCHAR}) {
+        RuntimeFilter filter(0, type, 8);
+        ASSERT_TRUE(filter.init().ok());
+        ASSERT_NE(nullptr, filter.bloom_filter());
+
+        std::vector<std::string> values = {"banana", "apple", "", "cherry", "apple"};
+        for (auto& value : values) {
+            StringValue string_value(const_cast<char*>(value.data()), value.size());
+            filter.insert(&string_value);
+        }
+        // the min and max values are copied, the inserted ones may be freed
+        values.clear();
+        ASSERT_EQ("", to_string(filter.min_value()));
+        ASSERT_EQ("cherry", to_string(filter.max_value()));
+        ASSERT_EQ(std::set<std::string>({"", "apple", "banana", "cherry"}),
+                  string_in_values(filter));
+
+        // the strings are hashed by their bytes
+        for (std::string value : {"", "apple", "banana", "cherry"}) {
+            ASSERT_TRUE(bloom_filter_test(filter, value.data(), value.size())) << value;
+        }
+    }
+}
+
+TEST_F(RuntimeFilterTest, bloom_filter) {
+    RuntimeFilter filter(0, TYPE_BIGINT, 1000);
+    ASSERT_TRUE(filter.init().ok());
+    ASSERT_NE(nullptr, filter.bloom_filter());
+    ASSERT_EQ(filter.bloom_filter()->size(), filter.allocated_bytes());
+    for (int64_t value = 0; value < 1000; ++value) {
+        int64_t key = value * 2;
+        filter.insert(&key);
+    }
+    int passed = 0;
+    for (int64_t value = 0; value < 1000; ++value) {
+        int64_t key = value * 2;
+        ASSERT_TRUE(bloom_filter_test(filter, &key, sizeof(key)));
+        key = value * 2 + 1;
+        passed += bloom_filter_test(filter, &key, sizeof(key));
+    }
+    // the false positive rate is about runtime_filter_bloom_filter_fpp
+    ASSERT_LT(passed, 200);
+}
+
+TEST_F(RuntimeFilterTest, protobuf) {
+    RuntimeFilter filter(3, TYPE_LARGEINT, 16);
+    ASSERT_TRUE(filter.init().ok());
+    __int128 big = static_cast<__int128>(1) << 100;
+    for (__int128 value : {big, -big, static_cast<__int128>(3)}) {
+        filter.insert(&value);
+    }
+    PRuntimeFilter pfilter;
+    filter.to_protobuf(&pfilter);
+
+    std::unique_ptr<RuntimeFilter> result;
+    ASSERT_TRUE(RuntimeFilter::create_from_protobuf(pfilter, &result).ok());
+    ASSERT_EQ(3, result->slot_id());
+    ASSERT_EQ(TYPE_LARGEINT, result->type());
+    ASSERT_TRUE(value_of<__int128>(result->min_value()) == -big);
+    ASSERT_TRUE(value_of<__int128>(result->max_value()) == big);
+    ASSERT_EQ(in_values<__int128>(filter), in_values<__int128>(*result));
+    ASSERT_EQ(filter.bloom_filter()->size(), result->bloom_filter()->size());
+    ASSERT_EQ(0, memcmp(filter.bloom_filter()->data(), result->bloom_filter()->data(),
+                        filter.bloom_filter()->size()));
+
+    // strings, without the IN values
+    config::runtime_filter_max_in_num = 1;
+    RuntimeFilter string_filter(4, TYPE_VARCHAR, 16);
+    ASSERT_TRUE(string_filter.init().ok());
+    for (std::string value : {"b", "a"}) {
+        StringValue string_value(const_cast<char*>(value.data()), value.size());
+        string_filter.insert(&string_value);
+    }
+    pfilter.Clear();
+    string_filter.to_protobuf(&pfilter);
+    ASSERT_TRUE(RuntimeFilter::create_from_protobuf(pfilter, &result).ok());
+    ASSERT_EQ("a", to_string(result->min_value()));
+    ASSERT_EQ("b", to_string(result->max_value()));
+    ASSERT_EQ(nullptr, result->in_values());
+    ASSERT_TRUE(bloom_filter_test(*result, "b", 1));
+
+    // the values are checked
+    pfilter.Clear();
+    filter.to_protobuf(&pfilter);
+    pfilter.set_min_value("short");
+    ASSERT_FALSE(RuntimeFilter::create_from_protobuf(pfilter, &result).ok());
+    pfilter.Clear();
+    filter.to_protobuf(&pfilter);
+    pfilter.set_bloom_filter(std::string(100, '\0'));
+    ASSERT_FALSE(RuntimeFilter::create_from_protobuf(pfilter, &result).ok());
+    pfilter.Clear();
+    filter.to_protobuf(&pfilter);
+    pfilter.clear_max_value();
+    ASSERT_FALSE(RuntimeFilter::create_from_protobuf(pfilter, &result).ok());
+}
+
+TEST_F(RuntimeFilterTest, merge) {
+    config::runtime_filter_max_in_num = 4;
+    // the filters of the instances of a join have about the same number of build rows
+    std::vector<std::unique_ptr<RuntimeFilter>> filters;
+    std::vector<std::vector<int32_t>> values = {{5, 1}, {}, {8, 5}, {2}};
+    for (const auto& instance_values : values) {
+        filters.emplace_back(new RuntimeFilter(0, TYPE_INT, 16));
+        ASSERT_TRUE(filters.back()->init().ok());
+        for (int32_t value : instance_values) {
+            filters.back()->insert(&value);
+        }
+    }
+    RuntimeFilter& merged = *filters[0];
+    ASSERT_TRUE(merged.merge(*filters[1]).ok());
+    ASSERT_TRUE(merged.merge(*filters[2]).ok());
+    ASSERT_EQ(1, value_of<int32_t>(merged.min_value()));
+    ASSERT_EQ(8, value_of<int32_t>(merged.max_value()));
+    ASSERT_EQ(std::set<int32_t>({1, 5, 8}), in_values<int32_t>(merged));
+    ASSERT_TRUE(merged.merge(*filters[3]).ok());
+    ASSERT_EQ(std::set<int32_t>({1, 2, 5, 8}), in_values<int32_t>(merged));
+    for (int32_t value : {1, 2, 5, 8}) {
+        ASSERT_TRUE(bloom_filter_test(merged, &value, sizeof(value)));
+    }
+
+    // too many values
+    int32_t value = 0;
+    RuntimeFilter other(0, TYPE_INT, 16);
+    ASSERT_TRUE(other.init().ok());
+    other.insert(&value);
+    ASSERT_TRUE(merged.merge(other).ok());
+    ASSERT_EQ(nullptr, merged.in_values());
+    ASSERT_EQ(0, value_of<int32_t>(merged.min_value()));
+
+    // the bloom filters of different sizes can not be merged
+    RuntimeFilter larger(0, TYPE_INT, 100000);
+    ASSERT_TRUE(larger.init().ok());
+    value = 100;
+    larger.insert(&value);
+    ASSERT_TRUE(merged.merge(larger).ok());
+    ASSERT_EQ(nullptr, merged.bloom_filter());
+    ASSERT_EQ(100, value_of<int32_t>(merged.max_value()));
+}
+
+} // namespace doris
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,331 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/bloom_filter_predicate.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "exprs/runtime_filter.h"
+#include "olap/column_predicate.h"
+#include "olap/field.h"
+#include "olap/row_block2.h"
+#include "runtime/mem_pool.h"
+#include "runtime/mem_tracker.h"
+#include "runtime/string_value.hpp"
+#include "runtime/vectorized_row_batch.h"
+
+namespace doris {
+
+class TestBloomFilterPredicate : public testing::Test {
+public:
+    TestBloomFilterPredicate() {
+        _mem_tracker.reset(new MemTracker(-1));
+        _mem_pool.reset(new MemPool(_mem_tracker.get()));
+    }
+
+    void SetTabletSchema(const std::string& type, uint32_t length) {
+        TabletSchemaPB tablet_schema_pb;
+        ColumnPB* column = tablet_schema_pb.add_column();
+        column->set_unique_id(0);
+        column->set_name("column");
+        column->set_type(type);
+        column->set_is_key(true);
+        column->set_is_nullable(true);
+        column->set_length(length);
+        column->set_aggregation("NONE");
+        column->set_is_bf_column(false);
+        _tablet_schema.init_from_pb(tablet_schema_pb);
+    }
+
+    void InitVectorizedBatch() {
+        _vectorized_batch.reset(new VectorizedRowBatch(&_tablet_schema, {0}, SIZE));
+        _vectorized_batch->set_size(SIZE);
+    }
+
+    void InitRowBlock() {
+        Schema schema(_tablet_schema);
+        _row_block.reset(new RowBlockV2(schema, SIZE));
+    }
+
+    // The bloom filter is much larger than the few values inserted, so that the other
+    // values are not false positives.
+    void InitFilter(PrimitiveType type) {
+        _filter.reset(new RuntimeFilter(0, type, 100000));
+        ASSERT_TRUE(_filter->init().ok());
+    }
+
+    // the values of the rows which are null
+    static bool IsNull(int i) { return i % 5 == 0; }
+
+    // the rows whose value is in the filter
+    static bool InFilter(int i) { return i % 3 == 0; }
+
+    static std::vector<uint16_t> ExpectedRows() {
+        std::vector<uint16_t> rows;
+        for (int i = 0; i < SIZE; ++i) {
+            if (InFilter(i) && !IsNull(i)) {
+                rows.push_back(i);
+            }
+        }
+        return rows;
+    }
+
+    // Fill the column with values, set the nulls of the column if nullable.
+    void FillVectorizedBatch(const std::function<void(int, char*)>& set_value, size_t cell_size,
+                             bool nullable) {
+        ColumnVector* col_vector = _vectorized_batch->column(0);
+        char* col_data = reinterpret_cast<char*>(_mem_pool->allocate(SIZE * cell_size));
+        col_vector->set_col_data(col_data);
+        col_vector->set_no_nulls(!nullable);
+        bool* is_null = reinterpret_cast<bool*>(_mem_pool->allocate(SIZE));
+        for (int i = 0; i < SIZE; ++i) {
+            is_null[i] = nullable && IsNull(i);
+            set_value(i, col_data + i * cell_size);
+        }
+        col_vector->set_is_null(is_null);
+        _vectorized_batch->set_size(SIZE);
+        _vectorized_batch->set_selected_in_use(false);
+    }
+
+    void FillRowBlock(const std::function<void(int, char*)>& set_value, bool nullable) {
+        _row_block->clear();
+        ColumnBlock col_block = _row_block->column_block(0);
+        ColumnBlockView col_block_view(&col_block);
+        for (int i = 0; i < SIZE; ++i, col_block_view.advance(1)) {
+            col_block_view.set_null_bits(1, nullable && IsNull(i));
+            set_value(i, reinterpret_cast<char*>(col_block_view.data()));
+        }
+    }
+
+    std::vector<uint16_t> EvaluateVectorizedBatch(const ColumnPredicate& pred) {
+        pred.evaluate(_vectorized_batch.get());
+        uint16_t* sel = _vectorized_batch->selected();
+        return std::vector<uint16_t>(sel, sel + _vectorized_batch->size());
+    }
+
+    std::vector<uint16_t> EvaluateColumnBlock(const ColumnPredicate& pred) {
+        ColumnBlock col_block = _row_block->column_block(0);
+        uint16_t select_size = _row_block->selected_size();
+        pred.evaluate(&col_block, _row_block->selection_vector(), &select_size);
+        uint16_t* sel = _row_block->selection_vector();
+        return std::vector<uint16_t>(sel, sel + select_size);
+    }
+
+    // Evaluate the predicate on the column with and without nulls.
+    void CheckPredicate(const ColumnPredicate& pred,
+                        const std::function<void(int, char*)>& set_value, size_t cell_size) {
+        auto expected = ExpectedRows();
+        std::vector<uint16_t> expected_not_null;
+        for (int i = 0; i < SIZE; ++i) {
+            if (InFilter(i)) {
+                expected_not_null.push_back(i);
+            }
+        }
+
+        for (bool nullable : {false, true}) {
+            const auto& rows = nullable ? expected : expected_not_null;
+            InitVectorizedBatch();
+            FillVectorizedBatch(set_value, cell_size, nullable);
+            ASSERT_EQ(rows, EvaluateVectorizedBatch(pred)) << nullable;
+
+            // the rows already selected are evaluated again
+            ASSERT_TRUE(_vectorized_batch->selected_in_use());
+            ASSERT_EQ(rows, EvaluateVectorizedBatch(pred)) << nullable;
+
+            InitRowBlock();
+            FillRowBlock(set_value, nullable);
+            ASSERT_EQ(rows, EvaluateColumnBlock(pred)) << nullable;
+        }
+    }
+
+    static constexpr int SIZE = 30;
+
+    TabletSchema _tablet_schema;
+    std::shared_ptr<MemTracker> _mem_tracker;
+    std::unique_ptr<MemPool> _mem_pool;
+    std::unique_ptr<VectorizedRowBatch> _vectorized_batch;
+    std::unique_ptr<RowBlockV2> _row_block;
+    std::unique_ptr<RuntimeFilter> _filter;
+};
+
+TEST_F(TestBloomFilterPredicate, INT_COLUMN) {
+    SetTabletSchema("INT", 4);
+    InitFilter(TYPE_INT);
+    for (int32_t i = 0; i < SIZE; ++i) {
+        if (InFilter(i)) {
+            _filter->insert(&i);
+        }
+    }
+    BloomFilterColumnPredicate pred(0, OLAP_FIELD_TYPE_INT, _filter->bloom_filter());
+    CheckPredicate(
+            pred, [](int i, char* cell) { *reinterpret_cast<int32_t*>(cell) = i; },
+            sizeof(int32_t));
+}
+
+TEST_F(TestBloomFilterPredicate, LARGEINT_COLUMN) {
+    SetTabletSchema("LARGEINT", 16);
+    InitFilter(TYPE_LARGEINT);
+    for (int i = 0; i < SIZE; ++i) {
+        if (InFilter(i)) {
+            int128_t value = static_cast<int128_t>(i) << 70;
+            _filter->insert(&value);
+        }
+    }
+    BloomFilterColumnPredicate pred(0, OLAP_FIELD_TYPE_LARGEINT, _filter->bloom_filter());
+    CheckPredicate(
+            pred,
+            [](int i, char* cell) {
+                int128_t value = static_cast<int128_t>(i) << 70;
+                memcpy(cell, &value, sizeof(value));
+            },
+            sizeof(int128_t));
+}
+
+TEST_F(TestBloomFilterPredicate, CHAR_COLUMN) {
+    // the CHAR values are padded with zeros by the storage, not by the hash join
+    const uint32_t length = 8;
+    SetTabletSchema("CHAR", length);
+    InitFilter(TYPE_CHAR);
+    std::vector<std::string> values;
+    for (int i = 0; i < SIZE; ++i) {
+        values.push_back(std::string(i % 7 + 1, 'a' + i % 26) + std::to_string(i / 26));
+    }
+    for (int i = 0; i < SIZE; ++i) {
+        if (InFilter(i)) {
+            StringValue value(const_cast<char*>(values[i].data()), values[i].size());
+            _filter->insert(&value);
+        }
+    }
+    BloomFilterColumnPredicate pred(0, OLAP_FIELD_TYPE_CHAR, _filter->bloom_filter());
+    CheckPredicate(
+            pred,
+            [&](int i, char* cell) {
+                char* buffer = reinterpret_cast<char*>(_mem_pool->allocate(length));
+                memset(buffer, 0, length);
+                memcpy(buffer, values[i].data(), values[i].size());
+                *reinterpret_cast<StringValue*>(cell) = StringValue(buffer, length);
+            },
+            sizeof(StringValue));
+}
+
+TEST_F(TestBloomFilterPredicate, VARCHAR_COLUMN) {
+    SetTabletSchema("VARCHAR", 16);
+    InitFilter(TYPE_VARCHAR);
+    // "" is one of the values
+    std::vector<std::string> values;
+    for (int i = 0; i < SIZE; ++i) {
+        values.push_back(std::string(i % 4, 'a' + i % 26));
+    }
+    for (int i = 0; i < SIZE; ++i) {
+        if (InFilter(i)) {
+            StringValue value(const_cast<char*>(values[i].data()), values[i].size());
+            _filter->insert(&value);
+        }
+    }
+    // the values are distinct from the inserted ones of another length
+    for (int i = 0; i < SIZE; ++i) {
+        if (!InFilter(i)) {
+            values[i] += "x";
+        }
+    }
+    BloomFilterColumnPredicate pred(0, OLAP_FIELD_TYPE_VARCHAR, _filter->bloom_filter());
+    CheckPredicate(
+            pred,
+            [&](int i, char* cell) {
+                char* buffer = reinterpret_cast<char*>(_mem_pool->allocate(values[i].size() + 1));
+                memcpy(buffer, values[i].data(), values[i].size());
+                *reinterpret_cast<StringValue*>(cell) = StringValue(buffer, values[i].size());
+            },
+            sizeof(StringValue));
+}
+
+TEST_F(TestBloomFilterPredicate, EVALUATE_AND_OR) {
+    SetTabletSchema("INT", 4);
+    InitFilter(TYPE_INT);
+    for (int32_t i = 0; i < SIZE; ++i) {
+        if (InFilter(i)) {
+            _filter->insert(&i);
+        }
+    }
+    BloomFilterColumnPredicate pred(0, OLAP_FIELD_TYPE_INT, _filter->bloom_filter());
+    InitRowBlock();
+    FillRowBlock([](int i, char* cell) { *reinterpret_cast<int32_t*>(cell) = i; }, true);
+    ColumnBlock col_block = _row_block->column_block(0);
+    uint16_t* sel = _row_block->selection_vector();
+    uint16_t size = _row_block->selected_size();
+
+    bool flags[SIZE];
+    for (int i = 0; i < SIZE; ++i) {
+        flags[i] = i % 2 == 0;
+    }
+    pred.evaluate_and(&col_block, sel, size, flags);
+    for (int i = 0; i < SIZE; ++i) {
+        ASSERT_EQ(i % 2 == 0 && InFilter(i) && !IsNull(i), flags[i]) << i;
+    }
+
+    for (int i = 0; i < SIZE; ++i) {
+        flags[i] = i % 2 == 0;
+    }
+    pred.evaluate_or(&col_block, sel, size, flags);
+    for (int i = 0; i < SIZE; ++i) {
+        ASSERT_EQ(i % 2 == 0 || (InFilter(i) && !IsNull(i)), flags[i]) << i;
+    }
+}
+
+TEST_F(TestBloomFilterPredicate, BITMAP_INDEX) {
+    SetTabletSchema("INT", 4);
+    InitFilter(TYPE_INT);
+    int32_t value = 1;
+    _filter->insert(&value);
+    BloomFilterColumnPredicate pred(0, OLAP_FIELD_TYPE_INT, _filter->bloom_filter());
+    // the rows must be read to be filtered, the segment iterator keeps the predicate
+    ASSERT_FALSE(pred.can_use_bitmap_index());
+
+    // without a bitmap index no row is removed
+    Schema schema(_tablet_schema);
+    std::vector<BitmapIndexIterator*> iterators(1, nullptr);
+    Roaring roaring;
+    roaring.addRange(0, SIZE);
+    ASSERT_TRUE(pred.evaluate(schema, iterators, SIZE, &roaring).ok());
+    ASSERT_EQ(static_cast<uint64_t>(SIZE), roaring.cardinality());
+}
+
+TEST_F(TestBloomFilterPredicate, SUPPORTED_TYPES) {
+    for (FieldType type : {OLAP_FIELD_TYPE_TINYINT, OLAP_FIELD_TYPE_SMALLINT, OLAP_FIELD_TYPE_INT,
+                           OLAP_FIELD_TYPE_BIGINT, OLAP_FIELD_TYPE_LARGEINT, OLAP_FIELD_TYPE_CHAR,
+                           OLAP_FIELD_TYPE_VARCHAR}) {
+        ASSERT_TRUE(BloomFilterColumnPredicate::is_supported_type(type)) << type;
+    }
+    // their storage format is not the one the hash join hashes
+    for (FieldType type : {OLAP_FIELD_TYPE_DATE, OLAP_FIELD_TYPE_DATETIME,
+                           OLAP_FIELD_TYPE_DECIMAL, OLAP_FIELD_TYPE_DOUBLE}) {
+        ASSERT_FALSE(BloomFilterColumnPredicate::is_supported_type(type)) << type;
+    }
+}
+
+} // namespace doris
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
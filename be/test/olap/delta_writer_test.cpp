@@ -20,24 +20,47 @@
 #include <gtest/gtest.h>
 #include <sys/file.h>
 
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <map>
+#include <set>
 #include <string>
+#include <tuple>
 
 #include "gen_cpp/Descriptors_types.h"
 #include "gen_cpp/PaloInternalService_types.h"
 #include "gen_cpp/Types_types.h"
 #include "olap/field.h"
+#include "olap/hll.h"
 #include "olap/options.h"
+#include "olap/row_block.h"
+#include "olap/row_cursor.h"
+#include "olap/rowset/beta_rowset.h"
+#include "olap/rowset/rowset_reader.h"
+#include "olap/rowset/rowset_reader_context.h"
+#include "olap/rowset/segment_v2/segment.h"
+#include "olap/short_key_index.h"
 #include "olap/storage_engine.h"
 #include "olap/tablet.h"
 #include "olap/tablet_meta_manager.h"
 #include "olap/utils.h"
+#include "runtime/datetime_value.h"
 #include "runtime/descriptor_helper.h"
 #include "runtime/exec_env.h"
 #include "runtime/mem_pool.h"
 #include "runtime/mem_tracker.h"
 #include "runtime/tuple.h"
+#include "util/bitmap_value.h"
 #include "util/file_utils.h"
 #include "util/logging.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/columns_number.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_string.h"
+#include "vec/data_types/data_types_number.h"
 
 namespace doris {
 
@@ -336,6 +359,207 @@ TDescriptorTable create_descriptor_tablet_with_sequence_col() {
     return dtb.desc_tbl();
 }
 
+TColumn create_tcolumn(const std::string& name, TPrimitiveType::type type, bool is_key,
+                       TAggregationType::type aggregation = TAggregationType::NONE) {
+    TColumn column;
+    column.column_name = name;
+    column.__set_is_key(is_key);
+    column.column_type.type = type;
+    if (!is_key) {
+        column.__set_aggregation_type(aggregation);
+    }
+    return column;
+}
+
+// k1 and k2 are the keys, a value column of every aggregation
+void create_tablet_request_with_agg_values(int64_t tablet_id, int32_t schema_hash,
+                                           TCreateTabletReq* request) {
+    request->tablet_id = tablet_id;
+    request->__set_version(1);
+    request->__set_version_hash(0);
+    request->tablet_schema.schema_hash = schema_hash;
+    request->tablet_schema.short_key_column_count = 2;
+    request->tablet_schema.keys_type = TKeysType::AGG_KEYS;
+    request->tablet_schema.storage_type = TStorageType::COLUMN;
+
+    auto& columns = request->tablet_schema.columns;
+    columns.push_back(create_tcolumn("k1", TPrimitiveType::INT, true));
+    columns.push_back(create_tcolumn("k2", TPrimitiveType::SMALLINT, true));
+    columns.push_back(
+            create_tcolumn("v_sum", TPrimitiveType::BIGINT, false, TAggregationType::SUM));
+    columns.push_back(create_tcolumn("v_min", TPrimitiveType::INT, false, TAggregationType::MIN));
+    columns.push_back(
+            create_tcolumn("v_max", TPrimitiveType::DATETIME, false, TAggregationType::MAX));
+    columns.push_back(
+            create_tcolumn("v_replace", TPrimitiveType::INT, false, TAggregationType::REPLACE));
+    TColumn v_replace_if_not_null = create_tcolumn("v_replace_if_not_null", TPrimitiveType::INT,
+                                                   false, TAggregationType::REPLACE_IF_NOT_NULL);
+    v_replace_if_not_null.__set_is_allow_null(true);
+    columns.push_back(v_replace_if_not_null);
+    TColumn v_hll =
+            create_tcolumn("v_hll", TPrimitiveType::HLL, false, TAggregationType::HLL_UNION);
+    v_hll.column_type.__set_len(HLL_COLUMN_DEFAULT_LEN);
+    columns.push_back(v_hll);
+    columns.push_back(create_tcolumn("v_bitmap", TPrimitiveType::OBJECT, false,
+                                     TAggregationType::BITMAP_UNION));
+}
+
+TDescriptorTable create_descriptor_tablet_with_agg_values() {
+    TDescriptorTableBuilder dtb;
+    TTupleDescriptorBuilder tuple_builder;
+
+    tuple_builder.add_slot(
+            TSlotDescriptorBuilder().type(TYPE_INT).column_name("k1").column_pos(0).build());
+    tuple_builder.add_slot(
+            TSlotDescriptorBuilder().type(TYPE_SMALLINT).column_name("k2").column_pos(1).build());
+    tuple_builder.add_slot(
+            TSlotDescriptorBuilder().type(TYPE_BIGINT).column_name("v_sum").column_pos(2).build());
+    tuple_builder.add_slot(
+            TSlotDescriptorBuilder().type(TYPE_INT).column_name("v_min").column_pos(3).build());
+    tuple_builder.add_slot(TSlotDescriptorBuilder()
+                                   .type(TYPE_DATETIME)
+                                   .column_name("v_max")
+                                   .column_pos(4)
+                                   .build());
+    tuple_builder.add_slot(
+            TSlotDescriptorBuilder().type(TYPE_INT).column_name("v_replace").column_pos(5).build());
+    tuple_builder.add_slot(TSlotDescriptorBuilder()
+                                   .type(TYPE_INT)
+                                   .nullable(true)
+                                   .column_name("v_replace_if_not_null")
+                                   .column_pos(6)
+                                   .build());
+    TSlotDescriptor v_hll =
+            TSlotDescriptorBuilder().type(TYPE_HLL).column_name("v_hll").column_pos(7).build();
+    v_hll.slotType.types[0].scalar_type.__set_len(HLL_COLUMN_DEFAULT_LEN);
+    tuple_builder.add_slot(v_hll);
+    tuple_builder.add_slot(TSlotDescriptorBuilder()
+                                   .type(TYPE_OBJECT)
+                                   .column_name("v_bitmap")
+                                   .column_pos(8)
+                                   .build());
+    tuple_builder.build(&dtb);
+
+    return dtb.desc_tbl();
+}
+
+// k1 and k2 are the keys, but only k1 is in the short key index
+void create_tablet_request_with_dup_keys(int64_t tablet_id, int32_t schema_hash,
+                                         TCreateTabletReq* request) {
+    request->tablet_id = tablet_id;
+    request->__set_version(1);
+    request->__set_version_hash(0);
+    request->tablet_schema.schema_hash = schema_hash;
+    request->tablet_schema.short_key_column_count = 1;
+    request->tablet_schema.keys_type = TKeysType::DUP_KEYS;
+    request->tablet_schema.storage_type = TStorageType::COLUMN;
+
+    auto& columns = request->tablet_schema.columns;
+    columns.push_back(create_tcolumn("k1", TPrimitiveType::INT, true));
+    columns.push_back(create_tcolumn("k2", TPrimitiveType::INT, true));
+    columns.push_back(create_tcolumn("v1", TPrimitiveType::INT, false));
+}
+
+TDescriptorTable create_descriptor_tablet_with_dup_keys() {
+    TDescriptorTableBuilder dtb;
+    TTupleDescriptorBuilder tuple_builder;
+
+    tuple_builder.add_slot(
+            TSlotDescriptorBuilder().type(TYPE_INT).column_name("k1").column_pos(0).build());
+    tuple_builder.add_slot(
+            TSlotDescriptorBuilder().type(TYPE_INT).column_name("k2").column_pos(1).build());
+    tuple_builder.add_slot(
+            TSlotDescriptorBuilder().type(TYPE_INT).column_name("v1").column_pos(2).build());
+    tuple_builder.build(&dtb);
+
+    return dtb.desc_tbl();
+}
+
+// Writes blocks by a vectorized delta writer, and returns the rowset it commits in rowset.
+void write_blocks(WriteRequest* write_req, const std::vector<vectorized::Block>& blocks,
+                  RowsetSharedPtr* rowset) {
+    write_req->is_vec = true;
+    DeltaWriter* delta_writer = nullptr;
+    DeltaWriter::open(write_req, k_mem_tracker, &delta_writer);
+    ASSERT_NE(delta_writer, nullptr);
+    std::unique_ptr<DeltaWriter> delta_writer_holder(delta_writer);
+    for (const auto& block : blocks) {
+        ASSERT_EQ(OLAP_SUCCESS, delta_writer->write(&block));
+    }
+    ASSERT_EQ(OLAP_SUCCESS, delta_writer->close());
+    ASSERT_EQ(OLAP_SUCCESS, delta_writer->close_wait(nullptr));
+
+    std::map<TabletInfo, RowsetSharedPtr> tablet_related_rs;
+    StorageEngine::instance()->txn_manager()->get_txn_related_tablets(
+            write_req->txn_id, write_req->partition_id, &tablet_related_rs);
+    ASSERT_EQ(1, tablet_related_rs.size());
+    *rowset = tablet_related_rs.begin()->second;
+}
+
+// Reads all the rows of rowset in order. Checks as well that the short key index of the
+// segment has the key of the first row of every block of rows, encoded as SegmentWriter
+// encodes the rows appended one by one.
+void read_rowset(const RowsetSharedPtr& rowset, const TabletSchema& tablet_schema,
+                 const std::function<void(const RowCursor&)>& visit_row) {
+    std::vector<uint32_t> return_columns;
+    for (uint32_t cid = 0; cid < tablet_schema.num_columns(); ++cid) {
+        return_columns.push_back(cid);
+    }
+    OlapReaderStatistics stats;
+    RowsetReaderContext reader_context;
+    reader_context.tablet_schema = &tablet_schema;
+    reader_context.need_ordered_result = true;
+    reader_context.return_columns = &return_columns;
+    reader_context.seek_columns = &return_columns;
+    reader_context.stats = &stats;
+    RowsetReaderSharedPtr rowset_reader;
+    ASSERT_EQ(OLAP_SUCCESS, rowset->create_reader(&rowset_reader));
+    ASSERT_EQ(OLAP_SUCCESS, rowset_reader->init(&reader_context));
+
+    RowCursor row;
+    ASSERT_EQ(OLAP_SUCCESS, row.init(tablet_schema));
+    std::vector<std::string> short_keys;
+    RowBlock* block = nullptr;
+    OLAPStatus res;
+    while ((res = rowset_reader->next_block(&block)) == OLAP_SUCCESS) {
+        for (uint32_t i = 0; i < block->row_num(); ++i) {
+            block->get_row(i, &row);
+            std::string short_key;
+            encode_key(&short_key, row, tablet_schema.num_short_key_columns());
+            short_keys.push_back(std::move(short_key));
+            visit_row(row);
+        }
+    }
+    ASSERT_EQ(OLAP_ERR_DATA_EOF, res);
+    ASSERT_EQ(rowset->num_rows(), short_keys.size());
+
+    ASSERT_EQ(1, rowset->num_segments());
+    ASSERT_EQ(OLAP_SUCCESS, rowset->load());
+    const auto& segment = std::static_pointer_cast<BetaRowset>(rowset)->_segments[0];
+    ASSERT_TRUE(segment->_load_index().ok());
+    const auto& short_key_index = *segment->_sk_index_decoder;
+    size_t num_rows_per_block = short_key_index.num_rows_per_block();
+    ASSERT_EQ((short_keys.size() + num_rows_per_block - 1) / num_rows_per_block,
+              short_key_index.num_items());
+    for (size_t i = 0; i < short_key_index.num_items(); ++i) {
+        ASSERT_EQ(Slice(short_keys[i * num_rows_per_block]), short_key_index.key(i));
+    }
+}
+
+std::string serialize_hll(uint64_t hash) {
+    HyperLogLog hll(hash);
+    std::string buf(hll.max_serialized_size(), '\0');
+    buf.resize(hll.serialize(reinterpret_cast<uint8_t*>(buf.data())));
+    return buf;
+}
+
+std::string serialize_bitmap(uint64_t value) {
+    BitmapValue bitmap(value);
+    std::string buf(bitmap.getSizeInBytes(), '\0');
+    bitmap.write(buf.data());
+    return buf;
+}
+
 class TestDeltaWriter : public ::testing::Test {
 public:
     TestDeltaWriter() {}
@@ -592,6 +816,293 @@ TEST_F(TestDeltaWriter, sequence_col) {
     delete delta_writer;
 }
 
+TEST_F(TestDeltaWriter, vec_sequence_col) {
+    TCreateTabletReq request;
+    create_tablet_request_with_sequence_col(10006, 270068378, &request);
+    OLAPStatus res = k_engine->create_tablet(request);
+    ASSERT_EQ(OLAP_SUCCESS, res);
+
+    TDescriptorTable tdesc_tbl = create_descriptor_tablet_with_sequence_col();
+    ObjectPool obj_pool;
+    DescriptorTbl* desc_tbl = nullptr;
+    DescriptorTbl::create(&obj_pool, tdesc_tbl, &desc_tbl);
+    TupleDescriptor* tuple_desc = desc_tbl->get_tuple_descriptor(0);
+
+    PUniqueId load_id;
+    load_id.set_hi(0);
+    load_id.set_lo(0);
+    WriteRequest write_req = {10006, 270068378,  WriteType::LOAD,       20004, 30004, load_id,
+                              false, tuple_desc, &(tuple_desc->slots())};
+
+    // Every key keeps its last loaded row of the greatest sequence. (1, 2) is loaded 5 times,
+    // twice with its greatest sequence 5, (3, 1) twice with the same sequence.
+    using Row = std::tuple<int8_t, int16_t, int32_t, std::string>;
+    std::vector<std::vector<Row>> block_rows = {{{1, 2, 3, "2020-07-16 19:39:43"},
+                                                 {3, 2, 1, "2020-07-16 19:39:44"},
+                                                 {1, 2, 5, "2020-07-16 19:39:45"},
+                                                 {3, 1, 7, "2020-07-16 19:39:46"},
+                                                 {1, 2, 4, "2020-07-16 19:39:47"}},
+                                                {{3, 1, 7, "2020-07-16 19:39:48"},
+                                                 {1, 2, 5, "2020-07-16 19:39:49"},
+                                                 {1, 2, 2, "2020-07-16 19:39:50"}}};
+    std::vector<Row> expected = {{1, 2, 5, "2020-07-16 19:39:49"},
+                                 {3, 1, 7, "2020-07-16 19:39:48"},
+                                 {3, 2, 1, "2020-07-16 19:39:44"}};
+
+    std::vector<vectorized::Block> blocks;
+    for (const auto& rows : block_rows) {
+        auto k1 = vectorized::ColumnInt8::create();
+        auto k2 = vectorized::ColumnInt16::create();
+        auto sequence = vectorized::ColumnInt32::create();
+        auto v1 = vectorized::ColumnVector<vectorized::Int128>::create();
+        for (const auto& [k1_value, k2_value, sequence_value, v1_value] : rows) {
+            k1->insertValue(k1_value);
+            k2->insertValue(k2_value);
+            sequence->insertValue(sequence_value);
+            DateTimeValue datetime;
+            datetime.from_date_str(v1_value.data(), v1_value.size());
+            v1->insertData(reinterpret_cast<const char*>(&datetime), sizeof(datetime));
+        }
+        blocks.push_back(vectorized::Block(
+                {{std::move(k1), std::make_shared<vectorized::DataTypeInt8>(), "k1"},
+                 {std::move(k2), std::make_shared<vectorized::DataTypeInt16>(), "k2"},
+                 {std::move(sequence), std::make_shared<vectorized::DataTypeInt32>(),
+                  SEQUENCE_COL},
+                 {std::move(v1), std::make_shared<vectorized::DataTypeInt128>(), "v1"}}));
+    }
+    RowsetSharedPtr rowset;
+    ASSERT_NO_FATAL_FAILURE(write_blocks(&write_req, blocks, &rowset));
+    ASSERT_EQ(expected.size(), rowset->num_rows());
+
+    TabletSharedPtr tablet = k_engine->tablet_manager()->get_tablet(10006, 270068378);
+    size_t num_rows = 0;
+    ASSERT_NO_FATAL_FAILURE(
+            read_rowset(rowset, tablet->tablet_schema(), [&](const RowCursor& row) {
+                ASSERT_LT(num_rows, expected.size());
+                const auto& [k1, k2, sequence, v1] = expected[num_rows++];
+                ASSERT_EQ(k1, *reinterpret_cast<const int8_t*>(row.cell_ptr(0)));
+                ASSERT_EQ(k2, *reinterpret_cast<const int16_t*>(row.cell_ptr(1)));
+                ASSERT_EQ(sequence, *reinterpret_cast<const int32_t*>(row.cell_ptr(2)));
+                DateTimeValue datetime;
+                datetime.from_date_str(v1.data(), v1.size());
+                ASSERT_EQ(datetime.to_olap_datetime(),
+                          *reinterpret_cast<const uint64_t*>(row.cell_ptr(3)));
+            }));
+    ASSERT_EQ(expected.size(), num_rows);
+
+    res = k_engine->tablet_manager()->drop_tablet(10006, 270068378);
+    ASSERT_EQ(OLAP_SUCCESS, res);
+}
+
+TEST_F(TestDeltaWriter, vec_agg_keys) {
+    TCreateTabletReq request;
+    create_tablet_request_with_agg_values(10007, 270068379, &request);
+    OLAPStatus res = k_engine->create_tablet(request);
+    ASSERT_EQ(OLAP_SUCCESS, res);
+
+    TDescriptorTable tdesc_tbl = create_descriptor_tablet_with_agg_values();
+    ObjectPool obj_pool;
+    DescriptorTbl* desc_tbl = nullptr;
+    DescriptorTbl::create(&obj_pool, tdesc_tbl, &desc_tbl);
+    TupleDescriptor* tuple_desc = desc_tbl->get_tuple_descriptor(0);
+
+    PUniqueId load_id;
+    load_id.set_hi(0);
+    load_id.set_lo(0);
+    WriteRequest write_req = {10007, 270068379,  WriteType::LOAD,       20005, 30005, load_id,
+                              false, tuple_desc, &(tuple_desc->slots())};
+
+    // The key k1 is loaded k1 % 3 + 1 times, in a block of every round. The keys of a round are
+    // ascending in even rounds and descending in odd ones. The aggregated rows fill several
+    // blocks of rows, so the short key index has several entries.
+    const int num_keys = 2500;
+    struct ExpectedValues {
+        int64_t sum = 0;
+        int32_t min = std::numeric_limits<int32_t>::max();
+        uint64_t max = 0;
+        int32_t replace = 0;
+        bool replace_if_not_null_is_null = true;
+        int32_t replace_if_not_null = 0;
+        std::set<uint64_t> hll_hashes;
+        std::set<uint64_t> bitmap_values;
+    };
+    std::vector<ExpectedValues> expected(num_keys);
+    std::vector<vectorized::Block> blocks;
+    for (int round = 0; round < 3; ++round) {
+        auto k1 = vectorized::ColumnInt32::create();
+        auto k2 = vectorized::ColumnInt16::create();
+        auto v_sum = vectorized::ColumnInt64::create();
+        auto v_min = vectorized::ColumnInt32::create();
+        auto v_max = vectorized::ColumnVector<vectorized::Int128>::create();
+        auto v_replace = vectorized::ColumnInt32::create();
+        auto v_replace_if_not_null = vectorized::ColumnInt32::create();
+        auto v_replace_if_not_null_map = vectorized::ColumnUInt8::create();
+        auto v_hll = vectorized::ColumnString::create();
+        auto v_bitmap = vectorized::ColumnString::create();
+        for (int i = 0; i < num_keys; ++i) {
+            int key = round % 2 == 0 ? i : num_keys - 1 - i;
+            if (key % 3 < round) {
+                continue;
+            }
+            auto& values = expected[key];
+            k1->insertValue(key);
+            k2->insertValue(key % 7);
+
+            int64_t sum = key * 10 + round;
+            v_sum->insertValue(sum);
+            values.sum += sum;
+
+            int32_t min = (key + round * 7) % 11 - 5;
+            v_min->insertValue(min);
+            values.min = std::min(values.min, min);
+
+            DateTimeValue max;
+            max.from_olap_datetime(20210101000000L + (key * 3 + round * 5) % 60);
+            v_max->insertData(reinterpret_cast<const char*>(&max), sizeof(max));
+            values.max = std::max(values.max, max.to_olap_datetime());
+
+            values.replace = key * 100 + round;
+            v_replace->insertValue(values.replace);
+
+            bool is_null = (key + round) % 4 == 0;
+            v_replace_if_not_null->insertValue(key * 100 + round);
+            v_replace_if_not_null_map->insertValue(is_null);
+            if (!is_null) {
+                values.replace_if_not_null_is_null = false;
+                values.replace_if_not_null = key * 100 + round;
+            }
+
+            // the hashes of the first two rounds are equal
+            uint64_t hash = key * 2 + round / 2;
+            std::string hll = serialize_hll(hash);
+            v_hll->insertData(hll.data(), hll.size());
+            values.hll_hashes.insert(hash);
+
+            uint64_t bitmap_value = key + round % 2;
+            std::string bitmap = serialize_bitmap(bitmap_value);
+            v_bitmap->insertData(bitmap.data(), bitmap.size());
+            values.bitmap_values.insert(bitmap_value);
+        }
+        auto int_type = std::make_shared<vectorized::DataTypeInt32>();
+        auto string_type = std::make_shared<vectorized::DataTypeString>();
+        blocks.push_back(vectorized::Block(
+                {{std::move(k1), int_type, "k1"},
+                 {std::move(k2), std::make_shared<vectorized::DataTypeInt16>(), "k2"},
+                 {std::move(v_sum), std::make_shared<vectorized::DataTypeInt64>(), "v_sum"},
+                 {std::move(v_min), int_type, "v_min"},
+                 {std::move(v_max), std::make_shared<vectorized::DataTypeInt128>(), "v_max"},
+                 {std::move(v_replace), int_type, "v_replace"},
+                 {vectorized::ColumnNullable::create(std::move(v_replace_if_not_null),
+                                                     std::move(v_replace_if_not_null_map)),
+                  vectorized::makeNullable(int_type), "v_replace_if_not_null"},
+                 {std::move(v_hll), string_type, "v_hll"},
+                 {std::move(v_bitmap), string_type, "v_bitmap"}}));
+    }
+    RowsetSharedPtr rowset;
+    ASSERT_NO_FATAL_FAILURE(write_blocks(&write_req, blocks, &rowset));
+    ASSERT_EQ(num_keys, rowset->num_rows());
+
+    TabletSharedPtr tablet = k_engine->tablet_manager()->get_tablet(10007, 270068379);
+    int num_rows = 0;
+    ASSERT_NO_FATAL_FAILURE(
+            read_rowset(rowset, tablet->tablet_schema(), [&](const RowCursor& row) {
+                // the keys are read in order, k2 is determined by k1
+                int key = num_rows++;
+                ASSERT_LT(key, num_keys);
+                const auto& values = expected[key];
+                ASSERT_EQ(key, *reinterpret_cast<const int32_t*>(row.cell_ptr(0)));
+                ASSERT_EQ(key % 7, *reinterpret_cast<const int16_t*>(row.cell_ptr(1)));
+                ASSERT_EQ(values.sum, *reinterpret_cast<const int64_t*>(row.cell_ptr(2)));
+                ASSERT_EQ(values.min, *reinterpret_cast<const int32_t*>(row.cell_ptr(3)));
+                ASSERT_EQ(values.max, *reinterpret_cast<const uint64_t*>(row.cell_ptr(4)));
+                ASSERT_EQ(values.replace, *reinterpret_cast<const int32_t*>(row.cell_ptr(5)));
+                ASSERT_EQ(values.replace_if_not_null_is_null, row.is_null(6));
+                if (!values.replace_if_not_null_is_null) {
+                    ASSERT_EQ(values.replace_if_not_null,
+                              *reinterpret_cast<const int32_t*>(row.cell_ptr(6)));
+                }
+
+                HyperLogLog hll(*reinterpret_cast<const Slice*>(row.cell_ptr(7)));
+                ASSERT_EQ(values.hll_hashes.size(),
+                          static_cast<size_t>(hll.estimate_cardinality()));
+
+                BitmapValue bitmap(reinterpret_cast<const Slice*>(row.cell_ptr(8))->data);
+                ASSERT_EQ(values.bitmap_values.size(), static_cast<size_t>(bitmap.cardinality()));
+                for (auto value : values.bitmap_values) {
+                    ASSERT_TRUE(bitmap.contains(value));
+                }
+            }));
+    ASSERT_EQ(num_keys, num_rows);
+
+    res = k_engine->tablet_manager()->drop_tablet(10007, 270068379);
+    ASSERT_EQ(OLAP_SUCCESS, res);
+}
+
+TEST_F(TestDeltaWriter, vec_dup_keys) {
+    TCreateTabletReq request;
+    create_tablet_request_with_dup_keys(10008, 270068380, &request);
+    OLAPStatus res = k_engine->create_tablet(request);
+    ASSERT_EQ(OLAP_SUCCESS, res);
+
+    TDescriptorTable tdesc_tbl = create_descriptor_tablet_with_dup_keys();
+    ObjectPool obj_pool;
+    DescriptorTbl* desc_tbl = nullptr;
+    DescriptorTbl::create(&obj_pool, tdesc_tbl, &desc_tbl);
+    TupleDescriptor* tuple_desc = desc_tbl->get_tuple_descriptor(0);
+
+    PUniqueId load_id;
+    load_id.set_hi(0);
+    load_id.set_lo(0);
+    WriteRequest write_req = {10008, 270068380,  WriteType::LOAD,       20006, 30006, load_id,
+                              false, tuple_desc, &(tuple_desc->slots())};
+
+    // All the rows are kept and sorted by k1 and k2, the rows of equal keys stay in the order
+    // they are loaded in, which v1 is.
+    const int num_blocks = 2;
+    const int rows_per_block = 1500;
+    using Row = std::tuple<int32_t, int32_t, int32_t>;
+    std::vector<Row> expected;
+    std::vector<vectorized::Block> blocks;
+    for (int block = 0; block < num_blocks; ++block) {
+        auto k1 = vectorized::ColumnInt32::create();
+        auto k2 = vectorized::ColumnInt32::create();
+        auto v1 = vectorized::ColumnInt32::create();
+        for (int i = block * rows_per_block; i < (block + 1) * rows_per_block; ++i) {
+            k1->insertValue(i * 7919 % 1000);
+            k2->insertValue(i % 3);
+            v1->insertValue(i);
+            expected.emplace_back(i * 7919 % 1000, i % 3, i);
+        }
+        auto int_type = std::make_shared<vectorized::DataTypeInt32>();
+        blocks.push_back(vectorized::Block({{std::move(k1), int_type, "k1"},
+                                            {std::move(k2), int_type, "k2"},
+                                            {std::move(v1), int_type, "v1"}}));
+    }
+    std::stable_sort(expected.begin(), expected.end(), [](const Row& lhs, const Row& rhs) {
+        return std::make_pair(std::get<0>(lhs), std::get<1>(lhs)) <
+               std::make_pair(std::get<0>(rhs), std::get<1>(rhs));
+    });
+
+    RowsetSharedPtr rowset;
+    ASSERT_NO_FATAL_FAILURE(write_blocks(&write_req, blocks, &rowset));
+    ASSERT_EQ(expected.size(), rowset->num_rows());
+
+    TabletSharedPtr tablet = k_engine->tablet_manager()->get_tablet(10008, 270068380);
+    size_t num_rows = 0;
+    ASSERT_NO_FATAL_FAILURE(
+            read_rowset(rowset, tablet->tablet_schema(), [&](const RowCursor& row) {
+                ASSERT_LT(num_rows, expected.size());
+                const auto& [k1, k2, v1] = expected[num_rows++];
+                ASSERT_EQ(k1, *reinterpret_cast<const int32_t*>(row.cell_ptr(0)));
+                ASSERT_EQ(k2, *reinterpret_cast<const int32_t*>(row.cell_ptr(1)));
+                ASSERT_EQ(v1, *reinterpret_cast<const int32_t*>(row.cell_ptr(2)));
+            }));
+    ASSERT_EQ(expected.size(), num_rows);
+
+    res = k_engine->tablet_manager()->drop_tablet(10008, 270068380);
+    ASSERT_EQ(OLAP_SUCCESS, res);
+}
+
 } // namespace doris
 
 int main(int argc, char** argv) {
@@ -19,6 +19,15 @@
 
 #include "olap/row_block2.h"
 
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/column_vector.h"
+#include "vec/common/assert_cast.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/data_types/data_type_string.h"
+
 namespace doris {
 
 class TestRowBlockV2 : public testing::Test {
@@ -164,6 +173,80 @@ TEST_F(TestRowBlockV2, test_convert) {
     }
 }
 
+TEST_F(TestRowBlockV2, test_convert_to_vec_block) {
+    TabletSchema tablet_schema;
+    init_tablet_schema(&tablet_schema, true);
+    Schema schema(tablet_schema);
+    RowBlockV2 input_block(schema, 1024);
+    auto tracker = std::make_shared<MemTracker>();
+    MemPool pool(tracker.get());
+    for (int i = 0; i < input_block.capacity(); ++i) {
+        RowBlockRow row = input_block.row(i);
+
+        // column_1, every 20th row is null
+        row.set_is_null(0, i % 20 == 0);
+        *(int64_t*)row.mutable_cell_ptr(0) = i;
+
+        // column_2, padded with zeros
+        uint8_t* buf = pool.allocate(10);
+        memset(buf, 0, 10);
+        memset(buf, 'a' + (i % 10), 5);
+        row.set_is_null(1, false);
+        *(Slice*)row.mutable_cell_ptr(1) = Slice(buf, 10);
+
+        // column_3
+        uint8_t* buf2 = pool.allocate(10);
+        memset(buf2, 'A' + (i % 10), 10);
+        row.set_is_null(2, false);
+        *(Slice*)row.mutable_cell_ptr(2) = Slice(buf2, 10);
+
+        // column_4
+        row.set_is_null(3, false);
+        *(int32_t*)row.mutable_cell_ptr(3) = 10 * i;
+    }
+
+    input_block.set_selected_size(5);
+    uint16_t* select_vector = input_block.selection_vector();
+    for (int i = 0; i < input_block.selected_size(); ++i) {
+        // 10, 20, 30, 40, 50
+        select_vector[i] = (i + 1) * 10;
+    }
+
+    // only the first three columns are wanted
+    vectorized::Block block;
+    auto nullable = [](vectorized::DataTypePtr type) {
+        return std::make_shared<vectorized::DataTypeNullable>(type);
+    };
+    for (auto type : {nullable(std::make_shared<vectorized::DataTypeInt64>()),
+                      nullable(std::make_shared<vectorized::DataTypeString>()),
+                      nullable(std::make_shared<vectorized::DataTypeString>())}) {
+        block.insert(vectorized::ColumnWithTypeAndName(type->createColumn(), type, ""));
+    }
+    // rows are appended
+    for (int round = 1; round <= 2; ++round) {
+        auto st = input_block.convert_to_vec_block(&block);
+        ASSERT_TRUE(st.ok());
+        ASSERT_EQ(5 * round, block.rows());
+    }
+
+    for (int i = 0; i < 10; ++i) {
+        int row_idx = (i % 5 + 1) * 10;
+        auto& k1 = assert_cast<const vectorized::ColumnNullable&>(*block.getByPosition(0).column);
+        ASSERT_EQ(row_idx % 20 == 0, k1.isNullAt(i));
+        if (!k1.isNullAt(i)) {
+            ASSERT_EQ(row_idx, k1.getNestedColumn().getInt(i));
+        }
+
+        auto& k2 = assert_cast<const vectorized::ColumnNullable&>(*block.getByPosition(1).column);
+        ASSERT_EQ(std::string(5, 'a' + row_idx % 10),
+                  k2.getNestedColumn().getDataAt(i).toString());
+
+        auto& k3 = assert_cast<const vectorized::ColumnNullable&>(*block.getByPosition(2).column);
+        ASSERT_EQ(std::string(10, 'A' + row_idx % 10),
+                  k3.getNestedColumn().getDataAt(i).toString());
+    }
+}
+
 } // namespace doris
 
 // @brief Test Stub
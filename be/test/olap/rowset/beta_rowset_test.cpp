@@ -14,6 +14,8 @@
 // KIND, either express or implied.  See the License for the
 // specific language governing permissions and limitations
 // under the License.
+#include <algorithm>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -31,11 +33,18 @@
 #include "olap/storage_engine.h"
 #include "olap/tablet_schema.h"
 #include "olap/utils.h"
+#include "olap/vcollect_iterator.h"
 #include "runtime/exec_env.h"
 #include "runtime/mem_pool.h"
 #include "runtime/mem_tracker.h"
 #include "util/file_utils.h"
 #include "util/slice.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
+#include "vec/common/assert_cast.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_types_number.h"
 
 using std::string;
 
@@ -140,6 +149,41 @@ protected:
         rowset_writer_context->version.second = 10;
     }
 
+    // rowset "i" has the version 10 + i and the rows k1 := rid * (i + 1), k2 := 0, v1 := 1
+    void create_rowsets(TabletSchema* tablet_schema, int num_rowsets, int rows_per_rowset,
+                        std::vector<RowsetSharedPtr>* rowsets) {
+        for (int i = 0; i < num_rowsets; ++i) {
+            RowsetWriterContext writer_context;
+            create_rowset_writer_context(tablet_schema, &writer_context);
+            writer_context.rowset_id.init(10000 + i);
+            writer_context.version.first = 10 + i;
+            writer_context.version.second = 10 + i;
+
+            std::unique_ptr<RowsetWriter> rowset_writer;
+            auto s = RowsetFactory::create_rowset_writer(writer_context, &rowset_writer);
+            ASSERT_EQ(OLAP_SUCCESS, s);
+
+            RowCursor input_row;
+            input_row.init(*tablet_schema);
+            auto tracker = std::make_shared<MemTracker>();
+            MemPool mem_pool(tracker.get());
+            for (int rid = 0; rid < rows_per_rowset; ++rid) {
+                uint32_t k1 = rid * (i + 1);
+                uint32_t k2 = 0;
+                uint32_t v1 = 1;
+                input_row.set_field_content(0, reinterpret_cast<char*>(&k1), &mem_pool);
+                input_row.set_field_content(1, reinterpret_cast<char*>(&k2), &mem_pool);
+                input_row.set_field_content(2, reinterpret_cast<char*>(&v1), &mem_pool);
+                s = rowset_writer->add_row(input_row);
+                ASSERT_EQ(OLAP_SUCCESS, s);
+            }
+            s = rowset_writer->flush();
+            ASSERT_EQ(OLAP_SUCCESS, s);
+            rowsets->push_back(rowset_writer->build());
+            ASSERT_TRUE(rowsets->back() != nullptr);
+        }
+    }
+
     void create_and_init_rowset_reader(Rowset* rowset, RowsetReaderContext& context,
                                        RowsetReaderSharedPtr* result) {
         auto s = rowset->create_reader(result);
@@ -350,6 +394,232 @@ TEST_F(BetaRowsetTest, BasicFunctionTest) {
     }
 }
 
+TEST_F(BetaRowsetTest, VCollectIteratorTest) {
+    OLAPStatus s;
+    TabletSchema tablet_schema;
+    create_tablet_schema(&tablet_schema);
+
+    const int num_rowsets = 3;
+    const int rows_per_rowset = 3000;
+    std::vector<RowsetSharedPtr> rowsets;
+    create_rowsets(&tablet_schema, num_rowsets, rows_per_rowset, &rowsets);
+    ASSERT_EQ(num_rowsets, rowsets.size());
+
+    // the number of rowsets of every key
+    std::map<int32_t, int32_t> expected;
+    for (int i = 0; i < num_rowsets; ++i) {
+        for (int rid = 0; rid < rows_per_rowset; ++rid) {
+            ++expected[rid * (i + 1)];
+        }
+    }
+
+    RowsetReaderContext reader_context;
+    reader_context.tablet_schema = &tablet_schema;
+    reader_context.need_ordered_result = true;
+    std::vector<uint32_t> return_columns = {0, 1, 2};
+    reader_context.return_columns = &return_columns;
+    reader_context.seek_columns = &return_columns;
+    reader_context.stats = &_stats;
+
+    auto nullable_int = vectorized::makeNullable(std::make_shared<vectorized::DataTypeInt32>());
+    auto not_null_int = std::make_shared<vectorized::DataTypeInt32>();
+    vectorized::Block header({{nullable_int->createColumn(), nullable_int, "k1"},
+                              {nullable_int->createColumn(), nullable_int, "k2"},
+                              {not_null_int->createColumn(), not_null_int, "v1"}});
+
+    for (auto keys_type : {DUP_KEYS, AGG_KEYS}) {
+        VCollectIterator iterator(&tablet_schema, keys_type);
+        for (auto& rowset : rowsets) {
+            RowsetReaderSharedPtr rowset_reader;
+            create_and_init_rowset_reader(rowset.get(), reader_context, &rowset_reader);
+            iterator.add_child(rowset_reader);
+        }
+
+        std::vector<int32_t> keys;
+        std::vector<int32_t> values;
+        while (true) {
+            vectorized::Block block = header.cloneEmpty();
+            bool eof = false;
+            s = iterator.next_block(&block, &eof);
+            ASSERT_EQ(OLAP_SUCCESS, s);
+            if (eof) {
+                break;
+            }
+            const auto& k1 = assert_cast<const vectorized::ColumnNullable&>(
+                    *block.getByPosition(0).column);
+            const auto& k1_data =
+                    assert_cast<const vectorized::ColumnInt32&>(k1.getNestedColumn()).getData();
+            const auto& v1_data =
+                    assert_cast<const vectorized::ColumnInt32&>(*block.getByPosition(2).column)
+                            .getData();
+            keys.insert(keys.end(), k1_data.begin(), k1_data.end());
+            values.insert(values.end(), v1_data.begin(), v1_data.end());
+        }
+
+        if (keys_type == DUP_KEYS) {
+            ASSERT_EQ(num_rowsets * rows_per_rowset, keys.size());
+            ASSERT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+            ASSERT_EQ(0, iterator.merged_rows());
+        } else {
+            // the values of every key are summed
+            ASSERT_EQ(expected.size(), keys.size());
+            size_t row = 0;
+            for (const auto& it : expected) {
+                ASSERT_EQ(it.first, keys[row]);
+                ASSERT_EQ(it.second, values[row]);
+                ++row;
+            }
+            ASSERT_EQ(num_rowsets * rows_per_rowset - expected.size(), iterator.merged_rows());
+        }
+    }
+}
+
+TEST_F(BetaRowsetTest, VerticalMergeTest) {
+    OLAPStatus s;
+    TabletSchema tablet_schema;
+    create_tablet_schema(&tablet_schema);
+
+    const int num_rowsets = 3;
+    const int rows_per_rowset = 3000;
+    std::vector<RowsetSharedPtr> rowsets;
+    create_rowsets(&tablet_schema, num_rowsets, rows_per_rowset, &rowsets);
+    ASSERT_EQ(num_rowsets, rowsets.size());
+
+    // the number of rowsets of every key
+    std::map<int32_t, int32_t> expected;
+    for (int i = 0; i < num_rowsets; ++i) {
+        for (int rid = 0; rid < rows_per_rowset; ++rid) {
+            ++expected[rid * (i + 1)];
+        }
+    }
+
+    RowsetWriterContext writer_context;
+    create_rowset_writer_context(&tablet_schema, &writer_context);
+    writer_context.rowset_id.init(10100);
+    writer_context.version.first = 10;
+    writer_context.version.second = 10 + num_rowsets - 1;
+    std::unique_ptr<RowsetWriter> rowset_writer;
+    s = RowsetFactory::create_rowset_writer(writer_context, &rowset_writer);
+    ASSERT_EQ(OLAP_SUCCESS, s);
+    const uint32_t max_rows_per_segment = 1000;
+
+    auto nullable_int = vectorized::makeNullable(std::make_shared<vectorized::DataTypeInt32>());
+    auto not_null_int = std::make_shared<vectorized::DataTypeInt32>();
+    vectorized::ColumnWithTypeAndName k1 {nullable_int->createColumn(), nullable_int, "k1"};
+    vectorized::ColumnWithTypeAndName k2 {nullable_int->createColumn(), nullable_int, "k2"};
+    vectorized::ColumnWithTypeAndName v1 {not_null_int->createColumn(), not_null_int, "v1"};
+
+    // the key columns, recording the row sources
+    RowSourcesBuffer row_sources;
+    {
+        RowsetReaderContext reader_context;
+        reader_context.tablet_schema = &tablet_schema;
+        reader_context.need_ordered_result = true;
+        std::vector<uint32_t> return_columns = {0, 1};
+        reader_context.return_columns = &return_columns;
+        reader_context.seek_columns = &return_columns;
+        reader_context.stats = &_stats;
+
+        VCollectIterator iterator(&tablet_schema, AGG_KEYS);
+        iterator.set_row_sources(&row_sources);
+        for (auto& rowset : rowsets) {
+            RowsetReaderSharedPtr rowset_reader;
+            create_and_init_rowset_reader(rowset.get(), reader_context, &rowset_reader);
+            iterator.add_child(rowset_reader);
+        }
+        vectorized::Block header({k1, k2});
+        while (true) {
+            vectorized::Block block = header.cloneEmpty();
+            bool eof = false;
+            s = iterator.next_block(&block, &eof);
+            ASSERT_EQ(OLAP_SUCCESS, s);
+            if (eof) {
+                break;
+            }
+            s = rowset_writer->add_columns(&block, {0, 1}, true, max_rows_per_segment);
+            ASSERT_EQ(OLAP_SUCCESS, s);
+        }
+        ASSERT_EQ(OLAP_SUCCESS, rowset_writer->flush_columns(true));
+        ASSERT_EQ(num_rowsets * rows_per_rowset, row_sources.size());
+        ASSERT_EQ(num_rowsets * rows_per_rowset - expected.size(), iterator.merged_rows());
+    }
+
+    // the value column in the same order, with the key columns for the rowset readers
+    {
+        RowsetReaderContext reader_context;
+        reader_context.tablet_schema = &tablet_schema;
+        reader_context.need_ordered_result = true;
+        std::vector<uint32_t> return_columns = {2, 0, 1};
+        reader_context.return_columns = &return_columns;
+        reader_context.seek_columns = &return_columns;
+        reader_context.stats = &_stats;
+
+        VValueGroupIterator iterator(&tablet_schema, return_columns, &row_sources);
+        for (auto& rowset : rowsets) {
+            RowsetReaderSharedPtr rowset_reader;
+            create_and_init_rowset_reader(rowset.get(), reader_context, &rowset_reader);
+            iterator.add_child(rowset_reader);
+        }
+        vectorized::Block header({v1});
+        while (true) {
+            vectorized::Block block = header.cloneEmpty();
+            bool eof = false;
+            s = iterator.next_block(&block, &eof);
+            ASSERT_EQ(OLAP_SUCCESS, s);
+            if (eof) {
+                break;
+            }
+            s = rowset_writer->add_columns(&block, {2}, false, max_rows_per_segment);
+            ASSERT_EQ(OLAP_SUCCESS, s);
+        }
+        ASSERT_EQ(OLAP_SUCCESS, rowset_writer->flush_columns(false));
+    }
+    ASSERT_EQ(OLAP_SUCCESS, rowset_writer->final_flush());
+    RowsetSharedPtr rowset = rowset_writer->build();
+    ASSERT_TRUE(rowset != nullptr);
+    ASSERT_EQ(expected.size(), rowset->num_rows());
+    ASSERT_EQ((expected.size() + max_rows_per_segment - 1) / max_rows_per_segment,
+              rowset->num_segments());
+
+    // the values of every key are summed
+    RowsetReaderContext reader_context;
+    reader_context.tablet_schema = &tablet_schema;
+    reader_context.need_ordered_result = true;
+    std::vector<uint32_t> return_columns = {0, 1, 2};
+    reader_context.return_columns = &return_columns;
+    reader_context.seek_columns = &return_columns;
+    reader_context.stats = &_stats;
+    RowsetReaderSharedPtr rowset_reader;
+    create_and_init_rowset_reader(rowset.get(), reader_context, &rowset_reader);
+    vectorized::Block header({k1, k2, v1});
+    std::vector<int32_t> keys;
+    std::vector<int32_t> values;
+    while (true) {
+        vectorized::Block block = header.cloneEmpty();
+        s = rowset_reader->next_block(&block);
+        if (s == OLAP_ERR_DATA_EOF) {
+            break;
+        }
+        ASSERT_EQ(OLAP_SUCCESS, s);
+        const auto& k1_column =
+                assert_cast<const vectorized::ColumnNullable&>(*block.getByPosition(0).column);
+        const auto& k1_data =
+                assert_cast<const vectorized::ColumnInt32&>(k1_column.getNestedColumn()).getData();
+        const auto& v1_data =
+                assert_cast<const vectorized::ColumnInt32&>(*block.getByPosition(2).column)
+                        .getData();
+        keys.insert(keys.end(), k1_data.begin(), k1_data.end());
+        values.insert(values.end(), v1_data.begin(), v1_data.end());
+    }
+    ASSERT_EQ(expected.size(), keys.size());
+    size_t row = 0;
+    for (const auto& it : expected) {
+        ASSERT_EQ(it.first, keys[row]);
+        ASSERT_EQ(it.second, values[row]);
+        ++row;
+    }
+}
+
 } // namespace doris
 
 int main(int argc, char** argv) {
@@ -105,6 +105,13 @@ public:
         ASSERT_EQ("Captain", values[6].to_string());
         ASSERT_EQ("Xmas", values[7].to_string());
 
+        // the codes of the values in the dictionary are kept as well
+        ASSERT_TRUE(cvb->has_dict_codes());
+        ASSERT_EQ(dict_page_decoder.get(), cvb->dict());
+        for (size_t i = 0; i < size; ++i) {
+            ASSERT_EQ(values[i], dict_page_decoder->string_at_index(cvb->dict_codes()[i]));
+        }
+
         status = page_decoder.seek_to_position_in_page(5);
         status = page_decoder.next_batch(&size, &block_view);
         ASSERT_TRUE(status.ok());
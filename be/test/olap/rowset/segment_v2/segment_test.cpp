@@ -22,6 +22,8 @@
 #include <boost/filesystem.hpp>
 #include <functional>
 #include <iostream>
+#include <map>
+#include <set>
 
 #include "common/logging.h"
 #include "gutil/strings/substitute.h"
@@ -29,6 +31,7 @@
 #include "olap/fs/block_manager.h"
 #include "olap/fs/fs_util.h"
 #include "olap/in_list_predicate.h"
+#include "olap/null_predicate.h"
 #include "olap/olap_common.h"
 #include "olap/row_block.h"
 #include "olap/row_block2.h"
@@ -42,6 +45,14 @@
 #include "runtime/mem_tracker.h"
 #include "util/file_utils.h"
 #include "test_util/test_util.h"
+#include "vec/columns/column_low_cardinality.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
+#include "vec/common/assert_cast.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_string.h"
+#include "vec/data_types/data_types_number.h"
 
 namespace doris {
 namespace segment_v2 {
@@ -1156,6 +1167,224 @@ TEST_F(SegmentReaderWriterTest, TestBloomFilterIndexUniqueModel) {
     ASSERT_TRUE(column_contains_index(seg2->footer().columns(3), BLOOM_FILTER_INDEX));
 }
 
+// the value of row n of a nullable string column, which may be a low cardinality one
+static std::string nullable_string_at(const vectorized::IColumn& column, size_t n) {
+    if (column.lowCardinality()) {
+        const auto& low_cardinality =
+                assert_cast<const vectorized::ColumnLowCardinality&>(column);
+        return nullable_string_at(low_cardinality.getDictionary(), low_cardinality.getCode(n));
+    }
+    const auto& nullable = assert_cast<const vectorized::ColumnNullable&>(column);
+    return nullable.getNestedColumn().getDataAt(n).toString();
+}
+
+TEST_F(SegmentReaderWriterTest, TestStringDictCodes) {
+    TabletColumn v1 = create_varchar_key(2);
+    v1._is_key = false;
+    v1._aggregation = OLAP_FIELD_AGGREGATION_NONE;
+    v1._length = 256;
+    TabletSchema tablet_schema = create_schema({create_int_key(1, false), v1});
+
+    // the values of v1 in a segment, k1 is the row id
+    struct SegmentValues {
+        std::vector<std::string> values;
+        std::vector<bool> is_null;
+
+        void append_low_cardinality(size_t num_rows) {
+            for (size_t i = 0; i < num_rows; ++i) {
+                size_t rid = values.size();
+                values.push_back("value_" + std::to_string(rid % 7));
+                is_null.push_back(rid % 5 == 0);
+            }
+        }
+
+        void append_distinct(size_t num_rows) {
+            for (size_t i = 0; i < num_rows; ++i) {
+                size_t rid = values.size();
+                values.push_back("distinct_" + std::to_string(rid) + std::string(200, 'x'));
+                is_null.push_back(false);
+            }
+        }
+    };
+    std::vector<SegmentValues> segment_values(2);
+    // all the values of the first segment are in its dictionary
+    segment_values[0].append_low_cardinality(3000);
+    // the distinct values fill the 1MB dictionary of the second segment, the pages after it
+    // are plain encoded
+    segment_values[1].append_low_cardinality(2048);
+    segment_values[1].append_distinct(5500);
+    segment_values[1].append_low_cardinality(3000);
+
+    std::vector<shared_ptr<Segment>> segments(2);
+    for (int i = 0; i < 2; ++i) {
+        const SegmentValues& data = segment_values[i];
+        ValueGenerator generator = [&data](size_t rid, int cid, int block_id,
+                                           RowCursorCell& cell) {
+            if (cid == 0) {
+                cell.set_not_null();
+                *(int*)(cell.mutable_cell_ptr()) = rid;
+            } else if (data.is_null[rid]) {
+                cell.set_null();
+            } else {
+                cell.set_not_null();
+                *reinterpret_cast<Slice*>(cell.mutable_cell_ptr()) = Slice(data.values[rid]);
+            }
+        };
+        build_segment(SegmentWriterOptions(), tablet_schema, tablet_schema,
+                      data.values.size(), generator, &segments[i]);
+    }
+
+    auto string_type = vectorized::makeNullable(std::make_shared<vectorized::DataTypeString>());
+    // v1 is read as codes, like the vectorized scanner does
+    auto create_vec_block = [&string_type]() {
+        vectorized::ColumnPtr dictionary = string_type->createColumn();
+        return vectorized::Block(
+                {{vectorized::ColumnInt32::create(),
+                  std::make_shared<vectorized::DataTypeInt32>(), "k1"},
+                 {vectorized::ColumnLowCardinality::create(dictionary,
+                                                           vectorized::ColumnUInt32::create()),
+                  string_type, "v1"}});
+    };
+
+    // the rows from offset of vec_block are the rows rids of data
+    auto check_rows = [](const vectorized::Block& vec_block, size_t offset,
+                         const SegmentValues& data, const std::vector<size_t>& rids) {
+        ASSERT_EQ(offset + rids.size(), vec_block.rows());
+        const auto& k1 = vec_block.getByPosition(0).column;
+        const auto& v1 = vec_block.getByPosition(1).column;
+        for (size_t i = 0; i < rids.size(); ++i) {
+            size_t rid = rids[i];
+            ASSERT_EQ(static_cast<int64_t>(rid), k1->getInt(offset + i));
+            ASSERT_EQ(data.is_null[rid], v1->isNullAt(offset + i));
+            if (!data.is_null[rid]) {
+                ASSERT_EQ(data.values[rid], nullable_string_at(*v1, offset + i));
+            }
+        }
+    };
+
+    // the rows are grouped by their codes, each group key is decoded once from the dictionary
+    auto check_groups = [](const vectorized::Block& vec_block, const SegmentValues& data,
+                           const std::vector<size_t>& rids) {
+        std::map<std::string, size_t> expected_groups;
+        size_t expected_nulls = 0;
+        for (size_t rid : rids) {
+            if (data.is_null[rid]) {
+                ++expected_nulls;
+            } else {
+                ++expected_groups[data.values[rid]];
+            }
+        }
+
+        const auto& low_cardinality = assert_cast<const vectorized::ColumnLowCardinality&>(
+                *vec_block.getByPosition(1).column);
+        std::map<vectorized::UInt32, size_t> code_counts;
+        for (auto code : low_cardinality.getCodes()) {
+            ++code_counts[code];
+        }
+        const auto& dictionary = low_cardinality.getDictionary();
+        std::map<std::string, size_t> groups;
+        size_t nulls = 0;
+        for (const auto& [code, count] : code_counts) {
+            if (dictionary.isNullAt(code)) {
+                nulls += count;
+                continue;
+            }
+            // a value has a single code
+            ASSERT_TRUE(groups.emplace(nullable_string_at(dictionary, code), count).second);
+        }
+        ASSERT_EQ(expected_nulls, nulls);
+        ASSERT_EQ(expected_groups, groups);
+    };
+
+    Schema schema(tablet_schema);
+    // like BetaRowsetReader, the same block reads the segments one after the other
+    RowBlockV2 block(schema, 1024);
+    auto scan = [&](const std::vector<ColumnPredicate*>& predicates,
+                    const std::function<bool(const SegmentValues&, size_t)>& filter) {
+        // the rows of both segments, the codes of their dictionaries can not be mixed
+        vectorized::Block all_rows = create_vec_block();
+        for (int i = 0; i < 2; ++i) {
+            const SegmentValues& data = segment_values[i];
+            OlapReaderStatistics stats;
+            StorageReadOptions read_opts;
+            read_opts.column_predicates = predicates;
+            read_opts.stats = &stats;
+            std::unique_ptr<RowwiseIterator> iter;
+            ASSERT_TRUE(segments[i]->new_iterator(schema, read_opts, &iter).ok());
+
+            size_t num_previous_rows = all_rows.rows();
+            vectorized::Block segment_rows = create_vec_block();
+            int batches_with_codes = 0;
+            int batches_without_codes = 0;
+            while (true) {
+                block.clear();
+                Status st = iter->next_batch(&block);
+                if (st.is_end_of_file()) {
+                    break;
+                }
+                ASSERT_TRUE(st.ok());
+                if (block.column_block(1).vector_batch()->has_dict_codes()) {
+                    ++batches_with_codes;
+                } else {
+                    ++batches_without_codes;
+                }
+                ASSERT_TRUE(block.convert_to_vec_block(&segment_rows).ok());
+                ASSERT_TRUE(block.convert_to_vec_block(&all_rows).ok());
+            }
+
+            std::vector<size_t> rids;
+            for (size_t rid = 0; rid < data.values.size(); ++rid) {
+                if (filter(data, rid)) {
+                    rids.push_back(rid);
+                }
+            }
+            ASSERT_FALSE(rids.empty());
+            ASSERT_EQ(static_cast<int64_t>(data.values.size() - rids.size()),
+                      stats.rows_vec_cond_filtered);
+            check_rows(segment_rows, 0, data, rids);
+            check_rows(all_rows, num_previous_rows, data, rids);
+            if (i == 0) {
+                ASSERT_EQ(0, batches_without_codes);
+                ASSERT_TRUE(segment_rows.getByPosition(1).column->lowCardinality());
+                ASSERT_TRUE(all_rows.getByPosition(1).column->lowCardinality());
+                check_groups(segment_rows, data, rids);
+            } else {
+                // the values of the plain encoded pages are decoded
+                ASSERT_GT(batches_with_codes, 0);
+                ASSERT_GT(batches_without_codes, 0);
+                ASSERT_FALSE(segment_rows.getByPosition(1).column->lowCardinality());
+                ASSERT_FALSE(all_rows.getByPosition(1).column->lowCardinality());
+            }
+        }
+    };
+
+    // select k1, v1
+    scan({}, [](const SegmentValues& data, size_t rid) { return true; });
+
+    // select k1, v1 where v1 in ('value_1', 'value_3', a distinct value of the dictionary,
+    // one of the plain encoded distinct values)
+    {
+        std::set<std::string> in_values = {"value_1", "value_3", segment_values[1].values[2100],
+                                           segment_values[1].values[7547]};
+        std::set<StringValue> values;
+        for (const auto& value : in_values) {
+            values.emplace(value);
+        }
+        std::unique_ptr<ColumnPredicate> predicate(
+                new InListPredicate<StringValue>(1, std::move(values)));
+        scan({predicate.get()}, [&in_values](const SegmentValues& data, size_t rid) {
+            return !data.is_null[rid] && in_values.count(data.values[rid]) > 0;
+        });
+    }
+
+    // select k1, v1 where v1 is null
+    {
+        std::unique_ptr<ColumnPredicate> predicate(new NullPredicate(1, true));
+        scan({predicate.get()},
+             [](const SegmentValues& data, size_t rid) { return data.is_null[rid]; });
+    }
+}
+
 } // namespace segment_v2
 } // namespace doris
 
@@ -35,10 +35,13 @@
 #include "runtime/row_batch.h"
 #include "runtime/tuple_row.h"
 #include "util/thrift_util.h"
+#include "vec/core/block.h"
 
 namespace doris {
 
 std::unordered_map<int64_t, int> _k_tablet_recorder;
+// the (c1, c2) of the rows of the blocks written to each tablet
+std::unordered_map<int64_t, std::vector<std::pair<int64_t, int64_t>>> _k_tablet_block_rows;
 OLAPStatus open_status;
 OLAPStatus add_status;
 OLAPStatus close_status;
@@ -73,6 +76,15 @@ OLAPStatus DeltaWriter::write(Tuple* tuple) {
     return add_status;
 }
 
+OLAPStatus DeltaWriter::write(const vectorized::Block* block) {
+    for (size_t i = 0; i < block->rows(); ++i) {
+        _k_tablet_block_rows[_req.tablet_id].emplace_back(
+                (*block->getByPosition(0).column)[i].get<vectorized::Int64>(),
+                (*block->getByPosition(1).column)[i].get<vectorized::Int64>());
+    }
+    return add_status;
+}
+
 OLAPStatus DeltaWriter::close() {
     return OLAP_SUCCESS;
 }
@@ -106,6 +118,7 @@ public:
     virtual ~LoadChannelMgrTest() {}
     void SetUp() override {
         _k_tablet_recorder.clear();
+        _k_tablet_block_rows.clear();
         open_status = OLAP_SUCCESS;
         add_status = OLAP_SUCCESS;
         close_status = OLAP_SUCCESS;
@@ -601,6 +614,94 @@ TEST_F(LoadChannelMgrTest, unknown_tablet) {
     }
 }
 
+TEST_F(LoadChannelMgrTest, add_block) {
+    ExecEnv env;
+    LoadChannelMgr mgr;
+    mgr.init(-1);
+
+    auto tdesc_tbl = create_descriptor_table();
+    ObjectPool obj_pool;
+    DescriptorTbl* desc_tbl = nullptr;
+    DescriptorTbl::create(&obj_pool, tdesc_tbl, &desc_tbl);
+    auto tuple_desc = desc_tbl->get_tuple_descriptor(0);
+    PUniqueId load_id;
+    load_id.set_hi(2);
+    load_id.set_lo(3);
+    {
+        PTabletWriterOpenRequest request;
+        request.set_allocated_id(&load_id);
+        request.set_index_id(4);
+        request.set_txn_id(1);
+        create_schema(desc_tbl, request.mutable_schema());
+        for (int i = 0; i < 3; ++i) {
+            auto tablet = request.add_tablets();
+            tablet->set_partition_id(10 + i);
+            tablet->set_tablet_id(20 + i);
+        }
+        request.set_num_senders(1);
+        request.set_need_gen_rollup(false);
+        request.set_is_vectorized(true);
+        auto st = mgr.open(request);
+        request.release_id();
+        ASSERT_TRUE(st.ok());
+    }
+
+    // the rows of a block, and the tablets they go to
+    auto add_block = [&](const std::vector<std::pair<int64_t, int64_t>>& rows,
+                         const std::vector<int64_t>& tablet_ids, int64_t packet_seq,
+                         bool eos) {
+        vectorized::Block block;
+        for (auto slot_desc : tuple_desc->slots()) {
+            block.insert({slot_desc->get_empty_mutable_column(), slot_desc->get_data_type_ptr(),
+                          slot_desc->col_name()});
+        }
+        auto columns = block.mutateColumns();
+        for (const auto& row : rows) {
+            columns[0]->insert(vectorized::Field(row.first));
+            columns[1]->insert(vectorized::Field(row.second));
+        }
+        block.setColumns(std::move(columns));
+
+        PTabletWriterAddBatchRequest request;
+        request.set_allocated_id(&load_id);
+        request.set_index_id(4);
+        request.set_sender_id(0);
+        request.set_eos(eos);
+        request.set_packet_seq(packet_seq);
+        for (int64_t tablet_id : tablet_ids) {
+            request.add_tablet_ids(tablet_id);
+        }
+        size_t uncompressed_bytes = 0;
+        size_t compressed_bytes = 0;
+        EXPECT_TRUE(block.serialize(request.mutable_block(), &uncompressed_bytes,
+                                    &compressed_bytes)
+                            .ok());
+        google::protobuf::RepeatedPtrField<PTabletInfo> tablet_vec;
+        auto st = mgr.add_batch(request, &tablet_vec);
+        request.release_id();
+        return st;
+    };
+
+    // the block is split by tablet, the rows of each keep their order
+    ASSERT_TRUE(add_block({{1, 10}, {2, 20}, {3, 30}, {4, 40}, {5, 50}}, {21, 20, 21, 22, 21}, 0,
+                          false)
+                        .ok());
+    ASSERT_EQ(std::vector<std::pair<int64_t, int64_t>>({{2, 20}}), _k_tablet_block_rows[20]);
+    ASSERT_EQ(std::vector<std::pair<int64_t, int64_t>>({{1, 10}, {3, 30}, {5, 50}}),
+              _k_tablet_block_rows[21]);
+    ASSERT_EQ(std::vector<std::pair<int64_t, int64_t>>({{4, 40}}), _k_tablet_block_rows[22]);
+    ASSERT_EQ(0, _k_tablet_recorder.size());
+
+    // all the rows of a block go to one tablet
+    ASSERT_TRUE(add_block({{6, 60}, {7, 70}}, {20, 20}, 1, false).ok());
+    ASSERT_EQ(std::vector<std::pair<int64_t, int64_t>>({{2, 20}, {6, 60}, {7, 70}}),
+              _k_tablet_block_rows[20]);
+    ASSERT_EQ(3, _k_tablet_block_rows[21].size());
+
+    // a tablet of another channel
+    ASSERT_FALSE(add_block({{8, 80}, {9, 90}}, {20, 23}, 2, true).ok());
+}
+
 TEST_F(LoadChannelMgrTest, duplicate_packet) {
     ExecEnv env;
     LoadChannelMgr mgr;
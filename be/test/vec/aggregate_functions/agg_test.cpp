@@ -4,6 +4,7 @@
 #include "gtest/gtest.h"
 #include "vec/aggregate_functions/aggregate_function.h"
 #include "vec/aggregate_functions/aggregate_function_simple_factory.h"
+#include "vec/columns/column_string.h"
 #include "vec/columns/column_vector.h"
 #include "vec/data_types/data_type.h"
 #include "vec/data_types/data_types_number.h"
@@ -37,6 +38,57 @@ TEST(AggTest, basic_test) {
     ASSERT_EQ(ans, *(int32_t*)place);
     agg_function->destroy(place);
 }
+
+TEST(AggTest, serialize_merge_test) {
+    auto column_vector_int32 = ColumnVector<Int32>::create();
+    for (int i = 0; i < 4096; i++) {
+        column_vector_int32->insert(castToNearestFieldType(i));
+    }
+    AggregateFunctionSimpleFactory factory;
+    registerAggregateFunctionSum(factory);
+    DataTypes data_types = {std::make_shared<DataTypeInt32>()};
+    Array array;
+    auto agg_function = factory.get("sum", data_types, array);
+
+    // two partial states, each one sees half of the rows
+    std::unique_ptr<char[]> partial_states[2];
+    const IColumn* column[1] = {column_vector_int32.get()};
+    for (int i = 0; i < 2; i++) {
+        partial_states[i].reset(new char[agg_function->sizeOfData()]);
+        agg_function->create(partial_states[i].get());
+    }
+    for (int i = 0; i < 4096; i++) {
+        agg_function->add(partial_states[i % 2].get(), column, i, nullptr);
+    }
+
+    auto serialized = ColumnString::create();
+    auto& chars = serialized->getChars();
+    VectorBufferWriter<ColumnString::Chars> writer(chars);
+    for (int i = 0; i < 2; i++) {
+        agg_function->serialize(partial_states[i].get(), writer);
+        chars.push_back(0);
+        serialized->getOffsets().push_back(chars.size());
+        agg_function->destroy(partial_states[i].get());
+    }
+    ASSERT_EQ(2, serialized->size());
+
+    std::unique_ptr<char[]> place(new char[agg_function->sizeOfData()]);
+    std::unique_ptr<char[]> tmp_place(new char[agg_function->sizeOfData()]);
+    agg_function->create(place.get());
+    for (int i = 0; i < 2; i++) {
+        BufferReadable reader(serialized->getDataAt(i));
+        agg_function->create(tmp_place.get());
+        agg_function->deserialize(tmp_place.get(), reader, nullptr);
+        ASSERT_TRUE(reader.eof());
+        agg_function->merge(place.get(), tmp_place.get(), nullptr);
+        agg_function->destroy(tmp_place.get());
+    }
+
+    auto result = ColumnVector<Int64>::create();
+    agg_function->insertResultInto(place.get(), *result);
+    ASSERT_EQ(4096 * 4095 / 2, result->getData()[0]);
+    agg_function->destroy(place.get());
+}
 } // namespace doris::vectorized
 
 int main(int argc, char** argv) {
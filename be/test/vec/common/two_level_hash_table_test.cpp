@@ -0,0 +1,107 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/common/hash_table/two_level_hash_map.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "vec/common/aggregation_common.h"
+#include "vec/common/arena.h"
+#include "vec/common/hash_table/hash_table_key_holder.h"
+
+namespace doris::vectorized {
+
+TEST(TwoLevelHashTableTest, EmplaceAndFind) {
+    TwoLevelHashMap<UInt64, UInt64, HashCRC32<UInt64>> map;
+    for (UInt64 i = 0; i < 10000; ++i) {
+        map[i] = i * 2;
+    }
+    ASSERT_EQ(10000, map.size());
+
+    for (UInt64 i = 0; i < 10000; ++i) {
+        auto it = map.find(i);
+        ASSERT_TRUE(it != nullptr);
+        ASSERT_EQ(i * 2, *lookupResultGetMapped(it));
+    }
+    ASSERT_TRUE(map.find(10000) == nullptr);
+
+    size_t count = 0;
+    UInt64 sum = 0;
+    map.forEachValue([&](const UInt64& key, UInt64& mapped) {
+        ++count;
+        sum += mapped - key;
+    });
+    ASSERT_EQ(10000, count);
+    ASSERT_EQ(10000 * 9999 / 2, sum);
+
+    // the keys are spread over the buckets
+    size_t non_empty_buckets = 0;
+    for (size_t i = 0; i < map.NUM_BUCKETS; ++i) {
+        non_empty_buckets += !map.impls[i].empty();
+    }
+    ASSERT_EQ(map.NUM_BUCKETS, non_empty_buckets);
+}
+
+TEST(TwoLevelHashTableTest, ConvertFromSingleLevel) {
+    HashMapWithSavedHash<StringRef, UInt64> single_level;
+    std::vector<std::string> keys;
+    for (int i = 0; i < 5000; ++i) {
+        keys.push_back("key_" + std::to_string(i));
+    }
+    // the empty string is the zero key, which is stored apart from the buffer
+    keys.emplace_back("");
+
+    for (size_t i = 0; i < keys.size(); ++i) {
+        single_level[StringRef(keys[i])] = i;
+    }
+
+    TwoLevelHashMapWithSavedHash<StringRef, UInt64> two_level(single_level);
+    ASSERT_EQ(single_level.size(), two_level.size());
+
+    for (size_t i = 0; i < keys.size(); ++i) {
+        auto it = two_level.find(StringRef(keys[i]));
+        ASSERT_TRUE(it != nullptr);
+        ASSERT_EQ(i, *lookupResultGetMapped(it));
+    }
+
+    size_t count = 0;
+    for (auto it = two_level.begin(); it != two_level.end(); ++it) {
+        ++count;
+    }
+    ASSERT_EQ(keys.size(), count);
+
+    // keep inserting after the conversion
+    Arena arena;
+    std::string new_key = "key_5000";
+    TwoLevelHashMapWithSavedHash<StringRef, UInt64>::LookupResult it;
+    bool inserted = false;
+    two_level.emplace(ArenaKeyHolder {StringRef(new_key), arena}, it, inserted);
+    ASSERT_TRUE(inserted);
+    two_level.emplace(ArenaKeyHolder {StringRef(keys[0]), arena}, it, inserted);
+    ASSERT_FALSE(inserted);
+    ASSERT_EQ(keys.size() + 1, two_level.size());
+}
+
+} // namespace doris::vectorized
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -19,12 +19,22 @@
 
 #include <gtest/gtest.h>
 
+#include <cstring>
+#include <functional>
 #include <iostream>
 #include <string>
 
+#include "common/config.h"
 #include "exec/schema_scanner.h"
+#include "gen_cpp/data.pb.h"
 #include "runtime/row_batch.h"
 #include "runtime/tuple_row.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/columns_number.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_string.h"
+#include "vec/data_types/data_types_number.h"
 
 namespace doris {
 
@@ -142,6 +152,118 @@ TEST(BlockTest, RowBatchCovertToBlock) {
     }
 }
 
+TEST(BlockTest, SerializeAndDeserializeBlock) {
+    auto int_type = std::make_shared<vectorized::DataTypeInt32>();
+    auto string_type = vectorized::makeNullable(std::make_shared<vectorized::DataTypeString>());
+    auto int_column = int_type->createColumn();
+    auto string_column = string_type->createColumn();
+    for (int i = 0; i < 1024; ++i) {
+        int_column->insert(vectorized::Field(vectorized::Int64(i)));
+        if (i % 7 == 0) {
+            string_column->insertData(nullptr, 0);
+        } else {
+            auto str = std::to_string(i % 10);
+            string_column->insertData(str.data(), str.size());
+        }
+    }
+    vectorized::Block block({{std::move(int_column), int_type, "k1"},
+                             {std::move(string_column), string_type, "k2"}});
+
+    for (bool compress : {false, true}) {
+        config::compress_rowbatches = compress;
+        PBlock pblock;
+        size_t uncompressed_bytes = 0;
+        size_t compressed_bytes = 0;
+        ASSERT_TRUE(block.serialize(&pblock, &uncompressed_bytes, &compressed_bytes).ok());
+        ASSERT_EQ(1024, pblock.num_rows());
+        if (compress) {
+            // the repeated strings compress well
+            ASSERT_LT(compressed_bytes, uncompressed_bytes);
+        } else {
+            ASSERT_EQ(compressed_bytes, uncompressed_bytes);
+        }
+
+        vectorized::Block received = block.cloneEmpty();
+        ASSERT_TRUE(received.deserialize(pblock).ok());
+        ASSERT_EQ(1024, received.rows());
+        for (size_t i = 0; i < block.columns(); ++i) {
+            const auto& column = *block.getByPosition(i).column;
+            const auto& received_column = *received.getByPosition(i).column;
+            for (size_t j = 0; j < 1024; ++j) {
+                ASSERT_EQ(0, column.compareAt(j, j, received_column, 1));
+            }
+        }
+    }
+    config::compress_rowbatches = true;
+}
+
+TEST(BlockTest, DeserializeCorruptedBlock) {
+    auto int_type = std::make_shared<vectorized::DataTypeInt32>();
+    auto string_type = vectorized::makeNullable(std::make_shared<vectorized::DataTypeString>());
+    auto int_column = int_type->createColumn();
+    auto string_column = string_type->createColumn();
+    for (int i = 0; i < 100; ++i) {
+        int_column->insert(vectorized::Field(vectorized::Int64(i)));
+        auto str = std::to_string(i);
+        string_column->insertData(str.data(), str.size());
+    }
+    vectorized::Block block({{std::move(int_column), int_type, "k1"},
+                             {std::move(string_column), string_type, "k2"}});
+
+    config::compress_rowbatches = false;
+    PBlock pblock;
+    size_t uncompressed_bytes = 0;
+    size_t compressed_bytes = 0;
+    ASSERT_TRUE(block.serialize(&pblock, &uncompressed_bytes, &compressed_bytes).ok());
+    config::compress_rowbatches = true;
+    ASSERT_FALSE(pblock.columns(0).has_uncompressed_size());
+    {
+        vectorized::Block received = block.cloneEmpty();
+        ASSERT_TRUE(received.deserialize(pblock).ok());
+    }
+
+    auto expect_corruption = [&](const std::function<void(PBlock*)>& corrupt) {
+        PBlock corrupted = pblock;
+        corrupt(&corrupted);
+        vectorized::Block received = block.cloneEmpty();
+        Status st = received.deserialize(corrupted);
+        ASSERT_EQ(TStatusCode::CORRUPTION, st.code()) << st.to_string();
+    };
+    auto set_uint64 = [](std::string* data, size_t pos, uint64_t value) {
+        memcpy(data->data() + pos, &value, sizeof(value));
+    };
+    // the values are truncated
+    expect_corruption([](PBlock* b) { b->mutable_columns(0)->mutable_data()->resize(100); });
+    expect_corruption([](PBlock* b) { b->mutable_columns(1)->mutable_data()->resize(4); });
+    // some bytes follow the values
+    expect_corruption([](PBlock* b) { b->mutable_columns(0)->mutable_data()->append("x"); });
+    // the number of rows is greater than the values
+    expect_corruption([&](PBlock* b) {
+        set_uint64(b->mutable_columns(0)->mutable_data(), 0, 101);
+    });
+    expect_corruption([&](PBlock* b) {
+        set_uint64(b->mutable_columns(0)->mutable_data(), 0, ~uint64_t(0));
+    });
+    expect_corruption([&](PBlock* b) {
+        set_uint64(b->mutable_columns(1)->mutable_data(), 0, ~uint64_t(0) / 2);
+    });
+    // the null map and the nested strings, which follow it, are of different numbers of rows
+    size_t nested_pos = sizeof(uint64_t) + 100;
+    expect_corruption([&](PBlock* b) {
+        set_uint64(b->mutable_columns(1)->mutable_data(), nested_pos, 99);
+    });
+    // an offset of the nested strings is after the chars
+    size_t offsets_pos = nested_pos + sizeof(uint64_t);
+    expect_corruption([&](PBlock* b) {
+        set_uint64(b->mutable_columns(1)->mutable_data(), offsets_pos, 1 << 20);
+    });
+    // the size of the chars is not the last offset
+    size_t chars_size_pos = offsets_pos + 100 * sizeof(vectorized::IColumn::Offset);
+    expect_corruption([&](PBlock* b) {
+        set_uint64(b->mutable_columns(1)->mutable_data(), chars_size_pos, 1);
+    });
+}
+
 } // namespace doris
 
 int main(int argc, char** argv) {
@@ -0,0 +1,142 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/columns/column_low_cardinality.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "vec/columns/column_string.h"
+#include "vec/columns/columns_number.h"
+#include "vec/common/arena.h"
+#include "vec/common/columns_hashing.h"
+#include "vec/common/exception.h"
+#include "vec/common/hash_table/hash_map.h"
+
+namespace doris::vectorized {
+
+static ColumnPtr create_string_column(const std::vector<std::string>& values) {
+    auto column = ColumnString::create();
+    for (const auto& value : values) {
+        column->insertData(value.data(), value.size());
+    }
+    return column;
+}
+
+static ColumnPtr create_low_cardinality_column(const ColumnPtr& dictionary,
+                                               const std::vector<UInt32>& codes) {
+    auto codes_column = ColumnUInt32::create();
+    for (auto code : codes) {
+        codes_column->insertValue(code);
+    }
+    return ColumnLowCardinality::create(dictionary, std::move(codes_column));
+}
+
+static std::vector<std::string> string_values(const IColumn& column) {
+    std::vector<std::string> res;
+    for (size_t i = 0; i < column.size(); ++i) {
+        res.push_back(column.getDataAt(i).toString());
+    }
+    return res;
+}
+
+TEST(ColumnLowCardinalityTest, RowsOfCodes) {
+    // the values of a dictionary are not necessarily unique
+    auto dictionary = create_string_column({"b", "a", "c", "a"});
+    auto column = create_low_cardinality_column(dictionary, {0, 1, 2, 3, 1, 0});
+    ASSERT_TRUE(column->lowCardinality());
+    ASSERT_EQ(6, column->size());
+
+    auto full_column = column->convertToFullColumnIfLowCardinality();
+    ASSERT_FALSE(full_column->lowCardinality());
+    std::vector<std::string> expected {"b", "a", "c", "a", "a", "b"};
+    ASSERT_EQ(expected, string_values(*full_column));
+    ASSERT_EQ(expected, string_values(*column));
+
+    IColumn::Filter filter {1, 0, 1, 1, 0, 0};
+    auto filtered = column->filter(filter, -1);
+    ASSERT_TRUE(filtered->lowCardinality());
+    ASSERT_EQ(std::vector<std::string>({"b", "c", "a"}), string_values(*filtered));
+
+    // the rows of equal values are equal whatever their codes
+    ASSERT_EQ(0, column->compareAt(1, 3, *column, 1));
+    ASSERT_EQ(0, column->compareAt(0, 5, *column, 1));
+    ASSERT_LT(column->compareAt(1, 0, *column, 1), 0);
+    ASSERT_GT(column->compareAt(2, 0, *full_column, 1), 0);
+
+    IColumn::Permutation perm;
+    column->getPermutation(false, 0, 1, perm);
+    std::vector<std::string> sorted;
+    for (auto row : perm) {
+        sorted.push_back(column->getDataAt(row).toString());
+    }
+    ASSERT_EQ(std::vector<std::string>({"a", "a", "a", "b", "b", "c"}), sorted);
+
+    // only the rows of the same dictionary can be inserted
+    auto mutable_column = column->cloneEmpty();
+    mutable_column->insertRangeFrom(*column, 2, 3);
+    ASSERT_EQ(std::vector<std::string>({"c", "a", "a"}), string_values(*mutable_column));
+    auto other = create_low_cardinality_column(create_string_column({"b"}), {0});
+    ASSERT_THROW(mutable_column->insertFrom(*other, 0), Exception);
+}
+
+TEST(ColumnLowCardinalityTest, EmplaceCodesIntoHashTable) {
+    using Data = HashMapWithSavedHash<StringRef, UInt64*>;
+    using State = ColumnsHashing::HashMethodSingleLowCardinalityColumn<
+            ColumnsHashing::HashMethodString<Data::value_type, UInt64*>, UInt64*>;
+
+    Data data;
+    Arena arena;
+    std::vector<UInt64> counts(4);
+    size_t groups = 0;
+    auto emplace_rows = [&](const ColumnPtr& column) {
+        ColumnRawPtrs key_columns {column.get()};
+        State state(key_columns, {}, nullptr);
+        for (size_t i = 0; i < column->size(); ++i) {
+            auto emplace_result = state.emplaceKey(data, i, arena);
+            if (emplace_result.isInserted()) {
+                emplace_result.setMapped(&counts[groups++]);
+            }
+            ++*emplace_result.getMapped();
+        }
+    };
+
+    // the blocks of two dictionaries
+    emplace_rows(create_low_cardinality_column(create_string_column({"b", "a", "c", "a"}),
+                                               {0, 1, 2, 3, 1, 0, 0}));
+    emplace_rows(create_low_cardinality_column(create_string_column({"d", "c"}), {1, 0, 1}));
+    // the rows of a full column are the dictionary of its block
+    emplace_rows(ColumnLowCardinality::createFromFullColumn(create_string_column({"a", "d"})));
+
+    ASSERT_EQ(4, data.size());
+    auto count_of = [&](const std::string& key) {
+        return **lookupResultGetMapped(data.find(StringRef(key)));
+    };
+    ASSERT_EQ(4, count_of("a"));
+    ASSERT_EQ(3, count_of("b"));
+    ASSERT_EQ(3, count_of("c"));
+    ASSERT_EQ(2, count_of("d"));
+}
+
+} // namespace doris::vectorized
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,190 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/core/sort_block.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/columns_number.h"
+#include "vec/common/loser_tree.h"
+#include "vec/core/sort_cursor.h"
+#include "vec/data_types/data_types_number.h"
+#include "vec/data_types/data_type_string.h"
+
+namespace doris::vectorized {
+
+static ColumnPtr create_nullable_int_column(const std::vector<int>& values,
+                                            const std::vector<uint8_t>& nulls) {
+    auto nested = ColumnInt32::create();
+    auto null_map = ColumnUInt8::create();
+    for (size_t i = 0; i < values.size(); ++i) {
+        nested->insert(Field(Int64(values[i])));
+        null_map->insert(Field(UInt64(nulls[i])));
+    }
+    return ColumnNullable::create(std::move(nested), std::move(null_map));
+}
+
+// the values of a nullable int column, -1 for the nulls
+static std::vector<int> nullable_values(const IColumn& column, const IColumn::Permutation& perm,
+                                        size_t limit) {
+    const auto& nullable = assert_cast<const ColumnNullable&>(column);
+    const auto& nested = assert_cast<const ColumnInt32&>(nullable.getNestedColumn());
+    std::vector<int> res;
+    for (size_t i = 0; i < limit; ++i) {
+        res.push_back(nullable.isNullAt(perm[i]) ? -1 : nested.getData()[perm[i]]);
+    }
+    return res;
+}
+
+TEST(SortBlockTest, NullableGetPermutation) {
+    auto column = create_nullable_int_column({5, 0, 3, 0, 1, 4, 2}, {0, 1, 0, 1, 0, 0, 0});
+    IColumn::Permutation perm;
+
+    // ASC NULLS FIRST
+    column->getPermutation(false, 0, -1, perm);
+    EXPECT_EQ((std::vector<int> {-1, -1, 1, 2, 3, 4, 5}), nullable_values(*column, perm, 7));
+    // ASC NULLS LAST with limit
+    column->getPermutation(false, 3, 1, perm);
+    EXPECT_EQ((std::vector<int> {1, 2, 3}), nullable_values(*column, perm, 3));
+    // DESC NULLS LAST with limit
+    column->getPermutation(true, 6, -1, perm);
+    EXPECT_EQ((std::vector<int> {5, 4, 3, 2, 1, -1}), nullable_values(*column, perm, 6));
+    // DESC NULLS FIRST with limit
+    column->getPermutation(true, 3, 1, perm);
+    EXPECT_EQ((std::vector<int> {-1, -1, 5}), nullable_values(*column, perm, 3));
+}
+
+TEST(SortBlockTest, SortBlockWithLimit) {
+    auto k1 = ColumnInt32::create();
+    auto k2 = ColumnString::create();
+    std::vector<int> k1_values = {2, 1, 2, 1, 3};
+    std::vector<std::string> k2_values = {"b", "z", "c", "a", "a"};
+    for (size_t i = 0; i < k1_values.size(); ++i) {
+        k1->insert(Field(Int64(k1_values[i])));
+        k2->insertData(k2_values[i].data(), k2_values[i].size());
+    }
+    Block block({{std::move(k1), std::make_shared<DataTypeInt32>(), "k1"},
+                 {std::move(k2), std::make_shared<DataTypeString>(), "k2"}});
+
+    // ORDER BY k1 ASC, k2 DESC LIMIT 4
+    SortDescription desc {{0, 1, 1}, {1, -1, -1}};
+    sortBlock(block, desc, 4);
+
+    ASSERT_EQ(4, block.rows());
+    const auto& res_k1 = assert_cast<const ColumnInt32&>(*block.getByPosition(0).column);
+    const auto& res_k2 = assert_cast<const ColumnString&>(*block.getByPosition(1).column);
+    EXPECT_EQ((std::vector<int> {1, 1, 2, 2}),
+              std::vector<int>(res_k1.getData().begin(), res_k1.getData().end()));
+    EXPECT_EQ("z", res_k2.getDataAt(0).toString());
+    EXPECT_EQ("a", res_k2.getDataAt(1).toString());
+    EXPECT_EQ("c", res_k2.getDataAt(2).toString());
+    EXPECT_EQ("b", res_k2.getDataAt(3).toString());
+}
+
+TEST(SortBlockTest, LoserTreeMerge) {
+    std::vector<std::vector<int>> inputs = {{1, 4, 7, 10}, {}, {2, 5, 8}, {0, 3, 6, 9, 11}, {6}};
+    SortDescription desc {{0, 1, 1}};
+    Blocks blocks;
+    for (const auto& values : inputs) {
+        auto column = ColumnInt32::create();
+        for (auto value : values) column->insert(Field(Int64(value)));
+        blocks.emplace_back(ColumnsWithTypeAndName {
+                {std::move(column), std::make_shared<DataTypeInt32>(), "k1"}});
+    }
+
+    std::vector<SortCursorImpl> impls;
+    for (size_t i = 0; i < blocks.size(); ++i) impls.emplace_back(blocks[i], desc, i);
+    std::vector<SortCursor> cursors;
+    for (auto& impl : impls) {
+        if (!impl.empty()) cursors.emplace_back(&impl);
+    }
+
+    LoserTree<SortCursor> tree(cursors);
+    std::vector<int> res;
+    std::vector<size_t> orders;
+    while (!tree.empty()) {
+        auto& cursor = tree.top();
+        const auto& column = assert_cast<const ColumnInt32&>(*cursor->all_columns[0]);
+        res.push_back(column.getData()[cursor->pos]);
+        orders.push_back(cursor->order);
+        if (cursor->isLast()) {
+            tree.removeTop();
+        } else {
+            cursor->next();
+            tree.updateTop();
+        }
+    }
+    EXPECT_EQ((std::vector<int> {0, 1, 2, 3, 4, 5, 6, 6, 7, 8, 9, 10, 11}), res);
+    // the equal rows are ordered by the number of their cursors
+    EXPECT_EQ(3, orders[6]);
+    EXPECT_EQ(4, orders[7]);
+}
+
+TEST(SortBlockTest, LoserTreeSecondTop) {
+    std::vector<std::vector<int>> inputs = {{1, 4, 7, 10}, {2, 5, 8}, {0, 3, 6, 9, 11}, {6}, {4}};
+    std::vector<size_t> positions(inputs.size(), 0);
+    struct IntCursor {
+        const std::vector<std::vector<int>>* inputs;
+        std::vector<size_t>* positions;
+        size_t order;
+        int value() const { return (*inputs)[order][(*positions)[order]]; }
+        bool greater(const IntCursor& rhs) const {
+            return value() != rhs.value() ? value() > rhs.value() : order > rhs.order;
+        }
+    };
+    std::vector<IntCursor> cursors;
+    for (size_t i = 0; i < inputs.size(); ++i) cursors.push_back({&inputs, &positions, i});
+
+    LoserTree<IntCursor> tree(cursors);
+    size_t num_values = 0;
+    while (!tree.empty()) {
+        auto& top = tree.top();
+        // the runner-up is the least of the current rows of the other cursors
+        const IntCursor* expected = nullptr;
+        for (const auto& cursor : cursors) {
+            if (cursor.order == top.order || positions[cursor.order] == inputs[cursor.order].size())
+                continue;
+            if (expected == nullptr || expected->greater(cursor)) expected = &cursor;
+        }
+        auto* second = tree.secondTop();
+        if (expected == nullptr) {
+            EXPECT_EQ(nullptr, second);
+        } else {
+            ASSERT_NE(nullptr, second);
+            EXPECT_EQ(expected->order, second->order);
+        }
+        ++num_values;
+        if (++positions[top.order] == inputs[top.order].size()) {
+            tree.removeTop();
+        } else {
+            tree.updateTop();
+        }
+    }
+    EXPECT_EQ(14, num_values);
+}
+
+} // namespace doris::vectorized
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
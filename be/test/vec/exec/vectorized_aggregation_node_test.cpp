@@ -0,0 +1,639 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/aggregation_node.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "common/config.h"
+#include "common/object_pool.h"
+#include "gen_cpp/Descriptors_types.h"
+#include "gen_cpp/Exprs_types.h"
+#include "gen_cpp/PlanNodes_types.h"
+#include "gen_cpp/Types_types.h"
+#include "runtime/descriptors.h"
+#include "runtime/mem_tracker.h"
+#include "runtime/runtime_state.h"
+#include "runtime/test_env.h"
+#include "util/filesystem_util.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
+#include "vec/common/assert_cast.h"
+#include "vec/data_types/data_types_number.h"
+
+namespace doris::vectorized {
+
+/// Returns the given blocks as its child would.
+class VBlockSourceNode : public ExecNode {
+public:
+    VBlockSourceNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs,
+                     std::vector<Block> blocks)
+            : ExecNode(pool, tnode, descs), _blocks(std::move(blocks)) {}
+
+    Status get_next(RuntimeState* state, RowBatch* row_batch, bool* eos) override {
+        return Status::NotSupported("VBlockSourceNode only returns blocks");
+    }
+
+    Status get_next(RuntimeState* state, Block* block, bool* eos) override {
+        if (_next < _blocks.size()) {
+            *block = _blocks[_next++];
+        }
+        *eos = _next >= _blocks.size();
+        return Status::OK();
+    }
+
+private:
+    std::vector<Block> _blocks;
+    size_t _next = 0;
+};
+
+/// The plans of the tests are sum(v) group by k, of the input tuple (k, v), the intermediate
+/// tuple (k, sum) and the output tuple (k, sum).
+struct AggPlan {
+    PrimitiveType key_type = TYPE_INT;
+    bool key_nullable = false;
+    bool value_nullable = false;
+    bool intermediate_key_nullable = false;
+    bool sum_nullable = false;
+};
+
+class VAggregationNodeTest : public testing::Test {
+public:
+    static constexpr TupleId INPUT_TUPLE = 0;
+    static constexpr TupleId INTERMEDIATE_TUPLE = 1;
+    static constexpr TupleId OUTPUT_TUPLE = 2;
+
+    void SetUp() override {
+        _tmp_dirs = {"/tmp/vaggregation-node-test"};
+        ASSERT_TRUE(FileSystemUtil::create_directory(_tmp_dirs[0]).ok());
+        _env.reset(new TestEnv());
+        _env->init_tmp_file_mgr(_tmp_dirs, false);
+    }
+
+    void TearDown() override {
+        _states.clear();
+        _env.reset();
+        FileSystemUtil::remove_paths(_tmp_dirs);
+    }
+
+protected:
+    void init_desc_tbl(const AggPlan& plan) {
+        _plan = plan;
+        TDescriptorTable t_desc_table;
+        TTableDescriptor t_table_desc;
+        t_table_desc.id = 0;
+        t_table_desc.tableType = TTableType::OLAP_TABLE;
+        t_table_desc.numCols = 0;
+        t_table_desc.numClusteringCols = 0;
+        t_desc_table.tableDescriptors.push_back(t_table_desc);
+        t_desc_table.__isset.tableDescriptors = true;
+
+        auto add_tuple = [&](TupleId tuple_id, bool key_nullable, bool value_nullable,
+                             PrimitiveType value_type) {
+            const int key_size = TypeDescriptor(plan.key_type).get_slot_size();
+            const int value_size = TypeDescriptor(value_type).get_slot_size();
+            int offset = 1;
+            int slot_idx = 0;
+            auto add_slot = [&](PrimitiveType type, int size, bool nullable,
+                                const std::string& name) {
+                TSlotDescriptor t_slot_desc;
+                t_slot_desc.__set_id(tuple_id * 2 + slot_idx);
+                t_slot_desc.__set_parent(tuple_id);
+                t_slot_desc.__set_slotType(TypeDescriptor(type).to_thrift());
+                t_slot_desc.__set_columnPos(slot_idx);
+                t_slot_desc.__set_byteOffset(offset);
+                t_slot_desc.__set_nullIndicatorByte(0);
+                t_slot_desc.__set_nullIndicatorBit(nullable ? slot_idx : -1);
+                t_slot_desc.__set_slotIdx(slot_idx);
+                t_slot_desc.__set_isMaterialized(true);
+                t_slot_desc.__set_colName(name);
+                t_desc_table.slotDescriptors.push_back(t_slot_desc);
+                offset += size;
+                ++slot_idx;
+            };
+            add_slot(plan.key_type, key_size, key_nullable, "k");
+            add_slot(value_type, value_size, value_nullable,
+                     tuple_id == INPUT_TUPLE ? "v" : "sum");
+
+            TTupleDescriptor t_tuple_desc;
+            t_tuple_desc.id = tuple_id;
+            t_tuple_desc.byteSize = offset;
+            t_tuple_desc.numNullBytes = 1;
+            t_tuple_desc.tableId = 0;
+            t_tuple_desc.__isset.tableId = true;
+            t_desc_table.tupleDescriptors.push_back(t_tuple_desc);
+        };
+        add_tuple(INPUT_TUPLE, plan.key_nullable, plan.value_nullable, TYPE_BIGINT);
+        add_tuple(INTERMEDIATE_TUPLE, plan.intermediate_key_nullable, plan.sum_nullable,
+                  TYPE_BIGINT);
+        add_tuple(OUTPUT_TUPLE, plan.intermediate_key_nullable, plan.sum_nullable, TYPE_BIGINT);
+        t_desc_table.__isset.slotDescriptors = true;
+
+        ASSERT_TRUE(DescriptorTbl::create(&_pool, t_desc_table, &_desc_tbl).ok());
+    }
+
+    RuntimeState* create_state(bool enable_spilling, int64_t mem_limit = -1) {
+        TQueryOptions query_options;
+        query_options.__set_enable_spilling(enable_spilling);
+        _states.emplace_back(new RuntimeState(TUniqueId(), query_options, TQueryGlobals(),
+                                              _env->exec_env()));
+        RuntimeState* state = _states.back().get();
+        state->_instance_mem_tracker = MemTracker::CreateTracker(mem_limit, "RuntimeState");
+        state->set_desc_tbl(_desc_tbl);
+        return state;
+    }
+
+    static TExprNode slot_ref(SlotId slot_id, TupleId tuple_id, PrimitiveType type) {
+        TExprNode node;
+        node.__set_node_type(TExprNodeType::SLOT_REF);
+        node.__set_type(TypeDescriptor(type).to_thrift());
+        node.__set_num_children(0);
+        TSlotRef t_slot_ref;
+        t_slot_ref.__set_slot_id(slot_id);
+        t_slot_ref.__set_tuple_id(tuple_id);
+        node.__set_slot_ref(t_slot_ref);
+        return node;
+    }
+
+    // sum(v) of the input tuple, or the merge of the sums of the intermediate tuple
+    static TExpr sum(bool is_merge) {
+        TFunction fn;
+        fn.name.__set_function_name("sum");
+        fn.__set_binary_type(TFunctionBinaryType::BUILTIN);
+        fn.__set_arg_types({TypeDescriptor(TYPE_BIGINT).to_thrift()});
+        fn.__set_ret_type(TypeDescriptor(TYPE_BIGINT).to_thrift());
+        fn.__set_has_var_args(false);
+        TAggregateFunction aggregate_fn;
+        aggregate_fn.__set_intermediate_type(TypeDescriptor(TYPE_BIGINT).to_thrift());
+        fn.__set_aggregate_fn(aggregate_fn);
+
+        TExprNode node;
+        node.__set_node_type(TExprNodeType::AGG_EXPR);
+        node.__set_type(TypeDescriptor(TYPE_BIGINT).to_thrift());
+        node.__set_num_children(1);
+        node.__set_fn(fn);
+        TAggregateExpr agg_expr;
+        agg_expr.__set_is_merge_agg(is_merge);
+        node.__set_agg_expr(agg_expr);
+
+        TExpr expr;
+        TupleId tuple_id = is_merge ? INTERMEDIATE_TUPLE : INPUT_TUPLE;
+        expr.nodes = {node, slot_ref(tuple_id * 2 + 1, tuple_id, TYPE_BIGINT)};
+        return expr;
+    }
+
+    // The aggregation of the rows of child, the blocks of the input tuple, or the serialized
+    // states of the intermediate tuple if is_merge.
+    AggregationNode* create_agg_node(RuntimeState* state, ExecNode* child, bool is_merge,
+                                     bool need_finalize, bool streaming = false) {
+        TPlanNode tnode;
+        tnode.node_id = _next_node_id++;
+        tnode.node_type = TPlanNodeType::AGGREGATION_NODE;
+        tnode.num_children = 1;
+        tnode.limit = -1;
+        tnode.row_tuples.push_back(need_finalize ? OUTPUT_TUPLE : INTERMEDIATE_TUPLE);
+        tnode.nullable_tuples.push_back(false);
+        TupleId tuple_id = is_merge ? INTERMEDIATE_TUPLE : INPUT_TUPLE;
+        tnode.agg_node.__set_grouping_exprs({TExpr()});
+        tnode.agg_node.grouping_exprs[0].nodes = {
+                slot_ref(tuple_id * 2, tuple_id, _plan.key_type)};
+        tnode.agg_node.__set_aggregate_functions({sum(is_merge)});
+        tnode.agg_node.__set_intermediate_tuple_id(INTERMEDIATE_TUPLE);
+        tnode.agg_node.__set_output_tuple_id(OUTPUT_TUPLE);
+        tnode.agg_node.__set_need_finalize(need_finalize);
+        tnode.agg_node.__set_use_streaming_preaggregation(streaming);
+        tnode.__isset.agg_node = true;
+
+        auto node = _pool.add(new AggregationNode(&_pool, tnode, *_desc_tbl));
+        EXPECT_TRUE(node->init(tnode, state).ok());
+        node->_children.push_back(child);
+        return node;
+    }
+
+    ExecNode* create_source_node(TupleId tuple_id, std::vector<Block> blocks) {
+        TPlanNode tnode;
+        tnode.node_id = _next_node_id++;
+        tnode.node_type = TPlanNodeType::EXCHANGE_NODE;
+        tnode.num_children = 0;
+        tnode.limit = -1;
+        tnode.row_tuples.push_back(tuple_id);
+        tnode.nullable_tuples.push_back(false);
+        return _pool.add(new VBlockSourceNode(&_pool, tnode, *_desc_tbl, std::move(blocks)));
+    }
+
+    // blocks of the input tuple, the key of row i is keys[i % keys.size()] and its value i
+    std::vector<Block> create_input(const std::vector<int64_t>& keys, int rows,
+                                    int rows_per_block) {
+        auto key_type = _desc_tbl->get_slot_descriptor(0)->get_data_type_ptr();
+        auto value_type = _desc_tbl->get_slot_descriptor(1)->get_data_type_ptr();
+        std::vector<Block> blocks;
+        for (int begin = 0; begin < rows; begin += rows_per_block) {
+            auto key_column = key_type->createColumn();
+            auto value_column = value_type->createColumn();
+            for (int i = begin; i < std::min(rows, begin + rows_per_block); ++i) {
+                key_column->insert(Field(keys[i % keys.size()]));
+                value_column->insert(Field(Int64(i)));
+            }
+            blocks.emplace_back(Block({{std::move(key_column), key_type, "k"},
+                                       {std::move(value_column), value_type, "v"}}));
+        }
+        return blocks;
+    }
+
+    // The sum of each key of the output of node.
+    static std::map<int64_t, int64_t> collect(RuntimeState* state, ExecNode* node) {
+        std::map<int64_t, int64_t> sums;
+        bool eos = false;
+        while (!eos) {
+            Block block;
+            EXPECT_TRUE(node->get_next(state, &block, &eos).ok());
+            for (size_t i = 0; i < block.rows(); ++i) {
+                int64_t key = (*block.getByPosition(0).column)[i].get<Int64>();
+                EXPECT_EQ(0u, sums.count(key));
+                sums[key] = (*block.getByPosition(1).column)[i].get<Int64>();
+            }
+        }
+        return sums;
+    }
+
+    static std::map<int64_t, int64_t> expected_sums(const std::vector<int64_t>& keys, int rows) {
+        std::map<int64_t, int64_t> sums;
+        for (int i = 0; i < rows; ++i) {
+            sums[keys[i % keys.size()]] += i;
+        }
+        return sums;
+    }
+
+    std::vector<std::string> _tmp_dirs;
+    std::unique_ptr<TestEnv> _env;
+    std::vector<std::unique_ptr<RuntimeState>> _states;
+    ObjectPool _pool;
+    DescriptorTbl* _desc_tbl = nullptr;
+    AggPlan _plan;
+    int _next_node_id = 0;
+};
+
+TEST_F(VAggregationNodeTest, spill_partition) {
+    // the small integer keys are their own hash, the CRC32 hashes only fill the low 32 bits
+    // and the two level hash table buckets by bits 24 to 31
+    std::set<size_t> small_integers;
+    std::set<size_t> low_32_bits;
+    std::set<size_t> bucket_bits;
+    for (size_t i = 0; i < 256; ++i) {
+        small_integers.insert(AggregationNode::_spill_partition(i, 0));
+        low_32_bits.insert(AggregationNode::_spill_partition(intHashCRC32(i), 0));
+        bucket_bits.insert(AggregationNode::_spill_partition(i << 24, 0));
+    }
+    ASSERT_EQ(AggregationNode::SPILL_PARTITION_FANOUT, small_integers.size());
+    ASSERT_EQ(AggregationNode::SPILL_PARTITION_FANOUT, low_32_bits.size());
+    ASSERT_EQ(AggregationNode::SPILL_PARTITION_FANOUT, bucket_bits.size());
+
+    // the groups of a partition are spread over all the partitions of the next level
+    std::vector<size_t> hashes;
+    for (size_t i = 0; hashes.size() < 256; ++i) {
+        if (AggregationNode::_spill_partition(i, 0) == 3) {
+            hashes.push_back(i);
+        }
+    }
+    for (int level = 1; level < AggregationNode::MAX_SPILL_LEVEL; ++level) {
+        std::set<size_t> partitions;
+        for (size_t hash : hashes) {
+            partitions.insert(AggregationNode::_spill_partition(hash, level));
+        }
+        ASSERT_EQ(AggregationNode::SPILL_PARTITION_FANOUT, partitions.size()) << level;
+    }
+}
+
+TEST_F(VAggregationNodeTest, spill) {
+    const int rows = 2000;
+    for (PrimitiveType key_type : {TYPE_TINYINT, TYPE_INT, TYPE_BIGINT}) {
+        init_desc_tbl({key_type});
+        std::vector<int64_t> keys;
+        for (int64_t key = -100; key < 100; ++key) {
+            keys.push_back(key);
+        }
+
+        RuntimeState* state = create_state(false);
+        auto node = create_agg_node(state, create_source_node(INPUT_TUPLE,
+                                                              create_input(keys, rows, 100)),
+                                    false, true);
+        ASSERT_TRUE(node->prepare(state).ok());
+        ASSERT_TRUE(node->open(state).ok());
+        ASSERT_FALSE(node->_spilled);
+        auto in_memory = collect(state, node);
+        ASSERT_TRUE(node->close(state).ok());
+        ASSERT_EQ(expected_sums(keys, rows), in_memory);
+
+        // any memory is over the limit, the groups are spilled after every block
+        RuntimeState* spill_state = create_state(true, 1);
+        auto spill_node = create_agg_node(
+                spill_state,
+                create_source_node(INPUT_TUPLE, create_input(keys, rows, 100)), false, true);
+        ASSERT_TRUE(spill_node->prepare(spill_state).ok());
+        ASSERT_TRUE(spill_node->open(spill_state).ok());
+        ASSERT_EQ(AggregationNode::SPILL_PARTITION_FANOUT,
+                  spill_node->_spilled_partitions.size());
+        ASSERT_GT(spill_node->_spill_count_counter->value(), 1);
+        // the groups are spread over the partitions
+        for (const auto& partition : spill_node->_spilled_partitions) {
+            ASSERT_EQ(0, partition.level);
+            ASSERT_FALSE(partition.stream->empty());
+        }
+        ASSERT_EQ(in_memory, collect(spill_state, spill_node));
+        // no partition fits either, they are spilled again until their groups are alone
+        ASSERT_GT(spill_node->_max_spill_level_counter->value(), 0);
+        ASSERT_LE(spill_node->_max_spill_level_counter->value(),
+                  AggregationNode::MAX_SPILL_LEVEL);
+        ASSERT_TRUE(spill_node->close(spill_state).ok());
+    }
+}
+
+TEST_F(VAggregationNodeTest, spill_flush) {
+    init_desc_tbl({TYPE_INT});
+    const int rows = 2000;
+    std::vector<int64_t> keys;
+    for (int64_t key = 0; key < 200; ++key) {
+        keys.push_back(key);
+    }
+
+    // every group is flushed on its own, a block of 100 rows has 100 groups
+    RuntimeState* state = create_state(true, 1);
+    auto node = create_agg_node(
+            state, create_source_node(INPUT_TUPLE, create_input(keys, rows, 100)), false, true);
+    node->_spill_flush_bytes = 1;
+    ASSERT_TRUE(node->prepare(state).ok());
+    ASSERT_TRUE(node->open(state).ok());
+    ASSERT_EQ(rows / 100, node->_spill_count_counter->value());
+    size_t chunks = 0;
+    for (const auto& partition : node->_spilled_partitions) {
+        chunks += partition.stream->_blocks.size();
+    }
+    ASSERT_EQ(static_cast<size_t>(rows), chunks);
+    ASSERT_EQ(expected_sums(keys, rows), collect(state, node));
+    ASSERT_TRUE(node->close(state).ok());
+}
+
+TEST_F(VAggregationNodeTest, spill_single_group) {
+    init_desc_tbl({TYPE_INT});
+    const int rows = 1000;
+    std::vector<int64_t> keys = {7};
+
+    // the partition of a single group is not spilled again, it can not be split
+    RuntimeState* state = create_state(true, 1);
+    auto node = create_agg_node(
+            state, create_source_node(INPUT_TUPLE, create_input(keys, rows, 100)), false, true);
+    ASSERT_TRUE(node->prepare(state).ok());
+    ASSERT_TRUE(node->open(state).ok());
+    ASSERT_EQ(1, node->_spilled_partitions.size());
+    ASSERT_EQ(expected_sums(keys, rows), collect(state, node));
+    ASSERT_EQ(0, node->_max_spill_level_counter->value());
+    ASSERT_TRUE(node->close(state).ok());
+}
+
+TEST_F(VAggregationNodeTest, streaming_passthrough_nullable_key_slot) {
+    // the key expr is not nullable, the key slot of the intermediate tuple is
+    init_desc_tbl({TYPE_INT, false, false, true, false});
+    const int rows = 100;
+    const std::vector<int64_t> keys {3, 1, 2, 1};
+
+    RuntimeState* state = create_state(false);
+    auto node = create_agg_node(state, create_source_node(INPUT_TUPLE, {}), false, false, true);
+    ASSERT_TRUE(node->_is_streaming_preagg);
+    ASSERT_TRUE(node->prepare(state).ok());
+    ASSERT_TRUE(node->open(state).ok());
+
+    std::vector<Block> passed_through;
+    for (auto& block : create_input(keys, rows, 30)) {
+        Block out_block;
+        ASSERT_TRUE(node->_streaming_passthrough(&block, &out_block).ok());
+        ASSERT_EQ(block.rows(), out_block.rows());
+        const auto& key = out_block.getByPosition(0);
+        ASSERT_TRUE(key.type->isNullable());
+        ASSERT_TRUE(key.column->isNullable());
+        for (size_t i = 0; i < out_block.rows(); ++i) {
+            ASSERT_FALSE(key.column->isNullAt(i));
+            ASSERT_EQ((*block.getByPosition(0).column)[i], (*key.column)[i]);
+        }
+        passed_through.push_back(std::move(out_block));
+    }
+    ASSERT_TRUE(node->close(state).ok());
+
+    // the merge reads the keys as the nullable slot they are
+    auto merge_node = create_agg_node(
+            state, create_source_node(INTERMEDIATE_TUPLE, std::move(passed_through)), true,
+            true);
+    ASSERT_TRUE(merge_node->prepare(state).ok());
+    ASSERT_TRUE(merge_node->open(state).ok());
+    ASSERT_EQ(expected_sums(keys, rows), collect(state, merge_node));
+    ASSERT_TRUE(merge_node->close(state).ok());
+}
+
+TEST_F(VAggregationNodeTest, nullable_key_slot) {
+    const int rows = 2000;
+    std::vector<int64_t> keys;
+    for (int64_t key = -100; key < 100; ++key) {
+        keys.push_back(key);
+    }
+    // the key slot of the output is nullable, the key expr is or is not, the hash method is
+    // chosen by the expr
+    for (bool key_nullable : {false, true}) {
+        init_desc_tbl({TYPE_INT, key_nullable, false, true, false});
+        for (bool enable_spilling : {false, true}) {
+            SCOPED_TRACE(std::to_string(key_nullable) + " " + std::to_string(enable_spilling));
+            // any memory is over the limit of a spilling node
+            RuntimeState* state = create_state(enable_spilling, enable_spilling ? 1 : -1);
+            auto node = create_agg_node(
+                    state, create_source_node(INPUT_TUPLE, create_input(keys, rows, 100)),
+                    false, true);
+            ASSERT_TRUE(node->prepare(state).ok());
+            ASSERT_TRUE(node->open(state).ok());
+            ASSERT_EQ(enable_spilling, node->_spilled);
+
+            std::map<int64_t, int64_t> sums;
+            bool eos = false;
+            while (!eos) {
+                Block block;
+                ASSERT_TRUE(node->get_next(state, &block, &eos).ok());
+                if (block.rows() == 0) {
+                    continue;
+                }
+                const auto& key = block.getByPosition(0);
+                ASSERT_TRUE(key.type->isNullable());
+                ASSERT_TRUE(key.column->isNullable());
+                for (size_t i = 0; i < block.rows(); ++i) {
+                    ASSERT_FALSE(key.column->isNullAt(i));
+                    sums[(*key.column)[i].get<Int64>()] =
+                            (*block.getByPosition(1).column)[i].get<Int64>();
+                }
+            }
+            ASSERT_EQ(expected_sums(keys, rows), sums);
+            ASSERT_TRUE(node->close(state).ok());
+        }
+    }
+}
+
+TEST_F(VAggregationNodeTest, key_hash_methods) {
+    using Type = AggregatedDataVariants::Type;
+    struct KeyCase {
+        PrimitiveType key_type;
+        bool key_nullable;
+        bool slot_nullable;
+        Type method;
+    };
+    const std::vector<KeyCase> cases = {
+            {TYPE_TINYINT, false, false, Type::int8_key},
+            {TYPE_SMALLINT, false, false, Type::int16_key},
+            {TYPE_INT, false, false, Type::int32_key},
+            {TYPE_BIGINT, false, false, Type::int64_key},
+            {TYPE_LARGEINT, false, false, Type::int128_key},
+            {TYPE_VARCHAR, false, false, Type::string_key},
+            // the key slot is nullable, the key expr is not
+            {TYPE_TINYINT, false, true, Type::int8_key},
+            {TYPE_INT, false, true, Type::int32_key},
+            {TYPE_LARGEINT, false, true, Type::int128_key},
+            {TYPE_VARCHAR, false, true, Type::string_key},
+            // the null bitmap is packed in front of the fixed keys
+            {TYPE_TINYINT, true, true, Type::int64_keys},
+            {TYPE_INT, true, true, Type::int64_keys},
+            {TYPE_BIGINT, true, true, Type::int128_keys},
+            {TYPE_LARGEINT, true, true, Type::int256_keys},
+            {TYPE_VARCHAR, true, true, Type::serialized},
+    };
+    const int rows = 1000;
+    const int64_t two_level_threshold = config::vectorized_agg_two_level_threshold;
+
+    for (const auto& key_case : cases) {
+        init_desc_tbl({key_case.key_type, key_case.key_nullable, false, key_case.slot_nullable,
+                       false});
+        bool is_string = key_case.key_type == TYPE_VARCHAR;
+        // the key of row i is i % 37 - 18, or null every 11 rows if the key is nullable
+        auto key_of_row = [&](int i) -> std::string {
+            if (key_case.key_nullable && i % 11 == 0) {
+                return "NULL";
+            }
+            return (is_string ? "key" : "") + std::to_string(i % 37 - 18);
+        };
+        std::map<std::string, int64_t> expected;
+        std::vector<Block> input;
+        auto key_type = _desc_tbl->get_slot_descriptor(0)->get_data_type_ptr();
+        auto value_type = _desc_tbl->get_slot_descriptor(1)->get_data_type_ptr();
+        for (int begin = 0; begin < rows; begin += 100) {
+            auto key_column = key_type->createColumn();
+            auto value_column = value_type->createColumn();
+            for (int i = begin; i < begin + 100; ++i) {
+                std::string key = key_of_row(i);
+                expected[key] += i;
+                if (key == "NULL") {
+                    key_column->insert(Field());
+                } else if (is_string) {
+                    key_column->insert(Field(key));
+                } else if (key_case.key_type == TYPE_LARGEINT) {
+                    key_column->insert(Field(Int128(i % 37 - 18)));
+                } else {
+                    key_column->insert(Field(Int64(i % 37 - 18)));
+                }
+                value_column->insert(Field(Int64(i)));
+            }
+            input.emplace_back(Block({{std::move(key_column), key_type, "k"},
+                                      {std::move(value_column), value_type, "v"}}));
+        }
+
+        // the groups are moved to a two level hash table once there are enough of them
+        for (bool two_level : {false, true}) {
+            SCOPED_TRACE(std::to_string(key_case.key_type) + " " +
+                         std::to_string(key_case.key_nullable) + " " +
+                         std::to_string(key_case.slot_nullable) + " " +
+                         std::to_string(two_level));
+            config::vectorized_agg_two_level_threshold = two_level ? 10 : two_level_threshold;
+            RuntimeState* state = create_state(false);
+            auto node = create_agg_node(state, create_source_node(INPUT_TUPLE, input), false,
+                                        true);
+            ASSERT_TRUE(node->prepare(state).ok());
+            ASSERT_EQ(key_case.method, node->_agg_data._type);
+            ASSERT_TRUE(node->open(state).ok());
+            // the tables of the small integer keys are direct lookup tables
+            bool is_lookup_table =
+                    key_case.method == Type::int8_key || key_case.method == Type::int16_key;
+            ASSERT_EQ(two_level && !is_lookup_table, node->_agg_data._is_two_level);
+
+            std::map<std::string, int64_t> sums;
+            bool eos = false;
+            while (!eos) {
+                Block block;
+                ASSERT_TRUE(node->get_next(state, &block, &eos).ok());
+                if (block.rows() == 0) {
+                    continue;
+                }
+                const auto& key = block.getByPosition(0);
+                ASSERT_EQ(key_case.slot_nullable, key.type->isNullable());
+                ASSERT_EQ(key_case.slot_nullable, key.column->isNullable());
+                const IColumn* values = key.column.get();
+                if (key.column->isNullable()) {
+                    values = &assert_cast<const ColumnNullable&>(*key.column).getNestedColumn();
+                }
+                for (size_t i = 0; i < block.rows(); ++i) {
+                    std::string key_value = key.column->isNullAt(i) ? "NULL"
+                                            : is_string ? values->getDataAt(i).toString()
+                                                        : std::to_string(values->getInt(i));
+                    ASSERT_EQ(0u, sums.count(key_value)) << key_value;
+                    sums[key_value] = (*block.getByPosition(1).column)[i].get<Int64>();
+                }
+            }
+            ASSERT_EQ(expected, sums);
+            ASSERT_TRUE(node->close(state).ok());
+        }
+    }
+    config::vectorized_agg_two_level_threshold = two_level_threshold;
+}
+
+TEST_F(VAggregationNodeTest, two_phase_nullable_intermediate_slot) {
+    const int rows = 1000;
+    const std::vector<int64_t> keys {5, 7, 11, 13, 17};
+    // the values are nullable or not, the intermediate sum is nullable anyway
+    for (bool value_nullable : {false, true}) {
+        init_desc_tbl({TYPE_INT, false, value_nullable, false, true});
+        RuntimeState* state = create_state(false);
+        auto update_node = create_agg_node(
+                state, create_source_node(INPUT_TUPLE, create_input(keys, rows, 128)), false,
+                false);
+        auto merge_node = create_agg_node(state, update_node, true, true);
+        ASSERT_TRUE(merge_node->prepare(state).ok());
+        ASSERT_TRUE(merge_node->open(state).ok());
+        ASSERT_EQ(expected_sums(keys, rows), collect(state, merge_node));
+        ASSERT_TRUE(merge_node->close(state).ok());
+    }
+}
+
+TEST_F(VAggregationNodeTest, nullable_argument_of_not_nullable_intermediate_slot) {
+    // the merge phase could not tell the NULL states of the update phase
+    init_desc_tbl({TYPE_INT, false, true, false, false});
+    RuntimeState* state = create_state(false);
+    auto node = create_agg_node(state, create_source_node(INPUT_TUPLE, {}), false, false);
+    ASSERT_FALSE(node->prepare(state).ok());
+}
+
+} // namespace doris::vectorized
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,521 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "common/config.h"
+#include "common/object_pool.h"
+#include "gen_cpp/DataSinks_types.h"
+#include "gen_cpp/Descriptors_types.h"
+#include "gen_cpp/Exprs_types.h"
+#include "gen_cpp/PaloInternalService_types.h"
+#include "gen_cpp/PlanNodes_types.h"
+#include "gen_cpp/Types_types.h"
+#include "gen_cpp/internal_service.pb.h"
+#include "runtime/descriptors.h"
+#include "runtime/exec_env.h"
+#include "runtime/mem_tracker.h"
+#include "runtime/query_statistics.h"
+#include "runtime/runtime_state.h"
+#include "runtime/test_env.h"
+#include "service/backend_options.h"
+#include "service/brpc.h"
+#include "util/brpc_stub_cache.h"
+#include "util/debug/leakcheck_disabler.h"
+#include "util/runtime_profile.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
+#include "vec/common/assert_cast.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_types_number.h"
+#include "vec/exec/exchange_node.h"
+#include "vec/runtime/data_stream_mgr.h"
+#include "vec/runtime/data_stream_recvr.h"
+#include "vec/sink/data_stream_sender.h"
+
+namespace doris::vectorized {
+
+/// The rpc service of a remote backend, which passes the blocks to its VDataStreamMgr like
+/// PInternalServiceImpl.
+class VDataStreamTestService : public PBackendService {
+public:
+    VDataStreamTestService(ExecEnv* exec_env) : _exec_env(exec_env) {}
+
+    void transmit_block(google::protobuf::RpcController* controller,
+                        const PTransmitDataParams* request, PTransmitDataResult* response,
+                        google::protobuf::Closure* done) override {
+        Status st = _exec_env->vstream_mgr()->transmit_block(request, &done);
+        st.to_protobuf(response->mutable_status());
+        if (done != nullptr) {
+            done->Run();
+        }
+    }
+
+private:
+    ExecEnv* _exec_env;
+};
+
+/// The streams of the tests are of the tuple (k, v) of a nullable INT k and a BIGINT v.
+class VDataStreamTest : public testing::Test {
+public:
+    static constexpr TupleId TUPLE_ID = 0;
+    static constexpr SlotId KEY_SLOT = 0;
+    static constexpr SlotId VALUE_SLOT = 1;
+    static constexpr PlanNodeId DEST_NODE_ID = 1;
+    /// the key of the rows whose key is null in the maps of the received rows
+    static constexpr int32_t NULL_KEY = -1;
+
+    void SetUp() override {
+        _env.reset(new TestEnv());
+        _env->exec_env()->_vstream_mgr = new VDataStreamMgr();
+        _env->exec_env()->_brpc_stub_cache = new BrpcStubCache();
+        BackendOptions::_s_localhost = "127.0.0.1";
+        init_desc_tbl();
+        _row_desc.reset(new RowDescriptor(*_desc_tbl, {TUPLE_ID}, {false}));
+
+        // the destinations of the port of the server are on a remote backend for the senders
+        _server.reset(new brpc::Server());
+        ASSERT_EQ(0, _server->AddService(new VDataStreamTestService(_env->exec_env()),
+                                         brpc::SERVER_OWNS_SERVICE));
+        brpc::ServerOptions options;
+        {
+            debug::ScopedLeakCheckDisabler disable_lsan;
+            ASSERT_EQ(0, _server->Start(remote_port(), &options));
+        }
+    }
+
+    void TearDown() override {
+        _server->Stop(100);
+        _server->Join();
+        _server.reset();
+        _senders.clear();
+        _recvrs.clear();
+        _states.clear();
+        SAFE_DELETE(_env->exec_env()->_brpc_stub_cache);
+        SAFE_DELETE(_env->exec_env()->_vstream_mgr);
+        _env.reset();
+    }
+
+protected:
+    void init_desc_tbl() {
+        TDescriptorTable t_desc_table;
+        TTableDescriptor t_table_desc;
+        t_table_desc.id = 0;
+        t_table_desc.tableType = TTableType::OLAP_TABLE;
+        t_table_desc.numCols = 0;
+        t_table_desc.numClusteringCols = 0;
+        t_desc_table.tableDescriptors.push_back(t_table_desc);
+        t_desc_table.__isset.tableDescriptors = true;
+
+        int offset = 1;
+        auto add_slot = [&](SlotId id, PrimitiveType type, bool nullable,
+                            const std::string& name) {
+            TSlotDescriptor t_slot_desc;
+            t_slot_desc.__set_id(id);
+            t_slot_desc.__set_parent(TUPLE_ID);
+            t_slot_desc.__set_slotType(TypeDescriptor(type).to_thrift());
+            t_slot_desc.__set_columnPos(id);
+            t_slot_desc.__set_byteOffset(offset);
+            t_slot_desc.__set_nullIndicatorByte(0);
+            t_slot_desc.__set_nullIndicatorBit(nullable ? id : -1);
+            t_slot_desc.__set_slotIdx(id);
+            t_slot_desc.__set_isMaterialized(true);
+            t_slot_desc.__set_colName(name);
+            t_desc_table.slotDescriptors.push_back(t_slot_desc);
+            offset += TypeDescriptor(type).get_slot_size();
+        };
+        add_slot(KEY_SLOT, TYPE_INT, true, "k");
+        add_slot(VALUE_SLOT, TYPE_BIGINT, false, "v");
+        t_desc_table.__isset.slotDescriptors = true;
+
+        TTupleDescriptor t_tuple_desc;
+        t_tuple_desc.id = TUPLE_ID;
+        t_tuple_desc.byteSize = offset;
+        t_tuple_desc.numNullBytes = 1;
+        t_tuple_desc.tableId = 0;
+        t_tuple_desc.__isset.tableId = true;
+        t_desc_table.tupleDescriptors.push_back(t_tuple_desc);
+
+        ASSERT_TRUE(DescriptorTbl::create(&_pool, t_desc_table, &_desc_tbl).ok());
+    }
+
+    RuntimeState* create_state(const TUniqueId& fragment_instance_id) {
+        _states.emplace_back(new RuntimeState(fragment_instance_id, TQueryOptions(),
+                                              TQueryGlobals(), _env->exec_env()));
+        RuntimeState* state = _states.back().get();
+        state->_instance_mem_tracker = MemTracker::CreateTracker(-1, "RuntimeState");
+        state->set_desc_tbl(_desc_tbl);
+        return state;
+    }
+
+    static int remote_port() { return config::brpc_port + 1; }
+
+    static TUniqueId instance_id(int64_t lo) {
+        TUniqueId id;
+        id.hi = 1;
+        id.lo = lo;
+        return id;
+    }
+
+    static TExprNode slot_ref(SlotId slot_id, PrimitiveType type) {
+        TExprNode node;
+        node.__set_node_type(TExprNodeType::SLOT_REF);
+        node.__set_type(TypeDescriptor(type).to_thrift());
+        node.__set_num_children(0);
+        TSlotRef t_slot_ref;
+        t_slot_ref.__set_slot_id(slot_id);
+        t_slot_ref.__set_tuple_id(TUPLE_ID);
+        node.__set_slot_ref(t_slot_ref);
+        return node;
+    }
+
+    // A prepared and opened sender to the instances of the destination, of the port
+    // config::brpc_port if it is on this backend.
+    VDataStreamSender* create_sender(RuntimeState* state, TPartitionType::type partition_type,
+                                     const std::vector<std::pair<TUniqueId, int>>& destinations,
+                                     int sender_id = 0) {
+        TDataSink t_sink;
+        t_sink.__set_type(TDataSinkType::DATA_STREAM_SINK);
+        TDataStreamSink& t_stream_sink = t_sink.stream_sink;
+        t_stream_sink.dest_node_id = DEST_NODE_ID;
+        t_stream_sink.output_partition.type = partition_type;
+        if (partition_type == TPartitionType::HASH_PARTITIONED) {
+            TExpr expr;
+            expr.nodes.push_back(slot_ref(KEY_SLOT, TYPE_INT));
+            t_stream_sink.output_partition.__set_partition_exprs({expr});
+        }
+        t_sink.__isset.stream_sink = true;
+
+        std::vector<TPlanFragmentDestination> t_destinations;
+        for (const auto& [fragment_instance_id, port] : destinations) {
+            TPlanFragmentDestination t_destination;
+            t_destination.fragment_instance_id = fragment_instance_id;
+            t_destination.server.hostname = "127.0.0.1";
+            t_destination.brpc_server.hostname = "127.0.0.1";
+            t_destination.brpc_server.port = port;
+            t_destination.__isset.brpc_server = true;
+            t_destinations.push_back(t_destination);
+        }
+
+        _senders.emplace_back(new VDataStreamSender(&_pool, sender_id, *_row_desc, t_stream_sink,
+                                                    t_destinations, false));
+        VDataStreamSender* sender = _senders.back().get();
+        sender->set_query_statistics(std::make_shared<QueryStatistics>());
+        EXPECT_TRUE(sender->init(t_sink).ok());
+        EXPECT_TRUE(sender->prepare(state).ok());
+        EXPECT_TRUE(sender->open(state).ok());
+        return sender;
+    }
+
+    VDataStreamRecvr* create_recvr(const TUniqueId& fragment_instance_id, int num_senders,
+                                   bool is_merging = false) {
+        RuntimeState* state = create_state(fragment_instance_id);
+        auto profile = _pool.add(new RuntimeProfile("VDataStreamRecvr"));
+        _recvrs.push_back(_env->exec_env()->vstream_mgr()->create_recvr(
+                state, *_row_desc, fragment_instance_id, DEST_NODE_ID, num_senders,
+                config::exchg_node_buffer_size_bytes, profile, is_merging,
+                std::make_shared<QueryStatisticsRecvr>()));
+        return _recvrs.back().get();
+    }
+
+    // The rows [begin, end) of the values v, whose keys are v % 50 or null if v % 13 is 0.
+    static Block create_block(int64_t begin, int64_t end) {
+        auto keys = ColumnNullable::create(ColumnInt32::create(), ColumnUInt8::create());
+        auto& nested_keys = assert_cast<ColumnInt32&>(keys->getNestedColumn());
+        auto values = ColumnInt64::create();
+        for (int64_t v = begin; v < end; ++v) {
+            nested_keys.insertValue(v % 50);
+            keys->getNullMapData().push_back(v % 13 == 0);
+            values->insertValue(v);
+        }
+        return Block({{std::move(keys), makeNullable(std::make_shared<DataTypeInt32>()), "k"},
+                      {std::move(values), std::make_shared<DataTypeInt64>(), "v"}});
+    }
+
+    // Add the rows of block to rows, a map of the values to their keys.
+    static void add_rows(const Block& block, std::map<int64_t, int32_t>* rows) {
+        const auto& keys = *block.getByPosition(0).column;
+        const auto& values = *block.getByPosition(1).column;
+        for (size_t i = 0; i < block.rows(); ++i) {
+            Field key = keys[i];
+            int32_t k = key.isNull() ? NULL_KEY : key.get<Int64>();
+            EXPECT_TRUE(rows->emplace(values[i].get<Int64>(), k).second) << "duplicated row";
+        }
+    }
+
+    // All the rows received by recvr, which is closed at the end of its stream.
+    static std::map<int64_t, int32_t> collect(VDataStreamRecvr* recvr) {
+        std::map<int64_t, int32_t> rows;
+        while (true) {
+            Block* block = nullptr;
+            EXPECT_TRUE(recvr->get_next(&block).ok());
+            if (block == nullptr) {
+                break;
+            }
+            add_rows(*block, &rows);
+        }
+        recvr->close();
+        return rows;
+    }
+
+    static void expect_rows(const std::map<int64_t, int32_t>& rows, int64_t begin, int64_t end) {
+        ASSERT_EQ(static_cast<size_t>(end - begin), rows.size());
+        int64_t v = begin;
+        for (auto [value, key] : rows) {
+            ASSERT_EQ(v, value);
+            ASSERT_EQ(v % 13 == 0 ? NULL_KEY : v % 50, key);
+            ++v;
+        }
+    }
+
+    // Send the rows [0, rows) in blocks of rows_per_block rows and close sender.
+    static void send(VDataStreamSender* sender, int64_t rows, int64_t rows_per_block) {
+        for (int64_t begin = 0; begin < rows; begin += rows_per_block) {
+            Block block = create_block(begin, std::min(rows, begin + rows_per_block));
+            ASSERT_TRUE(sender->send(sender->state(), &block).ok());
+        }
+        ASSERT_TRUE(sender->close(sender->state(), Status::OK()).ok());
+    }
+
+    std::unique_ptr<TestEnv> _env;
+    std::unique_ptr<brpc::Server> _server;
+    ObjectPool _pool;
+    DescriptorTbl* _desc_tbl = nullptr;
+    std::unique_ptr<RowDescriptor> _row_desc;
+    std::vector<std::unique_ptr<RuntimeState>> _states;
+    std::vector<std::unique_ptr<VDataStreamSender>> _senders;
+    std::vector<std::shared_ptr<VDataStreamRecvr>> _recvrs;
+};
+
+TEST_F(VDataStreamTest, hash_partition_of_nullable_and_not_nullable_keys) {
+    RuntimeState* state = create_state(instance_id(0));
+    std::vector<std::pair<TUniqueId, int>> destinations;
+    for (int i = 0; i < 4; ++i) {
+        destinations.emplace_back(instance_id(i + 1), config::brpc_port);
+    }
+    VDataStreamSender* sender =
+            create_sender(state, TPartitionType::HASH_PARTITIONED, destinations);
+
+    // the same keys, in a nullable column with some nulls between them
+    const int rows = 1000;
+    auto keys = ColumnInt32::create();
+    auto nullable_keys = ColumnNullable::create(ColumnInt32::create(), ColumnUInt8::create());
+    auto& nested_keys = assert_cast<ColumnInt32&>(nullable_keys->getNestedColumn());
+    auto& null_map = nullable_keys->getNullMapData();
+    for (int i = 0; i < rows; ++i) {
+        keys->insertValue(i * 7);
+        if (i % 10 == 0) {
+            nested_keys.insertValue(0);
+            null_map.push_back(1);
+        }
+        nested_keys.insertValue(i * 7);
+        null_map.push_back(0);
+    }
+
+    auto key_type = std::make_shared<DataTypeInt32>();
+    Block block({{std::move(keys), key_type, "k"}});
+    ASSERT_TRUE(sender->compute_selector(&block, destinations.size()).ok());
+    IColumn::Selector selector = sender->_selector;
+    Block nullable_block({{std::move(nullable_keys), makeNullable(key_type), "k"}});
+    ASSERT_TRUE(sender->compute_selector(&nullable_block, destinations.size()).ok());
+    const IColumn::Selector& nullable_selector = sender->_selector;
+
+    std::set<size_t> channels;
+    std::set<size_t> null_channels;
+    size_t row = 0;
+    for (size_t i = 0; i < nullable_block.rows(); ++i) {
+        if (null_map[i]) {
+            null_channels.insert(nullable_selector[i]);
+            continue;
+        }
+        ASSERT_EQ(selector[row], nullable_selector[i]) << row;
+        channels.insert(selector[row]);
+        ++row;
+    }
+    ASSERT_EQ(static_cast<size_t>(rows), row);
+    ASSERT_EQ(destinations.size(), channels.size());
+    // the nulls are all sent to the same channel
+    ASSERT_EQ(1u, null_channels.size());
+    for (auto& sender : _senders) {
+        ASSERT_TRUE(sender->close(state, Status::OK()).ok());
+    }
+}
+
+TEST_F(VDataStreamTest, broadcast_to_local_and_remote_recvrs) {
+    for (bool all_local : {true, false}) {
+        SCOPED_TRACE(all_local);
+        std::vector<std::pair<TUniqueId, int>> destinations = {
+                {instance_id(1), config::brpc_port},
+                {instance_id(2), all_local ? config::brpc_port : remote_port()},
+                {instance_id(3), config::brpc_port}};
+        std::vector<VDataStreamRecvr*> recvrs;
+        for (const auto& destination : destinations) {
+            recvrs.push_back(create_recvr(destination.first, 1));
+        }
+        send(create_sender(create_state(instance_id(0)), TPartitionType::UNPARTITIONED,
+                           destinations),
+             3000, 1000);
+        // every receiver gets all the rows
+        for (auto recvr : recvrs) {
+            expect_rows(collect(recvr), 0, 3000);
+        }
+        _senders.clear();
+        _recvrs.clear();
+    }
+}
+
+TEST_F(VDataStreamTest, random_to_local_and_remote_recvrs) {
+    std::vector<std::pair<TUniqueId, int>> destinations = {{instance_id(1), config::brpc_port},
+                                                           {instance_id(2), remote_port()}};
+    std::vector<VDataStreamRecvr*> recvrs;
+    for (const auto& destination : destinations) {
+        recvrs.push_back(create_recvr(destination.first, 1));
+    }
+    send(create_sender(create_state(instance_id(0)), TPartitionType::RANDOM, destinations), 4000,
+         1000);
+    // the blocks are sent round robin
+    std::map<int64_t, int32_t> rows;
+    for (auto recvr : recvrs) {
+        auto recvr_rows = collect(recvr);
+        ASSERT_EQ(2000u, recvr_rows.size());
+        rows.insert(recvr_rows.begin(), recvr_rows.end());
+    }
+    expect_rows(rows, 0, 4000);
+}
+
+TEST_F(VDataStreamTest, hash_partition_to_local_and_remote_recvrs) {
+    std::vector<std::pair<TUniqueId, int>> destinations = {{instance_id(1), config::brpc_port},
+                                                           {instance_id(2), remote_port()},
+                                                           {instance_id(3), config::brpc_port},
+                                                           {instance_id(4), remote_port()}};
+    std::vector<VDataStreamRecvr*> recvrs;
+    for (const auto& destination : destinations) {
+        recvrs.push_back(create_recvr(destination.first, 1));
+    }
+    // blocks larger and smaller than the batch size buffered by the channels
+    RuntimeState* state = create_state(instance_id(0));
+    VDataStreamSender* sender =
+            create_sender(state, TPartitionType::HASH_PARTITIONED, destinations);
+    int64_t begin = 0;
+    for (int64_t rows : {5000, 10, 300, 2000}) {
+        Block block = create_block(begin, begin + rows);
+        ASSERT_TRUE(sender->send(state, &block).ok());
+        begin += rows;
+    }
+    ASSERT_TRUE(sender->close(state, Status::OK()).ok());
+
+    // the rows of a key all go to the same receiver
+    std::map<int64_t, int32_t> rows;
+    std::map<int32_t, size_t> recvr_of_keys;
+    for (size_t i = 0; i < recvrs.size(); ++i) {
+        auto recvr_rows = collect(recvrs[i]);
+        ASSERT_FALSE(recvr_rows.empty()) << i;
+        for (auto [value, key] : recvr_rows) {
+            ASSERT_EQ(i, recvr_of_keys.emplace(key, i).first->second) << key;
+        }
+        rows.insert(recvr_rows.begin(), recvr_rows.end());
+    }
+    ASSERT_EQ(51u, recvr_of_keys.size());
+    expect_rows(rows, 0, begin);
+}
+
+TEST_F(VDataStreamTest, merging_exchange_node) {
+    // the rows of the senders are sorted by v, the local sender sends the even values and
+    // the remote one the odd values
+    const int64_t rows = 3000;
+    const int64_t offset = 7;
+    const int64_t limit = 2500;
+    TUniqueId exchange_instance_id = instance_id(1);
+    RuntimeState* state = create_state(exchange_instance_id);
+    state->_query_options.batch_size = 100;
+
+    TPlanNode tnode;
+    tnode.node_id = DEST_NODE_ID;
+    tnode.node_type = TPlanNodeType::EXCHANGE_NODE;
+    tnode.num_children = 0;
+    tnode.limit = limit;
+    tnode.row_tuples.push_back(TUPLE_ID);
+    tnode.nullable_tuples.push_back(false);
+    tnode.exchange_node.input_row_tuples.push_back(TUPLE_ID);
+    TExpr ordering_expr;
+    ordering_expr.nodes.push_back(slot_ref(VALUE_SLOT, TYPE_BIGINT));
+    tnode.exchange_node.sort_info.ordering_exprs.push_back(ordering_expr);
+    tnode.exchange_node.sort_info.is_asc_order.push_back(true);
+    tnode.exchange_node.sort_info.nulls_first.push_back(false);
+    tnode.exchange_node.__isset.sort_info = true;
+    tnode.exchange_node.__set_offset(offset);
+    tnode.__isset.exchange_node = true;
+
+    VExchangeNode exchange_node(&_pool, tnode, *_desc_tbl);
+    ASSERT_TRUE(exchange_node.init(tnode, state).ok());
+    exchange_node.set_num_senders(2);
+    ASSERT_TRUE(exchange_node.prepare(state).ok());
+
+    // the blocks are buffered by the receiver until the merger reads them
+    for (int sender_id : {0, 1}) {
+        int port = sender_id == 0 ? config::brpc_port : remote_port();
+        RuntimeState* sender_state = create_state(instance_id(10 + sender_id));
+        sender_state->set_be_number(sender_id);
+        VDataStreamSender* sender =
+                create_sender(sender_state, TPartitionType::UNPARTITIONED,
+                              {{exchange_instance_id, port}}, sender_id);
+        for (int64_t begin = 0; begin < rows; begin += 500) {
+            Block block = create_block(begin, begin + 500);
+            IColumn::Filter filter(500);
+            for (int64_t i = 0; i < 500; ++i) {
+                filter[i] = (begin + i) % 2 == sender_id;
+            }
+            for (size_t i = 0; i < block.columns(); ++i) {
+                auto& column = block.getByPosition(i).column;
+                column = column->filter(filter, -1);
+            }
+            ASSERT_TRUE(sender->send(sender_state, &block).ok());
+        }
+        ASSERT_TRUE(sender->close(sender_state, Status::OK()).ok());
+    }
+
+    ASSERT_TRUE(exchange_node.open(state).ok());
+    std::map<int64_t, int32_t> received;
+    bool eos = false;
+    int64_t last_value = -1;
+    while (!eos) {
+        Block block;
+        ASSERT_TRUE(exchange_node.get_next(state, &block, &eos).ok());
+        ASSERT_LE(block.rows(), 100u);
+        for (size_t i = 0; i < block.rows(); ++i) {
+            int64_t value = (*block.getByPosition(1).column)[i].get<Int64>();
+            ASSERT_LT(last_value, value);
+            last_value = value;
+        }
+        add_rows(block, &received);
+    }
+    expect_rows(received, offset, offset + limit);
+    ASSERT_TRUE(exchange_node.close(state).ok());
+}
+
+} // namespace doris::vectorized
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
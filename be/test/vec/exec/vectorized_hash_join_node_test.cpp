@@ -0,0 +1,491 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/hash_join_node.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "common/object_pool.h"
+#include "gen_cpp/Descriptors_types.h"
+#include "gen_cpp/Exprs_types.h"
+#include "gen_cpp/Opcodes_types.h"
+#include "gen_cpp/PlanNodes_types.h"
+#include "gen_cpp/Types_types.h"
+#include "runtime/descriptors.h"
+#include "runtime/mem_tracker.h"
+#include "runtime/runtime_state.h"
+#include "runtime/test_env.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
+#include "vec/common/assert_cast.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_types_number.h"
+
+namespace doris::vectorized {
+
+/// Returns the given blocks as its child would.
+class VBlockSourceNode : public ExecNode {
+public:
+    VBlockSourceNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs,
+                     std::vector<Block> blocks)
+            : ExecNode(pool, tnode, descs), _blocks(std::move(blocks)) {}
+
+    Status get_next(RuntimeState* state, RowBatch* row_batch, bool* eos) override {
+        return Status::NotSupported("VBlockSourceNode only returns blocks");
+    }
+
+    Status get_next(RuntimeState* state, Block* block, bool* eos) override {
+        if (_next < _blocks.size()) {
+            *block = _blocks[_next++];
+        }
+        *eos = _next >= _blocks.size();
+        return Status::OK();
+    }
+
+private:
+    std::vector<Block> _blocks;
+    size_t _next = 0;
+};
+
+/// A row (k, v) of the probe tuple or of the build tuple, k is nullable.
+struct JoinRow {
+    std::optional<int32_t> k;
+    int64_t v;
+};
+
+/// The plans of the tests join the probe tuple (pk, pv) with the build tuple (bk, bv) on
+/// pk = bk or pk <=> bk, and optionally the other join conjunct pv < bv.
+struct JoinPlan {
+    TJoinOp::type join_op = TJoinOp::INNER_JOIN;
+    bool null_safe = false;
+    bool other_conjunct = false;
+    int64_t limit = -1;
+};
+
+class VHashJoinNodeTest : public testing::Test {
+public:
+    static constexpr TupleId PROBE_TUPLE = 0;
+    static constexpr TupleId BUILD_TUPLE = 1;
+
+    void SetUp() override {
+        _env.reset(new TestEnv());
+        init_desc_tbl();
+    }
+
+    void TearDown() override {
+        _states.clear();
+        _env.reset();
+    }
+
+protected:
+    // the slots of tuple t are k (slot t * 2) and v (slot t * 2 + 1)
+    void init_desc_tbl() {
+        TDescriptorTable t_desc_table;
+        TTableDescriptor t_table_desc;
+        t_table_desc.id = 0;
+        t_table_desc.tableType = TTableType::OLAP_TABLE;
+        t_table_desc.numCols = 0;
+        t_table_desc.numClusteringCols = 0;
+        t_desc_table.tableDescriptors.push_back(t_table_desc);
+        t_desc_table.__isset.tableDescriptors = true;
+
+        for (TupleId tuple_id : {PROBE_TUPLE, BUILD_TUPLE}) {
+            int offset = 1;
+            int slot_idx = 0;
+            auto add_slot = [&](PrimitiveType type, bool nullable, const std::string& name) {
+                TSlotDescriptor t_slot_desc;
+                t_slot_desc.__set_id(tuple_id * 2 + slot_idx);
+                t_slot_desc.__set_parent(tuple_id);
+                t_slot_desc.__set_slotType(TypeDescriptor(type).to_thrift());
+                t_slot_desc.__set_columnPos(slot_idx);
+                t_slot_desc.__set_byteOffset(offset);
+                t_slot_desc.__set_nullIndicatorByte(0);
+                t_slot_desc.__set_nullIndicatorBit(nullable ? slot_idx : -1);
+                t_slot_desc.__set_slotIdx(slot_idx);
+                t_slot_desc.__set_isMaterialized(true);
+                t_slot_desc.__set_colName(name);
+                t_desc_table.slotDescriptors.push_back(t_slot_desc);
+                offset += TypeDescriptor(type).get_slot_size();
+                ++slot_idx;
+            };
+            std::string prefix = tuple_id == PROBE_TUPLE ? "p" : "b";
+            add_slot(TYPE_INT, true, prefix + "k");
+            add_slot(TYPE_BIGINT, false, prefix + "v");
+
+            TTupleDescriptor t_tuple_desc;
+            t_tuple_desc.id = tuple_id;
+            t_tuple_desc.byteSize = offset;
+            t_tuple_desc.numNullBytes = 1;
+            t_tuple_desc.tableId = 0;
+            t_tuple_desc.__isset.tableId = true;
+            t_desc_table.tupleDescriptors.push_back(t_tuple_desc);
+        }
+        t_desc_table.__isset.slotDescriptors = true;
+
+        ASSERT_TRUE(DescriptorTbl::create(&_pool, t_desc_table, &_desc_tbl).ok());
+    }
+
+    RuntimeState* create_state(int batch_size) {
+        TQueryOptions query_options;
+        query_options.__set_batch_size(batch_size);
+        _states.emplace_back(new RuntimeState(TUniqueId(), query_options, TQueryGlobals(),
+                                              _env->exec_env()));
+        RuntimeState* state = _states.back().get();
+        state->_instance_mem_tracker = MemTracker::CreateTracker(-1, "RuntimeState");
+        state->set_desc_tbl(_desc_tbl);
+        return state;
+    }
+
+    static TExprNode slot_ref(TupleId tuple_id, int slot_idx) {
+        PrimitiveType type = slot_idx == 0 ? TYPE_INT : TYPE_BIGINT;
+        TExprNode node;
+        node.__set_node_type(TExprNodeType::SLOT_REF);
+        node.__set_type(TypeDescriptor(type).to_thrift());
+        node.__set_num_children(0);
+        TSlotRef t_slot_ref;
+        t_slot_ref.__set_slot_id(tuple_id * 2 + slot_idx);
+        t_slot_ref.__set_tuple_id(tuple_id);
+        node.__set_slot_ref(t_slot_ref);
+        return node;
+    }
+
+    // pv < bv
+    static TExpr other_conjunct() {
+        TExprNode node;
+        node.__set_node_type(TExprNodeType::BINARY_PRED);
+        node.__set_type(TypeDescriptor(TYPE_BOOLEAN).to_thrift());
+        node.__set_num_children(2);
+        TFunction fn;
+        fn.name.__set_function_name("lt");
+        node.__set_fn(fn);
+        TExpr expr;
+        expr.nodes = {node, slot_ref(PROBE_TUPLE, 1), slot_ref(BUILD_TUPLE, 1)};
+        return expr;
+    }
+
+    ExecNode* create_source_node(TupleId tuple_id, const std::vector<JoinRow>& rows,
+                                 size_t rows_per_block) {
+        auto key_type = _desc_tbl->get_slot_descriptor(tuple_id * 2)->get_data_type_ptr();
+        auto value_type = _desc_tbl->get_slot_descriptor(tuple_id * 2 + 1)->get_data_type_ptr();
+        std::string prefix = tuple_id == PROBE_TUPLE ? "p" : "b";
+        std::vector<Block> blocks;
+        for (size_t begin = 0; begin < rows.size(); begin += rows_per_block) {
+            auto key_column = key_type->createColumn();
+            auto value_column = value_type->createColumn();
+            for (size_t i = begin; i < std::min(rows.size(), begin + rows_per_block); ++i) {
+                key_column->insert(rows[i].k ? Field(Int64(*rows[i].k)) : Field());
+                value_column->insert(Field(rows[i].v));
+            }
+            blocks.emplace_back(Block({{std::move(key_column), key_type, prefix + "k"},
+                                       {std::move(value_column), value_type, prefix + "v"}}));
+        }
+
+        TPlanNode tnode;
+        tnode.node_id = _next_node_id++;
+        tnode.node_type = TPlanNodeType::EXCHANGE_NODE;
+        tnode.num_children = 0;
+        tnode.limit = -1;
+        tnode.row_tuples.push_back(tuple_id);
+        tnode.nullable_tuples.push_back(false);
+        return _pool.add(new VBlockSourceNode(&_pool, tnode, *_desc_tbl, std::move(blocks)));
+    }
+
+    VHashJoinNode* create_join_node(RuntimeState* state, const JoinPlan& plan,
+                                    const std::vector<JoinRow>& probe_rows,
+                                    const std::vector<JoinRow>& build_rows) {
+        TPlanNode tnode;
+        tnode.node_id = _next_node_id++;
+        tnode.node_type = TPlanNodeType::HASH_JOIN_NODE;
+        tnode.num_children = 2;
+        tnode.limit = plan.limit;
+        tnode.row_tuples = {PROBE_TUPLE, BUILD_TUPLE};
+        // the side of an outer join which may have no match is nullable
+        bool probe_nullable = plan.join_op == TJoinOp::RIGHT_OUTER_JOIN ||
+                              plan.join_op == TJoinOp::FULL_OUTER_JOIN;
+        bool build_nullable = plan.join_op == TJoinOp::LEFT_OUTER_JOIN ||
+                              plan.join_op == TJoinOp::FULL_OUTER_JOIN;
+        tnode.nullable_tuples = {probe_nullable, build_nullable};
+        tnode.hash_join_node.join_op = plan.join_op;
+        TEqJoinCondition eq_join_conjunct;
+        eq_join_conjunct.left.nodes = {slot_ref(PROBE_TUPLE, 0)};
+        eq_join_conjunct.right.nodes = {slot_ref(BUILD_TUPLE, 0)};
+        eq_join_conjunct.__set_opcode(plan.null_safe ? TExprOpcode::EQ_FOR_NULL
+                                                     : TExprOpcode::EQ);
+        tnode.hash_join_node.eq_join_conjuncts = {eq_join_conjunct};
+        if (plan.other_conjunct) {
+            tnode.hash_join_node.__set_other_join_conjuncts({other_conjunct()});
+        }
+        tnode.hash_join_node.__set_is_push_down(false);
+        tnode.__isset.hash_join_node = true;
+
+        auto node = _pool.add(new VHashJoinNode(&_pool, tnode, *_desc_tbl));
+        EXPECT_TRUE(node->init(tnode, state).ok());
+        node->_children.push_back(create_source_node(PROBE_TUPLE, probe_rows, 7));
+        node->_children.push_back(create_source_node(BUILD_TUPLE, build_rows, 6));
+        return node;
+    }
+
+    static std::string to_string(const std::optional<int64_t>& value) {
+        return value ? std::to_string(*value) : "NULL";
+    }
+
+    static std::string to_string(const JoinRow* probe, const JoinRow* build) {
+        std::optional<int64_t> pk, pv, bk, bv;
+        if (probe != nullptr) {
+            pk = probe->k;
+            pv = probe->v;
+        }
+        if (build != nullptr) {
+            bk = build->k;
+            bv = build->v;
+        }
+        return to_string(pk) + "," + to_string(pv) + "," + to_string(bk) + "," + to_string(bv);
+    }
+
+    // The rows the join of the plan returns, of a nested loop over both sides.
+    static std::vector<std::string> expected_rows(const JoinPlan& plan,
+                                                  const std::vector<JoinRow>& probe_rows,
+                                                  const std::vector<JoinRow>& build_rows) {
+        auto match = [&](const JoinRow& probe, const JoinRow& build) {
+            bool key_match = plan.null_safe ? probe.k == build.k
+                                            : probe.k && build.k && *probe.k == *build.k;
+            return key_match && (!plan.other_conjunct || probe.v < build.v);
+        };
+        bool build_has_null = std::any_of(build_rows.begin(), build_rows.end(),
+                                          [](const JoinRow& row) { return !row.k; });
+
+        std::vector<std::string> rows;
+        std::vector<bool> build_matched(build_rows.size(), false);
+        for (const auto& probe : probe_rows) {
+            bool probe_matched = false;
+            for (size_t j = 0; j < build_rows.size(); ++j) {
+                if (!match(probe, build_rows[j])) {
+                    continue;
+                }
+                probe_matched = true;
+                build_matched[j] = true;
+                switch (plan.join_op) {
+                case TJoinOp::INNER_JOIN:
+                case TJoinOp::LEFT_OUTER_JOIN:
+                case TJoinOp::RIGHT_OUTER_JOIN:
+                case TJoinOp::FULL_OUTER_JOIN:
+                    rows.push_back(to_string(&probe, &build_rows[j]));
+                    break;
+                default:
+                    break;
+                }
+            }
+            switch (plan.join_op) {
+            case TJoinOp::LEFT_OUTER_JOIN:
+            case TJoinOp::FULL_OUTER_JOIN:
+            case TJoinOp::LEFT_ANTI_JOIN:
+                if (!probe_matched) {
+                    rows.push_back(to_string(&probe, nullptr));
+                }
+                break;
+            case TJoinOp::LEFT_SEMI_JOIN:
+                if (probe_matched) {
+                    rows.push_back(to_string(&probe, nullptr));
+                }
+                break;
+            case TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN:
+                // x NOT IN (...) is null, not true, if x is null or the subquery has a null
+                if (!probe_matched && !build_has_null && (probe.k || build_rows.empty())) {
+                    rows.push_back(to_string(&probe, nullptr));
+                }
+                break;
+            default:
+                break;
+            }
+        }
+        for (size_t j = 0; j < build_rows.size(); ++j) {
+            bool output = false;
+            switch (plan.join_op) {
+            case TJoinOp::RIGHT_OUTER_JOIN:
+            case TJoinOp::FULL_OUTER_JOIN:
+            case TJoinOp::RIGHT_ANTI_JOIN:
+                output = !build_matched[j];
+                break;
+            case TJoinOp::RIGHT_SEMI_JOIN:
+                output = build_matched[j];
+                break;
+            default:
+                break;
+            }
+            if (output) {
+                rows.push_back(to_string(nullptr, &build_rows[j]));
+            }
+        }
+        std::sort(rows.begin(), rows.end());
+        return rows;
+    }
+
+    static std::optional<int64_t> value_at(const IColumn& column, size_t row) {
+        if (column.isNullAt(row)) {
+            return std::nullopt;
+        }
+        if (column.isNullable()) {
+            return assert_cast<const ColumnNullable&>(column).getNestedColumn().getInt(row);
+        }
+        return column.getInt(row);
+    }
+
+    // The rows returned by the join, sorted.
+    static std::vector<std::string> collect(RuntimeState* state, ExecNode* node) {
+        std::vector<std::string> rows;
+        bool eos = false;
+        while (!eos) {
+            Block block;
+            EXPECT_TRUE(node->get_next(state, &block, &eos).ok());
+            if (block.rows() == 0) {
+                continue;
+            }
+            EXPECT_EQ(4u, block.columns());
+            for (size_t i = 0; i < block.rows(); ++i) {
+                std::string row;
+                for (size_t j = 0; j < block.columns(); ++j) {
+                    row += (j == 0 ? "" : ",") +
+                           to_string(value_at(*block.getByPosition(j).column, i));
+                }
+                rows.push_back(row);
+            }
+        }
+        std::sort(rows.begin(), rows.end());
+        return rows;
+    }
+
+    // the probe keys 0 to 2 and the build key 7 have no match, some keys of both sides
+    // are null and most keys are duplicated
+    static std::vector<JoinRow> probe_rows() {
+        std::vector<JoinRow> rows;
+        for (int i = 0; i < 40; ++i) {
+            rows.push_back({i % 9 == 0 ? std::nullopt : std::optional<int32_t>(i % 7), i});
+        }
+        return rows;
+    }
+
+    static std::vector<JoinRow> build_rows(bool with_null = true) {
+        std::vector<JoinRow> rows;
+        for (int j = 0; j < 25; ++j) {
+            bool is_null = with_null && j % 8 == 3;
+            rows.push_back({is_null ? std::nullopt : std::optional<int32_t>(j % 5 + 3), j * 2});
+        }
+        return rows;
+    }
+
+    std::unique_ptr<TestEnv> _env;
+    std::vector<std::unique_ptr<RuntimeState>> _states;
+    ObjectPool _pool;
+    DescriptorTbl* _desc_tbl = nullptr;
+    int _next_node_id = 0;
+};
+
+static const std::vector<TJoinOp::type> JOIN_OPS = {
+        TJoinOp::INNER_JOIN,      TJoinOp::LEFT_OUTER_JOIN, TJoinOp::RIGHT_OUTER_JOIN,
+        TJoinOp::FULL_OUTER_JOIN, TJoinOp::LEFT_SEMI_JOIN,  TJoinOp::RIGHT_SEMI_JOIN,
+        TJoinOp::LEFT_ANTI_JOIN,  TJoinOp::RIGHT_ANTI_JOIN, TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN};
+
+TEST_F(VHashJoinNodeTest, join_ops) {
+    for (TJoinOp::type join_op : JOIN_OPS) {
+        for (bool null_safe : {false, true}) {
+            for (bool other_conjunct : {false, true}) {
+                // the null keys of the build side of NOT IN are not compared by <=>, nor
+                // filtered by the other join conjuncts
+                if (join_op == TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN &&
+                    (null_safe || other_conjunct)) {
+                    continue;
+                }
+                SCOPED_TRACE(std::to_string(join_op) + " " + std::to_string(null_safe) + " " +
+                             std::to_string(other_conjunct));
+                JoinPlan plan {join_op, null_safe, other_conjunct};
+                // the build rows are output in several batches by the right joins
+                RuntimeState* state = create_state(4);
+                auto node = create_join_node(state, plan, probe_rows(), build_rows());
+                ASSERT_TRUE(node->prepare(state).ok());
+                ASSERT_TRUE(node->open(state).ok());
+                auto rows = collect(state, node);
+                ASSERT_EQ(expected_rows(plan, probe_rows(), build_rows()), rows);
+                ASSERT_TRUE(node->close(state).ok());
+            }
+        }
+    }
+}
+
+TEST_F(VHashJoinNodeTest, null_aware_anti_join_without_null_build_key) {
+    // the probe rows of a null key are only returned if the build side is empty
+    JoinPlan plan {TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN};
+    for (const auto& build : {build_rows(false), std::vector<JoinRow>()}) {
+        RuntimeState* state = create_state(1024);
+        auto node = create_join_node(state, plan, probe_rows(), build);
+        ASSERT_TRUE(node->prepare(state).ok());
+        ASSERT_TRUE(node->open(state).ok());
+        auto rows = collect(state, node);
+        ASSERT_EQ(expected_rows(plan, probe_rows(), build), rows);
+        bool has_null_key = std::any_of(rows.begin(), rows.end(), [](const std::string& row) {
+            return row.compare(0, 5, "NULL,") == 0;
+        });
+        ASSERT_EQ(build.empty(), has_null_key);
+        ASSERT_TRUE(node->close(state).ok());
+    }
+}
+
+TEST_F(VHashJoinNodeTest, empty_build_side) {
+    for (TJoinOp::type join_op : JOIN_OPS) {
+        for (bool null_safe : {false, true}) {
+            SCOPED_TRACE(std::to_string(join_op) + " " + std::to_string(null_safe));
+            JoinPlan plan {join_op, null_safe};
+            RuntimeState* state = create_state(1024);
+            auto node = create_join_node(state, plan, probe_rows(), {});
+            ASSERT_TRUE(node->prepare(state).ok());
+            ASSERT_TRUE(node->open(state).ok());
+            ASSERT_EQ(expected_rows(plan, probe_rows(), {}), collect(state, node));
+            ASSERT_TRUE(node->close(state).ok());
+        }
+    }
+}
+
+TEST_F(VHashJoinNodeTest, limit) {
+    for (TJoinOp::type join_op : JOIN_OPS) {
+        SCOPED_TRACE(std::to_string(join_op));
+        JoinPlan plan {join_op};
+        auto expected = expected_rows(plan, probe_rows(), build_rows());
+        for (int64_t limit : {int64_t(1), int64_t(5), int64_t(expected.size() + 1)}) {
+            plan.limit = limit;
+            RuntimeState* state = create_state(4);
+            auto node = create_join_node(state, plan, probe_rows(), build_rows());
+            ASSERT_TRUE(node->prepare(state).ok());
+            ASSERT_TRUE(node->open(state).ok());
+            auto rows = collect(state, node);
+            ASSERT_EQ(std::min<size_t>(limit, expected.size()), rows.size()) << limit;
+            // the rows are some of the rows of the join
+            ASSERT_TRUE(std::includes(expected.begin(), expected.end(), rows.begin(), rows.end()));
+            ASSERT_TRUE(node->close(state).ok());
+        }
+    }
+}
+
+} // namespace doris::vectorized
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
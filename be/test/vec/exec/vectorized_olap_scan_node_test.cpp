@@ -0,0 +1,359 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/olap_scan_node.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/config.h"
+#include "common/object_pool.h"
+#include "gen_cpp/Descriptors_types.h"
+#include "gen_cpp/Exprs_types.h"
+#include "gen_cpp/PlanNodes_types.h"
+#include "gen_cpp/Types_types.h"
+#include "runtime/descriptors.h"
+#include "runtime/runtime_state.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/exprs/vectorized_fn_call.h"
+#include "vec/exprs/vin_predicate.h"
+#include "vec/exprs/vliteral.h"
+#include "vec/exprs/vslot_ref.h"
+
+namespace doris::vectorized {
+
+/// A NULL of type INT, the NULL literal has no vectorized expr.
+class NullLiteral : public VExpr {
+public:
+    NullLiteral() : VExpr(TypeDescriptor(TYPE_INT), false) {}
+
+    Status execute(VExprContext* context, Block* block, int* result_column_id) override {
+        return Status::NotSupported("NullLiteral is only a constant");
+    }
+    const std::string& expr_name() const override { return _expr_name; }
+    VExpr* clone(ObjectPool* pool) const override { return pool->add(new NullLiteral(*this)); }
+    ColumnPtr get_const_col() const override {
+        return makeNullable(_data_type)->createColumnConst(1, Null());
+    }
+
+private:
+    std::string _expr_name = "NullLiteral";
+};
+
+class VOlapScanNodeTest : public testing::Test {
+public:
+    void SetUp() override {
+        // k1 INT and kb BOOLEAN are the keys of the table, v1 INT its value
+        TDescriptorTable t_desc_table;
+        TTableDescriptor t_table_desc;
+        t_table_desc.id = 0;
+        t_table_desc.tableType = TTableType::OLAP_TABLE;
+        t_table_desc.numCols = 0;
+        t_table_desc.numClusteringCols = 0;
+        t_desc_table.tableDescriptors.push_back(t_table_desc);
+        t_desc_table.__isset.tableDescriptors = true;
+
+        int offset = 1;
+        auto add_slot = [&](int id, PrimitiveType type, const std::string& name, int size) {
+            TSlotDescriptor t_slot_desc;
+            t_slot_desc.__set_id(id);
+            t_slot_desc.__set_parent(0);
+            t_slot_desc.__set_slotType(TypeDescriptor(type).to_thrift());
+            t_slot_desc.__set_columnPos(id);
+            t_slot_desc.__set_byteOffset(offset);
+            t_slot_desc.__set_nullIndicatorByte(0);
+            t_slot_desc.__set_nullIndicatorBit(-1);
+            t_slot_desc.__set_slotIdx(id);
+            t_slot_desc.__set_isMaterialized(true);
+            t_slot_desc.__set_colName(name);
+            t_desc_table.slotDescriptors.push_back(t_slot_desc);
+            offset += size;
+        };
+        add_slot(0, TYPE_INT, "k1", sizeof(int32_t));
+        add_slot(1, TYPE_BOOLEAN, "kb", sizeof(bool));
+        add_slot(2, TYPE_INT, "v1", sizeof(int32_t));
+        t_desc_table.__isset.slotDescriptors = true;
+
+        TTupleDescriptor t_tuple_desc;
+        t_tuple_desc.id = 0;
+        t_tuple_desc.byteSize = offset;
+        t_tuple_desc.numNullBytes = 1;
+        t_tuple_desc.tableId = 0;
+        t_tuple_desc.__isset.tableId = true;
+        t_desc_table.tupleDescriptors.push_back(t_tuple_desc);
+
+        ASSERT_TRUE(DescriptorTbl::create(&_pool, t_desc_table, &_desc_tbl).ok());
+
+        TPlanNode tnode;
+        tnode.node_id = 0;
+        tnode.node_type = TPlanNodeType::OLAP_SCAN_NODE;
+        tnode.num_children = 0;
+        tnode.limit = -1;
+        tnode.row_tuples.push_back(0);
+        tnode.nullable_tuples.push_back(false);
+        tnode.olap_scan_node.tuple_id = 0;
+        tnode.olap_scan_node.key_column_name = {"k1", "kb"};
+        tnode.olap_scan_node.keyType = TKeysType::AGG_KEYS;
+        tnode.__isset.olap_scan_node = true;
+
+        _node.reset(new VOlapScanNode(&_pool, tnode, *_desc_tbl));
+        _node->_tuple_desc = _desc_tbl->get_tuple_descriptor(0);
+    }
+
+protected:
+    VExpr* slot(int id) { return _pool.add(new VSlotRef(_desc_tbl->get_slot_descriptor(id))); }
+
+    VExpr* int_literal(int32_t value) {
+        TExprNode node;
+        node.__set_node_type(TExprNodeType::INT_LITERAL);
+        node.__set_type(TypeDescriptor(TYPE_INT).to_thrift());
+        TIntLiteral int_literal;
+        int_literal.__set_value(value);
+        node.__set_int_literal(int_literal);
+        return _pool.add(new VLiteral(node));
+    }
+
+    VExpr* bool_literal(bool value) {
+        TExprNode node;
+        node.__set_node_type(TExprNodeType::BOOL_LITERAL);
+        node.__set_type(TypeDescriptor(TYPE_BOOLEAN).to_thrift());
+        TBoolLiteral bool_literal;
+        bool_literal.__set_value(value);
+        node.__set_bool_literal(bool_literal);
+        return _pool.add(new VLiteral(node));
+    }
+
+    VExpr* null_literal() { return _pool.add(new NullLiteral()); }
+
+    VExpr* predicate(TExprNodeType::type node_type, const std::string& function_name,
+                     const std::vector<VExpr*>& children) {
+        TExprNode node;
+        node.__set_node_type(node_type);
+        node.__set_type(TypeDescriptor(TYPE_BOOLEAN).to_thrift());
+        TFunction fn;
+        fn.name.function_name = function_name;
+        node.__set_fn(fn);
+        VExpr* expr = _pool.add(new VectorizedFnCall(node));
+        for (auto child : children) {
+            expr->add_child(child);
+        }
+        return expr;
+    }
+
+    VExpr* in_predicate(bool is_not_in, const std::vector<VExpr*>& children) {
+        TExprNode node;
+        node.__set_node_type(TExprNodeType::IN_PRED);
+        node.__set_opcode(is_not_in ? TExprOpcode::FILTER_NOT_IN : TExprOpcode::FILTER_IN);
+        node.__set_type(TypeDescriptor(TYPE_BOOLEAN).to_thrift());
+        TInPredicate t_in_predicate;
+        t_in_predicate.__set_is_not_in(is_not_in);
+        node.__set_in_predicate(t_in_predicate);
+        VExpr* expr = _pool.add(new VInPredicate(node));
+        for (auto child : children) {
+            expr->add_child(child);
+        }
+        return expr;
+    }
+
+    // The filter the conjunct is pushed down to the storage as, or nullptr if it is not.
+    std::unique_ptr<TCondition> to_olap_filter(VExpr* conjunct) {
+        std::unique_ptr<TCondition> filter(new TCondition());
+        if (!_node->_to_olap_filter(conjunct, filter.get())) {
+            return nullptr;
+        }
+        return filter;
+    }
+
+    void check_filter(VExpr* conjunct, const std::string& column_name, const std::string& op,
+                      const std::vector<std::string>& values) {
+        auto filter = to_olap_filter(conjunct);
+        ASSERT_NE(nullptr, filter);
+        ASSERT_EQ(column_name, filter->column_name);
+        ASSERT_EQ(op, filter->condition_op);
+        ASSERT_EQ(values, filter->condition_values);
+    }
+
+    RuntimeFilter* int_filter(SlotId slot_id, const std::vector<int32_t>& values) {
+        auto filter = _pool.add(new RuntimeFilter(slot_id, TYPE_INT, values.size()));
+        EXPECT_TRUE(filter->init().ok());
+        for (int32_t value : values) {
+            filter->insert(&value);
+        }
+        return filter;
+    }
+
+    ObjectPool _pool;
+    DescriptorTbl* _desc_tbl = nullptr;
+    std::unique_ptr<VOlapScanNode> _node;
+};
+
+TEST_F(VOlapScanNodeTest, comparisons) {
+    const std::vector<std::pair<std::string, std::string>> ops = {
+            {"eq", "*="}, {"ne", "!*="}, {"lt", "<<"}, {"le", "<="}, {"gt", ">>"}, {"ge", ">="}};
+    for (const auto& [function_name, op] : ops) {
+        check_filter(predicate(TExprNodeType::BINARY_PRED, function_name,
+                               {slot(0), int_literal(10)}),
+                     "k1", op, {"10"});
+    }
+}
+
+TEST_F(VOlapScanNodeTest, reversed_comparisons) {
+    // 10 < k1 is k1 > 10
+    const std::vector<std::pair<std::string, std::string>> ops = {
+            {"eq", "*="}, {"ne", "!*="}, {"lt", ">>"}, {"le", ">="}, {"gt", "<<"}, {"ge", "<="}};
+    for (const auto& [function_name, op] : ops) {
+        check_filter(predicate(TExprNodeType::BINARY_PRED, function_name,
+                               {int_literal(10), slot(0)}),
+                     "k1", op, {"10"});
+    }
+}
+
+TEST_F(VOlapScanNodeTest, in_predicates) {
+    check_filter(in_predicate(false, {slot(0), int_literal(1), int_literal(2)}), "k1", "*=",
+                 {"1", "2"});
+    check_filter(in_predicate(true, {slot(0), int_literal(1), int_literal(2)}), "k1", "!*=",
+                 {"1", "2"});
+
+    // no row is equal to NULL
+    check_filter(in_predicate(false, {slot(0), int_literal(1), null_literal(), int_literal(2)}),
+                 "k1", "*=", {"1", "2"});
+    ASSERT_EQ(nullptr, to_olap_filter(in_predicate(false, {slot(0), null_literal()})));
+    // k1 NOT IN (1, NULL) is never true, the storage would return the rows other than 1
+    ASSERT_EQ(nullptr, to_olap_filter(in_predicate(true, {slot(0), int_literal(1),
+                                                          null_literal()})));
+}
+
+TEST_F(VOlapScanNodeTest, value_columns) {
+    // the values of a key are only known after the merge of its rows
+    for (const std::string& function_name : {"eq", "ne", "lt", "le", "gt", "ge"}) {
+        ASSERT_EQ(nullptr, to_olap_filter(predicate(TExprNodeType::BINARY_PRED, function_name,
+                                                    {slot(2), int_literal(10)})));
+        ASSERT_EQ(nullptr, to_olap_filter(predicate(TExprNodeType::BINARY_PRED, function_name,
+                                                    {int_literal(10), slot(2)})));
+    }
+    ASSERT_EQ(nullptr, to_olap_filter(in_predicate(false, {slot(2), int_literal(1)})));
+    ASSERT_EQ(nullptr, to_olap_filter(in_predicate(true, {slot(2), int_literal(1)})));
+    ASSERT_EQ(nullptr, to_olap_filter(predicate(TExprNodeType::FUNCTION_CALL, "is_null_pred",
+                                                {slot(2)})));
+}
+
+TEST_F(VOlapScanNodeTest, boolean_in_predicates) {
+    // the storage has no list predicate of booleans
+    ASSERT_EQ(nullptr, to_olap_filter(in_predicate(false, {slot(1), bool_literal(true),
+                                                           bool_literal(false)})));
+    ASSERT_EQ(nullptr, to_olap_filter(in_predicate(true, {slot(1), bool_literal(true),
+                                                          bool_literal(false)})));
+    // while a single value is a comparison
+    check_filter(in_predicate(false, {slot(1), bool_literal(true)}), "kb", "*=", {"1"});
+    check_filter(in_predicate(true, {slot(1), bool_literal(false)}), "kb", "!*=", {"0"});
+    check_filter(in_predicate(false, {slot(1), bool_literal(true), null_literal()}), "kb", "*=",
+                 {"1"});
+    check_filter(predicate(TExprNodeType::BINARY_PRED, "eq", {slot(1), bool_literal(true)}),
+                 "kb", "*=", {"1"});
+}
+
+TEST_F(VOlapScanNodeTest, push_down_conjunct) {
+    VExpr* pushed = predicate(TExprNodeType::BINARY_PRED, "gt", {slot(0), int_literal(1)});
+    VExpr* not_pushed =
+            in_predicate(false, {slot(1), bool_literal(true), bool_literal(false)});
+    VExpr* conjunct = predicate(TExprNodeType::COMPOUND_PRED, "and", {pushed, not_pushed});
+
+    // only the conjuncts made constant are filtered by the storage instead
+    ASSERT_FALSE(_node->_push_down_vconjunct(conjunct));
+    ASSERT_NE(nullptr, pushed->get_const_col());
+    ASSERT_EQ(nullptr, not_pushed->get_const_col());
+    ASSERT_EQ(nullptr, conjunct->get_const_col());
+    ASSERT_EQ(1, _node->_olap_filter.size());
+    ASSERT_EQ("k1", _node->_olap_filter[0].column_name);
+    ASSERT_EQ(">>", _node->_olap_filter[0].condition_op);
+}
+
+TEST_F(VOlapScanNodeTest, push_down_runtime_filters) {
+    RuntimeState state {TQueryGlobals()};
+    state.set_desc_tbl(_desc_tbl);
+    // the slot 3 is not one of the scanned tuple
+    RuntimeFilter* k1_filter = int_filter(0, {1});
+    RuntimeFilter* other_filter = int_filter(3, {1});
+    std::vector<RuntimeFilter*> filters = {k1_filter, other_filter};
+    _node->push_down_runtime_filters(&state, &filters);
+    ASSERT_EQ(std::vector<RuntimeFilter*>({other_filter}), filters);
+    ASSERT_EQ(std::vector<RuntimeFilter*>({k1_filter}), _node->_runtime_filters);
+
+    // the conditions of the scan are fixed once it starts
+    _node->_runtime_filters_applied = true;
+    filters = {int_filter(2, {1})};
+    _node->push_down_runtime_filters(&state, &filters);
+    ASSERT_EQ(1, filters.size());
+    ASSERT_EQ(std::vector<RuntimeFilter*>({k1_filter}), _node->_runtime_filters);
+}
+
+TEST_F(VOlapScanNodeTest, normalize_runtime_filters) {
+    SlotDescriptor* k1 = _desc_tbl->get_slot_descriptor(0);
+    RuntimeFilter* filter = int_filter(0, {9, 3, 5, 3});
+    _node->_runtime_filters = {int_filter(2, {100}), filter};
+
+    // few values become an IN condition, intersected with the other conditions of k1
+    ColumnValueRange<int32_t> range("k1", TYPE_INT);
+    ASSERT_TRUE(range.add_range(FILTER_LARGER, 3).ok());
+    ASSERT_TRUE(_node->normalize_runtime_filters(k1, &range).ok());
+    ASSERT_TRUE(range.is_fixed_value_range());
+    ASSERT_EQ(std::set<int32_t>({5, 9}), range.get_fixed_value_set());
+    ASSERT_TRUE(_node->_bloom_filters.empty());
+
+    // more values than can be pushed down become a range and a bloom filter
+    _node->_max_pushdown_conditions_per_column = 2;
+    range = ColumnValueRange<int32_t>("k1", TYPE_INT);
+    ASSERT_TRUE(_node->normalize_runtime_filters(k1, &range).ok());
+    ASSERT_FALSE(range.is_fixed_value_range());
+    ASSERT_EQ(3, range.get_range_min_value());
+    ASSERT_EQ(9, range.get_range_max_value());
+    ASSERT_FALSE(range.contain_null());
+    ASSERT_EQ(1, _node->_bloom_filters.size());
+    ASSERT_EQ("k1", _node->_bloom_filters[0].first);
+    ASSERT_EQ(filter->bloom_filter(), _node->_bloom_filters[0].second);
+
+    // as do the values of a filter which has too many of them
+    int32_t max_in_num = config::runtime_filter_max_in_num;
+    config::runtime_filter_max_in_num = 2;
+    _node->_max_pushdown_conditions_per_column = 1024;
+    _node->_bloom_filters.clear();
+    _node->_runtime_filters = {int_filter(0, {4, -1, 7})};
+    config::runtime_filter_max_in_num = max_in_num;
+    range = ColumnValueRange<int32_t>("k1", TYPE_INT);
+    ASSERT_TRUE(_node->normalize_runtime_filters(k1, &range).ok());
+    ASSERT_FALSE(range.is_fixed_value_range());
+    ASSERT_EQ(-1, range.get_range_min_value());
+    ASSERT_EQ(7, range.get_range_max_value());
+    ASSERT_EQ(1, _node->_bloom_filters.size());
+
+    // the range of the filter may be empty with the other conditions of k1
+    _node->_bloom_filters.clear();
+    range = ColumnValueRange<int32_t>("k1", TYPE_INT);
+    ASSERT_TRUE(range.add_range(FILTER_LARGER, 7).ok());
+    ASSERT_TRUE(_node->normalize_runtime_filters(k1, &range).ok());
+    ASSERT_TRUE(range.is_empty_value_range());
+}
+
+} // namespace doris::vectorized
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,149 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/spill_stream.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "runtime/tmp_file_mgr.h"
+#include "util/disk_info.h"
+#include "util/filesystem_util.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/columns_number.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_types_number.h"
+#include "vec/data_types/data_type_string.h"
+
+namespace doris::vectorized {
+
+class VSpillStreamTest : public testing::Test {
+public:
+    void SetUp() override {
+        _tmp_dirs = {"/tmp/vspill-stream-test"};
+        ASSERT_TRUE(FileSystemUtil::create_directory(_tmp_dirs[0]).ok());
+        DiskInfo::init();
+        ASSERT_TRUE(_tmp_file_mgr.init_custom(_tmp_dirs, false).ok());
+    }
+
+    void TearDown() override { FileSystemUtil::remove_paths(_tmp_dirs); }
+
+protected:
+    // rows [begin, end) of a block of an Int64, a string and a nullable Int64 column
+    static Block create_block(int64_t begin, int64_t end) {
+        auto ints = ColumnInt64::create();
+        auto strings = ColumnString::create();
+        auto nullable_ints = ColumnNullable::create(ColumnInt64::create(), ColumnUInt8::create());
+        for (int64_t i = begin; i < end; ++i) {
+            ints->insertValue(i);
+            std::string value = "value-" + std::to_string(i);
+            strings->insertData(value.data(), value.size());
+            if (i % 3 == 0) {
+                nullable_ints->insertDefault();
+            } else {
+                nullable_ints->insert(Field(i * 2));
+            }
+        }
+        auto int_type = std::make_shared<DataTypeInt64>();
+        return Block({{std::move(ints), int_type, "i"},
+                      {std::move(strings), std::make_shared<DataTypeString>(), "s"},
+                      {std::move(nullable_ints), makeNullable(int_type), "n"}});
+    }
+
+    static void check_rows(const Block& block, int64_t begin) {
+        for (size_t row = 0; row < block.rows(); ++row) {
+            int64_t i = begin + row;
+            ASSERT_EQ(i, block.getByPosition(0).column->getInt(row));
+            ASSERT_EQ("value-" + std::to_string(i),
+                      block.getByPosition(1).column->getDataAt(row).toString());
+            const auto& nullable = block.getByPosition(2).column;
+            ASSERT_EQ(i % 3 == 0, nullable->isNullAt(row));
+            if (i % 3 != 0) {
+                ASSERT_EQ(i * 2, (*nullable)[row].get<Int64>());
+            }
+        }
+    }
+
+    std::vector<std::string> _tmp_dirs;
+    TmpFileMgr _tmp_file_mgr;
+};
+
+TEST_F(VSpillStreamTest, write_and_read) {
+    SpillStream stream(&_tmp_file_mgr, TUniqueId());
+    ASSERT_TRUE(stream.empty());
+    ASSERT_TRUE(stream.write_block(create_block(0, 100)).ok());
+    ASSERT_TRUE(stream.write_block(create_block(100, 100)).ok());
+    ASSERT_TRUE(stream.write_block(create_block(100, 150)).ok());
+    ASSERT_FALSE(stream.empty());
+    ASSERT_GT(stream.bytes_written(), 0);
+
+    // the blocks are read back in the order they were written, the empty one is skipped
+    bool eos = false;
+    Block block;
+    ASSERT_TRUE(stream.read_block(&block, &eos).ok());
+    ASSERT_FALSE(eos);
+    ASSERT_EQ(100, block.rows());
+    check_rows(block, 0);
+    ASSERT_TRUE(stream.read_block(&block, &eos).ok());
+    ASSERT_FALSE(eos);
+    ASSERT_EQ(50, block.rows());
+    check_rows(block, 100);
+    ASSERT_TRUE(stream.read_block(&block, &eos).ok());
+    ASSERT_TRUE(eos);
+    stream.close();
+}
+
+TEST_F(VSpillStreamTest, large_block_in_chunks) {
+    const size_t max_chunk_bytes = 1024;
+    const int64_t rows = 1000;
+    SpillStream stream(&_tmp_file_mgr, TUniqueId(), max_chunk_bytes);
+    Block written = create_block(0, rows);
+    ASSERT_TRUE(stream.write_block(written).ok());
+    ASSERT_GT(stream.bytes_written(), 10 * max_chunk_bytes);
+
+    // the rows of the block come back as several chunks of about max_chunk_bytes, a row is
+    // more than the 8 bytes of its Int64
+    int64_t read_rows = 0;
+    int chunks = 0;
+    bool eos = false;
+    while (true) {
+        Block block;
+        ASSERT_TRUE(stream.read_block(&block, &eos).ok());
+        if (eos) {
+            break;
+        }
+        ASSERT_GT(block.rows(), 0);
+        ASSERT_LE(block.rows(), max_chunk_bytes / 8 + 1);
+        check_rows(block, read_rows);
+        read_rows += block.rows();
+        ++chunks;
+    }
+    ASSERT_EQ(rows, read_rows);
+    ASSERT_GT(chunks, 10);
+    stream.close();
+    ASSERT_TRUE(stream.empty());
+}
+
+} // namespace doris::vectorized
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
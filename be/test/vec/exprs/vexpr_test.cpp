@@ -250,7 +250,7 @@ TEST(TEST_VEXPR, LITERALTEST) {
         VLiteral literal(create_literal<TYPE_BOOLEAN>(true));
         Block block;
         int ret = -1;
-        literal.execute(&block, &ret);
+        literal.execute(nullptr, &block, &ret);
         auto ctn = block.safeGetByPosition(ret);
         bool v = ctn.column->getBool(0);
         ASSERT_EQ(v, true);
@@ -259,7 +259,7 @@ TEST(TEST_VEXPR, LITERALTEST) {
         VLiteral literal(create_literal<TYPE_SMALLINT>(1024));
         Block block;
         int ret = -1;
-        literal.execute(&block, &ret);
+        literal.execute(nullptr, &block, &ret);
         auto ctn = block.safeGetByPosition(ret);
         auto v = ctn.column->getInt(0);
         ASSERT_EQ(v, 1024);
@@ -268,7 +268,7 @@ TEST(TEST_VEXPR, LITERALTEST) {
         VLiteral literal(create_literal<TYPE_INT>(1024));
         Block block;
         int ret = -1;
-        literal.execute(&block, &ret);
+        literal.execute(nullptr, &block, &ret);
         auto ctn = block.safeGetByPosition(ret);
         auto v = ctn.column->getInt(0);
         ASSERT_EQ(v, 1024);
@@ -277,7 +277,7 @@ TEST(TEST_VEXPR, LITERALTEST) {
         VLiteral literal(create_literal<TYPE_BIGINT>(1024));
         Block block;
         int ret = -1;
-        literal.execute(&block, &ret);
+        literal.execute(nullptr, &block, &ret);
         auto ctn = block.safeGetByPosition(ret);
         auto v = ctn.column->get64(0);
         ASSERT_EQ(v, 1024);
@@ -286,7 +286,7 @@ TEST(TEST_VEXPR, LITERALTEST) {
         VLiteral literal(create_literal<TYPE_LARGEINT, __int128_t>(1024));
         Block block;
         int ret = -1;
-        literal.execute(&block, &ret);
+        literal.execute(nullptr, &block, &ret);
         auto ctn = block.safeGetByPosition(ret);
         auto v = (*ctn.column)[0].get<__int128_t>();
         ASSERT_EQ(v, 1024);
@@ -295,7 +295,7 @@ TEST(TEST_VEXPR, LITERALTEST) {
         VLiteral literal(create_literal<TYPE_FLOAT, float>(1024.0f));
         Block block;
         int ret = -1;
-        literal.execute(&block, &ret);
+        literal.execute(nullptr, &block, &ret);
         auto ctn = block.safeGetByPosition(ret);
         auto v = (*ctn.column)[0].get<double>();
         ASSERT_FLOAT_EQ(v, 1024.0f);
@@ -304,7 +304,7 @@ TEST(TEST_VEXPR, LITERALTEST) {
         VLiteral literal(create_literal<TYPE_DOUBLE, double>(1024.0));
         Block block;
         int ret = -1;
-        literal.execute(&block, &ret);
+        literal.execute(nullptr, &block, &ret);
         auto ctn = block.safeGetByPosition(ret);
         auto v = (*ctn.column)[0].get<double>();
         ASSERT_FLOAT_EQ(v, 1024.0);
@@ -318,7 +318,7 @@ TEST(TEST_VEXPR, LITERALTEST) {
         VLiteral literal(create_literal<TYPE_DATETIME, std::string>(std::string(date)));
         Block block;
         int ret = -1;
-        literal.execute(&block, &ret);
+        literal.execute(nullptr, &block, &ret);
         auto ctn = block.safeGetByPosition(ret);
         auto v = (*ctn.column)[0].get<__int128_t>();
         ASSERT_EQ(v, dt);
@@ -327,13 +327,376 @@ TEST(TEST_VEXPR, LITERALTEST) {
         VLiteral literal(create_literal<TYPE_DECIMALV2, std::string>(std::string("1234.56")));
         Block block;
         int ret = -1;
-        literal.execute(&block, &ret);
+        literal.execute(nullptr, &block, &ret);
         auto ctn = block.safeGetByPosition(ret);
         auto v = (*ctn.column)[0].get<DecimalField<Decimal128>>();
         ASSERT_FLOAT_EQ(((double)v.getValue()) / (std::pow(10, v.getScale())), 1234.56);
     }
 }
 
+TEST(TEST_VEXPR, CASETEST) {
+    using namespace doris;
+    using namespace doris::vectorized;
+    SchemaScanner::ColumnDesc column_descs[] = {{"k1", TYPE_INT, sizeof(int32_t), false}};
+    SchemaScanner schema_scanner(column_descs, 1);
+    ObjectPool object_pool;
+    SchemaScannerParam param;
+    schema_scanner.init(&param, &object_pool);
+    auto tuple_desc = const_cast<TupleDescriptor*>(schema_scanner.tuple_desc());
+    RowDescriptor row_desc(tuple_desc, false);
+    auto tracker_ptr = MemTracker::CreateTracker(-1, "BlockTest", nullptr, false);
+    RowBatch row_batch(row_desc, 1024, tracker_ptr.get());
+
+    auto type_desc = [](TPrimitiveType::type type) {
+        TScalarType scalar_type;
+        scalar_type.__set_type(type);
+        std::vector<TTypeNode> type_nodes(1);
+        type_nodes[0].__set_scalar_type(scalar_type);
+        TTypeDesc type_desc;
+        type_desc.__set_types(type_nodes);
+        return type_desc;
+    };
+    auto slot_ref = [&]() {
+        TExprNode node;
+        node.__set_node_type(TExprNodeType::SLOT_REF);
+        node.__set_type(type_desc(TPrimitiveType::INT));
+        node.__set_num_children(0);
+        TSlotRef slot;
+        slot.__set_slot_id(0);
+        slot.__set_tuple_id(0);
+        node.__set_slot_ref(slot);
+        return node;
+    };
+    // CASE WHEN k1 > 0 THEN k1 ELSE 0 END
+    TExprNode case_node;
+    case_node.__set_node_type(TExprNodeType::CASE_EXPR);
+    case_node.__set_type(type_desc(TPrimitiveType::INT));
+    case_node.__set_num_children(3);
+    TCaseExpr case_expr;
+    case_expr.__set_has_case_expr(false);
+    case_expr.__set_has_else_expr(true);
+    case_node.__set_case_expr(case_expr);
+    TExprNode gt_node;
+    gt_node.__set_node_type(TExprNodeType::BINARY_PRED);
+    gt_node.__set_type(type_desc(TPrimitiveType::BOOLEAN));
+    gt_node.__set_num_children(2);
+    TFunction fn;
+    fn.name.__set_function_name("gt");
+    gt_node.__set_fn(fn);
+    TExpr exprx;
+    exprx.nodes = {case_node,  gt_node, slot_ref(), create_literal<TYPE_INT>(0),
+                   slot_ref(), create_literal<TYPE_INT>(0)};
+
+    VExprContext* context = nullptr;
+    ASSERT_TRUE(VExpr::create_expr_tree(&object_pool, exprx, &context).ok());
+
+    int32_t k1 = -100;
+    for (int i = 0; i < 1024; ++i, k1++) {
+        auto idx = row_batch.add_row();
+        TupleRow* tuple_row = row_batch.get_row(idx);
+        auto tuple = (Tuple*)(row_batch.tuple_data_pool()->allocate(tuple_desc->byte_size()));
+        auto slot_desc = tuple_desc->slots()[0];
+        memcpy(tuple->get_slot(slot_desc->tuple_offset()), &k1, slot_desc->slot_size());
+        tuple_row->set_tuple(0, tuple);
+        row_batch.commit_last_row();
+    }
+
+    RuntimeState runtime_stat(TUniqueId(), TQueryOptions(), TQueryGlobals(), nullptr);
+    runtime_stat.init_instance_mem_tracker();
+    DescriptorTbl desc_tbl;
+    desc_tbl._slot_desc_map[0] = tuple_desc->slots()[0];
+    runtime_stat.set_desc_tbl(&desc_tbl);
+    std::shared_ptr<MemTracker> tracker = MemTracker::CreateTracker();
+    ASSERT_TRUE(context->prepare(&runtime_stat, row_desc, tracker).ok());
+    ASSERT_TRUE(context->open(&runtime_stat).ok());
+
+    auto block = row_batch.convert_to_vec_block();
+    int ts = -1;
+    ASSERT_TRUE(context->execute(&block, &ts).ok());
+    const auto& column = *block.getByPosition(ts).column;
+    ASSERT_EQ(1024, column.size());
+    for (int i = 0; i < 1024; ++i) {
+        ASSERT_EQ(std::max(i - 100, 0), column.getInt(i));
+    }
+}
+
+TEST(TEST_VEXPR, COMMON_SUBEXPR_TEST) {
+    using namespace doris;
+    using namespace doris::vectorized;
+    SchemaScanner::ColumnDesc column_descs[] = {{"k1", TYPE_INT, sizeof(int32_t), false}};
+    SchemaScanner schema_scanner(column_descs, 1);
+    ObjectPool object_pool;
+    SchemaScannerParam param;
+    schema_scanner.init(&param, &object_pool);
+    auto tuple_desc = const_cast<TupleDescriptor*>(schema_scanner.tuple_desc());
+    RowDescriptor row_desc(tuple_desc, false);
+    auto tracker_ptr = MemTracker::CreateTracker(-1, "BlockTest", nullptr, false);
+    RowBatch row_batch(row_desc, 1024, tracker_ptr.get());
+
+    auto type_desc = [](TPrimitiveType::type type) {
+        TScalarType scalar_type;
+        scalar_type.__set_type(type);
+        std::vector<TTypeNode> type_nodes(1);
+        type_nodes[0].__set_scalar_type(scalar_type);
+        TTypeDesc type_desc;
+        type_desc.__set_types(type_nodes);
+        return type_desc;
+    };
+    auto slot_ref = [&]() {
+        TExprNode node;
+        node.__set_node_type(TExprNodeType::SLOT_REF);
+        node.__set_type(type_desc(TPrimitiveType::INT));
+        node.__set_num_children(0);
+        TSlotRef slot;
+        slot.__set_slot_id(0);
+        slot.__set_tuple_id(0);
+        node.__set_slot_ref(slot);
+        return node;
+    };
+    auto arithmetic = [&](const std::string& name, TPrimitiveType::type type) {
+        TExprNode node;
+        node.__set_node_type(TExprNodeType::ARITHMETIC_EXPR);
+        node.__set_type(type_desc(type));
+        node.__set_num_children(2);
+        TFunction fn;
+        fn.name.__set_function_name(name);
+        node.__set_fn(fn);
+        return node;
+    };
+    // (k1 + 1) * (k1 + 1) and k1 + 1
+    TExpr square;
+    square.nodes = {arithmetic("multiply", TPrimitiveType::BIGINT),
+                    arithmetic("add", TPrimitiveType::BIGINT),
+                    slot_ref(),
+                    create_literal<TYPE_INT>(1),
+                    arithmetic("add", TPrimitiveType::BIGINT),
+                    slot_ref(),
+                    create_literal<TYPE_INT>(1)};
+    TExpr plus_one;
+    plus_one.nodes = {arithmetic("add", TPrimitiveType::BIGINT), slot_ref(),
+                      create_literal<TYPE_INT>(1)};
+
+    std::vector<VExprContext*> contexts;
+    ASSERT_TRUE(VExpr::create_expr_trees(&object_pool, {square, plus_one}, &contexts).ok());
+
+    int32_t k1 = -100;
+    for (int i = 0; i < 1024; ++i, k1++) {
+        auto idx = row_batch.add_row();
+        TupleRow* tuple_row = row_batch.get_row(idx);
+        auto tuple = (Tuple*)(row_batch.tuple_data_pool()->allocate(tuple_desc->byte_size()));
+        auto slot_desc = tuple_desc->slots()[0];
+        memcpy(tuple->get_slot(slot_desc->tuple_offset()), &k1, slot_desc->slot_size());
+        tuple_row->set_tuple(0, tuple);
+        row_batch.commit_last_row();
+    }
+
+    RuntimeState runtime_stat(TUniqueId(), TQueryOptions(), TQueryGlobals(), nullptr);
+    runtime_stat.init_instance_mem_tracker();
+    DescriptorTbl desc_tbl;
+    desc_tbl._slot_desc_map[0] = tuple_desc->slots()[0];
+    runtime_stat.set_desc_tbl(&desc_tbl);
+    std::shared_ptr<MemTracker> tracker = MemTracker::CreateTracker();
+    ASSERT_TRUE(VExpr::prepare(contexts, &runtime_stat, row_desc, tracker).ok());
+    ASSERT_TRUE(VExpr::open(contexts, &runtime_stat).ok());
+
+    // k1 + 1 is computed once, and only the results are appended to the block
+    auto block = row_batch.convert_to_vec_block();
+    std::vector<int> result_column_ids;
+    ASSERT_TRUE(VExprContext::execute_exprs(contexts, &block, &result_column_ids).ok());
+    ASSERT_EQ(3, block.columns());
+    const auto& square_column = *block.getByPosition(result_column_ids[0]).column;
+    const auto& plus_one_column = *block.getByPosition(result_column_ids[1]).column;
+    for (int i = 0; i < 1024; ++i) {
+        ASSERT_EQ(i - 99, plus_one_column.getInt(i));
+        ASSERT_EQ((i - 99) * (i - 99), square_column.getInt(i));
+    }
+
+    // executed alone, the temporary k1 + 1 is dropped
+    block = row_batch.convert_to_vec_block();
+    int ts = -1;
+    ASSERT_TRUE(contexts[0]->execute(&block, &ts).ok());
+    ASSERT_EQ(2, block.columns());
+    ASSERT_EQ(1, ts);
+}
+
+TEST(TEST_VEXPR, CONSTANT_FOLDING_TEST) {
+    using namespace doris;
+    using namespace doris::vectorized;
+    SchemaScanner::ColumnDesc column_descs[] = {{"k1", TYPE_INT, sizeof(int32_t), false}};
+    SchemaScanner schema_scanner(column_descs, 1);
+    ObjectPool object_pool;
+    SchemaScannerParam param;
+    schema_scanner.init(&param, &object_pool);
+    auto tuple_desc = const_cast<TupleDescriptor*>(schema_scanner.tuple_desc());
+    RowDescriptor row_desc(tuple_desc, false);
+    auto tracker_ptr = MemTracker::CreateTracker(-1, "BlockTest", nullptr, false);
+    RowBatch row_batch(row_desc, 1024, tracker_ptr.get());
+
+    auto type_desc = [](TPrimitiveType::type type) {
+        TScalarType scalar_type;
+        scalar_type.__set_type(type);
+        std::vector<TTypeNode> type_nodes(1);
+        type_nodes[0].__set_scalar_type(scalar_type);
+        TTypeDesc type_desc;
+        type_desc.__set_types(type_nodes);
+        return type_desc;
+    };
+    TExprNode slot_ref;
+    slot_ref.__set_node_type(TExprNodeType::SLOT_REF);
+    slot_ref.__set_type(type_desc(TPrimitiveType::INT));
+    slot_ref.__set_num_children(0);
+    TSlotRef slot;
+    slot.__set_slot_id(0);
+    slot.__set_tuple_id(0);
+    slot_ref.__set_slot_ref(slot);
+    auto arithmetic = [&](const std::string& name) {
+        TExprNode node;
+        node.__set_node_type(TExprNodeType::ARITHMETIC_EXPR);
+        node.__set_type(type_desc(TPrimitiveType::BIGINT));
+        node.__set_num_children(2);
+        TFunction fn;
+        fn.name.__set_function_name(name);
+        node.__set_fn(fn);
+        return node;
+    };
+    // k1 * (2 + 3) and 2 + 3
+    TExpr product;
+    product.nodes = {arithmetic("multiply"), slot_ref, arithmetic("add"),
+                     create_literal<TYPE_INT>(2), create_literal<TYPE_INT>(3)};
+    TExpr sum;
+    sum.nodes = {arithmetic("add"), create_literal<TYPE_INT>(2), create_literal<TYPE_INT>(3)};
+
+    std::vector<VExprContext*> contexts;
+    ASSERT_TRUE(VExpr::create_expr_trees(&object_pool, {product, sum}, &contexts).ok());
+
+    int32_t k1 = -100;
+    for (int i = 0; i < 1024; ++i, k1++) {
+        auto idx = row_batch.add_row();
+        TupleRow* tuple_row = row_batch.get_row(idx);
+        auto tuple = (Tuple*)(row_batch.tuple_data_pool()->allocate(tuple_desc->byte_size()));
+        auto slot_desc = tuple_desc->slots()[0];
+        memcpy(tuple->get_slot(slot_desc->tuple_offset()), &k1, slot_desc->slot_size());
+        tuple_row->set_tuple(0, tuple);
+        row_batch.commit_last_row();
+    }
+
+    RuntimeState runtime_stat(TUniqueId(), TQueryOptions(), TQueryGlobals(), nullptr);
+    runtime_stat.init_instance_mem_tracker();
+    DescriptorTbl desc_tbl;
+    desc_tbl._slot_desc_map[0] = tuple_desc->slots()[0];
+    runtime_stat.set_desc_tbl(&desc_tbl);
+    std::shared_ptr<MemTracker> tracker = MemTracker::CreateTracker();
+    ASSERT_TRUE(VExpr::prepare(contexts, &runtime_stat, row_desc, tracker).ok());
+    ASSERT_TRUE(VExpr::open(contexts, &runtime_stat).ok());
+    ASSERT_EQ(nullptr, contexts[0]->root()->get_const_col());
+    ASSERT_NE(nullptr, contexts[1]->root()->get_const_col());
+
+    auto block = row_batch.convert_to_vec_block();
+    std::vector<int> result_column_ids;
+    ASSERT_TRUE(VExprContext::execute_exprs(contexts, &block, &result_column_ids).ok());
+    const auto& product_column = *block.getByPosition(result_column_ids[0]).column;
+    const auto& sum_column = *block.getByPosition(result_column_ids[1]).column;
+    ASSERT_TRUE(isColumnConst(sum_column));
+    ASSERT_EQ(1024, sum_column.size());
+    for (int i = 0; i < 1024; ++i) {
+        ASSERT_EQ((i - 100) * 5, product_column.getInt(i));
+        ASSERT_EQ(5, sum_column.getInt(i));
+    }
+}
+
+TEST(TEST_VEXPR, CONJUNCTS_TEST) {
+    using namespace doris;
+    using namespace doris::vectorized;
+    SchemaScanner::ColumnDesc column_descs[] = {{"k1", TYPE_INT, sizeof(int32_t), false}};
+    SchemaScanner schema_scanner(column_descs, 1);
+    ObjectPool object_pool;
+    SchemaScannerParam param;
+    schema_scanner.init(&param, &object_pool);
+    auto tuple_desc = const_cast<TupleDescriptor*>(schema_scanner.tuple_desc());
+    RowDescriptor row_desc(tuple_desc, false);
+    auto tracker_ptr = MemTracker::CreateTracker(-1, "BlockTest", nullptr, false);
+    RowBatch row_batch(row_desc, 1024, tracker_ptr.get());
+
+    auto type_desc = [](TPrimitiveType::type type) {
+        TScalarType scalar_type;
+        scalar_type.__set_type(type);
+        std::vector<TTypeNode> type_nodes(1);
+        type_nodes[0].__set_scalar_type(scalar_type);
+        TTypeDesc type_desc;
+        type_desc.__set_types(type_nodes);
+        return type_desc;
+    };
+    TExprNode slot_ref;
+    slot_ref.__set_node_type(TExprNodeType::SLOT_REF);
+    slot_ref.__set_type(type_desc(TPrimitiveType::INT));
+    slot_ref.__set_num_children(0);
+    TSlotRef slot;
+    slot.__set_slot_id(0);
+    slot.__set_tuple_id(0);
+    slot_ref.__set_slot_ref(slot);
+    auto predicate = [&](TExprNodeType::type node_type, const std::string& name) {
+        TExprNode node;
+        node.__set_node_type(node_type);
+        node.__set_type(type_desc(TPrimitiveType::BOOLEAN));
+        node.__set_num_children(2);
+        TFunction fn;
+        fn.name.__set_function_name(name);
+        node.__set_fn(fn);
+        return node;
+    };
+    // k1 > 500 and k1 < 510 and k1 != 505, the next conjuncts run on the rows k1 > 500 keeps
+    TExpr conjuncts;
+    conjuncts.nodes = {predicate(TExprNodeType::COMPOUND_PRED, "and"),
+                       predicate(TExprNodeType::COMPOUND_PRED, "and"),
+                       predicate(TExprNodeType::BINARY_PRED, "gt"),
+                       slot_ref,
+                       create_literal<TYPE_INT>(500),
+                       predicate(TExprNodeType::BINARY_PRED, "lt"),
+                       slot_ref,
+                       create_literal<TYPE_INT>(510),
+                       predicate(TExprNodeType::BINARY_PRED, "ne"),
+                       slot_ref,
+                       create_literal<TYPE_INT>(505)};
+    VExprContext* context = nullptr;
+    ASSERT_TRUE(VExpr::create_expr_tree(&object_pool, conjuncts, &context).ok());
+
+    int32_t k1 = -100;
+    for (int i = 0; i < 1024; ++i, k1++) {
+        auto idx = row_batch.add_row();
+        TupleRow* tuple_row = row_batch.get_row(idx);
+        auto tuple = (Tuple*)(row_batch.tuple_data_pool()->allocate(tuple_desc->byte_size()));
+        auto slot_desc = tuple_desc->slots()[0];
+        memcpy(tuple->get_slot(slot_desc->tuple_offset()), &k1, slot_desc->slot_size());
+        tuple_row->set_tuple(0, tuple);
+        row_batch.commit_last_row();
+    }
+
+    RuntimeState runtime_stat(TUniqueId(), TQueryOptions(), TQueryGlobals(), nullptr);
+    runtime_stat.init_instance_mem_tracker();
+    DescriptorTbl desc_tbl;
+    desc_tbl._slot_desc_map[0] = tuple_desc->slots()[0];
+    runtime_stat.set_desc_tbl(&desc_tbl);
+    std::shared_ptr<MemTracker> tracker = MemTracker::CreateTracker();
+    ASSERT_TRUE(context->prepare(&runtime_stat, row_desc, tracker).ok());
+    ASSERT_TRUE(context->open(&runtime_stat).ok());
+
+    // the block is only filtered once, by the caller
+    auto block = row_batch.convert_to_vec_block();
+    IColumn::Filter filter;
+    ASSERT_TRUE(context->execute_conjuncts(&block, &filter).ok());
+    ASSERT_EQ(1, block.columns());
+    ASSERT_EQ(1024, block.rows());
+    ASSERT_EQ(1024, filter.size());
+    for (int i = 0; i < 1024; ++i) {
+        k1 = i - 100;
+        ASSERT_EQ(k1 > 500 && k1 < 510 && k1 != 505, filter[i]);
+    }
+    Block::filter_block(&block, filter, 1);
+    ASSERT_EQ(8, block.rows());
+    ASSERT_EQ(501, block.getByPosition(0).column->getInt(0));
+    ASSERT_EQ(509, block.getByPosition(0).column->getInt(7));
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,148 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "vec/columns/column_const.h"
+#include "vec/columns/column_decimal.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_types_decimal.h"
+#include "vec/data_types/data_types_number.h"
+#include "vec/functions/simple_function_factory.h"
+
+namespace doris::vectorized {
+
+// Execute the function name on the first two columns of block, return the result column.
+static ColumnPtr execute_binary_function(const std::string& name, Block& block) {
+    ColumnNumbers arguments = {0, 1};
+    ColumnsWithTypeAndName ctn = {block.getByPosition(0), block.getByPosition(1)};
+    auto function = SimpleFunctionFactory::instance().get_function(name, ctn);
+    EXPECT_TRUE(function != nullptr);
+    size_t result = block.columns();
+    block.insert({nullptr, function->getReturnType(), name});
+    function->execute(block, arguments, result, block.rows(), false);
+    return block.getByPosition(result).column->convertToFullColumnIfConst();
+}
+
+TEST(ArithmeticTest, IntegerTest) {
+    auto k1 = ColumnInt32::create();
+    auto k2 = ColumnInt64::create();
+    for (int i = 0; i < 1024; ++i) {
+        k1->insert(i - 100);
+        k2->insert(Int64(i) * 3);
+    }
+    Block block({{std::move(k1), std::make_shared<DataTypeInt32>(), "k1"},
+                 {std::move(k2), std::make_shared<DataTypeInt64>(), "k2"}});
+
+    auto plus = execute_binary_function("add", block);
+    auto minus = execute_binary_function("subtract", block);
+    auto multiply = execute_binary_function("multiply", block);
+    for (int i = 0; i < 1024; ++i) {
+        ASSERT_EQ(plus->getInt(i), i - 100 + Int64(i) * 3);
+        ASSERT_EQ(minus->getInt(i), i - 100 - Int64(i) * 3);
+        ASSERT_EQ(multiply->getInt(i), (i - 100) * Int64(i) * 3);
+    }
+
+    // the wrap on overflow is the same as the row engine
+    Block wrap_block({{ColumnInt32::create(1, INT32_MAX), std::make_shared<DataTypeInt32>(), "k1"},
+                      {ColumnInt32::create(1, 1), std::make_shared<DataTypeInt32>(), "k2"}});
+    ASSERT_EQ(execute_binary_function("add", wrap_block)->getInt(0), INT32_MIN);
+}
+
+TEST(ArithmeticTest, DivisionByZeroTest) {
+    auto k1 = ColumnInt32::create();
+    auto k2 = ColumnInt32::create();
+    for (int i = 0; i < 100; ++i) {
+        k1->insert(i == 0 ? INT32_MIN : i * 7);
+        k2->insert(i % 5 - 1);
+    }
+    Block block({{std::move(k1), std::make_shared<DataTypeInt32>(), "k1"},
+                 {std::move(k2), std::make_shared<DataTypeInt32>(), "k2"}});
+
+    for (const auto& name : {"int_divide", "mod"}) {
+        auto result = execute_binary_function(name, block);
+        auto& nullable = assert_cast<const ColumnNullable&>(*result);
+        for (int i = 0; i < 100; ++i) {
+            Int64 a = i == 0 ? INT32_MIN : i * 7;
+            Int64 b = i % 5 - 1;
+            ASSERT_EQ(nullable.isNullAt(i), b == 0);
+            if (b == 0) continue;
+            Int64 expected = std::string(name) == "mod" ? a % b : Int32(a / b);
+            ASSERT_EQ(nullable.getNestedColumn().getInt(i), expected);
+        }
+    }
+
+    // a constant divisor
+    auto k3 = ColumnFloat64::create();
+    for (int i = 0; i < 10; ++i) {
+        k3->insert(i * 1.5);
+    }
+    Block const_block({{std::move(k3), std::make_shared<DataTypeFloat64>(), "k3"},
+                       {ColumnConst::create(ColumnFloat64::create(1, 0.0), 10),
+                        std::make_shared<DataTypeFloat64>(), "zero"}});
+    auto result = execute_binary_function("divide", const_block);
+    ASSERT_EQ(result->size(), 10);
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_TRUE(result->isNullAt(i));
+    }
+}
+
+TEST(ArithmeticTest, DecimalTest) {
+    auto type = std::make_shared<DataTypeDecimal<Decimal128>>(27, 9);
+    auto k1 = ColumnDecimal<Decimal128>::create(0, 9);
+    auto k2 = ColumnDecimal<Decimal128>::create(0, 9);
+    // 1.5 and 2.25
+    k1->getData().push_back(Decimal128(1500000000));
+    k2->getData().push_back(Decimal128(2250000000));
+    // -1 and 3
+    k1->getData().push_back(Decimal128(-1000000000));
+    k2->getData().push_back(Decimal128(3000000000));
+    Block block({{std::move(k1), type, "k1"}, {std::move(k2), type, "k2"}});
+
+    auto get = [](const ColumnPtr& column, size_t i) {
+        return assert_cast<const ColumnDecimal<Decimal128>&>(*column).getData()[i].value;
+    };
+    auto plus = execute_binary_function("add", block);
+    ASSERT_EQ(get(plus, 0), 3750000000);
+    ASSERT_EQ(get(plus, 1), 2000000000);
+    auto multiply = execute_binary_function("multiply", block);
+    ASSERT_EQ(get(multiply, 0), 3375000000);
+    ASSERT_EQ(get(multiply, 1), -3000000000);
+    auto divide = execute_binary_function("divide", block);
+    auto& divide_nested = assert_cast<const ColumnNullable&>(*divide).getNestedColumnPtr();
+    // rounded half up like DecimalV2Value
+    ASSERT_EQ(get(divide_nested, 0), 666666667);
+    ASSERT_EQ(get(divide_nested, 1), -333333333);
+
+    // the decimal overflow throws
+    auto k3 = ColumnDecimal<Decimal128>::create(0, 9);
+    k3->getData().push_back(Decimal128(Int128(1) << 100));
+    auto k4 = ColumnDecimal<Decimal128>::create(0, 9);
+    k4->getData().push_back(Decimal128(Int128(1) << 100));
+    Block overflow_block({{std::move(k3), type, "k3"}, {std::move(k4), type, "k4"}});
+    ASSERT_THROW(execute_binary_function("multiply", overflow_block), Exception);
+}
+
+} // namespace doris::vectorized
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -23,6 +23,10 @@
 #include "exec/schema_scanner.h"
 #include "runtime/row_batch.h"
 #include "runtime/tuple_row.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_types_number.h"
 #include "vec/functions/simple_function_factory.h"
 
 namespace doris {
@@ -138,6 +142,38 @@ TEST(ComparisonTest, ComparisonFunctionTest) {
     }
 }
 
+TEST(ComparisonTest, IsNullFunctionTest) {
+    using namespace doris::vectorized;
+    auto nested = ColumnInt32::create();
+    auto null_map = ColumnUInt8::create();
+    for (int32_t i = 0; i < 4; ++i) {
+        nested->insertValue(i);
+        null_map->insertValue(i % 2);
+    }
+    Block block({{ColumnNullable::create(std::move(nested), std::move(null_map)),
+                  makeNullable(std::make_shared<DataTypeInt32>()), "k1"},
+                 {ColumnInt32::create(4, 1), std::make_shared<DataTypeInt32>(), "k2"}});
+
+    for (std::string name : {"is_null_pred", "is_not_null_pred"}) {
+        bool negative = name == "is_not_null_pred";
+        for (size_t argument = 0; argument < 2; ++argument) {
+            auto function = SimpleFunctionFactory::instance().get_function(
+                    name, {block.getByPosition(argument)});
+            ASSERT_TRUE(function != nullptr);
+            size_t result = block.columns();
+            block.insert({nullptr, function->getReturnType(), name});
+            function->execute(block, {argument}, result, 4, false);
+            ColumnPtr column = block.getByPosition(result).column;
+            for (size_t i = 0; i < 4; ++i) {
+                // k2 is not nullable
+                bool is_null = argument == 0 && i % 2 == 1;
+                ASSERT_EQ(column->getBool(i), is_null != negative);
+            }
+            block.erase(result);
+        }
+    }
+}
+
 } // namespace doris
 
 int main(int argc, char** argv) {
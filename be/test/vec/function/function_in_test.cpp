@@ -0,0 +1,129 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "vec/columns/column_const.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/columns_number.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_string.h"
+#include "vec/data_types/data_types_number.h"
+#include "vec/functions/simple_function_factory.h"
+
+namespace doris::vectorized {
+
+// -1 for a NULL result
+using Result = std::vector<int>;
+
+// Executes name(x, list...), x is the first column of block, the list the constants values.
+static Result execute_in(const std::string& name, Block block, const std::vector<Field>& values) {
+    const auto& x = block.getByPosition(0);
+    auto type = removeNullable(x.type);
+    ColumnsWithTypeAndName arguments = {x};
+    for (const auto& value : values) {
+        if (value.isNull()) {
+            auto null_type = makeNullable(type);
+            arguments.push_back({null_type->createColumnConst(1, value), null_type, "null"});
+        } else {
+            arguments.push_back({type->createColumnConst(1, value), type, "value"});
+        }
+    }
+    auto function = SimpleFunctionFactory::instance().get_function(name, arguments);
+    EXPECT_TRUE(function != nullptr);
+    size_t rows = x.column->size();
+    block.insert({nullptr, function->getReturnType(), name});
+    function->execute(block, {0}, 1, rows, false);
+
+    Result result;
+    const auto& column = *block.getByPosition(1).column;
+    for (size_t i = 0; i < rows; ++i) {
+        result.push_back(column.isNullAt(i) ? -1 : column.getBool(i));
+    }
+    return result;
+}
+
+static Block create_int_block(const std::vector<Int32>& values) {
+    auto column = ColumnInt32::create();
+    for (auto value : values) column->insertValue(value);
+    return Block({{std::move(column), std::make_shared<DataTypeInt32>(), "x"}});
+}
+
+TEST(FunctionInTest, int_in) {
+    std::vector<Int32> x = {1, 2, 3, 4, 100, -5};
+    // linear compare
+    std::vector<Field> list = {Int64(3), Int64(1), Int64(-5), Int64(3)};
+    EXPECT_EQ(Result({1, 0, 1, 0, 0, 1}), execute_in("in", create_int_block(x), list));
+    EXPECT_EQ(Result({0, 1, 0, 1, 1, 0}), execute_in("not_in", create_int_block(x), list));
+
+    // hash set
+    list.clear();
+    for (Int64 i = 0; i < 20; ++i) list.push_back(i * 5);
+    EXPECT_EQ(Result({0, 0, 0, 0, 0, 0}), execute_in("in", create_int_block(x), list));
+    list.push_back(Int64(4));
+    list.push_back(Int64(2));
+    EXPECT_EQ(Result({0, 1, 0, 1, 0, 0}), execute_in("in", create_int_block(x), list));
+    EXPECT_EQ(Result({1, 0, 1, 0, 1, 1}), execute_in("not_in", create_int_block(x), list));
+    list.push_back(Int64(100));
+    EXPECT_EQ(Result({0, 1, 0, 1, 1, 0}), execute_in("in", create_int_block(x), list));
+}
+
+TEST(FunctionInTest, string_in) {
+    auto column = ColumnString::create();
+    for (std::string str : {"", "a", "abc", "abcd", "b"}) {
+        column->insertData(str.data(), str.size());
+    }
+    Block block({{std::move(column), std::make_shared<DataTypeString>(), "x"}});
+    std::vector<Field> list = {String("abc"), String(""), String("b"), String("ab")};
+    EXPECT_EQ(Result({1, 0, 1, 0, 1}), execute_in("in", block, list));
+    EXPECT_EQ(Result({0, 1, 0, 1, 0}), execute_in("not_in", block, list));
+}
+
+TEST(FunctionInTest, null) {
+    std::vector<Field> list = {Int64(1), Int64(3)};
+    std::vector<Field> list_with_null = {Int64(1), Null(), Int64(3)};
+
+    // x NOT IN (..., NULL) is never true
+    EXPECT_EQ(Result({1, -1, 1, -1}), execute_in("in", create_int_block({1, 2, 3, 4}),
+                                                 list_with_null));
+    EXPECT_EQ(Result({0, -1, 0, -1}), execute_in("not_in", create_int_block({1, 2, 3, 4}),
+                                                 list_with_null));
+
+    auto nested = ColumnInt32::create();
+    auto null_map = ColumnUInt8::create();
+    for (Int32 i = 1; i <= 4; ++i) {
+        nested->insertValue(i);
+        null_map->insertValue(i == 3);
+    }
+    Block block({{ColumnNullable::create(std::move(nested), std::move(null_map)),
+                  makeNullable(std::make_shared<DataTypeInt32>()), "x"}});
+    EXPECT_EQ(Result({1, 0, -1, 0}), execute_in("in", block, list));
+    EXPECT_EQ(Result({0, 1, -1, 1}), execute_in("not_in", block, list));
+    EXPECT_EQ(Result({1, -1, -1, -1}), execute_in("in", block, list_with_null));
+}
+
+} // namespace doris::vectorized
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
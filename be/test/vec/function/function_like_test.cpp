@@ -0,0 +1,123 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "vec/columns/column_const.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/columns_number.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_string.h"
+#include "vec/functions/like.h"
+#include "vec/functions/simple_function_factory.h"
+
+namespace doris::vectorized {
+
+static ColumnPtr create_string_column(const std::vector<std::string>& strs) {
+    auto column = ColumnString::create();
+    for (const auto& str : strs) {
+        column->insertData(str.data(), str.size());
+    }
+    return column;
+}
+
+// Execute name(strs, pattern), the pattern is a constant at prepare if const_pattern is true,
+// otherwise it is a String column of the pattern repeated.
+static std::vector<UInt8> execute_like(const std::string& name,
+                                       const std::vector<std::string>& strs,
+                                       const std::string& pattern, bool const_pattern = true) {
+    auto type = std::make_shared<DataTypeString>();
+    ColumnPtr col_pattern = ColumnConst::create(create_string_column({pattern}), strs.size());
+    if (!const_pattern) {
+        col_pattern = col_pattern->convertToFullColumnIfConst();
+    }
+    Block block({{create_string_column(strs), type, "str"}, {col_pattern, type, "pattern"}});
+    auto function = SimpleFunctionFactory::instance().get_function(
+            name, {block.getByPosition(0), block.getByPosition(1)});
+    EXPECT_TRUE(function != nullptr);
+    block.insert({nullptr, function->getReturnType(), name});
+    function->execute(block, {0, 1}, 2, strs.size(), false);
+
+    auto& res = assert_cast<const ColumnUInt8&>(*block.getByPosition(2).column).getData();
+    return std::vector<UInt8>(res.begin(), res.end());
+}
+
+TEST(FunctionLikeTest, classify_like) {
+    std::vector<std::pair<std::string, LikeSearcher::Kind>> patterns = {
+            {"abc", LikeSearcher::Kind::EQUALS},    {"abc%", LikeSearcher::Kind::STARTS_WITH},
+            {"%abc", LikeSearcher::Kind::ENDS_WITH}, {"%%abc%", LikeSearcher::Kind::SUBSTRING},
+            {"%", LikeSearcher::Kind::SUBSTRING},   {"a%c", LikeSearcher::Kind::REGEX},
+            {"a_c", LikeSearcher::Kind::REGEX}};
+    for (const auto& [pattern, kind] : patterns) {
+        EXPECT_EQ(kind, LikeSearcher::fromLikePattern(StringRef(pattern))->getKind()) << pattern;
+    }
+    EXPECT_EQ("a%b_", LikeSearcher::fromLikePattern(StringRef("%a\\%b\\_%"))->getNeedle());
+
+    patterns = {{"^abc$", LikeSearcher::Kind::EQUALS},
+                {"^abc.*", LikeSearcher::Kind::STARTS_WITH},
+                {".*abc$", LikeSearcher::Kind::ENDS_WITH},
+                {"abc", LikeSearcher::Kind::SUBSTRING},
+                {"a.c", LikeSearcher::Kind::REGEX}};
+    for (const auto& [pattern, kind] : patterns) {
+        EXPECT_EQ(kind, LikeSearcher::fromRegexpPattern(StringRef(pattern))->getKind())
+                << pattern;
+    }
+}
+
+TEST(FunctionLikeTest, like) {
+    std::vector<std::string> strs = {"", "abc", "xabc", "abcx", "xabcx", "ab", "a\nc", "a%c"};
+    std::vector<std::pair<std::string, std::vector<UInt8>>> cases = {
+            {"abc", {0, 1, 0, 0, 0, 0, 0, 0}},   {"abc%", {0, 1, 0, 1, 0, 0, 0, 0}},
+            {"%abc", {0, 1, 1, 0, 0, 0, 0, 0}},  {"%abc%", {0, 1, 1, 1, 1, 0, 0, 0}},
+            {"%", {1, 1, 1, 1, 1, 1, 1, 1}},     {"a_c", {0, 1, 0, 0, 0, 0, 1, 1}},
+            {"a\\%c", {0, 0, 0, 0, 0, 0, 0, 1}}, {"%b%x", {0, 0, 0, 1, 1, 0, 0, 0}},
+            {"a.c", {0, 0, 0, 0, 0, 0, 0, 0}}};
+    for (const auto& [pattern, expected] : cases) {
+        EXPECT_EQ(expected, execute_like("like", strs, pattern)) << pattern;
+        EXPECT_EQ(expected, execute_like("like", strs, pattern, false)) << pattern;
+    }
+}
+
+TEST(FunctionLikeTest, like_substring_across_rows) {
+    // the needle must not be found across the end of a row
+    std::vector<std::string> strs = {"xxer", "ror", "error", "", "err", "or error"};
+    EXPECT_EQ(std::vector<UInt8>({0, 0, 1, 0, 0, 1}), execute_like("like", strs, "%error%"));
+    EXPECT_EQ(std::vector<UInt8>({0, 1, 1, 0, 0, 1}), execute_like("like", strs, "%or%"));
+}
+
+TEST(FunctionLikeTest, regexp) {
+    std::vector<std::string> strs = {"", "abc", "xabc", "abcx", "a1c"};
+    std::vector<std::pair<std::string, std::vector<UInt8>>> cases = {
+            {"^abc$", {0, 1, 0, 0, 0}},  {"^abc", {0, 1, 0, 1, 0}}, {"abc$", {0, 1, 1, 0, 0}},
+            {"abc", {0, 1, 1, 1, 0}},    {"", {1, 1, 1, 1, 1}},     {"a[0-9]c", {0, 0, 0, 0, 1}},
+            {"^a.c$", {0, 1, 0, 0, 1}}};
+    for (const auto& [pattern, expected] : cases) {
+        EXPECT_EQ(expected, execute_like("regexp", strs, pattern)) << pattern;
+        EXPECT_EQ(expected, execute_like("regexp", strs, pattern, false)) << pattern;
+    }
+}
+
+} // namespace doris::vectorized
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,179 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "vec/columns/column_const.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/columns_number.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_string.h"
+#include "vec/data_types/data_types_number.h"
+#include "vec/functions/simple_function_factory.h"
+
+namespace doris::vectorized {
+
+static ColumnPtr create_string_column(const std::vector<std::string>& strs) {
+    auto column = ColumnString::create();
+    for (const auto& str : strs) {
+        column->insertData(str.data(), str.size());
+    }
+    return column;
+}
+
+static ColumnWithTypeAndName const_int(Int32 value, size_t rows) {
+    return {ColumnConst::create(ColumnInt32::create(1, value), rows),
+            std::make_shared<DataTypeInt32>(), std::to_string(value)};
+}
+
+static ColumnWithTypeAndName const_string(const std::string& value, size_t rows) {
+    return {ColumnConst::create(create_string_column({value}), rows),
+            std::make_shared<DataTypeString>(), value};
+}
+
+// Execute the function name on all the columns of a copy of arguments, return the result.
+static ColumnPtr execute_function(const std::string& name, const Block& arguments_block) {
+    Block block = arguments_block;
+    ColumnNumbers arguments;
+    ColumnsWithTypeAndName ctn;
+    for (size_t i = 0; i < block.columns(); ++i) {
+        arguments.push_back(i);
+        ctn.push_back(block.getByPosition(i));
+    }
+    auto function = SimpleFunctionFactory::instance().get_function(name, ctn);
+    EXPECT_TRUE(function != nullptr);
+    size_t result = block.columns();
+    block.insert({nullptr, function->getReturnType(), name});
+    function->execute(block, arguments, result, block.rows(), false);
+    return block.getByPosition(result).column->convertToFullColumnIfConst();
+}
+
+// The strings of a String or Nullable(String) column, "NULL" for the nulls.
+static std::vector<std::string> to_strings(const ColumnPtr& column) {
+    std::vector<std::string> res;
+    for (size_t i = 0; i < column->size(); ++i) {
+        if (column->isNullAt(i)) {
+            res.push_back("NULL");
+        } else if (column->isNullable()) {
+            auto& nested = assert_cast<const ColumnNullable&>(*column).getNestedColumn();
+            res.push_back(nested.getDataAt(i).toString());
+        } else {
+            res.push_back(column->getDataAt(i).toString());
+        }
+    }
+    return res;
+}
+
+static const std::vector<std::string> strs = {
+        "", "  Hello World ", "你好,世界", "a,b,,c",
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZ abcdefghijklmnopqrstuvwxyz"};
+
+TEST(StringFunctionTest, UnaryTest) {
+    Block block({{create_string_column(strs), std::make_shared<DataTypeString>(), "k1"}});
+
+    auto length = execute_function("length", block);
+    auto char_length = execute_function("character_length", block);
+    for (size_t i = 0; i < strs.size(); ++i) {
+        ASSERT_EQ(length->getInt(i), strs[i].size());
+    }
+    ASSERT_EQ(char_length->getInt(2), 5);
+    ASSERT_EQ(char_length->getInt(4), 53);
+
+    ASSERT_EQ(to_strings(execute_function("upper", block)),
+              std::vector<std::string>({"", "  HELLO WORLD ", "你好,世界", "A,B,,C",
+                                        "ABCDEFGHIJKLMNOPQRSTUVWXYZ ABCDEFGHIJKLMNOPQRSTUVWXYZ"}));
+    ASSERT_EQ(to_strings(execute_function("lcase", block)),
+              std::vector<std::string>({"", "  hello world ", "你好,世界", "a,b,,c",
+                                        "abcdefghijklmnopqrstuvwxyz abcdefghijklmnopqrstuvwxyz"}));
+    ASSERT_EQ(to_strings(execute_function("reverse", block))[2], "界世,好你");
+    ASSERT_EQ(to_strings(execute_function("trim", block))[1], "Hello World");
+    ASSERT_EQ(to_strings(execute_function("ltrim", block))[1], "Hello World ");
+    ASSERT_EQ(to_strings(execute_function("rtrim", block))[1], "  Hello World");
+}
+
+TEST(StringFunctionTest, SubstringTest) {
+    size_t rows = strs.size();
+    Block block({{create_string_column(strs), std::make_shared<DataTypeString>(), "k1"},
+                 const_int(2, rows), const_int(3, rows)});
+    ASSERT_EQ(to_strings(execute_function("substr", block)),
+              std::vector<std::string>({"NULL", " He", "好,世", ",b,", "BCD"}));
+
+    Block negative_block({{create_string_column(strs), std::make_shared<DataTypeString>(), "k1"},
+                          const_int(-2, rows)});
+    ASSERT_EQ(to_strings(execute_function("substring", negative_block)),
+              std::vector<std::string>({"", "d ", "世界", ",c", "yz"}));
+
+    Block left_block({{create_string_column(strs), std::make_shared<DataTypeString>(), "k1"},
+                      const_int(3, rows)});
+    ASSERT_EQ(to_strings(execute_function("left", left_block)),
+              std::vector<std::string>({"NULL", "  H", "你好,", "a,b", "ABC"}));
+    ASSERT_EQ(to_strings(execute_function("right", left_block)),
+              std::vector<std::string>({"", "ld ", ",世界", ",,c", "xyz"}));
+}
+
+TEST(StringFunctionTest, SearchTest) {
+    size_t rows = strs.size();
+    Block block({{create_string_column(strs), std::make_shared<DataTypeString>(), "k1"},
+                 const_string(",", rows), const_int(2, rows)});
+    ASSERT_EQ(to_strings(execute_function("split_part", block)),
+              std::vector<std::string>({"NULL", "NULL", "世界", "b", "NULL"}));
+
+    Block instr_block({{create_string_column(strs), std::make_shared<DataTypeString>(), "k1"},
+                       const_string("世", rows)});
+    auto instr = execute_function("instr", instr_block);
+    ASSERT_EQ(instr->getInt(2), 4);
+    ASSERT_EQ(instr->getInt(1), 0);
+
+    Block locate_block({const_string("o", rows),
+                        {create_string_column(strs), std::make_shared<DataTypeString>(), "k1"},
+                        const_int(8, rows)});
+    auto locate = execute_function("locate", locate_block);
+    ASSERT_EQ(locate->getInt(0), 0);
+    ASSERT_EQ(locate->getInt(1), 10);
+
+    Block starts_block({{create_string_column(strs), std::make_shared<DataTypeString>(), "k1"},
+                        const_string("a,", rows)});
+    auto starts_with = execute_function("starts_with", starts_block);
+    ASSERT_EQ(starts_with->getUInt(3), 1);
+    ASSERT_EQ(starts_with->getUInt(4), 0);
+}
+
+TEST(StringFunctionTest, ConcatTest) {
+    size_t rows = strs.size();
+    auto null_map = ColumnUInt8::create(rows, 0);
+    null_map->getData()[3] = 1;
+    auto k1 = ColumnNullable::create(create_string_column(strs), std::move(null_map));
+    Block block({{std::move(k1),
+                  std::make_shared<DataTypeNullable>(std::make_shared<DataTypeString>()), "k1"},
+                 const_string("|", rows),
+                 {create_string_column(strs), std::make_shared<DataTypeString>(), "k2"}});
+    auto res = to_strings(execute_function("concat", block));
+    ASSERT_EQ(res[0], "|");
+    ASSERT_EQ(res[2], "你好,世界|你好,世界");
+    ASSERT_EQ(res[3], "NULL");
+}
+
+} // namespace doris::vectorized
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
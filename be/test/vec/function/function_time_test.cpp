@@ -0,0 +1,213 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "runtime/datetime_value.h"
+#include "vec/columns/column_const.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/columns_number.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_string.h"
+#include "vec/data_types/data_types_number.h"
+#include "vec/functions/date_time_transforms.h"
+#include "vec/functions/simple_function_factory.h"
+
+namespace doris::vectorized {
+
+static DateTimeValue parse_datetime(const std::string& str) {
+    DateTimeValue value;
+    EXPECT_TRUE(value.from_date_str(str.data(), str.size())) << str;
+    return value;
+}
+
+// Datetimes every 13 days and 7 hours from 1900 to 2200, in and out of the range of DateLUT.
+static std::vector<DateTimeValue> all_datetimes() {
+    std::vector<DateTimeValue> values;
+    DateTimeValue value = parse_datetime("1900-01-01 00:00:00");
+    while (value.year() < 2200) {
+        values.push_back(value);
+        value.date_add_interval(TimeInterval(HOUR, 13 * 24 + 7, false), HOUR);
+    }
+    return values;
+}
+
+static ColumnWithTypeAndName datetime_column(const std::vector<DateTimeValue>& values) {
+    auto column = ColumnVector<Int128>::create();
+    for (const auto& value : values) {
+        column->insert(dateTimeToBinary(value));
+    }
+    return {std::move(column), std::make_shared<DataTypeInt128>(), "datetime"};
+}
+
+// Execute the function name on all the columns of arguments, return the result.
+static ColumnPtr execute_function(const std::string& name, Block block) {
+    ColumnNumbers arguments;
+    ColumnsWithTypeAndName ctn;
+    for (size_t i = 0; i < block.columns(); ++i) {
+        arguments.push_back(i);
+        ctn.push_back(block.getByPosition(i));
+    }
+    auto function = SimpleFunctionFactory::instance().get_function(name, ctn);
+    EXPECT_TRUE(function != nullptr);
+    size_t result = block.columns();
+    block.insert({nullptr, function->getReturnType(), name});
+    function->execute(block, arguments, result, block.rows(), false);
+    return block.getByPosition(result).column->convertToFullColumnIfConst();
+}
+
+// Check the result of the function name on values against expected, -1 for NULL.
+static void check_int_function(const std::string& name, const std::vector<DateTimeValue>& values,
+                               const std::function<int(const DateTimeValue&)>& expected) {
+    auto res = execute_function(name, Block({datetime_column(values)}));
+    const IColumn& nested = res->isNullable()
+                                    ? assert_cast<const ColumnNullable&>(*res).getNestedColumn()
+                                    : *res;
+    for (size_t i = 0; i < values.size(); ++i) {
+        char buf[64];
+        values[i].to_string(buf);
+        int expected_value = expected(values[i]);
+        if (expected_value == -1) {
+            EXPECT_TRUE(res->isNullAt(i)) << name << " " << buf;
+        } else {
+            EXPECT_FALSE(res->isNullAt(i)) << name << " " << buf;
+            EXPECT_EQ(expected_value, nested.getInt(i)) << name << " " << buf;
+        }
+    }
+}
+
+TEST(FunctionTimeTest, to_time) {
+    auto values = all_datetimes();
+    values.push_back(DateTimeValue(0)); // 0000-00-00 00:00:00 is not a valid date
+
+    check_int_function("year", values, [](const auto& v) { return v.year(); });
+    check_int_function("quarter", values, [](const auto& v) { return (v.month() - 1) / 3 + 1; });
+    check_int_function("month", values, [](const auto& v) { return v.month(); });
+    check_int_function("dayofmonth", values, [](const auto& v) { return v.day(); });
+    check_int_function("hour", values, [](const auto& v) { return v.hour(); });
+    check_int_function("minute", values, [](const auto& v) { return v.minute(); });
+    check_int_function("second", values, [](const auto& v) { return v.second(); });
+    check_int_function("to_days", values, [](const auto& v) { return v.daynr(); });
+    check_int_function("dayofweek", values, [](const auto& v) {
+        return v.is_valid_date() ? (v.weekday() + 1) % 7 + 1 : -1;
+    });
+    check_int_function("dayofyear", values, [](const auto& v) {
+        return v.is_valid_date() ? v.day_of_year() : -1;
+    });
+    check_int_function("weekofyear", values, [](const auto& v) {
+        return v.is_valid_date() ? v.week(mysql_week_mode(3)) : -1;
+    });
+
+    auto res = execute_function("to_date", Block({datetime_column(values)}));
+    for (size_t i = 0; i < values.size(); ++i) {
+        DateTimeValue expected = values[i];
+        expected.cast_to_date();
+        EXPECT_EQ(dateTimeToBinary(expected),
+                  assert_cast<const ColumnVector<Int128>&>(*res).getData()[i]);
+    }
+}
+
+TEST(FunctionTimeTest, date_add) {
+    auto values = all_datetimes();
+    values.push_back(parse_datetime("2020-01-31 10:00:00"));
+    values.push_back(parse_datetime("2020-02-29 23:59:59"));
+    values.push_back(parse_datetime("9999-12-31 23:59:59"));
+
+    std::vector<std::pair<std::string, TimeUnit>> functions = {
+            {"years_add", YEAR},  {"months_add", MONTH},   {"weeks_add", WEEK},
+            {"days_add", DAY},    {"hours_add", HOUR},     {"minutes_add", MINUTE},
+            {"seconds_add", SECOND}};
+    for (const auto& [name, unit] : functions) {
+        for (Int32 delta : {1, -1, 13, -400, 100000}) {
+            auto delta_column = ColumnConst::create(ColumnInt32::create(1, delta), values.size());
+            auto res = execute_function(
+                    name, Block({datetime_column(values),
+                                 {std::move(delta_column), std::make_shared<DataTypeInt32>(),
+                                  "delta"}}));
+            for (size_t i = 0; i < values.size(); ++i) {
+                DateTimeValue expected = values[i];
+                char buf[64];
+                expected.to_string(buf);
+                if (!expected.date_add_interval(TimeInterval(unit, delta, false), unit)) {
+                    EXPECT_TRUE(res->isNullAt(i)) << name << " " << delta << " " << buf;
+                    continue;
+                }
+                EXPECT_FALSE(res->isNullAt(i)) << name << " " << delta << " " << buf;
+                auto& nested = assert_cast<const ColumnNullable&>(*res).getNestedColumn();
+                EXPECT_EQ(dateTimeToBinary(expected),
+                          assert_cast<const ColumnVector<Int128>&>(nested).getData()[i])
+                        << name << " " << delta << " " << buf;
+            }
+        }
+    }
+}
+
+TEST(FunctionTimeTest, datediff_and_date_format) {
+    auto values = all_datetimes();
+    std::vector<DateTimeValue> others(values.rbegin(), values.rend());
+
+    auto res = execute_function("datediff",
+                                Block({datetime_column(values), datetime_column(others)}));
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(int(values[i].daynr() - others[i].daynr()), res->getInt(i));
+    }
+
+    auto format = [&](const std::string& format_str) {
+        auto column = ColumnString::create();
+        column->insertData(format_str.data(), format_str.size());
+        return execute_function(
+                "date_format",
+                Block({datetime_column({parse_datetime("2021-03-05 07:08:09")}),
+                       {ColumnConst::create(std::move(column), 1),
+                        std::make_shared<DataTypeString>(), "format"}}));
+    };
+    auto nested = [](const ColumnPtr& column) {
+        const auto& nullable = assert_cast<const ColumnNullable&>(*column);
+        return nullable.getNestedColumn().getDataAt(0).toString();
+    };
+    EXPECT_EQ("2021-03-05 07:08:09", nested(format("yyyy-MM-dd HH:mm:ss")));
+    EXPECT_EQ("20210305", nested(format("yyyyMMdd")));
+    EXPECT_EQ("Friday 05 March", nested(format("%W %d %M")));
+    // the result of a format that may be longer than 128 bytes is NULL, the specifiers are
+    // counted with their longest value
+    auto repeat = [](const std::string& str, int times) {
+        std::string res;
+        for (int i = 0; i < times; ++i) {
+            res += str;
+        }
+        return res;
+    };
+    EXPECT_TRUE(format(repeat("%W", 20))->isNullAt(0));
+    EXPECT_TRUE(format(repeat("%W", 60))->isNullAt(0));
+    EXPECT_TRUE(format(repeat("%r", 12))->isNullAt(0));
+    EXPECT_TRUE(format(repeat("%M%W", 8))->isNullAt(0));
+    EXPECT_EQ(repeat("Friday", 14), nested(format(repeat("%W", 14))));
+    EXPECT_EQ(repeat("07:08:09 AM", 11), nested(format(repeat("%r", 11))));
+    EXPECT_EQ(repeat("MarchFriday", 7), nested(format(repeat("%M%W", 7))));
+}
+
+} // namespace doris::vectorized
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,333 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/sink/vtablet_sink.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "common/config.h"
+#include "gen_cpp/HeartbeatService_types.h"
+#include "olap/hll.h"
+#include "runtime/bufferpool/reservation_tracker.h"
+#include "runtime/decimalv2_value.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/exec_env.h"
+#include "runtime/runtime_state.h"
+#include "runtime/stream_load/load_stream_mgr.h"
+#include "runtime/thread_resource_mgr.h"
+#include "util/bitmap_value.h"
+#include "util/brpc_stub_cache.h"
+#include "util/cpu_info.h"
+#include "vec/columns/column_decimal.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/columns_number.h"
+#include "vec/core/block.h"
+
+namespace doris {
+namespace stream_load {
+
+using vectorized::ColumnDecimal;
+using vectorized::ColumnNullable;
+using vectorized::ColumnString;
+using vectorized::ColumnUInt8;
+using vectorized::Decimal128;
+
+// The table of the tests is
+// (c1 INT NOT NULL, c2 VARCHAR(3), c3 DECIMAL(5, 2), c4 HLL, c5 BITMAP),
+// partitioned and distributed by c1.
+TDataSink get_data_sink(TDescriptorTable* desc_tbl) {
+    TDataSink data_sink;
+    data_sink.type = TDataSinkType::OLAP_TABLE_SINK;
+    data_sink.__isset.olap_table_sink = true;
+
+    TOlapTableSink& tsink = data_sink.olap_table_sink;
+    tsink.load_id.hi = 123;
+    tsink.load_id.lo = 456;
+    tsink.txn_id = 789;
+    tsink.db_id = 1;
+    tsink.table_id = 2;
+    tsink.tuple_id = 0;
+    tsink.num_replicas = 1;
+    tsink.db_name = "testDb";
+    tsink.table_name = "testTable";
+
+    TOlapTableSchemaParam& tschema = tsink.schema;
+    tschema.db_id = 1;
+    tschema.table_id = 2;
+    tschema.version = 0;
+    {
+        auto slot = [](const TypeDescriptor& type, const std::string& name, int pos,
+                       bool nullable) {
+            TSlotDescriptor slot_desc = TSlotDescriptorBuilder()
+                                                .type(type.type)
+                                                .nullable(nullable)
+                                                .column_name(name)
+                                                .column_pos(pos)
+                                                .build();
+            slot_desc.slotType = type.to_thrift();
+            return slot_desc;
+        };
+        TDescriptorTableBuilder dtb;
+        TTupleDescriptorBuilder tuple_builder;
+        tuple_builder.add_slot(slot(TypeDescriptor(TYPE_INT), "c1", 1, false));
+        tuple_builder.add_slot(slot(TypeDescriptor::create_varchar_type(3), "c2", 2, true));
+        tuple_builder.add_slot(slot(TypeDescriptor::create_decimalv2_type(5, 2), "c3", 3, true));
+        tuple_builder.add_slot(slot(TypeDescriptor::create_hll_type(), "c4", 4, true));
+        tuple_builder.add_slot(slot(TypeDescriptor(TYPE_OBJECT), "c5", 5, true));
+        tuple_builder.build(&dtb);
+
+        *desc_tbl = dtb.desc_tbl();
+        tschema.slot_descs = desc_tbl->slotDescriptors;
+        tschema.tuple_desc = desc_tbl->tupleDescriptors[0];
+    }
+    tschema.indexes.resize(1);
+    tschema.indexes[0].id = 4;
+    tschema.indexes[0].columns = {"c1", "c2", "c3", "c4", "c5"};
+
+    TOlapTablePartitionParam& tpartition = tsink.partition;
+    tpartition.db_id = 1;
+    tpartition.table_id = 2;
+    tpartition.version = 2;
+    tpartition.__set_partition_column("c1");
+    tpartition.__set_distributed_columns({"c1"});
+    tpartition.partitions.resize(1);
+    tpartition.partitions[0].id = 3;
+    tpartition.partitions[0].num_buckets = 1;
+    tpartition.partitions[0].indexes.resize(1);
+    tpartition.partitions[0].indexes[0].index_id = 4;
+    tpartition.partitions[0].indexes[0].tablets = {6};
+
+    TOlapTableLocationParam& location = tsink.location;
+    location.db_id = 1;
+    location.table_id = 2;
+    location.version = 0;
+    location.tablets.resize(1);
+    location.tablets[0].tablet_id = 6;
+    location.tablets[0].node_ids = {0};
+
+    TPaloNodesInfo& nodes_info = tsink.nodes_info;
+    nodes_info.nodes.resize(1);
+    nodes_info.nodes[0].id = 0;
+    nodes_info.nodes[0].host = "127.0.0.1";
+    nodes_info.nodes[0].async_internal_port = 4356;
+
+    return data_sink;
+}
+
+class VOlapTableSinkTest : public testing::Test {
+public:
+    void SetUp() override {
+        _env = ExecEnv::GetInstance();
+        _env->_thread_mgr = new ThreadResourceMgr();
+        _env->_master_info = new TMasterInfo();
+        _env->_load_stream_mgr = new LoadStreamMgr();
+        _env->_brpc_stub_cache = new BrpcStubCache();
+        _env->_buffer_reservation = new ReservationTracker();
+
+        TDescriptorTable tdesc_tbl;
+        TDataSink t_data_sink = get_data_sink(&tdesc_tbl);
+        ASSERT_TRUE(DescriptorTbl::create(&_obj_pool, tdesc_tbl, &_desc_tbl).ok());
+        _state.reset(new RuntimeState(TUniqueId(), TQueryOptions(), TQueryGlobals(), _env));
+        _state->init_mem_trackers(TUniqueId());
+        _state->_desc_tbl = _desc_tbl;
+        _row_desc.reset(new RowDescriptor(*_desc_tbl, {0}, {false}));
+
+        // the rows are not sent, the sink is not opened
+        Status st;
+        _sink.reset(new VOlapTableSink(&_obj_pool, *_row_desc, {}, &st));
+        ASSERT_TRUE(st.ok());
+        ASSERT_TRUE(_sink->init(t_data_sink).ok());
+        ASSERT_TRUE(_sink->prepare(_state.get()).ok());
+        ASSERT_TRUE(_sink->_need_validate_data);
+    }
+
+    void TearDown() override {
+        _sink.reset();
+        _state.reset();
+        SAFE_DELETE(_env->_brpc_stub_cache);
+        SAFE_DELETE(_env->_load_stream_mgr);
+        SAFE_DELETE(_env->_master_info);
+        SAFE_DELETE(_env->_thread_mgr);
+        SAFE_DELETE(_env->_buffer_reservation);
+    }
+
+protected:
+    const SlotDescriptor* slot(int i) const {
+        return _desc_tbl->get_tuple_descriptor(0)->slots()[i];
+    }
+
+    static vectorized::MutableColumnPtr make_nullable(vectorized::MutableColumnPtr column,
+                                                      const std::vector<uint8_t>& nulls) {
+        auto null_map = ColumnUInt8::create();
+        for (uint8_t is_null : nulls) {
+            null_map->insert(vectorized::Field(vectorized::UInt64(is_null)));
+        }
+        return ColumnNullable::create(std::move(column), std::move(null_map));
+    }
+
+    static vectorized::MutableColumnPtr strings(const std::vector<std::string>& values) {
+        auto column = ColumnString::create();
+        for (const auto& value : values) {
+            column->insertData(value.data(), value.size());
+        }
+        return column;
+    }
+
+    static vectorized::MutableColumnPtr decimals(const std::vector<std::string>& values) {
+        auto column = ColumnDecimal<Decimal128>::create(0, 9);
+        for (const auto& value : values) {
+            column->getData().push_back(Decimal128(DecimalV2Value(value).value()));
+        }
+        return column;
+    }
+
+    static std::string hll(bool valid) {
+        if (!valid) {
+            return "\x07not a hll";
+        }
+        HyperLogLog hll(12345);
+        std::string buf(hll.max_serialized_size(), '\0');
+        buf.resize(hll.serialize(reinterpret_cast<uint8_t*>(&buf[0])));
+        return buf;
+    }
+
+    static std::string bitmap() {
+        BitmapValue bitmap(12345);
+        std::string buf(bitmap.getSizeInBytes(), '\0');
+        bitmap.write(&buf[0]);
+        return buf;
+    }
+
+    // A block of the columns of the slots, the values of c2 to c5 are the same valid
+    // ones in every row.
+    vectorized::Block create_block(vectorized::MutableColumnPtr c1, size_t rows) {
+        vectorized::Block block;
+        block.insert({std::move(c1), slot(0)->get_data_type_ptr(), "c1"});
+        block.insert({make_nullable(strings(std::vector<std::string>(rows, "ab")),
+                                    std::vector<uint8_t>(rows, 0)),
+                      slot(1)->get_data_type_ptr(), "c2"});
+        block.insert({make_nullable(decimals(std::vector<std::string>(rows, "1.5")),
+                                    std::vector<uint8_t>(rows, 0)),
+                      slot(2)->get_data_type_ptr(), "c3"});
+        block.insert({make_nullable(strings(std::vector<std::string>(rows, hll(true))),
+                                    std::vector<uint8_t>(rows, 0)),
+                      slot(3)->get_data_type_ptr(), "c4"});
+        block.insert({make_nullable(strings(std::vector<std::string>(rows, bitmap())),
+                                    std::vector<uint8_t>(rows, 0)),
+                      slot(4)->get_data_type_ptr(), "c5"});
+        return block;
+    }
+
+    ExecEnv* _env = nullptr;
+    ObjectPool _obj_pool;
+    DescriptorTbl* _desc_tbl = nullptr;
+    std::unique_ptr<RuntimeState> _state;
+    std::unique_ptr<RowDescriptor> _row_desc;
+    std::unique_ptr<VOlapTableSink> _sink;
+};
+
+TEST_F(VOlapTableSinkTest, convert_block) {
+    // the input of c1 is nullable, c2 is not
+    auto c1 = make_nullable(vectorized::ColumnInt32::create(), {});
+    for (int32_t value : {1, 0, 3, 0}) {
+        c1->insert(vectorized::Field(vectorized::Int64(value)));
+    }
+    auto& null_map = assert_cast<ColumnNullable&>(*c1).getNullMapData();
+    null_map[1] = 1;
+    null_map[3] = 1;
+    vectorized::Block input_block = create_block(std::move(c1), 4);
+    input_block.getByPosition(1).column = strings({"a", "b", "c", "d"});
+    input_block.getByPosition(1).type = slot(1)->type().get_data_type_ptr();
+
+    // the nulls for the not null c1 are filtered and counted once, the row 3 is filtered
+    // already
+    vectorized::IColumn::Filter filter = {1, 1, 1, 0};
+    vectorized::Block block;
+    ASSERT_TRUE(_sink->_convert_block(_state.get(), &input_block, &block, &filter).ok());
+    ASSERT_EQ(vectorized::IColumn::Filter({1, 0, 1, 0}), filter);
+    ASSERT_EQ(1, _sink->_number_filtered_rows);
+
+    // the columns get the nullability of their slots
+    ASSERT_EQ(5, block.columns());
+    ASSERT_FALSE(block.getByPosition(0).column->isNullable());
+    ASSERT_FALSE(block.getByPosition(0).type->isNullable());
+    ASSERT_EQ(1, block.getByPosition(0).column->getInt(0));
+    ASSERT_EQ(3, block.getByPosition(0).column->getInt(2));
+    for (int i = 1; i < 5; ++i) {
+        ASSERT_TRUE(block.getByPosition(i).column->isNullable()) << i;
+        ASSERT_TRUE(block.getByPosition(i).type->isNullable()) << i;
+    }
+    const auto& c2 = assert_cast<const ColumnNullable&>(*block.getByPosition(1).column);
+    ASSERT_FALSE(c2.isNullAt(3));
+    ASSERT_EQ("d", c2.getNestedColumn().getDataAt(3).toString());
+}
+
+TEST_F(VOlapTableSinkTest, validate_block) {
+    const size_t rows = 7;
+    auto c1 = vectorized::ColumnInt32::create();
+    for (size_t i = 0; i < rows; ++i) {
+        c1->insert(vectorized::Field(vectorized::Int64(i)));
+    }
+    vectorized::Block block = create_block(std::move(c1), rows);
+    // 0: valid, its decimal is rounded to the scale of c3
+    // 1: the string is too long
+    // 2: the decimal is rounded up to 1000.00, out of the range of c3
+    // 3: the decimal is out of the range of c3
+    // 4: the hll is not valid
+    // 5: null for the bitmap
+    // 6: valid, the nulls are not validated and the decimal is rounded down to 999.99
+    block.getByPosition(1).column = make_nullable(
+            strings({"abc", "abcd", "a", "a", "a", "a", "abcdef"}), {0, 0, 0, 0, 0, 0, 1});
+    block.getByPosition(2).column =
+            make_nullable(decimals({"1.234", "1", "999.995", "-1000", "1", "1", "999.994"}),
+                          {0, 0, 0, 0, 0, 0, 0});
+    block.getByPosition(3).column = make_nullable(
+            strings({hll(true), hll(true), hll(true), hll(true), hll(false), hll(true),
+                     hll(false)}),
+            {0, 0, 0, 0, 0, 0, 1});
+    block.getByPosition(4).column = make_nullable(
+            strings(std::vector<std::string>(rows, bitmap())), {0, 0, 0, 0, 0, 1, 0});
+
+    vectorized::IColumn::Filter filter(rows, 1);
+    _sink->_validate_block(_state.get(), &block, &filter);
+    ASSERT_EQ(vectorized::IColumn::Filter({1, 0, 0, 0, 0, 0, 1}), filter);
+    ASSERT_EQ(5, _sink->_number_filtered_rows);
+
+    const auto& c3 = assert_cast<const ColumnDecimal<Decimal128>&>(
+            assert_cast<const ColumnNullable&>(*block.getByPosition(2).column)
+                    .getNestedColumn());
+    ASSERT_TRUE(DecimalV2Value(std::string("1.23")).value() == c3.getData()[0].value);
+    ASSERT_TRUE(DecimalV2Value(std::string("999.99")).value() == c3.getData()[6].value);
+
+    // the rows filtered already are not validated again
+    filter.assign(rows, 0);
+    _sink->_validate_block(_state.get(), &block, &filter);
+    ASSERT_EQ(5, _sink->_number_filtered_rows);
+}
+
+} // namespace stream_load
+} // namespace doris
+
+int main(int argc, char* argv[]) {
+    doris::CpuInfo::init();
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -29,6 +29,7 @@ import org.apache.doris.analysis.TableRef;
 import org.apache.doris.analysis.TupleId;
 import org.apache.doris.catalog.ColumnStats;
 import org.apache.doris.common.UserException;
+import org.apache.doris.qe.ConnectContext;
 import org.apache.doris.thrift.TEqJoinCondition;
 import org.apache.doris.thrift.TExplainLevel;
 import org.apache.doris.thrift.THashJoinNode;
@@ -286,7 +287,8 @@ public class HashJoinNode extends PlanNode {
 
     @Override
     protected void toThrift(TPlanNode msg) {
-        msg.node_type = TPlanNodeType.HASH_JOIN_NODE;
+        msg.node_type = ConnectContext.get().getSessionVariable().enableVectorizedEngine() ?
+                TPlanNodeType.VHASH_JOIN_NODE : TPlanNodeType.HASH_JOIN_NODE;
         msg.hash_join_node = new THashJoinNode();
         msg.hash_join_node.join_op = joinOp.toThrift();
         for (BinaryPredicate eqJoinPredicate : eqJoinConjuncts) {
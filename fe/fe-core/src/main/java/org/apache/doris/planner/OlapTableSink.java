@@ -39,6 +39,7 @@ import org.apache.doris.common.ErrorReport;
 import org.apache.doris.common.InternalErrorCode;
 import org.apache.doris.common.Status;
 import org.apache.doris.common.UserException;
+import org.apache.doris.qe.ConnectContext;
 import org.apache.doris.system.Backend;
 import org.apache.doris.system.SystemInfoService;
 import org.apache.doris.thrift.TDataSink;
@@ -97,7 +98,9 @@ public class OlapTableSink extends DataSink {
         tSink.setDbId(dbId);
         tSink.setLoadChannelTimeoutS(loadChannelTimeoutS);
         tDataSink = new TDataSink(TDataSinkType.DATA_SPLIT_SINK);
-        tDataSink.setType(TDataSinkType.OLAP_TABLE_SINK);
+        ConnectContext ctx = ConnectContext.get();
+        tDataSink.setType(ctx != null && ctx.getSessionVariable().enableVectorizedEngine() ?
+                TDataSinkType.VOLAP_TABLE_SINK : TDataSinkType.OLAP_TABLE_SINK);
         tDataSink.setOlapTableSink(tSink);
 
         for (Long partitionId : partitionIds) {
@@ -25,6 +25,7 @@ import org.apache.doris.analysis.SlotId;
 import org.apache.doris.analysis.SlotRef;
 import org.apache.doris.analysis.SortInfo;
 import org.apache.doris.common.UserException;
+import org.apache.doris.qe.ConnectContext;
 import org.apache.doris.thrift.TExplainLevel;
 import org.apache.doris.thrift.TPlanNode;
 import org.apache.doris.thrift.TPlanNodeType;
@@ -148,7 +149,8 @@ public class SortNode extends PlanNode {
 
     @Override
     protected void toThrift(TPlanNode msg) {
-        msg.node_type = TPlanNodeType.SORT_NODE;
+        msg.node_type = ConnectContext.get().getSessionVariable().enableVectorizedEngine() ?
+                TPlanNodeType.VSORT_NODE : TPlanNodeType.SORT_NODE;
         TSortInfo sortInfo = new TSortInfo(
                 Expr.treesToThrift(info.getOrderingExprs()),
                 info.getIsAscOrder(),
@@ -33,7 +33,9 @@ enum TDataSinkType {
     OLAP_TABLE_SINK,
     MEMORY_SCRATCH_SINK,
     ODBC_TABLE_SINK,
-    VRESULT_SINK
+    VRESULT_SINK,
+    VDATA_STREAM_SINK,
+    VOLAP_TABLE_SINK
 }
 
 enum TResultSinkType {
@@ -53,6 +53,9 @@ enum TPlanNodeType {
   ODBC_SCAN_NODE,
   VOLAP_SCAN_NODE,
   VAGGREGATION_NODE,
+  VHASH_JOIN_NODE,
+  VSORT_NODE,
+  VEXCHANGE_NODE,
 }
 
 // phases of an execution node
@@ -358,6 +361,11 @@ enum TJoinOp {
   NULL_AWARE_LEFT_ANTI_JOIN
 }
 
+struct TRuntimeFilterTarget {
+  1: required Types.TUniqueId fragment_instance_id
+  2: required Types.TNetworkAddress address
+}
+
 struct THashJoinNode {
   1: required TJoinOp join_op
 
@@ -372,6 +380,13 @@ struct THashJoinNode {
   // If true, this join node can (but may choose not to) generate slot filters
   // after constructing the build side that can be applied to the probe side.
   5: optional bool add_probe_filters
+
+  // The instances of the fragments scanning the probe side, when it is not scanned by
+  // the fragment of the join. The runtime filters of every instance of the join are sent
+  // to them, and merged there once the filters of all the num_runtime_filter_senders
+  // instances are received.
+  6: optional list<TRuntimeFilterTarget> runtime_filter_targets
+  7: optional i32 num_runtime_filter_senders
 }
 
 struct TMergeJoinNode {